@@ -0,0 +1,355 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * CVODE BDF stability limit detection (STALD) benchmark. The problem is a set
+ * of n forced, lightly damped oscillators
+ *
+ *   y_i' = A_i (y_i - g_i(t)) + g_i'(t),   A_i = [ -a_i  -w_i ]
+ *                                                [  w_i  -a_i ]
+ *
+ * with y_i in R^2, the frequencies w_i logarithmically spaced in [wmin, wmax],
+ * a_i = d w_i, and the slowly varying forcing g_i(t) = (sin(t + i), cos(t + i)).
+ * With y(0) = g(0) the exact solution is y(t) = g(t).
+ *
+ * Accuracy alone allows large steps at high order, but for any step size h
+ * some of the eigenvalues h (-a_i +/- i w_i), which lie at an angle of
+ * atan(1/d) from the negative real axis, fall outside the stability regions
+ * of the BDF methods of order 3 to 5. Errors in these modes grow until the
+ * error test forces the step size down. STALD detects the growth and reduces
+ * the order instead. The problem is solved with STALD off and on, and the
+ * step counts, order reductions, errors, and run times are reported.
+ * ---------------------------------------------------------------------------*/
+
+#include <cvode/cvode.h>
+#include <math.h>
+#include <nvector/nvector_serial.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/sundials_math.h>
+#include <sunlinsol/sunlinsol_band.h>
+#include <sunmatrix/sunmatrix_band.h>
+#include <time.h>
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* Problem parameters */
+typedef struct
+{
+  sunindextype n;   /* number of oscillators */
+  sunrealtype wmin; /* smallest frequency    */
+  sunrealtype wmax; /* largest frequency     */
+  sunrealtype d;    /* damping ratio         */
+  sunrealtype tf;   /* final time            */
+  sunrealtype rtol;
+  sunrealtype atol;
+  int nreps; /* number of timed repetitions */
+}* UserData;
+
+/* Run statistics */
+typedef struct
+{
+  long int nst, nfe, nni, netf, ncfn, nje, nor;
+  sunrealtype err;
+  double time;
+} RunStats;
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data);
+static int Jac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+               void* user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+static sunrealtype Frequency(sunindextype i, UserData udata);
+static void Solution(sunrealtype t, N_Vector y, UserData udata);
+static int Run(SUNContext ctx, UserData udata, sunbooleantype stald,
+               RunStats* stats);
+static int ReadInputs(int argc, char* argv[], UserData udata);
+static int check_flag(int flag, const char* funcname);
+
+int main(int argc, char* argv[])
+{
+  SUNContext ctx;
+  UserData udata;
+  RunStats off, on;
+
+  udata = (UserData)malloc(sizeof *udata);
+  if (udata == NULL) { return 1; }
+  if (ReadInputs(argc, argv, udata)) { return 1; }
+
+  if (check_flag(SUNContext_Create(SUN_COMM_NULL, &ctx), "SUNContext_Create"))
+  {
+    return 1;
+  }
+
+  printf("\nCVODE STALD benchmark\n");
+  printf("  oscillators = %ld\n", (long int)udata->n);
+  printf("  frequencies = [%g, %g]\n", (double)udata->wmin,
+         (double)udata->wmax);
+  printf("  damping     = %g\n", (double)udata->d);
+  printf("  tf          = %g\n", (double)udata->tf);
+  printf("  rtol        = %g\n", (double)udata->rtol);
+  printf("  atol        = %g\n", (double)udata->atol);
+  printf("  repetitions = %d\n\n", udata->nreps);
+
+  if (Run(ctx, udata, SUNFALSE, &off)) { return 1; }
+  if (Run(ctx, udata, SUNTRUE, &on)) { return 1; }
+
+  printf("                     STALD off     STALD on\n");
+  printf("  Steps           %12ld %12ld\n", off.nst, on.nst);
+  printf("  RHS evals       %12ld %12ld\n", off.nfe, on.nfe);
+  printf("  NLS iters       %12ld %12ld\n", off.nni, on.nni);
+  printf("  Error test fails%12ld %12ld\n", off.netf, on.netf);
+  printf("  NLS conv fails  %12ld %12ld\n", off.ncfn, on.ncfn);
+  printf("  Jac evals       %12ld %12ld\n", off.nje, on.nje);
+  printf("  Order reductions%12ld %12ld\n", off.nor, on.nor);
+  printf("  Max error       %12.4e %12.4e\n", (double)off.err, (double)on.err);
+  printf("  Time (s)        %12.4e %12.4e\n", off.time, on.time);
+  printf("\n  Step reduction with STALD: %.1f%%\n",
+         100.0 * (double)(off.nst - on.nst) / (double)off.nst);
+
+  SUNContext_Free(&ctx);
+  free(udata);
+
+  return 0;
+}
+
+/* Solve the problem nreps times and return the statistics of the last run
+   and the average run time */
+static int Run(SUNContext ctx, UserData udata, sunbooleantype stald,
+               RunStats* stats)
+{
+  sunindextype N = 2 * udata->n;
+  N_Vector y, ytrue;
+  SUNMatrix A;
+  SUNLinearSolver LS;
+  void* cvode_mem;
+  sunrealtype t;
+  clock_t start;
+  int rep, flag;
+
+  y     = N_VNew_Serial(N, ctx);
+  ytrue = N_VNew_Serial(N, ctx);
+  A     = SUNBandMatrix(N, 1, 1, ctx);
+  LS    = SUNLinSol_Band(y, A, ctx);
+  if (y == NULL || ytrue == NULL || A == NULL || LS == NULL)
+  {
+    fprintf(stderr, "ERROR: allocation failed\n");
+    return 1;
+  }
+
+  Solution(ZERO, y, udata);
+
+  cvode_mem = CVodeCreate(CV_BDF, ctx);
+  if (check_flag(CVodeInit(cvode_mem, f, ZERO, y), "CVodeInit")) { return 1; }
+  flag = CVodeSStolerances(cvode_mem, udata->rtol, udata->atol);
+  if (check_flag(flag, "CVodeSStolerances")) { return 1; }
+  flag = CVodeSetUserData(cvode_mem, udata);
+  if (check_flag(flag, "CVodeSetUserData")) { return 1; }
+  flag = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (check_flag(flag, "CVodeSetLinearSolver")) { return 1; }
+  flag = CVodeSetJacFn(cvode_mem, Jac);
+  if (check_flag(flag, "CVodeSetJacFn")) { return 1; }
+  flag = CVodeSetMaxNumSteps(cvode_mem, 1000000);
+  if (check_flag(flag, "CVodeSetMaxNumSteps")) { return 1; }
+  flag = CVodeSetStabLimDet(cvode_mem, stald);
+  if (check_flag(flag, "CVodeSetStabLimDet")) { return 1; }
+
+  stats->time = 0.0;
+  for (rep = 0; rep < udata->nreps; rep++)
+  {
+    Solution(ZERO, y, udata);
+    flag = CVodeReInit(cvode_mem, ZERO, y);
+    if (check_flag(flag, "CVodeReInit")) { return 1; }
+
+    start = clock();
+    flag  = CVode(cvode_mem, udata->tf, y, &t, CV_NORMAL);
+    stats->time += (double)(clock() - start) / CLOCKS_PER_SEC;
+    if (check_flag(flag, "CVode")) { return 1; }
+  }
+  stats->time /= udata->nreps;
+
+  /* error at the final time */
+  Solution(t, ytrue, udata);
+  N_VLinearSum(ONE, y, -ONE, ytrue, ytrue);
+  stats->err = N_VMaxNorm(ytrue);
+
+  (void)CVodeGetNumSteps(cvode_mem, &stats->nst);
+  (void)CVodeGetNumRhsEvals(cvode_mem, &stats->nfe);
+  (void)CVodeGetNumNonlinSolvIters(cvode_mem, &stats->nni);
+  (void)CVodeGetNumErrTestFails(cvode_mem, &stats->netf);
+  (void)CVodeGetNumNonlinSolvConvFails(cvode_mem, &stats->ncfn);
+  (void)CVodeGetNumJacEvals(cvode_mem, &stats->nje);
+  (void)CVodeGetNumStabLimOrderReds(cvode_mem, &stats->nor);
+
+  CVodeFree(&cvode_mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  N_VDestroy(ytrue);
+  N_VDestroy(y);
+
+  return 0;
+}
+
+/* ODE right-hand side function */
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  UserData udata = (UserData)user_data;
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+  sunrealtype wi, ai, e1, e2, s, c;
+  sunindextype i;
+
+  for (i = 0; i < udata->n; i++)
+  {
+    wi = Frequency(i, udata);
+    ai = udata->d * wi;
+    s  = sin(t + (sunrealtype)i);
+    c  = cos(t + (sunrealtype)i);
+    e1 = yd[2 * i] - s;
+    e2 = yd[2 * i + 1] - c;
+
+    fd[2 * i]     = -ai * e1 - wi * e2 + c;
+    fd[2 * i + 1] = wi * e1 - ai * e2 - s;
+  }
+
+  return 0;
+}
+
+/* ODE Jacobian function */
+static int Jac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+               void* user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  UserData udata = (UserData)user_data;
+  sunrealtype wi, ai;
+  sunindextype i;
+
+  SUNMatZero(J);
+
+  for (i = 0; i < udata->n; i++)
+  {
+    wi = Frequency(i, udata);
+    ai = udata->d * wi;
+
+    SM_ELEMENT_B(J, 2 * i, 2 * i)         = -ai;
+    SM_ELEMENT_B(J, 2 * i, 2 * i + 1)     = -wi;
+    SM_ELEMENT_B(J, 2 * i + 1, 2 * i)     = wi;
+    SM_ELEMENT_B(J, 2 * i + 1, 2 * i + 1) = -ai;
+  }
+
+  return 0;
+}
+
+/* Frequency of oscillator i */
+static sunrealtype Frequency(sunindextype i, UserData udata)
+{
+  if (udata->n == 1) { return udata->wmin; }
+  return udata->wmin * SUNRpowerR(udata->wmax / udata->wmin,
+                                  (sunrealtype)i / (sunrealtype)(udata->n - 1));
+}
+
+/* Exact solution */
+static void Solution(sunrealtype t, N_Vector y, UserData udata)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunindextype i;
+
+  for (i = 0; i < udata->n; i++)
+  {
+    yd[2 * i]     = sin(t + (sunrealtype)i);
+    yd[2 * i + 1] = cos(t + (sunrealtype)i);
+  }
+}
+
+static int ReadInputs(int argc, char* argv[], UserData udata)
+{
+  int i;
+
+  udata->n     = 100;
+  udata->wmin  = SUN_RCONST(1.0);
+  udata->wmax  = SUN_RCONST(1.0e4);
+  udata->d     = SUN_RCONST(0.05);
+  udata->tf    = SUN_RCONST(10.0);
+  udata->rtol  = SUN_RCONST(1.0e-6);
+  udata->atol  = SUN_RCONST(1.0e-10);
+  udata->nreps = 5;
+
+  for (i = 1; i < argc; i++)
+  {
+    if (!strcmp(argv[i], "--n") && i + 1 < argc)
+    {
+      udata->n = (sunindextype)atol(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--wmin") && i + 1 < argc)
+    {
+      udata->wmin = (sunrealtype)atof(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--wmax") && i + 1 < argc)
+    {
+      udata->wmax = (sunrealtype)atof(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--d") && i + 1 < argc)
+    {
+      udata->d = (sunrealtype)atof(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--tf") && i + 1 < argc)
+    {
+      udata->tf = (sunrealtype)atof(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--rtol") && i + 1 < argc)
+    {
+      udata->rtol = (sunrealtype)atof(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--atol") && i + 1 < argc)
+    {
+      udata->atol = (sunrealtype)atof(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "--nreps") && i + 1 < argc)
+    {
+      udata->nreps = atoi(argv[++i]);
+    }
+    else
+    {
+      if (strcmp(argv[i], "--help"))
+      {
+        fprintf(stderr, "ERROR: unknown option %s\n", argv[i]);
+      }
+      printf("Usage: %s [options]\n", argv[0]);
+      printf("  --n <n>         : number of oscillators (default 100)\n");
+      printf("  --wmin <wmin>   : smallest frequency (default 1)\n");
+      printf("  --wmax <wmax>   : largest frequency (default 1e4)\n");
+      printf("  --d <d>         : damping ratio (default 0.05)\n");
+      printf("  --tf <tf>       : final time (default 10)\n");
+      printf("  --rtol <rtol>   : relative tolerance (default 1e-6)\n");
+      printf("  --atol <atol>   : absolute tolerance (default 1e-10)\n");
+      printf("  --nreps <nreps> : timed repetitions (default 5)\n");
+      return 1;
+    }
+  }
+
+  if (udata->n < 1 || udata->nreps < 1 || udata->wmin <= ZERO ||
+      udata->wmax < udata->wmin)
+  {
+    fprintf(stderr, "ERROR: n, nreps, and wmin must be positive and "
+                    "wmax >= wmin\n");
+    return 1;
+  }
+
+  return 0;
+}
+
+static int check_flag(int flag, const char* funcname)
+{
+  if (flag < 0)
+  {
+    fprintf(stderr, "ERROR: %s returned %d\n", funcname, flag);
+    return 1;
+  }
+  return 0;
+}
@@ -626,6 +626,7 @@ UserData::~UserData()
     N_VDestroy(diag);
     diag = NULL;
   }
+  MGFree(this);
 }
 
 // -----------------------------------------------------------------------------
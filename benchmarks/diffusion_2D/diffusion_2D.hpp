@@ -168,6 +168,10 @@ struct UserData
   // Inverse of Jacobian diagonal for preconditioner
   N_Vector diag = NULL;
 
+  // Geometric multigrid preconditioner
+  SUNStructMG mg = NULL;
+  int mgsweeps   = 1;
+
   UserData(SUNProfiler prof_) : prof(prof_) {}
 
   ~UserData();
@@ -236,6 +240,13 @@ int PSetup(sunrealtype t, N_Vector u, N_Vector f, sunbooleantype jok,
 int PSolve(sunrealtype t, N_Vector u, N_Vector f, N_Vector r, N_Vector z,
            sunrealtype gamma, sunrealtype delta, int lr, void* user_data);
 
+// Multigrid preconditioner setup and solve functions
+int PSetupMG(sunrealtype t, N_Vector u, N_Vector f, sunbooleantype jok,
+             sunbooleantype* jcurPtr, sunrealtype gamma, void* user_data);
+
+int PSolveMG(sunrealtype t, N_Vector u, N_Vector f, N_Vector r, N_Vector z,
+             sunrealtype gamma, sunrealtype delta, int lr, void* user_data);
+
 #elif defined(BENCHMARK_DAE)
 
 #if defined(USE_SUPERLU_DIST)
@@ -258,10 +269,22 @@ int PSetup(sunrealtype t, N_Vector u, N_Vector up, N_Vector res, sunrealtype cj,
 int PSolve(sunrealtype t, N_Vector u, N_Vector up, N_Vector res, N_Vector r,
            N_Vector z, sunrealtype cj, sunrealtype delta, void* user_data);
 
+// Multigrid preconditioner setup and solve functions
+int PSetupMG(sunrealtype t, N_Vector u, N_Vector up, N_Vector res,
+             sunrealtype cj, void* user_data);
+
+int PSolveMG(sunrealtype t, N_Vector u, N_Vector up, N_Vector res, N_Vector r,
+             N_Vector z, sunrealtype cj, sunrealtype delta, void* user_data);
+
 #else
 #error "Missing ODE/DAE preprocessor directive"
 #endif
 
+// Create, print, and free the multigrid preconditioner
+int MGCreate(UserData* udata, int sweeps, int maxlevels, SUNContext ctx);
+void MGPrint(UserData* udata);
+int MGFree(UserData* udata);
+
 // -----------------------------------------------------------------------------
 // Utility functions
 // -----------------------------------------------------------------------------
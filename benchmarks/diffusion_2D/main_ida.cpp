@@ -31,6 +31,11 @@ struct UserOptions
   int liniters         = 20;   // number of linear iterations
   sunrealtype epslin   = ZERO; // linear solver tolerance factor
 
+  // Preconditioner settings
+  std::string prec = "jacobi"; // preconditioner to use
+  int mgsweeps     = 2;        // multigrid smoothing sweeps
+  int mglevels     = 0;        // max multigrid levels (0 = no limit)
+
   // Helper functions
   int parse_args(vector<string>& args, bool outproc);
   void help();
@@ -232,8 +237,22 @@ int main(int argc, char* argv[])
     // Allocate preconditioner workspace
     if (uopts.preconditioning)
     {
-      udata.diag = N_VClone(u);
-      if (check_flag((void*)(udata.diag), "N_VClone", 0)) { return 1; }
+      if (uopts.prec == "jacobi")
+      {
+        udata.diag = N_VClone(u);
+        if (check_flag((void*)(udata.diag), "N_VClone", 0)) { return 1; }
+      }
+      else if (uopts.prec == "mg")
+      {
+        flag = MGCreate(&udata, uopts.mgsweeps, uopts.mglevels, ctx);
+        if (check_flag(&flag, "MGCreate", 1)) { return 1; }
+        if (outproc) { MGPrint(&udata); }
+      }
+      else
+      {
+        std::cerr << "ERROR: Invalid preconditioner option\n";
+        return 1;
+      }
     }
 
     // --------------
@@ -271,7 +290,11 @@ int main(int argc, char* argv[])
     if (uopts.preconditioning)
     {
       // Attach preconditioner
-      flag = IDASetPreconditioner(ida_mem, PSetup, PSolve);
+      if (uopts.prec == "mg")
+      {
+        flag = IDASetPreconditioner(ida_mem, PSetupMG, PSolveMG);
+      }
+      else { flag = IDASetPreconditioner(ida_mem, PSetup, PSolve); }
       if (check_flag(&flag, "IDASetPreconditioner", 1)) { return 1; }
     }
 
@@ -451,6 +474,27 @@ int UserOptions::parse_args(vector<string>& args, bool outproc)
     args.erase(it, it + 2);
   }
 
+  it = find(args.begin(), args.end(), "--prec");
+  if (it != args.end())
+  {
+    prec = *(it + 1);
+    args.erase(it, it + 2);
+  }
+
+  it = find(args.begin(), args.end(), "--mgsweeps");
+  if (it != args.end())
+  {
+    mgsweeps = stoi(*(it + 1));
+    args.erase(it, it + 2);
+  }
+
+  it = find(args.begin(), args.end(), "--mglevels");
+  if (it != args.end())
+  {
+    mglevels = stoi(*(it + 1));
+    args.erase(it, it + 2);
+  }
+
   return 0;
 }
 
@@ -465,6 +509,9 @@ void UserOptions::help()
   cout << "  --liniters <iters>      : max number of iterations" << endl;
   cout << "  --epslin <factor>       : linear tolerance factor" << endl;
   cout << "  --noprec                : disable preconditioner" << endl;
+  cout << "  --prec <jacobi|mg>      : preconditioner" << endl;
+  cout << "  --mgsweeps <sweeps>     : multigrid smoothing sweeps" << endl;
+  cout << "  --mglevels <levels>     : max multigrid levels" << endl;
 }
 
 // Print user options
@@ -498,6 +545,7 @@ void UserOptions::print()
     cout << " --------------------------------- " << endl;
     cout << " LS       = " << ls << endl;
     cout << " precond  = " << preconditioning << endl;
+    cout << " prec     = " << prec << endl;
     cout << " LS iters = " << liniters << endl;
     cout << " epslin   = " << epslin << endl;
     cout << " --------------------------------- " << endl;
@@ -0,0 +1,155 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Geometric multigrid preconditioner for 2D diffusion benchmark problem
+ *
+ * The preconditioner applies one V-cycle of the SUNStructMG to c0 I - s L,
+ * where L is the five-point Laplacian (c0 = 1 and s = gamma for the ODE,
+ * c0 = cj and s = 1 for the DAE). Meshes with 2^k + 1 nodes in each direction
+ * give the deepest hierarchy.
+ * ---------------------------------------------------------------------------*/
+
+#include "diffusion_2D.hpp"
+
+// -----------------------------------------------------------------------------
+// Multigrid create, print, and free functions
+// -----------------------------------------------------------------------------
+
+int MGCreate(UserData* udata, int sweeps, int maxlevels, SUNContext ctx)
+{
+#if defined(USE_HIP) || defined(USE_CUDA)
+  cerr << "ERROR: The multigrid preconditioner requires host vector data\n";
+  return -1;
+#else
+  // Process grid and subdomain of this process
+  SUNStructGrid grid;
+  grid.dim       = 2;
+  grid.n[0]      = udata->nx;
+  grid.n[1]      = udata->ny;
+  grid.start[0]  = udata->is;
+  grid.start[1]  = udata->js;
+  grid.nloc[0]   = udata->nx_loc;
+  grid.nloc[1]   = udata->ny_loc;
+  grid.nbr[0][0] = udata->HaveNbrW ? udata->ipW : -1;
+  grid.nbr[0][1] = udata->HaveNbrE ? udata->ipE : -1;
+  grid.nbr[1][0] = udata->HaveNbrS ? udata->ipS : -1;
+  grid.nbr[1][1] = udata->HaveNbrN ? udata->ipN : -1;
+  grid.comm      = udata->comm_c;
+
+  // Five-point Laplacian, kx / dx^2 and ky / dy^2
+  SUNStructStencil stencil;
+  stencil.coef[0] = udata->kx / (udata->dx * udata->dx);
+  stencil.coef[1] = udata->ky / (udata->dy * udata->dy);
+
+  SUNErrCode err = SUNStructMG_Create(&grid, &stencil, maxlevels, ctx,
+                                      &(udata->mg));
+  if (err != SUN_SUCCESS) { return -1; }
+
+  udata->mgsweeps = (sweeps > 0) ? sweeps : 1;
+  err             = SUNStructMG_SetNumSweeps(udata->mg, udata->mgsweeps);
+  if (err != SUN_SUCCESS) { return -1; }
+
+  return 0;
+#endif
+}
+
+void MGPrint(UserData* udata)
+{
+  if (udata->mg == NULL) { return; }
+
+  int nlevels = 0;
+  sunindextype ncoarse[2];
+  SUNStructMG_GetNumLevels(udata->mg, &nlevels);
+  SUNStructMG_GetCoarseGrid(udata->mg, ncoarse);
+
+  cout << endl;
+  cout << " Multigrid preconditioner:" << endl;
+  cout << " --------------------------------- " << endl;
+  cout << " levels      = " << nlevels << endl;
+  cout << " coarse grid = " << ncoarse[0] << " x " << ncoarse[1] << endl;
+  cout << " sweeps      = " << udata->mgsweeps << endl;
+  cout << " --------------------------------- " << endl;
+}
+
+int MGFree(UserData* udata)
+{
+  SUNStructMG_Destroy(&(udata->mg));
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// Preconditioner setup and solve functions
+// -----------------------------------------------------------------------------
+
+#if defined(BENCHMARK_ODE)
+
+// Preconditioner setup routine
+int PSetupMG(sunrealtype t, N_Vector u, N_Vector f, sunbooleantype jok,
+             sunbooleantype* jcurPtr, sunrealtype gamma, void* user_data)
+{
+  // Access problem data
+  UserData* udata = (UserData*)user_data;
+
+  SUNDIALS_CXX_MARK_FUNCTION(udata->prof);
+
+  return SUNStructMG_ODEPrecSetup(t, u, f, jok, jcurPtr, gamma, udata->mg);
+}
+
+// Preconditioner solve routine for Pz = r
+int PSolveMG(sunrealtype t, N_Vector u, N_Vector f, N_Vector r, N_Vector z,
+             sunrealtype gamma, sunrealtype delta, int lr, void* user_data)
+{
+  // Access user_data structure
+  UserData* udata = (UserData*)user_data;
+
+  SUNDIALS_CXX_MARK_FUNCTION(udata->prof);
+
+#if defined(USE_HIP) || defined(USE_CUDA)
+  return -1;
+#else
+  // Perform one V-cycle
+  return SUNStructMG_ODEPrecSolve(t, u, f, r, z, gamma, delta, lr, udata->mg);
+#endif
+}
+
+#elif defined(BENCHMARK_DAE)
+
+// Preconditioner setup and solve functions
+int PSetupMG(sunrealtype t, N_Vector u, N_Vector up, N_Vector res,
+             sunrealtype cj, void* user_data)
+{
+  // Access problem data
+  UserData* udata = (UserData*)user_data;
+
+  SUNDIALS_CXX_MARK_FUNCTION(udata->prof);
+
+  return SUNStructMG_DAEPrecSetup(t, u, up, res, cj, udata->mg);
+}
+
+int PSolveMG(sunrealtype t, N_Vector u, N_Vector up, N_Vector res, N_Vector r,
+             N_Vector z, sunrealtype cj, sunrealtype delta, void* user_data)
+{
+  // Access user_data structure
+  UserData* udata = (UserData*)user_data;
+
+  SUNDIALS_CXX_MARK_FUNCTION(udata->prof);
+
+#if defined(USE_HIP) || defined(USE_CUDA)
+  return -1;
+#else
+  // Perform one V-cycle
+  return SUNStructMG_DAEPrecSolve(t, u, up, res, r, z, cj, delta, udata->mg);
+#endif
+}
+
+#else
+#error "Missing ODE/DAE preprocessor directive"
+#endif
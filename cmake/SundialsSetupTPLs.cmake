@@ -157,6 +157,8 @@ endif()
 if(ENABLE_PTHREAD)
   include(SundialsPthread)
   list(APPEND SUNDIALS_TPL_LIST "PTHREAD")
+  # sundials_config.h spells the macro SUNDIALS_PTHREADS_ENABLED
+  set(SUNDIALS_PTHREADS_ENABLED TRUE)
 endif()
 
 # -------------------------------------------------------------
@@ -9,7 +9,7 @@
 # SPDX-License-Identifier: BSD-3-Clause
 # SUNDIALS Copyright End
 # ----------------------------------------------------------------
-doc_version = 'v7.1.1'
+doc_version = 'develop'
 sundials_version = 'v7.1.1'
 arkode_version = 'v6.1.1'
 cvode_version = 'v7.1.1'
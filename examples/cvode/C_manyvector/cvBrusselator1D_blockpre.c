@@ -0,0 +1,432 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Example problem:
+ *
+ * The following test simulates a brusselator problem from chemical
+ * kinetics. This is a PDE system with 3 components, Y = [u,v,w],
+ * satisfying the equations,
+ *    u_t = du*u_xx + a - (w+1)*u + v*u^2
+ *    v_t = dv*v_xx + w*u - v*u^2
+ *    w_t = dw*w_xx + (b-w)/ep - w*u
+ * for t in [0, 10], x in [0, 1], with initial conditions
+ *    u(0,x) =  a  + 0.1*sin(pi*x)
+ *    v(0,x) = b/a + 0.1*sin(pi*x)
+ *    w(0,x) =  b  + 0.1*sin(pi*x),
+ * and with stationary boundary conditions, i.e.
+ *    u_t(t,0) = u_t(t,1) = 0,
+ *    v_t(t,0) = v_t(t,1) = 0,
+ *    w_t(t,0) = w_t(t,1) = 0.
+ *
+ * The spatial derivatives are computed using second-order
+ * centered differences, with the data distributed over N points
+ * on a uniform spatial grid.
+ *
+ * The data is stored using the ManyVector structure, i.e., each of
+ * u, v and w is stored in a separate serial vector. The problem is
+ * solved with CVODE, with the BDF/GMRES method (i.e. using the
+ * SUNLinSol_SPGMR linear solver) and the block preconditioner of
+ * the CVBLOCKPRE module. Each of u, v and w is one block, whose
+ * tridiagonal self-coupling is approximated by difference
+ * quotients. The problem is solved with a block Jacobi sweep and
+ * with a block Gauss-Seidel sweep, which also accounts for the
+ * coupling of each species to the previous ones.
+ * -----------------------------------------------------------------*/
+
+#include <cvode/cvode.h>          /* prototypes for CVODE fcts., consts.  */
+#include <cvode/cvode_blockpre.h> /* access to CVBLOCKPRE module          */
+#include <math.h>
+#include <nvector/nvector_manyvector.h> /* access to ManyVector N_Vector */
+#include <nvector/nvector_serial.h>     /* access to serial N_Vector     */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_types.h> /* defs. of sunrealtype, sunindextype   */
+#include <sunlinsol/sunlinsol_spgmr.h> /* access to SPGMR SUNLinearSolver      */
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#define ESYM "Le"
+#define FSYM "Lf"
+#else
+#define GSYM "g"
+#define ESYM "e"
+#define FSYM "f"
+#endif
+
+/* Problem Constants */
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+#define NVAR 3                   /* number of species (blocks) */
+#define NX   201                 /* spatial mesh size          */
+#define T0   ZERO                /* initial time               */
+#define TF   SUN_RCONST(10.0)    /* final time                 */
+#define NOUT 10                  /* number of output times     */
+#define RTOL SUN_RCONST(1.0e-6)  /* scalar relative tolerance  */
+#define ATOL SUN_RCONST(1.0e-10) /* scalar absolute tolerance  */
+
+/* User data structure */
+
+typedef struct
+{
+  sunindextype N; /* number of mesh points   */
+  sunrealtype dx; /* mesh spacing            */
+  sunrealtype a;  /* constant forcing on u   */
+  sunrealtype b;  /* steady-state value of w */
+  sunrealtype du; /* diffusion coeff for u   */
+  sunrealtype dv; /* diffusion coeff for v   */
+  sunrealtype dw; /* diffusion coeff for w   */
+  sunrealtype ep; /* stiffness parameter     */
+}* UserData;
+
+/* Private Helper Functions */
+
+static void SetInitialProfiles(N_Vector y, UserData data);
+static void PrintOutput(void* cvode_mem, N_Vector y, sunrealtype t);
+static void PrintFinalStats(void* cvode_mem);
+
+/* Private function to check function return values */
+static int check_retval(void* returnvalue, const char* funcname, int opt);
+
+/* Function Called by the Solver */
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data);
+
+/*
+ *-------------------------------
+ * Main Program
+ *-------------------------------
+ */
+
+int main(void)
+{
+  SUNContext sunctx;
+  sunrealtype t, tout;
+  N_Vector y, uvw[NVAR];
+  UserData data;
+  SUNLinearSolver LS;
+  void* cvode_mem;
+  int retval, iout, sweep, k;
+  sunindextype mu[NVAR], ml[NVAR];
+
+  y         = NULL;
+  data      = NULL;
+  LS        = NULL;
+  cvode_mem = NULL;
+
+  /* Create the SUNDIALS context */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (check_retval(&retval, "SUNContext_Create", 1)) { return (1); }
+
+  /* Set problem data */
+  data = (UserData)malloc(sizeof *data);
+  if (check_retval((void*)data, "malloc", 2)) { return (1); }
+  data->N  = NX;
+  data->dx = ONE / (NX - 1);
+  data->a  = SUN_RCONST(0.6);
+  data->b  = SUN_RCONST(2.0);
+  data->du = SUN_RCONST(0.001);
+  data->dv = SUN_RCONST(0.001);
+  data->dw = SUN_RCONST(0.001);
+  data->ep = SUN_RCONST(1.0e-5);
+
+  /* Create the ManyVector y = [u, v, w] and set the initial profiles */
+  for (k = 0; k < NVAR; k++)
+  {
+    uvw[k] = N_VNew_Serial(NX, sunctx);
+    if (check_retval((void*)uvw[k], "N_VNew_Serial", 0)) { return (1); }
+  }
+  y = N_VNew_ManyVector(NVAR, uvw, sunctx);
+  if (check_retval((void*)y, "N_VNew_ManyVector", 0)) { return (1); }
+  SetInitialProfiles(y, data);
+
+  /* Call CVodeCreate to create the solver memory and specify the
+   * Backward Differentiation Formula */
+  cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  if (check_retval((void*)cvode_mem, "CVodeCreate", 0)) { return (1); }
+
+  /* Set the pointer to user-defined data */
+  retval = CVodeSetUserData(cvode_mem, data);
+  if (check_retval(&retval, "CVodeSetUserData", 1)) { return (1); }
+
+  /* Call CVodeInit to initialize the integrator memory */
+  retval = CVodeInit(cvode_mem, f, T0, y);
+  if (check_retval(&retval, "CVodeInit", 1)) { return (1); }
+
+  /* Call CVodeSStolerances to specify the scalar tolerances */
+  retval = CVodeSStolerances(cvode_mem, RTOL, ATOL);
+  if (check_retval(&retval, "CVodeSStolerances", 1)) { return (1); }
+
+  /* Call SUNLinSol_SPGMR to specify the linear solver SPGMR
+   * with left preconditioning and the default Krylov dimension */
+  LS = SUNLinSol_SPGMR(y, SUN_PREC_LEFT, 0, sunctx);
+  if (check_retval((void*)LS, "SUNLinSol_SPGMR", 0)) { return (1); }
+
+  /* Call CVodeSetLinearSolver to attach the linear solver to CVode */
+  retval = CVodeSetLinearSolver(cvode_mem, LS, NULL);
+  if (check_retval(&retval, "CVodeSetLinearSolver", 1)) { return (1); }
+
+  /* Each species block is tridiagonal */
+  for (k = 0; k < NVAR; k++) { mu[k] = ml[k] = 1; }
+
+  printf("\n1D Brusselator PDE test problem:\n");
+  printf("    N = %li,  a = %" GSYM ",  b = %" GSYM ",  ep = %" GSYM "\n",
+         (long int)data->N, data->a, data->b, data->ep);
+  printf("    du = %" GSYM ",  dv = %" GSYM ",  dw = %" GSYM "\n", data->du,
+         data->dv, data->dw);
+  printf("SPGMR solver; block preconditioner; %d tridiagonal blocks\n", NVAR);
+
+  /* Loop over the block sweeps and solve the problem */
+
+  for (sweep = CV_BLOCKPRE_JACOBI; sweep <= CV_BLOCKPRE_GAUSS_SEIDEL; sweep++)
+  {
+    /* On second run, re-initialize y and the solver */
+
+    if (sweep == CV_BLOCKPRE_GAUSS_SEIDEL)
+    {
+      SetInitialProfiles(y, data);
+
+      retval = CVodeReInit(cvode_mem, T0, y);
+      if (check_retval(&retval, "CVodeReInit", 1)) { return (1); }
+
+      printf("\n\n-------------------------------------------------------");
+      printf("------------\n");
+    }
+
+    /* Call CVBlockPrecInit to initialize the block preconditioner */
+    retval = CVBlockPrecInit(cvode_mem, sweep, mu, ml);
+    if (check_retval(&retval, "CVBlockPrecInit", 1)) { return (1); }
+
+    printf("\n\nBlock sweep is:  %s\n\n",
+           (sweep == CV_BLOCKPRE_JACOBI) ? "CV_BLOCKPRE_JACOBI"
+                                         : "CV_BLOCKPRE_GAUSS_SEIDEL");
+
+    /* In loop over output points, call CVode, print results, test for error */
+
+    for (iout = 1, tout = TF / NOUT; iout <= NOUT; iout++, tout += TF / NOUT)
+    {
+      retval = CVode(cvode_mem, tout, y, &t, CV_NORMAL);
+      if (check_retval(&retval, "CVode", 1)) { break; }
+      PrintOutput(cvode_mem, y, t);
+    }
+
+    /* Print final statistics */
+
+    PrintFinalStats(cvode_mem);
+
+  } /* End of sweep loop */
+
+  /* Free memory */
+  N_VDestroy(y);
+  for (k = 0; k < NVAR; k++) { N_VDestroy(uvw[k]); }
+  free(data);
+  CVodeFree(&cvode_mem);
+  SUNLinSolFree(LS);
+  SUNContext_Free(&sunctx);
+
+  return (0);
+}
+
+/*
+ *-------------------------------
+ * Private helper functions
+ *-------------------------------
+ */
+
+/* Set initial conditions in y */
+
+static void SetInitialProfiles(N_Vector y, UserData data)
+{
+  sunrealtype *udata, *vdata, *wdata, pi;
+  sunindextype i;
+
+  udata = N_VGetSubvectorArrayPointer_ManyVector(y, 0);
+  vdata = N_VGetSubvectorArrayPointer_ManyVector(y, 1);
+  wdata = N_VGetSubvectorArrayPointer_ManyVector(y, 2);
+
+  pi = SUN_RCONST(4.0) * atan(ONE);
+  for (i = 0; i < data->N; i++)
+  {
+    udata[i] = data->a + SUN_RCONST(0.1) * sin(pi * i * data->dx);
+    vdata[i] = data->b / data->a + SUN_RCONST(0.1) * sin(pi * i * data->dx);
+    wdata[i] = data->b + SUN_RCONST(0.1) * sin(pi * i * data->dx);
+  }
+}
+
+/* Print current t, step count, order, stepsize, and norms of u, v, w */
+
+static void PrintOutput(void* cvode_mem, N_Vector y, sunrealtype t)
+{
+  long int nst;
+  int qu, retval;
+  sunrealtype hu, nrm[NVAR];
+  N_Vector yk;
+  int k;
+
+  retval = CVodeGetNumSteps(cvode_mem, &nst);
+  check_retval(&retval, "CVodeGetNumSteps", 1);
+  retval = CVodeGetLastOrder(cvode_mem, &qu);
+  check_retval(&retval, "CVodeGetLastOrder", 1);
+  retval = CVodeGetLastStep(cvode_mem, &hu);
+  check_retval(&retval, "CVodeGetLastStep", 1);
+
+  for (k = 0; k < NVAR; k++)
+  {
+    yk     = N_VGetSubvector_ManyVector(y, k);
+    nrm[k] = sqrt(N_VDotProd(yk, yk) / N_VGetLength(yk));
+  }
+
+  printf("t = %.2" ESYM "   no. steps = %ld   order = %d   stepsize = %.2" ESYM
+         "\n",
+         t, nst, qu, hu);
+  printf("||u||_rms = %10.6" FSYM "  ||v||_rms = %10.6" FSYM
+         "  ||w||_rms = %10.6" FSYM "\n",
+         nrm[0], nrm[1], nrm[2]);
+}
+
+/* Get and print final statistics */
+
+static void PrintFinalStats(void* cvode_mem)
+{
+  long int lenrwBLP, leniwBLP;
+  long int nst, nfe, nsetups, nni, ncfn, netf;
+  long int nli, npe, nps, ncfl, nfeLS;
+  long int nfeBLP;
+  int retval;
+
+  retval = CVodeGetNumSteps(cvode_mem, &nst);
+  check_retval(&retval, "CVodeGetNumSteps", 1);
+  retval = CVodeGetNumRhsEvals(cvode_mem, &nfe);
+  check_retval(&retval, "CVodeGetNumRhsEvals", 1);
+  retval = CVodeGetNumLinSolvSetups(cvode_mem, &nsetups);
+  check_retval(&retval, "CVodeGetNumLinSolvSetups", 1);
+  retval = CVodeGetNumErrTestFails(cvode_mem, &netf);
+  check_retval(&retval, "CVodeGetNumErrTestFails", 1);
+  retval = CVodeGetNumNonlinSolvIters(cvode_mem, &nni);
+  check_retval(&retval, "CVodeGetNumNonlinSolvIters", 1);
+  retval = CVodeGetNumNonlinSolvConvFails(cvode_mem, &ncfn);
+  check_retval(&retval, "CVodeGetNumNonlinSolvConvFails", 1);
+
+  retval = CVodeGetNumLinIters(cvode_mem, &nli);
+  check_retval(&retval, "CVodeGetNumLinIters", 1);
+  retval = CVodeGetNumPrecEvals(cvode_mem, &npe);
+  check_retval(&retval, "CVodeGetNumPrecEvals", 1);
+  retval = CVodeGetNumPrecSolves(cvode_mem, &nps);
+  check_retval(&retval, "CVodeGetNumPrecSolves", 1);
+  retval = CVodeGetNumLinConvFails(cvode_mem, &ncfl);
+  check_retval(&retval, "CVodeGetNumLinConvFails", 1);
+  retval = CVodeGetNumLinRhsEvals(cvode_mem, &nfeLS);
+  check_retval(&retval, "CVodeGetNumLinRhsEvals", 1);
+
+  retval = CVBlockPrecGetWorkSpace(cvode_mem, &lenrwBLP, &leniwBLP);
+  check_retval(&retval, "CVBlockPrecGetWorkSpace", 1);
+  retval = CVBlockPrecGetNumRhsEvals(cvode_mem, &nfeBLP);
+  check_retval(&retval, "CVBlockPrecGetNumRhsEvals", 1);
+
+  printf("\nFinal Statistics.. \n\n");
+  printf("lenrwbp = %5ld     leniwbp = %5ld\n", lenrwBLP, leniwBLP);
+  printf("nst     = %5ld\n", nst);
+  printf("nfe     = %5ld     nfetot  = %5ld\n", nfe, nfe + nfeLS + nfeBLP);
+  printf("nfeLS   = %5ld     nfeBP   = %5ld\n", nfeLS, nfeBLP);
+  printf("nni     = %5ld     nli     = %5ld\n", nni, nli);
+  printf("nsetups = %5ld     netf    = %5ld\n", nsetups, netf);
+  printf("npe     = %5ld     nps     = %5ld\n", npe, nps);
+  printf("ncfn    = %5ld     ncfl    = %5ld\n\n", ncfn, ncfl);
+}
+
+/* Check function return value...
+     opt == 0 means SUNDIALS function allocates memory so check if
+              returned NULL pointer
+     opt == 1 means SUNDIALS function returns an integer value so check if
+              retval < 0
+     opt == 2 means function allocates memory so check if returned
+              NULL pointer */
+
+static int check_retval(void* returnvalue, const char* funcname, int opt)
+{
+  int* retval;
+
+  /* Check if SUNDIALS function returned NULL pointer - no memory allocated */
+  if (opt == 0 && returnvalue == NULL)
+  {
+    fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return (1);
+  }
+
+  /* Check if retval < 0 */
+  else if (opt == 1)
+  {
+    retval = (int*)returnvalue;
+    if (*retval < 0)
+    {
+      fprintf(stderr, "\nSUNDIALS_ERROR: %s() failed with retval = %d\n\n",
+              funcname, *retval);
+      return (1);
+    }
+  }
+
+  /* Check if function returned NULL pointer - no memory allocated */
+  else if (opt == 2 && returnvalue == NULL)
+  {
+    fprintf(stderr, "\nMEMORY_ERROR: %s() failed - returned NULL pointer\n\n",
+            funcname);
+    return (1);
+  }
+
+  return (0);
+}
+
+/*
+ *-------------------------------
+ * Function called by the solver
+ *-------------------------------
+ */
+
+/* f routine. Compute f(t,y). */
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  UserData data = (UserData)user_data;
+  sunindextype N, i;
+  sunrealtype uconst, vconst, wconst;
+  sunrealtype *y_u, *y_v, *y_w, *f_u, *f_v, *f_w;
+
+  N   = data->N;
+  y_u = N_VGetSubvectorArrayPointer_ManyVector(y, 0);
+  y_v = N_VGetSubvectorArrayPointer_ManyVector(y, 1);
+  y_w = N_VGetSubvectorArrayPointer_ManyVector(y, 2);
+  f_u = N_VGetSubvectorArrayPointer_ManyVector(ydot, 0);
+  f_v = N_VGetSubvectorArrayPointer_ManyVector(ydot, 1);
+  f_w = N_VGetSubvectorArrayPointer_ManyVector(ydot, 2);
+
+  /* iterate over domain, computing all equations */
+  uconst = data->du / data->dx / data->dx;
+  vconst = data->dv / data->dx / data->dx;
+  wconst = data->dw / data->dx / data->dx;
+  for (i = 1; i < N - 1; i++)
+  {
+    f_u[i] = (y_u[i - 1] - TWO * y_u[i] + y_u[i + 1]) * uconst + data->a -
+             (y_w[i] + ONE) * y_u[i] + y_v[i] * y_u[i] * y_u[i];
+    f_v[i] = (y_v[i - 1] - TWO * y_v[i] + y_v[i + 1]) * vconst +
+             y_w[i] * y_u[i] - y_v[i] * y_u[i] * y_u[i];
+    f_w[i] = (y_w[i - 1] - TWO * y_w[i] + y_w[i + 1]) * wconst +
+             (data->b - y_w[i]) / data->ep - y_w[i] * y_u[i];
+  }
+
+  /* enforce stationary boundaries */
+  f_u[0] = f_v[0] = f_w[0] = ZERO;
+  f_u[N - 1] = f_v[N - 1] = f_w[N - 1] = ZERO;
+
+  return (0);
+}
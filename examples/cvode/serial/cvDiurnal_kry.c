@@ -35,6 +35,13 @@
  * preconditioner. A copy of the block-diagonal part of the
  * Jacobian is saved and conditionally reused within the Precond
  * routine.
+ *
+ * Optionally, the adaptive linear solver tolerance (Eisenstat-
+ * Walker forcing term) is enabled with CVodeSetLSForcing.
+ *
+ * Execution: cvDiurnal_kry [forcing]
+ *   forcing = 0 (default) uses the fixed linear solver tolerance
+ *   forcing = 1 uses the adaptive linear solver tolerance
  * -----------------------------------------------------------------*/
 
 #include <cvode/cvode.h> /* prototypes for CVODE fcts., consts.  */
@@ -160,7 +167,7 @@ static int PSolve(sunrealtype tn, N_Vector u, N_Vector fu, N_Vector r, N_Vector
  *-------------------------------
  */
 
-int main(void)
+int main(int argc, char* argv[])
 {
   SUNContext sunctx;
   sunrealtype abstol, reltol, t, tout;
@@ -168,7 +175,11 @@ int main(void)
   UserData data;
   SUNLinearSolver LS;
   void* cvode_mem;
-  int iout, retval;
+  int iout, retval, forcing;
+
+  /* Optionally enable the adaptive linear solver tolerance */
+  forcing = 0;
+  if (argc > 1) { forcing = atoi(argv[1]); }
 
   u         = NULL;
   data      = NULL;
@@ -226,8 +237,16 @@ int main(void)
   retval = CVodeSetPreconditioner(cvode_mem, Precond, PSolve);
   if (check_retval(&retval, "CVodeSetPreconditioner", 1)) { return (1); }
 
+  /* Relax the linear solver tolerance while the Newton residual is large */
+  if (forcing)
+  {
+    retval = CVodeSetLSForcing(cvode_mem, SUNTRUE);
+    if (check_retval(&retval, "CVodeSetLSForcing", 1)) { return (1); }
+  }
+
   /* In loop over output points, call CVode, print results, test for error */
   printf(" \n2-species diurnal advection-diffusion problem\n\n");
+  if (forcing) { printf("Adaptive linear solver tolerance\n\n"); }
   for (iout = 1, tout = TWOHR; iout <= NOUT; iout++, tout += TWOHR)
   {
     retval = CVode(cvode_mem, tout, u, &t, CV_NORMAL);
@@ -34,6 +34,13 @@
  * ..., 10.24. Two cases are run -- with the Gram-Schmidt type
  * being Modified in the first case, and Classical in the second.
  * The second run uses IDAReInit.
+ *
+ * Optionally, the adaptive linear solver tolerance (Eisenstat-
+ * Walker forcing term) is enabled with IDASetLSForcing.
+ *
+ * Execution: idaHeat2D_kry [forcing]
+ *   forcing = 0 (default) uses the fixed linear solver tolerance
+ *   forcing = 1 uses the adaptive linear solver tolerance
  * -----------------------------------------------------------------*/
 
 #include <ida/ida.h> /* prototypes for IDA fcts., consts.    */
@@ -90,17 +97,21 @@ static int check_retval(void* returnvalue, const char* funcname, int opt);
  *--------------------------------------------------------------------
  */
 
-int main(void)
+int main(int argc, char* argv[])
 {
   void* mem;
   UserData data;
   N_Vector uu, up, constraints, res;
-  int retval, iout;
+  int retval, iout, forcing;
   sunrealtype rtol, atol, t0, t1, tout, tret;
   long int netf, ncfn, ncfl;
   SUNLinearSolver LS;
   SUNContext ctx;
 
+  /* Optionally enable the adaptive linear solver tolerance */
+  forcing = 0;
+  if (argc > 1) { forcing = atoi(argv[1]); }
+
   mem  = NULL;
   data = NULL;
   uu = up = constraints = res = NULL;
@@ -187,8 +198,16 @@ int main(void)
   retval = IDASetPreconditioner(mem, PsetupHeat, PsolveHeat);
   if (check_retval(&retval, "IDASetPreconditioner", 1)) { return (1); }
 
+  /* Relax the linear solver tolerance while the Newton residual is large */
+  if (forcing)
+  {
+    retval = IDASetLSForcing(mem, SUNTRUE);
+    if (check_retval(&retval, "IDASetLSForcing", 1)) { return (1); }
+  }
+
   /* Print output heading. */
   PrintHeader(rtol, atol);
+  if (forcing) { printf("Linear solver tolerance: adaptive (forcing term). \n"); }
 
   /*
    * -------------------------------------------------------------------------
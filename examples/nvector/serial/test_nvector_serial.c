@@ -170,6 +170,7 @@ int main(int argc, char* argv[])
   fails += Test_N_VWrmsNormMaskVectorArray(U, length, 0);
   fails += Test_N_VScaleAddMultiVectorArray(U, length, 0);
   fails += Test_N_VLinearCombinationVectorArray(U, length, 0);
+  fails += Test_N_VPascalShiftVectorArray(U, length, 0);
 
   /* Fused and vector array operations tests (enabled) */
   printf("\nTesting fused and vector array operations (enabled):\n\n");
@@ -202,6 +203,7 @@ int main(int argc, char* argv[])
   fails += Test_N_VWrmsNormMaskVectorArray(V, length, 0);
   fails += Test_N_VScaleAddMultiVectorArray(V, length, 0);
   fails += Test_N_VLinearCombinationVectorArray(V, length, 0);
+  fails += Test_N_VPascalShiftVectorArray(V, length, 0);
 
   /* local reduction operations */
   printf("\nTesting local reduction operations:\n\n");
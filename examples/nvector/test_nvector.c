@@ -4990,6 +4990,98 @@ int Test_N_VLinearCombinationVectorArray(N_Vector V, sunindextype local_length,
   return (fails);
 }
 
+/* ----------------------------------------------------------------------
+ * N_VPascalShiftVectorArray Test
+ * --------------------------------------------------------------------*/
+int Test_N_VPascalShiftVectorArray(N_Vector V, sunindextype local_length,
+                                   int myid)
+{
+  int fails = 0, failure = 0, ierr = 0;
+  double start_time, stop_time, maxt;
+
+  N_Vector* Z;
+
+  /* create vectors for testing */
+  Z = N_VCloneVectorArray(4, V);
+
+  /*
+   * Case 1: nvec = 1, Z[0] is unchanged
+   */
+
+  /* fill vector data */
+  N_VConst(TWO, Z[0]);
+
+  start_time = get_time();
+  ierr       = N_VPascalShiftVectorArray(1, Z);
+  sync_device(V);
+  stop_time = get_time();
+
+  /* Z[0] should equal +2 */
+  if (ierr == 0) { failure = check_ans(TWO, Z[0], local_length); }
+  else { failure = 1; }
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- N_VPascalShiftVectorArray Case 1, Proc %d \n",
+           myid);
+    fails++;
+  }
+  else if (myid == 0)
+  {
+    printf("PASSED test -- N_VPascalShiftVectorArray Case 1 \n");
+  }
+
+  /* find max time across all processes */
+  maxt = max_time(V, stop_time - start_time);
+  PRINT_TIME("N_VPascalShiftVectorArray", maxt);
+
+  /*
+   * Case 2: nvec = 4,
+   * Z[j] = sum{ binomial(i,j) * Z[i] }, i = j,...,3
+   */
+
+  /* fill vector data */
+  N_VConst(ONE, Z[0]);
+  N_VConst(TWO, Z[1]);
+  N_VConst(SUN_RCONST(3.0), Z[2]);
+  N_VConst(SUN_RCONST(4.0), Z[3]);
+
+  start_time = get_time();
+  ierr       = N_VPascalShiftVectorArray(4, Z);
+  sync_device(V);
+  stop_time = get_time();
+
+  /* Z[i] should equal to +10, +20, +15, +4 */
+  if (ierr == 0)
+  {
+    failure = check_ans(SUN_RCONST(10.0), Z[0], local_length);
+    failure += check_ans(SUN_RCONST(20.0), Z[1], local_length);
+    failure += check_ans(SUN_RCONST(15.0), Z[2], local_length);
+    failure += check_ans(SUN_RCONST(4.0), Z[3], local_length);
+  }
+  else { failure = 1; }
+
+  if (failure)
+  {
+    printf(">>> FAILED test -- N_VPascalShiftVectorArray Case 2, Proc %d \n",
+           myid);
+    fails++;
+  }
+  else if (myid == 0)
+  {
+    printf("PASSED test -- N_VPascalShiftVectorArray Case 2 \n");
+  }
+
+  /* find max time across all processes */
+  maxt = max_time(V, stop_time - start_time);
+  PRINT_TIME("N_VPascalShiftVectorArray", maxt);
+
+  /* Free vectors */
+  N_VDestroyVectorArray(Z, 4);
+
+  return (fails);
+}
+
 /* ----------------------------------------------------------------------
  * N_VDotProdLocal test
  * --------------------------------------------------------------------*/
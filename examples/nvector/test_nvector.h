@@ -115,6 +115,8 @@ int Test_N_VScaleAddMultiVectorArray(N_Vector X, sunindextype local_length,
                                      int myid);
 int Test_N_VLinearCombinationVectorArray(N_Vector X, sunindextype local_length,
                                          int myid);
+int Test_N_VPascalShiftVectorArray(N_Vector X, sunindextype local_length,
+                                   int myid);
 
 /* Local reduction operation tests */
 int Test_N_VDotProdLocal(N_Vector X, N_Vector Y, sunindextype local_length,
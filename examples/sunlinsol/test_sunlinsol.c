@@ -515,6 +515,80 @@ int Test_SUNLinSolSolve(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
   return (0);
 }
 
+/* ----------------------------------------------------------------------
+ * SUNLinSolSolveMulti Test
+ *
+ * This test must follow Test_SUNLinSolSetup. The right-hand sides are
+ * scaled copies of b, b_i = (i+1) b, so the expected solutions are
+ * x_i = (i+1) x. The number of right-hand sides is chosen so that
+ * implementations that process the right-hand sides in blocks are
+ * exercised with a partial final block.
+ * --------------------------------------------------------------------*/
+int Test_SUNLinSolSolveMulti(SUNLinearSolver S, SUNMatrix A, N_Vector x,
+                             N_Vector b, sunrealtype tol, int myid)
+{
+  int failure, i;
+  const int nrhs = 11;
+  double start_time, stop_time;
+  N_Vector *X, *B, y;
+
+  /* create right-hand sides and solution vectors */
+  X = N_VCloneVectorArray(nrhs, x);
+  B = N_VCloneVectorArray(nrhs, b);
+  y = N_VClone(x);
+  for (i = 0; i < nrhs; i++)
+  {
+    N_VScale((sunrealtype)(i + 1), b, B[i]);
+    N_VConst(ZERO, X[i]);
+  }
+
+  sync_device();
+
+  /* perform solve */
+  start_time = get_time();
+  failure    = SUNLinSolSolveMulti(S, A, X, B, nrhs, tol);
+  sync_device();
+  stop_time = get_time();
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNLinSolSolveMulti returned %d on Proc %d \n",
+           failure, myid);
+    N_VDestroyVectorArray(X, nrhs);
+    N_VDestroyVectorArray(B, nrhs);
+    N_VDestroy(y);
+    return (1);
+  }
+
+  /* Check solutions */
+  for (i = 0; i < nrhs; i++)
+  {
+    N_VScale((sunrealtype)(i + 1), x, y);
+    failure = check_vector(y, X[i], 10.0 * (i + 1) * tol);
+    if (failure) { break; }
+  }
+  if (failure)
+  {
+    printf(">>> FAILED test -- SUNLinSolSolveMulti check, Proc %d \n", myid);
+    PRINT_TIME("    SUNLinSolSolveMulti Time: %22.15e \n \n",
+               stop_time - start_time);
+    N_VDestroyVectorArray(X, nrhs);
+    N_VDestroyVectorArray(B, nrhs);
+    N_VDestroy(y);
+    return (1);
+  }
+  else if (myid == 0)
+  {
+    printf("    PASSED test -- SUNLinSolSolveMulti \n");
+    PRINT_TIME("    SUNLinSolSolveMulti Time: %22.15e \n \n",
+               stop_time - start_time);
+  }
+
+  N_VDestroyVectorArray(X, nrhs);
+  N_VDestroyVectorArray(B, nrhs);
+  N_VDestroy(y);
+  return (0);
+}
+
 /* ======================================================================
  * Private functions
  * ====================================================================*/
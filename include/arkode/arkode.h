@@ -140,6 +140,13 @@ extern "C" {
 
 #define ARK_STEPPER_UNSUPPORTED -48
 
+#define ARK_ADJ_MEM_NULL -49
+
+#define ARK_DOMEIG_FAIL          -50
+#define ARK_MAX_STAGE_LIMIT_FAIL -51
+
+#define ARK_OUTPUTFUNC_FAIL -52
+
 #define ARK_UNRECOGNIZED_ERROR -99
 
 /* ------------------------------
@@ -149,6 +156,9 @@ extern "C" {
 typedef int (*ARKRhsFn)(sunrealtype t, N_Vector y, N_Vector ydot,
                         void* user_data);
 
+typedef int (*ARKRhsDirFn)(sunrealtype t, N_Vector y, N_Vector v,
+                           N_Vector ydot, N_Vector Jv, void* user_data);
+
 typedef int (*ARKRootFn)(sunrealtype t, N_Vector y, sunrealtype* gout,
                          void* user_data);
 
@@ -174,6 +184,10 @@ typedef int (*ARKRelaxFn)(N_Vector y, sunrealtype* r, void* user_data);
 
 typedef int (*ARKRelaxJacFn)(N_Vector y, N_Vector J, void* user_data);
 
+typedef int (*ARKAdjRhsFn)(sunrealtype t, N_Vector y, N_Vector lambda,
+                           N_Vector JyTlambda, N_Vector JpTlambda,
+                           void* user_data);
+
 /* ------------------------------------------------
  * MRIStep Inner Stepper Type (forward declaration)
  * ------------------------------------------------ */
@@ -190,6 +204,18 @@ typedef enum
   ARK_RELAX_NEWTON
 } ARKRelaxSolver;
 
+/* --------------------------------
+ * Accumulated Error Estimate Types
+ * -------------------------------- */
+
+typedef enum
+{
+  ARK_ACCUMERROR_NONE,
+  ARK_ACCUMERROR_MAX,
+  ARK_ACCUMERROR_SUM,
+  ARK_ACCUMERROR_AVG
+} ARKAccumError;
+
 /* --------------------------
  * Shared API routines
  * -------------------------- */
@@ -200,6 +226,10 @@ SUNDIALS_EXPORT int ARKodeResize(void* arkode_mem, N_Vector ynew,
                                  ARKVecResizeFn resize, void* resize_data);
 SUNDIALS_EXPORT int ARKodeReset(void* arkode_mem, sunrealtype tR, N_Vector yR);
 
+/* Checkpoint/restart functions */
+SUNDIALS_EXPORT int ARKodeWriteState(void* arkode_mem, FILE* fp);
+SUNDIALS_EXPORT int ARKodeReadState(void* arkode_mem, FILE* fp);
+
 /* Tolerance input functions */
 SUNDIALS_EXPORT int ARKodeSStolerances(void* arkode_mem, sunrealtype reltol,
                                        sunrealtype abstol);
@@ -233,6 +263,8 @@ SUNDIALS_EXPORT int ARKodeSetPostprocessStepFn(void* arkode_mem,
                                                ARKPostProcessFn ProcessStep);
 SUNDIALS_EXPORT int ARKodeSetPostprocessStageFn(void* arkode_mem,
                                                 ARKPostProcessFn ProcessStage);
+SUNDIALS_EXPORT int ARKodeSetOutputFn(void* arkode_mem, SUNOutputFn fn,
+                                      void* output_data);
 
 /* Optional input functions (implicit solver) */
 SUNDIALS_EXPORT int ARKodeSetNonlinearSolver(void* arkode_mem,
@@ -280,6 +312,9 @@ SUNDIALS_EXPORT int ARKodeSetInitStep(void* arkode_mem, sunrealtype hin);
 SUNDIALS_EXPORT int ARKodeSetMinStep(void* arkode_mem, sunrealtype hmin);
 SUNDIALS_EXPORT int ARKodeSetMaxStep(void* arkode_mem, sunrealtype hmax);
 SUNDIALS_EXPORT int ARKodeSetMaxNumConstrFails(void* arkode_mem, int maxfails);
+SUNDIALS_EXPORT int ARKodeSetAccumulatedErrorType(void* arkode_mem,
+                                                 ARKAccumError accum_type);
+SUNDIALS_EXPORT int ARKodeResetAccumulatedError(void* arkode_mem);
 
 /* Integrate the ODE over an interval in t */
 SUNDIALS_EXPORT int ARKodeEvolve(void* arkode_mem, sunrealtype tout,
@@ -325,6 +360,8 @@ SUNDIALS_EXPORT int ARKodeGetNumConstrFails(void* arkode_mem,
 SUNDIALS_EXPORT int ARKodeGetStepStats(void* arkode_mem, long int* nsteps,
                                        sunrealtype* hinused, sunrealtype* hlast,
                                        sunrealtype* hcur, sunrealtype* tcur);
+SUNDIALS_EXPORT int ARKodeGetAccumulatedError(void* arkode_mem,
+                                              sunrealtype* accum_error);
 
 /* Optional output functions (implicit solver) */
 SUNDIALS_EXPORT int ARKodeGetNumLinSolvSetups(void* arkode_mem,
@@ -359,6 +396,9 @@ SUNDIALS_EXPORT int ARKodeGetNumJTSetupEvals(void* arkode_mem,
 SUNDIALS_EXPORT int ARKodeGetNumJtimesEvals(void* arkode_mem, long int* njvevals);
 SUNDIALS_EXPORT int ARKodeGetNumLinRhsEvals(void* arkode_mem,
                                             long int* nfevalsLS);
+SUNDIALS_EXPORT int ARKodeGetLinSolveTimes(void* arkode_mem, sunrealtype* tjac,
+                                           sunrealtype* tlsetup,
+                                           sunrealtype* tnls);
 SUNDIALS_EXPORT int ARKodeGetLastLinFlag(void* arkode_mem, long int* flag);
 SUNDIALS_EXPORT char* ARKodeGetLinReturnFlagName(long int flag);
 
@@ -412,6 +452,16 @@ SUNDIALS_EXPORT int ARKodeGetNumRelaxSolveFails(void* arkode_mem,
 SUNDIALS_EXPORT int ARKodeGetNumRelaxSolveIters(void* arkode_mem,
                                                 long int* iters);
 
+/* Discrete adjoint functions */
+SUNDIALS_EXPORT int ARKodeAdjInit(void* arkode_mem, int interval,
+                                  ARKAdjRhsFn fadj);
+SUNDIALS_EXPORT int ARKodeAdjSolve(void* arkode_mem, N_Vector lambda,
+                                   N_Vector mu);
+SUNDIALS_EXPORT int ARKodeGetNumAdjRhsEvals(void* arkode_mem, long int* nfevals,
+                                            long int* nfadjevals);
+SUNDIALS_EXPORT int ARKodeGetNumAdjCheckpoints(void* arkode_mem,
+                                               long int* nckpnt);
+
 #ifdef __cplusplus
 }
 #endif
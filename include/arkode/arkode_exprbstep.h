@@ -0,0 +1,57 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the ARKODE ExpRBStep module.
+ * -----------------------------------------------------------------*/
+
+#ifndef _ARKODE_EXPRBSTEP_H
+#define _ARKODE_EXPRBSTEP_H
+
+#include <arkode/arkode.h>
+#include <arkode/arkode_ls.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -------------------
+ * Exported Functions
+ * ------------------- */
+
+/* Creation and Reinitialization functions */
+SUNDIALS_EXPORT void* ExpRBStepCreate(ARKRhsFn f, sunrealtype t0, N_Vector y0,
+                                      SUNContext sunctx);
+SUNDIALS_EXPORT int ExpRBStepReInit(void* arkode_mem, ARKRhsFn f,
+                                    sunrealtype t0, N_Vector y0);
+
+/* Optional input functions -- must be called AFTER ExpRBStepCreate */
+SUNDIALS_EXPORT int ExpRBStepSetJacTimes(void* arkode_mem,
+                                         ARKLsJacTimesVecFn jtimes);
+SUNDIALS_EXPORT int ExpRBStepSetMaxKrylovDim(void* arkode_mem, int maxl);
+SUNDIALS_EXPORT int ExpRBStepSetEpsKrylov(void* arkode_mem,
+                                          sunrealtype eps_krylov);
+SUNDIALS_EXPORT int ExpRBStepSetAutonomous(void* arkode_mem,
+                                           sunbooleantype autonomous);
+
+/* Optional output functions */
+SUNDIALS_EXPORT int ExpRBStepGetNumRhsEvals(void* arkode_mem, long int* fevals);
+SUNDIALS_EXPORT int ExpRBStepGetNumJtimesEvals(void* arkode_mem,
+                                               long int* njvevals);
+SUNDIALS_EXPORT int ExpRBStepGetNumKrylovIters(void* arkode_mem,
+                                               long int* nkiters);
+SUNDIALS_EXPORT int ExpRBStepGetNumKrylovConvFails(void* arkode_mem,
+                                                   long int* nkcfails);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
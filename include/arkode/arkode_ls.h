@@ -99,6 +99,8 @@ SUNDIALS_EXPORT int ARKodeSetMassLinearSolver(void* arkode_mem,
 SUNDIALS_EXPORT int ARKodeSetJacFn(void* arkode_mem, ARKLsJacFn jac);
 SUNDIALS_EXPORT int ARKodeSetMassFn(void* arkode_mem, ARKLsMassFn mass);
 SUNDIALS_EXPORT int ARKodeSetJacEvalFrequency(void* arkode_mem, long int msbj);
+SUNDIALS_EXPORT int ARKodeSetJacEvalCostModel(void* arkode_mem,
+                                              sunbooleantype onoff);
 SUNDIALS_EXPORT int ARKodeSetLinearSolutionScaling(void* arkode_mem,
                                                    sunbooleantype onoff);
 SUNDIALS_EXPORT int ARKodeSetEpsLin(void* arkode_mem, sunrealtype eplifac);
@@ -106,6 +108,12 @@ SUNDIALS_EXPORT int ARKodeSetMassEpsLin(void* arkode_mem, sunrealtype eplifac);
 SUNDIALS_EXPORT int ARKodeSetLSNormFactor(void* arkode_mem, sunrealtype nrmfac);
 SUNDIALS_EXPORT int ARKodeSetMassLSNormFactor(void* arkode_mem,
                                               sunrealtype nrmfac);
+SUNDIALS_EXPORT int ARKodeSetLSForcing(void* arkode_mem, sunbooleantype adaptive);
+SUNDIALS_EXPORT int ARKodeSetLSForcingParams(void* arkode_mem,
+                                             sunrealtype fgamma,
+                                             sunrealtype falpha);
+SUNDIALS_EXPORT int ARKodeSetLSForcingMaxRelax(void* arkode_mem,
+                                               sunrealtype frelax);
 SUNDIALS_EXPORT int ARKodeSetPreconditioner(void* arkode_mem,
                                             ARKLsPrecSetupFn psetup,
                                             ARKLsPrecSolveFn psolve);
@@ -117,6 +125,8 @@ SUNDIALS_EXPORT int ARKodeSetJacTimes(void* arkode_mem,
                                       ARKLsJacTimesVecFn jtimes);
 SUNDIALS_EXPORT int ARKodeSetJacTimesRhsFn(void* arkode_mem,
                                            ARKRhsFn jtimesRhsFn);
+SUNDIALS_EXPORT int ARKodeSetJacTimesDirFn(void* arkode_mem,
+                                           ARKRhsDirFn jtimesDirFn);
 SUNDIALS_EXPORT int ARKodeSetMassTimes(void* arkode_mem,
                                        ARKLsMassTimesSetupFn msetup,
                                        ARKLsMassTimesVecFn mtimes,
@@ -81,6 +81,12 @@ static const int MRISTEP_DEFAULT_IMEX_SD_2 = ARKODE_IMEX_MRI_GARK_TRAPEZOIDAL;
 static const int MRISTEP_DEFAULT_IMEX_SD_3 = ARKODE_IMEX_MRI_GARK3b;
 static const int MRISTEP_DEFAULT_IMEX_SD_4 = ARKODE_IMEX_MRI_GARK4;
 
+/* Default embedded MRI coupling tables for adaptive slow time steps */
+static const int MRISTEP_DEFAULT_EXPL_2_AD    = ARKODE_MRI_GARK_ERK22b;
+static const int MRISTEP_DEFAULT_EXPL_3_AD    = ARKODE_MRI_GARK_ERK33a;
+static const int MRISTEP_DEFAULT_EXPL_4_AD    = ARKODE_MRI_GARK_ERK45a;
+static const int MRISTEP_DEFAULT_IMPL_SD_2_AD = ARKODE_MRI_GARK_IRK21a;
+
 /* ------------------------------------
  * MRIStep Inner Stepper Function Types
  * ------------------------------------ */
@@ -94,18 +100,26 @@ typedef int (*MRIStepInnerFullRhsFn)(MRIStepInnerStepper stepper, sunrealtype t,
 typedef int (*MRIStepInnerResetFn)(MRIStepInnerStepper stepper, sunrealtype tR,
                                    N_Vector yR);
 
+typedef int (*MRIStepInnerGetAccumulatedError)(MRIStepInnerStepper stepper,
+                                               sunrealtype* accum_error);
+
+typedef int (*MRIStepInnerResetAccumulatedError)(MRIStepInnerStepper stepper);
+
+typedef int (*MRIStepInnerSetRTol)(MRIStepInnerStepper stepper,
+                                   sunrealtype rtol);
+
 /*---------------------------------------------------------------
   MRI coupling data structure and associated utility routines
   ---------------------------------------------------------------*/
 struct MRIStepCouplingMem
 {
   int nmat;         /* number of MRI coupling matrices                   */
-  int stages;       /* size of coupling matrices (stages * stages)       */
+  int stages;       /* number of stages (last row of W, G is embedding)  */
   int q;            /* method order of accuracy                          */
   int p;            /* embedding order of accuracy                       */
   sunrealtype* c;   /* stage abscissae                                   */
-  sunrealtype*** W; /* explicit coupling matrices [nmat][stages][stages] */
-  sunrealtype*** G; /* implicit coupling matrices [nmat][stages][stages] */
+  sunrealtype*** W; /* explicit coupling [nmat][stages+1][stages]        */
+  sunrealtype*** G; /* implicit coupling [nmat][stages+1][stages]        */
 };
 
 typedef _SUNDIALS_STRUCT_ MRIStepCouplingMem* MRIStepCoupling;
@@ -149,6 +163,9 @@ typedef int (*MRIStepPostInnerFn)(sunrealtype t, N_Vector y, void* user_data);
 SUNDIALS_EXPORT void* MRIStepCreate(ARKRhsFn fse, ARKRhsFn fsi, sunrealtype t0,
                                     N_Vector y0, MRIStepInnerStepper stepper,
                                     SUNContext sunctx);
+SUNDIALS_EXPORT void* MRIStepCreatePartitioned(ARKRhsFn f, N_Vector fast_mask,
+                                               sunrealtype t0, N_Vector y0,
+                                               SUNContext sunctx);
 SUNDIALS_EXPORT int MRIStepReInit(void* arkode_mem, ARKRhsFn fse, ARKRhsFn fsi,
                                   sunrealtype t0, N_Vector y0);
 
@@ -165,6 +182,8 @@ SUNDIALS_EXPORT int MRIStepGetNumRhsEvals(void* arkode_mem, long int* nfse_evals
 SUNDIALS_EXPORT int MRIStepGetCurrentCoupling(void* arkode_mem,
                                               MRIStepCoupling* MRIC);
 SUNDIALS_EXPORT int MRIStepGetLastInnerStepFlag(void* arkode_mem, int* flag);
+SUNDIALS_EXPORT int MRIStepGetPartitionedInnerMem(void* arkode_mem,
+                                                  void** inner_arkode_mem);
 
 /* Custom inner stepper functions */
 SUNDIALS_EXPORT int MRIStepInnerStepper_Create(SUNContext sunctx,
@@ -180,6 +199,12 @@ SUNDIALS_EXPORT int MRIStepInnerStepper_SetFullRhsFn(MRIStepInnerStepper stepper
                                                      MRIStepInnerFullRhsFn fn);
 SUNDIALS_EXPORT int MRIStepInnerStepper_SetResetFn(MRIStepInnerStepper stepper,
                                                    MRIStepInnerResetFn fn);
+SUNDIALS_EXPORT int MRIStepInnerStepper_SetAccumulatedErrorGetFn(
+  MRIStepInnerStepper stepper, MRIStepInnerGetAccumulatedError fn);
+SUNDIALS_EXPORT int MRIStepInnerStepper_SetAccumulatedErrorResetFn(
+  MRIStepInnerStepper stepper, MRIStepInnerResetAccumulatedError fn);
+SUNDIALS_EXPORT int MRIStepInnerStepper_SetRTolFn(MRIStepInnerStepper stepper,
+                                                  MRIStepInnerSetRTol fn);
 SUNDIALS_EXPORT int MRIStepInnerStepper_AddForcing(MRIStepInnerStepper stepper,
                                                    sunrealtype t, N_Vector f);
 SUNDIALS_EXPORT int MRIStepInnerStepper_GetForcingData(
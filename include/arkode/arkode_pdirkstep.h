@@ -0,0 +1,68 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the ARKODE PDIRKStep module.
+ * -----------------------------------------------------------------*/
+
+#ifndef _ARKODE_PDIRKSTEP_H
+#define _ARKODE_PDIRKSTEP_H
+
+#include <arkode/arkode.h>
+#include <arkode/arkode_ls.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -----------------
+ * PDIRKStep Constants
+ * ----------------- */
+
+typedef enum
+{
+  ARKODE_PDIRK_RADAU_2_3,
+  ARKODE_PDIRK_RADAU_3_5
+} ARKODE_PDIRKMethodType;
+
+/* -------------------
+ * Exported Functions
+ * ------------------- */
+
+/* Creation and Reinitialization functions */
+SUNDIALS_EXPORT void* PDIRKStepCreate(ARKRhsFn f, sunrealtype t0, N_Vector y0,
+                                      SUNContext sunctx);
+SUNDIALS_EXPORT int PDIRKStepReInit(void* arkode_mem, ARKRhsFn f,
+                                    sunrealtype t0, N_Vector y0);
+
+/* Linear solver interface -- must be called AFTER PDIRKStepCreate */
+SUNDIALS_EXPORT int PDIRKStepSetLinearSolvers(void* arkode_mem, int num,
+                                              SUNLinearSolver* LS, SUNMatrix* A);
+SUNDIALS_EXPORT int PDIRKStepSetJacFn(void* arkode_mem, ARKLsJacFn jac);
+
+/* Optional input functions -- must be called AFTER PDIRKStepCreate */
+SUNDIALS_EXPORT int PDIRKStepSetMethod(void* arkode_mem,
+                                       ARKODE_PDIRKMethodType method);
+SUNDIALS_EXPORT int PDIRKStepSetMethodByName(void* arkode_mem,
+                                             const char* emethod);
+SUNDIALS_EXPORT int PDIRKStepSetNumIterations(void* arkode_mem, int niters);
+SUNDIALS_EXPORT int PDIRKStepSetNumThreads(void* arkode_mem, int nthreads);
+SUNDIALS_EXPORT int PDIRKStepSetJacEvalFrequency(void* arkode_mem,
+                                                 long int msbj);
+
+/* Optional output functions */
+SUNDIALS_EXPORT int PDIRKStepGetNumRhsEvals(void* arkode_mem, long int* fevals);
+SUNDIALS_EXPORT int PDIRKStepGetNumJacEvals(void* arkode_mem, long int* njevals);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,64 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the ARKODE RadauStep module.
+ * -----------------------------------------------------------------*/
+
+#ifndef _ARKODE_RADAUSTEP_H
+#define _ARKODE_RADAUSTEP_H
+
+#include <arkode/arkode.h>
+#include <arkode/arkode_ls.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -----------------
+ * RadauStep Constants
+ * ----------------- */
+
+typedef enum
+{
+  ARKODE_RADAU_3_5,
+  ARKODE_RADAU_5_9
+} ARKODE_RadauMethodType;
+
+/* -------------------
+ * Exported Functions
+ * ------------------- */
+
+/* Creation and Reinitialization functions */
+SUNDIALS_EXPORT void* RadauStepCreate(ARKRhsFn f, sunrealtype t0, N_Vector y0,
+                                      SUNContext sunctx);
+SUNDIALS_EXPORT int RadauStepReInit(void* arkode_mem, ARKRhsFn f,
+                                    sunrealtype t0, N_Vector y0);
+
+/* Jacobian interface -- must be called AFTER RadauStepCreate */
+SUNDIALS_EXPORT int RadauStepSetJacFn(void* arkode_mem, ARKLsJacFn jac);
+
+/* Optional input functions -- must be called AFTER RadauStepCreate */
+SUNDIALS_EXPORT int RadauStepSetMethod(void* arkode_mem,
+                                       ARKODE_RadauMethodType method);
+SUNDIALS_EXPORT int RadauStepSetMethodByName(void* arkode_mem,
+                                             const char* emethod);
+SUNDIALS_EXPORT int RadauStepSetJacReuseThreshold(void* arkode_mem,
+                                                  sunrealtype thet);
+
+/* Optional output functions */
+SUNDIALS_EXPORT int RadauStepGetNumRhsEvals(void* arkode_mem, long int* fevals);
+SUNDIALS_EXPORT int RadauStepGetNumJacEvals(void* arkode_mem, long int* njevals);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
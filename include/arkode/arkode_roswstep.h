@@ -0,0 +1,60 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the ARKODE RosWStep module.
+ * -----------------------------------------------------------------*/
+
+#ifndef _ARKODE_ROSWSTEP_H
+#define _ARKODE_ROSWSTEP_H
+
+#include <arkode/arkode.h>
+#include <arkode/arkode_ls.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -----------------
+ * RosWStep Constants
+ * ----------------- */
+
+typedef enum
+{
+  ARKODE_ROSW_ROS2,
+  ARKODE_ROSW_ROS34PW2
+} ARKODE_RosWMethodType;
+
+/* -------------------
+ * Exported Functions
+ * ------------------- */
+
+/* Creation and Reinitialization functions */
+SUNDIALS_EXPORT void* RosWStepCreate(ARKRhsFn f, sunrealtype t0, N_Vector y0,
+                                     SUNContext sunctx);
+SUNDIALS_EXPORT int RosWStepReInit(void* arkode_mem, ARKRhsFn f,
+                                   sunrealtype t0, N_Vector y0);
+
+/* Optional input functions -- must be called AFTER RosWStepCreate */
+SUNDIALS_EXPORT int RosWStepSetMethod(void* arkode_mem,
+                                      ARKODE_RosWMethodType method);
+SUNDIALS_EXPORT int RosWStepSetMethodByName(void* arkode_mem,
+                                            const char* emethod);
+
+/* Optional output functions */
+SUNDIALS_EXPORT int RosWStepGetNumRhsEvals(void* arkode_mem, long int* fevals);
+SUNDIALS_EXPORT int RosWStepGetNumLinSolves(void* arkode_mem,
+                                            long int* nlinsolves);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
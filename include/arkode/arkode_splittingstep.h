@@ -0,0 +1,129 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the ARKODE SplittingStep module.
+ * -----------------------------------------------------------------*/
+
+#ifndef _ARKODE_SPLITTINGSTEP_H
+#define _ARKODE_SPLITTINGSTEP_H
+
+#include <arkode/arkode.h>
+#include <arkode/arkode_mristep.h>
+#include <stdio.h>
+#include <sundials/sundials_types.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* -----------------------
+ * Splitting coefficients
+ * ----------------------- */
+
+typedef enum
+{
+  ARKODE_SPLITTING_NONE              = -1, /* ensure enum is signed int */
+  ARKODE_MIN_SPLITTING_NUM           = 0,
+  ARKODE_SPLITTING_LIE_TROTTER_1_1_2 = ARKODE_MIN_SPLITTING_NUM,
+  ARKODE_SPLITTING_STRANG_2_2_2,
+  ARKODE_SPLITTING_BEST_2_2_2,
+  ARKODE_SPLITTING_RUTH_3_3_2,
+  ARKODE_SPLITTING_YOSHIDA_4_4_2,
+  ARKODE_SPLITTING_YOSHIDA_8_6_2,
+  ARKODE_MAX_SPLITTING_NUM = ARKODE_SPLITTING_YOSHIDA_8_6_2
+} ARKODE_SplittingCoefficientsID;
+
+/*---------------------------------------------------------------
+  Types : struct SplittingStepCoefficientsMem,
+          SplittingStepCoefficients
+  ---------------------------------------------------------------
+  A splitting method is a linear combination, with weights alpha,
+  of sequential methods. Each sequential method consists of
+  stages, and in stage j partition k is evolved from
+  tn + beta[i][j][k] h to tn + beta[i][j+1][k] h for sequential
+  method i. Partitions are evolved in increasing order within a
+  stage, and beta[i][0][k] = 0.
+  ---------------------------------------------------------------*/
+struct SplittingStepCoefficientsMem
+{
+  sunrealtype* alpha;     /* weights of the sequential methods [methods] */
+  sunrealtype*** beta;    /* substep times [methods][stages+1][partitions] */
+  int sequential_methods; /* number of sequential methods                */
+  int stages;             /* number of stages per sequential method      */
+  int partitions;         /* number of partitions                        */
+  int order;              /* order of accuracy                           */
+};
+
+typedef _SUNDIALS_STRUCT_ SplittingStepCoefficientsMem*
+  SplittingStepCoefficients;
+
+/* Splitting coefficient functions */
+SUNDIALS_EXPORT SplittingStepCoefficients SplittingStepCoefficients_Alloc(
+  int sequential_methods, int stages, int partitions);
+SUNDIALS_EXPORT SplittingStepCoefficients SplittingStepCoefficients_Create(
+  int sequential_methods, int stages, int partitions, int order,
+  const sunrealtype* alpha, const sunrealtype* beta);
+SUNDIALS_EXPORT void SplittingStepCoefficients_Free(
+  SplittingStepCoefficients coefficients);
+SUNDIALS_EXPORT SplittingStepCoefficients
+SplittingStepCoefficients_Copy(SplittingStepCoefficients coefficients);
+SUNDIALS_EXPORT void SplittingStepCoefficients_Write(
+  SplittingStepCoefficients coefficients, FILE* outfile);
+
+SUNDIALS_EXPORT SplittingStepCoefficients
+SplittingStepCoefficients_LoadCoefficients(ARKODE_SplittingCoefficientsID id);
+SUNDIALS_EXPORT SplittingStepCoefficients
+SplittingStepCoefficients_LoadCoefficientsByName(const char* name);
+SUNDIALS_EXPORT const char* SplittingStepCoefficients_IDToName(
+  ARKODE_SplittingCoefficientsID id);
+
+SUNDIALS_EXPORT SplittingStepCoefficients
+SplittingStepCoefficients_LieTrotter(int partitions);
+SUNDIALS_EXPORT SplittingStepCoefficients
+SplittingStepCoefficients_Strang(int partitions);
+SUNDIALS_EXPORT SplittingStepCoefficients
+SplittingStepCoefficients_Parallel(int partitions);
+SUNDIALS_EXPORT SplittingStepCoefficients
+SplittingStepCoefficients_SymmetricParallel(int partitions);
+SUNDIALS_EXPORT SplittingStepCoefficients
+SplittingStepCoefficients_TripleJump(int partitions, int order);
+SUNDIALS_EXPORT SplittingStepCoefficients
+SplittingStepCoefficients_SuzukiFractal(int partitions, int order);
+
+/* -------------------
+ * Exported Functions
+ * ------------------- */
+
+/* Creation and Reinitialization functions */
+SUNDIALS_EXPORT void* SplittingStepCreate(MRIStepInnerStepper* steppers,
+                                          int partitions, sunrealtype t0,
+                                          N_Vector y0, SUNContext sunctx);
+SUNDIALS_EXPORT int SplittingStepReInit(void* arkode_mem,
+                                        MRIStepInnerStepper* steppers,
+                                        int partitions, sunrealtype t0,
+                                        N_Vector y0);
+
+/* Optional input functions -- must be called AFTER SplittingStepCreate */
+SUNDIALS_EXPORT int SplittingStepSetCoefficients(
+  void* arkode_mem, SplittingStepCoefficients coefficients);
+SUNDIALS_EXPORT int SplittingStepSetMethodSteppers(
+  void* arkode_mem, int method, MRIStepInnerStepper* steppers);
+SUNDIALS_EXPORT int SplittingStepSetNumThreads(void* arkode_mem, int nthreads);
+
+/* Optional output functions */
+SUNDIALS_EXPORT int SplittingStepGetNumEvolves(void* arkode_mem, int partition,
+                                               long int* evolves);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -81,6 +81,8 @@ extern "C" {
 
 #define CV_CONTEXT_ERR -32
 
+#define CV_OUTPUTFUNC_FAIL -33
+
 #define CV_UNRECOGNIZED_ERR -99
 
 /* ------------------------------
@@ -89,9 +91,16 @@ extern "C" {
 
 typedef int (*CVRhsFn)(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data);
 
+typedef int (*CVRhsDirFn)(sunrealtype t, N_Vector y, N_Vector v, N_Vector ydot,
+                          N_Vector Jv, void* user_data);
+
 typedef int (*CVRootFn)(sunrealtype t, N_Vector y, sunrealtype* gout,
                         void* user_data);
 
+typedef int (*CVRootSubsetFn)(sunrealtype t, N_Vector y, int nsub,
+                              const int* isub, sunrealtype* gout,
+                              void* user_data);
+
 typedef int (*CVEwtFn)(N_Vector y, N_Vector ewt, void* user_data);
 
 typedef int (*CVMonitorFn)(void* cvode_mem, void* user_data);
@@ -107,6 +116,10 @@ SUNDIALS_EXPORT int CVodeInit(void* cvode_mem, CVRhsFn f, sunrealtype t0,
                               N_Vector y0);
 SUNDIALS_EXPORT int CVodeReInit(void* cvode_mem, sunrealtype t0, N_Vector y0);
 
+/* Checkpoint/restart functions */
+SUNDIALS_EXPORT int CVodeWriteState(void* cvode_mem, FILE* fp);
+SUNDIALS_EXPORT int CVodeReadState(void* cvode_mem, FILE* fp);
+
 /* Tolerance input functions */
 SUNDIALS_EXPORT int CVodeSStolerances(void* cvode_mem, sunrealtype reltol,
                                       sunrealtype abstol);
@@ -135,6 +148,9 @@ SUNDIALS_EXPORT int CVodeSetNlsRhsFn(void* cvode_mem, CVRhsFn f);
 SUNDIALS_EXPORT int CVodeSetNonlinConvCoef(void* cvode_mem, sunrealtype nlscoef);
 SUNDIALS_EXPORT int CVodeSetNonlinearSolver(void* cvode_mem,
                                             SUNNonlinearSolver NLS);
+SUNDIALS_EXPORT int CVodeSetOutputFn(void* cvode_mem, SUNOutputFn fn,
+                                     void* output_data);
+SUNDIALS_EXPORT int CVodeSetRhsDirFn(void* cvode_mem, CVRhsDirFn fdir);
 SUNDIALS_EXPORT int CVodeSetStabLimDet(void* cvode_mem, sunbooleantype stldet);
 SUNDIALS_EXPORT int CVodeSetStopTime(void* cvode_mem, sunrealtype tstop);
 SUNDIALS_EXPORT int CVodeSetInterpolateStopTime(void* cvode_mem,
@@ -173,6 +189,7 @@ SUNDIALS_EXPORT int CVodeRootInit(void* cvode_mem, int nrtfn, CVRootFn g);
 /* Rootfinding optional input functions */
 SUNDIALS_EXPORT int CVodeSetRootDirection(void* cvode_mem, int* rootdir);
 SUNDIALS_EXPORT int CVodeSetNoInactiveRootWarn(void* cvode_mem);
+SUNDIALS_EXPORT int CVodeSetRootSubsetFn(void* cvode_mem, CVRootSubsetFn gsub);
 
 /* Solver function */
 SUNDIALS_EXPORT int CVode(void* cvode_mem, sunrealtype tout, N_Vector yout,
@@ -184,6 +201,9 @@ SUNDIALS_EXPORT int CVodeComputeState(void* cvode_mem, N_Vector ycor, N_Vector y
 /* Dense output function */
 SUNDIALS_EXPORT int CVodeGetDky(void* cvode_mem, sunrealtype t, int k,
                                 N_Vector dky);
+SUNDIALS_EXPORT int CVodeGetDkyBatch(void* cvode_mem, int nt,
+                                     const sunrealtype* t, int k,
+                                     N_Vector* dky);
 
 /* Optional output functions */
 SUNDIALS_EXPORT int CVodeGetWorkSpace(void* cvode_mem, long int* lenrw,
@@ -0,0 +1,52 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the CVBLOCKPRE module, which provides
+ * a block-diagonal difference quotient Jacobian-based preconditioner
+ * for problems whose state is an NVECTOR_MANYVECTOR. Each subvector
+ * is one diagonal block of the preconditioner.
+ * -----------------------------------------------------------------*/
+
+#ifndef _CVBLOCKPRE_H
+#define _CVBLOCKPRE_H
+
+#include <sundials/sundials_nvector.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Block sweeps */
+
+#define CV_BLOCKPRE_JACOBI       1
+#define CV_BLOCKPRE_GAUSS_SEIDEL 2
+
+/* BlockPrec inititialization function */
+
+SUNDIALS_EXPORT int CVBlockPrecInit(void* cvode_mem, int sweep,
+                                    sunindextype* mu, sunindextype* ml);
+
+/* Optional input functions */
+
+SUNDIALS_EXPORT int CVBlockPrecSetNumThreads(void* cvode_mem, int nthreads);
+
+/* Optional output functions */
+
+SUNDIALS_EXPORT int CVBlockPrecGetWorkSpace(void* cvode_mem, long int* lenrwBLP,
+                                            long int* leniwBLP);
+SUNDIALS_EXPORT int CVBlockPrecGetNumRhsEvals(void* cvode_mem,
+                                              long int* nfevalsBLP);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
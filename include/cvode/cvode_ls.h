@@ -85,12 +85,25 @@ SUNDIALS_EXPORT int CVodeSetLinearSolver(void* cvode_mem, SUNLinearSolver LS,
 
 SUNDIALS_EXPORT int CVodeSetJacFn(void* cvode_mem, CVLsJacFn jac);
 SUNDIALS_EXPORT int CVodeSetJacEvalFrequency(void* cvode_mem, long int msbj);
+SUNDIALS_EXPORT int CVodeSetJacEvalCostModel(void* cvode_mem,
+                                             sunbooleantype onoff);
+SUNDIALS_EXPORT int CVodeSetJacColumnTracking(void* cvode_mem,
+                                              sunbooleantype onoff,
+                                              sunrealtype dytol);
+SUNDIALS_EXPORT int CVodeSetNumJacUpdatedColumns(void* cvode_mem,
+                                                 sunindextype ncols);
 SUNDIALS_EXPORT int CVodeSetLinearSolutionScaling(void* cvode_mem,
                                                   sunbooleantype onoff);
 SUNDIALS_EXPORT int CVodeSetDeltaGammaMaxBadJac(void* cvode_mem,
                                                 sunrealtype dgmax_jbad);
 SUNDIALS_EXPORT int CVodeSetEpsLin(void* cvode_mem, sunrealtype eplifac);
 SUNDIALS_EXPORT int CVodeSetLSNormFactor(void* arkode_mem, sunrealtype nrmfac);
+SUNDIALS_EXPORT int CVodeSetLSForcing(void* cvode_mem, sunbooleantype adaptive);
+SUNDIALS_EXPORT int CVodeSetLSForcingParams(void* cvode_mem,
+                                            sunrealtype fgamma,
+                                            sunrealtype falpha);
+SUNDIALS_EXPORT int CVodeSetLSForcingMaxRelax(void* cvode_mem,
+                                              sunrealtype frelax);
 SUNDIALS_EXPORT int CVodeSetPreconditioner(void* cvode_mem, CVLsPrecSetupFn pset,
                                            CVLsPrecSolveFn psolve);
 SUNDIALS_EXPORT int CVodeSetJacTimes(void* cvode_mem, CVLsJacTimesSetupFn jtsetup,
@@ -119,6 +132,11 @@ SUNDIALS_EXPORT int CVodeGetLinSolveStats(void* cvode_mem, long int* njevals,
                                           long int* nliters, long int* nlcfails,
                                           long int* npevals, long int* npsolves,
                                           long int* njtsetups, long int* njtimes);
+SUNDIALS_EXPORT int CVodeGetLinSolveTimes(void* cvode_mem, sunrealtype* tjac,
+                                          sunrealtype* tlsetup,
+                                          sunrealtype* tnls);
+SUNDIALS_EXPORT int CVodeGetNumLinSetupsSkipped(void* cvode_mem,
+                                                long int* nlsskip);
 SUNDIALS_EXPORT int CVodeGetLastLinFlag(void* cvode_mem, long int* flag);
 SUNDIALS_EXPORT char* CVodeGetLinReturnFlagName(long int flag);
 
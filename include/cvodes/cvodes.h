@@ -133,6 +133,9 @@ extern "C" {
 
 typedef int (*CVRhsFn)(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data);
 
+typedef int (*CVRhsDirFn)(sunrealtype t, N_Vector y, N_Vector v, N_Vector ydot,
+                          N_Vector Jv, void* user_data);
+
 typedef int (*CVRootFn)(sunrealtype t, N_Vector y, sunrealtype* gout,
                         void* user_data);
 
@@ -178,6 +181,10 @@ SUNDIALS_EXPORT int CVodeInit(void* cvode_mem, CVRhsFn f, sunrealtype t0,
                               N_Vector y0);
 SUNDIALS_EXPORT int CVodeReInit(void* cvode_mem, sunrealtype t0, N_Vector y0);
 
+/* Checkpoint/restart functions */
+SUNDIALS_EXPORT int CVodeWriteState(void* cvode_mem, FILE* fp);
+SUNDIALS_EXPORT int CVodeReadState(void* cvode_mem, FILE* fp);
+
 /* Tolerance input functions */
 SUNDIALS_EXPORT int CVodeSStolerances(void* cvode_mem, sunrealtype reltol,
                                       sunrealtype abstol);
@@ -206,6 +213,7 @@ SUNDIALS_EXPORT int CVodeSetNlsRhsFn(void* cvode_mem, CVRhsFn f);
 SUNDIALS_EXPORT int CVodeSetNonlinConvCoef(void* cvode_mem, sunrealtype nlscoef);
 SUNDIALS_EXPORT int CVodeSetNonlinearSolver(void* cvode_mem,
                                             SUNNonlinearSolver NLS);
+SUNDIALS_EXPORT int CVodeSetRhsDirFn(void* cvode_mem, CVRhsDirFn fdir);
 SUNDIALS_EXPORT int CVodeSetStabLimDet(void* cvode_mem, sunbooleantype stldet);
 SUNDIALS_EXPORT int CVodeSetStopTime(void* cvode_mem, sunrealtype tstop);
 SUNDIALS_EXPORT int CVodeSetInterpolateStopTime(void* cvode_mem,
@@ -370,6 +378,9 @@ SUNDIALS_EXPORT int CVodeSensEEtolerances(void* cvode_mem);
 /* Optional input specification functions */
 SUNDIALS_EXPORT int CVodeSetSensDQMethod(void* cvode_mem, int DQtype,
                                          sunrealtype DQrhomax);
+SUNDIALS_EXPORT int CVodeSetSensDQThreads(void* cvode_mem, int nthreads,
+                                          sunrealtype** p_th,
+                                          void** user_data_th);
 SUNDIALS_EXPORT int CVodeSetSensErrCon(void* cvode_mem, sunbooleantype errconS);
 SUNDIALS_EXPORT int CVodeSetSensMaxNonlinIters(void* cvode_mem, int maxcorS);
 SUNDIALS_EXPORT int CVodeSetSensParams(void* cvode_mem, sunrealtype* p,
@@ -78,6 +78,8 @@ extern "C" {
 
 #define IDA_CONTEXT_ERR -29
 
+#define IDA_OUTPUTFUNC_FAIL -30
+
 #define IDA_UNRECOGNIZED_ERROR -99
 
 /* ------------------------------
@@ -87,6 +89,10 @@ extern "C" {
 typedef int (*IDAResFn)(sunrealtype tt, N_Vector yy, N_Vector yp, N_Vector rr,
                         void* user_data);
 
+typedef int (*IDAResDirFn)(sunrealtype tt, N_Vector yy, N_Vector yp,
+                           N_Vector vy, N_Vector vyp, N_Vector rr, N_Vector Jv,
+                           void* user_data);
+
 typedef int (*IDARootFn)(sunrealtype t, N_Vector y, N_Vector yp,
                          sunrealtype* gout, void* user_data);
 
@@ -104,6 +110,10 @@ SUNDIALS_EXPORT int IDAInit(void* ida_mem, IDAResFn res, sunrealtype t0,
 SUNDIALS_EXPORT int IDAReInit(void* ida_mem, sunrealtype t0, N_Vector yy0,
                               N_Vector yp0);
 
+/* Checkpoint/restart functions */
+SUNDIALS_EXPORT int IDAWriteState(void* ida_mem, FILE* fp);
+SUNDIALS_EXPORT int IDAReadState(void* ida_mem, FILE* fp);
+
 /* Tolerance input functions */
 SUNDIALS_EXPORT int IDASStolerances(void* ida_mem, sunrealtype reltol,
                                     sunrealtype abstol);
@@ -137,6 +147,8 @@ SUNDIALS_EXPORT int IDASetMaxErrTestFails(void* ida_mem, int maxnef);
 SUNDIALS_EXPORT int IDASetSuppressAlg(void* ida_mem, sunbooleantype suppressalg);
 SUNDIALS_EXPORT int IDASetId(void* ida_mem, N_Vector id);
 SUNDIALS_EXPORT int IDASetConstraints(void* ida_mem, N_Vector constraints);
+SUNDIALS_EXPORT int IDASetOutputFn(void* ida_mem, SUNOutputFn fn,
+                                   void* output_data);
 
 /* Optional step adaptivity input functions */
 SUNDIALS_EXPORT
@@ -159,6 +171,7 @@ SUNDIALS_EXPORT int IDASetMaxNonlinIters(void* ida_mem, int maxcor);
 SUNDIALS_EXPORT int IDASetNlsResFn(void* IDA_mem, IDAResFn res);
 SUNDIALS_EXPORT int IDASetNonlinConvCoef(void* ida_mem, sunrealtype epcon);
 SUNDIALS_EXPORT int IDASetNonlinearSolver(void* ida_mem, SUNNonlinearSolver NLS);
+SUNDIALS_EXPORT int IDASetResDirFn(void* ida_mem, IDAResDirFn resdir);
 
 /* Rootfinding initialization function */
 SUNDIALS_EXPORT int IDARootInit(void* ida_mem, int nrtfn, IDARootFn g);
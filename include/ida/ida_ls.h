@@ -87,9 +87,14 @@ SUNDIALS_EXPORT int IDASetJacTimes(void* ida_mem, IDALsJacTimesSetupFn jtsetup,
                                    IDALsJacTimesVecFn jtimes);
 SUNDIALS_EXPORT int IDASetEpsLin(void* ida_mem, sunrealtype eplifac);
 SUNDIALS_EXPORT int IDASetLSNormFactor(void* ida_mem, sunrealtype nrmfac);
+SUNDIALS_EXPORT int IDASetLSForcing(void* ida_mem, sunbooleantype adaptive);
+SUNDIALS_EXPORT int IDASetLSForcingParams(void* ida_mem, sunrealtype fgamma,
+                                          sunrealtype falpha);
+SUNDIALS_EXPORT int IDASetLSForcingMaxRelax(void* ida_mem, sunrealtype frelax);
 SUNDIALS_EXPORT int IDASetLinearSolutionScaling(void* ida_mem,
                                                 sunbooleantype onoff);
 SUNDIALS_EXPORT int IDASetIncrementFactor(void* ida_mem, sunrealtype dqincfac);
+SUNDIALS_EXPORT int IDASetJacEvalCostModel(void* ida_mem, sunbooleantype onoff);
 
 /*-----------------------------------------------------------------
   Optional outputs from the IDALS linear solver interface
@@ -109,6 +114,8 @@ SUNDIALS_EXPORT int IDAGetNumLinConvFails(void* ida_mem, long int* nlcfails);
 SUNDIALS_EXPORT int IDAGetNumJTSetupEvals(void* ida_mem, long int* njtsetups);
 SUNDIALS_EXPORT int IDAGetNumJtimesEvals(void* ida_mem, long int* njvevals);
 SUNDIALS_EXPORT int IDAGetNumLinResEvals(void* ida_mem, long int* nrevalsLS);
+SUNDIALS_EXPORT int IDAGetLinSolveTimes(void* ida_mem, sunrealtype* tjac,
+                                        sunrealtype* tnls);
 SUNDIALS_EXPORT int IDAGetLastLinFlag(void* ida_mem, long int* flag);
 SUNDIALS_EXPORT char* IDAGetLinReturnFlagName(long int flag);
 
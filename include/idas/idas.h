@@ -123,6 +123,10 @@ extern "C" {
 typedef int (*IDAResFn)(sunrealtype tt, N_Vector yy, N_Vector yp, N_Vector rr,
                         void* user_data);
 
+typedef int (*IDAResDirFn)(sunrealtype tt, N_Vector yy, N_Vector yp,
+                           N_Vector vy, N_Vector vyp, N_Vector rr, N_Vector Jv,
+                           void* user_data);
+
 typedef int (*IDARootFn)(sunrealtype t, N_Vector y, N_Vector yp,
                          sunrealtype* gout, void* user_data);
 
@@ -168,6 +172,10 @@ SUNDIALS_EXPORT int IDAInit(void* ida_mem, IDAResFn res, sunrealtype t0,
 SUNDIALS_EXPORT int IDAReInit(void* ida_mem, sunrealtype t0, N_Vector yy0,
                               N_Vector yp0);
 
+/* Checkpoint/restart functions */
+SUNDIALS_EXPORT int IDAWriteState(void* ida_mem, FILE* fp);
+SUNDIALS_EXPORT int IDAReadState(void* ida_mem, FILE* fp);
+
 /* Tolerance input functions */
 SUNDIALS_EXPORT int IDASStolerances(void* ida_mem, sunrealtype reltol,
                                     sunrealtype abstol);
@@ -223,6 +231,7 @@ SUNDIALS_EXPORT int IDASetMaxNonlinIters(void* ida_mem, int maxcor);
 SUNDIALS_EXPORT int IDASetNlsResFn(void* IDA_mem, IDAResFn res);
 SUNDIALS_EXPORT int IDASetNonlinConvCoef(void* ida_mem, sunrealtype epcon);
 SUNDIALS_EXPORT int IDASetNonlinearSolver(void* ida_mem, SUNNonlinearSolver NLS);
+SUNDIALS_EXPORT int IDASetResDirFn(void* ida_mem, IDAResDirFn resdir);
 
 /* Rootfinding initialization function */
 SUNDIALS_EXPORT int IDARootInit(void* ida_mem, int nrtfn, IDARootFn g);
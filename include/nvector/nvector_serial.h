@@ -223,6 +223,9 @@ SUNErrCode N_VLinearCombinationVectorArray_Serial(int nvec, int nsum,
                                                   sunrealtype* c, N_Vector** X,
                                                   N_Vector* Z);
 
+SUNDIALS_EXPORT
+SUNErrCode N_VPascalShiftVectorArray_Serial(int nvec, N_Vector* Z);
+
 /* OPTIONAL local reduction kernels (no parallel communication) */
 SUNDIALS_EXPORT
 sunrealtype N_VWSqrSumLocal_Serial(N_Vector x, N_Vector w);
@@ -281,6 +284,9 @@ SUNDIALS_EXPORT
 SUNErrCode N_VEnableLinearCombinationVectorArray_Serial(N_Vector v,
                                                         sunbooleantype tf);
 
+SUNDIALS_EXPORT
+SUNErrCode N_VEnablePascalShiftVectorArray_Serial(N_Vector v, sunbooleantype tf);
+
 #ifdef __cplusplus
 }
 #endif
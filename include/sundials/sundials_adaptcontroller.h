@@ -31,16 +31,19 @@ extern "C" {
 #endif
 
 /* -----------------------------------------------------------------
- * SUNAdaptController types (currently, only "H" is implemented;
- * others are planned):
- *    NONE - empty controller (does nothing)
- *    H    - controls a single-rate step size
+ * SUNAdaptController types:
+ *    NONE      - empty controller (does nothing)
+ *    H         - controls a single-rate step size
+ *    MRI_H_TOL - controls the slow step size and the relative
+ *                tolerance factor of the fast time scale of a
+ *                multirate method
  * ----------------------------------------------------------------- */
 
 typedef enum
 {
   SUN_ADAPTCONTROLLER_NONE,
-  SUN_ADAPTCONTROLLER_H
+  SUN_ADAPTCONTROLLER_H,
+  SUN_ADAPTCONTROLLER_MRI_H_TOL
 } SUNAdaptController_Type;
 
 /* -----------------------------------------------------------------
@@ -71,6 +74,15 @@ struct _generic_SUNAdaptController_Ops
   SUNErrCode (*seterrorbias)(SUNAdaptController C, sunrealtype bias);
   SUNErrCode (*updateh)(SUNAdaptController C, sunrealtype h, sunrealtype dsm);
   SUNErrCode (*space)(SUNAdaptController C, long int* lenrw, long int* leniw);
+
+  /* REQUIRED for controllers of SUN_ADAPTCONTROLLER_MRI_H_TOL type. */
+  SUNErrCode (*estimatesteptol)(SUNAdaptController C, sunrealtype H,
+                                sunrealtype tolfac, int P, sunrealtype DSM,
+                                sunrealtype dsm, sunrealtype* Hnew,
+                                sunrealtype* tolfacnew);
+  SUNErrCode (*updatemrihtol)(SUNAdaptController C, sunrealtype H,
+                              sunrealtype tolfac, sunrealtype DSM,
+                              sunrealtype dsm);
 };
 
 /* A SUNAdaptController is a structure with an implementation-dependent
@@ -118,6 +130,22 @@ SUNErrCode SUNAdaptController_EstimateStep(SUNAdaptController C, sunrealtype h,
                                            int p, sunrealtype dsm,
                                            sunrealtype* hnew);
 
+/* Multirate step size and tolerance controller function.  This is
+   called following a slow time step with size 'H', slow local error
+   factor 'DSM' (for a method of order 'P'), and accumulated fast
+   error factor 'dsm' measured relative to the slow tolerances, where
+   the fast time scale was solved with relative tolerance 'tolfac'
+   times that of the slow time scale. The controller should estimate
+   'Hnew' and 'tolfacnew' so that the ensuing step will have 'DSM'
+   and 'dsm' values JUST BELOW 1.
+
+   Any return value other than SUN_SUCCESS will be treated as
+   an unrecoverable failure. */
+SUNDIALS_EXPORT
+SUNErrCode SUNAdaptController_EstimateStepTol(
+  SUNAdaptController C, sunrealtype H, sunrealtype tolfac, int P,
+  sunrealtype DSM, sunrealtype dsm, sunrealtype* Hnew, sunrealtype* tolfacnew);
+
 /* Function to reset the controller to its initial state, e.g., if
    it stores a small number of previous dsm or step size values. */
 SUNDIALS_EXPORT
@@ -145,6 +173,16 @@ SUNDIALS_EXPORT
 SUNErrCode SUNAdaptController_UpdateH(SUNAdaptController C, sunrealtype h,
                                       sunrealtype dsm);
 
+/* Function to notify a controller of type SUN_ADAPTCONTROLLER_MRI_H_TOL
+   that a successful time step was taken with slow stepsize H, fast
+   relative tolerance factor tolfac, and slow and fast local error
+   factors DSM and dsm, indicating that these can be saved for
+   subsequent controller functions. */
+SUNDIALS_EXPORT
+SUNErrCode SUNAdaptController_UpdateMRIHTol(SUNAdaptController C, sunrealtype H,
+                                            sunrealtype tolfac, sunrealtype DSM,
+                                            sunrealtype dsm);
+
 /* Function to return the memory requirements of the controller object. */
 SUNDIALS_EXPORT
 SUNErrCode SUNAdaptController_Space(SUNAdaptController C, long int* lenrw,
@@ -27,7 +27,9 @@
 #include <sundials/sundials_memory.h>
 #include <sundials/sundials_nonlinearsolver.h>
 #include <sundials/sundials_nvector.h>
+#include <sundials/sundials_outputwriter.h>
 #include <sundials/sundials_profiler.h>
+#include <sundials/sundials_structmg.h>
 #include <sundials/sundials_types.h>
 #include <sundials/sundials_version.h>
 
@@ -122,6 +122,8 @@ struct _generic_SUNLinearSolver_Ops
   SUNErrCode (*initialize)(SUNLinearSolver);
   int (*setup)(SUNLinearSolver, SUNMatrix);
   int (*solve)(SUNLinearSolver, SUNMatrix, N_Vector, N_Vector, sunrealtype);
+  int (*solvemulti)(SUNLinearSolver, SUNMatrix, N_Vector*, N_Vector*, int,
+                    sunrealtype);
   int (*numiters)(SUNLinearSolver);
   sunrealtype (*resnorm)(SUNLinearSolver);
   sunindextype (*lastflag)(SUNLinearSolver);
@@ -181,6 +183,10 @@ SUNDIALS_EXPORT
 int SUNLinSolSolve(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
                    sunrealtype tol);
 
+SUNDIALS_EXPORT
+int SUNLinSolSolveMulti(SUNLinearSolver S, SUNMatrix A, N_Vector* X,
+                        N_Vector* B, int nrhs, sunrealtype tol);
+
 /* TODO(CJB): We should consider changing the return type to long int since
  batched solvers could in theory return a very large number here. */
 SUNDIALS_EXPORT
@@ -161,6 +161,7 @@ struct _generic_N_Vector_Ops
                                            N_Vector**, N_Vector**);
   SUNErrCode (*nvlinearcombinationvectorarray)(int, int, sunrealtype*,
                                                N_Vector**, N_Vector*);
+  SUNErrCode (*nvpascalshiftvectorarray)(int, N_Vector*);
 
   /*
    * OPTIONAL operations with no default implementation.
@@ -292,6 +293,9 @@ SUNDIALS_EXPORT
 SUNErrCode N_VLinearCombinationVectorArray(int nvec, int nsum, sunrealtype* c,
                                            N_Vector** X, N_Vector* Z);
 
+SUNDIALS_EXPORT
+SUNErrCode N_VPascalShiftVectorArray(int nvec, N_Vector* Z);
+
 /*
  * OPTIONAL operations with no default implementation.
  */
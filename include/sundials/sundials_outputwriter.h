@@ -0,0 +1,62 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the SUNOutputWriter, which writes
+ * solution snapshots (t, y) to a binary file. When SUNDIALS is
+ * built with Pthreads, the records are written by a background
+ * thread from a pair of buffers, so that the integration and the
+ * file I/O overlap.
+ * -----------------------------------------------------------------*/
+
+#ifndef _SUNDIALS_OUTPUTWRITER_H
+#define _SUNDIALS_OUTPUTWRITER_H
+
+#include <stdio.h>
+#include <sundials/sundials_context.h>
+#include <sundials/sundials_nvector.h>
+#include <sundials/sundials_types.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/* Solution output function called by the integrators after each step */
+typedef int (*SUNOutputFn)(sunrealtype t, N_Vector y, void* output_data);
+
+typedef _SUNDIALS_STRUCT_ SUNOutputWriter_* SUNOutputWriter;
+
+SUNDIALS_EXPORT
+SUNErrCode SUNOutputWriter_Create(N_Vector tmpl, FILE* fp, SUNContext sunctx,
+                                  SUNOutputWriter* writer);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNOutputWriter_Write(SUNOutputWriter writer, sunrealtype t,
+                                 N_Vector y);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNOutputWriter_Flush(SUNOutputWriter writer);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNOutputWriter_GetNumRecords(SUNOutputWriter writer,
+                                         long int* nrecords);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNOutputWriter_Destroy(SUNOutputWriter* writer);
+
+/* SUNOutputFn that writes a record with the SUNOutputWriter output_data */
+SUNDIALS_EXPORT
+int SUNOutputWriter_OutputFn(sunrealtype t, N_Vector y, void* output_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SUNDIALS_OUTPUTWRITER_H */
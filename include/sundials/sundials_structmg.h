@@ -0,0 +1,110 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the header file for the SUNStructMG, a geometric
+ * multigrid preconditioner for problems on logically Cartesian
+ * grids. It approximately solves (c0 I - s L) z = r with one
+ * V-cycle, where L is a constant coefficient star stencil, and
+ * provides preconditioner setup and solve functions for the
+ * CVODE, ARKODE, and IDA linear solver interfaces.
+ * -----------------------------------------------------------------*/
+
+#ifndef _SUNDIALS_STRUCTMG_H
+#define _SUNDIALS_STRUCTMG_H
+
+#include <sundials/sundials_context.h>
+#include <sundials/sundials_nvector.h>
+#include <sundials/sundials_types.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+#define SUN_STRUCTMG_MAXDIM 3
+
+/* Grid of nodes distributed over a grid of processes. The local
+   nodes are stored with direction 0 varying fastest. */
+typedef struct
+{
+  int dim;                                 /* number of directions (1-3)  */
+  sunindextype n[SUN_STRUCTMG_MAXDIM];     /* global nodes per direction  */
+  sunindextype start[SUN_STRUCTMG_MAXDIM]; /* global index of first local
+                                              node in each direction      */
+  sunindextype nloc[SUN_STRUCTMG_MAXDIM];  /* local nodes per direction   */
+  int nbr[SUN_STRUCTMG_MAXDIM][2];         /* rank of the lower and upper
+                                              neighbor in comm, or -1     */
+  SUNComm comm;                            /* communicator of the ranks   */
+} SUNStructGrid;
+
+/* Star stencil of L: in direction d a node is coupled to its two
+   neighbors with weight coef[d] and to itself with -2 coef[d],
+   e.g., coef[d] = k_d / h_d^2 for the Laplacian with diffusion
+   coefficient k_d and mesh spacing h_d. The nodes on the global
+   boundary are Dirichlet nodes, (c0 I - s L) z = r is z = r / c0. */
+typedef struct
+{
+  sunrealtype coef[SUN_STRUCTMG_MAXDIM];
+} SUNStructStencil;
+
+typedef _SUNDIALS_STRUCT_ SUNStructMG_* SUNStructMG;
+
+SUNDIALS_EXPORT
+SUNErrCode SUNStructMG_Create(const SUNStructGrid* grid,
+                              const SUNStructStencil* stencil, int maxlevels,
+                              SUNContext sunctx, SUNStructMG* mg);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNStructMG_SetNumSweeps(SUNStructMG mg, int sweeps);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNStructMG_SetOperator(SUNStructMG mg, sunrealtype c0,
+                                   sunrealtype s);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNStructMG_Solve(SUNStructMG mg, N_Vector r, N_Vector z);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNStructMG_GetNumLevels(SUNStructMG mg, int* nlevels);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNStructMG_GetCoarseGrid(SUNStructMG mg, sunindextype* n);
+
+SUNDIALS_EXPORT
+SUNErrCode SUNStructMG_Destroy(SUNStructMG* mg);
+
+/* Preconditioner setup and solve functions for ODEs, with the
+   SUNStructMG passed as the preconditioner data: A = I - gamma L */
+SUNDIALS_EXPORT
+int SUNStructMG_ODEPrecSetup(sunrealtype t, N_Vector y, N_Vector fy,
+                             sunbooleantype jok, sunbooleantype* jcurPtr,
+                             sunrealtype gamma, void* P_data);
+
+SUNDIALS_EXPORT
+int SUNStructMG_ODEPrecSolve(sunrealtype t, N_Vector y, N_Vector fy,
+                             N_Vector r, N_Vector z, sunrealtype gamma,
+                             sunrealtype delta, int lr, void* P_data);
+
+/* Preconditioner setup and solve functions for DAEs, with the
+   SUNStructMG passed as the preconditioner data: A = cj I - L */
+SUNDIALS_EXPORT
+int SUNStructMG_DAEPrecSetup(sunrealtype t, N_Vector y, N_Vector yp,
+                             N_Vector res, sunrealtype cj, void* P_data);
+
+SUNDIALS_EXPORT
+int SUNStructMG_DAEPrecSolve(sunrealtype t, N_Vector y, N_Vector yp,
+                             N_Vector res, N_Vector r, N_Vector z,
+                             sunrealtype cj, sunrealtype delta, void* P_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SUNDIALS_STRUCTMG_H */
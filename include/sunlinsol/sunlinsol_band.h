@@ -70,6 +70,10 @@ SUNDIALS_EXPORT
 int SUNLinSolSolve_Band(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
                         sunrealtype tol);
 
+SUNDIALS_EXPORT
+int SUNLinSolSolveMulti_Band(SUNLinearSolver S, SUNMatrix A, N_Vector* X,
+                             N_Vector* B, int nrhs, sunrealtype tol);
+
 SUNDIALS_EXPORT
 sunindextype SUNLinSolLastFlag_Band(SUNLinearSolver S);
 
@@ -96,6 +96,8 @@ struct _SUNLinearSolverContent_KLU
   sun_klu_numeric* numeric;
   sun_klu_common common;
   KLUSolveFn klu_solver;
+  sunrealtype* rhs_work;
+  sunindextype rhs_work_len;
 };
 
 typedef struct _SUNLinearSolverContent_KLU* SUNLinearSolverContent_KLU;
@@ -129,6 +131,9 @@ SUNDIALS_EXPORT SUNErrCode SUNLinSolInitialize_KLU(SUNLinearSolver S);
 SUNDIALS_EXPORT int SUNLinSolSetup_KLU(SUNLinearSolver S, SUNMatrix A);
 SUNDIALS_EXPORT int SUNLinSolSolve_KLU(SUNLinearSolver S, SUNMatrix A,
                                        N_Vector x, N_Vector b, sunrealtype tol);
+SUNDIALS_EXPORT int SUNLinSolSolveMulti_KLU(SUNLinearSolver S, SUNMatrix A,
+                                            N_Vector* X, N_Vector* B, int nrhs,
+                                            sunrealtype tol);
 SUNDIALS_EXPORT sunindextype SUNLinSolLastFlag_KLU(SUNLinearSolver S);
 SUNDIALS_EXPORT SUNErrCode SUNLinSolSpace_KLU(SUNLinearSolver S,
                                               long int* lenrwLS,
@@ -173,6 +173,9 @@ int ARKodeResize(void* arkode_mem, N_Vector y0, sunrealtype hscale,
   /* Disable constraints */
   ark_mem->constraintsSet = SUNFALSE;
 
+  /* Disable the discrete adjoint, its record no longer fits the vectors */
+  if (ark_mem->adj_mem) { arkAdjFree(&ark_mem->adj_mem); }
+
   /* Indicate that problem needs to be initialized */
   ark_mem->initsetup  = SUNTRUE;
   ark_mem->init_type  = RESIZE_INIT;
@@ -222,6 +225,169 @@ int ARKodeReset(void* arkode_mem, sunrealtype tR, N_Vector yR)
   return (ARK_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  ARKodeWriteState:
+
+  This routine writes the data ARKODE needs to continue the
+  integration from the current internal time to the binary stream
+  fp: the current solution, step size data, and counters. The
+  solution is written with the N_Vector buffer operations, so the
+  stream holds the local (per-process) part of the state.
+  Stepper-specific data (e.g., stage counters or an MRI inner
+  integrator) and the history of the step size controller are not
+  written.
+  ---------------------------------------------------------------*/
+int ARKodeWriteState(void* arkode_mem, FILE* fp)
+{
+  ARKodeMem ark_mem;
+  int hdr[ARK_STATE_NHDR];
+  sunindextype bufsize;
+  sunbooleantype ok;
+
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  if (ark_mem->MallocDone == SUNFALSE)
+  {
+    arkProcessError(ark_mem, ARK_NO_MALLOC, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MALLOC);
+    return (ARK_NO_MALLOC);
+  }
+
+  if (fp == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_FP);
+    return (ARK_ILL_INPUT);
+  }
+
+  /* The solution is serialized with the buffer operations */
+  if (N_VBufSize(ark_mem->yn, &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    arkProcessError(ark_mem, ARK_VECTOROP_ERR, __LINE__, __func__, __FILE__,
+                    MSG_ARK_BAD_NVECTOR);
+    return (ARK_VECTOROP_ERR);
+  }
+
+  /* Write the header, the current time and solution, and the step data */
+  arkStateHeader(hdr);
+
+  ok = arkStateIO(fp, hdr, sizeof(int), ARK_STATE_NHDR, SUNTRUE) &&
+       arkStateIO(fp, &ark_mem->tn, sizeof(sunrealtype), 1, SUNTRUE) &&
+       arkStateVector(fp, ark_mem->yn, SUNTRUE) &&
+       arkStateTransfer(ark_mem, fp, SUNTRUE);
+
+  if (!ok)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_STATE_WRITE);
+    return (ARK_ILL_INPUT);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  ARKodeReadState:
+
+  This routine restores a state written by ARKodeWriteState. The
+  ARKODE memory must have been created with the same stepper and
+  vector layout and must have its tolerances and solvers attached.
+  The stepper is reset to the saved time and solution (as with
+  ARKodeReset) and the saved step size and counters are then
+  restored, so the next call to ARKodeEvolve continues with the
+  saved step size rather than estimating a new initial step. If
+  reading fails, the ARKODE memory must be reset or re-initialized
+  before it is used again.
+  ---------------------------------------------------------------*/
+int ARKodeReadState(void* arkode_mem, FILE* fp)
+{
+  ARKodeMem ark_mem;
+  int hdr[ARK_STATE_NHDR], hdr_in[ARK_STATE_NHDR];
+  int i, retval;
+  sunrealtype tR;
+  sunindextype bufsize;
+  sunbooleantype ok;
+
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  if (ark_mem->MallocDone == SUNFALSE)
+  {
+    arkProcessError(ark_mem, ARK_NO_MALLOC, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MALLOC);
+    return (ARK_NO_MALLOC);
+  }
+
+  if (fp == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_FP);
+    return (ARK_ILL_INPUT);
+  }
+
+  if (N_VBufSize(ark_mem->yn, &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    arkProcessError(ark_mem, ARK_VECTOROP_ERR, __LINE__, __func__, __FILE__,
+                    MSG_ARK_BAD_NVECTOR);
+    return (ARK_VECTOROP_ERR);
+  }
+
+  /* Check that the stream matches this integrator */
+  if (!arkStateIO(fp, hdr_in, sizeof(int), ARK_STATE_NHDR, SUNFALSE))
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_STATE_READ);
+    return (ARK_ILL_INPUT);
+  }
+
+  arkStateHeader(hdr);
+
+  ok = SUNTRUE;
+  for (i = 0; i < ARK_STATE_NHDR; i++) { ok = ok && (hdr_in[i] == hdr[i]); }
+
+  if (!ok)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_STATE_BAD);
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Read the time and solution and reset the stepper to them */
+  ok = arkStateIO(fp, &tR, sizeof(sunrealtype), 1, SUNFALSE) &&
+       arkStateVector(fp, ark_mem->yn, SUNFALSE);
+
+  if (!ok)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_STATE_READ);
+    return (ARK_ILL_INPUT);
+  }
+
+  retval = ARKodeReset(arkode_mem, tR, ark_mem->yn);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Restore the step data and counters cleared or kept by the reset */
+  if (!arkStateTransfer(ark_mem, fp, SUNFALSE))
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_STATE_READ);
+    return (ARK_ILL_INPUT);
+  }
+
+  return (ARK_SUCCESS);
+}
+
 /*---------------------------------------------------------------
   ARKodeSStolerances, ARKodeSVtolerances, ARKodeWFtolerances:
 
@@ -643,7 +809,7 @@ int ARKodeEvolve(void* arkode_mem, sunrealtype tout, N_Vector yout,
   sunbooleantype inactive_roots;
   sunrealtype dsm;
   int nflag, ncf, nef, constrfails;
-  int relax_fails;
+  int relax_fails, nretry;
   ARKodeMem ark_mem;
 
   /* used only with debugging logging */
@@ -866,7 +1032,7 @@ int ARKodeEvolve(void* arkode_mem, sunrealtype tout, N_Vector yout,
     /* Looping point for step attempts */
     dsm      = ZERO;
     attempts = ncf = nef = constrfails = ark_mem->last_kflag = 0;
-    relax_fails                                              = 0;
+    relax_fails                                              = nretry = 0;
     nflag                                                    = FIRST_CALL;
     for (;;)
     {
@@ -889,6 +1055,27 @@ int ARKodeEvolve(void* arkode_mem, sunrealtype tout, N_Vector yout,
       kflag = ark_mem->step((void*)ark_mem, &dsm, &nflag);
       if (kflag < 0) { break; }
 
+      /* the step exceeded a stability limit of the time stepper module, which
+         has set eta to the largest stable step size ratio, so retry unless
+         this happened maxncf times or the step size is already at hmin */
+      if (kflag == RETRY_STEP)
+      {
+        nretry++;
+        if ((nretry == ark_mem->maxncf) ||
+            (SUNRabs(ark_mem->h) <= ark_mem->hmin * ONEPSM))
+        {
+          kflag = ARK_CONV_FAILURE;
+          break;
+        }
+        ark_mem->h *= ark_mem->eta;
+        if (SUNRabs(ark_mem->h) < ark_mem->hmin)
+        {
+          ark_mem->h = (ark_mem->h > ZERO) ? ark_mem->hmin : -ark_mem->hmin;
+        }
+        ark_mem->next_h = ark_mem->hprime = ark_mem->h;
+        continue;
+      }
+
       /* handle solver convergence failures */
       kflag = arkCheckConvergence(ark_mem, &nflag, &ncf);
       if (kflag < 0) { break; }
@@ -953,6 +1140,10 @@ int ARKodeEvolve(void* arkode_mem, sunrealtype tout, N_Vector yout,
     /* If step attempt loop succeeded, complete step (update current time, solution,
        error stepsize history arrays; call user-supplied step postprocessing function)
        (added stuff from arkStep_PrepareNextStep -- revisit) */
+    if ((kflag == ARK_SUCCESS) && ark_mem->adj_mem)
+    {
+      kflag = arkAdjRecord(ark_mem);
+    }
     if (kflag == ARK_SUCCESS) { kflag = arkCompleteStep(ark_mem, dsm); }
 
     /* If step attempt loop failed, process flag and return to user */
@@ -1221,6 +1412,9 @@ void ARKodeFree(void** arkode_mem)
     ark_mem->relax_mem = NULL;
   }
 
+  /* free the discrete adjoint module */
+  if (ark_mem->adj_mem) { arkAdjFree(&ark_mem->adj_mem); }
+
   free(*arkode_mem);
   *arkode_mem = NULL;
 }
@@ -1415,6 +1609,7 @@ ARKodeMem arkCreate(SUNContext sunctx)
   ark_mem->step_setdefaults               = NULL;
   ark_mem->step_computestate              = NULL;
   ark_mem->step_setrelaxfn                = NULL;
+  ark_mem->step_getadjointmethod          = NULL;
   ark_mem->step_setorder                  = NULL;
   ark_mem->step_setnonlinearsolver        = NULL;
   ark_mem->step_setlinear                 = NULL;
@@ -1454,6 +1649,21 @@ ARKodeMem arkCreate(SUNContext sunctx)
   ark_mem->relax_enabled = SUNFALSE;
   ark_mem->relax_mem     = NULL;
 
+  /* Initialize discrete adjoint variables */
+  ark_mem->adj_mem = NULL;
+
+  /* Initialize accumulated error estimation */
+  ark_mem->AccumErrorType  = ARK_ACCUMERROR_NONE;
+  ark_mem->AccumError      = ZERO;
+  ark_mem->AccumErrorStart = ZERO;
+
+  /* Jacobian evaluation cost model is disabled by default */
+  ark_mem->costmodel = SUNFALSE;
+  ark_mem->tjac      = ZERO;
+  ark_mem->tjaclast  = ZERO;
+  ark_mem->tlsetup   = ZERO;
+  ark_mem->tnls      = ZERO;
+
   /* Initialize lrw and liw */
   ark_mem->lrw = 18;
   ark_mem->liw = 53; /* fcn/data ptr, int, long int, sunindextype, sunbooleantype */
@@ -1467,6 +1677,10 @@ ARKodeMem arkCreate(SUNContext sunctx)
   ark_mem->ProcessStep = NULL;
   ark_mem->ps_data     = NULL;
 
+  /* No user-supplied output function yet */
+  ark_mem->outputfn    = NULL;
+  ark_mem->output_data = NULL;
+
   /* No user-supplied stage postprocessing function yet */
   ark_mem->ProcessStage = NULL;
 
@@ -1686,6 +1900,9 @@ int arkInit(ARKodeMem ark_mem, sunrealtype t0, N_Vector y0, int init_type)
   /* Clear any previous 'tstop' */
   ark_mem->tstopset = SUNFALSE;
 
+  /* Discard any recorded steps for the discrete adjoint */
+  arkAdjRestart(ark_mem);
+
   /* Initializations on (re-)initialization call, skip on reset */
   if (init_type == FIRST_INIT)
   {
@@ -1697,6 +1914,12 @@ int arkInit(ARKodeMem ark_mem, sunrealtype t0, N_Vector y0, int init_type)
     ark_mem->netf         = 0;
     ark_mem->nconstrfails = 0;
 
+    /* Cost model timers */
+    ark_mem->tjac     = ZERO;
+    ark_mem->tjaclast = ZERO;
+    ark_mem->tlsetup  = ZERO;
+    ark_mem->tnls     = ZERO;
+
     /* Initial, old, and next step sizes */
     ark_mem->h0u    = ZERO;
     ark_mem->hold   = ZERO;
@@ -1705,6 +1928,10 @@ int arkInit(ARKodeMem ark_mem, sunrealtype t0, N_Vector y0, int init_type)
     /* Tolerance scale factor */
     ark_mem->tolsf = ONE;
 
+    /* Accumulated error estimate */
+    ark_mem->AccumError      = ZERO;
+    ark_mem->AccumErrorStart = t0;
+
     /* Reset error controller object */
     retval = SUNAdaptController_Reset(ark_mem->hadapt_mem->hcontroller);
     if (retval != SUN_SUCCESS)
@@ -1735,6 +1962,178 @@ int arkInit(ARKodeMem ark_mem, sunrealtype t0, N_Vector y0, int init_type)
   return (ARK_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  arkSetState:
+
+  This routine replaces the current solution of an integrator
+  that already sits at tR with yR, e.g., when an operator
+  splitting method has updated the state between two evolves of
+  the same partition. The step size, the error controller
+  history, and the stepper and linear solver data are kept, so
+  that the next evolve continues as after a completed step and
+  does not repeat the initial setup or force a new Jacobian. The
+  right-hand side at the new state is evaluated as at the start
+  of an integration, since the stepper would otherwise reuse
+  stage data of the old state (e.g., for FSAL methods), and the
+  interpolation history is restarted. If the integrator has not
+  taken a step yet, is not at tR, does not store the right-hand
+  side, uses rootfinding, or its stepper needs its own reset,
+  this routine falls back to ARKodeReset.
+  ---------------------------------------------------------------*/
+int arkSetState(ARKodeMem ark_mem, sunrealtype tR, N_Vector yR)
+{
+  int retval;
+
+  if (ark_mem->initsetup || !(ark_mem->initialized) || ark_mem->tn != tR ||
+      ark_mem->fn == NULL || ark_mem->step_fullrhs == NULL ||
+      ark_mem->root_mem != NULL || ark_mem->step_reset != NULL)
+  {
+    return (ARKodeReset(ark_mem, tR, yR));
+  }
+
+  ark_mem->tcur = ark_mem->tn;
+  N_VScale(ONE, yR, ark_mem->yn);
+
+  ark_mem->fn_is_current = SUNFALSE;
+  retval = ark_mem->step_fullrhs(ark_mem, ark_mem->tn, ark_mem->yn, ark_mem->fn,
+                                 ARK_FULLRHS_START);
+  if (retval != 0)
+  {
+    arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_RHSFUNC_FAILED, ark_mem->tn);
+    return (ARK_RHSFUNC_FAIL);
+  }
+  ark_mem->fn_is_current = SUNTRUE;
+
+  /* Discard any recorded steps for the discrete adjoint */
+  arkAdjRestart(ark_mem);
+
+  /* Restart the interpolation history from the new state */
+  if (ark_mem->interp != NULL)
+  {
+    retval = arkInterpInit(ark_mem, ark_mem->interp, ark_mem->tn);
+    if (retval != ARK_SUCCESS)
+    {
+      arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                      "Unable to initialize interpolation module");
+      return (retval);
+    }
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  arkStateHeader:
+
+  This routine fills the header of a state stream. A stream can
+  only be read by an integrator producing the same header.
+  ---------------------------------------------------------------*/
+void arkStateHeader(int hdr[])
+{
+  hdr[0] = ARK_STATE_ID;
+  hdr[1] = ARK_STATE_VERSION;
+  hdr[2] = (int)sizeof(sunrealtype);
+  hdr[3] = (int)sizeof(long int);
+  hdr[4] = (int)sizeof(sunindextype);
+}
+
+/*---------------------------------------------------------------
+  arkStateIO:
+
+  This routine writes (save = SUNTRUE) or reads (save = SUNFALSE)
+  n items of the given size and returns SUNFALSE on a short
+  transfer.
+  ---------------------------------------------------------------*/
+sunbooleantype arkStateIO(FILE* fp, void* data, size_t size, size_t n,
+                          sunbooleantype save)
+{
+  if (n == 0) { return (SUNTRUE); }
+  if (save) { return (fwrite(data, size, n, fp) == n); }
+  return (fread(data, size, n, fp) == n);
+}
+
+/*---------------------------------------------------------------
+  arkStateVector:
+
+  This routine writes or reads the vector v with the N_Vector
+  buffer operations. The buffer size is written first and checked
+  on reading, so a stream from a different vector layout is
+  rejected.
+  ---------------------------------------------------------------*/
+sunbooleantype arkStateVector(FILE* fp, N_Vector v, sunbooleantype save)
+{
+  sunindextype bufsize, bufsize_in;
+  void* buf;
+  sunbooleantype ok;
+
+  if (N_VBufSize(v, &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    return (SUNFALSE);
+  }
+
+  bufsize_in = bufsize;
+  if (!arkStateIO(fp, &bufsize_in, sizeof(sunindextype), 1, save) ||
+      (bufsize_in != bufsize))
+  {
+    return (SUNFALSE);
+  }
+
+  buf = malloc(bufsize);
+  if (buf == NULL) { return (SUNFALSE); }
+
+  ok = SUNTRUE;
+  if (save) { ok = (N_VBufPack(v, buf) == SUN_SUCCESS); }
+  ok = ok && arkStateIO(fp, buf, 1, (size_t)bufsize, save);
+  if (!save) { ok = ok && (N_VBufUnpack(v, buf) == SUN_SUCCESS); }
+
+  free(buf);
+
+  return (ok);
+}
+
+/*---------------------------------------------------------------
+  arkStateTransfer:
+
+  This routine writes or reads the step size data and counters in
+  a fixed order, so the same code defines the stream layout in
+  both directions.
+  ---------------------------------------------------------------*/
+#define STATE_IO(x)                                \
+  if (!arkStateIO(fp, (x), sizeof(*(x)), 1, save)) \
+  {                                                \
+    return (SUNFALSE);                             \
+  }
+
+sunbooleantype arkStateTransfer(ARKodeMem ark_mem, FILE* fp, sunbooleantype save)
+{
+  /* Step data */
+  STATE_IO(&ark_mem->terr);
+  STATE_IO(&ark_mem->tretlast);
+  STATE_IO(&ark_mem->h);
+  STATE_IO(&ark_mem->hprime);
+  STATE_IO(&ark_mem->next_h);
+  STATE_IO(&ark_mem->eta);
+  STATE_IO(&ark_mem->h0u);
+  STATE_IO(&ark_mem->hold);
+  STATE_IO(&ark_mem->tolsf);
+  STATE_IO(&ark_mem->hadapt_mem->etamax);
+
+  /* Counters */
+  STATE_IO(&ark_mem->nst_attempts);
+  STATE_IO(&ark_mem->nst);
+  STATE_IO(&ark_mem->nhnil);
+  STATE_IO(&ark_mem->ncfn);
+  STATE_IO(&ark_mem->netf);
+  STATE_IO(&ark_mem->nconstrfails);
+  STATE_IO(&ark_mem->hadapt_mem->nst_acc);
+  STATE_IO(&ark_mem->hadapt_mem->nst_exp);
+
+  return (SUNTRUE);
+}
+
+#undef STATE_IO
+
 /*---------------------------------------------------------------
   arkCheckTimestepper:
 
@@ -2068,6 +2467,44 @@ int arkInitialSetup(ARKodeMem ark_mem, sunrealtype tout)
   return (ARK_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  arkSetDirection
+
+  This routine prepares an integrator that has already taken steps
+  for an evolution to tout in the opposite direction, e.g., when it
+  evolves a partition of a splitting method with negative substeps
+  after a reset. The step sizes are negated, so the step size
+  history is kept, and the step size controller is reset.
+  ---------------------------------------------------------------*/
+int arkSetDirection(ARKodeMem ark_mem, sunrealtype tout)
+{
+  sunrealtype htmp;
+  int retval;
+
+  htmp = (ark_mem->h == ZERO) ? ark_mem->hin : ark_mem->h;
+  if ((htmp == ZERO) || ((tout - ark_mem->tcur) * htmp >= ZERO))
+  {
+    return (ARK_SUCCESS);
+  }
+
+  ark_mem->h      = -ark_mem->h;
+  ark_mem->hprime = -ark_mem->hprime;
+  ark_mem->hin    = -ark_mem->hin;
+  ark_mem->h0u    = -ark_mem->h0u;
+  ark_mem->hold   = -ark_mem->hold;
+  ark_mem->next_h = -ark_mem->next_h;
+
+  retval = SUNAdaptController_Reset(ark_mem->hadapt_mem->hcontroller);
+  if (retval != SUN_SUCCESS)
+  {
+    arkProcessError(ark_mem, ARK_CONTROLLER_ERR, __LINE__, __func__, __FILE__,
+                    "Unable to reset error controller object");
+    return (ARK_CONTROLLER_ERR);
+  }
+
+  return (ARK_SUCCESS);
+}
+
 /*---------------------------------------------------------------
   arkStopTests
 
@@ -2542,6 +2979,19 @@ int arkCompleteStep(ARKodeMem ark_mem, sunrealtype dsm)
   N_VScale(ONE, ark_mem->ycur, ark_mem->yn);
   ark_mem->fn_is_current = SUNFALSE;
 
+  /* accumulate the local error estimate (dsm is relative to reltol) */
+  switch (ark_mem->AccumErrorType)
+  {
+  case ARK_ACCUMERROR_MAX:
+    ark_mem->AccumError = SUNMAX(ark_mem->AccumError, dsm);
+    break;
+  case ARK_ACCUMERROR_SUM: ark_mem->AccumError += dsm; break;
+  case ARK_ACCUMERROR_AVG:
+    ark_mem->AccumError += dsm * SUNRabs(ark_mem->h);
+    break;
+  default: break;
+  }
+
   /* Notify time step controller object of successful step */
   retval = SUNAdaptController_UpdateH(ark_mem->hadapt_mem->hcontroller,
                                       ark_mem->h, dsm);
@@ -2565,6 +3015,13 @@ int arkCompleteStep(ARKodeMem ark_mem, sunrealtype dsm)
   ark_mem->initsetup  = SUNFALSE;
   ark_mem->firststage = SUNFALSE;
 
+  /* pass the new solution to the user-supplied output function (if supplied) */
+  if (ark_mem->outputfn != NULL)
+  {
+    retval = ark_mem->outputfn(ark_mem->tn, ark_mem->yn, ark_mem->output_data);
+    if (retval != 0) { return (ARK_OUTPUTFUNC_FAIL); }
+  }
+
   return (ARK_SUCCESS);
 }
 
@@ -2649,6 +3106,10 @@ int arkHandleFailure(ARKodeMem ark_mem, int flag)
     arkProcessError(ark_mem, ARK_POSTPROCESS_STEP_FAIL, __LINE__, __func__,
                     __FILE__, MSG_ARK_POSTPROCESS_STEP_FAIL, ark_mem->tcur);
     break;
+  case ARK_OUTPUTFUNC_FAIL:
+    arkProcessError(ark_mem, ARK_OUTPUTFUNC_FAIL, __LINE__, __func__,
+                    __FILE__, MSG_ARK_OUTPUTFUNC_FAIL, ark_mem->tcur);
+    break;
   case ARK_POSTPROCESS_STAGE_FAIL:
     arkProcessError(ark_mem, ARK_POSTPROCESS_STAGE_FAIL, __LINE__, __func__,
                     __FILE__, MSG_ARK_POSTPROCESS_STAGE_FAIL, ark_mem->tcur);
@@ -2679,6 +3140,18 @@ int arkHandleFailure(ARKodeMem ark_mem, int flag)
     arkProcessError(ark_mem, ARK_RELAX_JAC_FAIL, __LINE__, __func__, __FILE__,
                     "The relaxation Jacobian failed unrecoverably");
     break;
+  case ARK_DOMEIG_FAIL:
+    arkProcessError(ark_mem, ARK_DOMEIG_FAIL, __LINE__, __func__, __FILE__,
+                    "At t = %Lg the dominant eigenvalue estimate failed",
+                    (long double)ark_mem->tcur);
+    break;
+  case ARK_MAX_STAGE_LIMIT_FAIL:
+    arkProcessError(ark_mem, ARK_MAX_STAGE_LIMIT_FAIL, __LINE__, __func__,
+                    __FILE__,
+                    "At t = %Lg the stable step size requires more than the "
+                    "maximum number of stages",
+                    (long double)ark_mem->tcur);
+    break;
   default:
     /* This return should never happen */
     arkProcessError(ark_mem, ARK_UNRECOGNIZED_ERROR, __LINE__, __func__, __FILE__,
@@ -0,0 +1,570 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * This is the implementation file for ARKODE's discrete adjoint functionality
+ * for explicit Runge--Kutta methods.
+ *
+ * During the forward integration the start time and size of every accepted
+ * step are recorded and the solution is stored at every interval-th step
+ * (a checkpoint). The backward sweep processes one segment of steps between
+ * two checkpoints at a time: the segment is recomputed from its checkpoint,
+ * storing the stage values, and the adjoint of each step is then applied in
+ * reverse. For the step
+ *
+ *   Y_i     = y_n + h sum_{j<i} A_ij f(t_n + c_i h, Y_j),
+ *   y_{n+1} = y_n + h sum_i b_i f(t_n + c_i h, Y_i),
+ *
+ * and lambda = dJ/dy_{n+1}, the stage adjoints and the update are
+ *
+ *   w_i      = h b_i lambda + h sum_{j>i} A_ji Lambda_j,
+ *   Lambda_i = (df/dy)^T(t_n + c_i h, Y_i) w_i,
+ *   mu      += (df/dp)^T(t_n + c_i h, Y_i) w_i,
+ *   dJ/dy_n  = lambda + sum_i Lambda_i.
+ *
+ * At most interval steps of stage values are stored at a time, so the memory
+ * is bounded by the checkpoints plus interval * stages vectors, and the
+ * backward sweep costs one extra forward integration.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode_adjoint_impl.h"
+#include "arkode_impl.h"
+
+/* =============================================================================
+ * Private Functions
+ * ===========================================================================*/
+
+/* Access the ARKODE and adjoint memory structures */
+static int arkAdjAccessMem(void* arkode_mem, const char* fname,
+                           ARKodeMem* ark_mem, ARKodeAdjMem* adj_mem)
+{
+  if (!arkode_mem)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return ARK_MEM_NULL;
+  }
+  *ark_mem = (ARKodeMem)arkode_mem;
+
+  if (!((*ark_mem)->adj_mem))
+  {
+    arkProcessError(*ark_mem, ARK_ADJ_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_ADJ_MEM_NULL);
+    return ARK_ADJ_MEM_NULL;
+  }
+  *adj_mem = (*ark_mem)->adj_mem;
+
+  return ARK_SUCCESS;
+}
+
+/* Free the backward sweep workspace */
+static void arkAdjFreeWorkspace(ARKodeAdjMem adj_mem)
+{
+  if (adj_mem->Y)
+  {
+    N_VDestroyVectorArray(adj_mem->Y, adj_mem->interval * adj_mem->stages);
+    adj_mem->Y = NULL;
+  }
+  if (adj_mem->F)
+  {
+    N_VDestroyVectorArray(adj_mem->F, adj_mem->stages);
+    adj_mem->F = NULL;
+  }
+  if (adj_mem->Lam)
+  {
+    N_VDestroyVectorArray(adj_mem->Lam, adj_mem->stages);
+    adj_mem->Lam = NULL;
+  }
+  if (adj_mem->w)
+  {
+    N_VDestroy(adj_mem->w);
+    adj_mem->w = NULL;
+  }
+  if (adj_mem->cvals)
+  {
+    free(adj_mem->cvals);
+    adj_mem->cvals = NULL;
+  }
+  if (adj_mem->Xvecs)
+  {
+    free(adj_mem->Xvecs);
+    adj_mem->Xvecs = NULL;
+  }
+  adj_mem->stages = 0;
+}
+
+/* Allocate the backward sweep workspace for a method with the given number of
+   stages (reusing an existing workspace of the same size) */
+static int arkAdjAllocWorkspace(ARKodeMem ark_mem, ARKodeAdjMem adj_mem,
+                                int stages, N_Vector mu)
+{
+  if (adj_mem->stages != stages)
+  {
+    arkAdjFreeWorkspace(adj_mem);
+
+    adj_mem->Y     = N_VCloneVectorArray(adj_mem->interval * stages, ark_mem->yn);
+    adj_mem->F     = N_VCloneVectorArray(stages, ark_mem->yn);
+    adj_mem->Lam   = N_VCloneVectorArray(stages, ark_mem->yn);
+    adj_mem->w     = N_VClone(ark_mem->yn);
+    adj_mem->cvals = (sunrealtype*)malloc((stages + 1) * sizeof(sunrealtype));
+    adj_mem->Xvecs = (N_Vector*)malloc((stages + 1) * sizeof(N_Vector));
+    adj_mem->stages = stages;
+
+    if (!(adj_mem->Y) || !(adj_mem->F) || !(adj_mem->Lam) || !(adj_mem->w) ||
+        !(adj_mem->cvals) || !(adj_mem->Xvecs))
+    {
+      arkAdjFreeWorkspace(adj_mem);
+      return ARK_MEM_FAIL;
+    }
+  }
+
+  if (mu && !(adj_mem->nu))
+  {
+    adj_mem->nu = N_VClone(mu);
+    if (!(adj_mem->nu)) { return ARK_MEM_FAIL; }
+  }
+
+  return ARK_SUCCESS;
+}
+
+/* Recompute the steps n0 <= n < n1 from the checkpoint at step n0 and store
+   their stage values in Y */
+static int arkAdjReplay(ARKodeMem ark_mem, ARKodeAdjMem adj_mem,
+                        ARKodeButcherTable B, ARKRhsFn f, long int n0,
+                        long int n1)
+{
+  int retval, i, j, nvec;
+  int s = B->stages;
+  long int n;
+  sunrealtype tn, h;
+  N_Vector* Y;
+  sunrealtype* cvals = adj_mem->cvals;
+  N_Vector* Xvecs    = adj_mem->Xvecs;
+
+  N_VScale(ONE, adj_mem->ckpnt[n0 / adj_mem->interval], adj_mem->Y[0]);
+
+  for (n = n0; n < n1; n++)
+  {
+    Y  = adj_mem->Y + (n - n0) * s;
+    tn = adj_mem->tstep[n];
+    h  = adj_mem->hstep[n];
+
+    /* stage values and right-hand sides (Y[0] holds y_n) */
+    for (i = 0; i < s; i++)
+    {
+      if (i > 0)
+      {
+        nvec = 0;
+        for (j = 0; j < i; j++)
+        {
+          cvals[nvec] = h * B->A[i][j];
+          Xvecs[nvec] = adj_mem->F[j];
+          nvec += 1;
+        }
+        cvals[nvec] = ONE;
+        Xvecs[nvec] = Y[0];
+        nvec += 1;
+
+        retval = N_VLinearCombination(nvec, cvals, Xvecs, Y[i]);
+        if (retval != 0) { return ARK_VECTOROP_ERR; }
+      }
+
+      retval = f(tn + B->c[i] * h, Y[i], adj_mem->F[i], ark_mem->user_data);
+      adj_mem->nfe++;
+      if (retval != 0) { return ARK_RHSFUNC_FAIL; }
+    }
+
+    /* step solution, i.e., the first stage of the next step in the segment */
+    if (n + 1 < n1)
+    {
+      nvec = 0;
+      for (j = 0; j < s; j++)
+      {
+        cvals[nvec] = h * B->b[j];
+        Xvecs[nvec] = adj_mem->F[j];
+        nvec += 1;
+      }
+      cvals[nvec] = ONE;
+      Xvecs[nvec] = Y[0];
+      nvec += 1;
+
+      retval = N_VLinearCombination(nvec, cvals, Xvecs, Y[s]);
+      if (retval != 0) { return ARK_VECTOROP_ERR; }
+    }
+  }
+
+  return ARK_SUCCESS;
+}
+
+/* Apply the adjoint of step n with stage values Y to lambda and mu */
+static int arkAdjStepBack(ARKodeMem ark_mem, ARKodeAdjMem adj_mem,
+                          ARKodeButcherTable B, long int n, N_Vector* Y,
+                          N_Vector lambda, N_Vector mu)
+{
+  int retval, i, j, nvec;
+  int s              = B->stages;
+  sunrealtype tn     = adj_mem->tstep[n];
+  sunrealtype h      = adj_mem->hstep[n];
+  sunrealtype* cvals = adj_mem->cvals;
+  N_Vector* Xvecs    = adj_mem->Xvecs;
+
+  for (i = s - 1; i >= 0; i--)
+  {
+    /* w_i = h b_i lambda + h sum_{j>i} A_ji Lambda_j */
+    nvec        = 0;
+    cvals[nvec] = h * B->b[i];
+    Xvecs[nvec] = lambda;
+    nvec += 1;
+    for (j = i + 1; j < s; j++)
+    {
+      if (B->A[j][i] == ZERO) { continue; }
+      cvals[nvec] = h * B->A[j][i];
+      Xvecs[nvec] = adj_mem->Lam[j];
+      nvec += 1;
+    }
+
+    retval = N_VLinearCombination(nvec, cvals, Xvecs, adj_mem->w);
+    if (retval != 0) { return ARK_VECTOROP_ERR; }
+
+    retval = adj_mem->fadj(tn + B->c[i] * h, Y[i], adj_mem->w,
+                           adj_mem->Lam[i], (mu) ? adj_mem->nu : NULL,
+                           ark_mem->user_data);
+    adj_mem->nfadj++;
+    if (retval != 0)
+    {
+      arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ADJ_RHS_FAIL, tn + B->c[i] * h);
+      return ARK_RHSFUNC_FAIL;
+    }
+
+    if (mu) { N_VLinearSum(ONE, mu, ONE, adj_mem->nu, mu); }
+  }
+
+  /* dJ/dy_n = lambda + sum_i Lambda_i */
+  nvec        = 0;
+  cvals[nvec] = ONE;
+  Xvecs[nvec] = lambda;
+  nvec += 1;
+  for (i = 0; i < s; i++)
+  {
+    cvals[nvec] = ONE;
+    Xvecs[nvec] = adj_mem->Lam[i];
+    nvec += 1;
+  }
+
+  retval = N_VLinearCombination(nvec, cvals, Xvecs, lambda);
+  if (retval != 0) { return ARK_VECTOROP_ERR; }
+
+  return ARK_SUCCESS;
+}
+
+/* =============================================================================
+ * Driver and Stepper Functions
+ * ===========================================================================*/
+
+/* Record the step that is about to be completed: its start time, its size,
+   and, at every interval-th step, the solution at its start */
+int arkAdjRecord(ARKodeMem ark_mem)
+{
+  long int i, len;
+  sunrealtype* tstep;
+  sunrealtype* hstep;
+  N_Vector* ckpnt;
+  ARKodeAdjMem adj_mem = ark_mem->adj_mem;
+
+  if (adj_mem->nsteps == adj_mem->nsteps_alloc)
+  {
+    len   = (adj_mem->nsteps_alloc > 0) ? 2 * adj_mem->nsteps_alloc : 64;
+    tstep = (sunrealtype*)realloc(adj_mem->tstep, len * sizeof(sunrealtype));
+    if (!tstep) { return ARK_MEM_FAIL; }
+    adj_mem->tstep = tstep;
+    hstep = (sunrealtype*)realloc(adj_mem->hstep, len * sizeof(sunrealtype));
+    if (!hstep) { return ARK_MEM_FAIL; }
+    adj_mem->hstep        = hstep;
+    adj_mem->nsteps_alloc = len;
+  }
+
+  if (adj_mem->nsteps % adj_mem->interval == 0)
+  {
+    if (adj_mem->nckpnt == adj_mem->nckpnt_alloc)
+    {
+      len   = (adj_mem->nckpnt_alloc > 0) ? 2 * adj_mem->nckpnt_alloc : 16;
+      ckpnt = (N_Vector*)realloc(adj_mem->ckpnt, len * sizeof(N_Vector));
+      if (!ckpnt) { return ARK_MEM_FAIL; }
+      for (i = adj_mem->nckpnt_alloc; i < len; i++) { ckpnt[i] = NULL; }
+      adj_mem->ckpnt        = ckpnt;
+      adj_mem->nckpnt_alloc = len;
+    }
+
+    /* checkpoint vectors are kept across restarts of the record */
+    if (!(adj_mem->ckpnt[adj_mem->nckpnt]))
+    {
+      adj_mem->ckpnt[adj_mem->nckpnt] = N_VClone(ark_mem->yn);
+      if (!(adj_mem->ckpnt[adj_mem->nckpnt])) { return ARK_MEM_FAIL; }
+    }
+    N_VScale(ONE, ark_mem->yn, adj_mem->ckpnt[adj_mem->nckpnt]);
+    adj_mem->nckpnt++;
+  }
+
+  adj_mem->tstep[adj_mem->nsteps] = ark_mem->tn;
+  adj_mem->hstep[adj_mem->nsteps] = ark_mem->h;
+  adj_mem->nsteps++;
+
+  return ARK_SUCCESS;
+}
+
+/* Discard the recorded steps, e.g., after a reset or reinitialization */
+void arkAdjRestart(ARKodeMem ark_mem)
+{
+  if (!(ark_mem->adj_mem)) { return; }
+  ark_mem->adj_mem->nsteps = 0;
+  ark_mem->adj_mem->nckpnt = 0;
+}
+
+/* Free the adjoint memory structure */
+void arkAdjFree(ARKodeAdjMem* adj_mem)
+{
+  long int i;
+
+  if (!(*adj_mem)) { return; }
+
+  arkAdjFreeWorkspace(*adj_mem);
+
+  if ((*adj_mem)->nu) { N_VDestroy((*adj_mem)->nu); }
+
+  if ((*adj_mem)->ckpnt)
+  {
+    for (i = 0; i < (*adj_mem)->nckpnt_alloc; i++)
+    {
+      if ((*adj_mem)->ckpnt[i]) { N_VDestroy((*adj_mem)->ckpnt[i]); }
+    }
+    free((*adj_mem)->ckpnt);
+  }
+
+  free((*adj_mem)->tstep);
+  free((*adj_mem)->hstep);
+  free(*adj_mem);
+  *adj_mem = NULL;
+}
+
+/* =============================================================================
+ * User Functions
+ * ===========================================================================*/
+
+/* -----------------------------------------------------------------------------
+ * ARKodeAdjInit:
+ *
+ * Enables the discrete adjoint and starts recording the forward integration
+ * from the current time. A checkpoint of the solution is stored every interval
+ * steps. Calling this function again discards the previous record and keeps
+ * the checkpoint storage.
+ * ---------------------------------------------------------------------------*/
+int ARKodeAdjInit(void* arkode_mem, int interval, ARKAdjRhsFn fadj)
+{
+  int retval;
+  ARKodeMem ark_mem;
+  ARKodeAdjMem adj_mem;
+  ARKodeButcherTable B;
+  ARKRhsFn f;
+
+  if (!arkode_mem)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return ARK_MEM_NULL;
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  /* Check that the stepper and method have a discrete adjoint */
+  if (!(ark_mem->step_getadjointmethod))
+  {
+    arkProcessError(ark_mem, ARK_STEPPER_UNSUPPORTED, __LINE__, __func__,
+                    __FILE__, MSG_ADJ_NO_METHOD);
+    return ARK_STEPPER_UNSUPPORTED;
+  }
+
+  retval = ark_mem->step_getadjointmethod(ark_mem, &B, &f);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    MSG_ADJ_NO_METHOD);
+    return retval;
+  }
+
+  if (ark_mem->relax_enabled)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ADJ_RELAX);
+    return ARK_ILL_INPUT;
+  }
+
+  if (!fadj)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The adjoint function is NULL.");
+    return ARK_ILL_INPUT;
+  }
+
+  if (interval < 1)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The checkpoint interval must be positive.");
+    return ARK_ILL_INPUT;
+  }
+
+  /* Create the adjoint memory or discard the previous record */
+  if (!(ark_mem->adj_mem))
+  {
+    adj_mem = (ARKodeAdjMem)calloc(1, sizeof(*adj_mem));
+    if (!adj_mem)
+    {
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_ARKMEM_FAIL);
+      return ARK_MEM_FAIL;
+    }
+    ark_mem->adj_mem = adj_mem;
+  }
+  adj_mem = ark_mem->adj_mem;
+
+  /* The stage storage depends on the interval */
+  if (adj_mem->interval != interval) { arkAdjFreeWorkspace(adj_mem); }
+
+  adj_mem->fadj      = fadj;
+  adj_mem->method_fn = ark_mem->step_getadjointmethod;
+  adj_mem->interval  = interval;
+  adj_mem->nsteps    = 0;
+  adj_mem->nckpnt    = 0;
+  adj_mem->nfe       = 0;
+  adj_mem->nfadj     = 0;
+
+  return ARK_SUCCESS;
+}
+
+/* -----------------------------------------------------------------------------
+ * ARKodeAdjSolve:
+ *
+ * Integrates the discrete adjoint backward over the recorded steps. On input
+ * lambda holds dJ/dy at the current internal time and mu (if not NULL) the
+ * direct dependence dJ/dp. On output lambda holds dJ/dy at the start of the
+ * record and mu the total derivative dJ/dp.
+ * ---------------------------------------------------------------------------*/
+int ARKodeAdjSolve(void* arkode_mem, N_Vector lambda, N_Vector mu)
+{
+  int retval;
+  long int c, n, n0, n1;
+  ARKodeMem ark_mem;
+  ARKodeAdjMem adj_mem;
+  ARKodeButcherTable B;
+  ARKRhsFn f;
+
+  retval = arkAdjAccessMem(arkode_mem, __func__, &ark_mem, &adj_mem);
+  if (retval != ARK_SUCCESS) { return retval; }
+
+  if (!lambda)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "lambda = NULL illegal.");
+    return ARK_ILL_INPUT;
+  }
+
+  if (ark_mem->relax_enabled)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ADJ_RELAX);
+    return ARK_ILL_INPUT;
+  }
+
+  retval = adj_mem->method_fn(ark_mem, &B, &f);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    MSG_ADJ_NO_METHOD);
+    return retval;
+  }
+
+  if (adj_mem->nsteps == 0) { return ARK_SUCCESS; }
+
+  retval = arkAdjAllocWorkspace(ark_mem, adj_mem, B->stages, mu);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_MEM_FAIL);
+    return ARK_MEM_FAIL;
+  }
+
+  /* Sweep backward over the segments between checkpoints */
+  for (c = adj_mem->nckpnt - 1; c >= 0; c--)
+  {
+    n0 = c * adj_mem->interval;
+    n1 = SUNMIN(n0 + adj_mem->interval, adj_mem->nsteps);
+
+    retval = arkAdjReplay(ark_mem, adj_mem, B, f, n0, n1);
+    if (retval == ARK_RHSFUNC_FAIL)
+    {
+      arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_RHSFUNC_FAILED, adj_mem->tstep[n0]);
+      return ARK_RHSFUNC_FAIL;
+    }
+    if (retval != ARK_SUCCESS) { return retval; }
+
+    for (n = n1 - 1; n >= n0; n--)
+    {
+      retval = arkAdjStepBack(ark_mem, adj_mem, B, n,
+                              adj_mem->Y + (n - n0) * B->stages, lambda, mu);
+      if (retval != ARK_SUCCESS) { return retval; }
+    }
+  }
+
+  return ARK_SUCCESS;
+}
+
+/* -----------------------------------------------------------------------------
+ * ARKodeGetNumAdjRhsEvals:
+ *
+ * Returns the number of right-hand side evaluations used to recompute the
+ * forward steps and the number of adjoint function evaluations.
+ * ---------------------------------------------------------------------------*/
+int ARKodeGetNumAdjRhsEvals(void* arkode_mem, long int* nfevals,
+                            long int* nfadjevals)
+{
+  int retval;
+  ARKodeMem ark_mem;
+  ARKodeAdjMem adj_mem;
+
+  retval = arkAdjAccessMem(arkode_mem, __func__, &ark_mem, &adj_mem);
+  if (retval != ARK_SUCCESS) { return retval; }
+
+  *nfevals    = adj_mem->nfe;
+  *nfadjevals = adj_mem->nfadj;
+
+  return ARK_SUCCESS;
+}
+
+/* -----------------------------------------------------------------------------
+ * ARKodeGetNumAdjCheckpoints:
+ *
+ * Returns the number of checkpoints in the current record.
+ * ---------------------------------------------------------------------------*/
+int ARKodeGetNumAdjCheckpoints(void* arkode_mem, long int* nckpnt)
+{
+  int retval;
+  ARKodeMem ark_mem;
+  ARKodeAdjMem adj_mem;
+
+  retval = arkAdjAccessMem(arkode_mem, __func__, &ark_mem, &adj_mem);
+  if (retval != ARK_SUCCESS) { return retval; }
+
+  *nckpnt = adj_mem->nckpnt;
+
+  return ARK_SUCCESS;
+}
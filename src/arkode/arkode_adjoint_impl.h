@@ -0,0 +1,89 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Implementation header file for ARKODE's discrete adjoint functionality.
+ * ---------------------------------------------------------------------------*/
+
+#ifndef _ARKODE_ADJOINT_IMPL_H
+#define _ARKODE_ADJOINT_IMPL_H
+
+#include <arkode/arkode.h>
+#include <arkode/arkode_butcher.h>
+#include <sundials/sundials_types.h>
+
+#include "arkode_types_impl.h"
+
+/* -----------------------------------------------------------------------------
+ * Stepper Supplied Adjoint Functions
+ * ---------------------------------------------------------------------------*/
+
+/* Get the explicit Butcher table and right-hand side function of the method.
+   Returns ARK_STEPPER_UNSUPPORTED if the current method configuration has no
+   discrete adjoint. */
+typedef int (*ARKAdjGetMethodFn)(ARKodeMem ark_mem, ARKodeButcherTable* B,
+                                 ARKRhsFn* f);
+
+/* -----------------------------------------------------------------------------
+ * Adjoint Data Structure
+ * ---------------------------------------------------------------------------*/
+
+struct ARKodeAdjMemRec
+{
+  /* user-supplied and stepper supplied functions */
+  ARKAdjRhsFn fadj;            /* user adjoint (transposed Jacobian) fn */
+  ARKAdjGetMethodFn method_fn; /* get the method from the stepper       */
+
+  /* forward step record */
+  int interval;          /* number of steps between checkpoints   */
+  long int nsteps;       /* number of recorded steps              */
+  long int nsteps_alloc; /* allocated length of tstep and hstep   */
+  sunrealtype* tstep;    /* start time of each recorded step      */
+  sunrealtype* hstep;    /* size of each recorded step            */
+  long int nckpnt;       /* number of stored checkpoints          */
+  long int nckpnt_alloc; /* allocated length of ckpnt             */
+  N_Vector* ckpnt;       /* solution at every interval-th step    */
+
+  /* backward sweep workspace */
+  int stages;     /* number of stages the workspace fits    */
+  N_Vector* Y;    /* stage values of one segment of steps   */
+  N_Vector* F;    /* stage right-hand sides of one step     */
+  N_Vector* Lam;  /* stage adjoints of one step             */
+  N_Vector w;     /* adjoint right-hand side input          */
+  N_Vector nu;    /* parameter adjoint of one stage         */
+  sunrealtype* cvals;
+  N_Vector* Xvecs;
+
+  /* counters */
+  long int nfe;   /* right-hand side evaluations in replays */
+  long int nfadj; /* adjoint function evaluations           */
+};
+
+/* -----------------------------------------------------------------------------
+ * Adjoint Functions
+ * ---------------------------------------------------------------------------*/
+
+/* Driver and Stepper Functions */
+int arkAdjRecord(ARKodeMem ark_mem);
+void arkAdjRestart(ARKodeMem ark_mem);
+void arkAdjFree(ARKodeAdjMem* adj_mem);
+
+/* -----------------------------------------------------------------------------
+ * Error Messages
+ * ---------------------------------------------------------------------------*/
+
+#define MSG_ADJ_MEM_NULL "Adjoint memory is NULL."
+#define MSG_ADJ_NO_METHOD \
+  "time-stepping module does not support the discrete adjoint"
+#define MSG_ADJ_RELAX "Relaxation is not supported with the discrete adjoint."
+#define MSG_ADJ_RHS_FAIL \
+  "At t = %g, the adjoint right-hand side routine failed."
+
+#endif
@@ -25,6 +25,7 @@
 #include "arkode_arkstep_impl.h"
 #include "arkode_impl.h"
 #include "arkode_interp_impl.h"
+#include "arkode_mristep_impl.h"
 
 #define FIXED_LIN_TOL
 
@@ -142,6 +143,7 @@ void* ARKStepCreate(ARKRhsFn fe, ARKRhsFn fi, sunrealtype t0, N_Vector y0,
   ark_mem->step_supports_implicit         = SUNTRUE;
   ark_mem->step_supports_massmatrix       = SUNTRUE;
   ark_mem->step_supports_relaxation       = SUNTRUE;
+  ark_mem->step_getadjointmethod          = arkStep_GetAdjointMethod;
   ark_mem->step_mem                       = (void*)step_mem;
 
   /* Set default values for optional inputs */
@@ -379,6 +381,20 @@ int ARKStepCreateMRIStepInnerStepper(void* inner_arkode_mem,
   retval = MRIStepInnerStepper_SetResetFn(*stepper, arkStep_MRIStepInnerReset);
   if (retval != ARK_SUCCESS) { return (retval); }
 
+  /* internal operation without a public setter */
+  (*stepper)->ops->setstate = arkStep_MRIStepInnerSetState;
+
+  retval = MRIStepInnerStepper_SetAccumulatedErrorGetFn(
+    *stepper, arkStep_MRIStepInnerGetAccumulatedError);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  retval = MRIStepInnerStepper_SetAccumulatedErrorResetFn(
+    *stepper, arkStep_MRIStepInnerResetAccumulatedError);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  retval = MRIStepInnerStepper_SetRTolFn(*stepper, arkStep_MRIStepInnerSetRTol);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
   return (ARK_SUCCESS);
 }
 
@@ -2783,11 +2799,13 @@ int arkStep_StageSetup(ARKodeMem ark_mem, sunbooleantype implicit)
     if (retval != ARK_SUCCESS) { return (ARK_MASSMULT_FAIL); }
   }
 
-  /* Update sdata with prior stage information */
+  /* Update sdata with prior stage information (skipping zero coefficients
+     to avoid streaming unused stage vectors through memory) */
   if (step_mem->explicit)
   { /* Explicit pieces */
     for (j = 0; j < i; j++)
     {
+      if (step_mem->Be->A[i][j] == ZERO) { continue; }
       cvals[nvec] = ark_mem->h * step_mem->Be->A[i][j];
       Xvecs[nvec] = step_mem->Fe[j];
       nvec += 1;
@@ -2797,6 +2815,7 @@ int arkStep_StageSetup(ARKodeMem ark_mem, sunbooleantype implicit)
   { /* Implicit pieces */
     for (j = 0; j < i; j++)
     {
+      if (step_mem->Bi->A[i][j] == ZERO) { continue; }
       cvals[nvec] = ark_mem->h * step_mem->Bi->A[i][j];
       Xvecs[nvec] = step_mem->Fi[j];
       nvec += 1;
@@ -2830,8 +2849,12 @@ int arkStep_StageSetup(ARKodeMem ark_mem, sunbooleantype implicit)
   }
 
   /* call fused vector operation to do the work */
-  retval = N_VLinearCombination(nvec, cvals, Xvecs, step_mem->sdata);
-  if (retval != 0) { return (ARK_VECTOROP_ERR); }
+  if (nvec > 0)
+  {
+    retval = N_VLinearCombination(nvec, cvals, Xvecs, step_mem->sdata);
+    if (retval != 0) { return (ARK_VECTOROP_ERR); }
+  }
+  else { N_VConst(ZERO, step_mem->sdata); }
 
   /* return with success */
   return (ARK_SUCCESS);
@@ -2914,13 +2937,13 @@ int arkStep_ComputeSolutions(ARKodeMem ark_mem, sunrealtype* dsmPtr)
     nvec     = 1;
     for (j = 0; j < step_mem->stages; j++)
     {
-      if (step_mem->explicit)
+      if (step_mem->explicit && (step_mem->Be->b[j] != ZERO))
       { /* Explicit pieces */
         cvals[nvec] = ark_mem->h * step_mem->Be->b[j];
         Xvecs[nvec] = step_mem->Fe[j];
         nvec += 1;
       }
-      if (step_mem->implicit)
+      if (step_mem->implicit && (step_mem->Bi->b[j] != ZERO))
       { /* Implicit pieces */
         cvals[nvec] = ark_mem->h * step_mem->Bi->b[j];
         Xvecs[nvec] = step_mem->Fi[j];
@@ -2964,13 +2987,13 @@ int arkStep_ComputeSolutions(ARKodeMem ark_mem, sunrealtype* dsmPtr)
     nvec = 0;
     for (j = 0; j < step_mem->stages; j++)
     {
-      if (step_mem->explicit)
+      if (step_mem->explicit && (step_mem->Be->b[j] != step_mem->Be->d[j]))
       { /* Explicit pieces */
         cvals[nvec] = ark_mem->h * (step_mem->Be->b[j] - step_mem->Be->d[j]);
         Xvecs[nvec] = step_mem->Fe[j];
         nvec += 1;
       }
-      if (step_mem->implicit)
+      if (step_mem->implicit && (step_mem->Bi->b[j] != step_mem->Bi->d[j]))
       { /* Implicit pieces */
         cvals[nvec] = ark_mem->h * (step_mem->Bi->b[j] - step_mem->Bi->d[j]);
         Xvecs[nvec] = step_mem->Fi[j];
@@ -3005,8 +3028,12 @@ int arkStep_ComputeSolutions(ARKodeMem ark_mem, sunrealtype* dsmPtr)
     }
 
     /* call fused vector operation to do the work */
-    retval = N_VLinearCombination(nvec, cvals, Xvecs, yerr);
-    if (retval != 0) { return (ARK_VECTOROP_ERR); }
+    if (nvec > 0)
+    {
+      retval = N_VLinearCombination(nvec, cvals, Xvecs, yerr);
+      if (retval != 0) { return (ARK_VECTOROP_ERR); }
+    }
+    else { N_VConst(ZERO, yerr); }
 
     /* fill error norm */
     *dsmPtr = N_VWrmsNorm(yerr, ark_mem->ewt);
@@ -3086,13 +3113,13 @@ int arkStep_ComputeSolutions_MassFixed(ARKodeMem ark_mem, sunrealtype* dsmPtr)
     nvec = 0;
     for (j = 0; j < step_mem->stages; j++)
     {
-      if (step_mem->explicit)
+      if (step_mem->explicit && (step_mem->Be->b[j] != ZERO))
       { /* Explicit pieces */
         cvals[nvec] = ark_mem->h * step_mem->Be->b[j];
         Xvecs[nvec] = step_mem->Fe[j];
         nvec += 1;
       }
-      if (step_mem->implicit)
+      if (step_mem->implicit && (step_mem->Bi->b[j] != ZERO))
       { /* Implicit pieces */
         cvals[nvec] = ark_mem->h * step_mem->Bi->b[j];
         Xvecs[nvec] = step_mem->Fi[j];
@@ -3125,13 +3152,13 @@ int arkStep_ComputeSolutions_MassFixed(ARKodeMem ark_mem, sunrealtype* dsmPtr)
     nvec = 0;
     for (j = 0; j < step_mem->stages; j++)
     {
-      if (step_mem->explicit)
+      if (step_mem->explicit && (step_mem->Be->b[j] != step_mem->Be->d[j]))
       { /* Explicit pieces */
         cvals[nvec] = ark_mem->h * (step_mem->Be->b[j] - step_mem->Be->d[j]);
         Xvecs[nvec] = step_mem->Fe[j];
         nvec += 1;
       }
-      if (step_mem->implicit)
+      if (step_mem->implicit && (step_mem->Bi->b[j] != step_mem->Bi->d[j]))
       { /* Implicit pieces */
         cvals[nvec] = ark_mem->h * (step_mem->Bi->b[j] - step_mem->Bi->d[j]);
         Xvecs[nvec] = step_mem->Fi[j];
@@ -3140,8 +3167,12 @@ int arkStep_ComputeSolutions_MassFixed(ARKodeMem ark_mem, sunrealtype* dsmPtr)
     }
 
     /*   call fused vector operation to compute yerr RHS */
-    retval = N_VLinearCombination(nvec, cvals, Xvecs, yerr);
-    if (retval != 0) { return (ARK_VECTOROP_ERR); }
+    if (nvec > 0)
+    {
+      retval = N_VLinearCombination(nvec, cvals, Xvecs, yerr);
+      if (retval != 0) { return (ARK_VECTOROP_ERR); }
+    }
+    else { N_VConst(ZERO, yerr); }
 
     /* solve for yerr */
     retval = step_mem->msolve((void*)ark_mem, yerr, step_mem->nlscoef);
@@ -3193,6 +3224,10 @@ int arkStep_MRIStepInnerEvolve(MRIStepInnerStepper stepper,
   retval = arkStep_SetInnerForcing(arkode_mem, tshift, tscale, forcing, nforcing);
   if (retval != ARK_SUCCESS) { return (retval); }
 
+  /* reverse the step direction (if needed) */
+  retval = arkSetDirection((ARKodeMem)arkode_mem, tout);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
   /* set the stop time */
   retval = ARKodeSetStopTime(arkode_mem, tout);
   if (retval != ARK_SUCCESS) { return (retval); }
@@ -3248,6 +3283,98 @@ int arkStep_MRIStepInnerReset(MRIStepInnerStepper stepper, sunrealtype tR,
   return (ARKodeReset(arkode_mem, tR, yR));
 }
 
+/*------------------------------------------------------------------------------
+  arkStep_MRIStepInnerSetState
+
+  Implementation of the internal inner stepper operation that replaces the
+  state of an inner (fast) stepper at tR without a full reset when it already
+  sits at tR.
+  ----------------------------------------------------------------------------*/
+
+int arkStep_MRIStepInnerSetState(MRIStepInnerStepper stepper, sunrealtype tR,
+                                 N_Vector yR)
+{
+  void* arkode_mem;
+  int retval;
+
+  /* extract the ARKODE memory struct */
+  retval = MRIStepInnerStepper_GetContent(stepper, &arkode_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  return (arkSetState((ARKodeMem)arkode_mem, tR, yR));
+}
+
+/*------------------------------------------------------------------------------
+  arkStep_MRIStepInnerGetAccumulatedError
+
+  Implementation of MRIStepInnerGetAccumulatedError to return the error
+  accumulated by the inner (fast) stepper since the last reset.
+  ----------------------------------------------------------------------------*/
+
+int arkStep_MRIStepInnerGetAccumulatedError(MRIStepInnerStepper stepper,
+                                            sunrealtype* accum_error)
+{
+  void* arkode_mem;
+  int retval;
+
+  /* extract the ARKODE memory struct */
+  retval = MRIStepInnerStepper_GetContent(stepper, &arkode_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  return (ARKodeGetAccumulatedError(arkode_mem, accum_error));
+}
+
+/*------------------------------------------------------------------------------
+  arkStep_MRIStepInnerResetAccumulatedError
+
+  Implementation of MRIStepInnerResetAccumulatedError to restart the error
+  accumulation of the inner (fast) stepper. Errors are summed over the fast
+  steps if no accumulation type has been selected.
+  ----------------------------------------------------------------------------*/
+
+int arkStep_MRIStepInnerResetAccumulatedError(MRIStepInnerStepper stepper)
+{
+  void* arkode_mem;
+  ARKodeMem ark_mem;
+  int retval;
+
+  /* extract the ARKODE memory struct */
+  retval = MRIStepInnerStepper_GetContent(stepper, &arkode_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  if (ark_mem->AccumErrorType == ARK_ACCUMERROR_NONE)
+  {
+    return (ARKodeSetAccumulatedErrorType(arkode_mem, ARK_ACCUMERROR_SUM));
+  }
+
+  return (ARKodeResetAccumulatedError(arkode_mem));
+}
+
+/*------------------------------------------------------------------------------
+  arkStep_MRIStepInnerSetRTol
+
+  Implementation of MRIStepInnerSetRTol to update the relative tolerance of the
+  inner (fast) stepper.
+  ----------------------------------------------------------------------------*/
+
+int arkStep_MRIStepInnerSetRTol(MRIStepInnerStepper stepper, sunrealtype rtol)
+{
+  void* arkode_mem;
+  ARKodeMem ark_mem;
+  int retval;
+
+  /* extract the ARKODE memory struct */
+  retval = MRIStepInnerStepper_GetContent(stepper, &arkode_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  if (rtol <= ZERO) { return (ARK_ILL_INPUT); }
+  ark_mem->reltol = rtol;
+
+  return (ARK_SUCCESS);
+}
+
 /*------------------------------------------------------------------------------
   arkStep_ApplyForcing
 
@@ -3554,6 +3681,29 @@ int arkStep_GetOrder(ARKodeMem ark_mem)
   return step_mem->q;
 }
 
+/* -----------------------------------------------------------------------------
+ * arkStep_GetAdjointMethod
+ *
+ * Returns the explicit Butcher table and right-hand side function for the
+ * discrete adjoint. Only purely explicit problems with an identity mass matrix
+ * are supported.
+ * ---------------------------------------------------------------------------*/
+int arkStep_GetAdjointMethod(ARKodeMem ark_mem, ARKodeButcherTable* B,
+                             ARKRhsFn* f)
+{
+  ARKodeARKStepMem step_mem = (ARKodeARKStepMem)(ark_mem->step_mem);
+
+  if (step_mem->implicit || !(step_mem->explicit) ||
+      (step_mem->mass_type != MASS_IDENTITY))
+  {
+    return ARK_STEPPER_UNSUPPORTED;
+  }
+
+  *B = step_mem->Be;
+  *f = step_mem->fe;
+  return ARK_SUCCESS;
+}
+
 /*===============================================================
   EOF
   ===============================================================*/
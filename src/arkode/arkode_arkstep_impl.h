@@ -277,6 +277,12 @@ int arkStep_MRIStepInnerFullRhs(MRIStepInnerStepper stepper, sunrealtype t,
                                 N_Vector y, N_Vector f, int mode);
 int arkStep_MRIStepInnerReset(MRIStepInnerStepper stepper, sunrealtype tR,
                               N_Vector yR);
+int arkStep_MRIStepInnerSetState(MRIStepInnerStepper stepper, sunrealtype tR,
+                                 N_Vector yR);
+int arkStep_MRIStepInnerGetAccumulatedError(MRIStepInnerStepper stepper,
+                                            sunrealtype* accum_error);
+int arkStep_MRIStepInnerResetAccumulatedError(MRIStepInnerStepper stepper);
+int arkStep_MRIStepInnerSetRTol(MRIStepInnerStepper stepper, sunrealtype rtol);
 
 /* private functions for relaxation */
 int arkStep_SetRelaxFn(ARKodeMem ark_mem, ARKRelaxFn rfn, ARKRelaxJacFn rjac);
@@ -284,6 +290,10 @@ int arkStep_RelaxDeltaE(ARKodeMem ark_mem, ARKRelaxJacFn relax_jac_fn,
                         long int* relax_jac_fn_evals, sunrealtype* delta_e_out);
 int arkStep_GetOrder(ARKodeMem ark_mem);
 
+/* private functions for the discrete adjoint */
+int arkStep_GetAdjointMethod(ARKodeMem ark_mem, ARKodeButcherTable* B,
+                             ARKRhsFn* f);
+
 /*===============================================================
   Reusable ARKStep Error Messages
   ===============================================================*/
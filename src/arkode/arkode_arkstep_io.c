@@ -1241,6 +1241,15 @@ int arkStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile, SUNOutputFormat fmt)
         fprintf(outfile, "Prec evals per NLS iter      = %" RSYM "\n",
                 (sunrealtype)arkls_mem->npe / (sunrealtype)step_mem->nls_iters);
       }
+      if (ark_mem->costmodel)
+      {
+        fprintf(outfile, "Jac setup time               = %" RSYM "\n",
+                ark_mem->tjac);
+        fprintf(outfile, "LS setup time                = %" RSYM "\n",
+                ark_mem->tlsetup);
+        fprintf(outfile, "NLS iteration time           = %" RSYM "\n",
+                ark_mem->tnls);
+      }
     }
 
     /* mass solve stats */
@@ -1305,6 +1314,12 @@ int arkStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile, SUNOutputFormat fmt)
         fprintf(outfile, ",Jac evals per NLS iter,0");
         fprintf(outfile, ",Prec evals per NLS iter,0");
       }
+      if (ark_mem->costmodel)
+      {
+        fprintf(outfile, ",Jac setup time,%" RSYM, ark_mem->tjac);
+        fprintf(outfile, ",LS setup time,%" RSYM, ark_mem->tlsetup);
+        fprintf(outfile, ",NLS iteration time,%" RSYM, ark_mem->tnls);
+      }
     }
 
     /* mass solve stats */
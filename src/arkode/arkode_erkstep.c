@@ -105,6 +105,7 @@ void* ERKStepCreate(ARKRhsFn f, sunrealtype t0, N_Vector y0, SUNContext sunctx)
   ark_mem->step_getestlocalerrors   = erkStep_GetEstLocalErrors;
   ark_mem->step_supports_adaptive   = SUNTRUE;
   ark_mem->step_supports_relaxation = SUNTRUE;
+  ark_mem->step_getadjointmethod    = erkStep_GetAdjointMethod;
   ark_mem->step_mem                 = (void*)step_mem;
 
   /* Set default values for optional inputs */
@@ -305,6 +306,9 @@ void erkStep_Free(ARKodeMem ark_mem)
       ark_mem->liw -= (step_mem->stages + 1);
     }
 
+    /* free the Butcher table nonzero pattern */
+    erkStep_FreeTablePattern(ark_mem, step_mem);
+
     /* free the time stepper module itself */
     free(ark_mem->step_mem);
     ark_mem->step_mem = NULL;
@@ -451,6 +455,10 @@ int erkStep_Init(ARKodeMem ark_mem, int init_type)
     ark_mem->liw += (step_mem->stages + 1); /* pointers */
   }
 
+  /* Store the nonzero pattern of the finalized Butcher table */
+  retval = erkStep_SetTablePattern(ark_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
   /* Override the interpolant degree (if needed), used in arkInitialSetup */
   if (step_mem->q > 1 && ark_mem->interp_degree > (step_mem->q - 1))
   {
@@ -610,7 +618,7 @@ int erkStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
   ---------------------------------------------------------------*/
 int erkStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr)
 {
-  int retval, is, js, nvec, mode;
+  int retval, is, js, k, nvec, mode;
   sunrealtype* cvals;
   N_Vector* Xvecs;
   ARKodeERKStepMem step_mem;
@@ -671,10 +679,11 @@ int erkStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr)
                        ark_mem->nst, is, ark_mem->h, ark_mem->tcur);
 #endif
 
-    /* Set ycur to current stage solution */
+    /* Set ycur to current stage solution (nonzero coefficients only) */
     nvec = 0;
-    for (js = 0; js < is; js++)
+    for (k = step_mem->nzAptr[is]; k < step_mem->nzAptr[is + 1]; k++)
     {
+      js          = step_mem->nzA[k];
       cvals[nvec] = ark_mem->h * step_mem->B->A[is][js];
       Xvecs[nvec] = step_mem->F[js];
       nvec += 1;
@@ -966,6 +975,91 @@ int erkStep_CheckButcherTable(ARKodeMem ark_mem)
   return (ARK_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  erkStep_SetTablePattern
+
+  This routine stores the nonzero pattern of the Butcher table so
+  the stage and solution updates only pass vectors with nonzero
+  coefficients to the fused vector operations. Tables with many
+  zero coefficients (e.g., Dormand-Prince or Verner) otherwise
+  stream every prior stage through memory for each update, which
+  dominates the cost of a step for small systems.
+  ---------------------------------------------------------------*/
+int erkStep_SetTablePattern(ARKodeMem ark_mem)
+{
+  ARKodeERKStepMem step_mem;
+  int i, j, nnz, stages;
+
+  /* access ARKodeERKStepMem structure */
+  step_mem = (ARKodeERKStepMem)ark_mem->step_mem;
+  stages   = step_mem->stages;
+
+  /* the table may have changed since the last initialization */
+  erkStep_FreeTablePattern(ark_mem, step_mem);
+
+  step_mem->nzA    = (int*)malloc((stages * (stages - 1) / 2 + 1) * sizeof(int));
+  step_mem->nzAptr = (int*)malloc((stages + 1) * sizeof(int));
+  step_mem->nzb    = (int*)malloc(stages * sizeof(int));
+  step_mem->nze    = (int*)malloc(stages * sizeof(int));
+  if (!step_mem->nzA || !step_mem->nzAptr || !step_mem->nzb || !step_mem->nze)
+  {
+    erkStep_FreeTablePattern(ark_mem, step_mem);
+    return (ARK_MEM_FAIL);
+  }
+  ark_mem->liw += stages * (stages - 1) / 2 + 3 * stages + 2;
+
+  /* strictly lower triangular part of A */
+  nnz = 0;
+  for (i = 0; i < stages; i++)
+  {
+    step_mem->nzAptr[i] = nnz;
+    for (j = 0; j < i; j++)
+    {
+      if (step_mem->B->A[i][j] != ZERO) { step_mem->nzA[nnz++] = j; }
+    }
+  }
+  step_mem->nzAptr[stages] = nnz;
+
+  /* solution and embedding weights */
+  step_mem->nnzb = 0;
+  step_mem->nnze = 0;
+  for (j = 0; j < stages; j++)
+  {
+    if (step_mem->B->b[j] != ZERO) { step_mem->nzb[step_mem->nnzb++] = j; }
+    if (step_mem->B->d && (step_mem->B->b[j] - step_mem->B->d[j] != ZERO))
+    {
+      step_mem->nze[step_mem->nnze++] = j;
+    }
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  erkStep_FreeTablePattern
+
+  This routine frees the Butcher table nonzero pattern.
+  ---------------------------------------------------------------*/
+void erkStep_FreeTablePattern(ARKodeMem ark_mem, ARKodeERKStepMem step_mem)
+{
+  if (step_mem->nzA && step_mem->nzAptr && step_mem->nzb && step_mem->nze)
+  {
+    ark_mem->liw -= step_mem->stages * (step_mem->stages - 1) / 2 +
+                    3 * step_mem->stages + 2;
+  }
+
+  free(step_mem->nzA);
+  free(step_mem->nzAptr);
+  free(step_mem->nzb);
+  free(step_mem->nze);
+  step_mem->nzA    = NULL;
+  step_mem->nzAptr = NULL;
+  step_mem->nzb    = NULL;
+  step_mem->nze    = NULL;
+  step_mem->nnzb   = 0;
+  step_mem->nnze   = 0;
+}
+
 /*---------------------------------------------------------------
   erkStep_ComputeSolutions
 
@@ -983,7 +1077,7 @@ int erkStep_CheckButcherTable(ARKodeMem ark_mem)
 int erkStep_ComputeSolutions(ARKodeMem ark_mem, sunrealtype* dsmPtr)
 {
   /* local data */
-  int retval, j, nvec;
+  int retval, j, k, nvec;
   N_Vector y, yerr;
   sunrealtype* cvals;
   N_Vector* Xvecs;
@@ -1010,10 +1104,11 @@ int erkStep_ComputeSolutions(ARKodeMem ark_mem, sunrealtype* dsmPtr)
   *dsmPtr = ZERO;
 
   /* Compute time step solution */
-  /*   set arrays for fused vector operation */
+  /*   set arrays for fused vector operation (nonzero coefficients only) */
   nvec = 0;
-  for (j = 0; j < step_mem->stages; j++)
+  for (k = 0; k < step_mem->nnzb; k++)
   {
+    j           = step_mem->nzb[k];
     cvals[nvec] = ark_mem->h * step_mem->B->b[j];
     Xvecs[nvec] = step_mem->F[j];
     nvec += 1;
@@ -1031,16 +1126,21 @@ int erkStep_ComputeSolutions(ARKodeMem ark_mem, sunrealtype* dsmPtr)
   {
     /* set arrays for fused vector operation */
     nvec = 0;
-    for (j = 0; j < step_mem->stages; j++)
+    for (k = 0; k < step_mem->nnze; k++)
     {
+      j           = step_mem->nze[k];
       cvals[nvec] = ark_mem->h * (step_mem->B->b[j] - step_mem->B->d[j]);
       Xvecs[nvec] = step_mem->F[j];
       nvec += 1;
     }
 
     /* call fused vector operation to do the work */
-    retval = N_VLinearCombination(nvec, cvals, Xvecs, yerr);
-    if (retval != 0) { return (ARK_VECTOROP_ERR); }
+    if (nvec > 0)
+    {
+      retval = N_VLinearCombination(nvec, cvals, Xvecs, yerr);
+      if (retval != 0) { return (ARK_VECTOROP_ERR); }
+    }
+    else { N_VConst(ZERO, yerr); }
 
     /* fill error norm */
     *dsmPtr = N_VWrmsNorm(yerr, ark_mem->ewt);
@@ -1144,6 +1244,21 @@ int erkStep_GetOrder(ARKodeMem ark_mem)
   return step_mem->q;
 }
 
+/* -----------------------------------------------------------------------------
+ * erkStep_GetAdjointMethod
+ *
+ * Returns the Butcher table and right-hand side function for the discrete
+ * adjoint
+ * ---------------------------------------------------------------------------*/
+int erkStep_GetAdjointMethod(ARKodeMem ark_mem, ARKodeButcherTable* B,
+                             ARKRhsFn* f)
+{
+  ARKodeERKStepMem step_mem = (ARKodeERKStepMem)(ark_mem->step_mem);
+  *B                        = step_mem->B;
+  *f                        = step_mem->f;
+  return ARK_SUCCESS;
+}
+
 /*===============================================================
   EOF
   ===============================================================*/
@@ -61,6 +61,14 @@ typedef struct ARKodeERKStepMemRec
   sunrealtype* cvals;
   N_Vector* Xvecs;
 
+  /* Nonzero pattern of the Butcher table */
+  int* nzA;    /* columns of nonzero A(i,:), stored row by row */
+  int* nzAptr; /* start of row i in nzA (stages+1 entries)     */
+  int* nzb;    /* indices of nonzero b                        */
+  int nnzb;    /* number of nonzero b                         */
+  int* nze;    /* indices of nonzero b - d                    */
+  int nnze;    /* number of nonzero b - d                     */
+
 }* ARKodeERKStepMem;
 
 /*===============================================================
@@ -92,6 +100,8 @@ int erkStep_AccessStepMem(ARKodeMem ark_mem, const char* fname,
 sunbooleantype erkStep_CheckNVector(N_Vector tmpl);
 int erkStep_SetButcherTable(ARKodeMem ark_mem);
 int erkStep_CheckButcherTable(ARKodeMem ark_mem);
+int erkStep_SetTablePattern(ARKodeMem ark_mem);
+void erkStep_FreeTablePattern(ARKodeMem ark_mem, ARKodeERKStepMem step_mem);
 int erkStep_ComputeSolutions(ARKodeMem ark_mem, sunrealtype* dsm);
 
 /* private functions for relaxation */
@@ -100,6 +110,10 @@ int erkStep_RelaxDeltaE(ARKodeMem ark_mem, ARKRelaxJacFn relax_jac_fn,
                         long int* relax_jac_fn_evals, sunrealtype* delta_e_out);
 int erkStep_GetOrder(ARKodeMem ark_mem);
 
+/* private functions for the discrete adjoint */
+int erkStep_GetAdjointMethod(ARKodeMem ark_mem, ARKodeButcherTable* B,
+                             ARKRhsFn* f);
+
 /*===============================================================
   Reusable ERKStep Error Messages
   ===============================================================*/
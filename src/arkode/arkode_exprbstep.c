@@ -0,0 +1,1091 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * This is the implementation file for ARKODE's exponential
+ * Rosenbrock (ExpRB) time stepper module.
+ *
+ * The module implements the third order method exprb32 of
+ * Hochbruck, Ostermann and Schweitzer (SIAM J. Numer. Anal.,
+ * 47(1), 2009) with its second order embedding. The products of
+ * the phi functions of h J, with J the Jacobian of f at the start
+ * of the step, are approximated in Krylov subspaces built by the
+ * Arnoldi process, so the method only requires Jacobian-vector
+ * products. The phi functions of the small Hessenberg matrix are
+ * computed from the exponential of an augmented matrix with a
+ * scaling and squaring Pade approximation.
+ *--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/sundials_context.h>
+#include <sundials/sundials_dense.h>
+#include <sundials/sundials_iterative.h>
+#include <sundials/sundials_math.h>
+
+#include "arkode_exprbstep_impl.h"
+#include "arkode_impl.h"
+#include "arkode_interp_impl.h"
+
+#define FOURTH SUN_RCONST(0.25)
+
+/*===============================================================
+  Exported functions
+  ===============================================================*/
+
+void* ExpRBStepCreate(ARKRhsFn f, sunrealtype t0, N_Vector y0, SUNContext sunctx)
+{
+  ARKodeMem ark_mem;
+  ARKodeExpRBStepMem step_mem;
+  sunbooleantype nvectorOK;
+  int retval;
+
+  /* Check that f is supplied */
+  if (f == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_F);
+    return (NULL);
+  }
+
+  /* Check for legal input parameters */
+  if (y0 == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_Y0);
+    return (NULL);
+  }
+
+  if (!sunctx)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_SUNCTX);
+    return (NULL);
+  }
+
+  /* Test if all required vector operations are implemented */
+  nvectorOK = expRBStep_CheckNVector(y0);
+  if (!nvectorOK)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_BAD_NVECTOR);
+    return (NULL);
+  }
+
+  /* Create ark_mem structure and set default values */
+  ark_mem = arkCreate(sunctx);
+  if (ark_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (NULL);
+  }
+
+  /* Allocate ARKodeExpRBStepMem structure, and initialize to zero */
+  step_mem = NULL;
+  step_mem = (ARKodeExpRBStepMem)malloc(sizeof(struct ARKodeExpRBStepMemRec));
+  if (step_mem == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_ARKMEM_FAIL);
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+  memset(step_mem, 0, sizeof(struct ARKodeExpRBStepMemRec));
+
+  /* Attach step_mem structure and function pointers to ark_mem */
+  ark_mem->step_init              = expRBStep_Init;
+  ark_mem->step_fullrhs           = expRBStep_FullRHS;
+  ark_mem->step_resize            = expRBStep_Resize;
+  ark_mem->step                   = expRBStep_TakeStep;
+  ark_mem->step_printallstats     = expRBStep_PrintAllStats;
+  ark_mem->step_writeparameters   = expRBStep_WriteParameters;
+  ark_mem->step_free              = expRBStep_Free;
+  ark_mem->step_printmem          = expRBStep_PrintMem;
+  ark_mem->step_setdefaults       = expRBStep_SetDefaults;
+  ark_mem->step_getestlocalerrors = expRBStep_GetEstLocalErrors;
+  ark_mem->step_supports_adaptive = SUNTRUE;
+  ark_mem->step_mem               = (void*)step_mem;
+
+  /* Set default values for optional inputs */
+  retval = expRBStep_SetDefaults((void*)ark_mem);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Error setting default solver options");
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+
+  /* Copy the input parameters into ARKODE state */
+  step_mem->f = f;
+
+  /* Update the ARKODE workspace requirements */
+  ark_mem->liw += 14; /* fcn ptrs, ints, long ints */
+  ark_mem->lrw += 1;
+
+  /* Initialize all the counters */
+  step_mem->nfe  = 0;
+  step_mem->njv  = 0;
+  step_mem->nkri = 0;
+  step_mem->nkcf = 0;
+
+  /* Initialize main ARKODE infrastructure */
+  retval = arkInit(ark_mem, t0, y0, FIRST_INIT);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Unable to initialize main ARKODE infrastructure");
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+
+  return ((void*)ark_mem);
+}
+
+/*---------------------------------------------------------------
+  ExpRBStepReInit:
+
+  This routine re-initializes the ExpRBStep module to solve a new
+  problem of the same size as was previously solved. This routine
+  should also be called when the problem dynamics or desired solvers
+  have changed dramatically, so that the problem integration should
+  resume as if started from scratch.
+
+  Note all internal counters are set to 0 on re-initialization.
+  ---------------------------------------------------------------*/
+int ExpRBStepReInit(void* arkode_mem, ARKRhsFn f, sunrealtype t0, N_Vector y0)
+{
+  ARKodeMem ark_mem;
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeExpRBStepMem structure */
+  retval = expRBStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Check if ark_mem was allocated */
+  if (ark_mem->MallocDone == SUNFALSE)
+  {
+    arkProcessError(ark_mem, ARK_NO_MALLOC, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MALLOC);
+    return (ARK_NO_MALLOC);
+  }
+
+  /* Check that f is supplied */
+  if (f == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_F);
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Check for legal input parameters */
+  if (y0 == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_Y0);
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Copy the input parameters into ARKODE state */
+  step_mem->f = f;
+
+  /* Initialize main ARKODE infrastructure */
+  retval = arkInit(arkode_mem, t0, y0, FIRST_INIT);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Unable to initialize main ARKODE infrastructure");
+    return (retval);
+  }
+
+  /* Initialize all the counters */
+  step_mem->nfe  = 0;
+  step_mem->njv  = 0;
+  step_mem->nkri = 0;
+  step_mem->nkcf = 0;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Interface routines supplied to ARKODE
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  expRBStep_Resize:
+
+  This routine resizes the Krylov basis vectors (if allocated).
+  ---------------------------------------------------------------*/
+int expRBStep_Resize(ARKodeMem ark_mem, N_Vector y0,
+                     SUNDIALS_MAYBE_UNUSED sunrealtype hscale,
+                     SUNDIALS_MAYBE_UNUSED sunrealtype t0,
+                     ARKVecResizeFn resize, void* resize_data)
+{
+  ARKodeExpRBStepMem step_mem;
+  sunindextype lrw1, liw1, lrw_diff, liw_diff;
+  int retval;
+
+  /* access ARKodeExpRBStepMem structure */
+  retval = expRBStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Determine change in vector sizes */
+  lrw1 = liw1 = 0;
+  if (y0->ops->nvspace != NULL) { N_VSpace(y0, &lrw1, &liw1); }
+  lrw_diff      = lrw1 - ark_mem->lrw1;
+  liw_diff      = liw1 - ark_mem->liw1;
+  ark_mem->lrw1 = lrw1;
+  ark_mem->liw1 = liw1;
+
+  /* Resize the Krylov basis */
+  if (step_mem->V != NULL)
+  {
+    if (!arkResizeVecArray(resize, resize_data, step_mem->maxl_alloc + 1, y0,
+                           &step_mem->V, lrw_diff, &ark_mem->lrw, liw_diff,
+                           &ark_mem->liw))
+    {
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      "Unable to resize vector");
+      return (ARK_MEM_FAIL);
+    }
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  expRBStep_Free frees all ExpRBStep memory.
+  ---------------------------------------------------------------*/
+void expRBStep_Free(ARKodeMem ark_mem)
+{
+  ARKodeExpRBStepMem step_mem;
+
+  /* nothing to do if ark_mem is already NULL */
+  if (ark_mem == NULL) { return; }
+
+  /* conditional frees on non-NULL ExpRBStep module */
+  if (ark_mem->step_mem != NULL)
+  {
+    step_mem = (ARKodeExpRBStepMem)ark_mem->step_mem;
+
+    /* free the Krylov and dense matrix workspace */
+    expRBStep_FreeKrylov(ark_mem, step_mem);
+
+    /* free the time stepper module itself */
+    free(ark_mem->step_mem);
+    ark_mem->step_mem = NULL;
+  }
+}
+
+/*---------------------------------------------------------------
+  expRBStep_PrintMem:
+
+  This routine outputs the memory from the ExpRBStep structure to
+  a specified file pointer (useful when debugging).
+  ---------------------------------------------------------------*/
+void expRBStep_PrintMem(ARKodeMem ark_mem, FILE* outfile)
+{
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeExpRBStepMem structure */
+  retval = expRBStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return; }
+
+  /* output integer quantities */
+  fprintf(outfile, "ExpRBStep: maxl = %i\n", step_mem->maxl);
+  fprintf(outfile, "ExpRBStep: maxl_alloc = %i\n", step_mem->maxl_alloc);
+  fprintf(outfile, "ExpRBStep: autonomous = %i\n", step_mem->autonomous);
+
+  /* output long integer quantities */
+  fprintf(outfile, "ExpRBStep: nfe = %li\n", step_mem->nfe);
+  fprintf(outfile, "ExpRBStep: njv = %li\n", step_mem->njv);
+  fprintf(outfile, "ExpRBStep: nkri = %li\n", step_mem->nkri);
+  fprintf(outfile, "ExpRBStep: nkcf = %li\n", step_mem->nkcf);
+
+  /* output sunrealtype quantities */
+  fprintf(outfile, "ExpRBStep: eps_kry = %" RSYM "\n", step_mem->eps_kry);
+}
+
+/*---------------------------------------------------------------
+  expRBStep_Init:
+
+  This routine is called just prior to performing internal time
+  steps (after all user "set" routines have been called) from
+  within arkInitialSetup.
+
+  With initialization type FIRST_INIT this routine:
+  - sets the method and embedding orders in the adaptivity module
+  - limits the interpolant degree by the method order
+  - allocates the Krylov workspace for the current maxl
+  - sets the call_fullrhs flag
+
+  Unlike the explicit steppers, the error weights are not replaced
+  by arkEwtSetSmallReal with a fixed step size since they also
+  scale the Krylov error test and the difference quotients.
+
+  With other initialization types, this routine does nothing.
+  ---------------------------------------------------------------*/
+int expRBStep_Init(ARKodeMem ark_mem, int init_type)
+{
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeExpRBStepMem structure */
+  retval = expRBStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* immediately return if resize or reset */
+  if (init_type == RESIZE_INIT || init_type == RESET_INIT)
+  {
+    return (ARK_SUCCESS);
+  }
+
+  /* Set the method and embedding orders (exprb32) */
+  ark_mem->hadapt_mem->q = 3;
+  ark_mem->hadapt_mem->p = 2;
+
+  /* Override the interpolant degree (if needed), used in arkInitialSetup */
+  if (ark_mem->interp_degree > 2) { ark_mem->interp_degree = 2; }
+
+  /* (Re)allocate the Krylov workspace if maxl changed */
+  if ((step_mem->V != NULL) && (step_mem->maxl_alloc != step_mem->maxl))
+  {
+    expRBStep_FreeKrylov(ark_mem, step_mem);
+  }
+  if (step_mem->V == NULL)
+  {
+    retval = expRBStep_AllocKrylov(ark_mem, step_mem);
+    if (retval != ARK_SUCCESS) { return (retval); }
+  }
+
+  /* Signal to shared arkode module that full RHS evaluations are required */
+  ark_mem->call_fullrhs = SUNTRUE;
+
+  return (ARK_SUCCESS);
+}
+
+/*------------------------------------------------------------------------------
+  expRBStep_FullRHS:
+
+  This is just a wrapper to call the user-supplied RHS function, f(t,y). The
+  method is not FSAL, so the RHS is evaluated in every mode.
+  ----------------------------------------------------------------------------*/
+int expRBStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
+                      int mode)
+{
+  int retval;
+  ARKodeExpRBStepMem step_mem;
+
+  /* access ARKodeExpRBStepMem structure */
+  retval = expRBStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* perform RHS functions contingent on 'mode' argument */
+  switch (mode)
+  {
+  case ARK_FULLRHS_START:
+  case ARK_FULLRHS_END:
+  case ARK_FULLRHS_OTHER:
+
+    /* call f */
+    retval = step_mem->f(t, y, f, ark_mem->user_data);
+    step_mem->nfe++;
+    if (retval != 0)
+    {
+      arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_RHSFUNC_FAILED, t);
+      return (ARK_RHSFUNC_FAIL);
+    }
+
+    break;
+
+  default:
+    /* return with RHS failure if unknown mode is passed */
+    arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                    "Unknown full RHS mode");
+    return (ARK_RHSFUNC_FAIL);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  expRBStep_TakeStep:
+
+  This routine performs a single step of the exponential
+  Rosenbrock method exprb32. With J the Jacobian and w the time
+  derivative of f at (tn, yn) (w = 0 for autonomous problems),
+
+    U = yn + h phi_1(hJ) fn + h^2 phi_2(hJ) w,
+    D = f(tn + h, U) - fn - J (U - yn) - h w,
+    y = U + 2 h phi_3(hJ) D,
+
+  and the second order embedding is U, so the local error
+  estimate is 2 h phi_3(hJ) D. The vectors are used as follows:
+  tempv1 holds the phi products and the error estimate, tempv2 the
+  stage RHS and D, tempv3 the time derivative w, and tempv4 is the
+  Jacobian-vector product work vector.
+
+  The output variable dsmPtr should contain estimate of the
+  weighted local error if an embedding is present; otherwise it
+  should be 0.
+
+  The input/output variable nflagPtr is used to gauge convergence
+  of the Krylov approximations within the step. If one of them
+  does not converge it is set to CONV_FAIL and TRY_AGAIN is
+  returned, so that ARKODE retries the step with a smaller step
+  size.
+
+  The return value from this routine is:
+            0 => step completed successfully
+           >0 => step encountered recoverable failure;
+                 reduce step and retry (if possible)
+           <0 => step encountered unrecoverable failure
+  ---------------------------------------------------------------*/
+int expRBStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr)
+{
+  int retval;
+  sunrealtype h, sigma;
+  sunrealtype cvals[4];
+  N_Vector Xvecs[4];
+  ARKodeExpRBStepMem step_mem;
+
+  /* initialize Krylov convergence flag to success */
+  *nflagPtr = ARK_SUCCESS;
+
+  /* initialize output */
+  *dsmPtr = ZERO;
+
+  /* access ARKodeExpRBStepMem structure */
+  retval = expRBStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  h = ark_mem->h;
+
+  /* The method is not FSAL, so the RHS at the start of the step may need
+     to be computed (possibly already computed by ARKODE) */
+  if (!(ark_mem->fn_is_current))
+  {
+    retval = ark_mem->step_fullrhs(ark_mem, ark_mem->tn, ark_mem->yn,
+                                   ark_mem->fn, ARK_FULLRHS_START);
+    if (retval) { return ARK_RHSFUNC_FAIL; }
+    ark_mem->fn_is_current = SUNTRUE;
+  }
+
+  /* Time derivative of f by a forward difference, w = 0 if autonomous */
+  if (step_mem->autonomous) { N_VConst(ZERO, ark_mem->tempv3); }
+  else
+  {
+    sigma = SUNRsqrt(ark_mem->uround) *
+            SUNMAX(SUNRabs(ark_mem->tn), SUNRabs(h));
+    retval = step_mem->f(ark_mem->tn + sigma, ark_mem->yn, ark_mem->tempv3,
+                         ark_mem->user_data);
+    step_mem->nfe++;
+    if (retval < 0) { return (ARK_RHSFUNC_FAIL); }
+    if (retval > 0) { return (RHSFUNC_RECVR); }
+    N_VLinearSum(ONE / sigma, ark_mem->tempv3, -ONE / sigma, ark_mem->fn,
+                 ark_mem->tempv3);
+  }
+
+  /* U = yn + h phi_1(hJ) fn + h^2 phi_2(hJ) w */
+  retval = expRBStep_Phi(ark_mem, step_mem, 1, ark_mem->fn, h, ark_mem->tempv1,
+                         nflagPtr);
+  if (retval != ARK_SUCCESS) { return (retval); }
+  N_VLinearSum(ONE, ark_mem->yn, h, ark_mem->tempv1, ark_mem->ycur);
+
+  if (!step_mem->autonomous)
+  {
+    retval = expRBStep_Phi(ark_mem, step_mem, 2, ark_mem->tempv3, h * h,
+                           ark_mem->tempv1, nflagPtr);
+    if (retval != ARK_SUCCESS) { return (retval); }
+    N_VLinearSum(ONE, ark_mem->ycur, h * h, ark_mem->tempv1, ark_mem->ycur);
+  }
+
+  /* apply user-supplied stage postprocessing function (if supplied) */
+  ark_mem->tcur = ark_mem->tn + h;
+  if (ark_mem->ProcessStage != NULL)
+  {
+    retval = ark_mem->ProcessStage(ark_mem->tcur, ark_mem->ycur,
+                                   ark_mem->user_data);
+    if (retval != 0) { return (ARK_POSTPROCESS_STAGE_FAIL); }
+  }
+
+  /* f(tn + h, U) */
+  retval = step_mem->f(ark_mem->tcur, ark_mem->ycur, ark_mem->tempv2,
+                       ark_mem->user_data);
+  step_mem->nfe++;
+  if (retval < 0) { return (ARK_RHSFUNC_FAIL); }
+  if (retval > 0) { return (RHSFUNC_RECVR); }
+
+  /* J (U - yn), using the (idle) first two Krylov vectors as storage */
+  N_VLinearSum(ONE, ark_mem->ycur, -ONE, ark_mem->yn, ark_mem->tempv1);
+  retval = expRBStep_Jv(ark_mem, step_mem, ark_mem->tempv1, step_mem->V[0],
+                        step_mem->V[1]);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* D = f(tn + h, U) - fn - J (U - yn) - h w */
+  cvals[0] = ONE;
+  Xvecs[0] = ark_mem->tempv2;
+  cvals[1] = -ONE;
+  Xvecs[1] = ark_mem->fn;
+  cvals[2] = -ONE;
+  Xvecs[2] = step_mem->V[0];
+  cvals[3] = -h;
+  Xvecs[3] = ark_mem->tempv3;
+
+  retval = N_VLinearCombination(step_mem->autonomous ? 3 : 4, cvals, Xvecs,
+                                ark_mem->tempv2);
+  if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+  /* yerr = 2 h phi_3(hJ) D and y = U + yerr */
+  retval = expRBStep_Phi(ark_mem, step_mem, 3, ark_mem->tempv2, TWO * h,
+                         ark_mem->tempv1, nflagPtr);
+  if (retval != ARK_SUCCESS) { return (retval); }
+  N_VScale(TWO * h, ark_mem->tempv1, ark_mem->tempv1);
+  N_VLinearSum(ONE, ark_mem->ycur, ONE, ark_mem->tempv1, ark_mem->ycur);
+
+  /* Compute the error norm (if step adaptivity enabled) */
+  if (!ark_mem->fixedstep)
+  {
+    *dsmPtr = N_VWrmsNorm(ark_mem->tempv1, ark_mem->ewt);
+  }
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
+  SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
+                     "ARKODE::expRBStep_TakeStep", "error-test",
+                     "step = %li, h = %" RSYM ", dsm = %" RSYM, ark_mem->nst,
+                     ark_mem->h, *dsmPtr);
+#endif
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Internal utility routines
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  expRBStep_AccessARKODEStepMem:
+
+  Shortcut routine to unpack both ark_mem and step_mem structures
+  from void* pointer.  If either is missing it returns ARK_MEM_NULL.
+  ---------------------------------------------------------------*/
+int expRBStep_AccessARKODEStepMem(void* arkode_mem, const char* fname,
+                                  ARKodeMem* ark_mem,
+                                  ARKodeExpRBStepMem* step_mem)
+{
+  /* access ARKodeMem structure */
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *ark_mem = (ARKodeMem)arkode_mem;
+
+  /* access ARKodeExpRBStepMem structure */
+  if ((*ark_mem)->step_mem == NULL)
+  {
+    arkProcessError(*ark_mem, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_EXPRBSTEP_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *step_mem = (ARKodeExpRBStepMem)(*ark_mem)->step_mem;
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  expRBStep_AccessStepMem:
+
+  Shortcut routine to unpack the step_mem structure from
+  ark_mem.  If missing it returns ARK_MEM_NULL.
+  ---------------------------------------------------------------*/
+int expRBStep_AccessStepMem(ARKodeMem ark_mem, const char* fname,
+                            ARKodeExpRBStepMem* step_mem)
+{
+  /* access ARKodeExpRBStepMem structure */
+  if (ark_mem->step_mem == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_EXPRBSTEP_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *step_mem = (ARKodeExpRBStepMem)ark_mem->step_mem;
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  expRBStep_CheckNVector:
+
+  This routine checks if all required vector operations are
+  present.  If any of them is missing it returns SUNFALSE. The
+  Arnoldi process additionally requires N_VDotProd.
+  ---------------------------------------------------------------*/
+sunbooleantype expRBStep_CheckNVector(N_Vector tmpl)
+{
+  if ((tmpl->ops->nvclone == NULL) || (tmpl->ops->nvdestroy == NULL) ||
+      (tmpl->ops->nvlinearsum == NULL) || (tmpl->ops->nvconst == NULL) ||
+      (tmpl->ops->nvscale == NULL) || (tmpl->ops->nvwrmsnorm == NULL) ||
+      (tmpl->ops->nvdotprod == NULL))
+  {
+    return (SUNFALSE);
+  }
+  return (SUNTRUE);
+}
+
+/*---------------------------------------------------------------
+  expRBStep_AllocKrylov:
+
+  This routine allocates the maxl+1 Krylov basis vectors, the
+  (maxl+1) x maxl Hessenberg matrix, and the dense workspace for
+  the exponential of the augmented (maxl+EXPRB_AUG) square matrix.
+  ---------------------------------------------------------------*/
+int expRBStep_AllocKrylov(ARKodeMem ark_mem, ARKodeExpRBStepMem step_mem)
+{
+  int i, maxl, n;
+
+  maxl = step_mem->maxl;
+  n    = maxl + EXPRB_AUG;
+
+  if (!arkAllocVecArray(maxl + 1, ark_mem->yn, &step_mem->V, ark_mem->lrw1,
+                        &ark_mem->lrw, ark_mem->liw1, &ark_mem->liw))
+  {
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_MEM_FAIL);
+    return (ARK_MEM_FAIL);
+  }
+  step_mem->maxl_alloc = maxl;
+
+  step_mem->Hes = (sunrealtype**)malloc((maxl + 1) * sizeof(sunrealtype*));
+  if (step_mem->Hes == NULL)
+  {
+    expRBStep_FreeKrylov(ark_mem, step_mem);
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_MEM_FAIL);
+    return (ARK_MEM_FAIL);
+  }
+  for (i = 0; i <= maxl; i++) { step_mem->Hes[i] = NULL; }
+  for (i = 0; i <= maxl; i++)
+  {
+    step_mem->Hes[i] = (sunrealtype*)malloc(maxl * sizeof(sunrealtype));
+    if (step_mem->Hes[i] == NULL)
+    {
+      expRBStep_FreeKrylov(ark_mem, step_mem);
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_MEM_FAIL);
+      return (ARK_MEM_FAIL);
+    }
+  }
+
+  step_mem->cvals  = SUNDlsMat_newRealArray(maxl);
+  step_mem->Amat   = SUNDlsMat_newDenseMat(n, n);
+  step_mem->Nmat   = SUNDlsMat_newDenseMat(n, n);
+  step_mem->Dmat   = SUNDlsMat_newDenseMat(n, n);
+  step_mem->Pmat   = SUNDlsMat_newDenseMat(n, n);
+  step_mem->Tmat   = SUNDlsMat_newDenseMat(n, n);
+  step_mem->pivots = SUNDlsMat_newIndexArray(n);
+  if ((step_mem->cvals == NULL) || (step_mem->Amat == NULL) ||
+      (step_mem->Nmat == NULL) || (step_mem->Dmat == NULL) ||
+      (step_mem->Pmat == NULL) || (step_mem->Tmat == NULL) ||
+      (step_mem->pivots == NULL))
+  {
+    expRBStep_FreeKrylov(ark_mem, step_mem);
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_MEM_FAIL);
+    return (ARK_MEM_FAIL);
+  }
+
+  ark_mem->lrw += (maxl + 1) * maxl + maxl + 5 * n * n;
+  ark_mem->liw += n;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  expRBStep_FreeKrylov:
+
+  This routine frees the Krylov and dense matrix workspace.
+  ---------------------------------------------------------------*/
+void expRBStep_FreeKrylov(ARKodeMem ark_mem, ARKodeExpRBStepMem step_mem)
+{
+  int i, maxl, n;
+
+  maxl = step_mem->maxl_alloc;
+  n    = maxl + EXPRB_AUG;
+
+  if (step_mem->V != NULL)
+  {
+    arkFreeVecArray(maxl + 1, &step_mem->V, ark_mem->lrw1, &ark_mem->lrw,
+                    ark_mem->liw1, &ark_mem->liw);
+  }
+
+  if (step_mem->Hes != NULL)
+  {
+    for (i = 0; i <= maxl; i++)
+    {
+      if (step_mem->Hes[i] != NULL) { free(step_mem->Hes[i]); }
+    }
+    free(step_mem->Hes);
+    step_mem->Hes = NULL;
+    ark_mem->lrw -= (maxl + 1) * maxl;
+  }
+
+  if (step_mem->cvals != NULL)
+  {
+    SUNDlsMat_destroyArray(step_mem->cvals);
+    step_mem->cvals = NULL;
+    ark_mem->lrw -= maxl;
+  }
+  if (step_mem->Amat != NULL)
+  {
+    SUNDlsMat_destroyMat(step_mem->Amat);
+    step_mem->Amat = NULL;
+    ark_mem->lrw -= n * n;
+  }
+  if (step_mem->Nmat != NULL)
+  {
+    SUNDlsMat_destroyMat(step_mem->Nmat);
+    step_mem->Nmat = NULL;
+    ark_mem->lrw -= n * n;
+  }
+  if (step_mem->Dmat != NULL)
+  {
+    SUNDlsMat_destroyMat(step_mem->Dmat);
+    step_mem->Dmat = NULL;
+    ark_mem->lrw -= n * n;
+  }
+  if (step_mem->Pmat != NULL)
+  {
+    SUNDlsMat_destroyMat(step_mem->Pmat);
+    step_mem->Pmat = NULL;
+    ark_mem->lrw -= n * n;
+  }
+  if (step_mem->Tmat != NULL)
+  {
+    SUNDlsMat_destroyMat(step_mem->Tmat);
+    step_mem->Tmat = NULL;
+    ark_mem->lrw -= n * n;
+  }
+  if (step_mem->pivots != NULL)
+  {
+    SUNDlsMat_destroyArray(step_mem->pivots);
+    step_mem->pivots = NULL;
+    ark_mem->liw -= n;
+  }
+
+  step_mem->maxl_alloc = 0;
+}
+
+/*---------------------------------------------------------------
+  expRBStep_Jv:
+
+  This routine computes the product of the Jacobian of f at
+  (tn, yn) with v, using the user-supplied routine if available
+  and otherwise the difference quotient
+
+    Jv = [f(tn, yn + sig v) - fn] / sig,  sig = 1 / ||v||_WRMS,
+
+  as in the ARKLS default Jacobian-vector product, so that the
+  perturbation is at the level of the error tolerances. The vector
+  work is used as temporary storage and may not alias v or Jv.
+  ---------------------------------------------------------------*/
+int expRBStep_Jv(ARKodeMem ark_mem, ARKodeExpRBStepMem step_mem, N_Vector v,
+                 N_Vector Jv, N_Vector work)
+{
+  sunrealtype sig, siginv;
+  int iter, retval;
+
+  step_mem->njv++;
+
+  /* user-supplied Jacobian-vector product */
+  if (step_mem->jtimes != NULL)
+  {
+    retval = step_mem->jtimes(v, Jv, ark_mem->tn, ark_mem->yn, ark_mem->fn,
+                              ark_mem->user_data, work);
+    if (retval < 0) { return (ARK_RHSFUNC_FAIL); }
+    if (retval > 0) { return (RHSFUNC_RECVR); }
+    return (ARK_SUCCESS);
+  }
+
+  /* Initialize perturbation */
+  sig = N_VWrmsNorm(v, ark_mem->ewt);
+  if (sig == ZERO)
+  {
+    N_VConst(ZERO, Jv);
+    return (ARK_SUCCESS);
+  }
+  sig = ONE / sig;
+
+  for (iter = 0; iter < 3; iter++)
+  {
+    /* Set work = y + sig*v */
+    N_VLinearSum(sig, v, ONE, ark_mem->yn, work);
+
+    /* Set Jv = f(tn, y+sig*v) */
+    retval = step_mem->f(ark_mem->tn, work, Jv, ark_mem->user_data);
+    step_mem->nfe++;
+    if (retval == 0) { break; }
+    if (retval < 0) { return (ARK_RHSFUNC_FAIL); }
+
+    /* If f failed recoverably, shrink sig and retry */
+    sig *= FOURTH;
+  }
+
+  /* If retval still isn't 0, return with a recoverable failure */
+  if (retval > 0) { return (RHSFUNC_RECVR); }
+
+  /* Replace Jv by (Jv - fn)/sig */
+  siginv = ONE / sig;
+  N_VLinearSum(siginv, Jv, -siginv, ark_mem->fn, Jv);
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  expRBStep_Phi:
+
+  This routine approximates out = phi_k(hJ) b (k <= EXPRB_MAX_PHI)
+  in the Krylov subspace K_m(hJ, b). The Arnoldi process (full
+  orthogonalization with SUNModifiedGS) gives hJ V_m = V_m H_m +
+  h_{m+1,m} v_{m+1} e_m^T and
+
+    phi_k(hJ) b ~ beta V_m phi_k(H_m) e1,  beta = ||b||_2.
+
+  After each Arnoldi iteration phi_k(H_m) e1 and phi_{k+1}(H_m) e1
+  are computed from the exponential of the augmented matrix of
+  size m + k + 1, and the error of the approximation is estimated
+  by (Saad, SIAM J. Numer. Anal., 29(1), 1992)
+
+    err = beta h_{m+1,m} |e_m^T phi_{k+1}(H_m) e1| ||v_{m+1}||_WRMS.
+
+  The iteration stops when hscale * err <= eps_kry, where hscale
+  is the factor multiplying the phi product in the step, or on a
+  happy breakdown. If the test fails with m = maxl, nflagPtr is
+  set to CONV_FAIL and TRY_AGAIN is returned.
+
+  The output vector may not alias b or the Krylov basis vectors.
+  ---------------------------------------------------------------*/
+int expRBStep_Phi(ARKodeMem ark_mem, ARKodeExpRBStepMem step_mem, int k,
+                  N_Vector b, sunrealtype hscale, N_Vector out, int* nflagPtr)
+{
+  int retval, i, j, r, m, n, p;
+  sunrealtype beta, hnorm, hmax, err;
+  sunbooleantype converged;
+  N_Vector* V;
+  sunrealtype** Hes;
+
+  V   = step_mem->V;
+  Hes = step_mem->Hes;
+  p   = k + 1;
+
+  /* V[0] = b / beta, trivial result for b = 0 */
+  beta = SUNRsqrt(N_VDotProd(b, b));
+  if (beta == ZERO)
+  {
+    N_VConst(ZERO, out);
+    return (ARK_SUCCESS);
+  }
+  N_VScale(ONE / beta, b, V[0]);
+
+  converged = SUNFALSE;
+  m         = 0;
+  for (j = 0; j < step_mem->maxl; j++)
+  {
+    m = j + 1;
+    step_mem->nkri++;
+
+    /* V[j+1] = hJ V[j] */
+    retval = expRBStep_Jv(ark_mem, step_mem, V[j], V[j + 1], ark_mem->tempv4);
+    if (retval != ARK_SUCCESS) { return (retval); }
+    N_VScale(ark_mem->h, V[j + 1], V[j + 1]);
+
+    /* Orthogonalize against all previous vectors */
+    retval = SUNModifiedGS(V, Hes, j + 1, step_mem->maxl, &hnorm);
+    if (retval != 0) { return (ARK_VECTOROP_ERR); }
+    Hes[j + 1][j] = hnorm;
+
+    /* phi functions of the projected matrix */
+    n = m + p;
+    for (i = 0; i < n; i++)
+    {
+      for (r = 0; r < n; r++) { step_mem->Amat[i][r] = ZERO; }
+    }
+    for (i = 0; i < m; i++)
+    {
+      for (r = 0; r <= SUNMIN(i + 1, m - 1); r++)
+      {
+        step_mem->Amat[i][r] = Hes[r][i];
+      }
+    }
+    step_mem->Amat[m][0] = ONE;
+    for (i = 1; i < p; i++) { step_mem->Amat[m + i][m + i - 1] = ONE; }
+
+    retval = expRBStep_DenseExpm(step_mem, n);
+    if (retval != ARK_SUCCESS) { return (retval); }
+
+    /* happy breakdown: the subspace is invariant and the result is exact */
+    hmax = ZERO;
+    for (i = 0; i <= j; i++) { hmax = SUNMAX(hmax, SUNRabs(Hes[i][j])); }
+    if (hnorm <= ark_mem->uround * hmax)
+    {
+      converged = SUNTRUE;
+      break;
+    }
+
+    /* error estimate, with V[j+1] normalized */
+    N_VScale(ONE / hnorm, V[j + 1], V[j + 1]);
+    err = beta * hnorm * SUNRabs(step_mem->Nmat[m + k][m - 1]) *
+          N_VWrmsNorm(V[j + 1], ark_mem->ewt);
+    if (SUNRabs(hscale) * err <= step_mem->eps_kry)
+    {
+      converged = SUNTRUE;
+      break;
+    }
+  }
+
+  if (!converged)
+  {
+    step_mem->nkcf++;
+    *nflagPtr = CONV_FAIL;
+    return (TRY_AGAIN);
+  }
+
+  /* out = beta V_m phi_k(H_m) e1 */
+  for (i = 0; i < m; i++)
+  {
+    step_mem->cvals[i] = beta * step_mem->Nmat[m + k - 1][i];
+  }
+  retval = N_VLinearCombination(m, step_mem->cvals, V, out);
+  if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  expRBStep_DenseExpm:
+
+  This routine computes the exponential of the leading n x n block
+  of the column-major matrix Amat (overwritten) and stores it in
+  Nmat, using a diagonal Pade approximation of degree
+  EXPRB_PADE_DEG combined with scaling and squaring (Moler and
+  Van Loan, SIAM Rev., 45(1), 2003).
+  ---------------------------------------------------------------*/
+int expRBStep_DenseExpm(ARKodeExpRBStepMem step_mem, int n)
+{
+  int i, j, l, s;
+  sunrealtype anorm, colsum, c, sgn;
+  sunrealtype** A = step_mem->Amat;
+  sunrealtype** N = step_mem->Nmat;
+  sunrealtype** D = step_mem->Dmat;
+  sunrealtype** P = step_mem->Pmat;
+  sunrealtype** T = step_mem->Tmat;
+
+  /* 1-norm of A and number of squarings so that ||A / 2^s|| <= 1/2 */
+  anorm = ZERO;
+  for (j = 0; j < n; j++)
+  {
+    colsum = ZERO;
+    for (i = 0; i < n; i++) { colsum += SUNRabs(A[j][i]); }
+    anorm = SUNMAX(anorm, colsum);
+  }
+  s = 0;
+  while ((anorm > HALF) && (s < EXPRB_MAX_SQUARE))
+  {
+    anorm *= HALF;
+    s++;
+  }
+  if (anorm > HALF) { return (ARK_VECTOROP_ERR); }
+  c = ONE;
+  for (l = 0; l < s; l++) { c *= HALF; }
+  for (j = 0; j < n; j++)
+  {
+    for (i = 0; i < n; i++) { A[j][i] *= c; }
+  }
+
+  /* N = sum c_l A^l and D = sum (-1)^l c_l A^l, with P = A^l */
+  for (j = 0; j < n; j++)
+  {
+    for (i = 0; i < n; i++)
+    {
+      P[j][i] = (i == j) ? ONE : ZERO;
+      N[j][i] = P[j][i];
+      D[j][i] = P[j][i];
+    }
+  }
+  c   = ONE;
+  sgn = ONE;
+  for (l = 1; l <= EXPRB_PADE_DEG; l++)
+  {
+    c *= (sunrealtype)(EXPRB_PADE_DEG - l + 1) /
+         (sunrealtype)(l * (2 * EXPRB_PADE_DEG - l + 1));
+    sgn = -sgn;
+
+    expRBStep_MatMul(n, A, P, T);
+    SUNDlsMat_denseCopy(T, P, n, n);
+
+    for (j = 0; j < n; j++)
+    {
+      for (i = 0; i < n; i++)
+      {
+        N[j][i] += c * P[j][i];
+        D[j][i] += sgn * c * P[j][i];
+      }
+    }
+  }
+
+  /* exp(A / 2^s) ~ D^{-1} N */
+  if (SUNDlsMat_denseGETRF(D, n, n, step_mem->pivots) != 0)
+  {
+    return (ARK_VECTOROP_ERR);
+  }
+  for (j = 0; j < n; j++) { SUNDlsMat_denseGETRS(D, n, step_mem->pivots, N[j]); }
+
+  /* undo the scaling by repeated squaring */
+  for (l = 0; l < s; l++)
+  {
+    expRBStep_MatMul(n, N, N, T);
+    SUNDlsMat_denseCopy(T, N, n, n);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  expRBStep_MatMul:
+
+  This routine computes the product C = A B of the leading n x n
+  blocks of the column-major matrices A and B. C may not alias A
+  or B.
+  ---------------------------------------------------------------*/
+void expRBStep_MatMul(int n, sunrealtype** A, sunrealtype** B, sunrealtype** C)
+{
+  int i, j, l;
+  sunrealtype blj;
+
+  for (j = 0; j < n; j++)
+  {
+    for (i = 0; i < n; i++) { C[j][i] = ZERO; }
+    for (l = 0; l < n; l++)
+    {
+      blj = B[j][l];
+      if (blj == ZERO) { continue; }
+      for (i = 0; i < n; i++) { C[j][i] += A[l][i] * blj; }
+    }
+  }
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
@@ -0,0 +1,138 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * Implementation header file for ARKODE's exponential Rosenbrock
+ * (ExpRB) time stepper module.
+ *--------------------------------------------------------------*/
+
+#ifndef _ARKODE_EXPRBSTEP_IMPL_H
+#define _ARKODE_EXPRBSTEP_IMPL_H
+
+#include <arkode/arkode_exprbstep.h>
+
+#include "arkode_impl.h"
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*===============================================================
+  ExpRB time step module constants
+  ===============================================================*/
+
+/* default maximum Krylov dimension and Krylov tolerance factor */
+#define EXPRB_MAXL        30
+#define EXPRB_EPS_KRYLOV  SUN_RCONST(0.05)
+
+/* highest phi function index used by the method, the augmented
+   matrix used to evaluate phi_k and phi_{k+1} has k+1 extra rows */
+#define EXPRB_MAX_PHI     3
+#define EXPRB_AUG         (EXPRB_MAX_PHI + 1)
+
+/* diagonal Pade degree and maximum number of squarings of the
+   dense matrix exponential */
+#define EXPRB_PADE_DEG    6
+#define EXPRB_MAX_SQUARE  64
+
+/*===============================================================
+  ExpRB time step module data structure
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  Types : struct ARKodeExpRBStepMemRec, ARKodeExpRBStepMem
+  ---------------------------------------------------------------
+  The type ARKodeExpRBStepMem is type pointer to struct
+  ARKodeExpRBStepMemRec.  This structure contains fields to
+  perform an exponential Rosenbrock time step. The phi functions
+  are evaluated with Krylov projections, so the structure holds
+  the Krylov basis, the Hessenberg matrix, and the dense
+  workspace for the matrix exponential of the projected matrix.
+  ---------------------------------------------------------------*/
+typedef struct ARKodeExpRBStepMemRec
+{
+  /* ExpRB problem specification */
+  ARKRhsFn f;                 /* y' = f(t,y)                */
+  ARKLsJacTimesVecFn jtimes;  /* user Jacobian-vector fn    */
+  sunbooleantype autonomous;  /* f does not depend on t     */
+
+  /* Krylov parameters */
+  int maxl;             /* maximum Krylov dimension   */
+  sunrealtype eps_kry;  /* Krylov tolerance factor    */
+
+  /* Krylov workspace */
+  int maxl_alloc;       /* allocated Krylov dimension */
+  N_Vector* V;          /* Krylov basis [maxl+1]      */
+  sunrealtype** Hes;    /* Hessenberg [maxl+1][maxl]  */
+  sunrealtype* cvals;   /* combination coefficients   */
+
+  /* dense matrix exponential workspace [maxl+EXPRB_AUG]^2 */
+  sunrealtype** Amat;
+  sunrealtype** Nmat;
+  sunrealtype** Dmat;
+  sunrealtype** Pmat;
+  sunrealtype** Tmat;
+  sunindextype* pivots;
+
+  /* Counters */
+  long int nfe;   /* num f calls                */
+  long int njv;   /* num Jv products            */
+  long int nkri;  /* num Krylov iterations      */
+  long int nkcf;  /* num Krylov conv. failures  */
+
+}* ARKodeExpRBStepMem;
+
+/*===============================================================
+  ExpRB time step module private function prototypes
+  ===============================================================*/
+
+/* Interface routines supplied to ARKODE */
+int expRBStep_Init(ARKodeMem ark_mem, int init_type);
+int expRBStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
+                      int mode);
+int expRBStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr);
+int expRBStep_SetDefaults(ARKodeMem ark_mem);
+int expRBStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile,
+                            SUNOutputFormat fmt);
+int expRBStep_WriteParameters(ARKodeMem ark_mem, FILE* fp);
+int expRBStep_Resize(ARKodeMem ark_mem, N_Vector y0, sunrealtype hscale,
+                     sunrealtype t0, ARKVecResizeFn resize, void* resize_data);
+void expRBStep_Free(ARKodeMem ark_mem);
+void expRBStep_PrintMem(ARKodeMem ark_mem, FILE* outfile);
+int expRBStep_GetEstLocalErrors(ARKodeMem ark_mem, N_Vector ele);
+
+/* Internal utility routines */
+int expRBStep_AccessARKODEStepMem(void* arkode_mem, const char* fname,
+                                  ARKodeMem* ark_mem,
+                                  ARKodeExpRBStepMem* step_mem);
+int expRBStep_AccessStepMem(ARKodeMem ark_mem, const char* fname,
+                            ARKodeExpRBStepMem* step_mem);
+sunbooleantype expRBStep_CheckNVector(N_Vector tmpl);
+int expRBStep_AllocKrylov(ARKodeMem ark_mem, ARKodeExpRBStepMem step_mem);
+void expRBStep_FreeKrylov(ARKodeMem ark_mem, ARKodeExpRBStepMem step_mem);
+int expRBStep_Jv(ARKodeMem ark_mem, ARKodeExpRBStepMem step_mem, N_Vector v,
+                 N_Vector Jv, N_Vector work);
+int expRBStep_Phi(ARKodeMem ark_mem, ARKodeExpRBStepMem step_mem, int k,
+                  N_Vector b, sunrealtype hscale, N_Vector out, int* nflagPtr);
+int expRBStep_DenseExpm(ARKodeExpRBStepMem step_mem, int n);
+void expRBStep_MatMul(int n, sunrealtype** A, sunrealtype** B, sunrealtype** C);
+
+/*===============================================================
+  Reusable ExpRBStep Error Messages
+  ===============================================================*/
+
+/* Initialization and I/O error messages */
+#define MSG_EXPRBSTEP_NO_MEM "Time step module memory is NULL."
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,344 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * This is the implementation file for the optional input and
+ * output functions for the ARKODE ExpRBStep time stepper module.
+ *--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/sundials_math.h>
+#include <sundials/sundials_types.h>
+
+#include "arkode_exprbstep_impl.h"
+
+/*===============================================================
+  Exported optional input functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  ExpRBStepSetJacTimes:
+
+  Specifies the Jacobian-vector product function used in the
+  Krylov approximations. A NULL input selects the internal
+  difference quotient approximation.
+  ---------------------------------------------------------------*/
+int ExpRBStepSetJacTimes(void* arkode_mem, ARKLsJacTimesVecFn jtimes)
+{
+  ARKodeMem ark_mem;
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeExpRBStepMem structures */
+  retval = expRBStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  step_mem->jtimes = jtimes;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  ExpRBStepSetMaxKrylovDim:
+
+  Specifies the maximum dimension of the Krylov subspaces. A
+  value <= 0 restores the default.
+  ---------------------------------------------------------------*/
+int ExpRBStepSetMaxKrylovDim(void* arkode_mem, int maxl)
+{
+  ARKodeMem ark_mem;
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeExpRBStepMem structures */
+  retval = expRBStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (maxl <= 0) { step_mem->maxl = EXPRB_MAXL; }
+  else { step_mem->maxl = maxl; }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  ExpRBStepSetEpsKrylov:
+
+  Specifies the factor relating the Krylov error tolerance to the
+  local error test. A value <= 0 restores the default.
+  ---------------------------------------------------------------*/
+int ExpRBStepSetEpsKrylov(void* arkode_mem, sunrealtype eps_krylov)
+{
+  ARKodeMem ark_mem;
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeExpRBStepMem structures */
+  retval = expRBStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (eps_krylov <= ZERO) { step_mem->eps_kry = EXPRB_EPS_KRYLOV; }
+  else { step_mem->eps_kry = eps_krylov; }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  ExpRBStepSetAutonomous:
+
+  Specifies that f does not depend on t, so the time derivative
+  of f is not approximated in each step.
+  ---------------------------------------------------------------*/
+int ExpRBStepSetAutonomous(void* arkode_mem, sunbooleantype autonomous)
+{
+  ARKodeMem ark_mem;
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeExpRBStepMem structures */
+  retval = expRBStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  step_mem->autonomous = autonomous;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Exported optional output functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  ExpRBStepGetNumRhsEvals:
+
+  Returns the current number of calls to f
+  ---------------------------------------------------------------*/
+int ExpRBStepGetNumRhsEvals(void* arkode_mem, long int* fevals)
+{
+  ARKodeMem ark_mem;
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeExpRBStepMem structures */
+  retval = expRBStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get values from step_mem */
+  *fevals = step_mem->nfe;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  ExpRBStepGetNumJtimesEvals:
+
+  Returns the current number of Jacobian-vector products
+  ---------------------------------------------------------------*/
+int ExpRBStepGetNumJtimesEvals(void* arkode_mem, long int* njvevals)
+{
+  ARKodeMem ark_mem;
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeExpRBStepMem structures */
+  retval = expRBStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get values from step_mem */
+  *njvevals = step_mem->njv;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  ExpRBStepGetNumKrylovIters:
+
+  Returns the current number of Arnoldi iterations
+  ---------------------------------------------------------------*/
+int ExpRBStepGetNumKrylovIters(void* arkode_mem, long int* nkiters)
+{
+  ARKodeMem ark_mem;
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeExpRBStepMem structures */
+  retval = expRBStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get values from step_mem */
+  *nkiters = step_mem->nkri;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  ExpRBStepGetNumKrylovConvFails:
+
+  Returns the current number of Krylov approximations that did
+  not converge
+  ---------------------------------------------------------------*/
+int ExpRBStepGetNumKrylovConvFails(void* arkode_mem, long int* nkcfails)
+{
+  ARKodeMem ark_mem;
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeExpRBStepMem structures */
+  retval = expRBStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get values from step_mem */
+  *nkcfails = step_mem->nkcf;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Private functions attached to ARKODE
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  expRBStep_SetDefaults:
+
+  Resets all ExpRBStep optional inputs to their default values.
+  Does not change problem-defining function pointers or
+  user_data pointer.
+  ---------------------------------------------------------------*/
+int expRBStep_SetDefaults(ARKodeMem ark_mem)
+{
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeExpRBStepMem structure */
+  retval = expRBStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Set default Krylov and problem parameters */
+  step_mem->jtimes     = NULL;
+  step_mem->maxl       = EXPRB_MAXL;
+  step_mem->eps_kry    = EXPRB_EPS_KRYLOV;
+  step_mem->autonomous = SUNFALSE;
+
+  /* Set the method and embedding orders */
+  ark_mem->hadapt_mem->q = 3;
+  ark_mem->hadapt_mem->p = 2;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  expRBStep_GetEstLocalErrors: Returns the current local truncation
+  error estimate vector
+  ---------------------------------------------------------------*/
+int expRBStep_GetEstLocalErrors(ARKodeMem ark_mem, N_Vector ele)
+{
+  int retval;
+  ARKodeExpRBStepMem step_mem;
+  retval = expRBStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* return an error if local truncation error is not computed */
+  if (ark_mem->fixedstep) { return (ARK_STEPPER_UNSUPPORTED); }
+
+  /* otherwise, copy local truncation error vector to output */
+  N_VScale(ONE, ark_mem->tempv1, ele);
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  expRBStep_PrintAllStats:
+
+  Prints integrator statistics
+  ---------------------------------------------------------------*/
+int expRBStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile,
+                            SUNOutputFormat fmt)
+{
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeExpRBStepMem structure */
+  retval = expRBStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  switch (fmt)
+  {
+  case SUN_OUTPUTFORMAT_TABLE:
+    fprintf(outfile, "RHS fn evals                 = %ld\n", step_mem->nfe);
+    fprintf(outfile, "Jac-times evals              = %ld\n", step_mem->njv);
+    fprintf(outfile, "Krylov iters                 = %ld\n", step_mem->nkri);
+    fprintf(outfile, "Krylov conv fails            = %ld\n", step_mem->nkcf);
+    if (ark_mem->nst > 0)
+    {
+      fprintf(outfile, "Avg Krylov iters per step    = %.6g\n",
+              (double)step_mem->nkri / (double)ark_mem->nst);
+    }
+    break;
+  case SUN_OUTPUTFORMAT_CSV:
+    fprintf(outfile, ",RHS fn evals,%ld", step_mem->nfe);
+    fprintf(outfile, ",Jac-times evals,%ld", step_mem->njv);
+    fprintf(outfile, ",Krylov iters,%ld", step_mem->nkri);
+    fprintf(outfile, ",Krylov conv fails,%ld", step_mem->nkcf);
+    if (ark_mem->nst > 0)
+    {
+      fprintf(outfile, ",Avg Krylov iters per step,%.16g",
+              (double)step_mem->nkri / (double)ark_mem->nst);
+    }
+    else { fprintf(outfile, ",Avg Krylov iters per step,0"); }
+    fprintf(outfile, "\n");
+    break;
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid formatting option.");
+    return (ARK_ILL_INPUT);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  expRBStep_WriteParameters:
+
+  Outputs all solver parameters to the provided file pointer.
+  ---------------------------------------------------------------*/
+int expRBStep_WriteParameters(ARKodeMem ark_mem, FILE* fp)
+{
+  ARKodeExpRBStepMem step_mem;
+  int retval;
+
+  /* access ARKodeExpRBStepMem structure */
+  retval = expRBStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* print integrator parameters to file */
+  fprintf(fp, "ExpRBStep time step module parameters:\n");
+  fprintf(fp, "  Method exprb32 (order 3, embedding order 2)\n");
+  fprintf(fp, "  Maximum Krylov dimension %i\n", step_mem->maxl);
+  fprintf(fp, "  Krylov tolerance factor %" RSYM "\n", step_mem->eps_kry);
+  fprintf(fp, "  Autonomous problem %s\n",
+          step_mem->autonomous ? "yes" : "no");
+  fprintf(fp, "  User Jacobian-vector product %s\n",
+          (step_mem->jtimes != NULL) ? "yes" : "no");
+  fprintf(fp, "\n");
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
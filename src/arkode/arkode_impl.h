@@ -30,6 +30,7 @@
 #include <sundials/sundials_linearsolver.h>
 
 #include "arkode_adapt_impl.h"
+#include "arkode_adjoint_impl.h"
 #include "arkode_relaxation_impl.h"
 #include "arkode_root_impl.h"
 #include "arkode_types_impl.h"
@@ -108,6 +109,13 @@ extern "C" {
 #define RESET_INIT  1 /* reset initialization           */
 #define RESIZE_INIT 2 /* resize initialization          */
 
+/*---------------------------------------------------------------
+  State stream constants (ARKodeWriteState, ARKodeReadState)
+  ---------------------------------------------------------------*/
+#define ARK_STATE_ID      0x41524B53 /* stream identifier      */
+#define ARK_STATE_VERSION 1          /* stream layout version  */
+#define ARK_STATE_NHDR    5          /* int entries in header  */
+
 /*---------------------------------------------------------------
   Control constants for lower-level time-stepping functions
   ---------------------------------------------------------------*/
@@ -119,6 +127,7 @@ extern "C" {
 #define PREV_ERR_FAIL  +8
 #define RHSFUNC_RECVR  +9
 #define CONSTR_RECVR   +10
+#define RETRY_STEP     +11
 
 /*---------------------------------------------------------------
   Return values for lower-level rootfinding functions
@@ -415,6 +424,9 @@ struct ARKodeMemRec
   sunbooleantype step_supports_relaxation;
   ARKTimestepSetRelaxFn step_setrelaxfn;
 
+  /* Time stepper module -- discrete adjoint */
+  ARKAdjGetMethodFn step_getadjointmethod;
+
   /* Time stepper module -- implcit solvers */
   sunbooleantype step_supports_implicit;
   ARKTimestepAttachLinsolFn step_attachlinsol;
@@ -512,6 +524,18 @@ struct ARKodeMemRec
   long int netf;         /* num error test failures                    */
   long int nconstrfails; /* number of constraint failures              */
 
+  /* Jacobian evaluation cost model (see ARKodeSetJacEvalCostModel) */
+  sunbooleantype costmodel; /* time the nonlinear solver and lsetup calls */
+  sunrealtype tjac;         /* time in lsetup calls that updated J        */
+  sunrealtype tjaclast;     /* time of the last lsetup that updated J     */
+  sunrealtype tlsetup;      /* time in lsetup calls that reused J         */
+  sunrealtype tnls;         /* time in nonlinear solves excluding lsetup  */
+
+  /* Accumulated temporal error estimate */
+  ARKAccumError AccumErrorType; /* type of error accumulation            */
+  sunrealtype AccumError;       /* accumulated error estimate            */
+  sunrealtype AccumErrorStart;  /* time when accumulation was reset      */
+
   /* Space requirements for ARKODE */
   sunindextype lrw1; /* no. of sunrealtype words in 1 N_Vector          */
   sunindextype liw1; /* no. of integer words in 1 N_Vector           */
@@ -540,10 +564,17 @@ struct ARKodeMemRec
   sunbooleantype relax_enabled; /* is relaxation enabled?    */
   ARKodeRelaxMem relax_mem;     /* relaxation data structure */
 
+  /* Discrete Adjoint Data */
+  ARKodeAdjMem adj_mem; /* forward step record and adjoint workspace */
+
   /* User-supplied step solution post-processing function */
   ARKPostProcessFn ProcessStep;
   void* ps_data; /* pointer to user_data */
 
+  /* User-supplied solution output function */
+  SUNOutputFn outputfn;
+  void* output_data; /* pointer passed to outputfn */
+
   /* User-supplied stage solution post-processing function */
   ARKPostProcessFn ProcessStage;
 
@@ -585,6 +616,7 @@ void arkProcessError(ARKodeMem ark_mem, int error_code, int line,
 
 ARKodeMem arkCreate(SUNContext sunctx);
 int arkInit(ARKodeMem ark_mem, sunrealtype t0, N_Vector y0, int init_type);
+int arkSetState(ARKodeMem ark_mem, sunrealtype tR, N_Vector yR);
 sunbooleantype arkAllocVec(ARKodeMem ark_mem, N_Vector tmpl, N_Vector* v);
 sunbooleantype arkAllocVecArray(int count, N_Vector tmpl, N_Vector** v,
                                 sunindextype lrw1, long int* lrw,
@@ -606,8 +638,14 @@ void arkFreeVecArray(int count, N_Vector** v, sunindextype lrw1, long int* lrw,
 void arkFreeVectors(ARKodeMem ark_mem);
 sunbooleantype arkCheckTimestepper(ARKodeMem ark_mem);
 sunbooleantype arkCheckNvector(N_Vector tmpl);
+void arkStateHeader(int hdr[]);
+sunbooleantype arkStateIO(FILE* fp, void* data, size_t size, size_t n,
+                          sunbooleantype save);
+sunbooleantype arkStateVector(FILE* fp, N_Vector v, sunbooleantype save);
+sunbooleantype arkStateTransfer(ARKodeMem ark_mem, FILE* fp, sunbooleantype save);
 
 int arkInitialSetup(ARKodeMem ark_mem, sunrealtype tout);
+int arkSetDirection(ARKodeMem ark_mem, sunrealtype tout);
 int arkStopTests(ARKodeMem ark_mem, sunrealtype tout, N_Vector yout,
                  sunrealtype* tret, int itask, int* ier);
 int arkHin(ARKodeMem ark_mem, sunrealtype tout);
@@ -697,6 +735,11 @@ int arkGetLastKFlag(void* arkode_mem, int* last_kflag);
 #define MSG_ARK_NULL_DKY       "dky = NULL illegal."
 #define MSG_ARK_BAD_T          "Illegal value for t. " MSG_TIME_INT
 #define MSG_ARK_NO_ROOT        "Rootfinding was not initialized."
+#define MSG_ARK_NULL_FP        "fp = NULL illegal."
+#define MSG_ARK_STATE_WRITE    "Writing the integrator state failed."
+#define MSG_ARK_STATE_READ     "Reading the integrator state failed."
+#define MSG_ARK_STATE_BAD \
+  "The saved state is not compatible with this integrator."
 
 /* ARKODE Error Messages */
 #define MSG_ARK_YOUT_NULL "yout = NULL illegal."
@@ -771,6 +814,8 @@ int arkGetLastKFlag(void* arkode_mem, int* last_kflag);
 #define MSG_ARK_VECTOROP_ERR "At " MSG_TIME ", a vector operation failed."
 #define MSG_ARK_INNERSTEP_FAILED \
   "At " MSG_TIME ", the inner stepper failed in an unrecoverable manner."
+#define MSG_ARK_OUTPUTFUNC_FAIL \
+  "At " MSG_TIME ", the output function failed in an unrecoverable manner."
 #define MSG_ARK_POSTPROCESS_STEP_FAIL \
   "At " MSG_TIME                      \
   ", the step postprocessing routine failed in an unrecoverable manner."
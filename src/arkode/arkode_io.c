@@ -1377,6 +1377,31 @@ int ARKodeSetPostprocessStepFn(void* arkode_mem, ARKPostProcessFn ProcessStep)
   return (ARK_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  ARKodeSetOutputFn:
+
+  Specifies a function called with the solution (tn, yn) after
+  each successful step, e.g., SUNOutputWriter_OutputFn, and the
+  data pointer passed to it.  A NULL input function disables the
+  output.  The function must not modify yn.
+  ---------------------------------------------------------------*/
+int ARKodeSetOutputFn(void* arkode_mem, SUNOutputFn fn, void* output_data)
+{
+  ARKodeMem ark_mem;
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  ark_mem->outputfn    = fn;
+  ark_mem->output_data = output_data;
+
+  return (ARK_SUCCESS);
+}
+
 /*---------------------------------------------------------------
   ARKodeSetPostprocessStageFn:
 
@@ -1510,6 +1535,66 @@ int ARKodeSetMaxNumConstrFails(void* arkode_mem, int maxfails)
   return (ARK_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  ARKodeSetAccumulatedErrorType:
+
+  Specifies the type of accumulation of the local temporal error
+  estimates over the steps taken since the last reset (none, max,
+  sum, or time-weighted average).  Changing the type resets the
+  accumulated value.
+  ---------------------------------------------------------------*/
+int ARKodeSetAccumulatedErrorType(void* arkode_mem, ARKAccumError accum_type)
+{
+  ARKodeMem ark_mem;
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  /* Guard against use for non-adaptive time stepper modules */
+  if (!ark_mem->step_supports_adaptive)
+  {
+    arkProcessError(ark_mem, ARK_STEPPER_UNSUPPORTED, __LINE__, __func__,
+                    __FILE__, "time-stepping module does not support temporal adaptivity");
+    return (ARK_STEPPER_UNSUPPORTED);
+  }
+
+  if ((accum_type < ARK_ACCUMERROR_NONE) || (accum_type > ARK_ACCUMERROR_AVG))
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Illegal accumulated error type");
+    return (ARK_ILL_INPUT);
+  }
+
+  ark_mem->AccumErrorType = accum_type;
+  return (ARKodeResetAccumulatedError(arkode_mem));
+}
+
+/*---------------------------------------------------------------
+  ARKodeResetAccumulatedError:
+
+  Resets the accumulated temporal error estimate to zero, starting
+  a new accumulation interval at the current time.
+  ---------------------------------------------------------------*/
+int ARKodeResetAccumulatedError(void* arkode_mem)
+{
+  ARKodeMem ark_mem;
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  ark_mem->AccumError      = ZERO;
+  ark_mem->AccumErrorStart = ark_mem->tn;
+  return (ARK_SUCCESS);
+}
+
 /*---------------------------------------------------------------
   ARKodeSetCFLFraction:
 
@@ -2220,6 +2305,43 @@ int ARKodeGetTolScaleFactor(void* arkode_mem, sunrealtype* tolsfact)
   return (ARK_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  ARKodeGetAccumulatedError:
+
+  Returns the accumulated temporal error estimate since the last
+  reset, scaled by the relative tolerance.
+  ---------------------------------------------------------------*/
+int ARKodeGetAccumulatedError(void* arkode_mem, sunrealtype* accum_error)
+{
+  sunrealtype dt;
+  ARKodeMem ark_mem;
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  if (ark_mem->AccumErrorType == ARK_ACCUMERROR_NONE)
+  {
+    arkProcessError(ark_mem, ARK_WARNING, __LINE__, __func__, __FILE__,
+                    "Error accumulation is disabled");
+    return (ARK_WARNING);
+  }
+
+  if (ark_mem->AccumErrorType == ARK_ACCUMERROR_AVG)
+  {
+    dt = SUNRabs(ark_mem->tn - ark_mem->AccumErrorStart);
+    if (dt > ZERO) { *accum_error = ark_mem->AccumError / dt; }
+    else { *accum_error = ZERO; }
+  }
+  else { *accum_error = ark_mem->AccumError; }
+
+  *accum_error *= ark_mem->reltol;
+  return (ARK_SUCCESS);
+}
+
 /*---------------------------------------------------------------
   ARKodeGetErrWeights:
 
@@ -2853,6 +2975,12 @@ char* ARKodeGetReturnFlagName(long int flag)
   case ARK_RELAX_JAC_FAIL: sprintf(name, "ARK_RELAX_JAC_FAIL"); break;
   case ARK_CONTROLLER_ERR: sprintf(name, "ARK_CONTROLLER_ERR"); break;
   case ARK_STEPPER_UNSUPPORTED: sprintf(name, "ARK_STEPPER_UNSUPPORTED"); break;
+  case ARK_ADJ_MEM_NULL: sprintf(name, "ARK_ADJ_MEM_NULL"); break;
+  case ARK_DOMEIG_FAIL: sprintf(name, "ARK_DOMEIG_FAIL"); break;
+  case ARK_MAX_STAGE_LIMIT_FAIL:
+    sprintf(name, "ARK_MAX_STAGE_LIMIT_FAIL");
+    break;
+  case ARK_OUTPUTFUNC_FAIL: sprintf(name, "ARK_OUTPUTFUNC_FAIL"); break;
   case ARK_UNRECOGNIZED_ERROR: sprintf(name, "ARK_UNRECOGNIZED_ERROR"); break;
   default: sprintf(name, "NONE");
   }
@@ -31,6 +31,7 @@
 #define ZERO         SUN_RCONST(0.0)
 #define PT25         SUN_RCONST(0.25)
 #define ONE          SUN_RCONST(1.0)
+#define TWO          SUN_RCONST(2.0)
 
 /* Prototypes for internal functions */
 static int arkLsLinSys(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix A,
@@ -38,6 +39,11 @@ static int arkLsLinSys(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix A,
                        sunrealtype gamma, void* arkode_mem, N_Vector tmp1,
                        N_Vector tmp2, N_Vector tmp3);
 
+static sunbooleantype arkLsCostModelJbad(ARKodeMem ark_mem, ARKLsMem arkls_mem);
+
+static sunrealtype arkLsForcingTol(ARKLsMem arkls_mem, int curiter,
+                                   sunrealtype bnorm, sunrealtype tolmax);
+
 /*===============================================================
   Exported routines
   ===============================================================*/
@@ -190,6 +196,7 @@ int ARKodeSetLinearSolver(void* arkode_mem, SUNLinearSolver LS, SUNMatrix A)
   arkls_mem->jtimes   = arkLsDQJtimes;
   arkls_mem->Jt_data  = ark_mem;
   arkls_mem->Jt_f     = ark_mem->step_getimplicitrhs(ark_mem);
+  arkls_mem->Jt_fdir  = NULL;
 
   if (arkls_mem->Jt_f == NULL)
   {
@@ -219,6 +226,14 @@ int ARKodeSetLinearSolver(void* arkode_mem, SUNLinearSolver LS, SUNMatrix A)
   arkls_mem->eplifac   = ARKLS_EPLIN;
   arkls_mem->last_flag = ARKLS_SUCCESS;
 
+  /* The adaptive forcing term is disabled by default */
+  arkls_mem->forcing = SUNFALSE;
+  arkls_mem->fgamma  = ARKLS_FGAMMA;
+  arkls_mem->falpha  = ARKLS_FALPHA;
+  arkls_mem->frelax  = ARKLS_FRELAX;
+  arkls_mem->feta    = ARKLS_FETA0;
+  arkls_mem->fbnorm  = ZERO;
+
   /* If LS supports ATimes, attach ARKLs routine */
   if (LS->ops->setatimes)
   {
@@ -737,6 +752,140 @@ int ARKodeSetLSNormFactor(void* arkode_mem, sunrealtype nrmfac)
   return (ARKLS_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  ARKodeSetLSForcing enables or disables the adaptive
+  (Eisenstat-Walker) forcing term for the iterative linear
+  solver tolerance.
+  ---------------------------------------------------------------*/
+int ARKodeSetLSForcing(void* arkode_mem, sunbooleantype adaptive)
+{
+  ARKodeMem ark_mem;
+  ARKLsMem arkls_mem;
+  int retval;
+
+  /* Return immediately if arkode_mem is NULL */
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  /* Guard against use for time steppers that do not need an algebraic solver */
+  if (!ark_mem->step_supports_implicit)
+  {
+    arkProcessError(ark_mem, ARK_STEPPER_UNSUPPORTED, __LINE__, __func__,
+                    __FILE__, "time-stepping module does not require an algebraic solver");
+    return (ARK_STEPPER_UNSUPPORTED);
+  }
+
+  /* access ARKLsMem structure */
+  retval = arkLs_AccessLMem(ark_mem, __func__, &arkls_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* store input and return */
+  arkls_mem->forcing = adaptive;
+  arkls_mem->feta    = ARKLS_FETA0;
+  arkls_mem->fbnorm  = ZERO;
+
+  return (ARKLS_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  ARKodeSetLSForcingParams sets the parameters gamma and alpha of
+  the adaptive forcing term; non-positive values restore the
+  defaults.
+  ---------------------------------------------------------------*/
+int ARKodeSetLSForcingParams(void* arkode_mem, sunrealtype fgamma,
+                             sunrealtype falpha)
+{
+  ARKodeMem ark_mem;
+  ARKLsMem arkls_mem;
+  int retval;
+
+  /* Return immediately if arkode_mem is NULL */
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  /* Guard against use for time steppers that do not need an algebraic solver */
+  if (!ark_mem->step_supports_implicit)
+  {
+    arkProcessError(ark_mem, ARK_STEPPER_UNSUPPORTED, __LINE__, __func__,
+                    __FILE__, "time-stepping module does not require an algebraic solver");
+    return (ARK_STEPPER_UNSUPPORTED);
+  }
+
+  /* access ARKLsMem structure */
+  retval = arkLs_AccessLMem(ark_mem, __func__, &arkls_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* check for legal gamma and alpha */
+  if (fgamma > ONE || falpha > TWO || (falpha > ZERO && falpha <= ONE))
+  {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_LS_BAD_FORCING);
+    return (ARKLS_ILL_INPUT);
+  }
+
+  /* store input and return */
+  arkls_mem->fgamma = (fgamma <= ZERO) ? ARKLS_FGAMMA : fgamma;
+  arkls_mem->falpha = (falpha <= ZERO) ? ARKLS_FALPHA : falpha;
+
+  return (ARKLS_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  ARKodeSetLSForcingMaxRelax sets the maximum factor by which the
+  adaptive forcing term relaxes the fixed linear solver
+  tolerance; a non-positive value restores the default.
+  ---------------------------------------------------------------*/
+int ARKodeSetLSForcingMaxRelax(void* arkode_mem, sunrealtype frelax)
+{
+  ARKodeMem ark_mem;
+  ARKLsMem arkls_mem;
+  int retval;
+
+  /* Return immediately if arkode_mem is NULL */
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  /* Guard against use for time steppers that do not need an algebraic solver */
+  if (!ark_mem->step_supports_implicit)
+  {
+    arkProcessError(ark_mem, ARK_STEPPER_UNSUPPORTED, __LINE__, __func__,
+                    __FILE__, "time-stepping module does not require an algebraic solver");
+    return (ARK_STEPPER_UNSUPPORTED);
+  }
+
+  /* access ARKLsMem structure */
+  retval = arkLs_AccessLMem(ark_mem, __func__, &arkls_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* check for legal frelax */
+  if (frelax > ZERO && frelax < ONE)
+  {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_LS_BAD_FRELAX);
+    return (ARKLS_ILL_INPUT);
+  }
+
+  /* store input and return */
+  arkls_mem->frelax = (frelax <= ZERO) ? ARKLS_FRELAX : frelax;
+
+  return (ARKLS_SUCCESS);
+}
+
 /*---------------------------------------------------------------
   ARKodeSetJacEvalFrequency specifies the frequency for
   recomputing the Jacobian matrix and/or preconditioner.
@@ -774,6 +923,46 @@ int ARKodeSetJacEvalFrequency(void* arkode_mem, long int msbj)
   return (ARKLS_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  ARKodeSetJacEvalCostModel enables or disables deciding when to
+  recompute the Jacobian matrix and/or preconditioner from the
+  measured solver costs instead of the evaluation frequency.
+  ---------------------------------------------------------------*/
+int ARKodeSetJacEvalCostModel(void* arkode_mem, sunbooleantype onoff)
+{
+  ARKodeMem ark_mem;
+  ARKLsMem arkls_mem;
+  int retval;
+
+  /* Return immediately if arkode_mem is NULL */
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  /* Guard against use for time steppers that do not use a nonlinear
+     solver, as the solver costs are only measured there */
+  if (!ark_mem->step_supports_implicit ||
+      (ark_mem->step_getnonlinearsystemdata == NULL))
+  {
+    arkProcessError(ark_mem, ARK_STEPPER_UNSUPPORTED, __LINE__, __func__,
+                    __FILE__, "time-stepping module does not use a nonlinear solver");
+    return (ARK_STEPPER_UNSUPPORTED);
+  }
+
+  /* access ARKLsMem structure */
+  retval = arkLs_AccessLMem(ark_mem, __func__, &arkls_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* store input and return */
+  ark_mem->costmodel = onoff;
+
+  return (ARKLS_SUCCESS);
+}
+
 /*---------------------------------------------------------------
   ARKodeSetLinearSolutionScaling enables or disables scaling the
   linear solver solution to account for changes in gamma.
@@ -916,6 +1105,10 @@ int ARKodeSetJacTimes(void* arkode_mem, ARKLsJacTimesSetupFn jtsetup,
     return (ARKLS_ILL_INPUT);
   }
 
+  /* the Jacobian-vector product is being replaced, drop any directional
+     derivative function set for the previous one */
+  arkls_mem->Jt_fdir = NULL;
+
   /* store function pointers for user-supplied routines in ARKLs
      interface (NULL jtimes implies use of DQ default) */
   if (jtimes != NULL)
@@ -1001,6 +1194,53 @@ int ARKodeSetJacTimesRhsFn(void* arkode_mem, ARKRhsFn jtimesRhsFn)
   return (ARKLS_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  ARKodeSetJacTimesDirFn specifies a user-supplied function that
+  evaluates the implicit ODE right-hand side together with its
+  directional derivative. When set, it replaces the internal
+  finite difference Jacobian-vector product.
+  ---------------------------------------------------------------*/
+int ARKodeSetJacTimesDirFn(void* arkode_mem, ARKRhsDirFn jtimesDirFn)
+{
+  ARKodeMem ark_mem;
+  ARKLsMem arkls_mem;
+  int retval;
+
+  /* Return immediately if arkode_mem is NULL */
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  /* Guard against use for time steppers that do not need an algebraic solver */
+  if (!ark_mem->step_supports_implicit)
+  {
+    arkProcessError(ark_mem, ARK_STEPPER_UNSUPPORTED, __LINE__, __func__,
+                    __FILE__, "time-stepping module does not require an algebraic solver");
+    return (ARK_STEPPER_UNSUPPORTED);
+  }
+
+  /* access ARKLsMem structure */
+  retval = arkLs_AccessLMem(ark_mem, __func__, &arkls_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* check if using internal finite difference approximation */
+  if (!(arkls_mem->jtimesDQ))
+  {
+    arkProcessError(ark_mem, ARKLS_ILL_INPUT, __LINE__, __func__,
+                    __FILE__, "Internal finite-difference Jacobian-vector product is disabled.");
+    return (ARKLS_ILL_INPUT);
+  }
+
+  /* store function pointer (NULL implies use the difference quotient) */
+  arkls_mem->Jt_fdir = jtimesDirFn;
+
+  return (ARKLS_SUCCESS);
+}
+
 /* ARKodeSetLinSysFn specifies the linear system setup function. */
 int ARKodeSetLinSysFn(void* arkode_mem, ARKLsLinSysFn linsys)
 {
@@ -1290,6 +1530,47 @@ int ARKodeGetNumLinRhsEvals(void* arkode_mem, long int* nfevalsLS)
   return (ARKLS_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  ARKodeGetLinSolveTimes returns the wall-clock times spent in
+  linear solver setups that evaluated the Jacobian, in setups that
+  reused it, and in the remaining nonlinear solver iterations.
+  ---------------------------------------------------------------*/
+int ARKodeGetLinSolveTimes(void* arkode_mem, sunrealtype* tjac,
+                           sunrealtype* tlsetup, sunrealtype* tnls)
+{
+  ARKodeMem ark_mem;
+  ARKLsMem arkls_mem;
+  int retval;
+
+  /* Return immediately if arkode_mem is NULL */
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  ark_mem = (ARKodeMem)arkode_mem;
+
+  /* Return 0 for incompatible steppers */
+  if (!ark_mem->step_supports_implicit)
+  {
+    *tjac    = ZERO;
+    *tlsetup = ZERO;
+    *tnls    = ZERO;
+    return (ARK_SUCCESS);
+  }
+
+  /* access ARKLsMem structure */
+  retval = arkLs_AccessLMem(ark_mem, __func__, &arkls_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* set outputs and return */
+  *tjac    = ark_mem->tjac;
+  *tlsetup = ark_mem->tlsetup;
+  *tnls    = ark_mem->tnls;
+  return (ARKLS_SUCCESS);
+}
+
 /*---------------------------------------------------------------
   ARKodeGetNumPrecEvals returns the number of calls to the
   user- or ARKODE-supplied preconditioner setup routine.
@@ -2819,7 +3100,9 @@ int arkLsBandDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
   This routine generates a difference quotient approximation to
   the Jacobian-vector product fi_y(t,y) * v. The approximation is
   Jv = [fi(y + v*sig) - fi(y)]/sig, where sig = 1 / ||v||_WRMS,
-  i.e. the WRMS norm of v*sig is 1.
+  i.e. the WRMS norm of v*sig is 1. If a directional derivative
+  function was supplied with ARKodeSetJacTimesDirFn (and no
+  alternative jtimesRhsFn), the exact product is returned instead.
   ---------------------------------------------------------------*/
 int arkLsDQJtimes(N_Vector v, N_Vector Jv, sunrealtype t, N_Vector y,
                   N_Vector fy, void* arkode_mem, N_Vector work)
@@ -2833,6 +3116,17 @@ int arkLsDQJtimes(N_Vector v, N_Vector Jv, sunrealtype t, N_Vector y,
   retval = arkLs_AccessARKODELMem(arkode_mem, __func__, &ark_mem, &arkls_mem);
   if (retval != ARK_SUCCESS) { return (retval); }
 
+  /* Compute Jv with the directional derivative function (work = fi) as long
+     as it differentiates the function used by the difference quotient */
+  if ((arkls_mem->Jt_fdir != NULL) &&
+      (arkls_mem->Jt_f == ark_mem->step_getimplicitrhs(ark_mem)))
+  {
+    retval = arkls_mem->Jt_fdir(t, y, v, work, Jv, ark_mem->user_data);
+    if (retval < 0) { return (-1); }
+    if (retval > 0) { return (+1); }
+    return (0);
+  }
+
   /* Initialize perturbation to 1/||v|| */
   sig = ONE / N_VWrmsNorm(v, ark_mem->ewt);
 
@@ -3153,7 +3447,7 @@ int arkLsSetup(ARKodeMem ark_mem, int convfail, sunrealtype tpred,
   void* ark_step_massmem = NULL;
   SUNMatrix M            = NULL;
   sunrealtype gamma, gamrat;
-  sunbooleantype dgamma_fail, *jcur;
+  sunbooleantype dgamma_fail, *jcur, jold;
   int retval;
 
   /* access ARKLsMem structure */
@@ -3186,9 +3480,12 @@ int arkLsSetup(ARKodeMem ark_mem, int convfail, sunrealtype tpred,
   /* Use initsetup, gamma/gammap, and convfail to set J/P eval. flag jok;
      Note: the "ARK_FAIL_BAD_J" test is asking whether the nonlinear
      solver converged due to a bad system Jacobian AND our gamma was
-     fine, indicating that the J and/or P were invalid */
-  arkls_mem->jbad = (ark_mem->initsetup) ||
-                    (ark_mem->nst >= arkls_mem->nstlj + arkls_mem->msbj) ||
+     fine, indicating that the J and/or P were invalid. The cost model
+     replaces the test on the number of steps since the last update. */
+  if (ark_mem->costmodel) { jold = arkLsCostModelJbad(ark_mem, arkls_mem); }
+  else { jold = (ark_mem->nst >= arkls_mem->nstlj + arkls_mem->msbj); }
+
+  arkls_mem->jbad = (ark_mem->initsetup) || jold ||
                     ((convfail == ARK_FAIL_BAD_J) && (!dgamma_fail)) ||
                     (convfail == ARK_FAIL_OTHER);
 
@@ -3225,8 +3522,10 @@ int arkLsSetup(ARKodeMem ark_mem, int convfail, sunrealtype tpred,
     if (*jcurPtr)
     {
       arkls_mem->nje++;
-      arkls_mem->nstlj = ark_mem->nst;
-      arkls_mem->tnlj  = tpred;
+      arkls_mem->nstlj    = ark_mem->nst;
+      arkls_mem->tnlj     = tpred;
+      arkls_mem->tcost_lj = ark_mem->tnls + ark_mem->tlsetup;
+      arkls_mem->tstep    = ZERO;
     }
 
     /* Check linsys() return value and return if necessary */
@@ -3267,8 +3566,10 @@ int arkLsSetup(ARKodeMem ark_mem, int convfail, sunrealtype tpred,
     if (*jcurPtr)
     {
       arkls_mem->npe++;
-      arkls_mem->nstlj = ark_mem->nst;
-      arkls_mem->tnlj  = tpred;
+      arkls_mem->nstlj    = ark_mem->nst;
+      arkls_mem->tnlj     = tpred;
+      arkls_mem->tcost_lj = ark_mem->tnls + ark_mem->tlsetup;
+      arkls_mem->tstep    = ZERO;
     }
 
     /* Update jcurPtr flag if we suggested an update */
@@ -3278,6 +3579,76 @@ int arkLsSetup(ARKodeMem ark_mem, int convfail, sunrealtype tpred,
   return (arkls_mem->last_flag);
 }
 
+/*---------------------------------------------------------------
+  arkLsCostModelJbad: decides from the measured solver costs
+  whether the Jacobian (or preconditioner) should be recomputed.
+  The cost per step since the last setup call is compared to the
+  average cost per step since the last Jacobian evaluation, which
+  includes the time of that evaluation; a new evaluation is
+  requested once the former exceeds the latter. The cost per step
+  is an exponential average (weight ARKLS_CMWT) that restarts at
+  each evaluation, so a single slow step does not trigger one.
+  The decision depends on measured times, so the step sequence is
+  not reproducible from run to run with the cost model enabled.
+  ---------------------------------------------------------------*/
+static sunbooleantype arkLsCostModelJbad(ARKodeMem ark_mem, ARKLsMem arkls_mem)
+{
+  sunrealtype tcost, tavg, tstep;
+  sunbooleantype jbad = SUNFALSE;
+
+  tcost = ark_mem->tnls + ark_mem->tlsetup;
+
+  if ((ark_mem->nst > arkls_mem->nstls) && (ark_mem->nst > arkls_mem->nstlj))
+  {
+    tavg  = (ark_mem->tjaclast + tcost - arkls_mem->tcost_lj) /
+           (sunrealtype)(ark_mem->nst - arkls_mem->nstlj);
+    tstep = (tcost - arkls_mem->tcost_ls) /
+            (sunrealtype)(ark_mem->nst - arkls_mem->nstls);
+    if (arkls_mem->tstep > ZERO)
+    {
+      tstep = ARKLS_CMWT * tstep + (ONE - ARKLS_CMWT) * arkls_mem->tstep;
+    }
+    arkls_mem->tstep = tstep;
+    jbad             = (tstep > tavg);
+  }
+
+  arkls_mem->tcost_ls = tcost;
+  arkls_mem->nstls    = ark_mem->nst;
+
+  return (jbad);
+}
+
+/*---------------------------------------------------------------
+  arkLsForcingTol: returns the adaptive linear solver tolerance
+  min(eta_k * ||b_k||, tolmax) (in the WRMS norm) for Newton
+  iteration k, with the Eisenstat-Walker forcing term (choice 2)
+
+    eta_k = gamma * (||b_k|| / ||b_{k-1}||)^alpha,
+
+  safeguarded by gamma * eta_{k-1}^alpha when that exceeds 0.1 and
+  bounded by ARKLS_FETAMX. The first iteration uses ARKLS_FETA0.
+  ---------------------------------------------------------------*/
+static sunrealtype arkLsForcingTol(ARKLsMem arkls_mem, int curiter,
+                                   sunrealtype bnorm, sunrealtype tolmax)
+{
+  sunrealtype eta, etasafe;
+
+  if (curiter == 0 || arkls_mem->fbnorm <= ZERO) { eta = ARKLS_FETA0; }
+  else
+  {
+    eta = arkls_mem->fgamma *
+          SUNRpowerR(bnorm / arkls_mem->fbnorm, arkls_mem->falpha);
+    etasafe = arkls_mem->fgamma * SUNRpowerR(arkls_mem->feta, arkls_mem->falpha);
+    if (etasafe > SUN_RCONST(0.1)) { eta = SUNMAX(eta, etasafe); }
+  }
+  eta = SUNMIN(eta, ARKLS_FETAMX);
+
+  arkls_mem->feta   = eta;
+  arkls_mem->fbnorm = bnorm;
+
+  return (SUNMIN(eta * bnorm, tolmax));
+}
+
 /*---------------------------------------------------------------
   arkLsSolve: interfaces between ARKODE and the generic
   SUNLinearSolver object LS, by setting the appropriate tolerance
@@ -3320,6 +3691,13 @@ int arkLsSolve(ARKodeMem ark_mem, N_Vector b, sunrealtype tnow, N_Vector ynow,
       arkls_mem->last_flag = ARKLS_SUCCESS;
       return (arkls_mem->last_flag);
     }
+    /* With the adaptive forcing term, relax the tolerance relative to
+       the current residual (between deltar and frelax * deltar) */
+    if (arkls_mem->forcing)
+    {
+      deltar = SUNMAX(deltar, arkLsForcingTol(arkls_mem, mnewt, bnorm,
+                                              arkls_mem->frelax * deltar));
+    }
     /* Adjust tolerance for 2-norm */
     delta = deltar * arkls_mem->nrmfac;
   }
@@ -3978,6 +4356,10 @@ int arkLsInitializeCounters(ARKLsMem arkls_mem)
   arkls_mem->ncfl     = 0;
   arkls_mem->njtsetup = 0;
   arkls_mem->njtimes  = 0;
+  arkls_mem->tcost_lj = ZERO;
+  arkls_mem->tcost_ls = ZERO;
+  arkls_mem->tstep    = ZERO;
+  arkls_mem->nstls    = 0;
   return (0);
 }
 
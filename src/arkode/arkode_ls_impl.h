@@ -35,9 +35,29 @@ extern "C" {
   ARKLS_EPLIN  default value for factor by which the tolerance
                on the nonlinear iteration is multiplied to get
                a tolerance on the linear iteration
+
+  ARKLS_FGAMMA default gamma of the adaptive forcing term
+
+  ARKLS_FALPHA default alpha of the adaptive forcing term
+
+  ARKLS_FETA0  adaptive forcing term at the first Newton iteration
+
+  ARKLS_FETAMX maximum adaptive forcing term
+
+  ARKLS_FRELAX default maximum factor by which the adaptive forcing
+               term relaxes the linear solver tolerance
+
+  ARKLS_CMWT   weight of the latest per-step cost in the smoothed
+               per-step cost of the Jacobian evaluation cost model
   ---------------------------------------------------------------*/
-#define ARKLS_MSBJ  51
-#define ARKLS_EPLIN SUN_RCONST(0.05)
+#define ARKLS_MSBJ   51
+#define ARKLS_EPLIN  SUN_RCONST(0.05)
+#define ARKLS_FGAMMA SUN_RCONST(0.9)
+#define ARKLS_FALPHA SUN_RCONST(2.0)
+#define ARKLS_FETA0  SUN_RCONST(0.1)
+#define ARKLS_FETAMX SUN_RCONST(0.9)
+#define ARKLS_FRELAX SUN_RCONST(2.0)
+#define ARKLS_CMWT   SUN_RCONST(0.25)
 
 /*---------------------------------------------------------------
   Types: ARKLsMemRec, ARKLsMem
@@ -63,6 +83,14 @@ typedef struct ARKLsMemRec
   sunrealtype eplifac; /* nonlinear -> linear tol scaling factor        */
   sunrealtype nrmfac;  /* integrator -> LS norm conversion factor       */
 
+  /* Adaptive forcing term (see ARKodeSetLSForcing) */
+  sunbooleantype forcing; /* use the Eisenstat-Walker forcing term      */
+  sunrealtype fgamma;     /* forcing term parameter gamma               */
+  sunrealtype falpha;     /* forcing term parameter alpha               */
+  sunrealtype frelax;     /* maximum relaxation of the fixed tolerance  */
+  sunrealtype feta;       /* forcing term of the last linear solve      */
+  sunrealtype fbnorm;     /* WRMS norm of b in the last linear solve    */
+
   /* Linear solver, matrix and vector objects/pointers */
   SUNLinearSolver LS; /* generic linear solver object                  */
   SUNMatrix A;        /* A = M - gamma * df/dy                         */
@@ -87,6 +115,12 @@ typedef struct ARKLsMemRec
   long int njtimes;  /* njtimes = total number of calls to jtimes    */
   sunrealtype tnlj;  /* tnlj = t_n at last jac/pset call             */
 
+  /* Jacobian evaluation cost model (see ARKodeSetJacEvalCostModel) */
+  sunrealtype tcost_lj; /* per-step solver time at last jac/pset call */
+  sunrealtype tcost_ls; /* per-step solver time at last setup call    */
+  sunrealtype tstep;    /* smoothed solver time per step since jac    */
+  long int nstls;       /* nst at last setup call                     */
+
   /* Preconditioner computation
     (a) user-provided:
         - P_data == user_data
@@ -105,11 +139,13 @@ typedef struct ARKLsMemRec
         - jtimesDQ == SUNFALSE
     (b) internal jtimes
         - Jt_data == arkode_mem
-        - jtimesDQ == SUNTRUE   */
+        - jtimesDQ == SUNTRUE
+        - Jt_fdir != NULL uses the user's directional derivative */
   sunbooleantype jtimesDQ;
   ARKLsJacTimesSetupFn jtsetup;
   ARKLsJacTimesVecFn jtimes;
   ARKRhsFn Jt_f;
+  ARKRhsDirFn Jt_fdir;
   void* Jt_data;
 
   /* Linear system setup function
@@ -264,6 +300,9 @@ int arkLSGetCurrentMassMatrix(ARKodeMem ark_mem, SUNMatrix* M);
 #define MSG_LS_MASSMEM_NULL "Mass matrix solver memory is NULL."
 #define MSG_LS_BAD_SIZES \
   "Illegal bandwidth parameter(s). Must have 0 <=  ml, mu <= N-1."
+#define MSG_LS_BAD_FORCING \
+  "Illegal forcing term parameters (need gamma <= 1 and 1 < alpha <= 2)."
+#define MSG_LS_BAD_FRELAX "frelax < 1 illegal."
 
 #define MSG_LS_PSET_FAILED \
   "The preconditioner setup routine failed in an unrecoverable manner."
@@ -0,0 +1,1569 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * This is the implementation file for ARKODE's low-storage
+ * Runge-Kutta (LSRK) time stepper module.
+ *
+ * The strong stability preserving methods SSP(s,2), SSP(s,3) and
+ * SSP(10,4) of Ketcheson (SIAM J. Sci. Comput., 30(4), 2008) are
+ * evaluated in their low-storage forms, so a step only uses the
+ * ARKODE state (yn, fn, ycur) and at most three temporary vectors
+ * regardless of the number of stages. The error estimates use
+ * embeddings whose weights are nonzero at only a few stages, so
+ * they do not require extra storage either.
+ *
+ * The super-time-stepping methods RKC2 and RKL2 select the number of
+ * stages in each step from a spectral radius estimate. Their three
+ * term recurrences only store the two previous stages.
+ *--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/sundials_context.h>
+#include <sundials/sundials_math.h>
+
+#include "arkode_impl.h"
+#include "arkode_interp_impl.h"
+#include "arkode_lsrkstep_impl.h"
+
+#define FOURTH SUN_RCONST(0.25)
+#define SIXTH  (ONE / SUN_RCONST(6.0))
+
+/*===============================================================
+  Exported functions
+  ===============================================================*/
+
+void* LSRKStepCreateSSP(ARKRhsFn rhs, sunrealtype t0, N_Vector y0,
+                        SUNContext sunctx)
+{
+  return (lsrkStep_Create_Commons(rhs, t0, y0, sunctx, LSRK_SSP_DEFAULT_METHOD));
+}
+
+void* LSRKStepCreateSTS(ARKRhsFn rhs, sunrealtype t0, N_Vector y0,
+                        SUNContext sunctx)
+{
+  return (lsrkStep_Create_Commons(rhs, t0, y0, sunctx, LSRK_STS_DEFAULT_METHOD));
+}
+
+/*---------------------------------------------------------------
+  LSRKStepReInitSSP, LSRKStepReInitSTS:
+
+  This routine re-initializes the LSRKStep module to solve a new
+  problem of the same size as was previously solved. This routine
+  should also be called when the problem dynamics or desired solvers
+  have changed dramatically, so that the problem integration should
+  resume as if started from scratch.
+
+  Note all internal counters are set to 0 on re-initialization.
+  ---------------------------------------------------------------*/
+int LSRKStepReInitSSP(void* arkode_mem, ARKRhsFn rhs, sunrealtype t0, N_Vector y0)
+{
+  return (lsrkStep_ReInit_Commons(arkode_mem, rhs, t0, y0));
+}
+
+int LSRKStepReInitSTS(void* arkode_mem, ARKRhsFn rhs, sunrealtype t0, N_Vector y0)
+{
+  return (lsrkStep_ReInit_Commons(arkode_mem, rhs, t0, y0));
+}
+
+/*===============================================================
+  Interface routines supplied to ARKODE
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  lsrkStep_Resize:
+
+  This routine resizes the power iteration vector (if allocated)
+  and requests a new dominant eigenvalue estimate.
+  ---------------------------------------------------------------*/
+int lsrkStep_Resize(ARKodeMem ark_mem, N_Vector y0,
+                    SUNDIALS_MAYBE_UNUSED sunrealtype hscale,
+                    SUNDIALS_MAYBE_UNUSED sunrealtype t0, ARKVecResizeFn resize,
+                    void* resize_data)
+{
+  ARKodeLSRKStepMem step_mem;
+  sunindextype lrw1, liw1, lrw_diff, liw_diff;
+  int retval;
+
+  /* access ARKodeLSRKStepMem structure */
+  retval = lsrkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Determine change in vector sizes */
+  lrw1 = liw1 = 0;
+  if (y0->ops->nvspace != NULL) { N_VSpace(y0, &lrw1, &liw1); }
+  lrw_diff      = lrw1 - ark_mem->lrw1;
+  liw_diff      = liw1 - ark_mem->liw1;
+  ark_mem->lrw1 = lrw1;
+  ark_mem->liw1 = liw1;
+
+  /* Resize the power iteration vector */
+  if (step_mem->dom_eig_v != NULL)
+  {
+    if (!arkResizeVec(ark_mem, resize, resize_data, lrw_diff, liw_diff, y0,
+                      &step_mem->dom_eig_v))
+    {
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      "Unable to resize vector");
+      return (ARK_MEM_FAIL);
+    }
+  }
+
+  /* The previous estimate does not apply to the resized problem */
+  step_mem->dom_eig_update = SUNTRUE;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_Free frees all LSRKStep memory.
+  ---------------------------------------------------------------*/
+void lsrkStep_Free(ARKodeMem ark_mem)
+{
+  ARKodeLSRKStepMem step_mem;
+
+  /* nothing to do if ark_mem is already NULL */
+  if (ark_mem == NULL) { return; }
+
+  /* conditional frees on non-NULL LSRKStep module */
+  if (ark_mem->step_mem != NULL)
+  {
+    step_mem = (ARKodeLSRKStepMem)ark_mem->step_mem;
+
+    /* free the power iteration vector */
+    if (step_mem->dom_eig_v != NULL)
+    {
+      arkFreeVec(ark_mem, &step_mem->dom_eig_v);
+      step_mem->dom_eig_v = NULL;
+    }
+
+    /* free the time stepper module itself */
+    free(ark_mem->step_mem);
+    ark_mem->step_mem = NULL;
+  }
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_PrintMem:
+
+  This routine outputs the memory from the LSRKStep structure to
+  a specified file pointer (useful when debugging).
+  ---------------------------------------------------------------*/
+void lsrkStep_PrintMem(ARKodeMem ark_mem, FILE* outfile)
+{
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeLSRKStepMem structure */
+  retval = lsrkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return; }
+
+  /* output integer quantities */
+  fprintf(outfile, "LSRKStep: method = %i\n", (int)step_mem->method);
+  fprintf(outfile, "LSRKStep: q = %i\n", step_mem->q);
+  fprintf(outfile, "LSRKStep: p = %i\n", step_mem->p);
+  fprintf(outfile, "LSRKStep: req_stages = %i\n", step_mem->req_stages);
+  fprintf(outfile, "LSRKStep: stage_max_limit = %i\n",
+          step_mem->stage_max_limit);
+  fprintf(outfile, "LSRKStep: stage_max = %i\n", step_mem->stage_max);
+
+  /* output long integer quantities */
+  fprintf(outfile, "LSRKStep: nfe = %li\n", step_mem->nfe);
+  fprintf(outfile, "LSRKStep: dom_eig_nfe = %li\n", step_mem->dom_eig_nfe);
+  fprintf(outfile, "LSRKStep: dom_eig_num = %li\n", step_mem->dom_eig_num);
+  fprintf(outfile, "LSRKStep: dom_eig_freq = %li\n", step_mem->dom_eig_freq);
+
+  /* output sunrealtype quantities */
+  fprintf(outfile, "LSRKStep: lambdaR = %" RSYM "\n", step_mem->lambdaR);
+  fprintf(outfile, "LSRKStep: lambdaI = %" RSYM "\n", step_mem->lambdaI);
+  fprintf(outfile, "LSRKStep: spectral_radius = %" RSYM "\n",
+          step_mem->spectral_radius);
+  fprintf(outfile, "LSRKStep: dom_eig_safety = %" RSYM "\n",
+          step_mem->dom_eig_safety);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_Init:
+
+  This routine is called just prior to performing internal time
+  steps (after all user "set" routines have been called) from
+  within arkInitialSetup.
+
+  With initialization type FIRST_INIT this routine:
+  - checks the method and sets its step function and orders
+  - limits the interpolant degree by the method order
+  - requests a new dominant eigenvalue estimate (STS methods)
+  - sets the call_fullrhs flag
+
+  With other initialization types, this routine does nothing.
+  ---------------------------------------------------------------*/
+int lsrkStep_Init(ARKodeMem ark_mem, int init_type)
+{
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeLSRKStepMem structure */
+  retval = lsrkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* immediately return if resize or reset */
+  if (init_type == RESIZE_INIT || init_type == RESET_INIT)
+  {
+    return (ARK_SUCCESS);
+  }
+
+  /* enforce use of arkEwtSmallReal if using a fixed step size
+     and an internal error weight function */
+  if (ark_mem->fixedstep && !ark_mem->user_efun)
+  {
+    ark_mem->user_efun = SUNFALSE;
+    ark_mem->efun      = arkEwtSetSmallReal;
+    ark_mem->e_data    = ark_mem;
+  }
+
+  /* Set the step function and method properties */
+  retval = lsrkStep_SetMethodProperties(ark_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Override the interpolant degree (if needed), used in arkInitialSetup */
+  if (step_mem->q > 1 && ark_mem->interp_degree > (step_mem->q - 1))
+  {
+    /* Limit max degree to at most one less than the method global order */
+    ark_mem->interp_degree = step_mem->q - 1;
+  }
+
+  /* Request a new dominant eigenvalue estimate */
+  step_mem->dom_eig_update = SUNTRUE;
+
+  /* Signal to shared arkode module that full RHS evaluations are required */
+  ark_mem->call_fullrhs = SUNTRUE;
+
+  return (ARK_SUCCESS);
+}
+
+/*------------------------------------------------------------------------------
+  lsrkStep_FullRHS:
+
+  This is just a wrapper to call the user-supplied RHS function, f(t,y). The
+  methods are not FSAL, so the RHS is evaluated in every mode unless ARKODE
+  has already marked ark_mem->fn as current.
+  ----------------------------------------------------------------------------*/
+int lsrkStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
+                     int mode)
+{
+  int retval;
+  ARKodeLSRKStepMem step_mem;
+
+  /* access ARKodeLSRKStepMem structure */
+  retval = lsrkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* perform RHS functions contingent on 'mode' argument */
+  switch (mode)
+  {
+  case ARK_FULLRHS_START:
+  case ARK_FULLRHS_END:
+  case ARK_FULLRHS_OTHER:
+
+    /* call f */
+    retval = step_mem->fe(t, y, f, ark_mem->user_data);
+    step_mem->nfe++;
+    if (retval != 0)
+    {
+      arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_RHSFUNC_FAILED, t);
+      return (ARK_RHSFUNC_FAIL);
+    }
+
+    break;
+
+  default:
+    /* return with RHS failure if unknown mode is passed */
+    arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                    "Unknown full RHS mode");
+    return (ARK_RHSFUNC_FAIL);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_TakeStepSSPs2:
+
+  This routine performs a single step of the s-stage, second order
+  SSP method with the first order embedding
+
+    bt = ((s+1)/s^2, 1/s, ..., 1/s, (s-1)/s^2),
+
+  for which y - ytilde = h/s^2 (F_s - F_1). Only ycur and tempv2
+  are used as stage storage.
+
+  The output variable dsmPtr should contain estimate of the
+  weighted local error if an embedding is present; otherwise it
+  should be 0.
+
+  The input/output variable nflagPtr is used to gauge convergence
+  of any algebraic solvers within the step.  As this routine
+  involves no algebraic solve, it is set to 0 (success).
+
+  The return value from this routine is:
+            0 => step completed successfully
+           >0 => step encountered recoverable failure;
+                 reduce step and retry (if possible)
+           <0 => step encountered unrecoverable failure
+  ---------------------------------------------------------------*/
+int lsrkStep_TakeStepSSPs2(ARKodeMem ark_mem, sunrealtype* dsmPtr,
+                           int* nflagPtr)
+{
+  int retval, j;
+  sunrealtype rs, sm1inv;
+  ARKodeLSRKStepMem step_mem;
+
+  /* initialize algebraic solver convergence flag to success */
+  *nflagPtr = ARK_SUCCESS;
+
+  /* initialize output */
+  *dsmPtr = ZERO;
+
+  /* access ARKodeLSRKStepMem structure */
+  retval = lsrkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  rs     = (sunrealtype)step_mem->req_stages;
+  sm1inv = ONE / (rs - ONE);
+
+  /* The method is not FSAL, so the first stage RHS is the full RHS at the
+     start of the step (possibly already computed by ARKODE) */
+  if (!(ark_mem->fn_is_current))
+  {
+    retval = ark_mem->step_fullrhs(ark_mem, ark_mem->tn, ark_mem->yn,
+                                   ark_mem->fn, ARK_FULLRHS_START);
+    if (retval) { return ARK_RHSFUNC_FAIL; }
+    ark_mem->fn_is_current = SUNTRUE;
+  }
+
+  /* Stage 2 solution */
+  N_VLinearSum(ONE, ark_mem->yn, sm1inv * ark_mem->h, ark_mem->fn,
+               ark_mem->ycur);
+
+  /* Stages 2, ..., s-1 */
+  for (j = 2; j < step_mem->req_stages; j++)
+  {
+    ark_mem->tcur = ark_mem->tn + ((sunrealtype)j - ONE) * sm1inv * ark_mem->h;
+
+    retval = lsrkStep_StageRHS(ark_mem, step_mem, ark_mem->ycur,
+                               ark_mem->tempv2);
+    if (retval != ARK_SUCCESS) { return (retval); }
+
+    N_VLinearSum(ONE, ark_mem->ycur, sm1inv * ark_mem->h, ark_mem->tempv2,
+                 ark_mem->ycur);
+  }
+
+  /* Stage s and the time step solution */
+  ark_mem->tcur = ark_mem->tn + ark_mem->h;
+
+  retval = lsrkStep_StageRHS(ark_mem, step_mem, ark_mem->ycur,
+                               ark_mem->tempv2);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  step_mem->cvals[0] = ONE - ONE / rs;
+  step_mem->Xvecs[0] = ark_mem->ycur;
+  step_mem->cvals[1] = ark_mem->h / rs;
+  step_mem->Xvecs[1] = ark_mem->tempv2;
+  step_mem->cvals[2] = ONE / rs;
+  step_mem->Xvecs[2] = ark_mem->yn;
+
+  retval = N_VLinearCombination(3, step_mem->cvals, step_mem->Xvecs,
+                                ark_mem->ycur);
+  if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+  /* Compute yerr (if step adaptivity enabled) */
+  if (!ark_mem->fixedstep)
+  {
+    N_VLinearSum(ark_mem->h / (rs * rs), ark_mem->tempv2,
+                 -ark_mem->h / (rs * rs), ark_mem->fn, ark_mem->tempv1);
+    *dsmPtr = N_VWrmsNorm(ark_mem->tempv1, ark_mem->ewt);
+  }
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
+  SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
+                     "ARKODE::lsrkStep_TakeStepSSPs2", "error-test",
+                     "step = %li, h = %" RSYM ", dsm = %" RSYM, ark_mem->nst,
+                     ark_mem->h, *dsmPtr);
+#endif
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_TakeStepSSPs3:
+
+  This routine performs a single step of the s = n^2 stage, third
+  order SSP method. The second order embedding only weights the
+  first and last stages,
+
+    bt_1 = (r-2)/(2(r-1)),  bt_s = r/(2(r-1)),  r = n^2 - n,
+
+  since the last stage is evaluated at c_s = 1 - 1/r. The stages
+  use ycur and tempv2, and tempv3 holds the intermediate solution
+  reused by the stage n(n+1)/2 combination.
+
+  See lsrkStep_TakeStepSSPs2 for the input and output arguments.
+  ---------------------------------------------------------------*/
+int lsrkStep_TakeStepSSPs3(ARKodeMem ark_mem, sunrealtype* dsmPtr,
+                           int* nflagPtr)
+{
+  int retval, j, n, in1, in2;
+  sunrealtype rn, rinv, c, c2;
+  ARKodeLSRKStepMem step_mem;
+
+  /* initialize algebraic solver convergence flag to success */
+  *nflagPtr = ARK_SUCCESS;
+
+  /* initialize output */
+  *dsmPtr = ZERO;
+
+  /* access ARKodeLSRKStepMem structure */
+  retval = lsrkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  n    = (int)(SUNRsqrt((sunrealtype)step_mem->req_stages) + HALF);
+  rn   = (sunrealtype)n;
+  rinv = ONE / (rn * rn - rn);
+  in1  = (n - 1) * (n - 2) / 2;
+  in2  = n * (n + 1) / 2;
+
+  /* The method is not FSAL, so the first stage RHS is the full RHS at the
+     start of the step (possibly already computed by ARKODE) */
+  if (!(ark_mem->fn_is_current))
+  {
+    retval = ark_mem->step_fullrhs(ark_mem, ark_mem->tn, ark_mem->yn,
+                                   ark_mem->fn, ARK_FULLRHS_START);
+    if (retval) { return ARK_RHSFUNC_FAIL; }
+    ark_mem->fn_is_current = SUNTRUE;
+  }
+
+  /* Stage 2 solution, saving the intermediate solution if it is yn */
+  c2 = ZERO;
+  if (in1 == 0) { N_VScale(ONE, ark_mem->yn, ark_mem->tempv3); }
+  N_VLinearSum(ONE, ark_mem->yn, rinv * ark_mem->h, ark_mem->fn, ark_mem->ycur);
+  c = rinv;
+
+  /* Stages 2, ..., s */
+  for (j = 2; j <= step_mem->req_stages; j++)
+  {
+    if (j == in1 + 1)
+    {
+      N_VScale(ONE, ark_mem->ycur, ark_mem->tempv3);
+      c2 = c;
+    }
+
+    ark_mem->tcur = ark_mem->tn + c * ark_mem->h;
+
+    retval = lsrkStep_StageRHS(ark_mem, step_mem, ark_mem->ycur,
+                               ark_mem->tempv2);
+    if (retval != ARK_SUCCESS) { return (retval); }
+
+    if (j == in2)
+    {
+      step_mem->cvals[0] = (rn - ONE) / (TWO * rn - ONE);
+      step_mem->Xvecs[0] = ark_mem->ycur;
+      step_mem->cvals[1] = rn / (TWO * rn - ONE);
+      step_mem->Xvecs[1] = ark_mem->tempv3;
+      step_mem->cvals[2] = (rn - ONE) * rinv * ark_mem->h / (TWO * rn - ONE);
+      step_mem->Xvecs[2] = ark_mem->tempv2;
+
+      retval = N_VLinearCombination(3, step_mem->cvals, step_mem->Xvecs,
+                                    ark_mem->ycur);
+      if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+      c = (rn * c2 + (rn - ONE) * (c + rinv)) / (TWO * rn - ONE);
+    }
+    else
+    {
+      N_VLinearSum(ONE, ark_mem->ycur, rinv * ark_mem->h, ark_mem->tempv2,
+                   ark_mem->ycur);
+      c += rinv;
+    }
+  }
+
+  /* Compute yerr (if step adaptivity enabled) */
+  if (!ark_mem->fixedstep)
+  {
+    step_mem->cvals[0] = ONE;
+    step_mem->Xvecs[0] = ark_mem->ycur;
+    step_mem->cvals[1] = -ONE;
+    step_mem->Xvecs[1] = ark_mem->yn;
+    step_mem->cvals[2] = -ark_mem->h * (ONE - TWO * rinv) /
+                         (TWO * (ONE - rinv));
+    step_mem->Xvecs[2] = ark_mem->fn;
+    step_mem->cvals[3] = -ark_mem->h / (TWO * (ONE - rinv));
+    step_mem->Xvecs[3] = ark_mem->tempv2;
+
+    retval = N_VLinearCombination(4, step_mem->cvals, step_mem->Xvecs,
+                                  ark_mem->tempv1);
+    if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+    *dsmPtr = N_VWrmsNorm(ark_mem->tempv1, ark_mem->ewt);
+  }
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
+  SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
+                     "ARKODE::lsrkStep_TakeStepSSPs3", "error-test",
+                     "step = %li, h = %" RSYM ", dsm = %" RSYM, ark_mem->nst,
+                     ark_mem->h, *dsmPtr);
+#endif
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_TakeStepSSP104:
+
+  This routine performs a single step of the ten stage, fourth
+  order SSP method. The third order embedding
+
+    ytilde = yn + h (F_1 / 4 + F_5 / 4 + F_8 / 2)
+
+  uses stages 5 and 8 (both at c = 2/3), which are accumulated in
+  tempv1. The stages use ycur and tempv2, and tempv3 holds the
+  second register of the method.
+
+  See lsrkStep_TakeStepSSPs2 for the input and output arguments.
+  ---------------------------------------------------------------*/
+int lsrkStep_TakeStepSSP104(ARKodeMem ark_mem, sunrealtype* dsmPtr,
+                            int* nflagPtr)
+{
+  int retval, j;
+  ARKodeLSRKStepMem step_mem;
+
+  /* initialize algebraic solver convergence flag to success */
+  *nflagPtr = ARK_SUCCESS;
+
+  /* initialize output */
+  *dsmPtr = ZERO;
+
+  /* access ARKodeLSRKStepMem structure */
+  retval = lsrkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* The method is not FSAL, so the first stage RHS is the full RHS at the
+     start of the step (possibly already computed by ARKODE) */
+  if (!(ark_mem->fn_is_current))
+  {
+    retval = ark_mem->step_fullrhs(ark_mem, ark_mem->tn, ark_mem->yn,
+                                   ark_mem->fn, ARK_FULLRHS_START);
+    if (retval) { return ARK_RHSFUNC_FAIL; }
+    ark_mem->fn_is_current = SUNTRUE;
+  }
+
+  /* Stage 2 solution */
+  N_VLinearSum(ONE, ark_mem->yn, SIXTH * ark_mem->h, ark_mem->fn,
+               ark_mem->ycur);
+
+  /* Stages 2, ..., 5 */
+  for (j = 2; j <= 5; j++)
+  {
+    ark_mem->tcur = ark_mem->tn + ((sunrealtype)j - ONE) * SIXTH * ark_mem->h;
+
+    retval = lsrkStep_StageRHS(ark_mem, step_mem, ark_mem->ycur,
+                               ark_mem->tempv2);
+    if (retval != ARK_SUCCESS) { return (retval); }
+
+    N_VLinearSum(ONE, ark_mem->ycur, SIXTH * ark_mem->h, ark_mem->tempv2,
+                 ark_mem->ycur);
+
+    if (j == 5 && !ark_mem->fixedstep)
+    {
+      N_VScale(FOURTH, ark_mem->tempv2, ark_mem->tempv1);
+    }
+  }
+
+  /* Combine the two registers, q2 = (yn + 9 q1) / 25, q1 = 15 q2 - 5 q1 */
+  N_VLinearSum(SUN_RCONST(0.04), ark_mem->yn, SUN_RCONST(0.36), ark_mem->ycur,
+               ark_mem->tempv3);
+  N_VLinearSum(SUN_RCONST(15.0), ark_mem->tempv3, -FIVE,
+               ark_mem->ycur, ark_mem->ycur);
+
+  /* Stages 6, ..., 9 */
+  for (j = 6; j <= 9; j++)
+  {
+    ark_mem->tcur = ark_mem->tn + ((sunrealtype)j - FOUR) * SIXTH *
+                                    ark_mem->h;
+
+    retval = lsrkStep_StageRHS(ark_mem, step_mem, ark_mem->ycur,
+                               ark_mem->tempv2);
+    if (retval != ARK_SUCCESS) { return (retval); }
+
+    N_VLinearSum(ONE, ark_mem->ycur, SIXTH * ark_mem->h, ark_mem->tempv2,
+                 ark_mem->ycur);
+
+    if (j == 8 && !ark_mem->fixedstep)
+    {
+      N_VLinearSum(ONE, ark_mem->tempv1, HALF, ark_mem->tempv2,
+                   ark_mem->tempv1);
+    }
+  }
+
+  /* Stage 10 and the time step solution */
+  ark_mem->tcur = ark_mem->tn + ark_mem->h;
+
+  retval = lsrkStep_StageRHS(ark_mem, step_mem, ark_mem->ycur,
+                               ark_mem->tempv2);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  step_mem->cvals[0] = SUN_RCONST(0.6);
+  step_mem->Xvecs[0] = ark_mem->ycur;
+  step_mem->cvals[1] = ONE;
+  step_mem->Xvecs[1] = ark_mem->tempv3;
+  step_mem->cvals[2] = TENTH * ark_mem->h;
+  step_mem->Xvecs[2] = ark_mem->tempv2;
+
+  retval = N_VLinearCombination(3, step_mem->cvals, step_mem->Xvecs,
+                                ark_mem->ycur);
+  if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+  /* Compute yerr (if step adaptivity enabled) */
+  if (!ark_mem->fixedstep)
+  {
+    step_mem->cvals[0] = -ark_mem->h;
+    step_mem->Xvecs[0] = ark_mem->tempv1;
+    step_mem->cvals[1] = ONE;
+    step_mem->Xvecs[1] = ark_mem->ycur;
+    step_mem->cvals[2] = -ONE;
+    step_mem->Xvecs[2] = ark_mem->yn;
+    step_mem->cvals[3] = -FOURTH * ark_mem->h;
+    step_mem->Xvecs[3] = ark_mem->fn;
+
+    retval = N_VLinearCombination(4, step_mem->cvals, step_mem->Xvecs,
+                                  ark_mem->tempv1);
+    if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+    *dsmPtr = N_VWrmsNorm(ark_mem->tempv1, ark_mem->ewt);
+  }
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
+  SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
+                     "ARKODE::lsrkStep_TakeStepSSP104", "error-test",
+                     "step = %li, h = %" RSYM ", dsm = %" RSYM, ark_mem->nst,
+                     ark_mem->h, *dsmPtr);
+#endif
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_TakeStepRKC:
+
+  This routine performs a single step of the s-stage, second
+  order Runge-Kutta-Chebyshev method of Sommeijer, Shampine and
+  Verwer (J. Comput. Appl. Math., 88(2), 1998) with damping
+  parameter eps = 2/13. The number of stages is selected from the
+  spectral radius estimate so that the step is stable.
+
+  The three term recurrence only needs the two previous stages,
+  which rotate through ycur, tempv2 and tempv3 such that the last
+  stage is stored in ycur, while tempv1 holds the stage RHS.
+
+  See lsrkStep_TakeStepSSPs2 for the input and output arguments.
+  ---------------------------------------------------------------*/
+int lsrkStep_TakeStepRKC(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr)
+{
+  int retval, j, ss;
+  sunrealtype w0, w1, zj, zjm1, zjm2, dzj, dzjm1, dzjm2, d2zj, d2zjm1, d2zjm2;
+  sunrealtype bj, bjm1, bjm2, ajm1, mu, nu, mus, thj, thjm1, thjm2;
+  N_Vector Y[3];
+  N_Vector yjm2;
+  ARKodeLSRKStepMem step_mem;
+
+  /* initialize algebraic solver convergence flag to success */
+  *nflagPtr = ARK_SUCCESS;
+
+  /* initialize output */
+  *dsmPtr = ZERO;
+
+  /* access ARKodeLSRKStepMem structure */
+  retval = lsrkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* select the number of stages (this also updates fn) */
+  retval = lsrkStep_STSStages(ark_mem, step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+  ss = step_mem->req_stages;
+
+  /* evaluate the Chebyshev polynomial derivatives at w0 to compute w1 */
+  w0     = ONE + LSRK_RKC_EPS / ((sunrealtype)ss * (sunrealtype)ss);
+  zjm1   = w0;
+  zjm2   = ONE;
+  dzjm1  = ONE;
+  dzjm2  = ZERO;
+  d2zjm1 = ZERO;
+  d2zjm2 = ZERO;
+  for (j = 2; j <= ss; j++)
+  {
+    zj     = TWO * w0 * zjm1 - zjm2;
+    dzj    = TWO * w0 * dzjm1 - dzjm2 + TWO * zjm1;
+    d2zj   = TWO * w0 * d2zjm1 - d2zjm2 + FOUR * dzjm1;
+    zjm2   = zjm1;
+    zjm1   = zj;
+    dzjm2  = dzjm1;
+    dzjm1  = dzj;
+    d2zjm2 = d2zjm1;
+    d2zjm1 = d2zj;
+  }
+  w1 = dzjm1 / d2zjm1;
+
+  /* stage j is stored in Y[j % 3], so that stage s is in ycur */
+  Y[ss % 3]       = ark_mem->ycur;
+  Y[(ss + 1) % 3] = ark_mem->tempv2;
+  Y[(ss + 2) % 3] = ark_mem->tempv3;
+
+  /* Stage 1 */
+  bjm1  = ONE / (FOUR * w0 * w0);
+  bjm2  = bjm1;
+  mus   = w1 * bjm1;
+  thjm2 = ZERO;
+  thjm1 = mus;
+  N_VLinearSum(ONE, ark_mem->yn, ark_mem->h * mus, ark_mem->fn, Y[1]);
+
+  /* Stages 2, ..., s */
+  zjm1   = w0;
+  zjm2   = ONE;
+  dzjm1  = ONE;
+  dzjm2  = ZERO;
+  d2zjm1 = ZERO;
+  d2zjm2 = ZERO;
+  for (j = 2; j <= ss; j++)
+  {
+    zj   = TWO * w0 * zjm1 - zjm2;
+    dzj  = TWO * w0 * dzjm1 - dzjm2 + TWO * zjm1;
+    d2zj = TWO * w0 * d2zjm1 - d2zjm2 + FOUR * dzjm1;
+    bj   = d2zj / (dzj * dzj);
+    ajm1 = ONE - zjm1 * bjm1;
+    mu   = TWO * w0 * bj / bjm1;
+    nu   = -bj / bjm2;
+    mus  = mu * w1 / w0;
+
+    /* RHS of the previous stage */
+    ark_mem->tcur = ark_mem->tn + thjm1 * ark_mem->h;
+
+    retval = lsrkStep_StageRHS(ark_mem, step_mem, Y[(j - 1) % 3],
+                               ark_mem->tempv1);
+    if (retval != ARK_SUCCESS) { return (retval); }
+
+    yjm2 = (j == 2) ? ark_mem->yn : Y[(j - 2) % 3];
+
+    step_mem->cvals[0] = mu;
+    step_mem->Xvecs[0] = Y[(j - 1) % 3];
+    step_mem->cvals[1] = nu;
+    step_mem->Xvecs[1] = yjm2;
+    step_mem->cvals[2] = ONE - mu - nu;
+    step_mem->Xvecs[2] = ark_mem->yn;
+    step_mem->cvals[3] = ark_mem->h * mus;
+    step_mem->Xvecs[3] = ark_mem->tempv1;
+    step_mem->cvals[4] = -ark_mem->h * mus * ajm1;
+    step_mem->Xvecs[4] = ark_mem->fn;
+
+    retval = N_VLinearCombination(5, step_mem->cvals, step_mem->Xvecs,
+                                  Y[j % 3]);
+    if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+    /* shift the data for the next stage */
+    thj    = mu * thjm1 + nu * thjm2 + mus * (ONE - ajm1);
+    thjm2  = thjm1;
+    thjm1  = thj;
+    bjm2   = bjm1;
+    bjm1   = bj;
+    zjm2   = zjm1;
+    zjm1   = zj;
+    dzjm2  = dzjm1;
+    dzjm1  = dzj;
+    d2zjm2 = d2zjm1;
+    d2zjm1 = d2zj;
+  }
+
+  /* Compute yerr (if step adaptivity enabled) */
+  if (!ark_mem->fixedstep)
+  {
+    retval = lsrkStep_STSErrorEstimate(ark_mem, step_mem, dsmPtr);
+    if (retval != ARK_SUCCESS) { return (retval); }
+  }
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
+  SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
+                     "ARKODE::lsrkStep_TakeStepRKC", "error-test",
+                     "step = %li, h = %" RSYM ", stages = %i, dsm = %" RSYM,
+                     ark_mem->nst, ark_mem->h, ss, *dsmPtr);
+#endif
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_TakeStepRKL:
+
+  This routine performs a single step of the s-stage, second
+  order Runge-Kutta-Legendre method of Meyer, Balsara and Aslam
+  (J. Comput. Phys., 257, 2014). The number of stages is selected
+  from the spectral radius estimate so that the step is stable.
+  The stage storage is the same as in lsrkStep_TakeStepRKC.
+
+  See lsrkStep_TakeStepSSPs2 for the input and output arguments.
+  ---------------------------------------------------------------*/
+int lsrkStep_TakeStepRKL(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr)
+{
+  int retval, j, ss;
+  sunrealtype rj, w1, bj, bjm1, bjm2, ajm1, mu, nu, mus, thj, thjm1, thjm2;
+  N_Vector Y[3];
+  N_Vector yjm2;
+  ARKodeLSRKStepMem step_mem;
+
+  /* initialize algebraic solver convergence flag to success */
+  *nflagPtr = ARK_SUCCESS;
+
+  /* initialize output */
+  *dsmPtr = ZERO;
+
+  /* access ARKodeLSRKStepMem structure */
+  retval = lsrkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* select the number of stages (this also updates fn) */
+  retval = lsrkStep_STSStages(ark_mem, step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+  ss = step_mem->req_stages;
+
+  w1 = FOUR / ((sunrealtype)ss * (sunrealtype)ss + (sunrealtype)ss - TWO);
+
+  /* stage j is stored in Y[j % 3], so that stage s is in ycur */
+  Y[ss % 3]       = ark_mem->ycur;
+  Y[(ss + 1) % 3] = ark_mem->tempv2;
+  Y[(ss + 2) % 3] = ark_mem->tempv3;
+
+  /* Stage 1 */
+  bjm1  = ONE / THREE;
+  bjm2  = bjm1;
+  mus   = w1 * bjm1;
+  thjm2 = ZERO;
+  thjm1 = mus;
+  N_VLinearSum(ONE, ark_mem->yn, ark_mem->h * mus, ark_mem->fn, Y[1]);
+
+  /* Stages 2, ..., s */
+  for (j = 2; j <= ss; j++)
+  {
+    rj   = (sunrealtype)j;
+    bj   = (rj * rj + rj - TWO) / (TWO * rj * (rj + ONE));
+    ajm1 = ONE - bjm1;
+    mu   = (TWO * rj - ONE) / rj * bj / bjm1;
+    nu   = -(rj - ONE) / rj * bj / bjm2;
+    mus  = mu * w1;
+
+    /* RHS of the previous stage */
+    ark_mem->tcur = ark_mem->tn + thjm1 * ark_mem->h;
+
+    retval = lsrkStep_StageRHS(ark_mem, step_mem, Y[(j - 1) % 3],
+                               ark_mem->tempv1);
+    if (retval != ARK_SUCCESS) { return (retval); }
+
+    yjm2 = (j == 2) ? ark_mem->yn : Y[(j - 2) % 3];
+
+    step_mem->cvals[0] = mu;
+    step_mem->Xvecs[0] = Y[(j - 1) % 3];
+    step_mem->cvals[1] = nu;
+    step_mem->Xvecs[1] = yjm2;
+    step_mem->cvals[2] = ONE - mu - nu;
+    step_mem->Xvecs[2] = ark_mem->yn;
+    step_mem->cvals[3] = ark_mem->h * mus;
+    step_mem->Xvecs[3] = ark_mem->tempv1;
+    step_mem->cvals[4] = -ark_mem->h * mus * ajm1;
+    step_mem->Xvecs[4] = ark_mem->fn;
+
+    retval = N_VLinearCombination(5, step_mem->cvals, step_mem->Xvecs,
+                                  Y[j % 3]);
+    if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+    /* shift the data for the next stage */
+    thj   = mu * thjm1 + nu * thjm2 + mus * (ONE - ajm1);
+    thjm2 = thjm1;
+    thjm1 = thj;
+    bjm2  = bjm1;
+    bjm1  = bj;
+  }
+
+  /* Compute yerr (if step adaptivity enabled) */
+  if (!ark_mem->fixedstep)
+  {
+    retval = lsrkStep_STSErrorEstimate(ark_mem, step_mem, dsmPtr);
+    if (retval != ARK_SUCCESS) { return (retval); }
+  }
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
+  SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
+                     "ARKODE::lsrkStep_TakeStepRKL", "error-test",
+                     "step = %li, h = %" RSYM ", stages = %i, dsm = %" RSYM,
+                     ark_mem->nst, ark_mem->h, ss, *dsmPtr);
+#endif
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Internal utility routines
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  lsrkStep_Create_Commons:
+
+  This routine creates the ARKODE and LSRKStep memory structures
+  shared by the SSP and STS constructors, for the method family
+  of the input method.
+  ---------------------------------------------------------------*/
+void* lsrkStep_Create_Commons(ARKRhsFn rhs, sunrealtype t0, N_Vector y0,
+                              SUNContext sunctx, ARKODE_LSRKMethodType method)
+{
+  ARKodeMem ark_mem;
+  ARKodeLSRKStepMem step_mem;
+  sunbooleantype nvectorOK;
+  int retval;
+
+  /* Check that rhs is supplied */
+  if (rhs == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_F);
+    return (NULL);
+  }
+
+  /* Check for legal input parameters */
+  if (y0 == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_Y0);
+    return (NULL);
+  }
+
+  if (!sunctx)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_SUNCTX);
+    return (NULL);
+  }
+
+  /* Test if all required vector operations are implemented */
+  nvectorOK = lsrkStep_CheckNVector(y0);
+  if (!nvectorOK)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_BAD_NVECTOR);
+    return (NULL);
+  }
+
+  /* Create ark_mem structure and set default values */
+  ark_mem = arkCreate(sunctx);
+  if (ark_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (NULL);
+  }
+
+  /* Allocate ARKodeLSRKStepMem structure, and initialize to zero */
+  step_mem = NULL;
+  step_mem = (ARKodeLSRKStepMem)malloc(sizeof(struct ARKodeLSRKStepMemRec));
+  if (step_mem == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_ARKMEM_FAIL);
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+  memset(step_mem, 0, sizeof(struct ARKodeLSRKStepMemRec));
+
+  /* Attach step_mem structure and function pointers to ark_mem */
+  ark_mem->step_init              = lsrkStep_Init;
+  ark_mem->step_fullrhs           = lsrkStep_FullRHS;
+  ark_mem->step_resize            = lsrkStep_Resize;
+  ark_mem->step                   = lsrkStep_TakeStepSSPs2;
+  ark_mem->step_printallstats     = lsrkStep_PrintAllStats;
+  ark_mem->step_writeparameters   = lsrkStep_WriteParameters;
+  ark_mem->step_free              = lsrkStep_Free;
+  ark_mem->step_printmem          = lsrkStep_PrintMem;
+  ark_mem->step_setdefaults       = lsrkStep_SetDefaults;
+  ark_mem->step_getestlocalerrors = lsrkStep_GetEstLocalErrors;
+  ark_mem->step_supports_adaptive = SUNTRUE;
+  ark_mem->step_mem               = (void*)step_mem;
+
+  /* Set the method family before setting the default values */
+  step_mem->method = method;
+
+  /* Set default values for optional inputs */
+  retval = lsrkStep_SetDefaults((void*)ark_mem);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Error setting default solver options");
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+
+  /* Copy the input parameters into ARKODE state */
+  step_mem->fe = rhs;
+
+  /* Update the ARKODE workspace requirements */
+  ark_mem->liw += 16; /* fcn ptrs, ints, long ints */
+  ark_mem->lrw += 9;
+
+  /* Initialize all the counters */
+  step_mem->nfe         = 0;
+  step_mem->dom_eig_nfe = 0;
+  step_mem->dom_eig_num = 0;
+  step_mem->stage_max   = 0;
+
+  /* Initialize main ARKODE infrastructure */
+  retval = arkInit(ark_mem, t0, y0, FIRST_INIT);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Unable to initialize main ARKODE infrastructure");
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+
+  return ((void*)ark_mem);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_ReInit_Commons:
+
+  This routine re-initializes the LSRKStep module to solve a new
+  problem of the same size as was previously solved. This routine
+  should also be called when the problem dynamics or desired solvers
+  have changed dramatically, so that the problem integration should
+  resume as if started from scratch.
+
+  Note all internal counters are set to 0 on re-initialization.
+  ---------------------------------------------------------------*/
+int lsrkStep_ReInit_Commons(void* arkode_mem, ARKRhsFn rhs, sunrealtype t0,
+                            N_Vector y0)
+{
+  ARKodeMem ark_mem;
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeLSRKStepMem structure */
+  retval = lsrkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Check if ark_mem was allocated */
+  if (ark_mem->MallocDone == SUNFALSE)
+  {
+    arkProcessError(ark_mem, ARK_NO_MALLOC, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MALLOC);
+    return (ARK_NO_MALLOC);
+  }
+
+  /* Check that rhs is supplied */
+  if (rhs == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_F);
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Check for legal input parameters */
+  if (y0 == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_Y0);
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Copy the input parameters into ARKODE state */
+  step_mem->fe = rhs;
+
+  /* Initialize main ARKODE infrastructure */
+  retval = arkInit(arkode_mem, t0, y0, FIRST_INIT);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Unable to initialize main ARKODE infrastructure");
+    return (retval);
+  }
+
+  /* Initialize all the counters */
+  step_mem->nfe         = 0;
+  step_mem->dom_eig_nfe = 0;
+  step_mem->dom_eig_num = 0;
+  step_mem->stage_max   = 0;
+
+  /* Request a new dominant eigenvalue estimate */
+  step_mem->dom_eig_update = SUNTRUE;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_AccessARKODEStepMem:
+
+  Shortcut routine to unpack both ark_mem and step_mem structures
+  from void* pointer.  If either is missing it returns ARK_MEM_NULL.
+  ---------------------------------------------------------------*/
+int lsrkStep_AccessARKODEStepMem(void* arkode_mem, const char* fname,
+                                 ARKodeMem* ark_mem, ARKodeLSRKStepMem* step_mem)
+{
+  /* access ARKodeMem structure */
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *ark_mem = (ARKodeMem)arkode_mem;
+
+  /* access ARKodeLSRKStepMem structure */
+  if ((*ark_mem)->step_mem == NULL)
+  {
+    arkProcessError(*ark_mem, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_LSRKSTEP_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *step_mem = (ARKodeLSRKStepMem)(*ark_mem)->step_mem;
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_AccessStepMem:
+
+  Shortcut routine to unpack the step_mem structure from
+  ark_mem.  If missing it returns ARK_MEM_NULL.
+  ---------------------------------------------------------------*/
+int lsrkStep_AccessStepMem(ARKodeMem ark_mem, const char* fname,
+                           ARKodeLSRKStepMem* step_mem)
+{
+  /* access ARKodeLSRKStepMem structure */
+  if (ark_mem->step_mem == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_LSRKSTEP_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *step_mem = (ARKodeLSRKStepMem)ark_mem->step_mem;
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_CheckNVector:
+
+  This routine checks if all required vector operations are
+  present.  If any of them is missing it returns SUNFALSE.
+  ---------------------------------------------------------------*/
+sunbooleantype lsrkStep_CheckNVector(N_Vector tmpl)
+{
+  if ((tmpl->ops->nvclone == NULL) || (tmpl->ops->nvdestroy == NULL) ||
+      (tmpl->ops->nvlinearsum == NULL) || (tmpl->ops->nvconst == NULL) ||
+      (tmpl->ops->nvscale == NULL) || (tmpl->ops->nvwrmsnorm == NULL))
+  {
+    return (SUNFALSE);
+  }
+  return (SUNTRUE);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_SetMethodProperties:
+
+  This routine attaches the step function of the selected method,
+  sets its method and embedding orders (also in the adaptivity
+  module), and checks the requested number of stages. The stages
+  of the STS methods are selected in each step.
+  ---------------------------------------------------------------*/
+int lsrkStep_SetMethodProperties(ARKodeMem ark_mem)
+{
+  ARKodeLSRKStepMem step_mem;
+  int n;
+
+  /* access ARKodeLSRKStepMem structure */
+  step_mem = (ARKodeLSRKStepMem)ark_mem->step_mem;
+
+  switch (step_mem->method)
+  {
+  case ARKODE_LSRK_SSP_S_2:
+    if (step_mem->req_stages == 0)
+    {
+      step_mem->req_stages = LSRK_SSP_S_2_STAGES;
+    }
+    if (step_mem->req_stages < 2)
+    {
+      arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      "SSP(s,2) methods require at least 2 stages");
+      return (ARK_ILL_INPUT);
+    }
+    ark_mem->step = lsrkStep_TakeStepSSPs2;
+    step_mem->q   = 2;
+    step_mem->p   = 1;
+    break;
+  case ARKODE_LSRK_SSP_S_3:
+    if (step_mem->req_stages == 0)
+    {
+      step_mem->req_stages = LSRK_SSP_S_3_STAGES;
+    }
+    n = (int)(SUNRsqrt((sunrealtype)step_mem->req_stages) + HALF);
+    if (step_mem->req_stages < 4 || n * n != step_mem->req_stages)
+    {
+      arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      "SSP(s,3) methods require a perfect square number of "
+                      "stages, s >= 4");
+      return (ARK_ILL_INPUT);
+    }
+    ark_mem->step = lsrkStep_TakeStepSSPs3;
+    step_mem->q   = 3;
+    step_mem->p   = 2;
+    break;
+  case ARKODE_LSRK_SSP_10_4:
+    if (step_mem->req_stages == 0)
+    {
+      step_mem->req_stages = LSRK_SSP_10_4_STAGES;
+    }
+    if (step_mem->req_stages != LSRK_SSP_10_4_STAGES)
+    {
+      arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      "The SSP(10,4) method requires 10 stages");
+      return (ARK_ILL_INPUT);
+    }
+    ark_mem->step = lsrkStep_TakeStepSSP104;
+    step_mem->q   = 4;
+    step_mem->p   = 3;
+    break;
+  case ARKODE_LSRK_RKC_2:
+    ark_mem->step = lsrkStep_TakeStepRKC;
+    step_mem->q   = 2;
+    step_mem->p   = 2;
+    break;
+  case ARKODE_LSRK_RKL_2:
+    ark_mem->step = lsrkStep_TakeStepRKL;
+    step_mem->q   = 2;
+    step_mem->p   = 2;
+    break;
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Unknown LSRK method type");
+    return (ARK_ILL_INPUT);
+  }
+
+  ark_mem->hadapt_mem->q = step_mem->q;
+  ark_mem->hadapt_mem->p = step_mem->p;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_IsSTSMethod:
+
+  Returns SUNTRUE if the method is a super-time-stepping method.
+  ---------------------------------------------------------------*/
+sunbooleantype lsrkStep_IsSTSMethod(ARKODE_LSRKMethodType method)
+{
+  return ((method == ARKODE_LSRK_RKC_2) || (method == ARKODE_LSRK_RKL_2));
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_ComputeDomEig:
+
+  This routine updates the dominant eigenvalue estimate at the
+  start of the step (tn, yn), either with the user-supplied
+  function or with the internal power iteration, and stores the
+  spectral radius estimate safety * |lambda|.
+  ---------------------------------------------------------------*/
+int lsrkStep_ComputeDomEig(ARKodeMem ark_mem, ARKodeLSRKStepMem step_mem)
+{
+  int retval;
+
+  if (step_mem->dom_eig_fn != NULL)
+  {
+    retval = step_mem->dom_eig_fn(ark_mem->tn, ark_mem->yn, ark_mem->fn,
+                                  &step_mem->lambdaR, &step_mem->lambdaI,
+                                  ark_mem->user_data, ark_mem->tempv1,
+                                  ark_mem->tempv2, ark_mem->tempv3);
+    if (retval != 0)
+    {
+      arkProcessError(ark_mem, ARK_DOMEIG_FAIL, __LINE__, __func__, __FILE__,
+                      "The dominant eigenvalue function failed");
+      return (ARK_DOMEIG_FAIL);
+    }
+  }
+  else
+  {
+    retval = lsrkStep_PowerIteration(ark_mem, step_mem);
+    if (retval != ARK_SUCCESS) { return (retval); }
+  }
+
+  step_mem->spectral_radius =
+    step_mem->dom_eig_safety * SUNRsqrt(step_mem->lambdaR * step_mem->lambdaR +
+                                        step_mem->lambdaI * step_mem->lambdaI);
+
+  step_mem->dom_eig_nst    = ark_mem->nst;
+  step_mem->dom_eig_update = SUNFALSE;
+  step_mem->dom_eig_num++;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_PowerIteration:
+
+  This routine estimates the magnitude of the dominant eigenvalue
+  of the Jacobian at (tn, yn) with a power iteration on difference
+  quotients of the RHS,
+
+    J v ~ (f(tn, yn + sigma v) - fn) / sigma,
+
+  with a unit vector v, which is allocated on the first call. As
+  in the RKC code, the iteration starts from fn on the first
+  update and from the previous eigenvector estimate afterwards,
+  and stops when the estimate changes by less than 1%. The
+  eigenvalue is assumed to be on the negative real axis. tempv1
+  and tempv2 are used as temporary storage.
+  ---------------------------------------------------------------*/
+int lsrkStep_PowerIteration(ARKodeMem ark_mem, ARKodeLSRKStepMem step_mem)
+{
+  int retval, k;
+  sunrealtype ynorm, vnorm, sigma, lambda, lambda_old;
+  N_Vector v;
+
+  if (ark_mem->yn->ops->nvdotprod == NULL)
+  {
+    arkProcessError(ark_mem, ARK_DOMEIG_FAIL, __LINE__, __func__, __FILE__,
+                    "The power iteration requires the N_VDotProd operation");
+    return (ARK_DOMEIG_FAIL);
+  }
+
+  /* allocate the eigenvector estimate on the first use */
+  if (step_mem->dom_eig_v == NULL)
+  {
+    if (!arkAllocVec(ark_mem, ark_mem->yn, &step_mem->dom_eig_v))
+    {
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_MEM_FAIL);
+      return (ARK_MEM_FAIL);
+    }
+  }
+  v = step_mem->dom_eig_v;
+
+  /* initial vector */
+  if (step_mem->dom_eig_num == 0) { N_VScale(ONE, ark_mem->fn, v); }
+  vnorm = SUNRsqrt(N_VDotProd(v, v));
+  if (vnorm == ZERO)
+  {
+    N_VConst(ONE, v);
+    vnorm = SUNRsqrt(N_VDotProd(v, v));
+  }
+
+  ynorm = SUNRsqrt(N_VDotProd(ark_mem->yn, ark_mem->yn));
+  sigma = SUNRsqrt(ark_mem->uround) * SUNMAX(ynorm, ONE);
+
+  lambda     = ZERO;
+  lambda_old = ZERO;
+  for (k = 0; k < LSRK_POWER_MAXITERS; k++)
+  {
+    /* perturbed state */
+    N_VLinearSum(ONE, ark_mem->yn, sigma / vnorm, v, ark_mem->tempv1);
+
+    retval = step_mem->fe(ark_mem->tn, ark_mem->tempv1, ark_mem->tempv2,
+                          ark_mem->user_data);
+    step_mem->nfe++;
+    step_mem->dom_eig_nfe++;
+    if (retval != 0)
+    {
+      arkProcessError(ark_mem, ARK_DOMEIG_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_RHSFUNC_FAILED, ark_mem->tn);
+      return (ARK_DOMEIG_FAIL);
+    }
+
+    /* v = J v / |v| */
+    N_VLinearSum(ONE / sigma, ark_mem->tempv2, -ONE / sigma, ark_mem->fn, v);
+    vnorm  = SUNRsqrt(N_VDotProd(v, v));
+    lambda = vnorm;
+
+    /* the Jacobian (numerically) annihilates v */
+    if (vnorm == ZERO)
+    {
+      N_VConst(ONE, v);
+      break;
+    }
+
+    if ((k > 0) && (SUNRabs(lambda - lambda_old) <= LSRK_POWER_TOL * lambda))
+    {
+      break;
+    }
+    lambda_old = lambda;
+  }
+
+  step_mem->lambdaR = -lambda;
+  step_mem->lambdaI = ZERO;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_STSStages:
+
+  This routine computes fn (if needed), updates the dominant
+  eigenvalue estimate every dom_eig_freq steps, and selects the
+  smallest number of stages of the STS method that is stable for
+  the current step size,
+
+    RKC: s = ceil(sqrt(1 + 1.54 h rho)),
+    RKL: s = ceil((sqrt(9 + 16 h rho) - 1) / 2),
+
+  with s >= 2. If this exceeds the maximum number of stages with
+  an adaptive step, eta is set to the largest stable step size
+  ratio and RETRY_STEP is returned; with a fixed step size this
+  is an error.
+  ---------------------------------------------------------------*/
+int lsrkStep_STSStages(ARKodeMem ark_mem, ARKodeLSRKStepMem step_mem)
+{
+  int retval, ss;
+  sunrealtype hrho, smax, hmax;
+
+  /* The methods are not FSAL, so the first stage RHS is the full RHS at the
+     start of the step (possibly already computed by ARKODE) */
+  if (!(ark_mem->fn_is_current))
+  {
+    retval = ark_mem->step_fullrhs(ark_mem, ark_mem->tn, ark_mem->yn,
+                                   ark_mem->fn, ARK_FULLRHS_START);
+    if (retval) { return ARK_RHSFUNC_FAIL; }
+    ark_mem->fn_is_current = SUNTRUE;
+  }
+
+  /* update the dominant eigenvalue estimate (if needed) */
+  if (step_mem->dom_eig_update ||
+      (ark_mem->nst - step_mem->dom_eig_nst >= step_mem->dom_eig_freq))
+  {
+    retval = lsrkStep_ComputeDomEig(ark_mem, step_mem);
+    if (retval != ARK_SUCCESS) { return (retval); }
+  }
+
+  hrho = SUNRabs(ark_mem->h) * step_mem->spectral_radius;
+  smax = (sunrealtype)step_mem->stage_max_limit;
+
+  if (step_mem->method == ARKODE_LSRK_RKC_2)
+  {
+    ss   = (int)SUNRceil(SUNRsqrt(ONE + SUN_RCONST(1.54) * hrho));
+    hmax = (smax * smax - ONE) / SUN_RCONST(1.54);
+  }
+  else
+  {
+    ss = (int)SUNRceil((SUNRsqrt(SUN_RCONST(9.0) + SUN_RCONST(16.0) * hrho) -
+                        ONE) /
+                       TWO);
+    hmax = (smax * smax + smax - TWO) / FOUR;
+  }
+  ss = SUNMAX(ss, 2);
+
+  if (ss > step_mem->stage_max_limit)
+  {
+    if (ark_mem->fixedstep)
+    {
+      arkProcessError(ark_mem, ARK_MAX_STAGE_LIMIT_FAIL, __LINE__, __func__,
+                      __FILE__,
+                      "The fixed step size requires %i stages, more than the "
+                      "maximum of %i",
+                      ss, step_mem->stage_max_limit);
+      return (ARK_MAX_STAGE_LIMIT_FAIL);
+    }
+
+    /* retry slightly inside the stability limit of the maximum stages */
+    hmax = SUN_RCONST(0.99) * hmax / step_mem->spectral_radius;
+    ark_mem->eta = hmax / SUNRabs(ark_mem->h);
+    ark_mem->hadapt_mem->nst_exp++;
+    return (RETRY_STEP);
+  }
+
+  step_mem->req_stages = ss;
+  step_mem->stage_max  = SUNMAX(step_mem->stage_max, ss);
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_STSErrorEstimate:
+
+  This routine computes the local error estimate of the STS
+  methods (from the RKC code),
+
+    yerr = 4/5 (yn - ycur) + 2/5 h (fn + f(tn + h, ycur)),
+
+  in tempv1, using tempv2 for the RHS at the new time, and
+  returns its weighted norm in dsmPtr.
+  ---------------------------------------------------------------*/
+int lsrkStep_STSErrorEstimate(ARKodeMem ark_mem, ARKodeLSRKStepMem step_mem,
+                              sunrealtype* dsmPtr)
+{
+  int retval;
+
+  ark_mem->tcur = ark_mem->tn + ark_mem->h;
+
+  retval = step_mem->fe(ark_mem->tcur, ark_mem->ycur, ark_mem->tempv2,
+                        ark_mem->user_data);
+  step_mem->nfe++;
+  if (retval < 0) { return (ARK_RHSFUNC_FAIL); }
+  if (retval > 0) { return (ARK_UNREC_RHSFUNC_ERR); }
+
+  step_mem->cvals[0] = SUN_RCONST(0.8);
+  step_mem->Xvecs[0] = ark_mem->yn;
+  step_mem->cvals[1] = -SUN_RCONST(0.8);
+  step_mem->Xvecs[1] = ark_mem->ycur;
+  step_mem->cvals[2] = SUN_RCONST(0.4) * ark_mem->h;
+  step_mem->Xvecs[2] = ark_mem->fn;
+  step_mem->cvals[3] = SUN_RCONST(0.4) * ark_mem->h;
+  step_mem->Xvecs[3] = ark_mem->tempv2;
+
+  retval = N_VLinearCombination(4, step_mem->cvals, step_mem->Xvecs,
+                                ark_mem->tempv1);
+  if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+  *dsmPtr = N_VWrmsNorm(ark_mem->tempv1, ark_mem->ewt);
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_StageRHS:
+
+  This routine applies the user-supplied stage postprocessing
+  function (if supplied) to the stage solution y, and then
+  evaluates the RHS at (tcur, y), storing the result in f.
+  ---------------------------------------------------------------*/
+int lsrkStep_StageRHS(ARKodeMem ark_mem, ARKodeLSRKStepMem step_mem, N_Vector y,
+                      N_Vector f)
+{
+  int retval;
+
+  /* apply user-supplied stage postprocessing function (if supplied) */
+  if (ark_mem->ProcessStage != NULL)
+  {
+    retval = ark_mem->ProcessStage(ark_mem->tcur, y, ark_mem->user_data);
+    if (retval != 0) { return (ARK_POSTPROCESS_STAGE_FAIL); }
+  }
+
+  /* compute updated RHS */
+  retval = step_mem->fe(ark_mem->tcur, y, f, ark_mem->user_data);
+  step_mem->nfe++;
+  if (retval < 0) { return (ARK_RHSFUNC_FAIL); }
+  if (retval > 0) { return (ARK_UNREC_RHSFUNC_ERR); }
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
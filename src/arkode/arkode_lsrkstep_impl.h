@@ -0,0 +1,161 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * Implementation header file for ARKODE's low-storage Runge-Kutta
+ * (LSRK) time stepper module.
+ *--------------------------------------------------------------*/
+
+#ifndef _ARKODE_LSRKSTEP_IMPL_H
+#define _ARKODE_LSRKSTEP_IMPL_H
+
+#include <arkode/arkode_lsrkstep.h>
+
+#include "arkode_impl.h"
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*===============================================================
+  LSRK time step module constants
+  ===============================================================*/
+
+/* default method and stage counts */
+#define LSRK_SSP_DEFAULT_METHOD ARKODE_LSRK_SSP_S_2
+#define LSRK_SSP_S_2_STAGES     10
+#define LSRK_SSP_S_3_STAGES     9
+#define LSRK_SSP_10_4_STAGES    10
+
+/* super-time-stepping defaults: method, maximum number of stages, number of
+   steps between dominant eigenvalue updates, eigenvalue safety factor, and
+   the power iteration limits (following the RKC code of Sommeijer et al.) */
+#define LSRK_STS_DEFAULT_METHOD ARKODE_LSRK_RKC_2
+#define LSRK_STS_MAX_STAGES     200
+#define LSRK_DOM_EIG_FREQ       25
+#define LSRK_DOM_EIG_SAFETY     SUN_RCONST(1.01)
+#define LSRK_POWER_MAXITERS     50
+#define LSRK_POWER_TOL          SUN_RCONST(0.01)
+
+/* RKC damping parameter */
+#define LSRK_RKC_EPS (SUN_RCONST(2.0) / SUN_RCONST(13.0))
+
+/*===============================================================
+  LSRK time step module data structure
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  Types : struct ARKodeLSRKStepMemRec, ARKodeLSRKStepMem
+  ---------------------------------------------------------------
+  The type ARKodeLSRKStepMem is type pointer to struct
+  ARKodeLSRKStepMemRec.  This structure contains fields to
+  perform a low-storage explicit Runge-Kutta time step. The
+  methods only use the ARKODE state and temporary vectors, so
+  no stage vectors are stored here. The super-time-stepping
+  methods additionally store the dominant eigenvalue estimate and,
+  when it is computed with the internal power iteration, the
+  eigenvector estimate used to warm start the next update.
+  ---------------------------------------------------------------*/
+typedef struct ARKodeLSRKStepMemRec
+{
+  /* LSRK problem specification */
+  ARKRhsFn fe; /* y' = fe(t,y)               */
+
+  /* LSRK method parameters */
+  ARKODE_LSRKMethodType method; /* method type                */
+  int q;                        /* method order               */
+  int p;                        /* embedding order            */
+  int req_stages;               /* number of stages per step  */
+
+  /* Super-time-stepping data */
+  ARKDomEigFn dom_eig_fn;        /* dominant eigenvalue fn     */
+  sunrealtype lambdaR;           /* dominant eigenvalue (real) */
+  sunrealtype lambdaI;           /* dominant eigenvalue (imag) */
+  sunrealtype spectral_radius;   /* safety * |lambda|          */
+  sunrealtype dom_eig_safety;    /* eigenvalue safety factor   */
+  long int dom_eig_freq;         /* steps between updates      */
+  long int dom_eig_nst;          /* step of the last update    */
+  sunbooleantype dom_eig_update; /* update before next step    */
+  int stage_max_limit;           /* maximum allowed stages     */
+  int stage_max;                 /* maximum stages used        */
+  N_Vector dom_eig_v;            /* power iteration vector     */
+
+  /* Counters */
+  long int nfe;         /* num fe calls               */
+  long int dom_eig_nfe; /* num fe calls for dom eig   */
+  long int dom_eig_num; /* num dom eig updates        */
+
+  /* Reusable arrays for fused vector operations */
+  sunrealtype cvals[5];
+  N_Vector Xvecs[5];
+
+}* ARKodeLSRKStepMem;
+
+/*===============================================================
+  LSRK time step module private function prototypes
+  ===============================================================*/
+
+/* Interface routines supplied to ARKODE */
+int lsrkStep_Init(ARKodeMem ark_mem, int init_type);
+int lsrkStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
+                     int mode);
+int lsrkStep_TakeStepSSPs2(ARKodeMem ark_mem, sunrealtype* dsmPtr,
+                           int* nflagPtr);
+int lsrkStep_TakeStepSSPs3(ARKodeMem ark_mem, sunrealtype* dsmPtr,
+                           int* nflagPtr);
+int lsrkStep_TakeStepSSP104(ARKodeMem ark_mem, sunrealtype* dsmPtr,
+                            int* nflagPtr);
+int lsrkStep_TakeStepRKC(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr);
+int lsrkStep_TakeStepRKL(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr);
+int lsrkStep_SetDefaults(ARKodeMem ark_mem);
+int lsrkStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile,
+                           SUNOutputFormat fmt);
+int lsrkStep_WriteParameters(ARKodeMem ark_mem, FILE* fp);
+int lsrkStep_Resize(ARKodeMem ark_mem, N_Vector y0, sunrealtype hscale,
+                    sunrealtype t0, ARKVecResizeFn resize, void* resize_data);
+void lsrkStep_Free(ARKodeMem ark_mem);
+void lsrkStep_PrintMem(ARKodeMem ark_mem, FILE* outfile);
+int lsrkStep_GetEstLocalErrors(ARKodeMem ark_mem, N_Vector ele);
+
+/* Internal utility routines */
+void* lsrkStep_Create_Commons(ARKRhsFn rhs, sunrealtype t0, N_Vector y0,
+                              SUNContext sunctx, ARKODE_LSRKMethodType method);
+int lsrkStep_ReInit_Commons(void* arkode_mem, ARKRhsFn rhs, sunrealtype t0,
+                            N_Vector y0);
+sunbooleantype lsrkStep_IsSTSMethod(ARKODE_LSRKMethodType method);
+int lsrkStep_AccessARKODEStepMem(void* arkode_mem, const char* fname,
+                                 ARKodeMem* ark_mem, ARKodeLSRKStepMem* step_mem);
+int lsrkStep_AccessStepMem(ARKodeMem ark_mem, const char* fname,
+                           ARKodeLSRKStepMem* step_mem);
+sunbooleantype lsrkStep_CheckNVector(N_Vector tmpl);
+int lsrkStep_SetMethodProperties(ARKodeMem ark_mem);
+int lsrkStep_StageRHS(ARKodeMem ark_mem, ARKodeLSRKStepMem step_mem,
+                      N_Vector y, N_Vector f);
+int lsrkStep_ComputeDomEig(ARKodeMem ark_mem, ARKodeLSRKStepMem step_mem);
+int lsrkStep_PowerIteration(ARKodeMem ark_mem, ARKodeLSRKStepMem step_mem);
+int lsrkStep_STSStages(ARKodeMem ark_mem, ARKodeLSRKStepMem step_mem);
+int lsrkStep_STSErrorEstimate(ARKodeMem ark_mem, ARKodeLSRKStepMem step_mem,
+                              sunrealtype* dsmPtr);
+
+/*===============================================================
+  Reusable LSRKStep Error Messages
+  ===============================================================*/
+
+/* Initialization and I/O error messages */
+#define MSG_LSRKSTEP_NO_MEM "Time step module memory is NULL."
+#define MSG_LSRKSTEP_NOT_SSP "The current method is not an SSP method."
+#define MSG_LSRKSTEP_NOT_STS \
+  "The current method is not a super-time-stepping method."
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,517 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * This is the implementation file for the optional input and
+ * output functions for the ARKODE LSRKStep time stepper module.
+ *--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/sundials_math.h>
+#include <sundials/sundials_types.h>
+
+#include "arkode_lsrkstep_impl.h"
+
+/*===============================================================
+  Exported optional input functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  LSRKStepSetSSPMethod:
+
+  Specifies the SSP method. The number of stages is reset to the
+  default of the new method.
+  ---------------------------------------------------------------*/
+int LSRKStepSetSSPMethod(void* arkode_mem, ARKODE_LSRKMethodType method)
+{
+  ARKodeMem ark_mem;
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeLSRKStepMem structures */
+  retval = lsrkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  switch (method)
+  {
+  case ARKODE_LSRK_SSP_S_2:
+  case ARKODE_LSRK_SSP_S_3:
+  case ARKODE_LSRK_SSP_10_4: break;
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid SSP method type");
+    return (ARK_ILL_INPUT);
+  }
+
+  step_mem->method     = method;
+  step_mem->req_stages = 0;
+
+  return (lsrkStep_SetMethodProperties(ark_mem));
+}
+
+/*---------------------------------------------------------------
+  LSRKStepSetSSPMethodByName:
+
+  Specifies the SSP method by its enumeration name.
+  ---------------------------------------------------------------*/
+int LSRKStepSetSSPMethodByName(void* arkode_mem, const char* emethod)
+{
+  if (emethod == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Method name is NULL");
+    return (ARK_ILL_INPUT);
+  }
+
+  if (strcmp(emethod, "ARKODE_LSRK_SSP_S_2") == 0)
+  {
+    return (LSRKStepSetSSPMethod(arkode_mem, ARKODE_LSRK_SSP_S_2));
+  }
+  if (strcmp(emethod, "ARKODE_LSRK_SSP_S_3") == 0)
+  {
+    return (LSRKStepSetSSPMethod(arkode_mem, ARKODE_LSRK_SSP_S_3));
+  }
+  if (strcmp(emethod, "ARKODE_LSRK_SSP_10_4") == 0)
+  {
+    return (LSRKStepSetSSPMethod(arkode_mem, ARKODE_LSRK_SSP_10_4));
+  }
+
+  arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                  "Unknown method name");
+  return (ARK_ILL_INPUT);
+}
+
+/*---------------------------------------------------------------
+  LSRKStepSetNumSSPStages:
+
+  Specifies the number of stages of the SSP method. A value <= 0
+  restores the default of the current method.
+  ---------------------------------------------------------------*/
+int LSRKStepSetNumSSPStages(void* arkode_mem, int num_of_stages)
+{
+  ARKodeMem ark_mem;
+  ARKodeLSRKStepMem step_mem;
+  int retval, old_stages;
+
+  /* access ARKodeMem and ARKodeLSRKStepMem structures */
+  retval = lsrkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (lsrkStep_IsSTSMethod(step_mem->method))
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_LSRKSTEP_NOT_SSP);
+    return (ARK_ILL_INPUT);
+  }
+
+  old_stages = step_mem->req_stages;
+
+  if (num_of_stages <= 0) { step_mem->req_stages = 0; }
+  else { step_mem->req_stages = num_of_stages; }
+
+  /* check the stage count against the current method */
+  retval = lsrkStep_SetMethodProperties(ark_mem);
+  if (retval != ARK_SUCCESS) { step_mem->req_stages = old_stages; }
+
+  return (retval);
+}
+
+/*---------------------------------------------------------------
+  LSRKStepSetSTSMethod:
+
+  Specifies the super-time-stepping method.
+  ---------------------------------------------------------------*/
+int LSRKStepSetSTSMethod(void* arkode_mem, ARKODE_LSRKMethodType method)
+{
+  ARKodeMem ark_mem;
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeLSRKStepMem structures */
+  retval = lsrkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (!lsrkStep_IsSTSMethod(method))
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid STS method type");
+    return (ARK_ILL_INPUT);
+  }
+
+  step_mem->method     = method;
+  step_mem->req_stages = 0;
+
+  return (lsrkStep_SetMethodProperties(ark_mem));
+}
+
+/*---------------------------------------------------------------
+  LSRKStepSetSTSMethodByName:
+
+  Specifies the super-time-stepping method by its enumeration
+  name.
+  ---------------------------------------------------------------*/
+int LSRKStepSetSTSMethodByName(void* arkode_mem, const char* emethod)
+{
+  if (emethod == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Method name is NULL");
+    return (ARK_ILL_INPUT);
+  }
+
+  if (strcmp(emethod, "ARKODE_LSRK_RKC_2") == 0)
+  {
+    return (LSRKStepSetSTSMethod(arkode_mem, ARKODE_LSRK_RKC_2));
+  }
+  if (strcmp(emethod, "ARKODE_LSRK_RKL_2") == 0)
+  {
+    return (LSRKStepSetSTSMethod(arkode_mem, ARKODE_LSRK_RKL_2));
+  }
+
+  arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                  "Unknown method name");
+  return (ARK_ILL_INPUT);
+}
+
+/*---------------------------------------------------------------
+  LSRKStepSetDomEigFn:
+
+  Specifies the dominant eigenvalue function of the STS methods.
+  A NULL input selects the internal power iteration.
+  ---------------------------------------------------------------*/
+int LSRKStepSetDomEigFn(void* arkode_mem, ARKDomEigFn dom_eig)
+{
+  ARKodeMem ark_mem;
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeLSRKStepMem structures */
+  retval = lsrkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  step_mem->dom_eig_fn     = dom_eig;
+  step_mem->dom_eig_update = SUNTRUE;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  LSRKStepSetDomEigFrequency:
+
+  Specifies the number of steps between dominant eigenvalue
+  updates. A value <= 0 restores the default.
+  ---------------------------------------------------------------*/
+int LSRKStepSetDomEigFrequency(void* arkode_mem, long int nsteps)
+{
+  ARKodeMem ark_mem;
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeLSRKStepMem structures */
+  retval = lsrkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (nsteps <= 0) { step_mem->dom_eig_freq = LSRK_DOM_EIG_FREQ; }
+  else { step_mem->dom_eig_freq = nsteps; }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  LSRKStepSetMaxNumStages:
+
+  Specifies the maximum number of stages of the STS methods. A
+  value <= 0 restores the default.
+  ---------------------------------------------------------------*/
+int LSRKStepSetMaxNumStages(void* arkode_mem, int stage_max_limit)
+{
+  ARKodeMem ark_mem;
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeLSRKStepMem structures */
+  retval = lsrkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (stage_max_limit <= 0) { step_mem->stage_max_limit = LSRK_STS_MAX_STAGES; }
+  else if (stage_max_limit < 2)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The maximum number of stages must be at least 2");
+    return (ARK_ILL_INPUT);
+  }
+  else { step_mem->stage_max_limit = stage_max_limit; }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  LSRKStepSetDomEigSafetyFactor:
+
+  Specifies the safety factor applied to the magnitude of the
+  dominant eigenvalue. A value <= 0 restores the default.
+  ---------------------------------------------------------------*/
+int LSRKStepSetDomEigSafetyFactor(void* arkode_mem, sunrealtype dom_eig_safety)
+{
+  ARKodeMem ark_mem;
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeLSRKStepMem structures */
+  retval = lsrkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (dom_eig_safety <= ZERO)
+  {
+    step_mem->dom_eig_safety = LSRK_DOM_EIG_SAFETY;
+  }
+  else if (dom_eig_safety < ONE)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The safety factor must be at least 1");
+    return (ARK_ILL_INPUT);
+  }
+  else { step_mem->dom_eig_safety = dom_eig_safety; }
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Exported optional output functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  LSRKStepGetNumRhsEvals:
+
+  Returns the current number of calls to f
+  ---------------------------------------------------------------*/
+int LSRKStepGetNumRhsEvals(void* arkode_mem, long int* fevals)
+{
+  ARKodeMem ark_mem;
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeLSRKStepMem structures */
+  retval = lsrkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get values from step_mem */
+  *fevals = step_mem->nfe;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  LSRKStepGetNumDomEigUpdates:
+
+  Returns the number of dominant eigenvalue updates
+  ---------------------------------------------------------------*/
+int LSRKStepGetNumDomEigUpdates(void* arkode_mem, long int* dom_eig_num_evals)
+{
+  ARKodeMem ark_mem;
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeLSRKStepMem structures */
+  retval = lsrkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get values from step_mem */
+  *dom_eig_num_evals = step_mem->dom_eig_num;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  LSRKStepGetMaxNumStages:
+
+  Returns the maximum number of stages used by the STS methods
+  ---------------------------------------------------------------*/
+int LSRKStepGetMaxNumStages(void* arkode_mem, int* stage_max)
+{
+  ARKodeMem ark_mem;
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeLSRKStepMem structures */
+  retval = lsrkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get values from step_mem */
+  *stage_max = step_mem->stage_max;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Private functions attached to ARKODE
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  lsrkStep_SetDefaults:
+
+  Resets all LSRKStep optional inputs to their default values.
+  Does not change problem-defining function pointers or
+  user_data pointer.
+  ---------------------------------------------------------------*/
+int lsrkStep_SetDefaults(ARKodeMem ark_mem)
+{
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeLSRKStepMem structure */
+  retval = lsrkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Set default method of the current family and number of stages */
+  if (lsrkStep_IsSTSMethod(step_mem->method))
+  {
+    step_mem->method = LSRK_STS_DEFAULT_METHOD;
+  }
+  else { step_mem->method = LSRK_SSP_DEFAULT_METHOD; }
+  step_mem->req_stages = 0;
+
+  /* Set default super-time-stepping parameters */
+  step_mem->stage_max_limit = LSRK_STS_MAX_STAGES;
+  step_mem->dom_eig_freq    = LSRK_DOM_EIG_FREQ;
+  step_mem->dom_eig_safety  = LSRK_DOM_EIG_SAFETY;
+  step_mem->dom_eig_update  = SUNTRUE;
+
+  return (lsrkStep_SetMethodProperties(ark_mem));
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_GetEstLocalErrors: Returns the current local truncation
+  error estimate vector
+  ---------------------------------------------------------------*/
+int lsrkStep_GetEstLocalErrors(ARKodeMem ark_mem, N_Vector ele)
+{
+  int retval;
+  ARKodeLSRKStepMem step_mem;
+  retval = lsrkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* return an error if local truncation error is not computed */
+  if (ark_mem->fixedstep) { return (ARK_STEPPER_UNSUPPORTED); }
+
+  /* otherwise, copy local truncation error vector to output */
+  N_VScale(ONE, ark_mem->tempv1, ele);
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_PrintAllStats:
+
+  Prints integrator statistics
+  ---------------------------------------------------------------*/
+int lsrkStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile, SUNOutputFormat fmt)
+{
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeLSRKStepMem structure */
+  retval = lsrkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  switch (fmt)
+  {
+  case SUN_OUTPUTFORMAT_TABLE:
+    fprintf(outfile, "RHS fn evals                 = %ld\n", step_mem->nfe);
+    if (lsrkStep_IsSTSMethod(step_mem->method))
+    {
+      fprintf(outfile, "RHS fn evals for dom eig     = %ld\n",
+              step_mem->dom_eig_nfe);
+      fprintf(outfile, "Number of dom eig updates    = %ld\n",
+              step_mem->dom_eig_num);
+      fprintf(outfile, "Max. num. of stages used     = %i\n",
+              step_mem->stage_max);
+      fprintf(outfile, "Max. num. of stages allowed  = %i\n",
+              step_mem->stage_max_limit);
+    }
+    else
+    {
+      fprintf(outfile, "Number of stages used        = %i\n",
+              step_mem->req_stages);
+    }
+    break;
+  case SUN_OUTPUTFORMAT_CSV:
+    fprintf(outfile, ",RHS fn evals,%ld", step_mem->nfe);
+    if (lsrkStep_IsSTSMethod(step_mem->method))
+    {
+      fprintf(outfile, ",RHS fn evals for dom eig,%ld", step_mem->dom_eig_nfe);
+      fprintf(outfile, ",Number of dom eig updates,%ld", step_mem->dom_eig_num);
+      fprintf(outfile, ",Max. num. of stages used,%i", step_mem->stage_max);
+      fprintf(outfile, ",Max. num. of stages allowed,%i",
+              step_mem->stage_max_limit);
+    }
+    else
+    {
+      fprintf(outfile, ",Number of stages used,%i", step_mem->req_stages);
+    }
+    fprintf(outfile, "\n");
+    break;
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid formatting option.");
+    return (ARK_ILL_INPUT);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  lsrkStep_WriteParameters:
+
+  Outputs all solver parameters to the provided file pointer.
+  ---------------------------------------------------------------*/
+int lsrkStep_WriteParameters(ARKodeMem ark_mem, FILE* fp)
+{
+  ARKodeLSRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeLSRKStepMem structure */
+  retval = lsrkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* print integrator parameters to file */
+  fprintf(fp, "LSRKStep time step module parameters:\n");
+  fprintf(fp, "  Method type %i\n", (int)step_mem->method);
+  fprintf(fp, "  Method order %i\n", step_mem->q);
+  if (lsrkStep_IsSTSMethod(step_mem->method))
+  {
+    fprintf(fp, "  Maximum number of stages %i\n", step_mem->stage_max_limit);
+    fprintf(fp, "  Dominant eigenvalue update frequency %li\n",
+            step_mem->dom_eig_freq);
+    fprintf(fp, "  Dominant eigenvalue safety factor %" RSYM "\n",
+            step_mem->dom_eig_safety);
+    fprintf(fp, "  User dominant eigenvalue function %s\n",
+            (step_mem->dom_eig_fn != NULL) ? "yes" : "no");
+  }
+  else { fprintf(fp, "  Number of stages %i\n", step_mem->req_stages); }
+  fprintf(fp, "\n");
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
@@ -114,11 +114,11 @@ MRIStepCoupling MRIStepCoupling_Alloc(int nmat, int stages,
       return (NULL);
     }
 
-    /* allocate rows of each matrix in W */
+    /* allocate rows of each matrix in W (including the embedding row) */
     for (i = 0; i < nmat; i++)
     {
       MRIC->W[i] = NULL;
-      MRIC->W[i] = (sunrealtype**)calloc(stages, sizeof(sunrealtype*));
+      MRIC->W[i] = (sunrealtype**)calloc(stages + 1, sizeof(sunrealtype*));
       if (!(MRIC->W[i]))
       {
         MRIStepCoupling_Free(MRIC);
@@ -129,7 +129,7 @@ MRIStepCoupling MRIStepCoupling_Alloc(int nmat, int stages,
     /* allocate columns of each matrix in W */
     for (i = 0; i < nmat; i++)
     {
-      for (j = 0; j < stages; j++)
+      for (j = 0; j <= stages; j++)
       {
         MRIC->W[i][j] = NULL;
         MRIC->W[i][j] = (sunrealtype*)calloc(stages, sizeof(sunrealtype));
@@ -152,11 +152,11 @@ MRIStepCoupling MRIStepCoupling_Alloc(int nmat, int stages,
       return (NULL);
     }
 
-    /* allocate rows of each matrix in G */
+    /* allocate rows of each matrix in G (including the embedding row) */
     for (i = 0; i < nmat; i++)
     {
       MRIC->G[i] = NULL;
-      MRIC->G[i] = (sunrealtype**)calloc(stages, sizeof(sunrealtype*));
+      MRIC->G[i] = (sunrealtype**)calloc(stages + 1, sizeof(sunrealtype*));
       if (!(MRIC->G[i]))
       {
         MRIStepCoupling_Free(MRIC);
@@ -167,7 +167,7 @@ MRIStepCoupling MRIStepCoupling_Alloc(int nmat, int stages,
     /* allocate columns of each matrix in G */
     for (i = 0; i < nmat; i++)
     {
-      for (j = 0; j < stages; j++)
+      for (j = 0; j <= stages; j++)
       {
         MRIC->G[i][j] = NULL;
         MRIC->G[i][j] = (sunrealtype*)calloc(stages, sizeof(sunrealtype));
@@ -190,13 +190,16 @@ MRIStepCoupling MRIStepCoupling_Create(int nmat, int stages, int q, int p,
                                        sunrealtype* W, sunrealtype* G,
                                        sunrealtype* c)
 {
-  int i, j, k;
+  int i, j, k, rows;
   MRISTEP_METHOD_TYPE type;
   MRIStepCoupling MRIC = NULL;
 
   /* Check for legal inputs */
   if (nmat < 1 || stages < 1 || !c) { return (NULL); }
 
+  /* Methods with an embedding provide an additional row of coefficients */
+  rows = (p > 0) ? stages + 1 : stages;
+
   /* Check for method coefficients and set method type */
   if (W && G) { type = MRISTEP_IMEX; }
   else if (W && !G) { type = MRISTEP_EXPLICIT; }
@@ -218,17 +221,17 @@ MRIStepCoupling MRIStepCoupling_Create(int nmat, int stages, int q, int p,
   /* Abscissae */
   for (i = 0; i < stages; i++) { MRIC->c[i] = c[i]; }
 
-  /* Coupling coefficients stored as 1D arrays of length nmat * stages * stages,
-     with each stages * stages matrix stored in C (row-major) order */
+  /* Coupling coefficients stored as 1D arrays of length nmat * rows * stages,
+     with each rows * stages matrix stored in C (row-major) order */
   if (type == MRISTEP_EXPLICIT || type == MRISTEP_IMEX)
   {
     for (k = 0; k < nmat; k++)
     {
-      for (i = 0; i < stages; i++)
+      for (i = 0; i < rows; i++)
       {
         for (j = 0; j < stages; j++)
         {
-          MRIC->W[k][i][j] = W[stages * (stages * k + i) + j];
+          MRIC->W[k][i][j] = W[stages * (rows * k + i) + j];
         }
       }
     }
@@ -237,11 +240,11 @@ MRIStepCoupling MRIStepCoupling_Create(int nmat, int stages, int q, int p,
   {
     for (k = 0; k < nmat; k++)
     {
-      for (i = 0; i < stages; i++)
+      for (i = 0; i < rows; i++)
       {
         for (j = 0; j < stages; j++)
         {
-          MRIC->G[k][i][j] = G[stages * (stages * k + i) + j];
+          MRIC->G[k][i][j] = G[stages * (rows * k + i) + j];
         }
       }
     }
@@ -252,7 +255,8 @@ MRIStepCoupling MRIStepCoupling_Create(int nmat, int stages, int q, int p,
 
 /*---------------------------------------------------------------
   Construct the MRI coupling matrix for an MIS method based on
-  a given 'slow' Butcher table.
+  a given 'slow' Butcher table. If p > 0 the embedding row is
+  constructed from the embedding coefficients of the table.
   ---------------------------------------------------------------*/
 MRIStepCoupling MRIStepCoupling_MIStoMRI(ARKodeButcherTable B, int q, int p)
 {
@@ -268,6 +272,9 @@ MRIStepCoupling MRIStepCoupling_MIStoMRI(ARKodeButcherTable B, int q, int p)
   /* Check that input table is non-NULL */
   if (!B) { return (NULL); }
 
+  /* Check that an embedding is available if requested */
+  if (p > 0 && !(B->d)) { return (NULL); }
+
   /* -----------------------------------
    * Check that the input table is valid
    * ----------------------------------- */
@@ -310,6 +317,13 @@ MRIStepCoupling MRIStepCoupling_MIStoMRI(ARKodeButcherTable B, int q, int p)
   }
   stages = (padding) ? B->stages + 1 : B->stages;
 
+  /* Without padding the embedding must not use the last stage, since it
+     replaces the last stage of the method */
+  if (p > 0 && !padding && SUNRabs(B->d[B->stages - 1]) > tol)
+  {
+    return (NULL);
+  }
+
   /* -------------------------
    * determine the method type
    * ------------------------- */
@@ -369,6 +383,17 @@ MRIStepCoupling MRIStepCoupling_MIStoMRI(ARKodeButcherTable B, int q, int p)
     }
   }
 
+  /* Embedding row = d(:) - A(end,:) with padding, otherwise the embedding
+     starts from the second to last stage, d(:) - A(end-1,:) */
+  if (p > 0)
+  {
+    for (j = 0; j < B->stages; j++)
+    {
+      C[0][stages][j] = (padding) ? B->d[j] - B->A[B->stages - 1][j]
+                                  : B->d[j] - B->A[B->stages - 2][j];
+    }
+  }
+
   return (MRIC);
 }
 
@@ -413,7 +438,7 @@ MRIStepCoupling MRIStepCoupling_Copy(MRIStepCoupling MRIC)
   {
     for (k = 0; k < nmat; k++)
     {
-      for (i = 0; i < stages; i++)
+      for (i = 0; i <= stages; i++)
       {
         for (j = 0; j < stages; j++)
         {
@@ -428,7 +453,7 @@ MRIStepCoupling MRIStepCoupling_Copy(MRIStepCoupling MRIC)
   {
     for (k = 0; k < nmat; k++)
     {
-      for (i = 0; i < stages; i++)
+      for (i = 0; i <= stages; i++)
       {
         for (j = 0; j < stages; j++)
         {
@@ -455,8 +480,8 @@ void MRIStepCoupling_Space(MRIStepCoupling MRIC, sunindextype* liw,
   /* fill outputs based on MRIC */
   *liw = 4;
   if (MRIC->c) { *lrw += MRIC->stages; }
-  if (MRIC->W) { *lrw += MRIC->nmat * MRIC->stages * MRIC->stages; }
-  if (MRIC->G) { *lrw += MRIC->nmat * MRIC->stages * MRIC->stages; }
+  if (MRIC->W) { *lrw += MRIC->nmat * (MRIC->stages + 1) * MRIC->stages; }
+  if (MRIC->G) { *lrw += MRIC->nmat * (MRIC->stages + 1) * MRIC->stages; }
 }
 
 /*---------------------------------------------------------------
@@ -478,7 +503,7 @@ void MRIStepCoupling_Free(MRIStepCoupling MRIC)
       {
         if (MRIC->W[k])
         {
-          for (i = 0; i < MRIC->stages; i++)
+          for (i = 0; i <= MRIC->stages; i++)
           {
             if (MRIC->W[k][i])
             {
@@ -499,7 +524,7 @@ void MRIStepCoupling_Free(MRIStepCoupling MRIC)
       {
         if (MRIC->G[k])
         {
-          for (i = 0; i < MRIC->stages; i++)
+          for (i = 0; i <= MRIC->stages; i++)
           {
             if (MRIC->G[k][i])
             {
@@ -535,7 +560,7 @@ void MRIStepCoupling_Write(MRIStepCoupling MRIC, FILE* outfile)
     for (i = 0; i < MRIC->nmat; i++)
     {
       if (!(MRIC->W[i])) { return; }
-      for (j = 0; j < MRIC->stages; j++)
+      for (j = 0; j <= MRIC->stages; j++)
       {
         if (!(MRIC->W[i][j])) { return; }
       }
@@ -547,7 +572,7 @@ void MRIStepCoupling_Write(MRIStepCoupling MRIC, FILE* outfile)
     for (i = 0; i < MRIC->nmat; i++)
     {
       if (!(MRIC->G[i])) { return; }
-      for (j = 0; j < MRIC->stages; j++)
+      for (j = 0; j <= MRIC->stages; j++)
       {
         if (!(MRIC->G[i][j])) { return; }
       }
@@ -579,6 +604,15 @@ void MRIStepCoupling_Write(MRIStepCoupling MRIC, FILE* outfile)
         }
         fprintf(outfile, "\n");
       }
+      if (MRIC->p > 0)
+      {
+        fprintf(outfile, "  embedding:\n      ");
+        for (j = 0; j < MRIC->stages; j++)
+        {
+          fprintf(outfile, "%" RSYMW "  ", MRIC->W[k][MRIC->stages][j]);
+        }
+        fprintf(outfile, "\n");
+      }
       fprintf(outfile, "\n");
     }
   }
@@ -597,6 +631,15 @@ void MRIStepCoupling_Write(MRIStepCoupling MRIC, FILE* outfile)
         }
         fprintf(outfile, "\n");
       }
+      if (MRIC->p > 0)
+      {
+        fprintf(outfile, "  embedding:\n      ");
+        for (j = 0; j < MRIC->stages; j++)
+        {
+          fprintf(outfile, "%" RSYMW "  ", MRIC->G[k][MRIC->stages][j]);
+        }
+        fprintf(outfile, "\n");
+      }
       fprintf(outfile, "\n");
     }
   }
@@ -658,6 +701,35 @@ int mriStepCoupling_GetStageType(MRIStepCoupling MRIC, int is)
   }
 }
 
+/* ---------------------------------------------------------------------------
+ * Exchanges the rows of the last stage and of the embedding in all coupling
+ * matrices. Calling it twice restores the original ordering. With the rows
+ * exchanged, the stage routines compute the embedded solution from the second
+ * to last stage solution.
+ * ---------------------------------------------------------------------------*/
+
+void mriStepCoupling_SwapEmbedding(MRIStepCoupling MRIC)
+{
+  int k;
+  sunrealtype* row;
+
+  for (k = 0; k < MRIC->nmat; k++)
+  {
+    if (MRIC->W)
+    {
+      row                          = MRIC->W[k][MRIC->stages - 1];
+      MRIC->W[k][MRIC->stages - 1] = MRIC->W[k][MRIC->stages];
+      MRIC->W[k][MRIC->stages]     = row;
+    }
+    if (MRIC->G)
+    {
+      row                          = MRIC->G[k][MRIC->stages - 1];
+      MRIC->G[k][MRIC->stages - 1] = MRIC->G[k][MRIC->stages];
+      MRIC->G[k][MRIC->stages]     = row;
+    }
+  }
+}
+
 /* ---------------------------------------------------------------------------
  * Computes the stage RHS vector storage maps. With repeated abscissae the
  * first stage of the pair generally corresponds to a column of zeros and so
@@ -691,7 +763,7 @@ int mriStepCoupling_GetStageMap(MRIStepCoupling MRIC, int* stage_map,
   idx = 0;
 
   /* Check if a stage corresponds to a column of zeros for all coupling
-   * matrices by computing the column sums */
+   * matrices (including the embedding row) by computing the column sums */
   for (j = 0; j < MRIC->stages; j++)
   {
     Wsum = ZERO;
@@ -701,7 +773,7 @@ int mriStepCoupling_GetStageMap(MRIStepCoupling MRIC, int* stage_map,
     {
       for (k = 0; k < MRIC->nmat; k++)
       {
-        for (i = 0; i < MRIC->stages; i++)
+        for (i = 0; i <= MRIC->stages; i++)
         {
           Wsum += SUNRabs(MRIC->W[k][i][j]);
         }
@@ -712,7 +784,7 @@ int mriStepCoupling_GetStageMap(MRIStepCoupling MRIC, int* stage_map,
     {
       for (k = 0; k < MRIC->nmat; k++)
       {
-        for (i = 0; i < MRIC->stages; i++)
+        for (i = 0; i <= MRIC->stages; i++)
         {
           Gsum += SUNRabs(MRIC->G[k][i][j]);
         }
@@ -26,6 +26,9 @@ extern "C" {
 /* Returns the stage type (implicit/explicit + fast/nofast) */
 int mriStepCoupling_GetStageType(MRIStepCoupling MRIC, int is);
 
+/* Exchanges the last and the embedding rows of the coupling matrices */
+void mriStepCoupling_SwapEmbedding(MRIStepCoupling MRIC);
+
 /* Returns index maps for where to store stage RHS evaluations */
 int mriStepCoupling_GetStageMap(MRIStepCoupling MRIC, int* stage_map,
                                 int* nstored_stages);
@@ -137,6 +137,8 @@ void* MRIStepCreate(ARKRhsFn fse, ARKRhsFn fsi, sunrealtype t0, N_Vector y0,
   ark_mem->step_getnumnonlinsolviters     = mriStep_GetNumNonlinSolvIters;
   ark_mem->step_getnumnonlinsolvconvfails = mriStep_GetNumNonlinSolvConvFails;
   ark_mem->step_getnonlinsolvstats        = mriStep_GetNonlinSolvStats;
+  ark_mem->step_getestlocalerrors         = mriStep_GetEstLocalErrors;
+  ark_mem->step_supports_adaptive         = SUNTRUE;
   ark_mem->step_supports_implicit         = SUNTRUE;
   ark_mem->step_mem                       = (void*)step_mem;
 
@@ -215,6 +217,16 @@ void* MRIStepCreate(ARKRhsFn fse, ARKRhsFn fsi, sunrealtype t0, N_Vector y0,
   step_mem->pre_inner_evolve  = NULL;
   step_mem->post_inner_evolve = NULL;
 
+  /* Initialize the component partition */
+  step_mem->partition = NULL;
+
+  /* Initialize temporal adaptivity data */
+  step_mem->yemb                  = NULL;
+  step_mem->inner_tolcontrol      = SUNFALSE;
+  step_mem->inner_rtol_factor     = ONE;
+  step_mem->inner_rtol_factor_new = ONE;
+  step_mem->inner_dsm             = ZERO;
+
   /* Initialize main ARKODE infrastructure (allocates vectors) */
   retval = arkInit(ark_mem, t0, y0, FIRST_INIT);
   if (retval != ARK_SUCCESS)
@@ -288,6 +300,15 @@ int MRIStepReInit(void* arkode_mem, ARKRhsFn fse, ARKRhsFn fsi, sunrealtype t0,
     return (ARK_ILL_INPUT);
   }
 
+  /* A partitioned integrator takes the full RHS as fse */
+  if (step_mem->partition != NULL && (fse == NULL || fsi != NULL))
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "A partitioned integrator requires fse = f and "
+                    "fsi = NULL");
+    return (ARK_ILL_INPUT);
+  }
+
   /* Set implicit/explicit problem based on function pointers */
   step_mem->explicit_rhs = (fse == NULL) ? SUNFALSE : SUNTRUE;
   step_mem->implicit_rhs = (fsi == NULL) ? SUNFALSE : SUNTRUE;
@@ -328,6 +349,14 @@ int MRIStepReInit(void* arkode_mem, ARKRhsFn fse, ARKRhsFn fsi, sunrealtype t0,
   step_mem->fse = fse;
   step_mem->fsi = fsi;
 
+  /* Reinitialize the packed fast subsystem of a partitioned integrator */
+  if (step_mem->partition != NULL)
+  {
+    step_mem->partition->f = fse;
+    retval = mriStepInnerStepper_Reset(step_mem->stepper, t0, y0);
+    if (retval != ARK_SUCCESS) { return (retval); }
+  }
+
   /* Initialize all the counters */
   step_mem->nfse      = 0;
   step_mem->nfsi      = 0;
@@ -361,6 +390,14 @@ int mriStep_Resize(ARKodeMem ark_mem, N_Vector y0,
   retval = mriStep_AccessStepMem(ark_mem, __func__, &step_mem);
   if (retval != ARK_SUCCESS) { return (retval); }
 
+  /* the component partition is fixed at creation */
+  if (step_mem->partition != NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "A partitioned integrator cannot be resized");
+    return (ARK_ILL_INPUT);
+  }
+
   /* Determine change in vector sizes */
   lrw1 = liw1 = 0;
   if (y0->ops->nvspace != NULL) { N_VSpace(y0, &lrw1, &liw1); }
@@ -395,6 +432,18 @@ int mriStep_Resize(ARKodeMem ark_mem, N_Vector y0,
     }
   }
 
+  /* Resize the embedded solution vector (if applicable) */
+  if (step_mem->yemb != NULL)
+  {
+    if (!arkResizeVec(ark_mem, resize, resize_data, lrw_diff, liw_diff, y0,
+                      &step_mem->yemb))
+    {
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      "Unable to resize vector");
+      return (ARK_MEM_FAIL);
+    }
+  }
+
   /* Resize the nonlinear solver interface vectors (if applicable) */
   if (step_mem->sdata != NULL)
   {
@@ -581,6 +630,13 @@ void mriStep_Free(ARKodeMem ark_mem)
       step_mem->lmem = NULL;
     }
 
+    /* free the embedded solution vector */
+    if (step_mem->yemb != NULL)
+    {
+      arkFreeVec(ark_mem, &step_mem->yemb);
+      step_mem->yemb = NULL;
+    }
+
     /* free the sdata, zpred and zcor vectors */
     if (step_mem->sdata != NULL)
     {
@@ -628,6 +684,12 @@ void mriStep_Free(ARKodeMem ark_mem)
     }
     step_mem->nfusedopvecs = 0;
 
+    /* free the component partition, including its inner stepper */
+    if (step_mem->partition != NULL)
+    {
+      mriStep_PartitionFree(&step_mem->partition);
+    }
+
     /* free the time stepper module itself */
     free(ark_mem->step_mem);
     ark_mem->step_mem = NULL;
@@ -884,6 +946,7 @@ int mriStep_Init(ARKodeMem ark_mem, int init_type)
        an explicit method and an internal error weight function */
     reset_efun = SUNTRUE;
     if (step_mem->implicit_rhs) { reset_efun = SUNFALSE; }
+    if (!ark_mem->fixedstep) { reset_efun = SUNFALSE; }
     if (ark_mem->user_efun) { reset_efun = SUNFALSE; }
     if (reset_efun)
     {
@@ -892,11 +955,12 @@ int mriStep_Init(ARKodeMem ark_mem, int init_type)
       ark_mem->e_data    = ark_mem;
     }
 
-    /* assume fixed outer step size */
-    if (!ark_mem->fixedstep)
+    /* adaptive outer time stepping is not supported for ImEx problems */
+    if (!ark_mem->fixedstep && step_mem->implicit_rhs && step_mem->explicit_rhs)
     {
-      arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__,
-                      __FILE__, "Adaptive outer time stepping is not currently supported");
+      arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      "Adaptive outer time stepping is not supported for ImEx "
+                      "problems");
       return (ARK_ILL_INPUT);
     }
 
@@ -944,13 +1008,13 @@ int mriStep_Init(ARKodeMem ark_mem, int init_type)
       return (ARK_ILL_INPUT);
     }
 
-    /* stage types */
+    /* stage types (the last entry is the type of the embedding stage) */
     if (step_mem->stagetypes)
     {
       free(step_mem->stagetypes);
-      ark_mem->liw -= step_mem->stages;
+      ark_mem->liw -= step_mem->stages + 1;
     }
-    step_mem->stagetypes = (int*)calloc(step_mem->MRIC->stages,
+    step_mem->stagetypes = (int*)calloc(step_mem->MRIC->stages + 1,
                                         sizeof(*step_mem->stagetypes));
     if (step_mem->stagetypes == NULL)
     {
@@ -958,11 +1022,22 @@ int mriStep_Init(ARKodeMem ark_mem, int init_type)
                       MSG_ARK_MEM_FAIL);
       return (ARK_MEM_FAIL);
     }
-    ark_mem->liw += step_mem->MRIC->stages;
+    ark_mem->liw += step_mem->MRIC->stages + 1;
     for (j = 0; j < step_mem->MRIC->stages; j++)
     {
       step_mem->stagetypes[j] = mriStepCoupling_GetStageType(step_mem->MRIC, j);
     }
+    mriStepCoupling_SwapEmbedding(step_mem->MRIC);
+    step_mem->stagetypes[step_mem->MRIC->stages] =
+      mriStepCoupling_GetStageType(step_mem->MRIC, step_mem->MRIC->stages - 1);
+    mriStepCoupling_SwapEmbedding(step_mem->MRIC);
+    if (!ark_mem->fixedstep &&
+        step_mem->stagetypes[step_mem->MRIC->stages] == MRISTAGE_DIRK_FAST)
+    {
+      arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      "solve-coupled DIRK embeddings are not supported");
+      return (ARK_ILL_INPUT);
+    }
 
     /* explicit RK coefficient row */
     if (step_mem->Ae_row)
@@ -1030,8 +1105,34 @@ int mriStep_Init(ARKodeMem ark_mem, int init_type)
 
     /* Retrieve/store method and embedding orders now that tables are finalized */
     step_mem->stages = step_mem->MRIC->stages;
-    step_mem->q      = step_mem->MRIC->q;
-    step_mem->p      = step_mem->MRIC->p;
+    step_mem->q = ark_mem->hadapt_mem->q = step_mem->MRIC->q;
+    step_mem->p = ark_mem->hadapt_mem->p = step_mem->MRIC->p;
+
+    /* Allocate the embedded solution and wrap an MRI step size and fast
+       tolerance controller (if needed) for adaptive slow time steps */
+    if (!ark_mem->fixedstep)
+    {
+      if (!arkAllocVec(ark_mem, ark_mem->ewt, &(step_mem->yemb)))
+      {
+        return (ARK_MEM_FAIL);
+      }
+
+      step_mem->inner_tolcontrol = SUNFALSE;
+      if (SUNAdaptController_GetType(ark_mem->hadapt_mem->hcontroller) ==
+          SUN_ADAPTCONTROLLER_MRI_H_TOL)
+      {
+        retval = mriStep_AttachHTolControl(ark_mem, step_mem);
+        if (retval != ARK_SUCCESS) { return (retval); }
+      }
+      else if (mriStep_IsHTolControl(ark_mem->hadapt_mem->hcontroller))
+      {
+        /* controller was wrapped in a previous initialization */
+        step_mem->inner_tolcontrol = SUNTRUE;
+      }
+      step_mem->inner_rtol_factor     = ONE;
+      step_mem->inner_rtol_factor_new = ONE;
+      step_mem->inner_dsm             = ZERO;
+    }
 
     /* Allocate MRI RHS vector memory, update storage requirements */
     /*   Allocate Fse[0] ... Fse[nstages_active - 1] and           */
@@ -1225,8 +1326,7 @@ int mriStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
       /* compute the explicit component */
       if (step_mem->explicit_rhs)
       {
-        retval = step_mem->fse(t, y, step_mem->Fse[0], ark_mem->user_data);
-        step_mem->nfse++;
+        retval = mriStep_EvalFse(ark_mem, step_mem, t, y, step_mem->Fse[0]);
         if (retval != 0)
         {
           arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__,
@@ -1287,8 +1387,7 @@ int mriStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
       /* compute the explicit component */
       if (step_mem->explicit_rhs)
       {
-        retval = step_mem->fse(t, y, step_mem->Fse[0], ark_mem->user_data);
-        step_mem->nfse++;
+        retval = mriStep_EvalFse(ark_mem, step_mem, t, y, step_mem->Fse[0]);
         if (retval != 0)
         {
           arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__,
@@ -1346,8 +1445,7 @@ int mriStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
     /* compute the explicit component and store in ark_tempv2 */
     if (step_mem->explicit_rhs)
     {
-      retval = step_mem->fse(t, y, ark_mem->tempv2, ark_mem->user_data);
-      step_mem->nfse++;
+      retval = mriStep_EvalFse(ark_mem, step_mem, t, y, ark_mem->tempv2);
       if (retval != 0)
       {
         arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
@@ -1449,6 +1547,29 @@ int mriStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr)
   retval = mriStep_AccessStepMem(ark_mem, __func__, &step_mem);
   if (retval != ARK_SUCCESS) { return (retval); }
 
+  /* with adaptive steps a previous attempt may have failed, so restart the
+     slow stages and the inner stepper from the step solution */
+  if (!ark_mem->fixedstep)
+  {
+    N_VScale(ONE, ark_mem->yn, ark_mem->ycur);
+    retval = mriStepInnerStepper_Reset(step_mem->stepper, ark_mem->tn,
+                                       ark_mem->ycur);
+    if (retval != ARK_SUCCESS) { return (ARK_INNERSTEP_FAIL); }
+
+    /* set the inner tolerance selected by the controller and restart the
+       accumulation of the inner error */
+    if (step_mem->inner_tolcontrol)
+    {
+      step_mem->inner_rtol_factor = step_mem->inner_rtol_factor_new;
+      retval = mriStepInnerStepper_SetRTol(step_mem->stepper,
+                                           step_mem->inner_rtol_factor *
+                                             ark_mem->reltol);
+      if (retval != ARK_SUCCESS) { return (ARK_INNERSTEP_FAIL); }
+      retval = mriStepInnerStepper_ResetAccumulatedError(step_mem->stepper);
+      if (retval != ARK_SUCCESS) { return (ARK_INNERSTEP_FAIL); }
+    }
+  }
+
   /* call nonlinear solver setup if it exists */
   if (step_mem->NLS)
   {
@@ -1472,9 +1593,8 @@ int mriStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr)
     /* compute the explicit component */
     if (step_mem->explicit_rhs)
     {
-      retval = step_mem->fse(ark_mem->tn, ark_mem->yn, step_mem->Fse[0],
-                             ark_mem->user_data);
-      step_mem->nfse++;
+      retval = mriStep_EvalFse(ark_mem, step_mem, ark_mem->tn, ark_mem->yn,
+                               step_mem->Fse[0]);
       if (retval) { return ARK_RHSFUNC_FAIL; }
     }
 
@@ -1523,6 +1643,14 @@ int mriStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr)
     /* Set current stage time  */
     ark_mem->tcur = ark_mem->tn + step_mem->MRIC->c[is] * ark_mem->h;
 
+    /* With adaptive steps, compute the embedded solution first; it replaces
+       the last stage and starts from the same previous stage solution */
+    if (!ark_mem->fixedstep && is == step_mem->stages - 1)
+    {
+      retval = mriStep_ComputeEmbedding(ark_mem, step_mem, nflagPtr);
+      if (retval != ARK_SUCCESS) { return (retval); }
+    }
+
     /* Solver diagnostics reporting */
 #if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
     SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
@@ -1583,10 +1711,8 @@ int mriStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr)
       /* store explicit slow rhs */
       if (step_mem->explicit_rhs)
       {
-        retval = step_mem->fse(ark_mem->tcur, ark_mem->ycur,
-                               step_mem->Fse[step_mem->stage_map[is]],
-                               ark_mem->user_data);
-        step_mem->nfse++;
+        retval = mriStep_EvalFse(ark_mem, step_mem, ark_mem->tcur, ark_mem->ycur,
+                                 step_mem->Fse[step_mem->stage_map[is]]);
         if (retval < 0) { return (ARK_RHSFUNC_FAIL); }
         if (retval > 0) { return (ARK_UNREC_RHSFUNC_ERR); }
 
@@ -1637,6 +1763,21 @@ int mriStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr)
   N_VPrintFile(ark_mem->ycur, ARK_LOGGER->debug_fp);
 #endif
 
+  /* Compute the local error estimate and the inner error estimate */
+  if (!ark_mem->fixedstep)
+  {
+    N_VLinearSum(ONE, ark_mem->ycur, -ONE, step_mem->yemb, ark_mem->tempv1);
+    *dsmPtr = N_VWrmsNorm(ark_mem->tempv1, ark_mem->ewt);
+
+    if (step_mem->inner_tolcontrol)
+    {
+      retval = mriStepInnerStepper_GetAccumulatedError(step_mem->stepper,
+                                                       &(step_mem->inner_dsm));
+      if (retval != ARK_SUCCESS) { return (ARK_INNERSTEP_FAIL); }
+      step_mem->inner_dsm /= ark_mem->reltol;
+    }
+  }
+
   /* Solver diagnostics reporting */
 #if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
   SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG, "ARKODE::mriStep_TakeStep",
@@ -1752,8 +1893,30 @@ int mriStep_SetCoupling(ARKodeMem ark_mem)
 
   /* select method based on order and type */
 
-  /**** ImEx methods ****/
-  if (step_mem->implicit_rhs && step_mem->explicit_rhs)
+  /**** embedded methods for adaptive steps ****/
+  if (!ark_mem->fixedstep && step_mem->implicit_rhs)
+  {
+    if (q_actual > 2)
+    {
+      arkProcessError(ark_mem, ARK_WARNING, __LINE__, __func__, __FILE__,
+                      "No embedded implicit MRI method at requested order, "
+                      "using q=2.");
+    }
+    table_id = MRISTEP_DEFAULT_IMPL_SD_2_AD;
+  }
+  else if (!ark_mem->fixedstep)
+  {
+    switch (q_actual)
+    {
+    case 1: table_id = MRISTEP_DEFAULT_EXPL_2_AD; break;
+    case 2: table_id = MRISTEP_DEFAULT_EXPL_2_AD; break;
+    case 3: table_id = MRISTEP_DEFAULT_EXPL_3_AD; break;
+    case 4: table_id = MRISTEP_DEFAULT_EXPL_4_AD; break;
+    }
+
+    /**** ImEx methods ****/
+  }
+  else if (step_mem->implicit_rhs && step_mem->explicit_rhs)
   {
     switch (q_actual)
     {
@@ -2054,6 +2217,59 @@ int mriStep_StageERKFast(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem, int is)
   return (ARK_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  mriStep_ComputeEmbedding
+
+  This routine computes the embedded solution of an adaptive step
+  and stores it in step_mem->yemb. The embedding replaces the last
+  stage of the method, so it is computed with the last and the
+  embedding rows of the coupling matrices exchanged, starting from
+  the second to last stage solution in ark_mem->ycur. On return,
+  ycur and the inner stepper are restored to that stage solution.
+  ---------------------------------------------------------------*/
+int mriStep_ComputeEmbedding(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
+                             int* nflagPtr)
+{
+  int is = step_mem->stages - 1; /* stage replaced by the embedding */
+  int retval;
+
+  /* save the previous stage solution */
+  N_VScale(ONE, ark_mem->ycur, ark_mem->tempv4);
+
+  /* compute the embedding with the coupling rows exchanged */
+  mriStepCoupling_SwapEmbedding(step_mem->MRIC);
+  switch (step_mem->stagetypes[step_mem->stages])
+  {
+  case (MRISTAGE_ERK_FAST):
+    retval = mriStep_StageERKFast(ark_mem, step_mem, is);
+    break;
+  case (MRISTAGE_ERK_NOFAST):
+    retval = mriStep_StageERKNoFast(ark_mem, step_mem, is);
+    break;
+  case (MRISTAGE_DIRK_NOFAST):
+    retval = mriStep_StageDIRKNoFast(ark_mem, step_mem, is, nflagPtr);
+    break;
+  default: retval = ARK_INVALID_TABLE; break;
+  }
+  mriStepCoupling_SwapEmbedding(step_mem->MRIC);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  N_VScale(ONE, ark_mem->ycur, step_mem->yemb);
+
+  /* restore the previous stage solution and the inner stepper state */
+  N_VScale(ONE, ark_mem->tempv4, ark_mem->ycur);
+  if (step_mem->stagetypes[step_mem->stages] == MRISTAGE_ERK_FAST)
+  {
+    retval = mriStepInnerStepper_Reset(step_mem->stepper,
+                                       ark_mem->tn +
+                                         step_mem->MRIC->c[is - 1] * ark_mem->h,
+                                       ark_mem->ycur);
+    if (retval != ARK_SUCCESS) { return (ARK_INNERSTEP_FAIL); }
+  }
+
+  return (ARK_SUCCESS);
+}
+
 /*---------------------------------------------------------------
   mriStep_StageERKNoFast
 
@@ -2377,6 +2593,30 @@ int mriStep_RKCoeffs(MRIStepCoupling MRIC, int is, int* stage_map,
   return (ARK_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  mriStep_EvalFse
+
+  This routine evaluates the slow explicit RHS and updates the
+  counter.  For a partitioned integrator the RHS is restricted to
+  the slow components, since the fast components are advanced by
+  the inner stepper.
+  ---------------------------------------------------------------*/
+int mriStep_EvalFse(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
+                    sunrealtype t, N_Vector y, N_Vector F)
+{
+  int retval;
+
+  retval = step_mem->fse(t, y, F, ark_mem->user_data);
+  step_mem->nfse++;
+
+  if (retval == 0 && step_mem->partition != NULL)
+  {
+    mriStep_PartitionApplyMask(step_mem->partition, F);
+  }
+
+  return (retval);
+}
+
 /*---------------------------------------------------------------
   mriStep_Predict
 
@@ -2734,6 +2974,72 @@ int MRIStepInnerStepper_SetResetFn(MRIStepInnerStepper stepper,
   return ARK_SUCCESS;
 }
 
+int MRIStepInnerStepper_SetAccumulatedErrorGetFn(
+  MRIStepInnerStepper stepper, MRIStepInnerGetAccumulatedError fn)
+{
+  if (stepper == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Inner stepper memory is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  if (stepper->ops == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Inner stepper operations structure is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  stepper->ops->geterror = fn;
+
+  return ARK_SUCCESS;
+}
+
+int MRIStepInnerStepper_SetAccumulatedErrorResetFn(
+  MRIStepInnerStepper stepper, MRIStepInnerResetAccumulatedError fn)
+{
+  if (stepper == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Inner stepper memory is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  if (stepper->ops == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Inner stepper operations structure is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  stepper->ops->reseterror = fn;
+
+  return ARK_SUCCESS;
+}
+
+int MRIStepInnerStepper_SetRTolFn(MRIStepInnerStepper stepper,
+                                  MRIStepInnerSetRTol fn)
+{
+  if (stepper == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Inner stepper memory is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  if (stepper->ops == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Inner stepper operations structure is NULL");
+    return ARK_ILL_INPUT;
+  }
+
+  stepper->ops->setrtol = fn;
+
+  return ARK_SUCCESS;
+}
+
 int MRIStepInnerStepper_AddForcing(MRIStepInnerStepper stepper, sunrealtype t,
                                    N_Vector f)
 {
@@ -2864,6 +3170,71 @@ int mriStepInnerStepper_Reset(MRIStepInnerStepper stepper, sunrealtype tR,
   }
 }
 
+/* Replace the inner (fast) stepper state at tR, without a full reset when the
+   stepper supports it and already sits at tR */
+int mriStepInnerStepper_SetState(MRIStepInnerStepper stepper, sunrealtype tR,
+                                 N_Vector yR)
+{
+  if (stepper == NULL) { return ARK_ILL_INPUT; }
+  if (stepper->ops == NULL) { return ARK_ILL_INPUT; }
+
+  if (stepper->ops->setstate)
+  {
+    stepper->last_flag = stepper->ops->setstate(stepper, tR, yR);
+    return stepper->last_flag;
+  }
+  else { return mriStepInnerStepper_Reset(stepper, tR, yR); }
+}
+
+/* Return the accumulated error estimate of the inner stepper (required for
+   the fast tolerance control) */
+int mriStepInnerStepper_GetAccumulatedError(MRIStepInnerStepper stepper,
+                                            sunrealtype* accum_error)
+{
+  if (stepper == NULL) { return ARK_ILL_INPUT; }
+  if (stepper->ops == NULL) { return ARK_ILL_INPUT; }
+  if (stepper->ops->geterror == NULL) { return ARK_ILL_INPUT; }
+
+  stepper->last_flag = stepper->ops->geterror(stepper, accum_error);
+  return stepper->last_flag;
+}
+
+/* Reset the accumulated error estimate of the inner stepper */
+int mriStepInnerStepper_ResetAccumulatedError(MRIStepInnerStepper stepper)
+{
+  if (stepper == NULL) { return ARK_ILL_INPUT; }
+  if (stepper->ops == NULL) { return ARK_ILL_INPUT; }
+
+  if (stepper->ops->reseterror)
+  {
+    stepper->last_flag = stepper->ops->reseterror(stepper);
+    return stepper->last_flag;
+  }
+  else
+  {
+    /* assume stepper does not accumulate errors */
+    return ARK_SUCCESS;
+  }
+}
+
+/* Set the relative tolerance of the inner stepper */
+int mriStepInnerStepper_SetRTol(MRIStepInnerStepper stepper, sunrealtype rtol)
+{
+  if (stepper == NULL) { return ARK_ILL_INPUT; }
+  if (stepper->ops == NULL) { return ARK_ILL_INPUT; }
+
+  if (stepper->ops->setrtol)
+  {
+    stepper->last_flag = stepper->ops->setrtol(stepper, rtol);
+    return stepper->last_flag;
+  }
+  else
+  {
+    /* assume stepper does not use tolerances */
+    return ARK_SUCCESS;
+  }
+}
+
 /* Allocate MRI forcing and fused op workspace vectors if necessary */
 int mriStepInnerStepper_AllocVecs(MRIStepInnerStepper stepper, int count,
                                   N_Vector tmpl)
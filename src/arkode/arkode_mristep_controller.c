@@ -0,0 +1,183 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the MRIStep wrapper of
+ * SUN_ADAPTCONTROLLER_MRI_H_TOL controllers.  The wrapper presents
+ * the multirate controller to the ARKODE infrastructure as a
+ * SUN_ADAPTCONTROLLER_H controller, and passes the fast tolerance
+ * factor and the fast error estimate stored in the MRIStep memory
+ * to the multirate controller.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode_impl.h"
+#include "arkode_mristep_impl.h"
+
+/* wrapper content: the multirate controller and the MRIStep memory */
+struct _mriStepHTolControlContent
+{
+  SUNAdaptController C;
+  ARKodeMRIStepMem step_mem;
+};
+
+typedef struct _mriStepHTolControlContent* mriStepHTolControlContent;
+
+/* ---------------
+ * Macro accessors
+ * --------------- */
+
+#define MC_CONTENT(C) ((mriStepHTolControlContent)(C->content))
+#define MC_CONTROL(C) (MC_CONTENT(C)->C)
+#define MC_STEPMEM(C) (MC_CONTENT(C)->step_mem)
+
+/* -----------------------------------------------------------------
+ * implementation of wrapper operations
+ * ----------------------------------------------------------------- */
+
+static SUNAdaptController_Type mriStep_HTolGetType(
+  SUNDIALS_MAYBE_UNUSED SUNAdaptController C)
+{
+  return SUN_ADAPTCONTROLLER_H;
+}
+
+static SUNErrCode mriStep_HTolEstimateStep(SUNAdaptController C,
+                                           sunrealtype H, int P,
+                                           sunrealtype DSM, sunrealtype* Hnew)
+{
+  ARKodeMRIStepMem step_mem = MC_STEPMEM(C);
+  return (SUNAdaptController_EstimateStepTol(MC_CONTROL(C), H,
+                                             step_mem->inner_rtol_factor, P,
+                                             DSM, step_mem->inner_dsm, Hnew,
+                                             &step_mem->inner_rtol_factor_new));
+}
+
+static SUNErrCode mriStep_HTolReset(SUNAdaptController C)
+{
+  return (SUNAdaptController_Reset(MC_CONTROL(C)));
+}
+
+static SUNErrCode mriStep_HTolSetDefaults(SUNAdaptController C)
+{
+  return (SUNAdaptController_SetDefaults(MC_CONTROL(C)));
+}
+
+static SUNErrCode mriStep_HTolWrite(SUNAdaptController C, FILE* fptr)
+{
+  fprintf(fptr, "MRIStep multirate controller wrapper:\n");
+  return (SUNAdaptController_Write(MC_CONTROL(C), fptr));
+}
+
+static SUNErrCode mriStep_HTolSetErrorBias(SUNAdaptController C,
+                                           sunrealtype bias)
+{
+  return (SUNAdaptController_SetErrorBias(MC_CONTROL(C), bias));
+}
+
+static SUNErrCode mriStep_HTolUpdateH(SUNAdaptController C, sunrealtype H,
+                                      sunrealtype DSM)
+{
+  ARKodeMRIStepMem step_mem = MC_STEPMEM(C);
+  return (SUNAdaptController_UpdateMRIHTol(MC_CONTROL(C), H,
+                                           step_mem->inner_rtol_factor, DSM,
+                                           step_mem->inner_dsm));
+}
+
+static SUNErrCode mriStep_HTolSpace(SUNAdaptController C, long int* lenrw,
+                                    long int* leniw)
+{
+  return (SUNAdaptController_Space(MC_CONTROL(C), lenrw, leniw));
+}
+
+/* -----------------------------------------------------------------
+ * internal functions
+ * ----------------------------------------------------------------- */
+
+/*---------------------------------------------------------------
+  mriStep_AttachHTolControl:
+
+  Replaces the SUN_ADAPTCONTROLLER_MRI_H_TOL controller attached
+  to ARKODE with an MRIStep-owned SUN_ADAPTCONTROLLER_H wrapper,
+  and enables control of the inner stepper tolerance.  The user
+  retains ownership of the multirate controller itself.
+  ---------------------------------------------------------------*/
+int mriStep_AttachHTolControl(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem)
+{
+  SUNAdaptController C;
+  mriStepHTolControlContent content;
+
+  /* the inner stepper must support tolerance and error accumulation */
+  if (!step_mem->stepper->ops->geterror ||
+      !step_mem->stepper->ops->reseterror ||
+      !step_mem->stepper->ops->setrtol)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The inner stepper does not support the accumulated "
+                    "error and relative tolerance functions required by the "
+                    "MRI step size and tolerance controller");
+    return (ARK_ILL_INPUT);
+  }
+
+  C = SUNAdaptController_NewEmpty(ark_mem->sunctx);
+  if (C == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_ARKMEM_FAIL);
+    return (ARK_MEM_FAIL);
+  }
+
+  C->ops->gettype      = mriStep_HTolGetType;
+  C->ops->estimatestep = mriStep_HTolEstimateStep;
+  C->ops->reset        = mriStep_HTolReset;
+  C->ops->setdefaults  = mriStep_HTolSetDefaults;
+  C->ops->write        = mriStep_HTolWrite;
+  C->ops->seterrorbias = mriStep_HTolSetErrorBias;
+  C->ops->updateh      = mriStep_HTolUpdateH;
+  C->ops->space        = mriStep_HTolSpace;
+
+  content = NULL;
+  content = (mriStepHTolControlContent)malloc(sizeof *content);
+  if (content == NULL)
+  {
+    SUNAdaptController_DestroyEmpty(C);
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_ARKMEM_FAIL);
+    return (ARK_MEM_FAIL);
+  }
+  content->C        = ark_mem->hadapt_mem->hcontroller;
+  content->step_mem = step_mem;
+  C->content        = content;
+
+  /* the wrapper reports the space of the multirate controller, so the
+     ARKODE workspace counters are unchanged */
+  ark_mem->hadapt_mem->hcontroller   = C;
+  ark_mem->hadapt_mem->owncontroller = SUNTRUE;
+  step_mem->inner_tolcontrol         = SUNTRUE;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  mriStep_IsHTolControl:
+
+  Returns SUNTRUE if C is a wrapper created by
+  mriStep_AttachHTolControl.
+  ---------------------------------------------------------------*/
+sunbooleantype mriStep_IsHTolControl(SUNAdaptController C)
+{
+  if (C == NULL) { return (SUNFALSE); }
+  return (C->ops->estimatestep == mriStep_HTolEstimateStep);
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
@@ -54,6 +54,41 @@ extern "C" {
   MRI time step module data structure
   ===============================================================*/
 
+/*---------------------------------------------------------------
+  The type MRIStepPartitionMem is type pointer to struct
+  _MRIStepPartitionMem. This structure contains the data of the
+  component-partitioned mode created by MRIStepCreatePartitioned.
+  ---------------------------------------------------------------*/
+typedef struct _MRIStepPartitionMem* MRIStepPartitionMem;
+
+struct _MRIStepPartitionMem
+{
+  ARKRhsFn f;                  /* full RHS function y' = f(t,y)          */
+  ARKodeMem ark_mem;           /* outer (slow) ARKODE memory             */
+  N_Vector fmask;              /* fast component mask (zeros and ones)   */
+  N_Vector smask;              /* slow component mask, 1 - fmask         */
+  sunindextype nfast;          /* number of fast components              */
+  sunindextype* fidx;          /* indices of the fast components         */
+  N_Vector yf;                 /* packed fast state                      */
+  void* inner_mem;             /* ARKStep memory for the packed system   */
+  MRIStepInnerStepper stepper; /* inner stepper wrapping inner_mem       */
+
+  /* inner ODE data of the current fast integration */
+  sunrealtype t0;     /* initial time                             */
+  N_Vector v0;        /* initial state                            */
+  sunrealtype tshift; /* forcing time shift                       */
+  sunrealtype tscale; /* forcing time scale                       */
+  N_Vector* forcing;  /* forcing vectors                          */
+  int nforcing;       /* number of forcing vectors                */
+  N_Vector w;         /* full state work vector                   */
+  N_Vector fw;        /* full RHS work vector                     */
+
+  /* Reusable arrays for fused vector operations */
+  int nfusedopvecs;
+  sunrealtype* cvals;
+  N_Vector* Xvecs;
+};
+
 /*---------------------------------------------------------------
   The type ARKodeMRIStepMem is type pointer to struct
   ARKodeMRIStepMemRec. This structure contains fields to
@@ -126,6 +161,18 @@ typedef struct ARKodeMRIStepMemRec
   /* Inner stepper */
   MRIStepInnerStepper stepper;
 
+  /* Component partition (NULL unless created by
+     MRIStepCreatePartitioned) */
+  MRIStepPartitionMem partition;
+
+  /* Temporal adaptivity data */
+  N_Vector yemb;                     /* embedded solution                */
+  sunbooleantype inner_tolcontrol;   /* adapt the inner tolerance?       */
+  sunrealtype inner_rtol_factor;     /* inner rtol / outer rtol          */
+  sunrealtype inner_rtol_factor_new; /* factor for the next step         */
+  sunrealtype inner_dsm;             /* inner error relative to the
+                                        outer relative tolerance         */
+
   /* User-supplied pre and post inner evolve functions */
   MRIStepPreInnerFn pre_inner_evolve;
   MRIStepPostInnerFn post_inner_evolve;
@@ -155,6 +202,11 @@ struct _MRIStepInnerStepper_Ops
   MRIStepInnerEvolveFn evolve;
   MRIStepInnerFullRhsFn fullrhs;
   MRIStepInnerResetFn reset;
+  MRIStepInnerResetFn setstate; /* internal, replaces the state at the
+                                   current time (optional) */
+  MRIStepInnerGetAccumulatedError geterror;
+  MRIStepInnerResetAccumulatedError reseterror;
+  MRIStepInnerSetRTol setrtol;
 };
 
 struct _MRIStepInnerStepper
@@ -229,6 +281,7 @@ int mriStep_GetNumNonlinSolvIters(ARKodeMem ark_mem, long int* nniters);
 int mriStep_GetNumNonlinSolvConvFails(ARKodeMem ark_mem, long int* nnfails);
 int mriStep_GetNonlinSolvStats(ARKodeMem ark_mem, long int* nniters,
                                long int* nnfails);
+int mriStep_GetEstLocalErrors(ARKodeMem ark_mem, N_Vector ele);
 int mriStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile, SUNOutputFormat fmt);
 int mriStep_WriteParameters(ARKodeMem ark_mem, FILE* fp);
 int mriStep_Reset(ARKodeMem ark_mem, sunrealtype tR, N_Vector yR);
@@ -252,11 +305,20 @@ int mriStep_StageDIRKFast(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem, int is,
                           int* nflagPtr);
 int mriStep_StageDIRKNoFast(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
                             int is, int* nflagPtr);
+int mriStep_ComputeEmbedding(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
+                             int* nflagPtr);
+int mriStep_EvalFse(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
+                    sunrealtype t, N_Vector y, N_Vector F);
 int mriStep_Predict(ARKodeMem ark_mem, int istage, N_Vector yguess);
 int mriStep_StageSetup(ARKodeMem ark_mem);
 int mriStep_NlsInit(ARKodeMem ark_mem);
 int mriStep_Nls(ARKodeMem ark_mem, int nflag);
 
+/* Component partition functions */
+sunbooleantype mriStep_PartitionCheckNVector(N_Vector tmpl);
+void mriStep_PartitionApplyMask(MRIStepPartitionMem P, N_Vector F);
+void mriStep_PartitionFree(MRIStepPartitionMem* P);
+
 /* private functions passed to nonlinear solver */
 int mriStep_NlsResidual(N_Vector yy, N_Vector res, void* arkode_mem);
 int mriStep_NlsFPFunction(N_Vector yy, N_Vector res, void* arkode_mem);
@@ -274,6 +336,12 @@ int mriStepInnerStepper_FullRhs(MRIStepInnerStepper stepper, sunrealtype t,
                                 N_Vector y, N_Vector f, int mode);
 int mriStepInnerStepper_Reset(MRIStepInnerStepper stepper, sunrealtype tR,
                               N_Vector yR);
+int mriStepInnerStepper_SetState(MRIStepInnerStepper stepper, sunrealtype tR,
+                                 N_Vector yR);
+int mriStepInnerStepper_GetAccumulatedError(MRIStepInnerStepper stepper,
+                                            sunrealtype* accum_error);
+int mriStepInnerStepper_ResetAccumulatedError(MRIStepInnerStepper stepper);
+int mriStepInnerStepper_SetRTol(MRIStepInnerStepper stepper, sunrealtype rtol);
 int mriStepInnerStepper_AllocVecs(MRIStepInnerStepper stepper, int count,
                                   N_Vector tmpl);
 int mriStepInnerStepper_Resize(MRIStepInnerStepper stepper, ARKVecResizeFn resize,
@@ -286,6 +354,10 @@ void mriStepInnerStepper_PrintMem(MRIStepInnerStepper stepper, FILE* outfile);
 int mriStep_ComputeInnerForcing(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem,
                                 int stage, sunrealtype cdiff);
 
+/* Wrap an MRI_H_TOL controller for use by the ARKODE infrastructure */
+int mriStep_AttachHTolControl(ARKodeMem ark_mem, ARKodeMRIStepMem step_mem);
+sunbooleantype mriStep_IsHTolControl(SUNAdaptController C);
+
 /* Return effective RK coefficients (nofast stage) */
 int mriStep_RKCoeffs(MRIStepCoupling MRIC, int is, int* stage_map,
                      sunrealtype* Ae_row, sunrealtype* Ai_row);
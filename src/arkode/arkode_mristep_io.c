@@ -662,6 +662,25 @@ int mriStep_GetNonlinSolvStats(ARKodeMem ark_mem, long int* nniters,
   return (ARK_SUCCESS);
 }
 
+/*---------------------------------------------------------------
+  mriStep_GetEstLocalErrors: Returns the current local truncation
+  error estimate vector
+  ---------------------------------------------------------------*/
+int mriStep_GetEstLocalErrors(ARKodeMem ark_mem, N_Vector ele)
+{
+  int retval;
+  ARKodeMRIStepMem step_mem;
+  retval = mriStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* return an error if local truncation error is not computed */
+  if (ark_mem->fixedstep) { return (ARK_STEPPER_UNSUPPORTED); }
+
+  /* otherwise, copy local truncation error vector to output */
+  N_VScale(ONE, ark_mem->tempv1, ele);
+  return (ARK_SUCCESS);
+}
+
 /*---------------------------------------------------------------
   mriStep_PrintAllStats:
 
@@ -717,6 +736,15 @@ int mriStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile, SUNOutputFormat fmt)
         fprintf(outfile, "Prec evals per NLS iter      = %" RSYM "\n",
                 (sunrealtype)arkls_mem->npe / (sunrealtype)step_mem->nls_iters);
       }
+      if (ark_mem->costmodel)
+      {
+        fprintf(outfile, "Jac setup time               = %" RSYM "\n",
+                ark_mem->tjac);
+        fprintf(outfile, "LS setup time                = %" RSYM "\n",
+                ark_mem->tlsetup);
+        fprintf(outfile, "NLS iteration time           = %" RSYM "\n",
+                ark_mem->tnls);
+      }
     }
     break;
 
@@ -763,6 +791,12 @@ int mriStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile, SUNOutputFormat fmt)
         fprintf(outfile, ",Jac evals per NLS iter,0");
         fprintf(outfile, ",Prec evals per NLS iter,0");
       }
+      if (ark_mem->costmodel)
+      {
+        fprintf(outfile, ",Jac setup time,%" RSYM, ark_mem->tjac);
+        fprintf(outfile, ",LS setup time,%" RSYM, ark_mem->tlsetup);
+        fprintf(outfile, ",NLS iteration time,%" RSYM, ark_mem->tnls);
+      }
     }
     fprintf(outfile, "\n");
     break;
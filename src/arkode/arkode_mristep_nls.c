@@ -22,6 +22,7 @@
 
 #include "arkode_impl.h"
 #include "arkode_mristep_impl.h"
+#include "sundials_utils.h"
 
 /*===============================================================
   Interface routines supplied to ARKODE
@@ -267,6 +268,8 @@ int mriStep_Nls(ARKodeMem ark_mem, int nflag)
   sunbooleantype callLSetup;
   long int nls_iters_inc = 0;
   long int nls_fails_inc = 0;
+  double tstart          = 0.0;
+  sunrealtype tlsetup    = ZERO;
   int retval;
 
   /* access ARKodeMRIStepMem structure */
@@ -321,11 +324,25 @@ int mriStep_Nls(ARKodeMem ark_mem, int nflag)
   /* Reset the stored residual norm (for iterative linear solvers) */
   step_mem->eRNrm = SUN_RCONST(0.1) * step_mem->nlscoef;
 
-  /* solve the nonlinear system for the actual correction */
+  /* solve the nonlinear system for the actual correction (timing it for
+     the Jacobian cost model) */
+  if (ark_mem->costmodel)
+  {
+    tstart  = sunWallClockTime();
+    tlsetup = ark_mem->tjac + ark_mem->tlsetup;
+  }
+
   retval = SUNNonlinSolSolve(step_mem->NLS, step_mem->zpred, step_mem->zcor,
                              ark_mem->ewt, step_mem->nlscoef, callLSetup,
                              ark_mem);
 
+  if (ark_mem->costmodel)
+  {
+    /* exclude the time spent in lsetup, which is timed separately */
+    tlsetup = ark_mem->tjac + ark_mem->tlsetup - tlsetup;
+    ark_mem->tnls += (sunrealtype)(sunWallClockTime() - tstart) - tlsetup;
+  }
+
 #ifdef SUNDIALS_LOGGING_EXTRA_DEBUG
   SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG, "ARKODE::mriStep_Nls",
                      "correction", "zcor(:) =", "");
@@ -367,6 +384,7 @@ int mriStep_NlsLSetup(sunbooleantype jbad, sunbooleantype* jcur, void* arkode_me
 {
   ARKodeMem ark_mem;
   ARKodeMRIStepMem step_mem;
+  double tsetup = 0.0;
   int retval;
 
   /* access ARKodeMem and ARKodeMRIStepMem structures */
@@ -378,6 +396,8 @@ int mriStep_NlsLSetup(sunbooleantype jbad, sunbooleantype* jcur, void* arkode_me
 
   /* Use ARKODE's tempv1, tempv2 and tempv3 as
      temporary vectors for the linear solver setup routine */
+  if (ark_mem->costmodel) { tsetup = sunWallClockTime(); }
+
   step_mem->nsetups++;
   retval = step_mem->lsetup(ark_mem, step_mem->convfail, ark_mem->tcur,
                             ark_mem->ycur,
@@ -388,6 +408,18 @@ int mriStep_NlsLSetup(sunbooleantype jbad, sunbooleantype* jcur, void* arkode_me
   /* update Jacobian status */
   *jcur = step_mem->jcur;
 
+  /* accumulate the setup time for the Jacobian cost model */
+  if (ark_mem->costmodel)
+  {
+    tsetup = sunWallClockTime() - tsetup;
+    if (step_mem->jcur)
+    {
+      ark_mem->tjac     += (sunrealtype)tsetup;
+      ark_mem->tjaclast  = (sunrealtype)tsetup;
+    }
+    else { ark_mem->tlsetup += (sunrealtype)tsetup; }
+  }
+
   /* update flags and 'gamma' values for last lsetup call */
   ark_mem->firststage = SUNFALSE;
   step_mem->gamrat = step_mem->crate = ONE;
@@ -0,0 +1,528 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the component-partitioned
+ * mode of the MRIStep module.  The user supplies a single RHS
+ * function and a mask selecting the fast components.  The slow
+ * RHS is the user RHS restricted to the slow components, and the
+ * fast components are packed into a short serial vector that is
+ * advanced by an internal ARKStep integrator, so the inner steps
+ * only operate on the fast subset.
+ * -----------------------------------------------------------------*/
+
+#include <nvector/nvector_serial.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode_arkstep_impl.h"
+#include "arkode_impl.h"
+#include "arkode_mristep_impl.h"
+
+#define HALF SUN_RCONST(0.5)
+
+/* -----------------------------------------------------------------
+ * private utility routines
+ * ----------------------------------------------------------------- */
+
+/* copy the fast components of v into the packed vector vf */
+static void mriStep_PartitionGather(MRIStepPartitionMem P, N_Vector v,
+                                    N_Vector vf)
+{
+  sunindextype i;
+  sunrealtype* vdata  = N_VGetArrayPointer(v);
+  sunrealtype* vfdata = NV_DATA_S(vf);
+
+  for (i = 0; i < P->nfast; i++) { vfdata[i] = vdata[P->fidx[i]]; }
+}
+
+/* copy the packed vector vf into the fast components of v */
+static void mriStep_PartitionScatter(MRIStepPartitionMem P, N_Vector vf,
+                                     N_Vector v)
+{
+  sunindextype i;
+  sunrealtype* vdata  = N_VGetArrayPointer(v);
+  sunrealtype* vfdata = NV_DATA_S(vf);
+
+  for (i = 0; i < P->nfast; i++) { vdata[P->fidx[i]] = vfdata[i]; }
+}
+
+/* Computes the state v(t) = v0 + int_{t0}^{t} r(s) ds of the inner ODE for
+   the current forcing polynomial r. Since the slow RHS vanishes in the fast
+   components, so does r, and only the slow components of v change. */
+static void mriStep_PartitionSlowState(MRIStepPartitionMem P, sunrealtype t,
+                                       N_Vector v)
+{
+  int k;
+  sunrealtype tau, tau0, taup, tau0p;
+
+  tau   = (t - P->tshift) / P->tscale;
+  tau0  = (P->t0 - P->tshift) / P->tscale;
+  taup  = tau;
+  tau0p = tau0;
+
+  P->cvals[0] = ONE;
+  P->Xvecs[0] = P->v0;
+  for (k = 0; k < P->nforcing; k++)
+  {
+    P->cvals[k + 1] = P->tscale * (taup - tau0p) / (sunrealtype)(k + 1);
+    P->Xvecs[k + 1] = P->forcing[k];
+    taup *= tau;
+    tau0p *= tau0;
+  }
+
+  (void)N_VLinearCombination(P->nforcing + 1, P->cvals, P->Xvecs, v);
+}
+
+/*---------------------------------------------------------------
+  mriStep_PartitionFastRhs:
+
+  RHS of the packed fast subsystem advanced by the inner ARKStep
+  integrator.  The slow components are given by the integrated
+  forcing polynomial, the fast components by the packed state.
+  ---------------------------------------------------------------*/
+static int mriStep_PartitionFastRhs(sunrealtype t, N_Vector yf, N_Vector yfdot,
+                                    void* user_data)
+{
+  MRIStepPartitionMem P = (MRIStepPartitionMem)user_data;
+  int retval;
+
+  mriStep_PartitionSlowState(P, t, P->w);
+  mriStep_PartitionScatter(P, yf, P->w);
+
+  retval = P->f(t, P->w, P->fw, P->ark_mem->user_data);
+  if (retval != 0) { return (retval); }
+
+  mriStep_PartitionGather(P, P->fw, yfdot);
+
+  return (0);
+}
+
+/* -----------------------------------------------------------------
+ * implementation of the inner stepper operations
+ * ----------------------------------------------------------------- */
+
+static int mriStep_PartitionInnerEvolve(MRIStepInnerStepper stepper,
+                                        sunrealtype t0, sunrealtype tout,
+                                        N_Vector v)
+{
+  MRIStepPartitionMem P;
+  ARKodeMem inner_mem;
+  sunrealtype tret;
+  int retval;
+
+  retval = MRIStepInnerStepper_GetContent(stepper, (void**)&P);
+  if (retval != ARK_SUCCESS) { return (retval); }
+  inner_mem = (ARKodeMem)P->inner_mem;
+
+  /* store the forcing data and the initial state of the slow components */
+  retval = MRIStepInnerStepper_GetForcingData(stepper, &P->tshift, &P->tscale,
+                                              &P->forcing, &P->nforcing);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (P->nforcing + 1 > P->nfusedopvecs)
+  {
+    free(P->cvals);
+    free(P->Xvecs);
+    P->nfusedopvecs = P->nforcing + 1;
+    P->cvals = (sunrealtype*)calloc(P->nfusedopvecs, sizeof(sunrealtype));
+    P->Xvecs = (N_Vector*)calloc(P->nfusedopvecs, sizeof(N_Vector));
+    if (P->cvals == NULL || P->Xvecs == NULL)
+    {
+      P->nfusedopvecs = 0;
+      return (ARK_MEM_FAIL);
+    }
+  }
+
+  P->t0 = t0;
+  N_VScale(ONE, v, P->v0);
+
+  /* the fast RHS changed with the forcing, so the stored RHS of the inner
+     integrator is out of date */
+  inner_mem->fn_is_current = SUNFALSE;
+
+  /* evolve the packed fast subsystem */
+  retval = ARKodeSetStopTime(inner_mem, tout);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  retval = ARKodeEvolve(inner_mem, tout, P->yf, &tret, ARK_NORMAL);
+  if (retval < 0) { return (retval); }
+
+  /* update the slow components and unpack the fast components */
+  mriStep_PartitionSlowState(P, tout, v);
+  mriStep_PartitionScatter(P, P->yf, v);
+
+  return (ARK_SUCCESS);
+}
+
+static int mriStep_PartitionInnerFullRhs(MRIStepInnerStepper stepper,
+                                         sunrealtype t, N_Vector v, N_Vector f,
+                                         SUNDIALS_MAYBE_UNUSED int mode)
+{
+  MRIStepPartitionMem P;
+  int retval;
+
+  retval = MRIStepInnerStepper_GetContent(stepper, (void**)&P);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  retval = P->f(t, v, f, P->ark_mem->user_data);
+  if (retval != 0) { return (ARK_RHSFUNC_FAIL); }
+
+  N_VProd(P->fmask, f, f);
+
+  return (ARK_SUCCESS);
+}
+
+static int mriStep_PartitionInnerReset(MRIStepInnerStepper stepper,
+                                       sunrealtype tR, N_Vector vR)
+{
+  MRIStepPartitionMem P;
+  int retval;
+
+  retval = MRIStepInnerStepper_GetContent(stepper, (void**)&P);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  mriStep_PartitionGather(P, vR, P->yf);
+
+  return (ARKodeReset(P->inner_mem, tR, P->yf));
+}
+
+static int mriStep_PartitionInnerGetAccumulatedError(
+  MRIStepInnerStepper stepper, sunrealtype* accum_error)
+{
+  MRIStepPartitionMem P;
+  int retval;
+
+  retval = MRIStepInnerStepper_GetContent(stepper, (void**)&P);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  return (ARKodeGetAccumulatedError(P->inner_mem, accum_error));
+}
+
+static int mriStep_PartitionInnerResetAccumulatedError(
+  MRIStepInnerStepper stepper)
+{
+  MRIStepPartitionMem P;
+  int retval;
+
+  retval = MRIStepInnerStepper_GetContent(stepper, (void**)&P);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (((ARKodeMem)P->inner_mem)->AccumErrorType == ARK_ACCUMERROR_NONE)
+  {
+    return (ARKodeSetAccumulatedErrorType(P->inner_mem, ARK_ACCUMERROR_SUM));
+  }
+
+  return (ARKodeResetAccumulatedError(P->inner_mem));
+}
+
+static int mriStep_PartitionInnerSetRTol(MRIStepInnerStepper stepper,
+                                         sunrealtype rtol)
+{
+  MRIStepPartitionMem P;
+  int retval;
+
+  retval = MRIStepInnerStepper_GetContent(stepper, (void**)&P);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (rtol <= ZERO) { return (ARK_ILL_INPUT); }
+  ((ARKodeMem)P->inner_mem)->reltol = rtol;
+
+  return (ARK_SUCCESS);
+}
+
+/* -----------------------------------------------------------------
+ * private partition memory routines
+ * ----------------------------------------------------------------- */
+
+/*---------------------------------------------------------------
+  mriStep_PartitionCreate:
+
+  Allocates the partition memory for the fast mask and initial
+  state, including the packed fast state, the inner ARKStep
+  integrator and the inner stepper wrapping it.
+  ---------------------------------------------------------------*/
+static MRIStepPartitionMem mriStep_PartitionCreate(ARKRhsFn f, N_Vector mask,
+                                                   sunrealtype t0, N_Vector y0,
+                                                   SUNContext sunctx)
+{
+  MRIStepPartitionMem P;
+  sunindextype i, n;
+  sunrealtype* mdata;
+  sunrealtype* fmdata;
+  int retval;
+
+  P = (MRIStepPartitionMem)calloc(1, sizeof(*P));
+  if (P == NULL) { return (NULL); }
+
+  P->f = f;
+
+  /* count the fast components and store their indices */
+  n     = N_VGetLength(y0);
+  mdata = N_VGetArrayPointer(mask);
+  for (i = 0; i < n; i++)
+  {
+    if (mdata[i] > HALF) { P->nfast++; }
+  }
+  if (P->nfast == 0)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The fast component mask has no nonzero entries");
+    mriStep_PartitionFree(&P);
+    return (NULL);
+  }
+
+  P->fidx  = (sunindextype*)malloc(P->nfast * sizeof(sunindextype));
+  P->fmask = N_VClone(y0);
+  P->smask = N_VClone(y0);
+  P->v0    = N_VClone(y0);
+  P->w     = N_VClone(y0);
+  P->fw    = N_VClone(y0);
+  P->yf    = N_VNew_Serial(P->nfast, sunctx);
+  if (P->fidx == NULL || P->fmask == NULL || P->smask == NULL ||
+      P->v0 == NULL || P->w == NULL || P->fw == NULL || P->yf == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_ARKMEM_FAIL);
+    mriStep_PartitionFree(&P);
+    return (NULL);
+  }
+
+  /* store the mask as zeros and ones */
+  fmdata   = N_VGetArrayPointer(P->fmask);
+  P->nfast = 0;
+  for (i = 0; i < n; i++)
+  {
+    if (mdata[i] > HALF)
+    {
+      P->fidx[P->nfast++] = i;
+      fmdata[i]           = ONE;
+    }
+    else { fmdata[i] = ZERO; }
+  }
+  N_VConst(ONE, P->smask);
+  N_VLinearSum(ONE, P->smask, -ONE, P->fmask, P->smask);
+
+  /* create the integrator of the packed fast subsystem */
+  mriStep_PartitionGather(P, y0, P->yf);
+
+  P->inner_mem = ARKStepCreate(mriStep_PartitionFastRhs, NULL, t0, P->yf,
+                               sunctx);
+  if (P->inner_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    "Unable to create the fast ARKStep integrator");
+    mriStep_PartitionFree(&P);
+    return (NULL);
+  }
+
+  retval = ARKodeSetUserData(P->inner_mem, P);
+  if (retval != ARK_SUCCESS)
+  {
+    mriStep_PartitionFree(&P);
+    return (NULL);
+  }
+
+  /* wrap it as an inner stepper */
+  retval = MRIStepInnerStepper_Create(sunctx, &P->stepper);
+  if (retval != ARK_SUCCESS)
+  {
+    mriStep_PartitionFree(&P);
+    return (NULL);
+  }
+
+  MRIStepInnerStepper_SetContent(P->stepper, P);
+  MRIStepInnerStepper_SetEvolveFn(P->stepper, mriStep_PartitionInnerEvolve);
+  MRIStepInnerStepper_SetFullRhsFn(P->stepper, mriStep_PartitionInnerFullRhs);
+  MRIStepInnerStepper_SetResetFn(P->stepper, mriStep_PartitionInnerReset);
+  MRIStepInnerStepper_SetAccumulatedErrorGetFn(
+    P->stepper, mriStep_PartitionInnerGetAccumulatedError);
+  MRIStepInnerStepper_SetAccumulatedErrorResetFn(
+    P->stepper, mriStep_PartitionInnerResetAccumulatedError);
+  MRIStepInnerStepper_SetRTolFn(P->stepper, mriStep_PartitionInnerSetRTol);
+
+  return (P);
+}
+
+/*===============================================================
+  Exported functions
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  MRIStepCreatePartitioned:
+
+  Creates an MRIStep integrator for y' = f(t,y), in which the
+  components selected by fast_mask are integrated with the fast
+  time scale and all others with the slow time scale.
+  ---------------------------------------------------------------*/
+void* MRIStepCreatePartitioned(ARKRhsFn f, N_Vector fast_mask, sunrealtype t0,
+                               N_Vector y0, SUNContext sunctx)
+{
+  ARKodeMem ark_mem;
+  ARKodeMRIStepMem step_mem;
+  MRIStepPartitionMem P;
+  int retval;
+
+  if (f == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_F);
+    return (NULL);
+  }
+
+  if (y0 == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_Y0);
+    return (NULL);
+  }
+
+  if (fast_mask == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The fast component mask is NULL");
+    return (NULL);
+  }
+
+  if (!sunctx)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_SUNCTX);
+    return (NULL);
+  }
+
+  /* the components are packed through the local data arrays */
+  if (!mriStep_PartitionCheckNVector(y0) ||
+      !mriStep_PartitionCheckNVector(fast_mask) ||
+      N_VGetLength(fast_mask) != N_VGetLength(y0))
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_BAD_NVECTOR);
+    return (NULL);
+  }
+
+  P = mriStep_PartitionCreate(f, fast_mask, t0, y0, sunctx);
+  if (P == NULL) { return (NULL); }
+
+  ark_mem = (ARKodeMem)MRIStepCreate(f, NULL, t0, y0, P->stepper, sunctx);
+  if (ark_mem == NULL)
+  {
+    mriStep_PartitionFree(&P);
+    return (NULL);
+  }
+
+  /* attach the partition memory, which is freed with the MRIStep memory */
+  retval = mriStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS)
+  {
+    mriStep_PartitionFree(&P);
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+  step_mem->partition = P;
+  P->ark_mem          = ark_mem;
+
+  return ((void*)ark_mem);
+}
+
+/*---------------------------------------------------------------
+  MRIStepGetPartitionedInnerMem:
+
+  Returns the ARKStep memory of the packed fast subsystem of an
+  integrator created with MRIStepCreatePartitioned.
+  ---------------------------------------------------------------*/
+int MRIStepGetPartitionedInnerMem(void* arkode_mem, void** inner_arkode_mem)
+{
+  ARKodeMem ark_mem;
+  ARKodeMRIStepMem step_mem;
+  int retval;
+
+  retval = mriStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (step_mem->partition == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The integrator was not created with "
+                    "MRIStepCreatePartitioned");
+    return (ARK_ILL_INPUT);
+  }
+
+  *inner_arkode_mem = step_mem->partition->inner_mem;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Internal functions
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  mriStep_PartitionCheckNVector:
+
+  Returns SUNTRUE if the vector data is stored in a single local
+  array, as required to pack the fast components.
+  ---------------------------------------------------------------*/
+sunbooleantype mriStep_PartitionCheckNVector(N_Vector tmpl)
+{
+  N_Vector_ID id;
+
+  if ((tmpl->ops->nvgetarraypointer == NULL) ||
+      (tmpl->ops->nvgetlength == NULL))
+  {
+    return (SUNFALSE);
+  }
+  id = N_VGetVectorID(tmpl);
+  if ((id != SUNDIALS_NVEC_SERIAL) && (id != SUNDIALS_NVEC_OPENMP) &&
+      (id != SUNDIALS_NVEC_PTHREADS))
+  {
+    return (SUNFALSE);
+  }
+  return (SUNTRUE);
+}
+
+/*---------------------------------------------------------------
+  mriStep_PartitionApplyMask:
+
+  Restricts a slow RHS vector to the slow components.
+  ---------------------------------------------------------------*/
+void mriStep_PartitionApplyMask(MRIStepPartitionMem P, N_Vector F)
+{
+  N_VProd(P->smask, F, F);
+}
+
+/*---------------------------------------------------------------
+  mriStep_PartitionFree:
+
+  Frees the partition memory, including the inner integrator and
+  inner stepper.
+  ---------------------------------------------------------------*/
+void mriStep_PartitionFree(MRIStepPartitionMem* P)
+{
+  if (*P == NULL) { return; }
+
+  if ((*P)->stepper) { MRIStepInnerStepper_Free(&(*P)->stepper); }
+  if ((*P)->inner_mem) { ARKodeFree(&(*P)->inner_mem); }
+  if ((*P)->yf) { N_VDestroy((*P)->yf); }
+  if ((*P)->fmask) { N_VDestroy((*P)->fmask); }
+  if ((*P)->smask) { N_VDestroy((*P)->smask); }
+  if ((*P)->v0) { N_VDestroy((*P)->v0); }
+  if ((*P)->w) { N_VDestroy((*P)->w); }
+  if ((*P)->fw) { N_VDestroy((*P)->fw); }
+  free((*P)->fidx);
+  free((*P)->cvals);
+  free((*P)->Xvecs);
+  free(*P);
+  *P = NULL;
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
@@ -0,0 +1,1067 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * This is the implementation file for ARKODE's parallel
+ * diagonally implicit Runge-Kutta (PDIRK) time stepper module.
+ *
+ * A step performs a fixed number of iterations on a Radau IIA
+ * corrector (van der Houwen and Sommeijer, SIAM J. Sci. Stat.
+ * Comput., 12(5), 1991). In every iteration the s stage systems
+ * only depend on each other through the previous iterate, so
+ * they are independent and are solved concurrently: each stage
+ * has its own Newton iteration, matrix I - h d_i J and
+ * SUNLinearSolver, and the loops over the stages run on OpenMP
+ * threads when ARKODE is built with OpenMP. The right-hand side
+ * and Jacobian functions must then be thread safe.
+ *--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/sundials_context.h>
+#include <sundials/sundials_math.h>
+
+#include "arkode_impl.h"
+#include "arkode_interp_impl.h"
+#include "arkode_pdirkstep_impl.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*===============================================================
+  PDIRK method coefficients
+
+  Each method is given by its Radau IIA corrector (A, c) and the
+  diagonal D of the iteration. The entries of D are chosen so
+  that the iteration matrix for h J -> infinity, I - D^{-1} A, is
+  nilpotent (stiff convergence is then reached after s
+  iterations), taking the root with the smallest spectral radius
+  of the iteration matrix over the left half plane.
+  ===============================================================*/
+
+/* 2-stage Radau IIA (order 3) */
+static const sunrealtype radau2_A[2][2] = {
+  {SUN_RCONST(5.0) / SUN_RCONST(12.0), -ONE / SUN_RCONST(12.0)},
+  {SUN_RCONST(0.75), SUN_RCONST(0.25)}};
+static const sunrealtype radau2_c[2] = {ONE / SUN_RCONST(3.0), SUN_RCONST(1.0)};
+static const sunrealtype radau2_d[2] = {SUN_RCONST(2.5841837620280367e-01),
+                                        SUN_RCONST(6.4494897427831777e-01)};
+
+/* 3-stage Radau IIA (order 5) */
+static const sunrealtype radau3_A[3][3] = {
+  {SUN_RCONST(1.9681547722366041e-01), SUN_RCONST(-6.5535425850198392e-02),
+   SUN_RCONST(2.3770974348220151e-02)},
+  {SUN_RCONST(3.9442431473908729e-01), SUN_RCONST(2.9207341166522849e-01),
+   SUN_RCONST(-4.1548752125997929e-02)},
+  {SUN_RCONST(3.7640306270046725e-01), SUN_RCONST(5.1248582618842164e-01),
+   SUN_RCONST(1.1111111111111111e-01)}};
+static const sunrealtype radau3_c[3] = {SUN_RCONST(1.5505102572168220e-01),
+                                        SUN_RCONST(6.4494897427831777e-01),
+                                        SUN_RCONST(1.0)};
+static const sunrealtype radau3_d[3] = {SUN_RCONST(3.2038277768578094e-01),
+                                        SUN_RCONST(1.3996680467732667e-01),
+                                        SUN_RCONST(3.7166745952291141e-01)};
+
+/*===============================================================
+  Private function prototypes
+  ===============================================================*/
+
+static int pdirkStep_SetupStageMatrices(ARKodeMem ark_mem,
+                                        ARKodePDIRKStepMem step_mem);
+static int pdirkStep_StageSolve(ARKodeMem ark_mem, ARKodePDIRKStepMem step_mem,
+                                int i, long int* nfePtr, long int* nniPtr);
+
+/*===============================================================
+  Exported functions
+  ===============================================================*/
+
+void* PDIRKStepCreate(ARKRhsFn f, sunrealtype t0, N_Vector y0,
+                      SUNContext sunctx)
+{
+  ARKodeMem ark_mem;
+  ARKodePDIRKStepMem step_mem;
+  sunbooleantype nvectorOK;
+  int retval;
+
+  /* Check that f is supplied */
+  if (f == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_F);
+    return (NULL);
+  }
+
+  /* Check for legal input parameters */
+  if (y0 == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_Y0);
+    return (NULL);
+  }
+
+  if (!sunctx)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_SUNCTX);
+    return (NULL);
+  }
+
+  /* Test if all required vector operations are implemented */
+  nvectorOK = pdirkStep_CheckNVector(y0);
+  if (!nvectorOK)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_BAD_NVECTOR);
+    return (NULL);
+  }
+
+  /* Create ark_mem structure and set default values */
+  ark_mem = arkCreate(sunctx);
+  if (ark_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (NULL);
+  }
+
+  /* Allocate ARKodePDIRKStepMem structure, and initialize to zero */
+  step_mem = NULL;
+  step_mem = (ARKodePDIRKStepMem)malloc(sizeof(struct ARKodePDIRKStepMemRec));
+  if (step_mem == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_ARKMEM_FAIL);
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+  memset(step_mem, 0, sizeof(struct ARKodePDIRKStepMemRec));
+
+  /* Attach step_mem structure and function pointers to ark_mem */
+  ark_mem->step_init                      = pdirkStep_Init;
+  ark_mem->step_fullrhs                   = pdirkStep_FullRHS;
+  ark_mem->step                           = pdirkStep_TakeStep;
+  ark_mem->step_printallstats             = pdirkStep_PrintAllStats;
+  ark_mem->step_writeparameters           = pdirkStep_WriteParameters;
+  ark_mem->step_resize                    = pdirkStep_Resize;
+  ark_mem->step_free                      = pdirkStep_Free;
+  ark_mem->step_printmem                  = pdirkStep_PrintMem;
+  ark_mem->step_setdefaults               = pdirkStep_SetDefaults;
+  ark_mem->step_setnonlincrdown           = pdirkStep_SetNonlinCRDown;
+  ark_mem->step_setnonlinrdiv             = pdirkStep_SetNonlinRDiv;
+  ark_mem->step_setmaxnonliniters         = pdirkStep_SetMaxNonlinIters;
+  ark_mem->step_setnonlinconvcoef         = pdirkStep_SetNonlinConvCoef;
+  ark_mem->step_getnumlinsolvsetups       = pdirkStep_GetNumLinSolvSetups;
+  ark_mem->step_getnumnonlinsolviters     = pdirkStep_GetNumNonlinSolvIters;
+  ark_mem->step_getnumnonlinsolvconvfails = pdirkStep_GetNumNonlinSolvConvFails;
+  ark_mem->step_getnonlinsolvstats        = pdirkStep_GetNonlinSolvStats;
+  ark_mem->step_getestlocalerrors         = pdirkStep_GetEstLocalErrors;
+  ark_mem->step_supports_adaptive         = SUNTRUE;
+  ark_mem->step_supports_implicit         = SUNTRUE;
+  ark_mem->step_mem                       = (void*)step_mem;
+
+  /* Set default values for optional inputs */
+  retval = pdirkStep_SetDefaults((void*)ark_mem);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Error setting default solver options");
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+
+  /* Copy the input parameters into ARKODE state */
+  step_mem->f = f;
+
+  /* Update the ARKODE workspace requirements */
+  ark_mem->liw += 22; /* fcn ptrs, ints, long ints */
+  ark_mem->lrw += 20;
+
+  /* Initialize all the counters */
+  step_mem->nfe     = 0;
+  step_mem->nje     = 0;
+  step_mem->nsetups = 0;
+  step_mem->nni     = 0;
+  step_mem->nncf    = 0;
+  step_mem->nstlj   = 0;
+
+  /* Initialize main ARKODE infrastructure */
+  retval = arkInit(ark_mem, t0, y0, FIRST_INIT);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Unable to initialize main ARKODE infrastructure");
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+
+  return ((void*)ark_mem);
+}
+
+/*---------------------------------------------------------------
+  PDIRKStepReInit:
+
+  This routine re-initializes the PDIRKStep module to solve a new
+  problem of the same size as was previously solved. This routine
+  should also be called when the problem dynamics or desired solvers
+  have changed dramatically, so that the problem integration should
+  resume as if started from scratch.
+
+  Note all internal counters are set to 0 on re-initialization.
+  ---------------------------------------------------------------*/
+int PDIRKStepReInit(void* arkode_mem, ARKRhsFn f, sunrealtype t0, N_Vector y0)
+{
+  ARKodeMem ark_mem;
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Check if ark_mem was allocated */
+  if (ark_mem->MallocDone == SUNFALSE)
+  {
+    arkProcessError(ark_mem, ARK_NO_MALLOC, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MALLOC);
+    return (ARK_NO_MALLOC);
+  }
+
+  /* Check that f is supplied */
+  if (f == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_F);
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Check for legal input parameters */
+  if (y0 == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_Y0);
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Copy the input parameters into ARKODE state */
+  step_mem->f = f;
+
+  /* Initialize main ARKODE infrastructure */
+  retval = arkInit(arkode_mem, t0, y0, FIRST_INIT);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Unable to initialize main ARKODE infrastructure");
+    return (retval);
+  }
+
+  /* Initialize all the counters */
+  step_mem->nfe     = 0;
+  step_mem->nje     = 0;
+  step_mem->nsetups = 0;
+  step_mem->nni     = 0;
+  step_mem->nncf    = 0;
+  step_mem->nstlj   = 0;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Interface routines supplied to ARKODE
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  pdirkStep_Resize:
+
+  This routine resizes the stage vectors (if allocated). The
+  per-stage matrices and linear solvers are owned by the user and
+  must be replaced with PDIRKStepSetLinearSolvers.
+  ---------------------------------------------------------------*/
+int pdirkStep_Resize(ARKodeMem ark_mem, N_Vector y0,
+                     SUNDIALS_MAYBE_UNUSED sunrealtype hscale,
+                     SUNDIALS_MAYBE_UNUSED sunrealtype t0,
+                     ARKVecResizeFn resize, void* resize_data)
+{
+  ARKodePDIRKStepMem step_mem;
+  sunindextype lrw1, liw1, lrw_diff, liw_diff;
+  N_Vector** vecs[6];
+  int retval, k;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Determine change in vector sizes */
+  lrw1 = liw1 = 0;
+  if (y0->ops->nvspace != NULL) { N_VSpace(y0, &lrw1, &liw1); }
+  lrw_diff      = lrw1 - ark_mem->lrw1;
+  liw_diff      = liw1 - ark_mem->liw1;
+  ark_mem->lrw1 = lrw1;
+  ark_mem->liw1 = liw1;
+
+  /* Resize the stage vectors */
+  vecs[0] = &step_mem->Y;
+  vecs[1] = &step_mem->F;
+  vecs[2] = &step_mem->Fold;
+  vecs[3] = &step_mem->Z;
+  vecs[4] = &step_mem->res;
+  vecs[5] = &step_mem->delta;
+  for (k = 0; k < 6; k++)
+  {
+    if (*vecs[k] == NULL) { continue; }
+    if (!arkResizeVecArray(resize, resize_data, step_mem->vec_alloc, y0,
+                           vecs[k], lrw_diff, &ark_mem->lrw, liw_diff,
+                           &ark_mem->liw))
+    {
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      "Unable to resize vector");
+      return (ARK_MEM_FAIL);
+    }
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_Free frees all PDIRKStep memory.
+  ---------------------------------------------------------------*/
+void pdirkStep_Free(ARKodeMem ark_mem)
+{
+  ARKodePDIRKStepMem step_mem;
+  N_Vector** vecs[6];
+  int k;
+
+  /* nothing to do if ark_mem is already NULL */
+  if (ark_mem == NULL) { return; }
+
+  /* conditional frees on non-NULL PDIRKStep module */
+  if (ark_mem->step_mem != NULL)
+  {
+    step_mem = (ARKodePDIRKStepMem)ark_mem->step_mem;
+
+    /* free the stage vectors */
+    vecs[0] = &step_mem->Y;
+    vecs[1] = &step_mem->F;
+    vecs[2] = &step_mem->Fold;
+    vecs[3] = &step_mem->Z;
+    vecs[4] = &step_mem->res;
+    vecs[5] = &step_mem->delta;
+    for (k = 0; k < 6; k++)
+    {
+      arkFreeVecArray(step_mem->vec_alloc, vecs[k], ark_mem->lrw1,
+                      &ark_mem->lrw, ark_mem->liw1, &ark_mem->liw);
+    }
+    step_mem->vec_alloc = 0;
+
+    /* free the saved Jacobian (the stage solvers belong to the user) */
+    if (step_mem->J != NULL)
+    {
+      SUNMatDestroy(step_mem->J);
+      step_mem->J = NULL;
+    }
+
+    /* free the time stepper module itself */
+    free(ark_mem->step_mem);
+    ark_mem->step_mem = NULL;
+  }
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_PrintMem:
+
+  This routine outputs the memory from the PDIRKStep structure to
+  a specified file pointer (useful when debugging).
+  ---------------------------------------------------------------*/
+void pdirkStep_PrintMem(ARKodeMem ark_mem, FILE* outfile)
+{
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return; }
+
+  /* output integer quantities */
+  fprintf(outfile, "PDIRKStep: method = %i\n", (int)step_mem->method);
+  fprintf(outfile, "PDIRKStep: stages = %i\n", step_mem->stages);
+  fprintf(outfile, "PDIRKStep: niters = %i\n", step_mem->niters);
+  fprintf(outfile, "PDIRKStep: q = %i\n", step_mem->q);
+  fprintf(outfile, "PDIRKStep: p = %i\n", step_mem->p);
+  fprintf(outfile, "PDIRKStep: maxcor = %i\n", step_mem->maxcor);
+  fprintf(outfile, "PDIRKStep: nthreads = %i\n", step_mem->nthreads);
+  fprintf(outfile, "PDIRKStep: jcur = %i\n", step_mem->jcur);
+
+  /* output long integer quantities */
+  fprintf(outfile, "PDIRKStep: msbj = %li\n", step_mem->msbj);
+  fprintf(outfile, "PDIRKStep: nstlj = %li\n", step_mem->nstlj);
+  fprintf(outfile, "PDIRKStep: nfe = %li\n", step_mem->nfe);
+  fprintf(outfile, "PDIRKStep: nje = %li\n", step_mem->nje);
+  fprintf(outfile, "PDIRKStep: nsetups = %li\n", step_mem->nsetups);
+  fprintf(outfile, "PDIRKStep: nni = %li\n", step_mem->nni);
+  fprintf(outfile, "PDIRKStep: nncf = %li\n", step_mem->nncf);
+
+  /* output sunrealtype quantities */
+  fprintf(outfile, "PDIRKStep: hsetup = %" RSYM "\n", step_mem->hsetup);
+  fprintf(outfile, "PDIRKStep: nlscoef = %" RSYM "\n", step_mem->nlscoef);
+  fprintf(outfile, "PDIRKStep: crdown = %" RSYM "\n", step_mem->crdown);
+  fprintf(outfile, "PDIRKStep: rdiv = %" RSYM "\n", step_mem->rdiv);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_Init:
+
+  This routine is called just prior to performing internal time
+  steps (after all user "set" routines have been called) from
+  within arkInitialSetup.
+
+  With initialization type FIRST_INIT this routine:
+  - sets the method coefficients and orders
+  - checks that a Jacobian function and one matrix-based direct
+    linear solver per stage have been attached
+  - limits the interpolant degree by the method order
+  - allocates the saved Jacobian and the stage vectors
+  - sets the call_fullrhs flag
+
+  With initialization types FIRST_INIT or RESIZE_INIT, this
+  routine initializes the stage linear solvers. With all
+  initialization types the next step reevaluates the Jacobian.
+  ---------------------------------------------------------------*/
+int pdirkStep_Init(ARKodeMem ark_mem, int init_type)
+{
+  ARKodePDIRKStepMem step_mem;
+  N_Vector** vecs[6];
+  int retval, i, k;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* force a Jacobian evaluation in the next step */
+  step_mem->jbad   = SUNTRUE;
+  step_mem->hsetup = ZERO;
+
+  /* immediately return if reset */
+  if (init_type == RESET_INIT) { return (ARK_SUCCESS); }
+
+  /* initializations/checks for (re-)initialization call */
+  if (init_type == FIRST_INIT)
+  {
+    /* Set the method coefficients and orders */
+    retval = pdirkStep_SetMethodProperties(ark_mem);
+    if (retval != ARK_SUCCESS) { return (retval); }
+
+    /* the stages require a Jacobian and a linear solver each */
+    if (step_mem->jac == NULL)
+    {
+      arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSG_PDIRKSTEP_NO_JAC);
+      return (ARK_ILL_INPUT);
+    }
+    if (step_mem->nls < step_mem->stages)
+    {
+      arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSG_PDIRKSTEP_NO_LS);
+      return (ARK_ILL_INPUT);
+    }
+
+    /* Override the interpolant degree (if needed), used in arkInitialSetup */
+    if (step_mem->q > 1 && ark_mem->interp_degree > (step_mem->q - 1))
+    {
+      /* Limit max degree to at most one less than the method global order */
+      ark_mem->interp_degree = step_mem->q - 1;
+    }
+
+    /* Allocate the saved Jacobian (if needed) */
+    if (step_mem->J == NULL)
+    {
+      step_mem->J = SUNMatClone(step_mem->Amat[0]);
+      if (step_mem->J == NULL)
+      {
+        arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                        "A memory request failed.");
+        return (ARK_MEM_FAIL);
+      }
+    }
+
+    /* Allocate the stage vectors (if needed) */
+    vecs[0] = &step_mem->Y;
+    vecs[1] = &step_mem->F;
+    vecs[2] = &step_mem->Fold;
+    vecs[3] = &step_mem->Z;
+    vecs[4] = &step_mem->res;
+    vecs[5] = &step_mem->delta;
+    if ((step_mem->Y != NULL) && (step_mem->vec_alloc < step_mem->stages))
+    {
+      for (k = 0; k < 6; k++)
+      {
+        arkFreeVecArray(step_mem->vec_alloc, vecs[k], ark_mem->lrw1,
+                        &ark_mem->lrw, ark_mem->liw1, &ark_mem->liw);
+      }
+      step_mem->vec_alloc = 0;
+    }
+    if (step_mem->Y == NULL)
+    {
+      for (k = 0; k < 6; k++)
+      {
+        if (!arkAllocVecArray(step_mem->stages, ark_mem->ewt, vecs[k],
+                              ark_mem->lrw1, &ark_mem->lrw, ark_mem->liw1,
+                              &ark_mem->liw))
+        {
+          return (ARK_MEM_FAIL);
+        }
+      }
+      step_mem->vec_alloc = step_mem->stages;
+    }
+
+    /* Signal to shared arkode module that full RHS evaluations are required */
+    ark_mem->call_fullrhs = SUNTRUE;
+  }
+
+  /* Initialize the stage linear solvers */
+  for (i = 0; i < step_mem->stages; i++)
+  {
+    retval = SUNLinSolInitialize(step_mem->LS[i]);
+    if (retval != SUN_SUCCESS)
+    {
+      arkProcessError(ark_mem, ARK_LINIT_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_LINIT_FAIL);
+      return (ARK_LINIT_FAIL);
+    }
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*------------------------------------------------------------------------------
+  pdirkStep_FullRHS:
+
+  This is just a wrapper to call the user-supplied RHS function, f(t,y). The
+  RHS is evaluated in every mode.
+  ----------------------------------------------------------------------------*/
+int pdirkStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
+                      int mode)
+{
+  int retval;
+  ARKodePDIRKStepMem step_mem;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* perform RHS functions contingent on 'mode' argument */
+  switch (mode)
+  {
+  case ARK_FULLRHS_START:
+  case ARK_FULLRHS_END:
+  case ARK_FULLRHS_OTHER:
+
+    /* call f */
+    retval = step_mem->f(t, y, f, ark_mem->user_data);
+    step_mem->nfe++;
+    if (retval != 0)
+    {
+      arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_RHSFUNC_FAILED, t);
+      return (ARK_RHSFUNC_FAIL);
+    }
+
+    break;
+
+  default:
+    /* return with RHS failure if unknown mode is passed */
+    arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                    "Unknown full RHS mode");
+    return (ARK_RHSFUNC_FAIL);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_TakeStep:
+
+  This routine performs a single PDIRK step. Starting from the
+  predictor Y_i = yn, F_i = f(tn, yn), each of the niters
+  iterations solves the s independent stage systems
+
+    Y_i - h d_i f(tn + c_i h, Y_i) = yn + h sum_j a_ij F_j
+                                        - h d_i F_i,
+
+  with F the right-hand side values of the previous iterate, and
+  the solution and error estimate are given by the last stage
+  (the corrector is stiffly accurate),
+
+    y = Y_s,   yerr = Y_s - Y_s(previous iterate).
+
+  The Jacobian is evaluated at (tn, yn) in the first step, every
+  msbj steps, and after a stage solve failure with an out of date
+  Jacobian; the stage matrices I - h d_i J are set up whenever J
+  or h changed. Both the stage matrix setups and the stage solves
+  are distributed over nthreads OpenMP threads. The vector tempv1
+  holds the error estimate, and tempv1-tempv3 are the work
+  vectors of the Jacobian function.
+
+  The output variable dsmPtr should contain estimate of the
+  weighted local error if an embedding is present; otherwise it
+  should be 0.
+
+  The input/output variable nflagPtr is used to gauge failures of
+  the stage solves. On failure it is set to the failure flag of
+  the stage solves and TRY_AGAIN is returned, so that ARKODE
+  retries the step with a smaller step size (if recoverable).
+
+  The return value from this routine is:
+            0 => step completed successfully
+           >0 => step encountered recoverable failure;
+                 reduce step and retry (if possible)
+           <0 => step encountered unrecoverable failure
+  ---------------------------------------------------------------*/
+int pdirkStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr)
+{
+  int retval, i, k, s;
+  long int nfe, nni;
+  sunbooleantype evalJ;
+  N_Vector* Ftmp;
+  ARKodePDIRKStepMem step_mem;
+
+  /* initialize output */
+  *dsmPtr = ZERO;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+  s = step_mem->stages;
+
+  /* Decide whether to reevaluate the Jacobian */
+  evalJ = (step_mem->jbad) || (step_mem->msbj < 0) ||
+          (ark_mem->nst >= step_mem->nstlj + labs(step_mem->msbj)) ||
+          ((*nflagPtr == PREV_CONV_FAIL) && !(step_mem->jcur));
+
+  /* initialize the stage solve failure flag to success */
+  *nflagPtr = ARK_SUCCESS;
+
+  /* The RHS at the start of the step may need to be computed (possibly
+     already computed by ARKODE) */
+  if (!(ark_mem->fn_is_current))
+  {
+    retval = ark_mem->step_fullrhs(ark_mem, ark_mem->tn, ark_mem->yn,
+                                   ark_mem->fn, ARK_FULLRHS_START);
+    if (retval) { return ARK_RHSFUNC_FAIL; }
+    ark_mem->fn_is_current = SUNTRUE;
+  }
+
+  /* Evaluate J at (tn, yn) */
+  step_mem->jcur = SUNFALSE;
+  if (evalJ)
+  {
+    retval = SUNMatZero(step_mem->J);
+    if (retval != SUN_SUCCESS) { return (ARK_LSETUP_FAIL); }
+    retval = step_mem->jac(ark_mem->tn, ark_mem->yn, ark_mem->fn, step_mem->J,
+                           ark_mem->user_data, ark_mem->tempv1,
+                           ark_mem->tempv2, ark_mem->tempv3);
+    step_mem->nje++;
+    if (retval < 0) { return (ARK_LSETUP_FAIL); }
+    if (retval > 0)
+    {
+      *nflagPtr = CONV_FAIL;
+      return (TRY_AGAIN);
+    }
+    step_mem->jbad   = SUNFALSE;
+    step_mem->jcur   = SUNTRUE;
+    step_mem->nstlj  = ark_mem->nst;
+    step_mem->hsetup = ZERO;
+  }
+
+  /* Set up the stage matrices I - h d_i J */
+  if (step_mem->hsetup != ark_mem->h)
+  {
+    *nflagPtr = pdirkStep_SetupStageMatrices(ark_mem, step_mem);
+    if (*nflagPtr != ARK_SUCCESS) { return (TRY_AGAIN); }
+  }
+
+  /* Predictor: Y_i = yn, F_i = f(tn, yn) */
+  for (i = 0; i < s; i++)
+  {
+    N_VScale(ONE, ark_mem->yn, step_mem->Y[i]);
+    N_VScale(ONE, ark_mem->fn, step_mem->F[i]);
+  }
+
+  /* Corrector iterations */
+  for (k = 1; k <= step_mem->niters; k++)
+  {
+    /* the last iterate values become the old ones */
+    Ftmp           = step_mem->Fold;
+    step_mem->Fold = step_mem->F;
+    step_mem->F    = Ftmp;
+
+    /* save the previous value of the last stage for the error estimate */
+    if ((k == step_mem->niters) && !(ark_mem->fixedstep))
+    {
+      N_VScale(ONE, step_mem->Y[s - 1], ark_mem->tempv1);
+    }
+
+    /* solve the stage systems concurrently */
+    retval = ARK_SUCCESS;
+    nfe    = 0;
+    nni    = 0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(step_mem->nthreads) schedule(dynamic) \
+  reduction(+ : nfe, nni)
+#endif
+    for (i = 0; i < s; i++)
+    {
+      long int nfel = 0, nnil = 0;
+      int ier;
+
+      ier = pdirkStep_StageSolve(ark_mem, step_mem, i, &nfel, &nnil);
+      nfe += nfel;
+      nni += nnil;
+
+      if (ier != ARK_SUCCESS)
+      {
+#ifdef _OPENMP
+#pragma omp critical(pdirkStep_TakeStep)
+#endif
+        {
+          if ((retval == ARK_SUCCESS) || (ier < 0 && retval > 0))
+          {
+            retval = ier;
+          }
+        }
+      }
+    }
+
+    /* update the counters */
+    step_mem->nfe += nfe;
+    step_mem->nni += nni;
+
+    /* return with a failure to retry the step (if recoverable) */
+    if (retval != ARK_SUCCESS)
+    {
+      if (retval > 0) { step_mem->nncf++; }
+      *nflagPtr = retval;
+      return (TRY_AGAIN);
+    }
+  }
+
+  /* y = Y_s */
+  ark_mem->tcur = ark_mem->tn + ark_mem->h;
+  N_VScale(ONE, step_mem->Y[s - 1], ark_mem->ycur);
+
+  /* Compute yerr and the error norm (if step adaptivity enabled) */
+  if (!ark_mem->fixedstep)
+  {
+    N_VLinearSum(ONE, step_mem->Y[s - 1], -ONE, ark_mem->tempv1,
+                 ark_mem->tempv1);
+    *dsmPtr = N_VWrmsNorm(ark_mem->tempv1, ark_mem->ewt);
+  }
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
+  SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
+                     "ARKODE::pdirkStep_TakeStep", "error-test",
+                     "step = %li, h = %" RSYM ", dsm = %" RSYM ", jeval = %i",
+                     ark_mem->nst, ark_mem->h, *dsmPtr, (int)evalJ);
+#endif
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Internal utility routines
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  pdirkStep_AccessARKODEStepMem:
+
+  Shortcut routine to unpack both ark_mem and step_mem structures
+  from void* pointer.  If either is missing it returns ARK_MEM_NULL.
+  ---------------------------------------------------------------*/
+int pdirkStep_AccessARKODEStepMem(void* arkode_mem, const char* fname,
+                                  ARKodeMem* ark_mem,
+                                  ARKodePDIRKStepMem* step_mem)
+{
+  /* access ARKodeMem structure */
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *ark_mem = (ARKodeMem)arkode_mem;
+
+  /* access ARKodePDIRKStepMem structure */
+  if ((*ark_mem)->step_mem == NULL)
+  {
+    arkProcessError(*ark_mem, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_PDIRKSTEP_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *step_mem = (ARKodePDIRKStepMem)(*ark_mem)->step_mem;
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_AccessStepMem:
+
+  Shortcut routine to unpack the step_mem structure from
+  ark_mem.  If missing it returns ARK_MEM_NULL.
+  ---------------------------------------------------------------*/
+int pdirkStep_AccessStepMem(ARKodeMem ark_mem, const char* fname,
+                            ARKodePDIRKStepMem* step_mem)
+{
+  /* access ARKodePDIRKStepMem structure */
+  if (ark_mem->step_mem == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_PDIRKSTEP_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *step_mem = (ARKodePDIRKStepMem)ark_mem->step_mem;
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_CheckNVector:
+
+  This routine checks if all required vector operations are
+  present.  If any of them is missing it returns SUNFALSE.
+  ---------------------------------------------------------------*/
+sunbooleantype pdirkStep_CheckNVector(N_Vector tmpl)
+{
+  if ((tmpl->ops->nvclone == NULL) || (tmpl->ops->nvdestroy == NULL) ||
+      (tmpl->ops->nvlinearsum == NULL) || (tmpl->ops->nvconst == NULL) ||
+      (tmpl->ops->nvscale == NULL) || (tmpl->ops->nvwrmsnorm == NULL))
+  {
+    return (SUNFALSE);
+  }
+  return (SUNTRUE);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_SetMethodProperties:
+
+  This routine sets the coefficients, number of stages and
+  corrector order of the selected method, the number of
+  iterations per step (by default equal to the corrector order),
+  and the resulting method and embedding orders (also in the
+  adaptivity module). Starting from the first order predictor,
+  every iteration raises the order by one up to the corrector
+  order, so q = min(pstar, niters) and p = q - 1.
+  ---------------------------------------------------------------*/
+int pdirkStep_SetMethodProperties(ARKodeMem ark_mem)
+{
+  ARKodePDIRKStepMem step_mem;
+  int retval, i, j;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  for (i = 0; i < PDIRK_MAX_STAGES; i++)
+  {
+    step_mem->c[i] = step_mem->d[i] = ZERO;
+    for (j = 0; j < PDIRK_MAX_STAGES; j++) { step_mem->A[i][j] = ZERO; }
+  }
+
+  /* Set the coefficients of the selected method */
+  switch (step_mem->method)
+  {
+  case ARKODE_PDIRK_RADAU_2_3:
+    step_mem->stages = 2;
+    step_mem->pstar  = 3;
+    for (i = 0; i < 2; i++)
+    {
+      step_mem->c[i] = radau2_c[i];
+      step_mem->d[i] = radau2_d[i];
+      for (j = 0; j < 2; j++) { step_mem->A[i][j] = radau2_A[i][j]; }
+    }
+    break;
+  case ARKODE_PDIRK_RADAU_3_5:
+    step_mem->stages = 3;
+    step_mem->pstar  = 5;
+    for (i = 0; i < 3; i++)
+    {
+      step_mem->c[i] = radau3_c[i];
+      step_mem->d[i] = radau3_d[i];
+      for (j = 0; j < 3; j++) { step_mem->A[i][j] = radau3_A[i][j]; }
+    }
+    break;
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid PDIRK method type");
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Set the number of iterations and the orders */
+  step_mem->niters = (step_mem->niters_user > 0) ? step_mem->niters_user
+                                                 : step_mem->pstar;
+  step_mem->q      = SUNMIN(step_mem->pstar, step_mem->niters);
+  step_mem->p      = step_mem->q - 1;
+
+  /* Set the method and embedding orders in the adaptivity module */
+  ark_mem->hadapt_mem->q = step_mem->q;
+  ark_mem->hadapt_mem->p = step_mem->p;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_SetupStageMatrices:
+
+  This routine forms the stage matrices A_i = I - h d_i J from
+  the saved Jacobian and calls the setup routine of the stage
+  linear solvers, distributing the stages over the OpenMP
+  threads. It returns ARK_SUCCESS, CONV_FAIL if a solver setup
+  failed recoverably (e.g., a singular matrix), or
+  ARK_LSETUP_FAIL.
+  ---------------------------------------------------------------*/
+static int pdirkStep_SetupStageMatrices(ARKodeMem ark_mem,
+                                        ARKodePDIRKStepMem step_mem)
+{
+  int i, retval;
+
+  retval = ARK_SUCCESS;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(step_mem->nthreads) schedule(dynamic)
+#endif
+  for (i = 0; i < step_mem->stages; i++)
+  {
+    int ier;
+
+    ier = SUNMatCopy(step_mem->J, step_mem->Amat[i]);
+    if (ier == SUN_SUCCESS)
+    {
+      ier = SUNMatScaleAddI(-ark_mem->h * step_mem->d[i], step_mem->Amat[i]);
+    }
+    if (ier == SUN_SUCCESS)
+    {
+      ier = SUNLinSolSetup(step_mem->LS[i], step_mem->Amat[i]);
+      if (ier > 0) { ier = CONV_FAIL; }
+    }
+    if (ier < 0) { ier = ARK_LSETUP_FAIL; }
+
+    if (ier != ARK_SUCCESS)
+    {
+#ifdef _OPENMP
+#pragma omp critical(pdirkStep_SetupStageMatrices)
+#endif
+      {
+        if ((retval == ARK_SUCCESS) || (ier < 0 && retval > 0))
+        {
+          retval = ier;
+        }
+      }
+    }
+  }
+
+  step_mem->nsetups += step_mem->stages;
+  step_mem->hsetup = (retval == ARK_SUCCESS) ? ark_mem->h : ZERO;
+
+  return (retval);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_StageSolve:
+
+  This routine solves the system of stage i in the current
+  corrector iteration with a modified Newton iteration, starting
+  from the previous iterate Y_i and F_i = Fold_i. It only touches
+  the vectors, linear solver and matrix of stage i, so it may be
+  called concurrently for different stages. The Newton iteration
+  uses the convergence test of ARKStep: with del the norm of the
+  Newton update and crate the estimated convergence rate, the
+  iteration has converged when del * min(1, crate) <= nlscoef.
+  On exit F_i holds f at the new Y_i.
+
+  The numbers of RHS evaluations and Newton iterations are
+  returned in nfePtr and nniPtr. The return value is
+  ARK_SUCCESS, CONV_FAIL, RHSFUNC_RECVR, ARK_LSOLVE_FAIL, or
+  ARK_RHSFUNC_FAIL; no error is reported here, since the routine
+  may run on several threads.
+  ---------------------------------------------------------------*/
+static int pdirkStep_StageSolve(ARKodeMem ark_mem, ARKodePDIRKStepMem step_mem,
+                                int i, long int* nfePtr, long int* nniPtr)
+{
+  int retval, j, nvec, m;
+  sunrealtype h, hd, ti, del, delp, crate, dcon;
+  sunrealtype* cvals;
+  N_Vector* Xvecs;
+
+  h     = ark_mem->h;
+  hd    = h * step_mem->d[i];
+  ti    = ark_mem->tn + step_mem->c[i] * h;
+  cvals = step_mem->cvals[i];
+  Xvecs = step_mem->Xvecs[i];
+
+  /* Z_i = yn + h sum_j a_ij Fold_j - h d_i Fold_i (skipping zeros) */
+  nvec        = 0;
+  cvals[nvec] = ONE;
+  Xvecs[nvec] = ark_mem->yn;
+  nvec++;
+  for (j = 0; j < step_mem->stages; j++)
+  {
+    cvals[nvec] = h * step_mem->A[i][j];
+    if (j == i) { cvals[nvec] -= hd; }
+    if (cvals[nvec] == ZERO) { continue; }
+    Xvecs[nvec] = step_mem->Fold[j];
+    nvec++;
+  }
+  retval = N_VLinearCombination(nvec, cvals, Xvecs, step_mem->Z[i]);
+  if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+  /* f at the initial Newton iterate */
+  N_VScale(ONE, step_mem->Fold[i], step_mem->F[i]);
+
+  /* Newton iteration */
+  crate = ONE;
+  delp  = ZERO;
+  for (m = 0;; m++)
+  {
+    /* residual Z_i - Y_i + h d_i F_i and Newton update */
+    cvals[0] = ONE;
+    Xvecs[0] = step_mem->Z[i];
+    cvals[1] = -ONE;
+    Xvecs[1] = step_mem->Y[i];
+    cvals[2] = hd;
+    Xvecs[2] = step_mem->F[i];
+    retval   = N_VLinearCombination(3, cvals, Xvecs, step_mem->res[i]);
+    if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+    retval = SUNLinSolSolve(step_mem->LS[i], step_mem->Amat[i],
+                            step_mem->delta[i], step_mem->res[i], ZERO);
+    (*nniPtr)++;
+    if (retval < 0) { return (ARK_LSOLVE_FAIL); }
+    if (retval > 0) { return (CONV_FAIL); }
+
+    N_VLinearSum(ONE, step_mem->Y[i], ONE, step_mem->delta[i], step_mem->Y[i]);
+    del = N_VWrmsNorm(step_mem->delta[i], ark_mem->ewt);
+
+    /* f at the updated stage */
+    retval = step_mem->f(ti, step_mem->Y[i], step_mem->F[i], ark_mem->user_data);
+    (*nfePtr)++;
+    if (retval < 0) { return (ARK_RHSFUNC_FAIL); }
+    if (retval > 0) { return (RHSFUNC_RECVR); }
+
+    /* convergence and divergence tests */
+    if (m > 0) { crate = SUNMAX(step_mem->crdown * crate, del / delp); }
+    dcon = del * SUNMIN(ONE, crate) / step_mem->nlscoef;
+    if (dcon <= ONE) { return (ARK_SUCCESS); }
+    if (m + 1 >= step_mem->maxcor) { return (CONV_FAIL); }
+    if ((m > 0) && (del > step_mem->rdiv * delp)) { return (CONV_FAIL); }
+    delp = del;
+  }
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
@@ -0,0 +1,171 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * Implementation header file for ARKODE's parallel diagonally
+ * implicit Runge-Kutta (PDIRK) time stepper module.
+ *--------------------------------------------------------------*/
+
+#ifndef _ARKODE_PDIRKSTEP_IMPL_H
+#define _ARKODE_PDIRKSTEP_IMPL_H
+
+#include <arkode/arkode_pdirkstep.h>
+
+#include "arkode_impl.h"
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*===============================================================
+  PDIRK time step module constants
+  ===============================================================*/
+
+/* default method and maximum number of stages */
+#define PDIRK_DEFAULT_METHOD ARKODE_PDIRK_RADAU_3_5
+#define PDIRK_MAX_STAGES     3
+
+/* max no. of steps between Jacobian evaluations */
+#define PDIRK_MSBJ 20
+
+/* stage Newton iteration parameters (as in ARKStep) */
+#define PDIRK_NLSCOEF SUN_RCONST(0.1)
+#define PDIRK_MAXCOR  3
+#define PDIRK_CRDOWN  SUN_RCONST(0.3)
+#define PDIRK_RDIV    SUN_RCONST(2.3)
+
+/*===============================================================
+  PDIRK time step module data structure
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  Types : struct ARKodePDIRKStepMemRec, ARKodePDIRKStepMem
+  ---------------------------------------------------------------
+  The type ARKodePDIRKStepMem is type pointer to struct
+  ARKodePDIRKStepMemRec.  This structure contains fields to
+  perform a PDIRK time step: a fixed number of iterations on a
+  Radau IIA corrector, in which the stage systems are decoupled
+  by the diagonal matrix D and solved concurrently, each one with
+  its own matrix I - h d_i J and linear solver.
+  ---------------------------------------------------------------*/
+typedef struct ARKodePDIRKStepMemRec
+{
+  /* PDIRK problem specification */
+  ARKRhsFn f;     /* y' = f(t,y)                */
+  ARKLsJacFn jac; /* Jacobian of f              */
+
+  /* PDIRK method */
+  ARKODE_PDIRKMethodType method; /* corrector type             */
+  int stages;                    /* number of stages           */
+  int pstar;                     /* corrector order            */
+  int niters;                    /* iterations per step        */
+  int niters_user;               /* user iterations (0 = def.) */
+  int q;                         /* method order               */
+  int p;                         /* embedding order            */
+  sunrealtype A[PDIRK_MAX_STAGES][PDIRK_MAX_STAGES]; /* corrector coeffs  */
+  sunrealtype c[PDIRK_MAX_STAGES];                   /* stage times       */
+  sunrealtype d[PDIRK_MAX_STAGES];                   /* diagonal of D     */
+
+  /* PDIRK stage vectors */
+  N_Vector* Y;     /* stage states                      */
+  N_Vector* F;     /* f at the current stage iterates   */
+  N_Vector* Fold;  /* f at the previous stage iterates  */
+  N_Vector* Z;     /* right-hand sides of stage systems */
+  N_Vector* res;   /* Newton residuals                  */
+  N_Vector* delta; /* Newton updates                    */
+  int vec_alloc;   /* number of allocated stage vectors */
+
+  /* Per-stage linear solvers and matrices (owned by the user) */
+  int nls;                            /* number of attached solvers */
+  SUNLinearSolver LS[PDIRK_MAX_STAGES];
+  SUNMatrix Amat[PDIRK_MAX_STAGES];
+  SUNMatrix J;                        /* saved Jacobian             */
+
+  /* Jacobian and stage matrix heuristics */
+  sunbooleantype jbad; /* Jacobian must be reevaluated     */
+  sunbooleantype jcur; /* Jacobian is current              */
+  long int msbj;       /* max steps between J evaluations  */
+  long int nstlj;      /* step of the last J evaluation    */
+  sunrealtype hsetup;  /* step size of the stage matrices  */
+
+  /* Newton parameters */
+  sunrealtype nlscoef; /* convergence test coefficient     */
+  int maxcor;          /* max Newton iterations            */
+  sunrealtype crdown;  /* convergence rate constant        */
+  sunrealtype rdiv;    /* divergence test constant         */
+
+  /* Number of OpenMP threads for the stage loops */
+  int nthreads;
+
+  /* Counters */
+  long int nfe;     /* num f calls                      */
+  long int nje;     /* num Jacobian evaluations         */
+  long int nsetups; /* num stage matrix setups          */
+  long int nni;     /* num Newton iterations            */
+  long int nncf;    /* num stage Newton failures        */
+
+  /* Reusable arrays for fused vector operations (one row per stage) */
+  sunrealtype cvals[PDIRK_MAX_STAGES][PDIRK_MAX_STAGES + 1];
+  N_Vector Xvecs[PDIRK_MAX_STAGES][PDIRK_MAX_STAGES + 1];
+
+}* ARKodePDIRKStepMem;
+
+/*===============================================================
+  PDIRK time step module private function prototypes
+  ===============================================================*/
+
+/* Interface routines supplied to ARKODE */
+int pdirkStep_Init(ARKodeMem ark_mem, int init_type);
+int pdirkStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
+                      int mode);
+int pdirkStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr);
+int pdirkStep_SetDefaults(ARKodeMem ark_mem);
+int pdirkStep_SetNonlinCRDown(ARKodeMem ark_mem, sunrealtype crdown);
+int pdirkStep_SetNonlinRDiv(ARKodeMem ark_mem, sunrealtype rdiv);
+int pdirkStep_SetMaxNonlinIters(ARKodeMem ark_mem, int maxcor);
+int pdirkStep_SetNonlinConvCoef(ARKodeMem ark_mem, sunrealtype nlscoef);
+int pdirkStep_GetNumLinSolvSetups(ARKodeMem ark_mem, long int* nlinsetups);
+int pdirkStep_GetNumNonlinSolvIters(ARKodeMem ark_mem, long int* nniters);
+int pdirkStep_GetNumNonlinSolvConvFails(ARKodeMem ark_mem, long int* nnfails);
+int pdirkStep_GetNonlinSolvStats(ARKodeMem ark_mem, long int* nniters,
+                                 long int* nnfails);
+int pdirkStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile,
+                            SUNOutputFormat fmt);
+int pdirkStep_WriteParameters(ARKodeMem ark_mem, FILE* fp);
+int pdirkStep_Resize(ARKodeMem ark_mem, N_Vector y0, sunrealtype hscale,
+                     sunrealtype t0, ARKVecResizeFn resize, void* resize_data);
+void pdirkStep_Free(ARKodeMem ark_mem);
+void pdirkStep_PrintMem(ARKodeMem ark_mem, FILE* outfile);
+int pdirkStep_GetEstLocalErrors(ARKodeMem ark_mem, N_Vector ele);
+
+/* Internal utility routines */
+int pdirkStep_AccessARKODEStepMem(void* arkode_mem, const char* fname,
+                                  ARKodeMem* ark_mem,
+                                  ARKodePDIRKStepMem* step_mem);
+int pdirkStep_AccessStepMem(ARKodeMem ark_mem, const char* fname,
+                            ARKodePDIRKStepMem* step_mem);
+sunbooleantype pdirkStep_CheckNVector(N_Vector tmpl);
+int pdirkStep_SetMethodProperties(ARKodeMem ark_mem);
+
+/*===============================================================
+  Reusable PDIRKStep Error Messages
+  ===============================================================*/
+
+/* Initialization and I/O error messages */
+#define MSG_PDIRKSTEP_NO_MEM "Time step module memory is NULL."
+#define MSG_PDIRKSTEP_NO_LS \
+  "PDIRKStep requires one matrix-based direct linear solver per stage."
+#define MSG_PDIRKSTEP_NO_JAC "PDIRKStep requires a Jacobian function."
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,645 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * This is the implementation file for the optional input and
+ * output functions for the ARKODE PDIRKStep time stepper module.
+ *--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/sundials_math.h>
+#include <sundials/sundials_types.h>
+
+#include "arkode_pdirkstep_impl.h"
+
+/*===============================================================
+  Exported linear solver interface functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  PDIRKStepSetLinearSolvers:
+
+  Attaches one matrix-based direct linear solver and matrix per
+  stage (at least as many as the method has stages). The solvers
+  and matrices remain owned by the user; they must be distinct
+  objects, since the stages are solved concurrently.
+  ---------------------------------------------------------------*/
+int PDIRKStepSetLinearSolvers(void* arkode_mem, int num, SUNLinearSolver* LS,
+                              SUNMatrix* A)
+{
+  ARKodeMem ark_mem;
+  ARKodePDIRKStepMem step_mem;
+  int retval, i;
+
+  /* access ARKodeMem and ARKodePDIRKStepMem structures */
+  retval = pdirkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* check the inputs */
+  if ((num < 1) || (LS == NULL) || (A == NULL))
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_PDIRKSTEP_NO_LS);
+    return (ARK_ILL_INPUT);
+  }
+  num = SUNMIN(num, PDIRK_MAX_STAGES);
+  for (i = 0; i < num; i++)
+  {
+    if ((LS[i] == NULL) || (A[i] == NULL) ||
+        (SUNLinSolGetType(LS[i]) != SUNLINEARSOLVER_DIRECT))
+    {
+      arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSG_PDIRKSTEP_NO_LS);
+      return (ARK_ILL_INPUT);
+    }
+  }
+
+  /* attach the solvers and matrices */
+  step_mem->nls = num;
+  for (i = 0; i < num; i++)
+  {
+    step_mem->LS[i]   = LS[i];
+    step_mem->Amat[i] = A[i];
+  }
+
+  /* the saved Jacobian is recreated from the new matrices in Init */
+  if (step_mem->J != NULL)
+  {
+    SUNMatDestroy(step_mem->J);
+    step_mem->J = NULL;
+  }
+
+  /* Reset the linear solver counters */
+  step_mem->nje     = 0;
+  step_mem->nsetups = 0;
+  step_mem->nstlj   = 0;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  PDIRKStepSetJacFn:
+
+  Specifies the Jacobian function of f. It is only called at the
+  beginning of a step, but when several threads are used it
+  should be thread safe along with f.
+  ---------------------------------------------------------------*/
+int PDIRKStepSetJacFn(void* arkode_mem, ARKLsJacFn jac)
+{
+  ARKodeMem ark_mem;
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodePDIRKStepMem structures */
+  retval = pdirkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (jac == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_PDIRKSTEP_NO_JAC);
+    return (ARK_ILL_INPUT);
+  }
+
+  step_mem->jac = jac;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Exported optional input functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  PDIRKStepSetMethod:
+
+  Specifies the PDIRK method (corrector).
+  ---------------------------------------------------------------*/
+int PDIRKStepSetMethod(void* arkode_mem, ARKODE_PDIRKMethodType method)
+{
+  ARKodeMem ark_mem;
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodePDIRKStepMem structures */
+  retval = pdirkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  switch (method)
+  {
+  case ARKODE_PDIRK_RADAU_2_3:
+  case ARKODE_PDIRK_RADAU_3_5: break;
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid PDIRK method type");
+    return (ARK_ILL_INPUT);
+  }
+
+  step_mem->method = method;
+
+  return (pdirkStep_SetMethodProperties(ark_mem));
+}
+
+/*---------------------------------------------------------------
+  PDIRKStepSetMethodByName:
+
+  Specifies the PDIRK method by its enumeration name.
+  ---------------------------------------------------------------*/
+int PDIRKStepSetMethodByName(void* arkode_mem, const char* emethod)
+{
+  if (emethod == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Method name is NULL");
+    return (ARK_ILL_INPUT);
+  }
+
+  if (strcmp(emethod, "ARKODE_PDIRK_RADAU_2_3") == 0)
+  {
+    return (PDIRKStepSetMethod(arkode_mem, ARKODE_PDIRK_RADAU_2_3));
+  }
+  if (strcmp(emethod, "ARKODE_PDIRK_RADAU_3_5") == 0)
+  {
+    return (PDIRKStepSetMethod(arkode_mem, ARKODE_PDIRK_RADAU_3_5));
+  }
+
+  arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                  "Unknown method name");
+  return (ARK_ILL_INPUT);
+}
+
+/*---------------------------------------------------------------
+  PDIRKStepSetNumIterations:
+
+  Specifies the number of corrector iterations per step. The
+  method order is the smaller of the number of iterations and the
+  corrector order. At least two iterations are needed for the
+  error estimate; a non-positive value restores the default (the
+  corrector order).
+  ---------------------------------------------------------------*/
+int PDIRKStepSetNumIterations(void* arkode_mem, int niters)
+{
+  ARKodeMem ark_mem;
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodePDIRKStepMem structures */
+  retval = pdirkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (niters == 1)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "At least two iterations are required");
+    return (ARK_ILL_INPUT);
+  }
+
+  step_mem->niters_user = (niters > 0) ? niters : 0;
+
+  return (pdirkStep_SetMethodProperties(ark_mem));
+}
+
+/*---------------------------------------------------------------
+  PDIRKStepSetNumThreads:
+
+  Specifies the number of OpenMP threads used for the stage
+  loops. The value is ignored when ARKODE is built without
+  OpenMP; a non-positive value restores the default (1).
+  ---------------------------------------------------------------*/
+int PDIRKStepSetNumThreads(void* arkode_mem, int nthreads)
+{
+  ARKodeMem ark_mem;
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodePDIRKStepMem structures */
+  retval = pdirkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  step_mem->nthreads = (nthreads > 0) ? nthreads : 1;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  PDIRKStepSetJacEvalFrequency:
+
+  Specifies the maximum number of steps between Jacobian
+  evaluations. Negative values imply an evaluation in each step;
+  a zero value implies a reset to the default.
+  ---------------------------------------------------------------*/
+int PDIRKStepSetJacEvalFrequency(void* arkode_mem, long int msbj)
+{
+  ARKodeMem ark_mem;
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodePDIRKStepMem structures */
+  retval = pdirkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  step_mem->msbj = (msbj == 0) ? PDIRK_MSBJ : msbj;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Exported optional output functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  PDIRKStepGetNumRhsEvals:
+
+  Returns the current number of calls to f
+  ---------------------------------------------------------------*/
+int PDIRKStepGetNumRhsEvals(void* arkode_mem, long int* fevals)
+{
+  ARKodeMem ark_mem;
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodePDIRKStepMem structures */
+  retval = pdirkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get values from step_mem */
+  *fevals = step_mem->nfe;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  PDIRKStepGetNumJacEvals:
+
+  Returns the current number of calls to the Jacobian function
+  ---------------------------------------------------------------*/
+int PDIRKStepGetNumJacEvals(void* arkode_mem, long int* njevals)
+{
+  ARKodeMem ark_mem;
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodePDIRKStepMem structures */
+  retval = pdirkStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get values from step_mem */
+  *njevals = step_mem->nje;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Private functions attached to ARKODE
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  pdirkStep_SetDefaults:
+
+  Resets all PDIRKStep optional inputs to their default values.
+  Does not change problem-defining function pointers, the
+  Jacobian function, the attached linear solvers or the
+  user_data pointer.
+  ---------------------------------------------------------------*/
+int pdirkStep_SetDefaults(ARKodeMem ark_mem)
+{
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Set default values for integrator optional inputs */
+  step_mem->method      = PDIRK_DEFAULT_METHOD;
+  step_mem->niters_user = 0;
+  step_mem->nthreads    = 1;
+  step_mem->msbj        = PDIRK_MSBJ;
+  step_mem->nlscoef     = PDIRK_NLSCOEF;
+  step_mem->maxcor      = PDIRK_MAXCOR;
+  step_mem->crdown      = PDIRK_CRDOWN;
+  step_mem->rdiv        = PDIRK_RDIV;
+
+  return (pdirkStep_SetMethodProperties(ark_mem));
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_SetNonlinCRDown:
+
+  Specifies the user-provided stage Newton convergence rate
+  constant crdown.  Legal values are strictly positive; illegal
+  values imply a reset to the default.
+  ---------------------------------------------------------------*/
+int pdirkStep_SetNonlinCRDown(ARKodeMem ark_mem, sunrealtype crdown)
+{
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* if argument legal set it, otherwise set default */
+  if (crdown <= ZERO) { step_mem->crdown = PDIRK_CRDOWN; }
+  else { step_mem->crdown = crdown; }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_SetNonlinRDiv:
+
+  Specifies the user-provided stage Newton divergence threshold
+  rdiv.  Legal values are strictly positive; illegal values imply
+  a reset to the default.
+  ---------------------------------------------------------------*/
+int pdirkStep_SetNonlinRDiv(ARKodeMem ark_mem, sunrealtype rdiv)
+{
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* if argument legal set it, otherwise set default */
+  if (rdiv <= ZERO) { step_mem->rdiv = PDIRK_RDIV; }
+  else { step_mem->rdiv = rdiv; }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_SetMaxNonlinIters:
+
+  Sets the maximum number of Newton iterations per stage solve.
+  Non-positive values imply a reset to the default.
+  ---------------------------------------------------------------*/
+int pdirkStep_SetMaxNonlinIters(ARKodeMem ark_mem, int maxcor)
+{
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* if argument legal set it, otherwise set default */
+  if (maxcor <= 0) { step_mem->maxcor = PDIRK_MAXCOR; }
+  else { step_mem->maxcor = maxcor; }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_SetNonlinConvCoef:
+
+  Specifies the coefficient in the stage Newton convergence test.
+  Non-positive values imply a reset to the default.
+  ---------------------------------------------------------------*/
+int pdirkStep_SetNonlinConvCoef(ARKodeMem ark_mem, sunrealtype nlscoef)
+{
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* if argument legal set it, otherwise set default */
+  if (nlscoef <= ZERO) { step_mem->nlscoef = PDIRK_NLSCOEF; }
+  else { step_mem->nlscoef = nlscoef; }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_GetNumLinSolvSetups:
+
+  Returns the current number of stage linear solver setups
+  ---------------------------------------------------------------*/
+int pdirkStep_GetNumLinSolvSetups(ARKodeMem ark_mem, long int* nlinsetups)
+{
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get value from step_mem */
+  *nlinsetups = step_mem->nsetups;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_GetNumNonlinSolvIters:
+
+  Returns the current number of stage Newton iterations (each
+  with one linear solve)
+  ---------------------------------------------------------------*/
+int pdirkStep_GetNumNonlinSolvIters(ARKodeMem ark_mem, long int* nniters)
+{
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  *nniters = step_mem->nni;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_GetNumNonlinSolvConvFails:
+
+  Returns the current number of failed corrector iterations
+  ---------------------------------------------------------------*/
+int pdirkStep_GetNumNonlinSolvConvFails(ARKodeMem ark_mem, long int* nnfails)
+{
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  *nnfails = step_mem->nncf;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_GetNonlinSolvStats:
+
+  Returns stage Newton iteration statistics
+  ---------------------------------------------------------------*/
+int pdirkStep_GetNonlinSolvStats(ARKodeMem ark_mem, long int* nniters,
+                                 long int* nnfails)
+{
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  *nniters = step_mem->nni;
+  *nnfails = step_mem->nncf;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_GetEstLocalErrors: Returns the current local truncation
+  error estimate vector
+  ---------------------------------------------------------------*/
+int pdirkStep_GetEstLocalErrors(ARKodeMem ark_mem, N_Vector ele)
+{
+  int retval;
+  ARKodePDIRKStepMem step_mem;
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* return an error if local truncation error is not computed */
+  if (ark_mem->fixedstep) { return (ARK_STEPPER_UNSUPPORTED); }
+
+  /* otherwise, copy local truncation error vector to output */
+  N_VScale(ONE, ark_mem->tempv1, ele);
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_PrintAllStats:
+
+  Prints integrator statistics
+  ---------------------------------------------------------------*/
+int pdirkStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile,
+                            SUNOutputFormat fmt)
+{
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  switch (fmt)
+  {
+  case SUN_OUTPUTFORMAT_TABLE:
+    /* function evaluations */
+    fprintf(outfile, "RHS fn evals                 = %ld\n", step_mem->nfe);
+
+    /* nonlinear and linear solver stats */
+    fprintf(outfile, "NLS iters                    = %ld\n", step_mem->nni);
+    fprintf(outfile, "NLS fails                    = %ld\n", step_mem->nncf);
+    if (ark_mem->nst > 0)
+    {
+      fprintf(outfile, "NLS iters per step           = %" RSYM "\n",
+              (sunrealtype)step_mem->nni / (sunrealtype)ark_mem->nst);
+    }
+    fprintf(outfile, "LS setups                    = %ld\n", step_mem->nsetups);
+    fprintf(outfile, "Jac fn evals                 = %ld\n", step_mem->nje);
+    if (ark_mem->nst > 0)
+    {
+      fprintf(outfile, "Jac evals per step           = %" RSYM "\n",
+              (sunrealtype)step_mem->nje / (sunrealtype)ark_mem->nst);
+    }
+    break;
+
+  case SUN_OUTPUTFORMAT_CSV:
+    /* function evaluations */
+    fprintf(outfile, ",RHS fn evals,%ld", step_mem->nfe);
+
+    /* nonlinear and linear solver stats */
+    fprintf(outfile, ",NLS iters,%ld", step_mem->nni);
+    fprintf(outfile, ",NLS fails,%ld", step_mem->nncf);
+    if (ark_mem->nst > 0)
+    {
+      fprintf(outfile, ",NLS iters per step,%" RSYM,
+              (sunrealtype)step_mem->nni / (sunrealtype)ark_mem->nst);
+    }
+    else { fprintf(outfile, ",NLS iters per step,0"); }
+    fprintf(outfile, ",LS setups,%ld", step_mem->nsetups);
+    fprintf(outfile, ",Jac fn evals,%ld", step_mem->nje);
+    if (ark_mem->nst > 0)
+    {
+      fprintf(outfile, ",Jac evals per step,%" RSYM,
+              (sunrealtype)step_mem->nje / (sunrealtype)ark_mem->nst);
+    }
+    else { fprintf(outfile, ",Jac evals per step,0"); }
+    fprintf(outfile, "\n");
+    break;
+
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid formatting option.");
+    return (ARK_ILL_INPUT);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  pdirkStep_WriteParameters:
+
+  Outputs all solver parameters to the provided file pointer.
+  ---------------------------------------------------------------*/
+int pdirkStep_WriteParameters(ARKodeMem ark_mem, FILE* fp)
+{
+  ARKodePDIRKStepMem step_mem;
+  int retval;
+
+  /* access ARKodePDIRKStepMem structure */
+  retval = pdirkStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* print integrator parameters to file */
+  fprintf(fp, "PDIRKStep time step module parameters:\n");
+  switch (step_mem->method)
+  {
+  case ARKODE_PDIRK_RADAU_2_3:
+    fprintf(fp, "  Corrector Radau IIA 2-stage");
+    break;
+  case ARKODE_PDIRK_RADAU_3_5:
+    fprintf(fp, "  Corrector Radau IIA 3-stage");
+    break;
+  default: fprintf(fp, "  Corrector unknown"); break;
+  }
+  fprintf(fp, " (%i iterations, order %i, embedding order %i)\n",
+          step_mem->niters, step_mem->q, step_mem->p);
+  fprintf(fp, "  Number of threads %i\n", step_mem->nthreads);
+  fprintf(fp, "  Jacobian evaluation frequency %li\n", step_mem->msbj);
+  fprintf(fp, "  Newton convergence coefficient = %" RSYM "\n",
+          step_mem->nlscoef);
+  fprintf(fp, "  Maximum Newton iterations = %i\n", step_mem->maxcor);
+  fprintf(fp, "  Newton rate constant = %" RSYM "\n", step_mem->crdown);
+  fprintf(fp, "  Newton divergence constant = %" RSYM "\n", step_mem->rdiv);
+  fprintf(fp, "\n");
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
@@ -0,0 +1,1425 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * This is the implementation file for ARKODE's fully implicit
+ * Radau IIA time stepper module.
+ *
+ * The stage systems are solved as in RADAU5 and RADAU of Hairer
+ * and Wanner (Solving Ordinary Differential Equations II,
+ * Section IV.8): a simplified Newton iteration is applied to the
+ * stage increments Z_i = Y_i - yn transformed with the real
+ * eigenbasis T of A^{-1}. The real eigenvalue gamma of A^{-1}
+ * gives one real system with the matrix gamma/h I - J, and each
+ * complex pair alpha +/- i beta a complex system with the matrix
+ * (alpha + i beta)/h I - J. As SUNDIALS has no complex vectors,
+ * the complex systems are solved in their real 2N x 2N form
+ *
+ *   [ alpha/h I - J   -beta/h I      ] [u]   [a]
+ *   [ beta/h I         alpha/h I - J ] [v] = [b].
+ *
+ * All matrices are formed from a dense Jacobian that is held
+ * across steps, and are factored with SUNLinSol_Dense solvers
+ * created by the module.
+ *--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <nvector/nvector_serial.h>
+#include <sundials/sundials_context.h>
+#include <sundials/sundials_math.h>
+#include <sunlinsol/sunlinsol_dense.h>
+#include <sunmatrix/sunmatrix_dense.h>
+
+#include "arkode_impl.h"
+#include "arkode_interp_impl.h"
+#include "arkode_radaustep_impl.h"
+
+/*===============================================================
+  Radau IIA method coefficients
+
+  Each method is given by its nodes c, the real eigenbasis T of
+  A^{-1} and its inverse, such that T^{-1} A^{-1} T is block
+  diagonal with the real eigenvalue gamma followed by the 2 x 2
+  blocks [alpha, -beta; beta, alpha] of the complex pairs, and
+  the coefficients dd of the error estimate,
+
+    err = (gamma/h I - J)^{-1} (f(tn, yn) + sum_i dd_i/h Z_i),
+
+  the difference to an embedded method of order s (with the
+  weight 1/gamma for f(tn, yn)), filtered for stiff components.
+  ===============================================================*/
+
+/* 3-stage Radau IIA (order 5) */
+static const sunrealtype radau3_c[3] = {SUN_RCONST(1.5505102572168220e-01),
+                                        SUN_RCONST(6.4494897427831777e-01),
+                                        SUN_RCONST(1.0)};
+static const sunrealtype radau3_T[3][3] = {
+  {SUN_RCONST(9.4438762488975245e-02), SUN_RCONST(-1.4125529502095421e-01),
+   SUN_RCONST(-3.0029194105147424e-02)},
+  {SUN_RCONST(2.5021312296533332e-01), SUN_RCONST(2.0412935229379994e-01),
+   SUN_RCONST(3.8294211275726192e-01)},
+  {SUN_RCONST(1.0), SUN_RCONST(1.0), SUN_RCONST(0.0)}};
+static const sunrealtype radau3_Ti[3][3] = {
+  {SUN_RCONST(4.1787185915519052e+00), SUN_RCONST(3.2768282076106237e-01),
+   SUN_RCONST(5.2337644549944951e-01)},
+  {SUN_RCONST(-4.1787185915519052e+00), SUN_RCONST(-3.2768282076106237e-01),
+   SUN_RCONST(4.7662355450055044e-01)},
+  {SUN_RCONST(-5.0287263494578682e-01), SUN_RCONST(2.5719269498556052e+00),
+   SUN_RCONST(-5.9603920482822492e-01)}};
+static const sunrealtype radau3_dd[3] = {SUN_RCONST(-1.0048809399827416e+01),
+                                         SUN_RCONST(1.3821427331607490e+00),
+                                         SUN_RCONST(-3.3333333333333333e-01)};
+static const sunrealtype radau3_gamma    = SUN_RCONST(3.6378342527444958e+00);
+static const sunrealtype radau3_alpha[1] = {SUN_RCONST(2.6810828736277523e+00)};
+static const sunrealtype radau3_beta[1]  = {SUN_RCONST(3.0504301992474105e+00)};
+
+/* 5-stage Radau IIA (order 9) */
+static const sunrealtype radau5_c[5] = {SUN_RCONST(5.7104196114517683e-02),
+                                        SUN_RCONST(2.7684301363812380e-01),
+                                        SUN_RCONST(5.8359043236891683e-01),
+                                        SUN_RCONST(8.6024013565621948e-01),
+                                        SUN_RCONST(1.0)};
+static const sunrealtype radau5_T[5][5] = {
+  {SUN_RCONST(1.3576867344947943e-02), SUN_RCONST(-1.0242047817908826e-02),
+   SUN_RCONST(4.7673877290295721e-02), SUN_RCONST(-1.1478515255229515e-02),
+   SUN_RCONST(-1.4019858892875410e-02)},
+  {SUN_RCONST(1.6179004017190875e-03), SUN_RCONST(5.0172864517371060e-02),
+   SUN_RCONST(-9.4331819181611432e-02), SUN_RCONST(-7.6688307491801630e-03),
+   SUN_RCONST(2.4708578426518527e-02)},
+  {SUN_RCONST(7.9157853347447210e-02), SUN_RCONST(-2.3053953404341795e-01),
+   SUN_RCONST(1.0270304538012590e-01), SUN_RCONST(1.9398463998828951e-02),
+   SUN_RCONST(8.1800353703751175e-02)},
+  {SUN_RCONST(4.1225608268046143e-01), SUN_RCONST(3.7789390224886127e-01),
+   SUN_RCONST(4.6674413033249434e-01), SUN_RCONST(4.0760117128019907e-01),
+   SUN_RCONST(1.9968242788680252e-01)},
+  {SUN_RCONST(1.0), SUN_RCONST(1.0), SUN_RCONST(0.0), SUN_RCONST(1.0),
+   SUN_RCONST(0.0)}};
+static const sunrealtype radau5_Ti[5][5] = {
+  {SUN_RCONST(2.7697693775684087e+01), SUN_RCONST(1.2783337911304406e+01),
+   SUN_RCONST(3.2084893867134299e+00), SUN_RCONST(-9.5149041224891617e-01),
+   SUN_RCONST(7.4155049602598966e-01)},
+  {SUN_RCONST(5.3441864378349120e+00), SUN_RCONST(4.5936155677591612e+00),
+   SUN_RCONST(-3.0363603234594243e+00), SUN_RCONST(1.0506601902314590e+00),
+   SUN_RCONST(-2.7277861186429625e-01)},
+  {SUN_RCONST(3.7480598074398048e+00), SUN_RCONST(-3.9849657363438848e+00),
+   SUN_RCONST(-1.0444156416080188e+00), SUN_RCONST(1.1840985681379486e+00),
+   SUN_RCONST(-4.4991777015678036e-01)},
+  {SUN_RCONST(-3.3041880213519001e+01), SUN_RCONST(-1.7376953479063566e+01),
+   SUN_RCONST(-1.7212906325400557e-01), SUN_RCONST(-9.9169777982542645e-02),
+   SUN_RCONST(5.3122811583830665e-01)},
+  {SUN_RCONST(-8.6114439798752915e+00), SUN_RCONST(9.6999914095288080e+00),
+   SUN_RCONST(1.9147286396968743e+00), SUN_RCONST(2.4186920060849402e+00),
+   SUN_RCONST(-1.0474634879353375e+00)}};
+static const sunrealtype radau5_dd[5] = {SUN_RCONST(-2.7780933944064639e+01),
+                                         SUN_RCONST(3.6414784980492132e+00),
+                                         SUN_RCONST(-1.2525477211691187e+00),
+                                         SUN_RCONST(5.9200316718454282e-01),
+                                         SUN_RCONST(-2.0e-01)};
+static const sunrealtype radau5_gamma    = SUN_RCONST(6.2867047517292765e+00);
+static const sunrealtype radau5_alpha[2] = {SUN_RCONST(3.6556943254635721e+00),
+                                            SUN_RCONST(5.7009532986717897e+00)};
+static const sunrealtype radau5_beta[2]  = {SUN_RCONST(6.5437368993600771e+00),
+                                            SUN_RCONST(3.2102656003085497e+00)};
+
+/*===============================================================
+  Private function prototypes
+  ===============================================================*/
+
+static int radauStep_AllocLinearAlgebra(ARKodeMem ark_mem,
+                                        ARKodeRadauStepMem step_mem);
+static void radauStep_FreeLinearAlgebra(ARKodeRadauStepMem step_mem);
+static int radauStep_DQJac(ARKodeMem ark_mem, ARKodeRadauStepMem step_mem);
+static int radauStep_Setup(ARKodeMem ark_mem, ARKodeRadauStepMem step_mem);
+static void radauStep_StartingValues(ARKodeMem ark_mem,
+                                     ARKodeRadauStepMem step_mem);
+static int radauStep_Nls(ARKodeMem ark_mem, ARKodeRadauStepMem step_mem);
+static int radauStep_ErrorEstimate(ARKodeMem ark_mem,
+                                   ARKodeRadauStepMem step_mem, N_Vector fy,
+                                   sunrealtype* dsmPtr);
+
+/*===============================================================
+  Exported functions
+  ===============================================================*/
+
+void* RadauStepCreate(ARKRhsFn f, sunrealtype t0, N_Vector y0,
+                      SUNContext sunctx)
+{
+  ARKodeMem ark_mem;
+  ARKodeRadauStepMem step_mem;
+  sunbooleantype nvectorOK;
+  int retval;
+
+  /* Check that f is supplied */
+  if (f == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_F);
+    return (NULL);
+  }
+
+  /* Check for legal input parameters */
+  if (y0 == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_Y0);
+    return (NULL);
+  }
+
+  if (!sunctx)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_SUNCTX);
+    return (NULL);
+  }
+
+  /* Test if all required vector operations are implemented */
+  nvectorOK = radauStep_CheckNVector(y0);
+  if (!nvectorOK)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_BAD_NVECTOR);
+    return (NULL);
+  }
+
+  /* Create ark_mem structure and set default values */
+  ark_mem = arkCreate(sunctx);
+  if (ark_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (NULL);
+  }
+
+  /* Allocate ARKodeRadauStepMem structure, and initialize to zero */
+  step_mem = NULL;
+  step_mem = (ARKodeRadauStepMem)malloc(sizeof(struct ARKodeRadauStepMemRec));
+  if (step_mem == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_ARKMEM_FAIL);
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+  memset(step_mem, 0, sizeof(struct ARKodeRadauStepMemRec));
+
+  /* Attach step_mem structure and function pointers to ark_mem */
+  ark_mem->step_init                      = radauStep_Init;
+  ark_mem->step_fullrhs                   = radauStep_FullRHS;
+  ark_mem->step                           = radauStep_TakeStep;
+  ark_mem->step_printallstats             = radauStep_PrintAllStats;
+  ark_mem->step_writeparameters           = radauStep_WriteParameters;
+  ark_mem->step_resize                    = radauStep_Resize;
+  ark_mem->step_free                      = radauStep_Free;
+  ark_mem->step_printmem                  = radauStep_PrintMem;
+  ark_mem->step_setdefaults               = radauStep_SetDefaults;
+  ark_mem->step_setnonlincrdown           = radauStep_SetNonlinCRDown;
+  ark_mem->step_setnonlinrdiv             = radauStep_SetNonlinRDiv;
+  ark_mem->step_setmaxnonliniters         = radauStep_SetMaxNonlinIters;
+  ark_mem->step_setnonlinconvcoef         = radauStep_SetNonlinConvCoef;
+  ark_mem->step_getnumlinsolvsetups       = radauStep_GetNumLinSolvSetups;
+  ark_mem->step_getnumnonlinsolviters     = radauStep_GetNumNonlinSolvIters;
+  ark_mem->step_getnumnonlinsolvconvfails = radauStep_GetNumNonlinSolvConvFails;
+  ark_mem->step_getnonlinsolvstats        = radauStep_GetNonlinSolvStats;
+  ark_mem->step_getestlocalerrors         = radauStep_GetEstLocalErrors;
+  ark_mem->step_supports_adaptive         = SUNTRUE;
+  ark_mem->step_supports_implicit         = SUNTRUE;
+  ark_mem->step_mem                       = (void*)step_mem;
+
+  /* Set default values for optional inputs */
+  retval = radauStep_SetDefaults((void*)ark_mem);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Error setting default solver options");
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+
+  /* Copy the input parameters into ARKODE state */
+  step_mem->f = f;
+
+  /* Update the ARKODE workspace requirements */
+  ark_mem->liw += 24; /* fcn ptrs, ints, long ints */
+  ark_mem->lrw += 70;
+
+  /* Initialize all the counters */
+  step_mem->nfe     = 0;
+  step_mem->nje     = 0;
+  step_mem->nsetups = 0;
+  step_mem->nni     = 0;
+  step_mem->nncf    = 0;
+  step_mem->nstlj   = 0;
+
+  /* Initialize main ARKODE infrastructure */
+  retval = arkInit(ark_mem, t0, y0, FIRST_INIT);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Unable to initialize main ARKODE infrastructure");
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+
+  return ((void*)ark_mem);
+}
+
+/*---------------------------------------------------------------
+  RadauStepReInit:
+
+  This routine re-initializes the RadauStep module to solve a new
+  problem of the same size as was previously solved. This routine
+  should also be called when the problem dynamics or desired solvers
+  have changed dramatically, so that the problem integration should
+  resume as if started from scratch.
+
+  Note all internal counters are set to 0 on re-initialization.
+  ---------------------------------------------------------------*/
+int RadauStepReInit(void* arkode_mem, ARKRhsFn f, sunrealtype t0, N_Vector y0)
+{
+  ARKodeMem ark_mem;
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Check if ark_mem was allocated */
+  if (ark_mem->MallocDone == SUNFALSE)
+  {
+    arkProcessError(ark_mem, ARK_NO_MALLOC, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MALLOC);
+    return (ARK_NO_MALLOC);
+  }
+
+  /* Check that f is supplied */
+  if (f == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_F);
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Check for legal input parameters */
+  if (y0 == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_Y0);
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Copy the input parameters into ARKODE state */
+  step_mem->f = f;
+
+  /* Initialize main ARKODE infrastructure */
+  retval = arkInit(arkode_mem, t0, y0, FIRST_INIT);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Unable to initialize main ARKODE infrastructure");
+    return (retval);
+  }
+
+  /* Initialize all the counters */
+  step_mem->nfe     = 0;
+  step_mem->nje     = 0;
+  step_mem->nsetups = 0;
+  step_mem->nni     = 0;
+  step_mem->nncf    = 0;
+  step_mem->nstlj   = 0;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Interface routines supplied to ARKODE
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  radauStep_Resize:
+
+  This routine resizes the stage vectors (if allocated) and frees
+  the dense matrices and linear solvers, which are recreated for
+  the new problem size in radauStep_Init.
+  ---------------------------------------------------------------*/
+int radauStep_Resize(ARKodeMem ark_mem, N_Vector y0,
+                     SUNDIALS_MAYBE_UNUSED sunrealtype hscale,
+                     SUNDIALS_MAYBE_UNUSED sunrealtype t0,
+                     ARKVecResizeFn resize, void* resize_data)
+{
+  ARKodeRadauStepMem step_mem;
+  sunindextype lrw1, liw1, lrw_diff, liw_diff;
+  N_Vector** vecs[4];
+  int retval, k;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Determine change in vector sizes */
+  lrw1 = liw1 = 0;
+  if (y0->ops->nvspace != NULL) { N_VSpace(y0, &lrw1, &liw1); }
+  lrw_diff      = lrw1 - ark_mem->lrw1;
+  liw_diff      = liw1 - ark_mem->liw1;
+  ark_mem->lrw1 = lrw1;
+  ark_mem->liw1 = liw1;
+
+  /* Resize the stage vectors */
+  vecs[0] = &step_mem->Z;
+  vecs[1] = &step_mem->W;
+  vecs[2] = &step_mem->F;
+  vecs[3] = &step_mem->D;
+  for (k = 0; k < 4; k++)
+  {
+    if (*vecs[k] == NULL) { continue; }
+    if (!arkResizeVecArray(resize, resize_data, step_mem->vec_alloc, y0,
+                           vecs[k], lrw_diff, &ark_mem->lrw, liw_diff,
+                           &ark_mem->liw))
+    {
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      "Unable to resize vector");
+      return (ARK_MEM_FAIL);
+    }
+  }
+
+  /* The linear algebra objects are recreated in Init */
+  radauStep_FreeLinearAlgebra(step_mem);
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_Free frees all RadauStep memory.
+  ---------------------------------------------------------------*/
+void radauStep_Free(ARKodeMem ark_mem)
+{
+  ARKodeRadauStepMem step_mem;
+  N_Vector** vecs[4];
+  int k;
+
+  /* nothing to do if ark_mem is already NULL */
+  if (ark_mem == NULL) { return; }
+
+  /* conditional frees on non-NULL RadauStep module */
+  if (ark_mem->step_mem != NULL)
+  {
+    step_mem = (ARKodeRadauStepMem)ark_mem->step_mem;
+
+    /* free the stage vectors */
+    vecs[0] = &step_mem->Z;
+    vecs[1] = &step_mem->W;
+    vecs[2] = &step_mem->F;
+    vecs[3] = &step_mem->D;
+    for (k = 0; k < 4; k++)
+    {
+      arkFreeVecArray(step_mem->vec_alloc, vecs[k], ark_mem->lrw1,
+                      &ark_mem->lrw, ark_mem->liw1, &ark_mem->liw);
+    }
+    step_mem->vec_alloc = 0;
+
+    /* free the matrices, linear solvers and 2N vectors */
+    radauStep_FreeLinearAlgebra(step_mem);
+
+    /* free the time stepper module itself */
+    free(ark_mem->step_mem);
+    ark_mem->step_mem = NULL;
+  }
+}
+
+/*---------------------------------------------------------------
+  radauStep_PrintMem:
+
+  This routine outputs the memory from the RadauStep structure to
+  a specified file pointer (useful when debugging).
+  ---------------------------------------------------------------*/
+void radauStep_PrintMem(ARKodeMem ark_mem, FILE* outfile)
+{
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return; }
+
+  /* output integer quantities */
+  fprintf(outfile, "RadauStep: method = %i\n", (int)step_mem->method);
+  fprintf(outfile, "RadauStep: stages = %i\n", step_mem->stages);
+  fprintf(outfile, "RadauStep: npairs = %i\n", step_mem->npairs);
+  fprintf(outfile, "RadauStep: q = %i\n", step_mem->q);
+  fprintf(outfile, "RadauStep: p = %i\n", step_mem->p);
+  fprintf(outfile, "RadauStep: maxcor = %i\n", step_mem->maxcor);
+  fprintf(outfile, "RadauStep: jbad = %i\n", step_mem->jbad);
+  fprintf(outfile, "RadauStep: jold = %i\n", step_mem->jold);
+  fprintf(outfile, "RadauStep: zvalid = %i\n", step_mem->zvalid);
+
+  /* output long integer quantities */
+  fprintf(outfile, "RadauStep: N = %li\n", (long int)step_mem->N);
+  fprintf(outfile, "RadauStep: nstlj = %li\n", step_mem->nstlj);
+  fprintf(outfile, "RadauStep: nstz = %li\n", step_mem->nstz);
+  fprintf(outfile, "RadauStep: nfe = %li\n", step_mem->nfe);
+  fprintf(outfile, "RadauStep: nje = %li\n", step_mem->nje);
+  fprintf(outfile, "RadauStep: nsetups = %li\n", step_mem->nsetups);
+  fprintf(outfile, "RadauStep: nni = %li\n", step_mem->nni);
+  fprintf(outfile, "RadauStep: nncf = %li\n", step_mem->nncf);
+
+  /* output sunrealtype quantities */
+  fprintf(outfile, "RadauStep: thet = %" RSYM "\n", step_mem->thet);
+  fprintf(outfile, "RadauStep: hsetup = %" RSYM "\n", step_mem->hsetup);
+  fprintf(outfile, "RadauStep: hz = %" RSYM "\n", step_mem->hz);
+  fprintf(outfile, "RadauStep: nlscoef = %" RSYM "\n", step_mem->nlscoef);
+  fprintf(outfile, "RadauStep: crdown = %" RSYM "\n", step_mem->crdown);
+  fprintf(outfile, "RadauStep: rdiv = %" RSYM "\n", step_mem->rdiv);
+}
+
+/*---------------------------------------------------------------
+  radauStep_Init:
+
+  This routine is called just prior to performing internal time
+  steps (after all user "set" routines have been called) from
+  within arkInitialSetup.
+
+  With initialization type FIRST_INIT this routine:
+  - sets the method coefficients and orders
+  - limits the interpolant degree by the method order
+  - allocates the stage vectors
+  - sets the call_fullrhs flag
+
+  With initialization types FIRST_INIT or RESIZE_INIT, this
+  routine creates (if needed) and initializes the dense matrices
+  and linear solvers. With all initialization types the next step
+  reevaluates the Jacobian and starts from zero stage increments.
+  ---------------------------------------------------------------*/
+int radauStep_Init(ARKodeMem ark_mem, int init_type)
+{
+  ARKodeRadauStepMem step_mem;
+  N_Vector** vecs[4];
+  int retval, k;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* force a Jacobian evaluation and zero starting values */
+  step_mem->jbad   = SUNTRUE;
+  step_mem->jold   = SUNFALSE;
+  step_mem->hsetup = ZERO;
+  step_mem->zvalid = SUNFALSE;
+
+  /* immediately return if reset */
+  if (init_type == RESET_INIT) { return (ARK_SUCCESS); }
+
+  /* initializations/checks for (re-)initialization call */
+  if (init_type == FIRST_INIT)
+  {
+    /* Set the method coefficients and orders */
+    retval = radauStep_SetMethodProperties(ark_mem);
+    if (retval != ARK_SUCCESS) { return (retval); }
+
+    /* Override the interpolant degree (if needed), used in arkInitialSetup */
+    if (step_mem->q > 1 && ark_mem->interp_degree > (step_mem->q - 1))
+    {
+      /* Limit max degree to at most one less than the method global order */
+      ark_mem->interp_degree = step_mem->q - 1;
+    }
+
+    /* Allocate the stage vectors (if needed) */
+    vecs[0] = &step_mem->Z;
+    vecs[1] = &step_mem->W;
+    vecs[2] = &step_mem->F;
+    vecs[3] = &step_mem->D;
+    if ((step_mem->Z != NULL) && (step_mem->vec_alloc < step_mem->stages))
+    {
+      for (k = 0; k < 4; k++)
+      {
+        arkFreeVecArray(step_mem->vec_alloc, vecs[k], ark_mem->lrw1,
+                        &ark_mem->lrw, ark_mem->liw1, &ark_mem->liw);
+      }
+      step_mem->vec_alloc = 0;
+    }
+    if (step_mem->Z == NULL)
+    {
+      for (k = 0; k < 4; k++)
+      {
+        if (!arkAllocVecArray(step_mem->stages, ark_mem->ewt, vecs[k],
+                              ark_mem->lrw1, &ark_mem->lrw, ark_mem->liw1,
+                              &ark_mem->liw))
+        {
+          return (ARK_MEM_FAIL);
+        }
+      }
+      step_mem->vec_alloc = step_mem->stages;
+    }
+
+    /* Signal to shared arkode module that full RHS evaluations are required */
+    ark_mem->call_fullrhs = SUNTRUE;
+  }
+
+  /* Create and initialize the matrices and linear solvers */
+  return (radauStep_AllocLinearAlgebra(ark_mem, step_mem));
+}
+
+/*------------------------------------------------------------------------------
+  radauStep_FullRHS:
+
+  This is just a wrapper to call the user-supplied RHS function, f(t,y). The
+  RHS is evaluated in every mode.
+  ----------------------------------------------------------------------------*/
+int radauStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
+                      int mode)
+{
+  int retval;
+  ARKodeRadauStepMem step_mem;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* perform RHS functions contingent on 'mode' argument */
+  switch (mode)
+  {
+  case ARK_FULLRHS_START:
+  case ARK_FULLRHS_END:
+  case ARK_FULLRHS_OTHER:
+
+    /* call f */
+    retval = step_mem->f(t, y, f, ark_mem->user_data);
+    step_mem->nfe++;
+    if (retval != 0)
+    {
+      arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_RHSFUNC_FAILED, t);
+      return (ARK_RHSFUNC_FAIL);
+    }
+
+    break;
+
+  default:
+    /* return with RHS failure if unknown mode is passed */
+    arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                    "Unknown full RHS mode");
+    return (ARK_RHSFUNC_FAIL);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_TakeStep:
+
+  This routine performs a single Radau IIA step,
+
+    Z_i = h sum_j a_ij f(tn + c_j h, yn + Z_j),   y = yn + Z_s,
+
+  solving the stage equations with the simplified Newton
+  iteration of radauStep_Nls. As in RADAU5, the Jacobian is held
+  across steps: it is only reevaluated (at tn, yn) in the first
+  step, after a Newton iteration that converged slower than the
+  rate thet, and after a Newton failure with an out of date
+  Jacobian. The factorizations are reused as long as the step
+  size ratio h / hsetup is in [1, 1.2].
+
+  The output variable dsmPtr should contain estimate of the
+  weighted local error if an embedding is present; otherwise it
+  should be 0.
+
+  The input/output variable nflagPtr is used to gauge failures of
+  the Newton iteration. On failure it is set to the failure flag
+  and TRY_AGAIN is returned, so that ARKODE retries the step with
+  a smaller step size (if recoverable).
+
+  The return value from this routine is:
+            0 => step completed successfully
+           >0 => step encountered recoverable failure;
+                 reduce step and retry (if possible)
+           <0 => step encountered unrecoverable failure
+  ---------------------------------------------------------------*/
+int radauStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr)
+{
+  int retval, nflag;
+  sunbooleantype jcur, evalJ;
+  sunrealtype ratio;
+  ARKodeRadauStepMem step_mem;
+
+  /* initialize output */
+  *dsmPtr = ZERO;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Decide whether to reevaluate the Jacobian (jcur: J is at yn) */
+  nflag = *nflagPtr;
+  jcur  = !(step_mem->jbad) && (step_mem->nstlj == ark_mem->nst);
+  evalJ = (step_mem->jbad) || (step_mem->thet < ZERO) ||
+          (!jcur && (step_mem->jold || (nflag == PREV_CONV_FAIL)));
+
+  /* initialize the Newton failure flag to success */
+  *nflagPtr = ARK_SUCCESS;
+
+  /* The RHS at the start of the step may need to be computed (possibly
+     already computed by ARKODE) */
+  if (!(ark_mem->fn_is_current))
+  {
+    retval = ark_mem->step_fullrhs(ark_mem, ark_mem->tn, ark_mem->yn,
+                                   ark_mem->fn, ARK_FULLRHS_START);
+    if (retval) { return ARK_RHSFUNC_FAIL; }
+    ark_mem->fn_is_current = SUNTRUE;
+  }
+
+  /* Evaluate J at (tn, yn) */
+  if (evalJ)
+  {
+    retval = SUNMatZero(step_mem->J);
+    if (retval != SUN_SUCCESS) { return (ARK_LSETUP_FAIL); }
+    if (step_mem->jac != NULL)
+    {
+      retval = step_mem->jac(ark_mem->tn, ark_mem->yn, ark_mem->fn, step_mem->J,
+                             ark_mem->user_data, ark_mem->tempv1,
+                             ark_mem->tempv2, ark_mem->tempv3);
+    }
+    else { retval = radauStep_DQJac(ark_mem, step_mem); }
+    step_mem->nje++;
+    if (retval < 0) { return (ARK_LSETUP_FAIL); }
+    if (retval > 0)
+    {
+      *nflagPtr = CONV_FAIL;
+      return (TRY_AGAIN);
+    }
+    step_mem->jbad   = SUNFALSE;
+    step_mem->jold   = SUNFALSE;
+    step_mem->nstlj  = ark_mem->nst;
+    step_mem->hsetup = ZERO;
+  }
+
+  /* Form and factor the real and complex systems (if needed) */
+  ratio = (step_mem->hsetup != ZERO) ? ark_mem->h / step_mem->hsetup : ZERO;
+  if ((ratio < RADAU_QUOT1) || (ratio > RADAU_QUOT2))
+  {
+    *nflagPtr = radauStep_Setup(ark_mem, step_mem);
+    if (*nflagPtr != ARK_SUCCESS) { return (TRY_AGAIN); }
+  }
+
+  /* Solve the stage equations */
+  radauStep_StartingValues(ark_mem, step_mem);
+  retval = radauStep_Nls(ark_mem, step_mem);
+  if (retval != ARK_SUCCESS)
+  {
+    if (retval > 0) { step_mem->nncf++; }
+    *nflagPtr = retval;
+    return (TRY_AGAIN);
+  }
+
+  /* Compute the error estimate (if step adaptivity enabled) */
+  if (!ark_mem->fixedstep)
+  {
+    retval = radauStep_ErrorEstimate(ark_mem, step_mem, ark_mem->fn, dsmPtr);
+    if (retval != ARK_SUCCESS) { return (retval); }
+
+    /* as in RADAU5, a rejected first step or a step following an error
+       test failure is reestimated with f at yn + err */
+    if ((*dsmPtr >= ONE) && ((ark_mem->nst == 0) || (nflag == PREV_ERR_FAIL)))
+    {
+      N_VLinearSum(ONE, ark_mem->yn, ONE, ark_mem->tempv1, ark_mem->ycur);
+      retval = step_mem->f(ark_mem->tn, ark_mem->ycur, ark_mem->tempv3,
+                           ark_mem->user_data);
+      step_mem->nfe++;
+      if (retval < 0) { return (ARK_RHSFUNC_FAIL); }
+      if (retval > 0)
+      {
+        *nflagPtr = RHSFUNC_RECVR;
+        return (TRY_AGAIN);
+      }
+      retval = radauStep_ErrorEstimate(ark_mem, step_mem, ark_mem->tempv3,
+                                       dsmPtr);
+      if (retval != ARK_SUCCESS) { return (retval); }
+    }
+  }
+
+  /* y = yn + Z_s */
+  ark_mem->tcur = ark_mem->tn + ark_mem->h;
+  N_VLinearSum(ONE, ark_mem->yn, ONE, step_mem->Z[step_mem->stages - 1],
+               ark_mem->ycur);
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
+  SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
+                     "ARKODE::radauStep_TakeStep", "error-test",
+                     "step = %li, h = %" RSYM ", dsm = %" RSYM ", jeval = %i",
+                     ark_mem->nst, ark_mem->h, *dsmPtr, (int)evalJ);
+#endif
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Internal utility routines
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  radauStep_AccessARKODEStepMem:
+
+  Shortcut routine to unpack both ark_mem and step_mem structures
+  from void* pointer.  If either is missing it returns ARK_MEM_NULL.
+  ---------------------------------------------------------------*/
+int radauStep_AccessARKODEStepMem(void* arkode_mem, const char* fname,
+                                  ARKodeMem* ark_mem,
+                                  ARKodeRadauStepMem* step_mem)
+{
+  /* access ARKodeMem structure */
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *ark_mem = (ARKodeMem)arkode_mem;
+
+  /* access ARKodeRadauStepMem structure */
+  if ((*ark_mem)->step_mem == NULL)
+  {
+    arkProcessError(*ark_mem, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_RADAUSTEP_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *step_mem = (ARKodeRadauStepMem)(*ark_mem)->step_mem;
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_AccessStepMem:
+
+  Shortcut routine to unpack the step_mem structure from
+  ark_mem.  If missing it returns ARK_MEM_NULL.
+  ---------------------------------------------------------------*/
+int radauStep_AccessStepMem(ARKodeMem ark_mem, const char* fname,
+                            ARKodeRadauStepMem* step_mem)
+{
+  /* access ARKodeRadauStepMem structure */
+  if (ark_mem->step_mem == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_RADAUSTEP_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *step_mem = (ARKodeRadauStepMem)ark_mem->step_mem;
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_CheckNVector:
+
+  This routine checks if all required vector operations are
+  present, and that the vector data is stored in a single local
+  array (as required by the dense linear algebra).  If not it
+  returns SUNFALSE.
+  ---------------------------------------------------------------*/
+sunbooleantype radauStep_CheckNVector(N_Vector tmpl)
+{
+  N_Vector_ID id;
+
+  if ((tmpl->ops->nvclone == NULL) || (tmpl->ops->nvdestroy == NULL) ||
+      (tmpl->ops->nvlinearsum == NULL) || (tmpl->ops->nvconst == NULL) ||
+      (tmpl->ops->nvscale == NULL) || (tmpl->ops->nvwrmsnorm == NULL) ||
+      (tmpl->ops->nvgetarraypointer == NULL) ||
+      (tmpl->ops->nvgetlength == NULL))
+  {
+    return (SUNFALSE);
+  }
+  id = N_VGetVectorID(tmpl);
+  if ((id != SUNDIALS_NVEC_SERIAL) && (id != SUNDIALS_NVEC_OPENMP) &&
+      (id != SUNDIALS_NVEC_PTHREADS))
+  {
+    return (SUNFALSE);
+  }
+  return (SUNTRUE);
+}
+
+/*---------------------------------------------------------------
+  radauStep_SetMethodProperties:
+
+  This routine sets the coefficients, number of stages and
+  complex pairs, and the method and embedding orders (also in the
+  adaptivity module) of the selected method. An s-stage Radau IIA
+  method has order 2s - 1, and the embedded method order s.
+  ---------------------------------------------------------------*/
+int radauStep_SetMethodProperties(ARKodeMem ark_mem)
+{
+  ARKodeRadauStepMem step_mem;
+  int retval, i, j;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Set the coefficients of the selected method */
+  switch (step_mem->method)
+  {
+  case ARKODE_RADAU_3_5:
+    step_mem->stages = 3;
+    step_mem->gamma  = radau3_gamma;
+    for (i = 0; i < 3; i++)
+    {
+      step_mem->c[i]  = radau3_c[i];
+      step_mem->dd[i] = radau3_dd[i];
+      for (j = 0; j < 3; j++)
+      {
+        step_mem->T[i][j]  = radau3_T[i][j];
+        step_mem->Ti[i][j] = radau3_Ti[i][j];
+      }
+    }
+    for (i = 0; i < 1; i++)
+    {
+      step_mem->alpha[i] = radau3_alpha[i];
+      step_mem->beta[i]  = radau3_beta[i];
+    }
+    break;
+  case ARKODE_RADAU_5_9:
+    step_mem->stages = 5;
+    step_mem->gamma  = radau5_gamma;
+    for (i = 0; i < 5; i++)
+    {
+      step_mem->c[i]  = radau5_c[i];
+      step_mem->dd[i] = radau5_dd[i];
+      for (j = 0; j < 5; j++)
+      {
+        step_mem->T[i][j]  = radau5_T[i][j];
+        step_mem->Ti[i][j] = radau5_Ti[i][j];
+      }
+    }
+    for (i = 0; i < 2; i++)
+    {
+      step_mem->alpha[i] = radau5_alpha[i];
+      step_mem->beta[i]  = radau5_beta[i];
+    }
+    break;
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid Radau method type");
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Set the number of complex pairs and the orders */
+  step_mem->npairs = (step_mem->stages - 1) / 2;
+  step_mem->q      = 2 * step_mem->stages - 1;
+  step_mem->p      = step_mem->stages;
+
+  /* Set the method and embedding orders in the adaptivity module */
+  ark_mem->hadapt_mem->q = step_mem->q;
+  ark_mem->hadapt_mem->p = step_mem->p;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_AllocLinearAlgebra:
+
+  This routine creates (if needed) the dense Jacobian, the real
+  system matrix and solver, and for each complex pair the 2N x 2N
+  matrix, solver and vectors of its real form, and initializes
+  the solvers. Objects from a previous problem size or method are
+  replaced.
+  ---------------------------------------------------------------*/
+static int radauStep_AllocLinearAlgebra(ARKodeMem ark_mem,
+                                        ARKodeRadauStepMem step_mem)
+{
+  sunindextype N;
+  int k, retval;
+
+  /* replace objects of a different size or too few pairs */
+  N = N_VGetLength(ark_mem->ewt);
+  if ((step_mem->J != NULL) &&
+      ((step_mem->N != N) ||
+       ((step_mem->npairs > 0) &&
+        (step_mem->LSc[step_mem->npairs - 1] == NULL))))
+  {
+    radauStep_FreeLinearAlgebra(step_mem);
+  }
+  step_mem->N = N;
+
+  if (step_mem->J == NULL)
+  {
+    step_mem->J   = SUNDenseMatrix(N, N, ark_mem->sunctx);
+    step_mem->Ar  = SUNDenseMatrix(N, N, ark_mem->sunctx);
+    step_mem->LSr = NULL;
+    if ((step_mem->J != NULL) && (step_mem->Ar != NULL))
+    {
+      step_mem->LSr = SUNLinSol_Dense(ark_mem->ewt, step_mem->Ar,
+                                      ark_mem->sunctx);
+    }
+    if (step_mem->LSr == NULL)
+    {
+      radauStep_FreeLinearAlgebra(step_mem);
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      "A memory request failed.");
+      return (ARK_MEM_FAIL);
+    }
+
+    for (k = 0; k < step_mem->npairs; k++)
+    {
+      step_mem->Ac[k] = SUNDenseMatrix(2 * N, 2 * N, ark_mem->sunctx);
+      step_mem->bc[k] = N_VNew_Serial(2 * N, ark_mem->sunctx);
+      step_mem->xc[k] = N_VNew_Serial(2 * N, ark_mem->sunctx);
+      if ((step_mem->Ac[k] != NULL) && (step_mem->bc[k] != NULL) &&
+          (step_mem->xc[k] != NULL))
+      {
+        step_mem->LSc[k] = SUNLinSol_Dense(step_mem->bc[k], step_mem->Ac[k],
+                                           ark_mem->sunctx);
+      }
+      if (step_mem->LSc[k] == NULL)
+      {
+        radauStep_FreeLinearAlgebra(step_mem);
+        arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                        "A memory request failed.");
+        return (ARK_MEM_FAIL);
+      }
+    }
+  }
+
+  /* Initialize the linear solvers */
+  retval = SUNLinSolInitialize(step_mem->LSr);
+  for (k = 0; (k < step_mem->npairs) && (retval == SUN_SUCCESS); k++)
+  {
+    retval = SUNLinSolInitialize(step_mem->LSc[k]);
+  }
+  if (retval != SUN_SUCCESS)
+  {
+    arkProcessError(ark_mem, ARK_LINIT_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_LINIT_FAIL);
+    return (ARK_LINIT_FAIL);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_FreeLinearAlgebra:
+
+  This routine frees the dense matrices, linear solvers and 2N
+  vectors created by radauStep_AllocLinearAlgebra.
+  ---------------------------------------------------------------*/
+static void radauStep_FreeLinearAlgebra(ARKodeRadauStepMem step_mem)
+{
+  int k;
+
+  if (step_mem->LSr != NULL) { SUNLinSolFree(step_mem->LSr); }
+  if (step_mem->Ar != NULL) { SUNMatDestroy(step_mem->Ar); }
+  if (step_mem->J != NULL) { SUNMatDestroy(step_mem->J); }
+  step_mem->LSr = NULL;
+  step_mem->Ar  = NULL;
+  step_mem->J   = NULL;
+
+  for (k = 0; k < RADAU_MAX_PAIRS; k++)
+  {
+    if (step_mem->LSc[k] != NULL) { SUNLinSolFree(step_mem->LSc[k]); }
+    if (step_mem->Ac[k] != NULL) { SUNMatDestroy(step_mem->Ac[k]); }
+    if (step_mem->bc[k] != NULL) { N_VDestroy(step_mem->bc[k]); }
+    if (step_mem->xc[k] != NULL) { N_VDestroy(step_mem->xc[k]); }
+    step_mem->LSc[k] = NULL;
+    step_mem->Ac[k]  = NULL;
+    step_mem->bc[k]  = NULL;
+    step_mem->xc[k]  = NULL;
+  }
+}
+
+/*---------------------------------------------------------------
+  radauStep_DQJac:
+
+  This routine approximates the dense Jacobian at (tn, yn) by
+  forward difference quotients, with the increments of
+  arkLsDenseDQJac. It uses tempv2 and tempv3 as work vectors and
+  returns the value of the last failed f call (or 0).
+  ---------------------------------------------------------------*/
+static int radauStep_DQJac(ARKodeMem ark_mem, ARKodeRadauStepMem step_mem)
+{
+  sunrealtype fnorm, minInc, inc, inc_inv, yjsaved, srur;
+  sunrealtype *y_data, *ewt_data, *f_data, *fy_data, *col_j;
+  sunindextype i, j, N;
+  int retval;
+
+  N = step_mem->N;
+
+  /* perturb a copy of yn */
+  N_VScale(ONE, ark_mem->yn, ark_mem->tempv2);
+  y_data   = N_VGetArrayPointer(ark_mem->tempv2);
+  ewt_data = N_VGetArrayPointer(ark_mem->ewt);
+  f_data   = N_VGetArrayPointer(ark_mem->tempv3);
+  fy_data  = N_VGetArrayPointer(ark_mem->fn);
+
+  /* Set minimum increment based on uround and norm of f */
+  srur   = SUNRsqrt(ark_mem->uround);
+  fnorm  = N_VWrmsNorm(ark_mem->fn, ark_mem->ewt);
+  minInc = (fnorm != ZERO) ? (RADAU_MIN_INC_MULT * SUNRabs(ark_mem->h) *
+                              ark_mem->uround * N * fnorm)
+                           : ONE;
+
+  for (j = 0; j < N; j++)
+  {
+    /* Generate the jth col of J(tn,yn) */
+    yjsaved   = y_data[j];
+    inc       = SUNMAX(srur * SUNRabs(yjsaved), minInc / ewt_data[j]);
+    y_data[j] += inc;
+
+    retval = step_mem->f(ark_mem->tn, ark_mem->tempv2, ark_mem->tempv3,
+                         ark_mem->user_data);
+    step_mem->nfe++;
+    if (retval != 0) { return (retval); }
+
+    y_data[j] = yjsaved;
+    inc_inv   = ONE / inc;
+    col_j     = SUNDenseMatrix_Column(step_mem->J, j);
+    for (i = 0; i < N; i++) { col_j[i] = inc_inv * (f_data[i] - fy_data[i]); }
+  }
+
+  return (0);
+}
+
+/*---------------------------------------------------------------
+  radauStep_Setup:
+
+  This routine forms the real system matrix gamma/h I - J and the
+  real forms of the complex system matrices from the saved
+  Jacobian, and factors them. It returns ARK_SUCCESS, CONV_FAIL
+  if a factorization failed recoverably (a singular matrix), or
+  ARK_LSETUP_FAIL.
+  ---------------------------------------------------------------*/
+static int radauStep_Setup(ARKodeMem ark_mem, ARKodeRadauStepMem step_mem)
+{
+  sunindextype i, j, N;
+  sunrealtype fac, afac, bfac;
+  sunrealtype *J_col, *A_col, *A_col2;
+  int k, retval;
+
+  N = step_mem->N;
+
+  /* gamma/h I - J */
+  fac = step_mem->gamma / ark_mem->h;
+  for (j = 0; j < N; j++)
+  {
+    J_col = SUNDenseMatrix_Column(step_mem->J, j);
+    A_col = SUNDenseMatrix_Column(step_mem->Ar, j);
+    for (i = 0; i < N; i++) { A_col[i] = -J_col[i]; }
+    A_col[j] += fac;
+  }
+  retval = SUNLinSolSetup(step_mem->LSr, step_mem->Ar);
+  step_mem->nsetups++;
+
+  /* [alpha/h I - J, -beta/h I; beta/h I, alpha/h I - J] */
+  for (k = 0; (k < step_mem->npairs) && (retval == SUN_SUCCESS); k++)
+  {
+    afac = step_mem->alpha[k] / ark_mem->h;
+    bfac = step_mem->beta[k] / ark_mem->h;
+    for (j = 0; j < N; j++)
+    {
+      J_col  = SUNDenseMatrix_Column(step_mem->J, j);
+      A_col  = SUNDenseMatrix_Column(step_mem->Ac[k], j);
+      A_col2 = SUNDenseMatrix_Column(step_mem->Ac[k], N + j);
+      for (i = 0; i < N; i++)
+      {
+        A_col[i]      = -J_col[i];
+        A_col[N + i]  = ZERO;
+        A_col2[i]     = ZERO;
+        A_col2[N + i] = -J_col[i];
+      }
+      A_col[j] += afac;
+      A_col[N + j]  = bfac;
+      A_col2[j]     = -bfac;
+      A_col2[N + j] += afac;
+    }
+    retval = SUNLinSolSetup(step_mem->LSc[k], step_mem->Ac[k]);
+    step_mem->nsetups++;
+  }
+
+  if (retval != SUN_SUCCESS)
+  {
+    step_mem->hsetup = ZERO;
+    return ((retval > 0) ? CONV_FAIL : ARK_LSETUP_FAIL);
+  }
+
+  step_mem->hsetup = ark_mem->h;
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_StartingValues:
+
+  This routine sets the starting values of the stage increments
+  Z and of W = T^{-1} Z. When Z holds the converged increments of
+  the step just accepted (or of the current step, rejected by the
+  error test), they are extrapolated with the collocation
+  polynomial p of that step, p(0) = 0, p(c_i) = Z_i, as
+
+    Z_i = p(theta0 + c_i r) - p(theta0),   r = h / hz,
+
+  with theta0 = 1 after an accepted step and 0 otherwise.
+  Otherwise the iteration starts from Z = 0.
+  ---------------------------------------------------------------*/
+static void radauStep_StartingValues(ARKodeMem ark_mem,
+                                     ARKodeRadauStepMem step_mem)
+{
+  int i, j, k, s;
+  sunrealtype theta0, r, theta, L;
+  N_Vector* Ztmp;
+
+  s = step_mem->stages;
+
+  if (step_mem->zvalid && (step_mem->nstz + 1 == ark_mem->nst))
+  {
+    theta0 = ONE;
+  }
+  else if (step_mem->zvalid && (step_mem->nstz == ark_mem->nst))
+  {
+    theta0 = ZERO;
+  }
+  else
+  {
+    for (i = 0; i < s; i++)
+    {
+      N_VConst(ZERO, step_mem->Z[i]);
+      N_VConst(ZERO, step_mem->W[i]);
+    }
+    return;
+  }
+
+  /* extrapolate into W (as work space), then swap W and Z */
+  r = ark_mem->h / step_mem->hz;
+  for (i = 0; i < s; i++)
+  {
+    theta = theta0 + step_mem->c[i] * r;
+    for (j = 0; j < s; j++)
+    {
+      /* Lagrange basis polynomial of c_j on the nodes 0, c_1, ..., c_s */
+      L = theta / step_mem->c[j];
+      for (k = 0; k < s; k++)
+      {
+        if (k == j) { continue; }
+        L *= (theta - step_mem->c[k]) / (step_mem->c[j] - step_mem->c[k]);
+      }
+      /* subtract p(theta0) (c_s = 1, so p(1) = Z_s) */
+      if ((theta0 == ONE) && (j == s - 1)) { L -= ONE; }
+      step_mem->cvals[j] = L;
+    }
+    (void)N_VLinearCombination(s, step_mem->cvals, step_mem->Z,
+                               step_mem->W[i]);
+  }
+  Ztmp        = step_mem->Z;
+  step_mem->Z = step_mem->W;
+  step_mem->W = Ztmp;
+
+  /* W = T^{-1} Z */
+  for (i = 0; i < s; i++)
+  {
+    for (j = 0; j < s; j++) { step_mem->cvals[j] = step_mem->Ti[i][j]; }
+    (void)N_VLinearCombination(s, step_mem->cvals, step_mem->Z,
+                               step_mem->W[i]);
+  }
+}
+
+/*---------------------------------------------------------------
+  radauStep_Nls:
+
+  This routine solves the stage equations with the simplified
+  Newton iteration
+
+    (h^{-1} Lambda (x) I - I (x) J) dW = (T^{-1} (x) I) F(Z)
+                                         - h^{-1} (Lambda (x) I) W,
+    W = W + dW,   Z = (T (x) I) W,
+
+  where F_i(Z) = f(tn + c_i h, yn + Z_i) and Lambda = T^{-1}
+  A^{-1} T. The block diagonal structure of Lambda decouples the
+  update into one real system and one complex system per pair,
+  whose right-hand sides are assembled in D. With the matrices
+  factored for hsetup (possibly != h) the iteration still
+  converges to the solution for h. The convergence test is that
+  of ARKStep: with del the RMS over the stages of the weighted
+  norms of dW and crate the estimated convergence rate, the
+  iteration has converged when del * min(1, crate) <= nlscoef.
+
+  The return value is ARK_SUCCESS, CONV_FAIL, RHSFUNC_RECVR,
+  ARK_LSOLVE_FAIL, or ARK_RHSFUNC_FAIL.
+  ---------------------------------------------------------------*/
+static int radauStep_Nls(ARKodeMem ark_mem, ARKodeRadauStepMem step_mem)
+{
+  int retval, i, j, k, m, s, kr, ki;
+  sunindextype N;
+  sunrealtype h, fac, afac, bfac, del, delp, crate, theta, dcon;
+  sunrealtype *re, *im, *xc, *bc;
+  sunrealtype* cvals;
+  N_Vector* Xvecs;
+
+  s     = step_mem->stages;
+  N     = step_mem->N;
+  h     = ark_mem->h;
+  cvals = step_mem->cvals;
+  Xvecs = step_mem->Xvecs;
+
+  crate = ONE;
+  theta = ZERO;
+  delp  = ZERO;
+  for (m = 0;; m++)
+  {
+    /* F_i = f(tn + c_i h, yn + Z_i) */
+    for (i = 0; i < s; i++)
+    {
+      N_VLinearSum(ONE, ark_mem->yn, ONE, step_mem->Z[i], ark_mem->ycur);
+      retval = step_mem->f(ark_mem->tn + step_mem->c[i] * h, ark_mem->ycur,
+                           step_mem->F[i], ark_mem->user_data);
+      step_mem->nfe++;
+      if (retval < 0) { return (ARK_RHSFUNC_FAIL); }
+      if (retval > 0) { return (RHSFUNC_RECVR); }
+    }
+
+    /* real system: (gamma/h I - J) dW_0 = (T^{-1} F)_0 - gamma/h W_0 */
+    fac = step_mem->gamma / h;
+    for (j = 0; j < s; j++)
+    {
+      cvals[j] = step_mem->Ti[0][j];
+      Xvecs[j] = step_mem->F[j];
+    }
+    cvals[s] = -fac;
+    Xvecs[s] = step_mem->W[0];
+    retval   = N_VLinearCombination(s + 1, cvals, Xvecs, ark_mem->tempv2);
+    if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+    retval = SUNLinSolSolve(step_mem->LSr, step_mem->Ar, step_mem->D[0],
+                            ark_mem->tempv2, ZERO);
+    if (retval < 0) { return (ARK_LSOLVE_FAIL); }
+    if (retval > 0) { return (CONV_FAIL); }
+
+    /* complex systems: ((alpha + i beta)/h I - J)(dW_kr + i dW_ki)
+       = (T^{-1} F)_kr + i (T^{-1} F)_ki - (alpha + i beta)/h (W_kr + i W_ki) */
+    for (k = 0; k < step_mem->npairs; k++)
+    {
+      kr   = 1 + 2 * k;
+      ki   = kr + 1;
+      afac = step_mem->alpha[k] / h;
+      bfac = step_mem->beta[k] / h;
+
+      for (j = 0; j < s; j++) { cvals[j] = step_mem->Ti[kr][j]; }
+      cvals[s]     = -afac;
+      Xvecs[s]     = step_mem->W[kr];
+      cvals[s + 1] = bfac;
+      Xvecs[s + 1] = step_mem->W[ki];
+      retval = N_VLinearCombination(s + 2, cvals, Xvecs, step_mem->D[kr]);
+      if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+      for (j = 0; j < s; j++) { cvals[j] = step_mem->Ti[ki][j]; }
+      cvals[s]     = -bfac;
+      cvals[s + 1] = -afac;
+      retval = N_VLinearCombination(s + 2, cvals, Xvecs, step_mem->D[ki]);
+      if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+      /* solve the real form of the complex system */
+      re = N_VGetArrayPointer(step_mem->D[kr]);
+      im = N_VGetArrayPointer(step_mem->D[ki]);
+      bc = N_VGetArrayPointer(step_mem->bc[k]);
+      xc = N_VGetArrayPointer(step_mem->xc[k]);
+      memcpy(bc, re, N * sizeof(sunrealtype));
+      memcpy(bc + N, im, N * sizeof(sunrealtype));
+
+      retval = SUNLinSolSolve(step_mem->LSc[k], step_mem->Ac[k],
+                              step_mem->xc[k], step_mem->bc[k], ZERO);
+      if (retval < 0) { return (ARK_LSOLVE_FAIL); }
+      if (retval > 0) { return (CONV_FAIL); }
+
+      memcpy(re, xc, N * sizeof(sunrealtype));
+      memcpy(im, xc + N, N * sizeof(sunrealtype));
+    }
+    step_mem->nni++;
+
+    /* W = W + dW and the RMS norm of the update */
+    del = ZERO;
+    for (i = 0; i < s; i++)
+    {
+      N_VLinearSum(ONE, step_mem->W[i], ONE, step_mem->D[i], step_mem->W[i]);
+      dcon = N_VWrmsNorm(step_mem->D[i], ark_mem->ewt);
+      del += dcon * dcon;
+    }
+    del = SUNRsqrt(del / s);
+
+    /* Z = T W */
+    for (i = 0; i < s; i++)
+    {
+      for (j = 0; j < s; j++) { cvals[j] = step_mem->T[i][j]; }
+      retval = N_VLinearCombination(s, cvals, step_mem->W, step_mem->Z[i]);
+      if (retval != 0) { return (ARK_VECTOROP_ERR); }
+    }
+
+    /* convergence and divergence tests */
+    if (m > 0)
+    {
+      theta = del / delp;
+      crate = SUNMAX(step_mem->crdown * crate, theta);
+    }
+    dcon = del * SUNMIN(ONE, crate) / step_mem->nlscoef;
+    if (dcon <= ONE)
+    {
+      /* record the converged increments and the Jacobian age */
+      step_mem->zvalid = SUNTRUE;
+      step_mem->nstz   = ark_mem->nst;
+      step_mem->hz     = h;
+      step_mem->jold   = (theta > step_mem->thet);
+      return (ARK_SUCCESS);
+    }
+    if ((m + 1 >= step_mem->maxcor) ||
+        ((m > 0) && (del > step_mem->rdiv * delp)))
+    {
+      step_mem->zvalid = SUNFALSE;
+      return (CONV_FAIL);
+    }
+    delp = del;
+  }
+}
+
+/*---------------------------------------------------------------
+  radauStep_ErrorEstimate:
+
+  This routine computes the error estimate
+
+    err = (gamma/h I - J)^{-1} (fy + sum_i dd_i/h Z_i)
+
+  in tempv1 and its weighted norm in dsmPtr, where fy = f(tn, yn)
+  or, when reestimating, f(tn, yn + err). As the factorization is
+  for hsetup, the result is scaled by h / hsetup, which is exact
+  for nonstiff components and conservative for stiff ones.
+  ---------------------------------------------------------------*/
+static int radauStep_ErrorEstimate(ARKodeMem ark_mem,
+                                   ARKodeRadauStepMem step_mem, N_Vector fy,
+                                   sunrealtype* dsmPtr)
+{
+  int retval, i, s;
+
+  s = step_mem->stages;
+
+  step_mem->cvals[0] = ONE;
+  step_mem->Xvecs[0] = fy;
+  for (i = 0; i < s; i++)
+  {
+    step_mem->cvals[i + 1] = step_mem->dd[i] / ark_mem->h;
+    step_mem->Xvecs[i + 1] = step_mem->Z[i];
+  }
+  retval = N_VLinearCombination(s + 1, step_mem->cvals, step_mem->Xvecs,
+                                ark_mem->tempv2);
+  if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+  retval = SUNLinSolSolve(step_mem->LSr, step_mem->Ar, ark_mem->tempv1,
+                          ark_mem->tempv2, ZERO);
+  if (retval != 0) { return (ARK_LSOLVE_FAIL); }
+  N_VScale(ark_mem->h / step_mem->hsetup, ark_mem->tempv1, ark_mem->tempv1);
+
+  *dsmPtr = N_VWrmsNorm(ark_mem->tempv1, ark_mem->ewt);
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
@@ -0,0 +1,183 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * Implementation header file for ARKODE's fully implicit Radau
+ * IIA time stepper module.
+ *--------------------------------------------------------------*/
+
+#ifndef _ARKODE_RADAUSTEP_IMPL_H
+#define _ARKODE_RADAUSTEP_IMPL_H
+
+#include <arkode/arkode_radaustep.h>
+
+#include "arkode_impl.h"
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*===============================================================
+  Radau time step module constants
+  ===============================================================*/
+
+/* default method, maximum number of stages and complex pairs */
+#define RADAU_DEFAULT_METHOD ARKODE_RADAU_3_5
+#define RADAU_MAX_STAGES     5
+#define RADAU_MAX_PAIRS      2
+
+/* Newton iteration parameters (as in RADAU5 of Hairer and Wanner) */
+#define RADAU_NLSCOEF SUN_RCONST(0.03)
+#define RADAU_MAXCOR  7
+#define RADAU_CRDOWN  SUN_RCONST(0.3)
+#define RADAU_RDIV    SUN_RCONST(2.3)
+
+/* Jacobian reuse threshold on the Newton convergence rate */
+#define RADAU_THET SUN_RCONST(0.001)
+
+/* range of h / hsetup in which the factorizations are reused */
+#define RADAU_QUOT1 SUN_RCONST(1.0)
+#define RADAU_QUOT2 SUN_RCONST(1.2)
+
+/* minimum increment factor of the difference quotient Jacobian */
+#define RADAU_MIN_INC_MULT SUN_RCONST(1000.0)
+
+/*===============================================================
+  Radau time step module data structure
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  Types : struct ARKodeRadauStepMemRec, ARKodeRadauStepMem
+  ---------------------------------------------------------------
+  The type ARKodeRadauStepMem is type pointer to struct
+  ARKodeRadauStepMemRec.  This structure contains fields to
+  perform a Radau IIA time step: a simplified Newton iteration
+  on the transformed stage increments W = T^{-1} Z, in which the
+  real eigenvalue of A^{-1} gives one real N x N system and each
+  complex pair one complex system, solved in real form as a
+  2N x 2N system. The dense Jacobian is held across steps.
+  ---------------------------------------------------------------*/
+typedef struct ARKodeRadauStepMemRec
+{
+  /* Radau problem specification */
+  ARKRhsFn f;     /* y' = f(t,y)                        */
+  ARKLsJacFn jac; /* Jacobian of f (NULL for DQ approx) */
+
+  /* Radau method */
+  ARKODE_RadauMethodType method; /* method type                  */
+  int stages;                    /* number of stages             */
+  int npairs;                    /* number of complex pairs      */
+  int q;                         /* method order                 */
+  int p;                         /* embedding order              */
+  sunrealtype c[RADAU_MAX_STAGES];                     /* nodes       */
+  sunrealtype T[RADAU_MAX_STAGES][RADAU_MAX_STAGES];   /* eigenbasis  */
+  sunrealtype Ti[RADAU_MAX_STAGES][RADAU_MAX_STAGES];  /* inverse     */
+  sunrealtype dd[RADAU_MAX_STAGES];                    /* error coefs */
+  sunrealtype gamma;                   /* real eigenvalue of A^{-1} */
+  sunrealtype alpha[RADAU_MAX_PAIRS];  /* complex eigenvalues       */
+  sunrealtype beta[RADAU_MAX_PAIRS];   /*   alpha +/- i beta        */
+
+  /* Radau stage vectors */
+  N_Vector* Z;   /* stage increments Y_i - yn             */
+  N_Vector* W;   /* transformed stage increments          */
+  N_Vector* F;   /* f at the stages                       */
+  N_Vector* D;   /* Newton right-hand sides and updates   */
+  int vec_alloc; /* number of allocated stage vectors     */
+
+  /* Dense linear algebra (created by the module) */
+  sunindextype N;                       /* problem size              */
+  SUNMatrix J;                          /* saved Jacobian            */
+  SUNMatrix Ar;                         /* gamma/h I - J             */
+  SUNLinearSolver LSr;                  /* real system solver        */
+  SUNMatrix Ac[RADAU_MAX_PAIRS];        /* real forms, 2N x 2N       */
+  SUNLinearSolver LSc[RADAU_MAX_PAIRS]; /* complex system solvers    */
+  N_Vector bc[RADAU_MAX_PAIRS];         /* 2N right-hand sides       */
+  N_Vector xc[RADAU_MAX_PAIRS];         /* 2N solutions              */
+
+  /* Jacobian and factorization heuristics */
+  sunbooleantype jbad; /* Jacobian must be reevaluated         */
+  sunbooleantype jold; /* last Newton rate exceeded thet       */
+  long int nstlj;      /* step of the last J evaluation        */
+  sunrealtype thet;    /* Jacobian reuse threshold             */
+  sunrealtype hsetup;  /* step size of the factorizations      */
+
+  /* Starting values from the last converged Newton iteration */
+  sunbooleantype zvalid; /* Z holds converged stage increments */
+  long int nstz;         /* step of the converged increments   */
+  sunrealtype hz;        /* step size of the increments        */
+
+  /* Newton parameters */
+  sunrealtype nlscoef; /* convergence test coefficient     */
+  int maxcor;          /* max Newton iterations            */
+  sunrealtype crdown;  /* convergence rate constant        */
+  sunrealtype rdiv;    /* divergence test constant         */
+
+  /* Counters */
+  long int nfe;     /* num f calls                      */
+  long int nje;     /* num Jacobian evaluations         */
+  long int nsetups; /* num factorization setups         */
+  long int nni;     /* num Newton iterations            */
+  long int nncf;    /* num Newton failures              */
+
+  /* Reusable arrays for fused vector operations */
+  sunrealtype cvals[RADAU_MAX_STAGES + 2];
+  N_Vector Xvecs[RADAU_MAX_STAGES + 2];
+
+}* ARKodeRadauStepMem;
+
+/*===============================================================
+  Radau time step module private function prototypes
+  ===============================================================*/
+
+/* Interface routines supplied to ARKODE */
+int radauStep_Init(ARKodeMem ark_mem, int init_type);
+int radauStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
+                      int mode);
+int radauStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr);
+int radauStep_SetDefaults(ARKodeMem ark_mem);
+int radauStep_SetNonlinCRDown(ARKodeMem ark_mem, sunrealtype crdown);
+int radauStep_SetNonlinRDiv(ARKodeMem ark_mem, sunrealtype rdiv);
+int radauStep_SetMaxNonlinIters(ARKodeMem ark_mem, int maxcor);
+int radauStep_SetNonlinConvCoef(ARKodeMem ark_mem, sunrealtype nlscoef);
+int radauStep_GetNumLinSolvSetups(ARKodeMem ark_mem, long int* nlinsetups);
+int radauStep_GetNumNonlinSolvIters(ARKodeMem ark_mem, long int* nniters);
+int radauStep_GetNumNonlinSolvConvFails(ARKodeMem ark_mem, long int* nnfails);
+int radauStep_GetNonlinSolvStats(ARKodeMem ark_mem, long int* nniters,
+                                 long int* nnfails);
+int radauStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile,
+                            SUNOutputFormat fmt);
+int radauStep_WriteParameters(ARKodeMem ark_mem, FILE* fp);
+int radauStep_Resize(ARKodeMem ark_mem, N_Vector y0, sunrealtype hscale,
+                     sunrealtype t0, ARKVecResizeFn resize, void* resize_data);
+void radauStep_Free(ARKodeMem ark_mem);
+void radauStep_PrintMem(ARKodeMem ark_mem, FILE* outfile);
+int radauStep_GetEstLocalErrors(ARKodeMem ark_mem, N_Vector ele);
+
+/* Internal utility routines */
+int radauStep_AccessARKODEStepMem(void* arkode_mem, const char* fname,
+                                  ARKodeMem* ark_mem,
+                                  ARKodeRadauStepMem* step_mem);
+int radauStep_AccessStepMem(ARKodeMem ark_mem, const char* fname,
+                            ARKodeRadauStepMem* step_mem);
+sunbooleantype radauStep_CheckNVector(N_Vector tmpl);
+int radauStep_SetMethodProperties(ARKodeMem ark_mem);
+
+/*===============================================================
+  Reusable RadauStep Error Messages
+  ===============================================================*/
+
+/* Initialization and I/O error messages */
+#define MSG_RADAUSTEP_NO_MEM "Time step module memory is NULL."
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,516 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * This is the implementation file for the optional input and
+ * output functions for the ARKODE RadauStep time stepper module.
+ *--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/sundials_math.h>
+#include <sundials/sundials_types.h>
+
+#include "arkode_radaustep_impl.h"
+
+/*===============================================================
+  Exported Jacobian interface functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  RadauStepSetJacFn:
+
+  Specifies the Jacobian function of f, which fills the dense
+  matrix created by the module. A NULL value selects the internal
+  difference quotient approximation.
+  ---------------------------------------------------------------*/
+int RadauStepSetJacFn(void* arkode_mem, ARKLsJacFn jac)
+{
+  ARKodeMem ark_mem;
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeRadauStepMem structures */
+  retval = radauStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  step_mem->jac  = jac;
+  step_mem->jbad = SUNTRUE;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Exported optional input functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  RadauStepSetMethod:
+
+  Specifies the Radau IIA method.
+  ---------------------------------------------------------------*/
+int RadauStepSetMethod(void* arkode_mem, ARKODE_RadauMethodType method)
+{
+  ARKodeMem ark_mem;
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeRadauStepMem structures */
+  retval = radauStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  switch (method)
+  {
+  case ARKODE_RADAU_3_5:
+  case ARKODE_RADAU_5_9: break;
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid Radau method type");
+    return (ARK_ILL_INPUT);
+  }
+
+  step_mem->method = method;
+
+  return (radauStep_SetMethodProperties(ark_mem));
+}
+
+/*---------------------------------------------------------------
+  RadauStepSetMethodByName:
+
+  Specifies the Radau IIA method by its enumeration name.
+  ---------------------------------------------------------------*/
+int RadauStepSetMethodByName(void* arkode_mem, const char* emethod)
+{
+  if (emethod == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Method name is NULL");
+    return (ARK_ILL_INPUT);
+  }
+
+  if (strcmp(emethod, "ARKODE_RADAU_3_5") == 0)
+  {
+    return (RadauStepSetMethod(arkode_mem, ARKODE_RADAU_3_5));
+  }
+  if (strcmp(emethod, "ARKODE_RADAU_5_9") == 0)
+  {
+    return (RadauStepSetMethod(arkode_mem, ARKODE_RADAU_5_9));
+  }
+
+  arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                  "Unknown method name");
+  return (ARK_ILL_INPUT);
+}
+
+/*---------------------------------------------------------------
+  RadauStepSetJacReuseThreshold:
+
+  Specifies the Newton convergence rate above which the Jacobian
+  is reevaluated in the next step (RADAU5's THET). A negative
+  value implies an evaluation in each step; a zero value implies
+  a reset to the default.
+  ---------------------------------------------------------------*/
+int RadauStepSetJacReuseThreshold(void* arkode_mem, sunrealtype thet)
+{
+  ARKodeMem ark_mem;
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeRadauStepMem structures */
+  retval = radauStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  step_mem->thet = (thet == ZERO) ? RADAU_THET : thet;
+
+  return (ARK_SUCCESS);
+}
+/*===============================================================
+  Exported optional output functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  RadauStepGetNumRhsEvals:
+
+  Returns the current number of calls to f
+  ---------------------------------------------------------------*/
+int RadauStepGetNumRhsEvals(void* arkode_mem, long int* fevals)
+{
+  ARKodeMem ark_mem;
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeRadauStepMem structures */
+  retval = radauStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get values from step_mem */
+  *fevals = step_mem->nfe;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  RadauStepGetNumJacEvals:
+
+  Returns the current number of calls to the Jacobian function
+  ---------------------------------------------------------------*/
+int RadauStepGetNumJacEvals(void* arkode_mem, long int* njevals)
+{
+  ARKodeMem ark_mem;
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeRadauStepMem structures */
+  retval = radauStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                         &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get values from step_mem */
+  *njevals = step_mem->nje;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Private functions attached to ARKODE
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  radauStep_SetDefaults:
+
+  Resets all RadauStep optional inputs to their default values.
+  Does not change problem-defining function pointers, the
+  Jacobian function or the
+  user_data pointer.
+  ---------------------------------------------------------------*/
+int radauStep_SetDefaults(ARKodeMem ark_mem)
+{
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Set default values for integrator optional inputs */
+  step_mem->method      = RADAU_DEFAULT_METHOD;
+  step_mem->thet        = RADAU_THET;
+  step_mem->nlscoef     = RADAU_NLSCOEF;
+  step_mem->maxcor      = RADAU_MAXCOR;
+  step_mem->crdown      = RADAU_CRDOWN;
+  step_mem->rdiv        = RADAU_RDIV;
+
+  return (radauStep_SetMethodProperties(ark_mem));
+}
+
+/*---------------------------------------------------------------
+  radauStep_SetNonlinCRDown:
+
+  Specifies the user-provided Newton convergence rate
+  constant crdown.  Legal values are strictly positive; illegal
+  values imply a reset to the default.
+  ---------------------------------------------------------------*/
+int radauStep_SetNonlinCRDown(ARKodeMem ark_mem, sunrealtype crdown)
+{
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* if argument legal set it, otherwise set default */
+  if (crdown <= ZERO) { step_mem->crdown = RADAU_CRDOWN; }
+  else { step_mem->crdown = crdown; }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_SetNonlinRDiv:
+
+  Specifies the user-provided Newton divergence threshold
+  rdiv.  Legal values are strictly positive; illegal values imply
+  a reset to the default.
+  ---------------------------------------------------------------*/
+int radauStep_SetNonlinRDiv(ARKodeMem ark_mem, sunrealtype rdiv)
+{
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* if argument legal set it, otherwise set default */
+  if (rdiv <= ZERO) { step_mem->rdiv = RADAU_RDIV; }
+  else { step_mem->rdiv = rdiv; }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_SetMaxNonlinIters:
+
+  Sets the maximum number of Newton iterations per step.
+  Non-positive values imply a reset to the default.
+  ---------------------------------------------------------------*/
+int radauStep_SetMaxNonlinIters(ARKodeMem ark_mem, int maxcor)
+{
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* if argument legal set it, otherwise set default */
+  if (maxcor <= 0) { step_mem->maxcor = RADAU_MAXCOR; }
+  else { step_mem->maxcor = maxcor; }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_SetNonlinConvCoef:
+
+  Specifies the coefficient in the Newton convergence test.
+  Non-positive values imply a reset to the default.
+  ---------------------------------------------------------------*/
+int radauStep_SetNonlinConvCoef(ARKodeMem ark_mem, sunrealtype nlscoef)
+{
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* if argument legal set it, otherwise set default */
+  if (nlscoef <= ZERO) { step_mem->nlscoef = RADAU_NLSCOEF; }
+  else { step_mem->nlscoef = nlscoef; }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_GetNumLinSolvSetups:
+
+  Returns the current number of factorizations (one real and
+  one per complex pair in each setup)
+  ---------------------------------------------------------------*/
+int radauStep_GetNumLinSolvSetups(ARKodeMem ark_mem, long int* nlinsetups)
+{
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get value from step_mem */
+  *nlinsetups = step_mem->nsetups;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_GetNumNonlinSolvIters:
+
+  Returns the current number of Newton iterations (each with
+  one real and one complex solve per pair)
+  ---------------------------------------------------------------*/
+int radauStep_GetNumNonlinSolvIters(ARKodeMem ark_mem, long int* nniters)
+{
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  *nniters = step_mem->nni;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_GetNumNonlinSolvConvFails:
+
+  Returns the current number of failed corrector iterations
+  ---------------------------------------------------------------*/
+int radauStep_GetNumNonlinSolvConvFails(ARKodeMem ark_mem, long int* nnfails)
+{
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  *nnfails = step_mem->nncf;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_GetNonlinSolvStats:
+
+  Returns Newton iteration statistics
+  ---------------------------------------------------------------*/
+int radauStep_GetNonlinSolvStats(ARKodeMem ark_mem, long int* nniters,
+                                 long int* nnfails)
+{
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  *nniters = step_mem->nni;
+  *nnfails = step_mem->nncf;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_GetEstLocalErrors: Returns the current local truncation
+  error estimate vector
+  ---------------------------------------------------------------*/
+int radauStep_GetEstLocalErrors(ARKodeMem ark_mem, N_Vector ele)
+{
+  int retval;
+  ARKodeRadauStepMem step_mem;
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* return an error if local truncation error is not computed */
+  if (ark_mem->fixedstep) { return (ARK_STEPPER_UNSUPPORTED); }
+
+  /* otherwise, copy local truncation error vector to output */
+  N_VScale(ONE, ark_mem->tempv1, ele);
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_PrintAllStats:
+
+  Prints integrator statistics
+  ---------------------------------------------------------------*/
+int radauStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile,
+                            SUNOutputFormat fmt)
+{
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  switch (fmt)
+  {
+  case SUN_OUTPUTFORMAT_TABLE:
+    /* function evaluations */
+    fprintf(outfile, "RHS fn evals                 = %ld\n", step_mem->nfe);
+
+    /* nonlinear and linear solver stats */
+    fprintf(outfile, "NLS iters                    = %ld\n", step_mem->nni);
+    fprintf(outfile, "NLS fails                    = %ld\n", step_mem->nncf);
+    if (ark_mem->nst > 0)
+    {
+      fprintf(outfile, "NLS iters per step           = %" RSYM "\n",
+              (sunrealtype)step_mem->nni / (sunrealtype)ark_mem->nst);
+    }
+    fprintf(outfile, "LS setups                    = %ld\n", step_mem->nsetups);
+    fprintf(outfile, "Jac fn evals                 = %ld\n", step_mem->nje);
+    if (ark_mem->nst > 0)
+    {
+      fprintf(outfile, "Jac evals per step           = %" RSYM "\n",
+              (sunrealtype)step_mem->nje / (sunrealtype)ark_mem->nst);
+    }
+    break;
+
+  case SUN_OUTPUTFORMAT_CSV:
+    /* function evaluations */
+    fprintf(outfile, ",RHS fn evals,%ld", step_mem->nfe);
+
+    /* nonlinear and linear solver stats */
+    fprintf(outfile, ",NLS iters,%ld", step_mem->nni);
+    fprintf(outfile, ",NLS fails,%ld", step_mem->nncf);
+    if (ark_mem->nst > 0)
+    {
+      fprintf(outfile, ",NLS iters per step,%" RSYM,
+              (sunrealtype)step_mem->nni / (sunrealtype)ark_mem->nst);
+    }
+    else { fprintf(outfile, ",NLS iters per step,0"); }
+    fprintf(outfile, ",LS setups,%ld", step_mem->nsetups);
+    fprintf(outfile, ",Jac fn evals,%ld", step_mem->nje);
+    if (ark_mem->nst > 0)
+    {
+      fprintf(outfile, ",Jac evals per step,%" RSYM,
+              (sunrealtype)step_mem->nje / (sunrealtype)ark_mem->nst);
+    }
+    else { fprintf(outfile, ",Jac evals per step,0"); }
+    fprintf(outfile, "\n");
+    break;
+
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid formatting option.");
+    return (ARK_ILL_INPUT);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  radauStep_WriteParameters:
+
+  Outputs all solver parameters to the provided file pointer.
+  ---------------------------------------------------------------*/
+int radauStep_WriteParameters(ARKodeMem ark_mem, FILE* fp)
+{
+  ARKodeRadauStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRadauStepMem structure */
+  retval = radauStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* print integrator parameters to file */
+  fprintf(fp, "RadauStep time step module parameters:\n");
+  switch (step_mem->method)
+  {
+  case ARKODE_RADAU_3_5: fprintf(fp, "  Radau IIA 3-stage"); break;
+  case ARKODE_RADAU_5_9: fprintf(fp, "  Radau IIA 5-stage"); break;
+  default: fprintf(fp, "  Radau IIA unknown"); break;
+  }
+  fprintf(fp, " (order %i, embedding order %i, %i complex pairs)\n",
+          step_mem->q, step_mem->p, step_mem->npairs);
+  fprintf(fp, "  Jacobian reuse threshold = %" RSYM "\n", step_mem->thet);
+  fprintf(fp, "  Newton convergence coefficient = %" RSYM "\n",
+          step_mem->nlscoef);
+  fprintf(fp, "  Maximum Newton iterations = %i\n", step_mem->maxcor);
+  fprintf(fp, "  Newton rate constant = %" RSYM "\n", step_mem->crdown);
+  fprintf(fp, "  Newton divergence constant = %" RSYM "\n", step_mem->rdiv);
+  fprintf(fp, "\n");
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
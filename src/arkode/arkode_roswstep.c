@@ -0,0 +1,1071 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * This is the implementation file for ARKODE's Rosenbrock-W
+ * (RosW) time stepper module.
+ *
+ * The stages are linearly implicit: each one requires a single
+ * solve with the matrix I - h gamma J, where J is (an
+ * approximation of) the Jacobian of f. The linear systems are
+ * set up and solved by the ARKLS interface, so the same matrix,
+ * linear solver, Jacobian and preconditioner options as for
+ * ARKStep are available. Since the methods are W-methods, the
+ * Jacobian may be out of date without reducing the order of
+ * accuracy, and the factorization of I - h gamma J is shared by
+ * all stages of a step and reused across steps while h is fixed.
+ *--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/sundials_context.h>
+#include <sundials/sundials_math.h>
+
+#include "arkode_impl.h"
+#include "arkode_interp_impl.h"
+#include "arkode_roswstep_impl.h"
+
+/*===============================================================
+  RosW method coefficients
+
+  The methods are given in the standard Rosenbrock form
+  (Hairer and Wanner, Solving ODEs II, Sec. IV.7) by the stage
+  coefficient matrices alpha (strictly lower triangular) and
+  Gamma (lower triangular with constant diagonal), the solution
+  weights b and the embedding weights bhat.
+  ===============================================================*/
+
+/* ROS2 of Verwer et al. (SIAM J. Sci. Comput., 20(4), 1999):
+   order 2 with a first order embedding */
+#define ROS2_GAMMA (ONE + ONE / SUNRsqrt(TWO))
+
+/* ROS34PW2 of Rang and Angermann (BIT, 45(4), 2005): order 3 with
+   a second order embedding, both W-methods of order 2 */
+static const sunrealtype ros34pw2_alpha[4][4] = {
+  {SUN_RCONST(0.0), SUN_RCONST(0.0), SUN_RCONST(0.0), SUN_RCONST(0.0)},
+  {SUN_RCONST(8.7173304301691801e-01), SUN_RCONST(0.0), SUN_RCONST(0.0),
+   SUN_RCONST(0.0)},
+  {SUN_RCONST(8.4457060015369423e-01), SUN_RCONST(-1.1299064236484185e-01),
+   SUN_RCONST(0.0), SUN_RCONST(0.0)},
+  {SUN_RCONST(0.0), SUN_RCONST(0.0), SUN_RCONST(1.0), SUN_RCONST(0.0)}};
+static const sunrealtype ros34pw2_Gamma[4][4] = {
+  {SUN_RCONST(4.3586652150845900e-01), SUN_RCONST(0.0), SUN_RCONST(0.0),
+   SUN_RCONST(0.0)},
+  {SUN_RCONST(-8.7173304301691801e-01), SUN_RCONST(4.3586652150845900e-01),
+   SUN_RCONST(0.0), SUN_RCONST(0.0)},
+  {SUN_RCONST(-9.0338057013044082e-01), SUN_RCONST(5.4180672388095326e-02),
+   SUN_RCONST(4.3586652150845900e-01), SUN_RCONST(0.0)},
+  {SUN_RCONST(2.4212380706095346e-01), SUN_RCONST(-1.2232505839045147e+00),
+   SUN_RCONST(5.4526025533510214e-01), SUN_RCONST(4.3586652150845900e-01)}};
+static const sunrealtype ros34pw2_b[4] = {SUN_RCONST(2.4212380706095346e-01),
+                                          SUN_RCONST(-1.2232505839045147e+00),
+                                          SUN_RCONST(1.5452602553351020e+00),
+                                          SUN_RCONST(4.3586652150845900e-01)};
+static const sunrealtype ros34pw2_bhat[4] = {SUN_RCONST(3.7810903145819369e-01),
+                                             SUN_RCONST(-9.6042292212423178e-02),
+                                             SUN_RCONST(0.5),
+                                             SUN_RCONST(2.1793326075422950e-01)};
+
+/*===============================================================
+  Exported functions
+  ===============================================================*/
+
+void* RosWStepCreate(ARKRhsFn f, sunrealtype t0, N_Vector y0, SUNContext sunctx)
+{
+  ARKodeMem ark_mem;
+  ARKodeRosWStepMem step_mem;
+  sunbooleantype nvectorOK;
+  int retval;
+
+  /* Check that f is supplied */
+  if (f == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_F);
+    return (NULL);
+  }
+
+  /* Check for legal input parameters */
+  if (y0 == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_Y0);
+    return (NULL);
+  }
+
+  if (!sunctx)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_SUNCTX);
+    return (NULL);
+  }
+
+  /* Test if all required vector operations are implemented */
+  nvectorOK = rosWStep_CheckNVector(y0);
+  if (!nvectorOK)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_BAD_NVECTOR);
+    return (NULL);
+  }
+
+  /* Create ark_mem structure and set default values */
+  ark_mem = arkCreate(sunctx);
+  if (ark_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (NULL);
+  }
+
+  /* Allocate ARKodeRosWStepMem structure, and initialize to zero */
+  step_mem = NULL;
+  step_mem = (ARKodeRosWStepMem)malloc(sizeof(struct ARKodeRosWStepMemRec));
+  if (step_mem == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_ARKMEM_FAIL);
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+  memset(step_mem, 0, sizeof(struct ARKodeRosWStepMemRec));
+
+  /* Attach step_mem structure and function pointers to ark_mem */
+  ark_mem->step_attachlinsol        = rosWStep_AttachLinsol;
+  ark_mem->step_disablelsetup       = rosWStep_DisableLSetup;
+  ark_mem->step_getlinmem           = rosWStep_GetLmem;
+  ark_mem->step_getimplicitrhs      = rosWStep_GetImplicitRHS;
+  ark_mem->step_getgammas           = rosWStep_GetGammas;
+  ark_mem->step_init                = rosWStep_Init;
+  ark_mem->step_fullrhs             = rosWStep_FullRHS;
+  ark_mem->step                     = rosWStep_TakeStep;
+  ark_mem->step_setuserdata         = rosWStep_SetUserData;
+  ark_mem->step_printallstats       = rosWStep_PrintAllStats;
+  ark_mem->step_writeparameters     = rosWStep_WriteParameters;
+  ark_mem->step_resize              = rosWStep_Resize;
+  ark_mem->step_free                = rosWStep_Free;
+  ark_mem->step_printmem            = rosWStep_PrintMem;
+  ark_mem->step_setdefaults         = rosWStep_SetDefaults;
+  ark_mem->step_setautonomous       = rosWStep_SetAutonomous;
+  ark_mem->step_setlsetupfrequency  = rosWStep_SetLSetupFrequency;
+  ark_mem->step_getnumlinsolvsetups = rosWStep_GetNumLinSolvSetups;
+  ark_mem->step_getcurrentgamma     = rosWStep_GetCurrentGamma;
+  ark_mem->step_getestlocalerrors   = rosWStep_GetEstLocalErrors;
+  ark_mem->step_supports_adaptive   = SUNTRUE;
+  ark_mem->step_supports_implicit   = SUNTRUE;
+  ark_mem->step_mem                 = (void*)step_mem;
+
+  /* Set default values for optional inputs */
+  retval = rosWStep_SetDefaults((void*)ark_mem);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Error setting default solver options");
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+
+  /* Copy the input parameters into ARKODE state */
+  step_mem->f = f;
+
+  /* Update the ARKODE workspace requirements */
+  ark_mem->liw += 14; /* fcn ptrs, ints, long ints */
+  ark_mem->lrw += 4;
+
+  /* Set the linear solver addresses to NULL (we check != NULL later) */
+  step_mem->linit  = NULL;
+  step_mem->lsetup = NULL;
+  step_mem->lsolve = NULL;
+  step_mem->lfree  = NULL;
+  step_mem->lmem   = NULL;
+
+  /* Initialize all the counters */
+  step_mem->nfe     = 0;
+  step_mem->nsetups = 0;
+  step_mem->nsolves = 0;
+  step_mem->nstlp   = 0;
+
+  /* Initialize main ARKODE infrastructure */
+  retval = arkInit(ark_mem, t0, y0, FIRST_INIT);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Unable to initialize main ARKODE infrastructure");
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+
+  return ((void*)ark_mem);
+}
+
+/*---------------------------------------------------------------
+  RosWStepReInit:
+
+  This routine re-initializes the RosWStep module to solve a new
+  problem of the same size as was previously solved. This routine
+  should also be called when the problem dynamics or desired solvers
+  have changed dramatically, so that the problem integration should
+  resume as if started from scratch.
+
+  Note all internal counters are set to 0 on re-initialization.
+  ---------------------------------------------------------------*/
+int RosWStepReInit(void* arkode_mem, ARKRhsFn f, sunrealtype t0, N_Vector y0)
+{
+  ARKodeMem ark_mem;
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Check if ark_mem was allocated */
+  if (ark_mem->MallocDone == SUNFALSE)
+  {
+    arkProcessError(ark_mem, ARK_NO_MALLOC, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MALLOC);
+    return (ARK_NO_MALLOC);
+  }
+
+  /* Check that f is supplied */
+  if (f == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_F);
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Check for legal input parameters */
+  if (y0 == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_Y0);
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Copy the input parameters into ARKODE state */
+  step_mem->f = f;
+
+  /* Initialize main ARKODE infrastructure */
+  retval = arkInit(arkode_mem, t0, y0, FIRST_INIT);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Unable to initialize main ARKODE infrastructure");
+    return (retval);
+  }
+
+  /* Initialize all the counters */
+  step_mem->nfe     = 0;
+  step_mem->nsetups = 0;
+  step_mem->nsolves = 0;
+  step_mem->nstlp   = 0;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Interface routines supplied to ARKODE
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  rosWStep_Resize:
+
+  This routine resizes the stage vectors (if allocated).
+  ---------------------------------------------------------------*/
+int rosWStep_Resize(ARKodeMem ark_mem, N_Vector y0,
+                    SUNDIALS_MAYBE_UNUSED sunrealtype hscale,
+                    SUNDIALS_MAYBE_UNUSED sunrealtype t0,
+                    ARKVecResizeFn resize, void* resize_data)
+{
+  ARKodeRosWStepMem step_mem;
+  sunindextype lrw1, liw1, lrw_diff, liw_diff;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Determine change in vector sizes */
+  lrw1 = liw1 = 0;
+  if (y0->ops->nvspace != NULL) { N_VSpace(y0, &lrw1, &liw1); }
+  lrw_diff      = lrw1 - ark_mem->lrw1;
+  liw_diff      = liw1 - ark_mem->liw1;
+  ark_mem->lrw1 = lrw1;
+  ark_mem->liw1 = liw1;
+
+  /* Resize the stage vectors */
+  if (step_mem->U != NULL)
+  {
+    if (!arkResizeVecArray(resize, resize_data, step_mem->U_alloc, y0,
+                           &step_mem->U, lrw_diff, &ark_mem->lrw, liw_diff,
+                           &ark_mem->liw))
+    {
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      "Unable to resize vector");
+      return (ARK_MEM_FAIL);
+    }
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_Free frees all RosWStep memory.
+  ---------------------------------------------------------------*/
+void rosWStep_Free(ARKodeMem ark_mem)
+{
+  ARKodeRosWStepMem step_mem;
+
+  /* nothing to do if ark_mem is already NULL */
+  if (ark_mem == NULL) { return; }
+
+  /* conditional frees on non-NULL RosWStep module */
+  if (ark_mem->step_mem != NULL)
+  {
+    step_mem = (ARKodeRosWStepMem)ark_mem->step_mem;
+
+    /* free the stage vectors */
+    arkFreeVecArray(step_mem->U_alloc, &step_mem->U, ark_mem->lrw1,
+                    &ark_mem->lrw, ark_mem->liw1, &ark_mem->liw);
+    step_mem->U_alloc = 0;
+
+    /* free the linear solver memory */
+    if (step_mem->lfree != NULL)
+    {
+      step_mem->lfree((void*)ark_mem);
+      step_mem->lmem = NULL;
+    }
+
+    /* free the time stepper module itself */
+    free(ark_mem->step_mem);
+    ark_mem->step_mem = NULL;
+  }
+}
+
+/*---------------------------------------------------------------
+  rosWStep_PrintMem:
+
+  This routine outputs the memory from the RosWStep structure to
+  a specified file pointer (useful when debugging).
+  ---------------------------------------------------------------*/
+void rosWStep_PrintMem(ARKodeMem ark_mem, FILE* outfile)
+{
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return; }
+
+  /* output integer quantities */
+  fprintf(outfile, "RosWStep: method = %i\n", (int)step_mem->method);
+  fprintf(outfile, "RosWStep: stages = %i\n", step_mem->stages);
+  fprintf(outfile, "RosWStep: q = %i\n", step_mem->q);
+  fprintf(outfile, "RosWStep: p = %i\n", step_mem->p);
+  fprintf(outfile, "RosWStep: msbp = %i\n", step_mem->msbp);
+  fprintf(outfile, "RosWStep: autonomous = %i\n", step_mem->autonomous);
+  fprintf(outfile, "RosWStep: jcur = %i\n", step_mem->jcur);
+
+  /* output long integer quantities */
+  fprintf(outfile, "RosWStep: nfe = %li\n", step_mem->nfe);
+  fprintf(outfile, "RosWStep: nsetups = %li\n", step_mem->nsetups);
+  fprintf(outfile, "RosWStep: nsolves = %li\n", step_mem->nsolves);
+  fprintf(outfile, "RosWStep: nstlp = %li\n", step_mem->nstlp);
+
+  /* output sunrealtype quantities */
+  fprintf(outfile, "RosWStep: gamma = %" RSYM "\n", step_mem->gamma);
+  fprintf(outfile, "RosWStep: gammap = %" RSYM "\n", step_mem->gammap);
+  fprintf(outfile, "RosWStep: gamrat = %" RSYM "\n", step_mem->gamrat);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_AttachLinsol:
+
+  This routine attaches the various set of system linear solver
+  interface routines, data structure, and solver type to the
+  RosWStep module.
+  ---------------------------------------------------------------*/
+int rosWStep_AttachLinsol(ARKodeMem ark_mem, ARKLinsolInitFn linit,
+                          ARKLinsolSetupFn lsetup, ARKLinsolSolveFn lsolve,
+                          ARKLinsolFreeFn lfree,
+                          SUNLinearSolver_Type lsolve_type, void* lmem)
+{
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* free any existing system solver */
+  if (step_mem->lfree != NULL) { step_mem->lfree(ark_mem); }
+
+  /* Attach the provided routines, data structure and solve type */
+  step_mem->linit       = linit;
+  step_mem->lsetup      = lsetup;
+  step_mem->lsolve      = lsolve;
+  step_mem->lfree       = lfree;
+  step_mem->lmem        = lmem;
+  step_mem->lsolve_type = lsolve_type;
+
+  /* Reset all linear solver counters */
+  step_mem->nsetups = 0;
+  step_mem->nstlp   = 0;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_DisableLSetup:
+
+  This routine NULLifies the lsetup function pointer in the
+  RosWStep module.
+  ---------------------------------------------------------------*/
+void rosWStep_DisableLSetup(ARKodeMem ark_mem)
+{
+  ARKodeRosWStepMem step_mem;
+
+  /* access ARKodeRosWStepMem structure */
+  if (ark_mem->step_mem == NULL) { return; }
+  step_mem = (ARKodeRosWStepMem)ark_mem->step_mem;
+
+  /* nullify the lsetup function pointer */
+  step_mem->lsetup = NULL;
+}
+
+/*---------------------------------------------------------------
+  rosWStep_GetLmem:
+
+  This routine returns the system linear solver interface memory
+  structure, lmem.
+  ---------------------------------------------------------------*/
+void* rosWStep_GetLmem(ARKodeMem ark_mem)
+{
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure, and return lmem */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (NULL); }
+  return (step_mem->lmem);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_GetImplicitRHS:
+
+  This routine returns the RHS function pointer, f. The whole
+  right-hand side is treated linearly implicitly.
+  ---------------------------------------------------------------*/
+ARKRhsFn rosWStep_GetImplicitRHS(ARKodeMem ark_mem)
+{
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure, and return f */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (NULL); }
+  return (step_mem->f);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_GetGammas:
+
+  This routine fills the current value of gamma, and states
+  whether gamma has changed since the last setup. The RosW stages
+  require the exact gamma, so lsetup is always called when gamma
+  changes and the ratio is only different from one in between.
+  ---------------------------------------------------------------*/
+int rosWStep_GetGammas(ARKodeMem ark_mem, sunrealtype* gamma,
+                       sunrealtype* gamrat, sunbooleantype** jcur,
+                       sunbooleantype* dgamma_fail)
+{
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* set outputs */
+  *gamma       = step_mem->gamma;
+  *gamrat      = step_mem->gamrat;
+  *jcur        = &step_mem->jcur;
+  *dgamma_fail = (step_mem->gamrat != ONE);
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_Init:
+
+  This routine is called just prior to performing internal time
+  steps (after all user "set" routines have been called) from
+  within arkInitialSetup.
+
+  With initialization type FIRST_INIT this routine:
+  - checks that a linear solver has been attached
+  - sets the transformed method coefficients and orders
+  - limits the interpolant degree by the method order
+  - allocates the stage vectors
+  - sets the call_fullrhs flag
+
+  With initialization types FIRST_INIT or RESIZE_INIT, this
+  routine calls the linear solver initialization routine. With
+  all initialization types the next step recomputes the linear
+  system matrix.
+  ---------------------------------------------------------------*/
+int rosWStep_Init(ARKodeMem ark_mem, int init_type)
+{
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* force a linear solver setup in the next step */
+  step_mem->gammap = ZERO;
+  step_mem->gamrat = ONE;
+
+  /* immediately return if reset */
+  if (init_type == RESET_INIT) { return (ARK_SUCCESS); }
+
+  /* initializations/checks for (re-)initialization call */
+  if (init_type == FIRST_INIT)
+  {
+    /* the stages require a linear solver */
+    if (step_mem->lsolve == NULL)
+    {
+      arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      MSG_ROSWSTEP_NO_LS);
+      return (ARK_ILL_INPUT);
+    }
+
+    /* Set the method coefficients and orders */
+    retval = rosWStep_SetMethodProperties(ark_mem);
+    if (retval != ARK_SUCCESS) { return (retval); }
+
+    /* Override the interpolant degree (if needed), used in arkInitialSetup */
+    if (step_mem->q > 1 && ark_mem->interp_degree > (step_mem->q - 1))
+    {
+      /* Limit max degree to at most one less than the method global order */
+      ark_mem->interp_degree = step_mem->q - 1;
+    }
+
+    /* Allocate the stage vectors (if needed) */
+    if ((step_mem->U != NULL) && (step_mem->U_alloc < step_mem->stages))
+    {
+      arkFreeVecArray(step_mem->U_alloc, &step_mem->U, ark_mem->lrw1,
+                      &ark_mem->lrw, ark_mem->liw1, &ark_mem->liw);
+      step_mem->U_alloc = 0;
+    }
+    if (step_mem->U == NULL)
+    {
+      if (!arkAllocVecArray(step_mem->stages, ark_mem->ewt, &step_mem->U,
+                            ark_mem->lrw1, &ark_mem->lrw, ark_mem->liw1,
+                            &ark_mem->liw))
+      {
+        return (ARK_MEM_FAIL);
+      }
+      step_mem->U_alloc = step_mem->stages;
+    }
+
+    /* Signal to shared arkode module that full RHS evaluations are required */
+    ark_mem->call_fullrhs = SUNTRUE;
+  }
+
+  /* Call linit (if it exists) */
+  if (step_mem->linit)
+  {
+    retval = step_mem->linit(ark_mem);
+    if (retval != 0)
+    {
+      arkProcessError(ark_mem, ARK_LINIT_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_LINIT_FAIL);
+      return (ARK_LINIT_FAIL);
+    }
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*------------------------------------------------------------------------------
+  rosWStep_FullRHS:
+
+  This is just a wrapper to call the user-supplied RHS function, f(t,y). The
+  methods are not FSAL, so the RHS is evaluated in every mode.
+  ----------------------------------------------------------------------------*/
+int rosWStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
+                     int mode)
+{
+  int retval;
+  ARKodeRosWStepMem step_mem;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* perform RHS functions contingent on 'mode' argument */
+  switch (mode)
+  {
+  case ARK_FULLRHS_START:
+  case ARK_FULLRHS_END:
+  case ARK_FULLRHS_OTHER:
+
+    /* call f */
+    retval = step_mem->f(t, y, f, ark_mem->user_data);
+    step_mem->nfe++;
+    if (retval != 0)
+    {
+      arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_RHSFUNC_FAILED, t);
+      return (ARK_RHSFUNC_FAIL);
+    }
+
+    break;
+
+  default:
+    /* return with RHS failure if unknown mode is passed */
+    arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                    "Unknown full RHS mode");
+    return (ARK_RHSFUNC_FAIL);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_TakeStep:
+
+  This routine performs a single Rosenbrock-W step. In the
+  transformed form the stages u_i solve
+
+    (I - h gamma J) u_i = h gamma f(tn + alpha_i h, yn + sum_j a_ij u_j)
+                          + gamma sum_j c_ij u_j + gamma gamma_i h^2 w,
+
+  with w the time derivative of f at (tn, yn) (w = 0 for
+  autonomous problems), and the solution and error estimate are
+
+    y = yn + sum_i m_i u_i,   yerr = sum_i (m_i - mhat_i) u_i.
+
+  All stages share the matrix I - h gamma J. It is set up at the
+  start of the step when gamma changed since the last setup, after
+  a linear solver failure, or when msbp steps have passed;
+  otherwise the factorization from a previous step is reused.
+  Within a setup, ARKLS only reevaluates J every msbj steps (see
+  ARKodeSetJacEvalFrequency), which the W-methods tolerate. The
+  vectors are used as follows: tempv1 holds the error estimate,
+  tempv2 the stage states, tempv3 the time derivative w, and
+  tempv1-tempv3 are the work vectors of lsetup.
+
+  The output variable dsmPtr should contain estimate of the
+  weighted local error if an embedding is present; otherwise it
+  should be 0.
+
+  The input/output variable nflagPtr is used to gauge failures of
+  the linear solver. On a recoverable failure it is set to
+  CONV_FAIL and TRY_AGAIN is returned, so that ARKODE retries the
+  step with a smaller step size, and the next setup updates J.
+
+  The return value from this routine is:
+            0 => step completed successfully
+           >0 => step encountered recoverable failure;
+                 reduce step and retry (if possible)
+           <0 => step encountered unrecoverable failure
+  ---------------------------------------------------------------*/
+int rosWStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr)
+{
+  int retval, i, j, nvec, convfail;
+  sunrealtype h, sigma;
+  sunbooleantype callLSetup;
+  sunrealtype* cvals;
+  N_Vector* Xvecs;
+  ARKodeRosWStepMem step_mem;
+
+  /* initialize output */
+  *dsmPtr = ZERO;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* local shortcuts for fused vector operations */
+  h     = ark_mem->h;
+  cvals = step_mem->cvals;
+  Xvecs = step_mem->Xvecs;
+
+  /* Update gamma and decide whether to call lsetup */
+  step_mem->gamma  = h * step_mem->gamma_m;
+  step_mem->gamrat = (step_mem->gammap == ZERO)
+                       ? ONE
+                       : step_mem->gamma / step_mem->gammap;
+  callLSetup       = SUNFALSE;
+  if (step_mem->lsetup)
+  {
+    callLSetup = (ark_mem->firststage) || (step_mem->gammap == ZERO) ||
+                 (step_mem->msbp < 0) || (step_mem->gamrat != ONE) ||
+                 (*nflagPtr == PREV_CONV_FAIL) ||
+                 (ark_mem->nst >= step_mem->nstlp + abs(step_mem->msbp));
+  }
+  convfail = ((*nflagPtr == FIRST_CALL) || (*nflagPtr == PREV_ERR_FAIL))
+               ? ARK_NO_FAILURES
+               : ARK_FAIL_OTHER;
+
+  /* initialize linear solver failure flag to success */
+  *nflagPtr = ARK_SUCCESS;
+
+  /* The method is not FSAL, so the RHS at the start of the step may need
+     to be computed (possibly already computed by ARKODE) */
+  if (!(ark_mem->fn_is_current))
+  {
+    retval = ark_mem->step_fullrhs(ark_mem, ark_mem->tn, ark_mem->yn,
+                                   ark_mem->fn, ARK_FULLRHS_START);
+    if (retval) { return ARK_RHSFUNC_FAIL; }
+    ark_mem->fn_is_current = SUNTRUE;
+  }
+
+  /* Set up I - h gamma J at (tn, yn) */
+  if (callLSetup)
+  {
+    retval = step_mem->lsetup(ark_mem, convfail, ark_mem->tn, ark_mem->yn,
+                              ark_mem->fn, &(step_mem->jcur), ark_mem->tempv1,
+                              ark_mem->tempv2, ark_mem->tempv3);
+    step_mem->nsetups++;
+    if (retval < 0) { return (ARK_LSETUP_FAIL); }
+    if (retval > 0)
+    {
+      *nflagPtr = CONV_FAIL;
+      return (TRY_AGAIN);
+    }
+    step_mem->gamrat = ONE;
+    step_mem->gammap = step_mem->gamma;
+    step_mem->nstlp  = ark_mem->nst;
+  }
+
+  /* Time derivative of f by a forward difference, w = 0 if autonomous */
+  if (!step_mem->autonomous)
+  {
+    sigma = SUNRsqrt(ark_mem->uround) *
+            SUNMAX(SUNRabs(ark_mem->tn), SUNRabs(h));
+    retval = step_mem->f(ark_mem->tn + sigma, ark_mem->yn, ark_mem->tempv3,
+                         ark_mem->user_data);
+    step_mem->nfe++;
+    if (retval < 0) { return (ARK_RHSFUNC_FAIL); }
+    if (retval > 0) { return (RHSFUNC_RECVR); }
+    N_VLinearSum(ONE / sigma, ark_mem->tempv3, -ONE / sigma, ark_mem->fn,
+                 ark_mem->tempv3);
+  }
+
+  /* Loop over the stages */
+  for (i = 0; i < step_mem->stages; i++)
+  {
+    /* f at the stage state, stored in U[i] */
+    if (i == 0) { N_VScale(ONE, ark_mem->fn, step_mem->U[0]); }
+    else
+    {
+      /* stage state yn + sum_j a_ij u_j (skipping zero coefficients) */
+      nvec        = 0;
+      cvals[nvec] = ONE;
+      Xvecs[nvec] = ark_mem->yn;
+      nvec++;
+      for (j = 0; j < i; j++)
+      {
+        if (step_mem->a[i][j] == ZERO) { continue; }
+        cvals[nvec] = step_mem->a[i][j];
+        Xvecs[nvec] = step_mem->U[j];
+        nvec++;
+      }
+      retval = N_VLinearCombination(nvec, cvals, Xvecs, ark_mem->tempv2);
+      if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+      /* apply user-supplied stage postprocessing function (if supplied) */
+      ark_mem->tcur = ark_mem->tn + step_mem->alpha[i] * h;
+      if (ark_mem->ProcessStage != NULL)
+      {
+        retval = ark_mem->ProcessStage(ark_mem->tcur, ark_mem->tempv2,
+                                       ark_mem->user_data);
+        if (retval != 0) { return (ARK_POSTPROCESS_STAGE_FAIL); }
+      }
+
+      retval = step_mem->f(ark_mem->tcur, ark_mem->tempv2, step_mem->U[i],
+                           ark_mem->user_data);
+      step_mem->nfe++;
+      if (retval < 0) { return (ARK_RHSFUNC_FAIL); }
+      if (retval > 0) { return (RHSFUNC_RECVR); }
+    }
+
+    /* right-hand side of the stage system */
+    nvec        = 0;
+    cvals[nvec] = step_mem->gamma;
+    Xvecs[nvec] = step_mem->U[i];
+    nvec++;
+    for (j = 0; j < i; j++)
+    {
+      if (step_mem->c[i][j] == ZERO) { continue; }
+      cvals[nvec] = step_mem->gamma_m * step_mem->c[i][j];
+      Xvecs[nvec] = step_mem->U[j];
+      nvec++;
+    }
+    if (!step_mem->autonomous && step_mem->gsum[i] != ZERO)
+    {
+      cvals[nvec] = step_mem->gamma_m * step_mem->gsum[i] * h * h;
+      Xvecs[nvec] = ark_mem->tempv3;
+      nvec++;
+    }
+    retval = N_VLinearCombination(nvec, cvals, Xvecs, step_mem->U[i]);
+    if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+    /* solve with I - h gamma J */
+    retval = step_mem->lsolve(ark_mem, step_mem->U[i], ark_mem->tn, ark_mem->yn,
+                              ark_mem->fn, ONE, 0);
+    step_mem->nsolves++;
+    if (retval < 0) { return (ARK_LSOLVE_FAIL); }
+    if (retval > 0)
+    {
+      *nflagPtr = CONV_FAIL;
+      return (TRY_AGAIN);
+    }
+  }
+
+  /* y = yn + sum_i m_i u_i */
+  ark_mem->tcur = ark_mem->tn + h;
+  nvec          = 0;
+  cvals[nvec]   = ONE;
+  Xvecs[nvec]   = ark_mem->yn;
+  nvec++;
+  for (i = 0; i < step_mem->stages; i++)
+  {
+    cvals[nvec] = step_mem->m[i];
+    Xvecs[nvec] = step_mem->U[i];
+    nvec++;
+  }
+  retval = N_VLinearCombination(nvec, cvals, Xvecs, ark_mem->ycur);
+  if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+  /* Compute yerr and the error norm (if step adaptivity enabled) */
+  if (!ark_mem->fixedstep)
+  {
+    for (i = 0; i < step_mem->stages; i++)
+    {
+      cvals[i] = step_mem->m[i] - step_mem->mhat[i];
+      Xvecs[i] = step_mem->U[i];
+    }
+    retval = N_VLinearCombination(step_mem->stages, cvals, Xvecs,
+                                  ark_mem->tempv1);
+    if (retval != 0) { return (ARK_VECTOROP_ERR); }
+
+    *dsmPtr = N_VWrmsNorm(ark_mem->tempv1, ark_mem->ewt);
+  }
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
+  SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
+                     "ARKODE::rosWStep_TakeStep", "error-test",
+                     "step = %li, h = %" RSYM ", dsm = %" RSYM ", setup = %i",
+                     ark_mem->nst, ark_mem->h, *dsmPtr, (int)callLSetup);
+#endif
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Internal utility routines
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  rosWStep_AccessARKODEStepMem:
+
+  Shortcut routine to unpack both ark_mem and step_mem structures
+  from void* pointer.  If either is missing it returns ARK_MEM_NULL.
+  ---------------------------------------------------------------*/
+int rosWStep_AccessARKODEStepMem(void* arkode_mem, const char* fname,
+                                 ARKodeMem* ark_mem, ARKodeRosWStepMem* step_mem)
+{
+  /* access ARKodeMem structure */
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *ark_mem = (ARKodeMem)arkode_mem;
+
+  /* access ARKodeRosWStepMem structure */
+  if ((*ark_mem)->step_mem == NULL)
+  {
+    arkProcessError(*ark_mem, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_ROSWSTEP_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *step_mem = (ARKodeRosWStepMem)(*ark_mem)->step_mem;
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_AccessStepMem:
+
+  Shortcut routine to unpack the step_mem structure from
+  ark_mem.  If missing it returns ARK_MEM_NULL.
+  ---------------------------------------------------------------*/
+int rosWStep_AccessStepMem(ARKodeMem ark_mem, const char* fname,
+                           ARKodeRosWStepMem* step_mem)
+{
+  /* access ARKodeRosWStepMem structure */
+  if (ark_mem->step_mem == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_ROSWSTEP_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *step_mem = (ARKodeRosWStepMem)ark_mem->step_mem;
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_CheckNVector:
+
+  This routine checks if all required vector operations are
+  present.  If any of them is missing it returns SUNFALSE.
+  ---------------------------------------------------------------*/
+sunbooleantype rosWStep_CheckNVector(N_Vector tmpl)
+{
+  if ((tmpl->ops->nvclone == NULL) || (tmpl->ops->nvdestroy == NULL) ||
+      (tmpl->ops->nvlinearsum == NULL) || (tmpl->ops->nvconst == NULL) ||
+      (tmpl->ops->nvscale == NULL) || (tmpl->ops->nvwrmsnorm == NULL))
+  {
+    return (SUNFALSE);
+  }
+  return (SUNTRUE);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_SetMethodProperties:
+
+  This routine sets the number of stages and the orders of the
+  selected method (also in the adaptivity module), and computes
+  its coefficients in the transformed form. With Gamma^{-1} the
+  inverse of the lower triangular matrix Gamma,
+
+    a = alpha Gamma^{-1},  c = diag(1/gamma) - Gamma^{-1},
+    m = b Gamma^{-1},      mhat = bhat Gamma^{-1},
+
+  while the stage times and time derivative coefficients are the
+  row sums of alpha and Gamma, respectively.
+  ---------------------------------------------------------------*/
+int rosWStep_SetMethodProperties(ARKodeMem ark_mem)
+{
+  ARKodeRosWStepMem step_mem;
+  sunrealtype alpha[ROSW_MAX_STAGES][ROSW_MAX_STAGES];
+  sunrealtype G[ROSW_MAX_STAGES][ROSW_MAX_STAGES];
+  sunrealtype Ginv[ROSW_MAX_STAGES][ROSW_MAX_STAGES];
+  sunrealtype b[ROSW_MAX_STAGES], bhat[ROSW_MAX_STAGES];
+  sunrealtype sum;
+  int retval, s, i, j, k;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  for (i = 0; i < ROSW_MAX_STAGES; i++)
+  {
+    b[i] = bhat[i] = ZERO;
+    for (j = 0; j < ROSW_MAX_STAGES; j++) { alpha[i][j] = G[i][j] = ZERO; }
+  }
+
+  /* Set the standard form coefficients of the selected method */
+  switch (step_mem->method)
+  {
+  case ARKODE_ROSW_ROS2:
+    s           = 2;
+    step_mem->q = 2;
+    step_mem->p = 1;
+    G[0][0] = G[1][1] = ROS2_GAMMA;
+    G[1][0]           = -TWO * ROS2_GAMMA;
+    alpha[1][0]       = ONE;
+    b[0] = b[1] = HALF;
+    bhat[0]     = ONE;
+    break;
+  case ARKODE_ROSW_ROS34PW2:
+    s           = 4;
+    step_mem->q = 3;
+    step_mem->p = 2;
+    for (i = 0; i < s; i++)
+    {
+      b[i]    = ros34pw2_b[i];
+      bhat[i] = ros34pw2_bhat[i];
+      for (j = 0; j < s; j++)
+      {
+        alpha[i][j] = ros34pw2_alpha[i][j];
+        G[i][j]     = ros34pw2_Gamma[i][j];
+      }
+    }
+    break;
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid RosW method type");
+    return (ARK_ILL_INPUT);
+  }
+  step_mem->stages  = s;
+  step_mem->gamma_m = G[0][0];
+
+  /* Invert the lower triangular Gamma by forward substitution */
+  for (j = 0; j < s; j++)
+  {
+    for (i = 0; i < s; i++) { Ginv[i][j] = ZERO; }
+    Ginv[j][j] = ONE / G[j][j];
+    for (i = j + 1; i < s; i++)
+    {
+      sum = ZERO;
+      for (k = j; k < i; k++) { sum += G[i][k] * Ginv[k][j]; }
+      Ginv[i][j] = -sum / G[i][i];
+    }
+  }
+
+  /* Transformed coefficients */
+  for (i = 0; i < ROSW_MAX_STAGES; i++)
+  {
+    step_mem->alpha[i] = step_mem->gsum[i] = ZERO;
+    step_mem->m[i] = step_mem->mhat[i] = ZERO;
+    for (j = 0; j < ROSW_MAX_STAGES; j++)
+    {
+      step_mem->a[i][j] = step_mem->c[i][j] = ZERO;
+    }
+  }
+  for (i = 0; i < s; i++)
+  {
+    for (j = 0; j < s; j++)
+    {
+      step_mem->alpha[i] += alpha[i][j];
+      if (j <= i) { step_mem->gsum[i] += G[i][j]; }
+      for (k = 0; k < s; k++)
+      {
+        step_mem->a[i][j] += alpha[i][k] * Ginv[k][j];
+      }
+      if (j < i) { step_mem->c[i][j] = -Ginv[i][j]; }
+    }
+    for (k = 0; k < s; k++)
+    {
+      step_mem->m[i] += b[k] * Ginv[k][i];
+      step_mem->mhat[i] += bhat[k] * Ginv[k][i];
+    }
+  }
+
+  /* Set the method and embedding orders in the adaptivity module */
+  ark_mem->hadapt_mem->q = step_mem->q;
+  ark_mem->hadapt_mem->p = step_mem->p;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
@@ -0,0 +1,157 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * Implementation header file for ARKODE's Rosenbrock-W (RosW)
+ * time stepper module.
+ *--------------------------------------------------------------*/
+
+#ifndef _ARKODE_ROSWSTEP_IMPL_H
+#define _ARKODE_ROSWSTEP_IMPL_H
+
+#include <arkode/arkode_roswstep.h>
+
+#include "arkode_impl.h"
+#include "arkode_ls_impl.h"
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*===============================================================
+  RosW time step module constants
+  ===============================================================*/
+
+/* default method and maximum number of stages */
+#define ROSW_DEFAULT_METHOD ARKODE_ROSW_ROS34PW2
+#define ROSW_MAX_STAGES     4
+
+/* max no. of steps between lsetup calls with an unchanged step size */
+#define ROSW_MSBP 20
+
+/*===============================================================
+  RosW time step module data structure
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  Types : struct ARKodeRosWStepMemRec, ARKodeRosWStepMem
+  ---------------------------------------------------------------
+  The type ARKodeRosWStepMem is type pointer to struct
+  ARKodeRosWStepMemRec.  This structure contains fields to
+  perform a Rosenbrock-W time step. The method coefficients are
+  stored in the transformed form of Hairer and Wanner (Solving
+  ODEs II, Sec. IV.7), in which the stages only require solves
+  with I - h gamma J and no Jacobian-vector products.
+  ---------------------------------------------------------------*/
+typedef struct ARKodeRosWStepMemRec
+{
+  /* RosW problem specification */
+  ARKRhsFn f;                /* y' = f(t,y)                */
+  sunbooleantype autonomous; /* f does not depend on t     */
+
+  /* RosW method (transformed coefficients) */
+  ARKODE_RosWMethodType method; /* method type              */
+  int stages;                   /* number of stages         */
+  int q;                        /* method order             */
+  int p;                        /* embedding order          */
+  sunrealtype gamma_m;          /* diagonal coefficient     */
+  sunrealtype a[ROSW_MAX_STAGES][ROSW_MAX_STAGES]; /* stage state coeffs  */
+  sunrealtype c[ROSW_MAX_STAGES][ROSW_MAX_STAGES]; /* stage rhs coeffs    */
+  sunrealtype alpha[ROSW_MAX_STAGES];              /* stage times         */
+  sunrealtype gsum[ROSW_MAX_STAGES];               /* time deriv. coeffs  */
+  sunrealtype m[ROSW_MAX_STAGES];                  /* solution weights    */
+  sunrealtype mhat[ROSW_MAX_STAGES];               /* embedding weights   */
+
+  /* RosW stage vectors */
+  N_Vector* U;   /* transformed stages        */
+  int U_alloc;   /* number of allocated U     */
+
+  /* Linear Solver Data */
+  ARKLinsolInitFn linit;
+  ARKLinsolSetupFn lsetup;
+  ARKLinsolSolveFn lsolve;
+  ARKLinsolFreeFn lfree;
+  void* lmem;
+  SUNLinearSolver_Type lsolve_type;
+
+  /* Linear solver heuristics */
+  sunrealtype gamma;  /* h * gamma_m                */
+  sunrealtype gammap; /* gamma at the last setup    */
+  sunrealtype gamrat; /* gamma / gammap             */
+  sunbooleantype jcur; /* Jacobian is current       */
+  int msbp;           /* max steps between lsetups  */
+  long int nstlp;     /* step of the last lsetup    */
+
+  /* Counters */
+  long int nfe;     /* num f calls                */
+  long int nsetups; /* num lsetup calls           */
+  long int nsolves; /* num lsolve calls           */
+
+  /* Reusable arrays for fused vector operations */
+  sunrealtype cvals[ROSW_MAX_STAGES + 2];
+  N_Vector Xvecs[ROSW_MAX_STAGES + 2];
+
+}* ARKodeRosWStepMem;
+
+/*===============================================================
+  RosW time step module private function prototypes
+  ===============================================================*/
+
+/* Interface routines supplied to ARKODE */
+int rosWStep_AttachLinsol(ARKodeMem ark_mem, ARKLinsolInitFn linit,
+                          ARKLinsolSetupFn lsetup, ARKLinsolSolveFn lsolve,
+                          ARKLinsolFreeFn lfree,
+                          SUNLinearSolver_Type lsolve_type, void* lmem);
+void rosWStep_DisableLSetup(ARKodeMem ark_mem);
+int rosWStep_Init(ARKodeMem ark_mem, int init_type);
+void* rosWStep_GetLmem(ARKodeMem ark_mem);
+ARKRhsFn rosWStep_GetImplicitRHS(ARKodeMem ark_mem);
+int rosWStep_GetGammas(ARKodeMem ark_mem, sunrealtype* gamma,
+                       sunrealtype* gamrat, sunbooleantype** jcur,
+                       sunbooleantype* dgamma_fail);
+int rosWStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y, N_Vector f,
+                     int mode);
+int rosWStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr, int* nflagPtr);
+int rosWStep_SetUserData(ARKodeMem ark_mem, void* user_data);
+int rosWStep_SetDefaults(ARKodeMem ark_mem);
+int rosWStep_SetAutonomous(ARKodeMem ark_mem, sunbooleantype autonomous);
+int rosWStep_SetLSetupFrequency(ARKodeMem ark_mem, int msbp);
+int rosWStep_GetNumLinSolvSetups(ARKodeMem ark_mem, long int* nlinsetups);
+int rosWStep_GetCurrentGamma(ARKodeMem ark_mem, sunrealtype* gamma);
+int rosWStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile,
+                           SUNOutputFormat fmt);
+int rosWStep_WriteParameters(ARKodeMem ark_mem, FILE* fp);
+int rosWStep_Resize(ARKodeMem ark_mem, N_Vector y0, sunrealtype hscale,
+                    sunrealtype t0, ARKVecResizeFn resize, void* resize_data);
+void rosWStep_Free(ARKodeMem ark_mem);
+void rosWStep_PrintMem(ARKodeMem ark_mem, FILE* outfile);
+int rosWStep_GetEstLocalErrors(ARKodeMem ark_mem, N_Vector ele);
+
+/* Internal utility routines */
+int rosWStep_AccessARKODEStepMem(void* arkode_mem, const char* fname,
+                                 ARKodeMem* ark_mem, ARKodeRosWStepMem* step_mem);
+int rosWStep_AccessStepMem(ARKodeMem ark_mem, const char* fname,
+                           ARKodeRosWStepMem* step_mem);
+sunbooleantype rosWStep_CheckNVector(N_Vector tmpl);
+int rosWStep_SetMethodProperties(ARKodeMem ark_mem);
+
+/*===============================================================
+  Reusable RosWStep Error Messages
+  ===============================================================*/
+
+/* Initialization and I/O error messages */
+#define MSG_ROSWSTEP_NO_MEM "Time step module memory is NULL."
+#define MSG_ROSWSTEP_NO_LS  "RosWStep requires a linear solver."
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,403 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * This is the implementation file for the optional input and
+ * output functions for the ARKODE RosWStep time stepper module.
+ *--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/sundials_math.h>
+#include <sundials/sundials_types.h>
+
+#include "arkode_roswstep_impl.h"
+
+/*===============================================================
+  Exported optional input functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  RosWStepSetMethod:
+
+  Specifies the Rosenbrock-W method.
+  ---------------------------------------------------------------*/
+int RosWStepSetMethod(void* arkode_mem, ARKODE_RosWMethodType method)
+{
+  ARKodeMem ark_mem;
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeRosWStepMem structures */
+  retval = rosWStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  switch (method)
+  {
+  case ARKODE_ROSW_ROS2:
+  case ARKODE_ROSW_ROS34PW2: break;
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid RosW method type");
+    return (ARK_ILL_INPUT);
+  }
+
+  step_mem->method = method;
+
+  return (rosWStep_SetMethodProperties(ark_mem));
+}
+
+/*---------------------------------------------------------------
+  RosWStepSetMethodByName:
+
+  Specifies the Rosenbrock-W method by its enumeration name.
+  ---------------------------------------------------------------*/
+int RosWStepSetMethodByName(void* arkode_mem, const char* emethod)
+{
+  if (emethod == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Method name is NULL");
+    return (ARK_ILL_INPUT);
+  }
+
+  if (strcmp(emethod, "ARKODE_ROSW_ROS2") == 0)
+  {
+    return (RosWStepSetMethod(arkode_mem, ARKODE_ROSW_ROS2));
+  }
+  if (strcmp(emethod, "ARKODE_ROSW_ROS34PW2") == 0)
+  {
+    return (RosWStepSetMethod(arkode_mem, ARKODE_ROSW_ROS34PW2));
+  }
+
+  arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                  "Unknown method name");
+  return (ARK_ILL_INPUT);
+}
+
+/*===============================================================
+  Exported optional output functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  RosWStepGetNumRhsEvals:
+
+  Returns the current number of calls to f
+  ---------------------------------------------------------------*/
+int RosWStepGetNumRhsEvals(void* arkode_mem, long int* fevals)
+{
+  ARKodeMem ark_mem;
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeRosWStepMem structures */
+  retval = rosWStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get values from step_mem */
+  *fevals = step_mem->nfe;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  RosWStepGetNumLinSolves:
+
+  Returns the current number of calls to the lsolve routine, i.e.,
+  the number of stage linear systems solved
+  ---------------------------------------------------------------*/
+int RosWStepGetNumLinSolves(void* arkode_mem, long int* nlinsolves)
+{
+  ARKodeMem ark_mem;
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeRosWStepMem structures */
+  retval = rosWStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                        &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get values from step_mem */
+  *nlinsolves = step_mem->nsolves;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Private functions attached to ARKODE
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  rosWStep_SetUserData:
+
+  Passes user-data pointer to the attached linear solver module.
+  ---------------------------------------------------------------*/
+int rosWStep_SetUserData(ARKodeMem ark_mem, void* user_data)
+{
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* set user data in ARKODE LS mem */
+  if (step_mem->lmem != NULL)
+  {
+    retval = arkLSSetUserData(ark_mem, user_data);
+    if (retval != ARKLS_SUCCESS) { return (retval); }
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_SetDefaults:
+
+  Resets all RosWStep optional inputs to their default values.
+  Does not change problem-defining function pointers or
+  user_data pointer.
+  ---------------------------------------------------------------*/
+int rosWStep_SetDefaults(ARKodeMem ark_mem)
+{
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Set default values for integrator optional inputs */
+  step_mem->method     = ROSW_DEFAULT_METHOD;
+  step_mem->autonomous = SUNFALSE;
+  step_mem->msbp       = ROSW_MSBP;
+
+  return (rosWStep_SetMethodProperties(ark_mem));
+}
+
+/*---------------------------------------------------------------
+  rosWStep_SetAutonomous:
+
+  Indicates if the problem is autonomous (True) or non-autonomous
+  (False). For autonomous problems the time derivative of f is
+  not approximated in each step.
+  ---------------------------------------------------------------*/
+int rosWStep_SetAutonomous(ARKodeMem ark_mem, sunbooleantype autonomous)
+{
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  step_mem->autonomous = autonomous;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_SetLSetupFrequency:
+
+  Specifies the user-provided linear setup decision constant
+  msbp.  Positive values give the maximum number of steps with an
+  unchanged step size between calls to lsetup; negative values
+  imply recomputation of lsetup in each step; a zero value
+  implies a reset to the default.
+  ---------------------------------------------------------------*/
+int rosWStep_SetLSetupFrequency(ARKodeMem ark_mem, int msbp)
+{
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* if argument legal set it, otherwise set default */
+  if (msbp == 0) { step_mem->msbp = ROSW_MSBP; }
+  else { step_mem->msbp = msbp; }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_GetNumLinSolvSetups:
+
+  Returns the current number of calls to the lsetup routine
+  ---------------------------------------------------------------*/
+int rosWStep_GetNumLinSolvSetups(ARKodeMem ark_mem, long int* nlinsetups)
+{
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* get value from step_mem */
+  *nlinsetups = step_mem->nsetups;
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_GetCurrentGamma: Returns the current value of gamma
+  ---------------------------------------------------------------*/
+int rosWStep_GetCurrentGamma(ARKodeMem ark_mem, sunrealtype* gamma)
+{
+  int retval;
+  ARKodeRosWStepMem step_mem;
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+  *gamma = step_mem->gamma;
+  return (retval);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_GetEstLocalErrors: Returns the current local truncation
+  error estimate vector
+  ---------------------------------------------------------------*/
+int rosWStep_GetEstLocalErrors(ARKodeMem ark_mem, N_Vector ele)
+{
+  int retval;
+  ARKodeRosWStepMem step_mem;
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* return an error if local truncation error is not computed */
+  if (ark_mem->fixedstep) { return (ARK_STEPPER_UNSUPPORTED); }
+
+  /* otherwise, copy local truncation error vector to output */
+  N_VScale(ONE, ark_mem->tempv1, ele);
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_PrintAllStats:
+
+  Prints integrator statistics
+  ---------------------------------------------------------------*/
+int rosWStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile,
+                           SUNOutputFormat fmt)
+{
+  ARKodeRosWStepMem step_mem;
+  ARKLsMem arkls_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  switch (fmt)
+  {
+  case SUN_OUTPUTFORMAT_TABLE:
+    /* function evaluations */
+    fprintf(outfile, "RHS fn evals                 = %ld\n", step_mem->nfe);
+
+    /* linear solver stats */
+    fprintf(outfile, "LS setups                    = %ld\n", step_mem->nsetups);
+    fprintf(outfile, "LS solves                    = %ld\n", step_mem->nsolves);
+    if (ark_mem->step_getlinmem(ark_mem))
+    {
+      arkls_mem = (ARKLsMem)(ark_mem->step_getlinmem(ark_mem));
+      fprintf(outfile, "Jac fn evals                 = %ld\n", arkls_mem->nje);
+      fprintf(outfile, "LS RHS fn evals              = %ld\n", arkls_mem->nfeDQ);
+      fprintf(outfile, "Prec setup evals             = %ld\n", arkls_mem->npe);
+      fprintf(outfile, "Prec solves                  = %ld\n", arkls_mem->nps);
+      fprintf(outfile, "LS iters                     = %ld\n", arkls_mem->nli);
+      fprintf(outfile, "LS fails                     = %ld\n", arkls_mem->ncfl);
+      fprintf(outfile, "Jac-times setups             = %ld\n",
+              arkls_mem->njtsetup);
+      fprintf(outfile, "Jac-times evals              = %ld\n",
+              arkls_mem->njtimes);
+      if (ark_mem->nst > 0)
+      {
+        fprintf(outfile, "Jac evals per step           = %" RSYM "\n",
+                (sunrealtype)arkls_mem->nje / (sunrealtype)ark_mem->nst);
+      }
+    }
+    break;
+
+  case SUN_OUTPUTFORMAT_CSV:
+    /* function evaluations */
+    fprintf(outfile, ",RHS fn evals,%ld", step_mem->nfe);
+
+    /* linear solver stats */
+    fprintf(outfile, ",LS setups,%ld", step_mem->nsetups);
+    fprintf(outfile, ",LS solves,%ld", step_mem->nsolves);
+    if (ark_mem->step_getlinmem(ark_mem))
+    {
+      arkls_mem = (ARKLsMem)(ark_mem->step_getlinmem(ark_mem));
+      fprintf(outfile, ",Jac fn evals,%ld", arkls_mem->nje);
+      fprintf(outfile, ",LS RHS fn evals,%ld", arkls_mem->nfeDQ);
+      fprintf(outfile, ",Prec setup evals,%ld", arkls_mem->npe);
+      fprintf(outfile, ",Prec solves,%ld", arkls_mem->nps);
+      fprintf(outfile, ",LS iters,%ld", arkls_mem->nli);
+      fprintf(outfile, ",LS fails,%ld", arkls_mem->ncfl);
+      fprintf(outfile, ",Jac-times setups,%ld", arkls_mem->njtsetup);
+      fprintf(outfile, ",Jac-times evals,%ld", arkls_mem->njtimes);
+      if (ark_mem->nst > 0)
+      {
+        fprintf(outfile, ",Jac evals per step,%" RSYM,
+                (sunrealtype)arkls_mem->nje / (sunrealtype)ark_mem->nst);
+      }
+      else { fprintf(outfile, ",Jac evals per step,0"); }
+    }
+    fprintf(outfile, "\n");
+    break;
+
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid formatting option.");
+    return (ARK_ILL_INPUT);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  rosWStep_WriteParameters:
+
+  Outputs all solver parameters to the provided file pointer.
+  ---------------------------------------------------------------*/
+int rosWStep_WriteParameters(ARKodeMem ark_mem, FILE* fp)
+{
+  ARKodeRosWStepMem step_mem;
+  int retval;
+
+  /* access ARKodeRosWStepMem structure */
+  retval = rosWStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* print integrator parameters to file */
+  fprintf(fp, "RosWStep time step module parameters:\n");
+  switch (step_mem->method)
+  {
+  case ARKODE_ROSW_ROS2: fprintf(fp, "  Method ROS2"); break;
+  case ARKODE_ROSW_ROS34PW2: fprintf(fp, "  Method ROS34PW2"); break;
+  default: fprintf(fp, "  Method unknown"); break;
+  }
+  fprintf(fp, " (%i stages, order %i, embedding order %i)\n", step_mem->stages,
+          step_mem->q, step_mem->p);
+  fprintf(fp, "  Linear solver setup frequency %i\n", step_mem->msbp);
+  fprintf(fp, "  Autonomous problem %s\n",
+          step_mem->autonomous ? "yes" : "no");
+  fprintf(fp, "\n");
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
@@ -0,0 +1,937 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * This is the implementation file for ARKODE's operator splitting
+ * time stepper module.
+ *
+ * The ODE y' = f_1(t,y) + ... + f_P(t,y) is advanced by composing
+ * the flows of the partitions, each evolved by an
+ * MRIStepInnerStepper (e.g., an ARKStep, ERKStep or MRIStep
+ * integrator, or a user-supplied stepper). A step is the linear
+ * combination
+ *
+ *   y_{n+1} = sum_i alpha_i y_i
+ *
+ * of sequential methods, where y_i is obtained from yn by evolving
+ * the partitions stage by stage over the substeps given by the
+ * splitting coefficients. The partition steppers are reset to the
+ * current state before each substep, but keep their step size
+ * history, so that no initial step size estimate is repeated.
+ *
+ * Sequential methods that evolve disjoint sets of stepper objects
+ * are independent and are evolved concurrently with OpenMP.
+ *--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/sundials_math.h>
+
+#include "arkode_impl.h"
+#include "arkode_interp_impl.h"
+#include "arkode_splittingstep_impl.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*===============================================================
+  Private function prototypes
+  ===============================================================*/
+
+static MRIStepInnerStepper splittingStep_GetStepper(
+  ARKodeSplittingStepMem step_mem, int method, int partition);
+static sunbooleantype splittingStep_Evolves(
+  SplittingStepCoefficients coefficients, int method, int partition);
+static sunbooleantype splittingStep_IsConcurrent(
+  ARKodeSplittingStepMem step_mem);
+static int splittingStep_SequentialMethod(ARKodeMem ark_mem,
+                                          ARKodeSplittingStepMem step_mem,
+                                          int method, N_Vector y);
+
+/*===============================================================
+  Exported functions
+  ===============================================================*/
+
+void* SplittingStepCreate(MRIStepInnerStepper* steppers, int partitions,
+                          sunrealtype t0, N_Vector y0, SUNContext sunctx)
+{
+  ARKodeMem ark_mem;
+  ARKodeSplittingStepMem step_mem;
+  sunbooleantype nvectorOK;
+  int retval;
+
+  /* Check for legal input parameters */
+  if (y0 == NULL)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_Y0);
+    return (NULL);
+  }
+
+  if (!sunctx)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_SUNCTX);
+    return (NULL);
+  }
+
+  retval = splittingStep_CheckSteppers(NULL, steppers, partitions);
+  if (retval != ARK_SUCCESS) { return (NULL); }
+
+  /* Test if all required vector operations are implemented */
+  nvectorOK = splittingStep_CheckNVector(y0);
+  if (!nvectorOK)
+  {
+    arkProcessError(NULL, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_BAD_NVECTOR);
+    return (NULL);
+  }
+
+  /* Create ark_mem structure and set default values */
+  ark_mem = arkCreate(sunctx);
+  if (ark_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (NULL);
+  }
+
+  /* Allocate ARKodeSplittingStepMem structure, and initialize to zero */
+  step_mem = NULL;
+  step_mem = (ARKodeSplittingStepMem)malloc(
+    sizeof(struct ARKodeSplittingStepMemRec));
+  if (step_mem == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_ARKMEM_FAIL);
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+  memset(step_mem, 0, sizeof(struct ARKodeSplittingStepMemRec));
+
+  /* Attach step_mem structure and function pointers to ark_mem */
+  ark_mem->step_init            = splittingStep_Init;
+  ark_mem->step_fullrhs         = splittingStep_FullRHS;
+  ark_mem->step                 = splittingStep_TakeStep;
+  ark_mem->step_printallstats   = splittingStep_PrintAllStats;
+  ark_mem->step_writeparameters = splittingStep_WriteParameters;
+  ark_mem->step_resize          = splittingStep_Resize;
+  ark_mem->step_free            = splittingStep_Free;
+  ark_mem->step_printmem        = splittingStep_PrintMem;
+  ark_mem->step_setdefaults     = splittingStep_SetDefaults;
+  ark_mem->step_setorder        = splittingStep_SetOrder;
+  ark_mem->step_mem             = (void*)step_mem;
+
+  /* Copy the partition steppers and allocate the counters */
+  step_mem->partitions = partitions;
+  step_mem->steppers   = (MRIStepInnerStepper*)malloc(
+    partitions * sizeof(MRIStepInnerStepper));
+  step_mem->n_evolves = (long int*)calloc(partitions, sizeof(long int));
+  if (step_mem->steppers == NULL || step_mem->n_evolves == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_ARKMEM_FAIL);
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+  memcpy(step_mem->steppers, steppers, partitions * sizeof(MRIStepInnerStepper));
+  ark_mem->liw += 2 * partitions;
+
+  /* Set default values for optional inputs */
+  retval = splittingStep_SetDefaults((void*)ark_mem);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Error setting default solver options");
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+
+  /* SplittingStep uses Lagrange interpolation by default, since the
+     partition RHS functions are not evaluated by the method. */
+  ARKodeSetInterpolantType(ark_mem, ARK_INTERP_LAGRANGE);
+
+  /* Initialize main ARKODE infrastructure */
+  retval = arkInit(ark_mem, t0, y0, FIRST_INIT);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Unable to initialize main ARKODE infrastructure");
+    ARKodeFree((void**)&ark_mem);
+    return (NULL);
+  }
+
+  return ((void*)ark_mem);
+}
+
+/*---------------------------------------------------------------
+  SplittingStepReInit:
+
+  This routine re-initializes the SplittingStep module to solve a
+  new problem of the same size as was previously solved, possibly
+  with new partition steppers. The number of partitions must be
+  unchanged. Steppers given to SplittingStepSetMethodSteppers are
+  discarded.
+
+  Note all internal counters are set to 0 on re-initialization.
+  ---------------------------------------------------------------*/
+int SplittingStepReInit(void* arkode_mem, MRIStepInnerStepper* steppers,
+                        int partitions, sunrealtype t0, N_Vector y0)
+{
+  ARKodeMem ark_mem;
+  ARKodeSplittingStepMem step_mem;
+  int retval, i, k;
+
+  /* access ARKodeSplittingStepMem structure */
+  retval = splittingStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                             &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Check if ark_mem was allocated */
+  if (ark_mem->MallocDone == SUNFALSE)
+  {
+    arkProcessError(ark_mem, ARK_NO_MALLOC, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NO_MALLOC);
+    return (ARK_NO_MALLOC);
+  }
+
+  /* Check for legal input parameters */
+  if (y0 == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_ARK_NULL_Y0);
+    return (ARK_ILL_INPUT);
+  }
+
+  retval = splittingStep_CheckSteppers(ark_mem, steppers, partitions);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (partitions != step_mem->partitions)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The number of partitions cannot be changed");
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Copy the partition steppers and discard the method steppers */
+  memcpy(step_mem->steppers, steppers, partitions * sizeof(MRIStepInnerStepper));
+  for (i = 0; i < step_mem->method_steppers_alloc; i++)
+  {
+    if (step_mem->method_steppers[i])
+    {
+      free(step_mem->method_steppers[i]);
+      step_mem->method_steppers[i] = NULL;
+    }
+  }
+
+  /* Initialize main ARKODE infrastructure */
+  retval = arkInit(arkode_mem, t0, y0, FIRST_INIT);
+  if (retval != ARK_SUCCESS)
+  {
+    arkProcessError(ark_mem, retval, __LINE__, __func__, __FILE__,
+                    "Unable to initialize main ARKODE infrastructure");
+    return (retval);
+  }
+
+  /* Initialize all the counters */
+  for (k = 0; k < partitions; k++) { step_mem->n_evolves[k] = 0; }
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Interface routines supplied to ARKODE
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  splittingStep_Resize:
+
+  This routine resizes the sequential method states and the RHS
+  workspace vector (if allocated). The partition steppers must be
+  resized by the user.
+  ---------------------------------------------------------------*/
+int splittingStep_Resize(ARKodeMem ark_mem, N_Vector y0,
+                         SUNDIALS_MAYBE_UNUSED sunrealtype hscale,
+                         SUNDIALS_MAYBE_UNUSED sunrealtype t0,
+                         ARKVecResizeFn resize, void* resize_data)
+{
+  ARKodeSplittingStepMem step_mem;
+  sunindextype lrw1, liw1, lrw_diff, liw_diff;
+  int retval;
+
+  /* access ARKodeSplittingStepMem structure */
+  retval = splittingStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* Determine change in vector sizes */
+  lrw1 = liw1 = 0;
+  if (y0->ops->nvspace != NULL) { N_VSpace(y0, &lrw1, &liw1); }
+  lrw_diff      = lrw1 - ark_mem->lrw1;
+  liw_diff      = liw1 - ark_mem->liw1;
+  ark_mem->lrw1 = lrw1;
+  ark_mem->liw1 = liw1;
+
+  /* Resize the sequential method states */
+  if (step_mem->yvecs != NULL)
+  {
+    if (!arkResizeVecArray(resize, resize_data, step_mem->yvecs_alloc, y0,
+                           &step_mem->yvecs, lrw_diff, &ark_mem->lrw,
+                           liw_diff, &ark_mem->liw))
+    {
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      "Unable to resize vector");
+      return (ARK_MEM_FAIL);
+    }
+  }
+
+  /* Resize the RHS workspace vector */
+  if (step_mem->ftemp != NULL)
+  {
+    if (!arkResizeVec(ark_mem, resize, resize_data, lrw_diff, liw_diff, y0,
+                      &step_mem->ftemp))
+    {
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      "Unable to resize vector");
+      return (ARK_MEM_FAIL);
+    }
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  splittingStep_Free frees all SplittingStep memory.
+  ---------------------------------------------------------------*/
+void splittingStep_Free(ARKodeMem ark_mem)
+{
+  ARKodeSplittingStepMem step_mem;
+  int i;
+
+  /* nothing to do if ark_mem is already NULL */
+  if (ark_mem == NULL) { return; }
+
+  /* conditional frees on non-NULL SplittingStep module */
+  if (ark_mem->step_mem != NULL)
+  {
+    step_mem = (ARKodeSplittingStepMem)ark_mem->step_mem;
+
+    /* free the sequential method states and workspace vector */
+    arkFreeVecArray(step_mem->yvecs_alloc, &step_mem->yvecs, ark_mem->lrw1,
+                    &ark_mem->lrw, ark_mem->liw1, &ark_mem->liw);
+    step_mem->yvecs_alloc = 0;
+    arkFreeVec(ark_mem, &step_mem->ftemp);
+
+    /* free the splitting coefficients */
+    if (step_mem->coefficients)
+    {
+      SplittingStepCoefficients_Free(step_mem->coefficients);
+      step_mem->coefficients = NULL;
+    }
+
+    /* free the stepper arrays (the steppers are owned by the user) */
+    if (step_mem->method_steppers)
+    {
+      for (i = 0; i < step_mem->method_steppers_alloc; i++)
+      {
+        if (step_mem->method_steppers[i])
+        {
+          free(step_mem->method_steppers[i]);
+        }
+      }
+      free(step_mem->method_steppers);
+      step_mem->method_steppers = NULL;
+    }
+    if (step_mem->steppers)
+    {
+      free(step_mem->steppers);
+      step_mem->steppers = NULL;
+    }
+
+    /* free the workspace arrays */
+    if (step_mem->cvals)
+    {
+      free(step_mem->cvals);
+      step_mem->cvals = NULL;
+    }
+    if (step_mem->n_evolves)
+    {
+      free(step_mem->n_evolves);
+      step_mem->n_evolves = NULL;
+    }
+    if (step_mem->evolves_work)
+    {
+      free(step_mem->evolves_work);
+      step_mem->evolves_work = NULL;
+    }
+
+    /* free the time stepper module itself */
+    free(ark_mem->step_mem);
+    ark_mem->step_mem = NULL;
+  }
+}
+
+/*---------------------------------------------------------------
+  splittingStep_PrintMem:
+
+  This routine outputs the memory from the SplittingStep structure
+  to a specified file pointer (useful when debugging).
+  ---------------------------------------------------------------*/
+void splittingStep_PrintMem(ARKodeMem ark_mem, FILE* outfile)
+{
+  ARKodeSplittingStepMem step_mem;
+  int retval, k;
+
+  /* access ARKodeSplittingStepMem structure */
+  retval = splittingStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return; }
+
+  /* output integer quantities */
+  fprintf(outfile, "SplittingStep: partitions = %i\n", step_mem->partitions);
+  fprintf(outfile, "SplittingStep: order = %i\n", step_mem->order);
+  fprintf(outfile, "SplittingStep: nthreads = %i\n", step_mem->nthreads);
+  fprintf(outfile, "SplittingStep: concurrent = %i\n", step_mem->concurrent);
+
+  /* output long integer quantities */
+  for (k = 0; k < step_mem->partitions; k++)
+  {
+    fprintf(outfile, "SplittingStep: partition %i: n_evolves = %li\n", k,
+            step_mem->n_evolves[k]);
+  }
+
+  /* output the splitting coefficients */
+  if (step_mem->coefficients)
+  {
+    fprintf(outfile, "SplittingStep: coefficients:\n");
+    SplittingStepCoefficients_Write(step_mem->coefficients, outfile);
+  }
+}
+
+/*---------------------------------------------------------------
+  splittingStep_Init:
+
+  This routine is called just prior to performing internal time
+  steps (after all user "set" routines have been called) from
+  within arkInitialSetup.
+
+  With all initialization types this routine:
+  - builds the default splitting coefficients of the requested
+    order (if none were supplied)
+  - limits the interpolant degree by the method order
+  - allocates the sequential method states and workspaces (if
+    needed)
+  - determines if the sequential methods can run concurrently
+  so that new coefficients or method steppers may be supplied
+  after a call to ARKodeReset.
+  ---------------------------------------------------------------*/
+int splittingStep_Init(ARKodeMem ark_mem,
+                       SUNDIALS_MAYBE_UNUSED int init_type)
+{
+  ARKodeSplittingStepMem step_mem;
+  SplittingStepCoefficients coefficients;
+  int retval, methods, order;
+
+  /* access ARKodeSplittingStepMem structure */
+  retval = splittingStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* the splitting methods have no error estimate */
+  if (!ark_mem->fixedstep)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "SplittingStep requires a fixed step size");
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Build the default coefficients of the requested order */
+  if (step_mem->coefficients == NULL)
+  {
+    order = step_mem->order;
+    if (order <= 1)
+    {
+      step_mem->coefficients =
+        SplittingStepCoefficients_LieTrotter(step_mem->partitions);
+    }
+    else if (order == 2)
+    {
+      step_mem->coefficients =
+        SplittingStepCoefficients_Strang(step_mem->partitions);
+    }
+    else
+    {
+      /* composition methods have even order */
+      step_mem->coefficients =
+        SplittingStepCoefficients_TripleJump(step_mem->partitions,
+                                             order + order % 2);
+    }
+    if (step_mem->coefficients == NULL)
+    {
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_ARKMEM_FAIL);
+      return (ARK_MEM_FAIL);
+    }
+  }
+  coefficients = step_mem->coefficients;
+  methods      = coefficients->sequential_methods;
+
+  if (coefficients->partitions != step_mem->partitions)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The splitting coefficients have %i partitions, but "
+                    "%i partition steppers were given",
+                    coefficients->partitions, step_mem->partitions);
+    return (ARK_ILL_INPUT);
+  }
+
+  /* Override the interpolant degree (if needed), used in arkInitialSetup */
+  if (coefficients->order > 1 &&
+      ark_mem->interp_degree > (coefficients->order - 1))
+  {
+    /* Limit max degree to at most one less than the method global order */
+    ark_mem->interp_degree = coefficients->order - 1;
+  }
+
+  /* Allocate the sequential method states (if needed) */
+  if (methods > 1)
+  {
+    if ((step_mem->yvecs != NULL) && (step_mem->yvecs_alloc < methods))
+    {
+      arkFreeVecArray(step_mem->yvecs_alloc, &step_mem->yvecs, ark_mem->lrw1,
+                      &ark_mem->lrw, ark_mem->liw1, &ark_mem->liw);
+      step_mem->yvecs_alloc = 0;
+    }
+    if (step_mem->yvecs == NULL)
+    {
+      if (!arkAllocVecArray(methods, ark_mem->ewt, &step_mem->yvecs,
+                            ark_mem->lrw1, &ark_mem->lrw, ark_mem->liw1,
+                            &ark_mem->liw))
+      {
+        return (ARK_MEM_FAIL);
+      }
+      step_mem->yvecs_alloc = methods;
+
+      if (step_mem->cvals) { free(step_mem->cvals); }
+      step_mem->cvals = (sunrealtype*)calloc(methods, sizeof(sunrealtype));
+      if (step_mem->cvals == NULL) { return (ARK_MEM_FAIL); }
+    }
+  }
+
+  /* Allocate the per method evolve counters */
+  if (step_mem->evolves_work_alloc < methods * step_mem->partitions)
+  {
+    if (step_mem->evolves_work) { free(step_mem->evolves_work); }
+    step_mem->evolves_work_alloc = methods * step_mem->partitions;
+    step_mem->evolves_work = (long int*)calloc(step_mem->evolves_work_alloc,
+                                               sizeof(long int));
+    if (step_mem->evolves_work == NULL)
+    {
+      step_mem->evolves_work_alloc = 0;
+      return (ARK_MEM_FAIL);
+    }
+  }
+
+  /* Determine if the sequential methods can be evolved concurrently */
+  step_mem->concurrent = splittingStep_IsConcurrent(step_mem);
+
+  return (ARK_SUCCESS);
+}
+
+/*------------------------------------------------------------------------------
+  splittingStep_FullRHS:
+
+  The full RHS is the sum of the RHS functions of the partitions, evaluated
+  by the partition steppers. The steppers are always called with the mode
+  ARK_FULLRHS_OTHER, so that their internal state is not modified.
+  ----------------------------------------------------------------------------*/
+int splittingStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y,
+                          N_Vector f, SUNDIALS_MAYBE_UNUSED int mode)
+{
+  ARKodeSplittingStepMem step_mem;
+  int retval, k;
+
+  /* access ARKodeSplittingStepMem structure */
+  retval = splittingStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* allocate the workspace vector (if needed) */
+  if (step_mem->partitions > 1 && step_mem->ftemp == NULL)
+  {
+    if (!arkAllocVec(ark_mem, ark_mem->ewt, &step_mem->ftemp))
+    {
+      return (ARK_MEM_FAIL);
+    }
+  }
+
+  for (k = 0; k < step_mem->partitions; k++)
+  {
+    retval = mriStepInnerStepper_FullRhs(step_mem->steppers[k], t, y,
+                                         (k == 0) ? f : step_mem->ftemp,
+                                         ARK_FULLRHS_OTHER);
+    if (retval != ARK_SUCCESS)
+    {
+      arkProcessError(ark_mem, ARK_RHSFUNC_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_RHSFUNC_FAILED, t);
+      return (ARK_RHSFUNC_FAIL);
+    }
+    if (k > 0) { N_VLinearSum(ONE, f, ONE, step_mem->ftemp, f); }
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  splittingStep_TakeStep:
+
+  This routine performs a single operator splitting step. Each
+  sequential method is evolved from yn (concurrently when the
+  methods use disjoint steppers and more than one thread was
+  requested) and the new solution is the linear combination of
+  the sequential method states.
+
+  The splitting methods have no error estimate, so dsmPtr is set
+  to zero. Failures of the partition steppers are unrecoverable.
+  ---------------------------------------------------------------*/
+int splittingStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr,
+                           int* nflagPtr)
+{
+  ARKodeSplittingStepMem step_mem;
+  SplittingStepCoefficients coefficients;
+  int retval, methods, i, k;
+
+  /* initialize algebraic solver convergence flag to success */
+  *nflagPtr = ARK_SUCCESS;
+  *dsmPtr   = ZERO;
+
+  /* access ARKodeSplittingStepMem structure */
+  retval = splittingStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  coefficients = step_mem->coefficients;
+  methods      = coefficients->sequential_methods;
+
+  if (methods == 1)
+  {
+    /* a single sequential method is evolved in place */
+    retval = splittingStep_SequentialMethod(ark_mem, step_mem, 0,
+                                            ark_mem->ycur);
+  }
+  else
+  {
+    retval = ARK_SUCCESS;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(step_mem->nthreads) schedule(dynamic) \
+  if (step_mem->concurrent && step_mem->nthreads > 1)
+#endif
+    for (i = 0; i < methods; i++)
+    {
+      int ier;
+
+      ier = splittingStep_SequentialMethod(ark_mem, step_mem, i,
+                                           step_mem->yvecs[i]);
+      if (ier != ARK_SUCCESS)
+      {
+#ifdef _OPENMP
+#pragma omp critical(splittingStep_TakeStep)
+#endif
+        {
+          if (retval == ARK_SUCCESS) { retval = ier; }
+        }
+      }
+    }
+
+    /* y_{n+1} = sum_i alpha_i y_i */
+    if (retval == ARK_SUCCESS)
+    {
+      for (i = 0; i < methods; i++)
+      {
+        step_mem->cvals[i] = coefficients->alpha[i];
+      }
+      retval = N_VLinearCombination(methods, step_mem->cvals, step_mem->yvecs,
+                                    ark_mem->ycur);
+      if (retval != 0) { retval = ARK_VECTOROP_ERR; }
+    }
+  }
+
+  /* update the counters */
+  for (i = 0; i < methods; i++)
+  {
+    for (k = 0; k < step_mem->partitions; k++)
+    {
+      step_mem->n_evolves[k] +=
+        step_mem->evolves_work[i * step_mem->partitions + k];
+    }
+  }
+
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  ark_mem->tcur = ark_mem->tn + ark_mem->h;
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
+  SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
+                     "ARKODE::splittingStep_TakeStep", "end-step",
+                     "step = %li, h = %" RSYM ", methods = %i", ark_mem->nst,
+                     ark_mem->h, methods);
+#endif
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Internal utility routines
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  splittingStep_AccessARKODEStepMem:
+
+  Shortcut routine to unpack both ark_mem and step_mem structures
+  from void* pointer. If either is missing it returns ARK_MEM_NULL.
+  ---------------------------------------------------------------*/
+int splittingStep_AccessARKODEStepMem(void* arkode_mem, const char* fname,
+                                      ARKodeMem* ark_mem,
+                                      ARKodeSplittingStepMem* step_mem)
+{
+  /* access ARKodeMem structure */
+  if (arkode_mem == NULL)
+  {
+    arkProcessError(NULL, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_ARK_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *ark_mem = (ARKodeMem)arkode_mem;
+
+  /* access ARKodeSplittingStepMem structure */
+  if ((*ark_mem)->step_mem == NULL)
+  {
+    arkProcessError(*ark_mem, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_SPLITTINGSTEP_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *step_mem = (ARKodeSplittingStepMem)(*ark_mem)->step_mem;
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  splittingStep_AccessStepMem:
+
+  Shortcut routine to unpack the step_mem structure from ark_mem.
+  If missing it returns ARK_MEM_NULL.
+  ---------------------------------------------------------------*/
+int splittingStep_AccessStepMem(ARKodeMem ark_mem, const char* fname,
+                                ARKodeSplittingStepMem* step_mem)
+{
+  /* access ARKodeSplittingStepMem structure */
+  if (ark_mem->step_mem == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_NULL, __LINE__, fname, __FILE__,
+                    MSG_SPLITTINGSTEP_NO_MEM);
+    return (ARK_MEM_NULL);
+  }
+  *step_mem = (ARKodeSplittingStepMem)ark_mem->step_mem;
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  splittingStep_CheckNVector:
+
+  This routine checks if all required vector operations are
+  present. If any of them is missing it returns SUNFALSE.
+  ---------------------------------------------------------------*/
+sunbooleantype splittingStep_CheckNVector(N_Vector tmpl)
+{
+  if ((tmpl->ops->nvclone == NULL) || (tmpl->ops->nvdestroy == NULL) ||
+      (tmpl->ops->nvlinearsum == NULL) || (tmpl->ops->nvconst == NULL) ||
+      (tmpl->ops->nvscale == NULL) || (tmpl->ops->nvwrmsnorm == NULL))
+  {
+    return (SUNFALSE);
+  }
+  return (SUNTRUE);
+}
+
+/*---------------------------------------------------------------
+  splittingStep_CheckSteppers:
+
+  This routine checks that an array of partition steppers is
+  valid. The ark_mem argument may be NULL.
+  ---------------------------------------------------------------*/
+int splittingStep_CheckSteppers(ARKodeMem ark_mem,
+                                MRIStepInnerStepper* steppers, int partitions)
+{
+  int k;
+
+  if (partitions < 1)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The number of partitions must be at least one");
+    return (ARK_ILL_INPUT);
+  }
+
+  if (steppers == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The partition steppers array is NULL");
+    return (ARK_ILL_INPUT);
+  }
+
+  for (k = 0; k < partitions; k++)
+  {
+    if (mriStepInnerStepper_HasRequiredOps(steppers[k]) != ARK_SUCCESS)
+    {
+      arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                      "The stepper of partition %i is NULL or is missing "
+                      "the evolve function",
+                      k);
+      return (ARK_ILL_INPUT);
+    }
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Private helper functions
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  splittingStep_GetStepper:
+
+  Returns the stepper of a partition for a sequential method.
+  ---------------------------------------------------------------*/
+static MRIStepInnerStepper splittingStep_GetStepper(
+  ARKodeSplittingStepMem step_mem, int method, int partition)
+{
+  if (method < step_mem->method_steppers_alloc &&
+      step_mem->method_steppers[method] != NULL)
+  {
+    return (step_mem->method_steppers[method][partition]);
+  }
+  return (step_mem->steppers[partition]);
+}
+
+/*---------------------------------------------------------------
+  splittingStep_Evolves:
+
+  Returns SUNTRUE if a sequential method has a nonzero substep
+  for a partition.
+  ---------------------------------------------------------------*/
+static sunbooleantype splittingStep_Evolves(
+  SplittingStepCoefficients coefficients, int method, int partition)
+{
+  int j;
+
+  for (j = 0; j < coefficients->stages; j++)
+  {
+    if (coefficients->beta[method][j + 1][partition] !=
+        coefficients->beta[method][j][partition])
+    {
+      return (SUNTRUE);
+    }
+  }
+  return (SUNFALSE);
+}
+
+/*---------------------------------------------------------------
+  splittingStep_IsConcurrent:
+
+  Returns SUNTRUE if no stepper is evolved by more than one
+  sequential method, in which case the methods are independent.
+  ---------------------------------------------------------------*/
+static sunbooleantype splittingStep_IsConcurrent(
+  ARKodeSplittingStepMem step_mem)
+{
+  SplittingStepCoefficients coefficients = step_mem->coefficients;
+  int i1, i2, k1, k2;
+
+  for (i1 = 0; i1 < coefficients->sequential_methods; i1++)
+  {
+    for (k1 = 0; k1 < step_mem->partitions; k1++)
+    {
+      /* skip partitions that are not evolved by method i1 */
+      if (!splittingStep_Evolves(coefficients, i1, k1)) { continue; }
+
+      for (i2 = i1 + 1; i2 < coefficients->sequential_methods; i2++)
+      {
+        for (k2 = 0; k2 < step_mem->partitions; k2++)
+        {
+          if (!splittingStep_Evolves(coefficients, i2, k2)) { continue; }
+          if (splittingStep_GetStepper(step_mem, i1, k1) ==
+              splittingStep_GetStepper(step_mem, i2, k2))
+          {
+            return (SUNFALSE);
+          }
+        }
+      }
+    }
+  }
+
+  return (SUNTRUE);
+}
+
+/*---------------------------------------------------------------
+  splittingStep_SequentialMethod:
+
+  Evolves y from yn with one sequential method. In stage j each
+  partition k is evolved from tn + beta[i][j][k] h to
+  tn + beta[i][j+1][k] h, after its stepper is given the
+  current state. A stepper that already sits at the start of the
+  substep (e.g., the end of its previous substep) keeps its step
+  size and solver data, others are reset. Zero length substeps
+  are skipped. The evolves of each partition are counted in the
+  row of the method in evolves_work.
+  ---------------------------------------------------------------*/
+static int splittingStep_SequentialMethod(ARKodeMem ark_mem,
+                                          ARKodeSplittingStepMem step_mem,
+                                          int method, N_Vector y)
+{
+  SplittingStepCoefficients coefficients = step_mem->coefficients;
+  MRIStepInnerStepper stepper;
+  long int* evolves;
+  sunrealtype t_start, t_end;
+  int retval, j, k;
+
+  evolves = &(step_mem->evolves_work[method * step_mem->partitions]);
+  for (k = 0; k < step_mem->partitions; k++) { evolves[k] = 0; }
+
+  N_VScale(ONE, ark_mem->yn, y);
+
+  for (j = 0; j < coefficients->stages; j++)
+  {
+    for (k = 0; k < step_mem->partitions; k++)
+    {
+      t_start = ark_mem->tn + coefficients->beta[method][j][k] * ark_mem->h;
+      t_end   = ark_mem->tn + coefficients->beta[method][j + 1][k] * ark_mem->h;
+      if (t_start == t_end) { continue; }
+
+#if SUNDIALS_LOGGING_LEVEL >= SUNDIALS_LOGGING_DEBUG
+      SUNLogger_QueueMsg(ARK_LOGGER, SUN_LOGLEVEL_DEBUG,
+                         "ARKODE::splittingStep_SequentialMethod",
+                         "start-partition",
+                         "method = %i, stage = %i, partition = %i, "
+                         "t_start = %" RSYM ", t_end = %" RSYM,
+                         method, j, k, t_start, t_end);
+#endif
+
+      stepper = splittingStep_GetStepper(step_mem, method, k);
+
+      retval = mriStepInnerStepper_SetState(stepper, t_start, y);
+      if (retval != ARK_SUCCESS) { return (ARK_INNERSTEP_FAIL); }
+
+      retval = mriStepInnerStepper_Evolve(stepper, t_start, t_end, y);
+      evolves[k]++;
+      if (retval != ARK_SUCCESS) { return (ARK_INNERSTEP_FAIL); }
+    }
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
@@ -0,0 +1,526 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * This is the implementation file for the splitting coefficients
+ * of the ARKODE SplittingStep module.
+ *
+ * The composition methods (Strang, triple jump and Suzuki
+ * fractal) are first built as a list of flows, i.e., pairs of a
+ * partition and a fraction of the step size, which is then
+ * converted to stages: consecutive flows of the same partition
+ * are merged, and a new stage is started whenever the partition
+ * index does not increase.
+ *--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arkode/arkode_splittingstep.h>
+#include <sundials/sundials_math.h>
+
+#include "arkode_impl.h"
+
+/* names of the splitting coefficients, indexed by ID */
+static const char* const splitting_names[] = {
+  "ARKODE_SPLITTING_LIE_TROTTER_1_1_2", "ARKODE_SPLITTING_STRANG_2_2_2",
+  "ARKODE_SPLITTING_BEST_2_2_2",        "ARKODE_SPLITTING_RUTH_3_3_2",
+  "ARKODE_SPLITTING_YOSHIDA_4_4_2",     "ARKODE_SPLITTING_YOSHIDA_8_6_2"};
+
+/* a flow of one partition over a fraction of the step size */
+typedef struct
+{
+  int partition;
+  sunrealtype dt;
+} splittingFlow;
+
+/*===============================================================
+  Private helper functions for composition methods
+  ===============================================================*/
+
+/* appends the flows of the Strang splitting scaled by h */
+static void splitting_StrangFlows(int partitions, sunrealtype h,
+                                  splittingFlow* flows, int* nflows)
+{
+  int k;
+
+  for (k = 0; k < partitions - 1; k++)
+  {
+    flows[*nflows].partition = k;
+    flows[*nflows].dt        = HALF * h;
+    (*nflows)++;
+  }
+  flows[*nflows].partition = partitions - 1;
+  flows[*nflows].dt        = h;
+  (*nflows)++;
+  for (k = partitions - 2; k >= 0; k--)
+  {
+    flows[*nflows].partition = k;
+    flows[*nflows].dt        = HALF * h;
+    (*nflows)++;
+  }
+}
+
+/* appends the flows of a symmetric composition of order 'order' built
+   recursively from the Strang splitting with 'nsub' (3 for the triple
+   jump, 5 for the Suzuki fractal) substeps per level */
+static void splitting_CompositionFlows(int partitions, int order, int nsub,
+                                       sunrealtype h, splittingFlow* flows,
+                                       int* nflows)
+{
+  sunrealtype gamma1, gamma2, root;
+  int i;
+
+  if (order <= 2)
+  {
+    splitting_StrangFlows(partitions, h, flows, nflows);
+    return;
+  }
+
+  /* gamma1 (nsub-1 times) and gamma2 cancel the leading error term of
+     the method of order 'order - 2' */
+  root   = SUNRpowerR(nsub - 1, ONE / (order - 1));
+  gamma1 = ONE / ((nsub - 1) - root);
+  gamma2 = ONE - (nsub - 1) * gamma1;
+
+  for (i = 0; i < nsub; i++)
+  {
+    splitting_CompositionFlows(partitions, order - 2, nsub,
+                               (i == nsub / 2) ? gamma2 * h : gamma1 * h,
+                               flows, nflows);
+  }
+}
+
+/* converts a list of flows into single sequential method coefficients */
+static SplittingStepCoefficients splitting_FlowsToCoefficients(
+  int partitions, int order, splittingFlow* flows, int nflows)
+{
+  SplittingStepCoefficients coefficients;
+  int i, m, j, k, last, stages;
+
+  /* merge consecutive flows of the same partition */
+  m = 0;
+  for (i = 1; i < nflows; i++)
+  {
+    if (flows[i].partition == flows[m].partition)
+    {
+      flows[m].dt += flows[i].dt;
+    }
+    else { flows[++m] = flows[i]; }
+  }
+  nflows = m + 1;
+
+  /* count the stages */
+  stages = 1;
+  for (i = 1; i < nflows; i++)
+  {
+    if (flows[i].partition <= flows[i - 1].partition) { stages++; }
+  }
+
+  coefficients = SplittingStepCoefficients_Alloc(1, stages, partitions);
+  if (coefficients == NULL) { return (NULL); }
+  coefficients->order    = order;
+  coefficients->alpha[0] = ONE;
+
+  /* accumulate the substep times of each stage (beta is zero initialized) */
+  j    = 0;
+  last = -1;
+  for (i = 0; i < nflows; i++)
+  {
+    if (flows[i].partition <= last)
+    {
+      j++;
+      for (k = 0; k < partitions; k++)
+      {
+        coefficients->beta[0][j + 1][k] = coefficients->beta[0][j][k];
+      }
+    }
+    coefficients->beta[0][j + 1][flows[i].partition] += flows[i].dt;
+    last = flows[i].partition;
+  }
+
+  return (coefficients);
+}
+
+/* builds a composition method of even order */
+static SplittingStepCoefficients splitting_Composition(int partitions,
+                                                       int order, int nsub)
+{
+  SplittingStepCoefficients coefficients;
+  splittingFlow* flows;
+  int nflows, nstrang, i;
+
+  if (partitions < 1 || order < 2 || order % 2 != 0) { return (NULL); }
+
+  /* number of Strang splittings in the composition */
+  nstrang = 1;
+  for (i = 2; i < order; i += 2) { nstrang *= nsub; }
+
+  flows = (splittingFlow*)malloc(nstrang * (2 * partitions - 1) *
+                                 sizeof(*flows));
+  if (flows == NULL) { return (NULL); }
+
+  nflows = 0;
+  splitting_CompositionFlows(partitions, order, nsub, ONE, flows, &nflows);
+  coefficients = splitting_FlowsToCoefficients(partitions, order, flows,
+                                               nflows);
+
+  free(flows);
+  return (coefficients);
+}
+
+/*===============================================================
+  Exported functions
+  ===============================================================*/
+
+SplittingStepCoefficients SplittingStepCoefficients_Alloc(
+  int sequential_methods, int stages, int partitions)
+{
+  SplittingStepCoefficients coefficients;
+  int i, j;
+
+  if (sequential_methods < 1 || stages < 1 || partitions < 1) { return (NULL); }
+
+  coefficients = (SplittingStepCoefficients)calloc(1, sizeof(*coefficients));
+  if (coefficients == NULL) { return (NULL); }
+
+  coefficients->sequential_methods = sequential_methods;
+  coefficients->stages             = stages;
+  coefficients->partitions         = partitions;
+
+  coefficients->alpha = (sunrealtype*)calloc(sequential_methods,
+                                             sizeof(sunrealtype));
+  if (coefficients->alpha == NULL)
+  {
+    SplittingStepCoefficients_Free(coefficients);
+    return (NULL);
+  }
+
+  /* beta is stored contiguously, with pointer arrays for each level */
+  coefficients->beta = (sunrealtype***)malloc(sequential_methods *
+                                              sizeof(sunrealtype**));
+  if (coefficients->beta == NULL)
+  {
+    SplittingStepCoefficients_Free(coefficients);
+    return (NULL);
+  }
+
+  coefficients->beta[0] = (sunrealtype**)malloc(sequential_methods *
+                                                (stages + 1) *
+                                                sizeof(sunrealtype*));
+  if (coefficients->beta[0] == NULL)
+  {
+    free(coefficients->beta);
+    coefficients->beta = NULL;
+    SplittingStepCoefficients_Free(coefficients);
+    return (NULL);
+  }
+
+  coefficients->beta[0][0] = (sunrealtype*)calloc(sequential_methods *
+                                                    (stages + 1) * partitions,
+                                                  sizeof(sunrealtype));
+  if (coefficients->beta[0][0] == NULL)
+  {
+    SplittingStepCoefficients_Free(coefficients);
+    return (NULL);
+  }
+
+  for (i = 0; i < sequential_methods; i++)
+  {
+    coefficients->beta[i] = &(coefficients->beta[0][i * (stages + 1)]);
+    for (j = 0; j <= stages; j++)
+    {
+      coefficients->beta[i][j] =
+        &(coefficients->beta[0][0][(i * (stages + 1) + j) * partitions]);
+    }
+  }
+
+  return (coefficients);
+}
+
+SplittingStepCoefficients SplittingStepCoefficients_Create(
+  int sequential_methods, int stages, int partitions, int order,
+  const sunrealtype* alpha, const sunrealtype* beta)
+{
+  SplittingStepCoefficients coefficients;
+
+  if (alpha == NULL || beta == NULL || order < 1) { return (NULL); }
+
+  coefficients = SplittingStepCoefficients_Alloc(sequential_methods, stages,
+                                                 partitions);
+  if (coefficients == NULL) { return (NULL); }
+
+  coefficients->order = order;
+  memcpy(coefficients->alpha, alpha, sequential_methods * sizeof(sunrealtype));
+  memcpy(coefficients->beta[0][0], beta,
+         sequential_methods * (stages + 1) * partitions * sizeof(sunrealtype));
+
+  return (coefficients);
+}
+
+void SplittingStepCoefficients_Free(SplittingStepCoefficients coefficients)
+{
+  if (coefficients == NULL) { return; }
+
+  if (coefficients->alpha) { free(coefficients->alpha); }
+  if (coefficients->beta)
+  {
+    if (coefficients->beta[0])
+    {
+      if (coefficients->beta[0][0]) { free(coefficients->beta[0][0]); }
+      free(coefficients->beta[0]);
+    }
+    free(coefficients->beta);
+  }
+  free(coefficients);
+}
+
+SplittingStepCoefficients SplittingStepCoefficients_Copy(
+  SplittingStepCoefficients coefficients)
+{
+  if (coefficients == NULL) { return (NULL); }
+
+  return (SplittingStepCoefficients_Create(coefficients->sequential_methods,
+                                           coefficients->stages,
+                                           coefficients->partitions,
+                                           coefficients->order,
+                                           coefficients->alpha,
+                                           coefficients->beta[0][0]));
+}
+
+void SplittingStepCoefficients_Write(SplittingStepCoefficients coefficients,
+                                     FILE* outfile)
+{
+  int i, j, k;
+
+  if (coefficients == NULL || outfile == NULL) { return; }
+
+  fprintf(outfile, "  sequential methods = %i\n",
+          coefficients->sequential_methods);
+  fprintf(outfile, "  stages = %i\n", coefficients->stages);
+  fprintf(outfile, "  partitions = %i\n", coefficients->partitions);
+  fprintf(outfile, "  order = %i\n", coefficients->order);
+  fprintf(outfile, "  alpha =");
+  for (i = 0; i < coefficients->sequential_methods; i++)
+  {
+    fprintf(outfile, "  %" RSYM, coefficients->alpha[i]);
+  }
+  fprintf(outfile, "\n");
+  for (i = 0; i < coefficients->sequential_methods; i++)
+  {
+    fprintf(outfile, "  beta[%i] =\n", i);
+    for (j = 0; j <= coefficients->stages; j++)
+    {
+      fprintf(outfile, "     ");
+      for (k = 0; k < coefficients->partitions; k++)
+      {
+        fprintf(outfile, "  %" RSYM, coefficients->beta[i][j][k]);
+      }
+      fprintf(outfile, "\n");
+    }
+  }
+}
+
+SplittingStepCoefficients SplittingStepCoefficients_LoadCoefficients(
+  ARKODE_SplittingCoefficientsID id)
+{
+  const sunrealtype alpha[1] = {ONE};
+  sunrealtype r;
+
+  switch (id)
+  {
+  case ARKODE_SPLITTING_LIE_TROTTER_1_1_2:
+    return (SplittingStepCoefficients_LieTrotter(2));
+  case ARKODE_SPLITTING_STRANG_2_2_2:
+    return (SplittingStepCoefficients_Strang(2));
+  case ARKODE_SPLITTING_BEST_2_2_2:
+  {
+    /* the second order two stage method with the smallest error constant */
+    r = ONE / SUNRsqrt(TWO);
+    const sunrealtype beta[] = {ZERO, ZERO, ONE - r, r, ONE, ONE};
+    return (SplittingStepCoefficients_Create(1, 2, 2, 2, alpha, beta));
+  }
+  case ARKODE_SPLITTING_RUTH_3_3_2:
+  {
+    /* R.D. Ruth, A canonical integration technique, IEEE Trans. Nucl.
+       Sci. 30 (1983), 2669-2671 */
+    const sunrealtype beta[] = {ZERO,
+                                ZERO,
+                                SUN_RCONST(7.0) / SUN_RCONST(24.0),
+                                SUN_RCONST(2.0) / SUN_RCONST(3.0),
+                                SUN_RCONST(25.0) / SUN_RCONST(24.0),
+                                ZERO,
+                                ONE,
+                                ONE};
+    return (SplittingStepCoefficients_Create(1, 3, 2, 3, alpha, beta));
+  }
+  case ARKODE_SPLITTING_YOSHIDA_4_4_2:
+    return (SplittingStepCoefficients_TripleJump(2, 4));
+  case ARKODE_SPLITTING_YOSHIDA_8_6_2:
+    return (SplittingStepCoefficients_TripleJump(2, 6));
+  default: return (NULL);
+  }
+}
+
+SplittingStepCoefficients SplittingStepCoefficients_LoadCoefficientsByName(
+  const char* name)
+{
+  int id;
+
+  if (name == NULL) { return (NULL); }
+
+  for (id = ARKODE_MIN_SPLITTING_NUM; id <= ARKODE_MAX_SPLITTING_NUM; id++)
+  {
+    if (!strcmp(name, splitting_names[id]))
+    {
+      return (SplittingStepCoefficients_LoadCoefficients(
+        (ARKODE_SplittingCoefficientsID)id));
+    }
+  }
+
+  return (NULL);
+}
+
+const char* SplittingStepCoefficients_IDToName(
+  ARKODE_SplittingCoefficientsID id)
+{
+  if (id < ARKODE_MIN_SPLITTING_NUM || id > ARKODE_MAX_SPLITTING_NUM)
+  {
+    return (NULL);
+  }
+  return (splitting_names[id]);
+}
+
+/*---------------------------------------------------------------
+  SplittingStepCoefficients_LieTrotter:
+
+  The first order Lie-Trotter splitting, which evolves each
+  partition over the full step in a single stage.
+  ---------------------------------------------------------------*/
+SplittingStepCoefficients SplittingStepCoefficients_LieTrotter(int partitions)
+{
+  SplittingStepCoefficients coefficients;
+  int k;
+
+  coefficients = SplittingStepCoefficients_Alloc(1, 1, partitions);
+  if (coefficients == NULL) { return (NULL); }
+
+  coefficients->order    = 1;
+  coefficients->alpha[0] = ONE;
+  for (k = 0; k < partitions; k++) { coefficients->beta[0][1][k] = ONE; }
+
+  return (coefficients);
+}
+
+/*---------------------------------------------------------------
+  SplittingStepCoefficients_Strang:
+
+  The second order Strang splitting, which evolves the first
+  partitions over half steps, forward and then in reverse order,
+  around a full step of the last partition.
+  ---------------------------------------------------------------*/
+SplittingStepCoefficients SplittingStepCoefficients_Strang(int partitions)
+{
+  return (splitting_Composition(partitions, 2, 3));
+}
+
+/*---------------------------------------------------------------
+  SplittingStepCoefficients_Parallel:
+
+  The first order parallel splitting
+
+    y_{n+1} = sum_k phi_k(h) yn + (1 - P) yn,
+
+  in which the partitions are evolved independently, each by its
+  own sequential method, and the last sequential method is the
+  identity.
+  ---------------------------------------------------------------*/
+SplittingStepCoefficients SplittingStepCoefficients_Parallel(int partitions)
+{
+  SplittingStepCoefficients coefficients;
+  int i;
+
+  if (partitions < 1) { return (NULL); }
+
+  coefficients = SplittingStepCoefficients_Alloc(partitions + 1, 1, partitions);
+  if (coefficients == NULL) { return (NULL); }
+
+  coefficients->order = 1;
+  for (i = 0; i < partitions; i++)
+  {
+    coefficients->alpha[i]       = ONE;
+    coefficients->beta[i][1][i] = ONE;
+  }
+  coefficients->alpha[partitions] = ONE - partitions;
+
+  return (coefficients);
+}
+
+/*---------------------------------------------------------------
+  SplittingStepCoefficients_SymmetricParallel:
+
+  The second order average of the Lie-Trotter splitting and the
+  Lie-Trotter splitting with the partitions in reverse order.
+  ---------------------------------------------------------------*/
+SplittingStepCoefficients SplittingStepCoefficients_SymmetricParallel(
+  int partitions)
+{
+  SplittingStepCoefficients coefficients;
+  int j, k;
+
+  coefficients = SplittingStepCoefficients_Alloc(2, partitions, partitions);
+  if (coefficients == NULL) { return (NULL); }
+
+  coefficients->order    = 2;
+  coefficients->alpha[0] = HALF;
+  coefficients->alpha[1] = HALF;
+
+  /* forward order in the first stage, reverse order one per stage */
+  for (j = 1; j <= partitions; j++)
+  {
+    for (k = 0; k < partitions; k++)
+    {
+      coefficients->beta[0][j][k] = ONE;
+      if (k >= partitions - j) { coefficients->beta[1][j][k] = ONE; }
+    }
+  }
+
+  return (coefficients);
+}
+
+/*---------------------------------------------------------------
+  SplittingStepCoefficients_TripleJump:
+
+  The composition method of even order built recursively from
+  the Strang splitting by the triple jump of Yoshida (Phys. Lett.
+  A 150 (1990), 262-268).
+  ---------------------------------------------------------------*/
+SplittingStepCoefficients SplittingStepCoefficients_TripleJump(int partitions,
+                                                               int order)
+{
+  return (splitting_Composition(partitions, order, 3));
+}
+
+/*---------------------------------------------------------------
+  SplittingStepCoefficients_SuzukiFractal:
+
+  The composition method of even order built recursively from
+  the Strang splitting by the five substep fractal of Suzuki
+  (Phys. Lett. A 146 (1990), 319-323).
+  ---------------------------------------------------------------*/
+SplittingStepCoefficients SplittingStepCoefficients_SuzukiFractal(
+  int partitions, int order)
+{
+  return (splitting_Composition(partitions, order, 5));
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
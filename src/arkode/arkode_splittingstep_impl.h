@@ -0,0 +1,112 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * Implementation header file for ARKODE's operator splitting
+ * time stepper module.
+ *--------------------------------------------------------------*/
+
+#ifndef _ARKODE_SPLITTINGSTEP_IMPL_H
+#define _ARKODE_SPLITTINGSTEP_IMPL_H
+
+#include <arkode/arkode_splittingstep.h>
+
+#include "arkode_impl.h"
+#include "arkode_mristep_impl.h"
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*===============================================================
+  SplittingStep time step module data structure
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  Types : struct ARKodeSplittingStepMemRec, ARKodeSplittingStepMem
+  ---------------------------------------------------------------
+  The type ARKodeSplittingStepMem is type pointer to struct
+  ARKodeSplittingStepMemRec. This structure contains fields to
+  perform an operator splitting step. Each partition is evolved
+  by an MRIStepInnerStepper; sequential methods may be given
+  their own steppers so that they can be evolved concurrently.
+  ---------------------------------------------------------------*/
+typedef struct ARKodeSplittingStepMemRec
+{
+  /* Partition steppers */
+  MRIStepInnerStepper* steppers;         /* steppers of each partition    */
+  int partitions;                        /* number of partitions          */
+  MRIStepInnerStepper** method_steppers; /* steppers of each sequential
+                                            method (NULL for default)     */
+  int method_steppers_alloc;             /* length of method_steppers     */
+
+  /* Splitting coefficients */
+  SplittingStepCoefficients coefficients; /* coefficients (NULL for default) */
+  int order;                              /* order of the default method     */
+
+  /* Sequential method states and fused operation workspace */
+  N_Vector* yvecs;  /* states of the sequential methods  */
+  int yvecs_alloc;  /* number of allocated states        */
+  N_Vector ftemp;   /* partition RHS for the full RHS    */
+  sunrealtype* cvals;
+
+  /* Concurrent evaluation of the sequential methods */
+  int nthreads;              /* number of OpenMP threads           */
+  sunbooleantype concurrent; /* methods use disjoint steppers      */
+
+  /* Counters */
+  long int* n_evolves;      /* evolves of each partition          */
+  long int* evolves_work;   /* evolves of each method in a step   */
+  int evolves_work_alloc;   /* length of evolves_work             */
+}* ARKodeSplittingStepMem;
+
+/*===============================================================
+  SplittingStep time step module private function prototypes
+  ===============================================================*/
+
+/* Interface routines supplied to ARKODE */
+int splittingStep_Init(ARKodeMem ark_mem, int init_type);
+int splittingStep_FullRHS(ARKodeMem ark_mem, sunrealtype t, N_Vector y,
+                          N_Vector f, int mode);
+int splittingStep_TakeStep(ARKodeMem ark_mem, sunrealtype* dsmPtr,
+                           int* nflagPtr);
+int splittingStep_SetDefaults(ARKodeMem ark_mem);
+int splittingStep_SetOrder(ARKodeMem ark_mem, int ord);
+int splittingStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile,
+                                SUNOutputFormat fmt);
+int splittingStep_WriteParameters(ARKodeMem ark_mem, FILE* fp);
+int splittingStep_Resize(ARKodeMem ark_mem, N_Vector y0, sunrealtype hscale,
+                         sunrealtype t0, ARKVecResizeFn resize,
+                         void* resize_data);
+void splittingStep_Free(ARKodeMem ark_mem);
+void splittingStep_PrintMem(ARKodeMem ark_mem, FILE* outfile);
+
+/* Internal utility routines */
+int splittingStep_AccessARKODEStepMem(void* arkode_mem, const char* fname,
+                                      ARKodeMem* ark_mem,
+                                      ARKodeSplittingStepMem* step_mem);
+int splittingStep_AccessStepMem(ARKodeMem ark_mem, const char* fname,
+                                ARKodeSplittingStepMem* step_mem);
+sunbooleantype splittingStep_CheckNVector(N_Vector tmpl);
+int splittingStep_CheckSteppers(ARKodeMem ark_mem,
+                                MRIStepInnerStepper* steppers, int partitions);
+
+/*===============================================================
+  Reusable SplittingStep Error Messages
+  ===============================================================*/
+
+/* Initialization and I/O error messages */
+#define MSG_SPLITTINGSTEP_NO_MEM "Time step module memory is NULL."
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,348 @@
+/*---------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ *---------------------------------------------------------------
+ * This is the implementation file for the optional input and
+ * output functions for the ARKODE SplittingStep time stepper
+ * module.
+ *--------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/sundials_types.h>
+
+#include "arkode_splittingstep_impl.h"
+
+/*===============================================================
+  Exported optional input functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  SplittingStepSetCoefficients:
+
+  Specifies the splitting coefficients, which are copied. The
+  number of partitions must match the number of steppers.
+  ---------------------------------------------------------------*/
+int SplittingStepSetCoefficients(void* arkode_mem,
+                                 SplittingStepCoefficients coefficients)
+{
+  ARKodeMem ark_mem;
+  ARKodeSplittingStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeSplittingStepMem structures */
+  retval = splittingStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                             &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (coefficients == NULL)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The splitting coefficients are NULL");
+    return (ARK_ILL_INPUT);
+  }
+
+  if (coefficients->partitions != step_mem->partitions)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The splitting coefficients must have %i partitions",
+                    step_mem->partitions);
+    return (ARK_ILL_INPUT);
+  }
+
+  if (step_mem->coefficients)
+  {
+    SplittingStepCoefficients_Free(step_mem->coefficients);
+  }
+  step_mem->coefficients = SplittingStepCoefficients_Copy(coefficients);
+  if (step_mem->coefficients == NULL)
+  {
+    arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                    MSG_ARK_ARKMEM_FAIL);
+    return (ARK_MEM_FAIL);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  SplittingStepSetMethodSteppers:
+
+  Specifies the partition steppers of one sequential method. A
+  NULL array restores the steppers given at creation. Sequential
+  methods that do not share any stepper are evolved concurrently.
+  ---------------------------------------------------------------*/
+int SplittingStepSetMethodSteppers(void* arkode_mem, int method,
+                                   MRIStepInnerStepper* steppers)
+{
+  ARKodeMem ark_mem;
+  ARKodeSplittingStepMem step_mem;
+  MRIStepInnerStepper** method_steppers;
+  int retval, i;
+
+  /* access ARKodeMem and ARKodeSplittingStepMem structures */
+  retval = splittingStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                             &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (method < 0)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The sequential method index must be non-negative");
+    return (ARK_ILL_INPUT);
+  }
+
+  /* restore the default steppers */
+  if (steppers == NULL)
+  {
+    if (method < step_mem->method_steppers_alloc &&
+        step_mem->method_steppers[method] != NULL)
+    {
+      free(step_mem->method_steppers[method]);
+      step_mem->method_steppers[method] = NULL;
+    }
+    return (ARK_SUCCESS);
+  }
+
+  retval = splittingStep_CheckSteppers(ark_mem, steppers, step_mem->partitions);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* grow the array of method steppers (if needed) */
+  if (method >= step_mem->method_steppers_alloc)
+  {
+    method_steppers = (MRIStepInnerStepper**)realloc(step_mem->method_steppers,
+                                                     (method + 1) *
+                                                       sizeof(*method_steppers));
+    if (method_steppers == NULL)
+    {
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_ARKMEM_FAIL);
+      return (ARK_MEM_FAIL);
+    }
+    for (i = step_mem->method_steppers_alloc; i <= method; i++)
+    {
+      method_steppers[i] = NULL;
+    }
+    step_mem->method_steppers       = method_steppers;
+    step_mem->method_steppers_alloc = method + 1;
+  }
+
+  if (step_mem->method_steppers[method] == NULL)
+  {
+    step_mem->method_steppers[method] = (MRIStepInnerStepper*)malloc(
+      step_mem->partitions * sizeof(MRIStepInnerStepper));
+    if (step_mem->method_steppers[method] == NULL)
+    {
+      arkProcessError(ark_mem, ARK_MEM_FAIL, __LINE__, __func__, __FILE__,
+                      MSG_ARK_ARKMEM_FAIL);
+      return (ARK_MEM_FAIL);
+    }
+  }
+  memcpy(step_mem->method_steppers[method], steppers,
+         step_mem->partitions * sizeof(MRIStepInnerStepper));
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  SplittingStepSetNumThreads:
+
+  Specifies the number of OpenMP threads used to evolve
+  independent sequential methods. The value is ignored when
+  ARKODE is built without OpenMP; a non-positive value restores
+  the default (1).
+  ---------------------------------------------------------------*/
+int SplittingStepSetNumThreads(void* arkode_mem, int nthreads)
+{
+  ARKodeMem ark_mem;
+  ARKodeSplittingStepMem step_mem;
+  int retval;
+
+  /* access ARKodeMem and ARKodeSplittingStepMem structures */
+  retval = splittingStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                             &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  step_mem->nthreads = (nthreads > 0) ? nthreads : 1;
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Exported optional output functions.
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  SplittingStepGetNumEvolves:
+
+  Returns the number of stepper evolves of a partition, or the
+  total over all partitions if partition is negative.
+  ---------------------------------------------------------------*/
+int SplittingStepGetNumEvolves(void* arkode_mem, int partition,
+                               long int* evolves)
+{
+  ARKodeMem ark_mem;
+  ARKodeSplittingStepMem step_mem;
+  int retval, k;
+
+  /* access ARKodeMem and ARKodeSplittingStepMem structures */
+  retval = splittingStep_AccessARKODEStepMem(arkode_mem, __func__, &ark_mem,
+                                             &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  if (partition >= step_mem->partitions)
+  {
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "The partition index is %i but there are only %i "
+                    "partitions",
+                    partition, step_mem->partitions);
+    return (ARK_ILL_INPUT);
+  }
+
+  if (partition >= 0) { *evolves = step_mem->n_evolves[partition]; }
+  else
+  {
+    *evolves = 0;
+    for (k = 0; k < step_mem->partitions; k++)
+    {
+      *evolves += step_mem->n_evolves[k];
+    }
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  Private functions attached to ARKODE
+  ===============================================================*/
+
+/*---------------------------------------------------------------
+  splittingStep_SetDefaults:
+
+  Resets all SplittingStep optional inputs to their default
+  values. Does not change problem-defining function pointers or
+  user_data pointer.
+  ---------------------------------------------------------------*/
+int splittingStep_SetDefaults(ARKodeMem ark_mem)
+{
+  ARKodeSplittingStepMem step_mem;
+  int retval;
+
+  /* access ARKodeSplittingStepMem structure */
+  retval = splittingStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  step_mem->nthreads = 1;
+
+  /* use the default method order */
+  return (splittingStep_SetOrder(ark_mem, 0));
+}
+
+/*---------------------------------------------------------------
+  splittingStep_SetOrder:
+
+  Specifies the order of the default splitting coefficients: the
+  Lie-Trotter splitting for order 1, the Strang splitting for
+  order 2, and triple jump compositions of the Strang splitting
+  for higher (even) orders. Non-positive values select order 1.
+  Any previously set coefficients are discarded.
+  ---------------------------------------------------------------*/
+int splittingStep_SetOrder(ARKodeMem ark_mem, int ord)
+{
+  ARKodeSplittingStepMem step_mem;
+  int retval;
+
+  /* access ARKodeSplittingStepMem structure */
+  retval = splittingStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  step_mem->order = (ord > 0) ? ord : 1;
+
+  if (step_mem->coefficients)
+  {
+    SplittingStepCoefficients_Free(step_mem->coefficients);
+    step_mem->coefficients = NULL;
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  splittingStep_PrintAllStats:
+
+  Prints integrator statistics
+  ---------------------------------------------------------------*/
+int splittingStep_PrintAllStats(ARKodeMem ark_mem, FILE* outfile,
+                                SUNOutputFormat fmt)
+{
+  ARKodeSplittingStepMem step_mem;
+  int retval, k;
+
+  /* access ARKodeSplittingStepMem structure */
+  retval = splittingStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  switch (fmt)
+  {
+  case SUN_OUTPUTFORMAT_TABLE:
+    for (k = 0; k < step_mem->partitions; k++)
+    {
+      fprintf(outfile, "Partition %i evolves          = %ld\n", k,
+              step_mem->n_evolves[k]);
+    }
+    break;
+  case SUN_OUTPUTFORMAT_CSV:
+    for (k = 0; k < step_mem->partitions; k++)
+    {
+      fprintf(outfile, ",Partition %i evolves,%ld", k, step_mem->n_evolves[k]);
+    }
+    break;
+  default:
+    arkProcessError(ark_mem, ARK_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    "Invalid formatting option.");
+    return (ARK_ILL_INPUT);
+  }
+
+  return (ARK_SUCCESS);
+}
+
+/*---------------------------------------------------------------
+  splittingStep_WriteParameters:
+
+  Outputs all solver parameters to the provided file pointer.
+  ---------------------------------------------------------------*/
+int splittingStep_WriteParameters(ARKodeMem ark_mem, FILE* fp)
+{
+  ARKodeSplittingStepMem step_mem;
+  int retval;
+
+  /* access ARKodeSplittingStepMem structure */
+  retval = splittingStep_AccessStepMem(ark_mem, __func__, &step_mem);
+  if (retval != ARK_SUCCESS) { return (retval); }
+
+  /* print integrator parameters to file */
+  fprintf(fp, "SplittingStep time step module parameters:\n");
+  fprintf(fp, "  Number of partitions %i\n", step_mem->partitions);
+  fprintf(fp, "  Number of threads %i\n", step_mem->nthreads);
+  if (step_mem->coefficients)
+  {
+    fprintf(fp, "  Splitting coefficients:\n");
+    SplittingStepCoefficients_Write(step_mem->coefficients, fp);
+  }
+  else { fprintf(fp, "  Method order %i\n", step_mem->order); }
+  fprintf(fp, "\n");
+
+  return (ARK_SUCCESS);
+}
+
+/*===============================================================
+  EOF
+  ===============================================================*/
@@ -30,6 +30,7 @@
 
 #include "cvode_impl.h"
 #include "sundials/priv/sundials_errors_impl.h"
+#include "sundials_utils.h"
 
 /*=================================================================*/
 /* CVODE Private Constants                                         */
@@ -109,6 +110,12 @@
  *
  *   CORTES       constant in nonlinear iteration convergence test
  *
+ * cvCompleteStep
+ *
+ *   SLDET_NSMIN  minimum nscon for which the STALD norms can still be
+ *                used by cvSLdet (nscon >= q+5 with q >= 3 within the
+ *                next four steps)
+ *
  */
 
 #define FUZZ_FACTOR SUN_RCONST(100.0)
@@ -120,6 +127,23 @@
 
 #define CORTES SUN_RCONST(0.1)
 
+#define SLDET_NSMIN 4
+
+/*
+ * State stream constants
+ * ----------------------
+ *
+ * CVodeWriteState and CVodeReadState
+ *
+ *    STATE_ID      identifier at the start of a CVODE state stream
+ *    STATE_VERSION layout version of the state stream
+ *    STATE_NHDR    number of int entries in the stream header
+ */
+
+#define STATE_ID      0x43564F44
+#define STATE_VERSION 1
+#define STATE_NHDR    8
+
 /*=================================================================*/
 /* Private Helper Functions Prototypes                             */
 /*=================================================================*/
@@ -130,6 +154,16 @@ static sunbooleantype cvCheckNvector(N_Vector tmpl);
 
 static int cvInitialSetup(CVodeMem cv_mem);
 
+/* State serialization */
+
+static void cvStateHeader(CVodeMem cv_mem, int hdr[]);
+static sunbooleantype cvStateIO(FILE* fp, void* data, size_t size, size_t n,
+                                sunbooleantype save);
+static sunbooleantype cvStateVectors(FILE* fp, N_Vector* v, int n,
+                                     sunbooleantype save);
+static sunbooleantype cvStateTransfer(CVodeMem cv_mem, FILE* fp,
+                                      sunbooleantype save);
+
 /* Memory allocation/deallocation */
 
 static sunbooleantype cvAllocVectors(CVodeMem cv_mem, N_Vector tmpl);
@@ -206,6 +240,8 @@ static int cvRcheck1(CVodeMem cv_mem);
 static int cvRcheck2(CVodeMem cv_mem);
 static int cvRcheck3(CVodeMem cv_mem);
 static int cvRootfind(CVodeMem cv_mem);
+static sunbooleantype cvRootScan(CVodeMem cv_mem, sunrealtype* g, int nsub,
+                                 int* nchg, int* imax, sunbooleantype* zroot);
 
 /*
  * =================================================================
@@ -271,6 +307,7 @@ void* CVodeCreate(int lmm, SUNContext sunctx)
 
   /* Set default values for integrator optional inputs */
   cv_mem->cv_f                = NULL;
+  cv_mem->cv_fdir             = NULL;
   cv_mem->cv_user_data        = NULL;
   cv_mem->cv_itol             = CV_NN;
   cv_mem->cv_atolmin0         = SUNTRUE;
@@ -279,6 +316,8 @@ void* CVodeCreate(int lmm, SUNContext sunctx)
   cv_mem->cv_e_data           = NULL;
   cv_mem->cv_monitorfun       = NULL;
   cv_mem->cv_monitor_interval = 0;
+  cv_mem->cv_outputfn         = NULL;
+  cv_mem->cv_output_data      = NULL;
   cv_mem->cv_qmax             = maxord;
   cv_mem->cv_mxstep           = MXSTEP_DEFAULT;
   cv_mem->cv_mxhnil           = MXHNIL_DEFAULT;
@@ -304,6 +343,7 @@ void* CVodeCreate(int lmm, SUNContext sunctx)
   cv_mem->cv_nlscoef          = CORTES;
   cv_mem->cv_msbp             = MSBP_DEFAULT;
   cv_mem->cv_dgmax_lsetup     = DGMAX_LSETUP_DEFAULT;
+  cv_mem->cv_costmodel        = SUNFALSE;
   cv_mem->convfail            = CV_NO_FAILURES;
   cv_mem->cv_constraints      = NULL;
   cv_mem->cv_constraintsSet   = SUNFALSE;
@@ -319,6 +359,8 @@ void* CVodeCreate(int lmm, SUNContext sunctx)
   cv_mem->cv_nrtfn   = 0;
   cv_mem->cv_gactive = NULL;
   cv_mem->cv_mxgnull = 1;
+  cv_mem->cv_gsub    = NULL;
+  cv_mem->cv_isub    = NULL;
 
   /* Initialize projection variables */
   cv_mem->proj_mem     = NULL;
@@ -508,6 +550,11 @@ int CVodeInit(void* cvode_mem, CVRhsFn f, sunrealtype t0, N_Vector y0)
   cv_mem->cv_nscon   = 0;
   cv_mem->cv_nge     = 0;
 
+  cv_mem->cv_tjac     = ZERO;
+  cv_mem->cv_tjaclast = ZERO;
+  cv_mem->cv_tlsetup  = ZERO;
+  cv_mem->cv_tnls     = ZERO;
+
   cv_mem->cv_irfnd = 0;
 
   /* Initialize other integrator optional outputs */
@@ -521,7 +568,8 @@ int CVodeInit(void* cvode_mem, CVRhsFn f, sunrealtype t0, N_Vector y0)
      turned on yet. This way, the user can turn it
      on at any time */
 
-  cv_mem->cv_nor = 0;
+  cv_mem->cv_nor        = 0;
+  cv_mem->cv_sldnrm_cur = SUNFALSE;
   for (i = 1; i <= 5; i++)
   {
     for (k = 1; k <= 3; k++) { cv_mem->cv_ssdat[i - 1][k - 1] = ZERO; }
@@ -618,6 +666,11 @@ int CVodeReInit(void* cvode_mem, sunrealtype t0, N_Vector y0)
   cv_mem->cv_nscon   = 0;
   cv_mem->cv_nge     = 0;
 
+  cv_mem->cv_tjac     = ZERO;
+  cv_mem->cv_tjaclast = ZERO;
+  cv_mem->cv_tlsetup  = ZERO;
+  cv_mem->cv_tnls     = ZERO;
+
   cv_mem->cv_irfnd = 0;
 
   /* Initialize other integrator optional outputs */
@@ -628,7 +681,8 @@ int CVodeReInit(void* cvode_mem, sunrealtype t0, N_Vector y0)
 
   /* Initialize Stablilty Limit Detection data */
 
-  cv_mem->cv_nor = 0;
+  cv_mem->cv_nor        = 0;
+  cv_mem->cv_sldnrm_cur = SUNFALSE;
   for (i = 1; i <= 5; i++)
   {
     for (k = 1; k <= 3; k++) { cv_mem->cv_ssdat[i - 1][k - 1] = ZERO; }
@@ -642,6 +696,186 @@ int CVodeReInit(void* cvode_mem, sunrealtype t0, N_Vector y0)
 
 /*-----------------------------------------------------------------*/
 
+/*
+ * CVodeWriteState
+ *
+ * CVodeWriteState writes everything CVODE needs to continue the
+ * integration from the current internal time to the binary stream fp:
+ * the step data, counters, Nordsieck history array, and rootfinding
+ * data. Optional inputs, tolerances, and solver objects are not
+ * written; they are set up by the user before calling CVodeReadState.
+ * The vectors are written with the N_Vector buffer operations, so the
+ * stream holds the local (per-process) part of the state.
+ */
+
+int CVodeWriteState(void* cvode_mem, FILE* fp)
+{
+  CVodeMem cv_mem;
+  int hdr[STATE_NHDR];
+  sunindextype bufsize;
+  sunbooleantype ok;
+
+  /* Check cvode_mem */
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem)cvode_mem;
+
+  if (cv_mem->cv_MallocDone == SUNFALSE)
+  {
+    cvProcessError(cv_mem, CV_NO_MALLOC, __LINE__, __func__, __FILE__,
+                   MSGCV_NO_MALLOC);
+    return (CV_NO_MALLOC);
+  }
+
+  if (fp == NULL)
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_NULL_FP);
+    return (CV_ILL_INPUT);
+  }
+
+  /* The vectors are serialized with the buffer operations */
+
+  if (N_VBufSize(cv_mem->cv_zn[0], &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    cvProcessError(cv_mem, CV_VECTOROP_ERR, __LINE__, __func__, __FILE__,
+                   MSGCV_BAD_NVECTOR);
+    return (CV_VECTOROP_ERR);
+  }
+
+  /* Write the header followed by the state */
+
+  cvStateHeader(cv_mem, hdr);
+
+  ok = cvStateIO(fp, hdr, sizeof(int), STATE_NHDR, SUNTRUE) &&
+       cvStateTransfer(cv_mem, fp, SUNTRUE);
+
+  if (!ok)
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_STATE_WRITE);
+    return (CV_ILL_INPUT);
+  }
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * CVodeReadState
+ *
+ * CVodeReadState restores a state written by CVodeWriteState. The
+ * CVODE memory must have been created with the same method, maximum
+ * order, number of root functions, and vector layout, and must have
+ * its tolerances and solvers attached. The next call to CVode then
+ * continues from the saved internal time with the saved step size,
+ * order, and history. Since the linear solver memory (e.g., a saved
+ * Jacobian) is not part of the state, a linear solver setup with a
+ * fresh Jacobian is done at the next step. If reading fails, the
+ * CVODE memory must be re-initialized before it is used again.
+ */
+
+int CVodeReadState(void* cvode_mem, FILE* fp)
+{
+  CVodeMem cv_mem;
+  int hdr[STATE_NHDR], hdr_in[STATE_NHDR];
+  int i, ier;
+  sunindextype bufsize;
+  sunbooleantype ok;
+
+  /* Check cvode_mem */
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem)cvode_mem;
+
+  SUNDIALS_MARK_FUNCTION_BEGIN(CV_PROFILER);
+
+  if (cv_mem->cv_MallocDone == SUNFALSE)
+  {
+    cvProcessError(cv_mem, CV_NO_MALLOC, __LINE__, __func__, __FILE__,
+                   MSGCV_NO_MALLOC);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_NO_MALLOC);
+  }
+
+  if (fp == NULL)
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_NULL_FP);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_ILL_INPUT);
+  }
+
+  if (N_VBufSize(cv_mem->cv_zn[0], &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    cvProcessError(cv_mem, CV_VECTOROP_ERR, __LINE__, __func__, __FILE__,
+                   MSGCV_BAD_NVECTOR);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_VECTOROP_ERR);
+  }
+
+  /* Check that the stream matches this integrator */
+
+  if (!cvStateIO(fp, hdr_in, sizeof(int), STATE_NHDR, SUNFALSE))
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_STATE_READ);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_ILL_INPUT);
+  }
+
+  cvStateHeader(cv_mem, hdr);
+
+  ok = SUNTRUE;
+  for (i = 0; i < STATE_NHDR; i++) { ok = ok && (hdr_in[i] == hdr[i]); }
+
+  if (!ok)
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_STATE_BAD);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_ILL_INPUT);
+  }
+
+  /* Read the state */
+
+  ok = cvStateTransfer(cv_mem, fp, SUNFALSE);
+
+  if (!ok)
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_STATE_READ);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_ILL_INPUT);
+  }
+
+  /* Redo the setup normally done on the first call to CVode and force
+     a linear solver setup (and Jacobian evaluation) at the next step */
+
+  if (cv_mem->cv_nst > 0)
+  {
+    ier = cvInitialSetup(cv_mem);
+    if (ier != CV_SUCCESS)
+    {
+      SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+      return (ier);
+    }
+    cv_mem->cv_nstlp = cv_mem->cv_nst - cv_mem->cv_msbp;
+  }
+
+  SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+  return (CV_SUCCESS);
+}
+
+/*-----------------------------------------------------------------*/
+
 /*
  * CVodeSStolerances
  * CVodeSVtolerances
@@ -826,6 +1060,9 @@ int CVodeRootInit(void* cvode_mem, int nrtfn, CVRootFn g)
 
   nrt = (nrtfn < 0) ? 0 : nrtfn;
 
+  /* A subset function belongs to the previous root function */
+  cv_mem->cv_gsub = NULL;
+
   /* If rerunning CVodeRootInit() with a different number of root
      functions (changing number of gfun components), then free
      currently held memory resources */
@@ -843,9 +1080,11 @@ int CVodeRootInit(void* cvode_mem, int nrtfn, CVRootFn g)
     cv_mem->cv_rootdir = NULL;
     free(cv_mem->cv_gactive);
     cv_mem->cv_gactive = NULL;
+    free(cv_mem->cv_isub);
+    cv_mem->cv_isub = NULL;
 
     cv_mem->cv_lrw -= 3 * (cv_mem->cv_nrtfn);
-    cv_mem->cv_liw -= 3 * (cv_mem->cv_nrtfn);
+    cv_mem->cv_liw -= 4 * (cv_mem->cv_nrtfn);
   }
 
   /* If CVodeRootInit() was called with nrtfn == 0, then set cv_nrtfn to
@@ -880,9 +1119,11 @@ int CVodeRootInit(void* cvode_mem, int nrtfn, CVRootFn g)
         cv_mem->cv_rootdir = NULL;
         free(cv_mem->cv_gactive);
         cv_mem->cv_gactive = NULL;
+        free(cv_mem->cv_isub);
+        cv_mem->cv_isub = NULL;
 
         cv_mem->cv_lrw -= 3 * nrt;
-        cv_mem->cv_liw -= 3 * nrt;
+        cv_mem->cv_liw -= 4 * nrt;
 
         cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
                        MSGCV_NULL_G);
@@ -992,6 +1233,27 @@ int CVodeRootInit(void* cvode_mem, int nrtfn, CVRootFn g)
     return (CV_MEM_FAIL);
   }
 
+  cv_mem->cv_isub = NULL;
+  cv_mem->cv_isub = (int*)malloc(nrt * sizeof(int));
+  if (cv_mem->cv_isub == NULL)
+  {
+    free(cv_mem->cv_glo);
+    cv_mem->cv_glo = NULL;
+    free(cv_mem->cv_ghi);
+    cv_mem->cv_ghi = NULL;
+    free(cv_mem->cv_grout);
+    cv_mem->cv_grout = NULL;
+    free(cv_mem->cv_iroots);
+    cv_mem->cv_iroots = NULL;
+    free(cv_mem->cv_rootdir);
+    cv_mem->cv_rootdir = NULL;
+    free(cv_mem->cv_gactive);
+    cv_mem->cv_gactive = NULL;
+    cvProcessError(cv_mem, CV_MEM_FAIL, __LINE__, __func__, __FILE__,
+                   MSGCV_MEM_FAIL);
+    return (CV_MEM_FAIL);
+  }
+
   /* Set default values for rootdir (both directions) */
   for (i = 0; i < nrt; i++) { cv_mem->cv_rootdir[i] = 0; }
 
@@ -999,7 +1261,7 @@ int CVodeRootInit(void* cvode_mem, int nrtfn, CVRootFn g)
   for (i = 0; i < nrt; i++) { cv_mem->cv_gactive[i] = SUNTRUE; }
 
   cv_mem->cv_lrw += 3 * nrt;
-  cv_mem->cv_liw += 3 * nrt;
+  cv_mem->cv_liw += 4 * nrt;
 
   return (CV_SUCCESS);
 }
@@ -1489,6 +1751,22 @@ int CVode(void* cvode_mem, sunrealtype tout, N_Vector yout, sunrealtype* tret,
       }
     }
 
+    /* Pass the new solution to the output function. */
+    if (cv_mem->cv_outputfn != NULL)
+    {
+      retval = cv_mem->cv_outputfn(cv_mem->cv_tn, cv_mem->cv_zn[0],
+                                   cv_mem->cv_output_data);
+      if (retval != 0)
+      {
+        cvProcessError(cv_mem, CV_OUTPUTFUNC_FAIL, __LINE__, __func__,
+                       __FILE__, MSGCV_OUTPUTFUNC_FAILED, cv_mem->cv_tn);
+        istate              = CV_OUTPUTFUNC_FAIL;
+        cv_mem->cv_tretlast = *tret = cv_mem->cv_tn;
+        N_VScale(ONE, cv_mem->cv_zn[0], yout);
+        break;
+      }
+    }
+
     /* Check for root in last step taken. */
     if (cv_mem->cv_nrtfn > 0)
     {
@@ -1696,6 +1974,122 @@ int CVodeGetDky(void* cvode_mem, sunrealtype t, int k, N_Vector dky)
   return (CV_SUCCESS);
 }
 
+/*
+ * CVodeGetDkyBatch
+ *
+ * This routine computes the k-th derivative of the interpolating
+ * polynomial at the nt times t[m] and stores the results in the
+ * vectors dky[m], with the same formula as CVodeGetDky. All times are
+ * checked before any output is computed. The factors c(j,k) * h^(-k)
+ * are computed once for the batch and folded into the weights, so
+ * each output takes a single fused linear combination of zn.
+ */
+
+int CVodeGetDkyBatch(void* cvode_mem, int nt, const sunrealtype* t, int k,
+                     N_Vector* dky)
+{
+  sunrealtype s, r, sp;
+  sunrealtype tfuzz, tp, tn1;
+  sunrealtype ck[L_MAX];
+  int i, j, m, nvec, ier;
+  CVodeMem cv_mem;
+
+  /* Check all inputs for legality */
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem)cvode_mem;
+
+  SUNDIALS_MARK_FUNCTION_BEGIN(CV_PROFILER);
+
+  if (nt < 0 || (nt > 0 && t == NULL))
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   "nt < 0 or t = NULL illegal.");
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_ILL_INPUT);
+  }
+
+  if (nt > 0 && dky == NULL)
+  {
+    cvProcessError(cv_mem, CV_BAD_DKY, __LINE__, __func__, __FILE__,
+                   MSGCV_NULL_DKY);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_BAD_DKY);
+  }
+
+  if ((k < 0) || (k > cv_mem->cv_q))
+  {
+    cvProcessError(cv_mem, CV_BAD_K, __LINE__, __func__, __FILE__, MSGCV_BAD_K);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_BAD_K);
+  }
+
+  /* Allow for some slack */
+  tfuzz = FUZZ_FACTOR * cv_mem->cv_uround *
+          (SUNRabs(cv_mem->cv_tn) + SUNRabs(cv_mem->cv_hu));
+  if (cv_mem->cv_hu < ZERO) { tfuzz = -tfuzz; }
+  tp  = cv_mem->cv_tn - cv_mem->cv_hu - tfuzz;
+  tn1 = cv_mem->cv_tn + tfuzz;
+  for (m = 0; m < nt; m++)
+  {
+    if (dky[m] == NULL)
+    {
+      cvProcessError(cv_mem, CV_BAD_DKY, __LINE__, __func__, __FILE__,
+                     MSGCV_NULL_DKY);
+      SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+      return (CV_BAD_DKY);
+    }
+    if ((t[m] - tp) * (t[m] - tn1) > ZERO)
+    {
+      cvProcessError(cv_mem, CV_BAD_T, __LINE__, __func__, __FILE__,
+                     MSGCV_BAD_T, t[m], cv_mem->cv_tn - cv_mem->cv_hu,
+                     cv_mem->cv_tn);
+      SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+      return (CV_BAD_T);
+    }
+  }
+
+  /* Compute c(j,k) * h^(-k) for j = k,...,q once for all times */
+  r = SUNRpowerI(cv_mem->cv_h, -k);
+  for (j = k; j <= cv_mem->cv_q; j++)
+  {
+    ck[j] = ONE;
+    for (i = j; i >= j - k + 1; i--) { ck[j] *= i; }
+    ck[j] *= r;
+  }
+
+  /* Sum the differentiated interpolating polynomial at each time */
+  nvec = cv_mem->cv_q - k + 1;
+  for (j = cv_mem->cv_q; j >= k; j--)
+  {
+    cv_mem->cv_Xvecs[cv_mem->cv_q - j] = cv_mem->cv_zn[j];
+  }
+
+  for (m = 0; m < nt; m++)
+  {
+    s  = (t[m] - cv_mem->cv_tn) / cv_mem->cv_h;
+    sp = ONE;
+    for (j = k; j <= cv_mem->cv_q; j++)
+    {
+      cv_mem->cv_cvals[cv_mem->cv_q - j] = ck[j] * sp;
+      sp *= s;
+    }
+    ier = N_VLinearCombination(nvec, cv_mem->cv_cvals, cv_mem->cv_Xvecs, dky[m]);
+    if (ier != CV_SUCCESS)
+    {
+      SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+      return (CV_VECTOROP_ERR);
+    }
+  }
+
+  SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+  return (CV_SUCCESS);
+}
+
 /*
  * CVodeComputeState
  *
@@ -1765,6 +2159,8 @@ void CVodeFree(void** cvode_mem)
     cv_mem->cv_rootdir = NULL;
     free(cv_mem->cv_gactive);
     cv_mem->cv_gactive = NULL;
+    free(cv_mem->cv_isub);
+    cv_mem->cv_isub = NULL;
   }
 
   if (cv_mem->proj_mem) { cvProjFree(&(cv_mem->proj_mem)); }
@@ -2068,6 +2464,192 @@ static int cvInitialSetup(CVodeMem cv_mem)
   return (CV_SUCCESS);
 }
 
+/*
+ * -----------------------------------------------------------------
+ * State serialization
+ * -----------------------------------------------------------------
+ */
+
+/*
+ * cvStateHeader
+ *
+ * This routine fills the header of a state stream. A stream can only
+ * be read by an integrator producing the same header.
+ */
+
+static void cvStateHeader(CVodeMem cv_mem, int hdr[])
+{
+  hdr[0] = STATE_ID;
+  hdr[1] = STATE_VERSION;
+  hdr[2] = (int)sizeof(sunrealtype);
+  hdr[3] = (int)sizeof(long int);
+  hdr[4] = (int)sizeof(sunindextype);
+  hdr[5] = cv_mem->cv_lmm;
+  hdr[6] = cv_mem->cv_qmax;
+  hdr[7] = cv_mem->cv_nrtfn;
+}
+
+/*
+ * cvStateIO
+ *
+ * This routine writes (save = SUNTRUE) or reads (save = SUNFALSE) n
+ * items of the given size and returns SUNFALSE on a short transfer.
+ */
+
+static sunbooleantype cvStateIO(FILE* fp, void* data, size_t size, size_t n,
+                                sunbooleantype save)
+{
+  if (n == 0) { return (SUNTRUE); }
+  if (save) { return (fwrite(data, size, n, fp) == n); }
+  return (fread(data, size, n, fp) == n);
+}
+
+/*
+ * cvStateVectors
+ *
+ * This routine writes or reads the n vectors v with the N_Vector
+ * buffer operations. The buffer size is written first and checked on
+ * reading, so a stream from a different vector layout is rejected.
+ */
+
+static sunbooleantype cvStateVectors(FILE* fp, N_Vector* v, int n,
+                                     sunbooleantype save)
+{
+  sunindextype bufsize, bufsize_in;
+  void* buf;
+  int j;
+  sunbooleantype ok;
+
+  if (N_VBufSize(v[0], &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    return (SUNFALSE);
+  }
+
+  bufsize_in = bufsize;
+  if (!cvStateIO(fp, &bufsize_in, sizeof(sunindextype), 1, save) ||
+      (bufsize_in != bufsize))
+  {
+    return (SUNFALSE);
+  }
+
+  buf = malloc(bufsize);
+  if (buf == NULL) { return (SUNFALSE); }
+
+  ok = SUNTRUE;
+  for (j = 0; ok && j < n; j++)
+  {
+    if (save) { ok = (N_VBufPack(v[j], buf) == SUN_SUCCESS); }
+    ok = ok && cvStateIO(fp, buf, 1, (size_t)bufsize, save);
+    if (!save) { ok = ok && (N_VBufUnpack(v[j], buf) == SUN_SUCCESS); }
+  }
+
+  free(buf);
+
+  return (ok);
+}
+
+/*
+ * cvStateTransfer
+ *
+ * This routine writes or reads the integrator state in a fixed order,
+ * so the same code defines the stream layout in both directions.
+ */
+
+#define STATE_IO(x, n)                                      \
+  if (!cvStateIO(fp, (x), sizeof(*(x)), (size_t)(n), save)) \
+  {                                                         \
+    return (SUNFALSE);                                      \
+  }
+
+static sunbooleantype cvStateTransfer(CVodeMem cv_mem, FILE* fp,
+                                      sunbooleantype save)
+{
+  int j;
+  N_Vector vecs[L_MAX + 1];
+
+  /* Step data */
+
+  STATE_IO(&cv_mem->cv_tn, 1);
+  STATE_IO(&cv_mem->cv_tretlast, 1);
+  STATE_IO(&cv_mem->cv_h, 1);
+  STATE_IO(&cv_mem->cv_hprime, 1);
+  STATE_IO(&cv_mem->cv_next_h, 1);
+  STATE_IO(&cv_mem->cv_eta, 1);
+  STATE_IO(&cv_mem->cv_hscale, 1);
+  STATE_IO(&cv_mem->cv_etamax, 1);
+  STATE_IO(&cv_mem->cv_etaqm1, 1);
+  STATE_IO(&cv_mem->cv_etaq, 1);
+  STATE_IO(&cv_mem->cv_etaqp1, 1);
+  STATE_IO(cv_mem->cv_tau, L_MAX + 1);
+  STATE_IO(cv_mem->cv_tq, NUM_TESTS + 1);
+  STATE_IO(cv_mem->cv_l, L_MAX);
+  STATE_IO(&cv_mem->cv_rl1, 1);
+  STATE_IO(&cv_mem->cv_gamma, 1);
+  STATE_IO(&cv_mem->cv_gammap, 1);
+  STATE_IO(&cv_mem->cv_gamrat, 1);
+  STATE_IO(&cv_mem->cv_crate, 1);
+  STATE_IO(&cv_mem->cv_delp, 1);
+  STATE_IO(&cv_mem->cv_acnrm, 1);
+  STATE_IO(&cv_mem->cv_acnrmcur, 1);
+  STATE_IO(&cv_mem->cv_q, 1);
+  STATE_IO(&cv_mem->cv_qprime, 1);
+  STATE_IO(&cv_mem->cv_next_q, 1);
+  STATE_IO(&cv_mem->cv_qwait, 1);
+  STATE_IO(&cv_mem->cv_L, 1);
+
+  /* Saved values */
+
+  STATE_IO(&cv_mem->cv_qu, 1);
+  STATE_IO(&cv_mem->cv_h0u, 1);
+  STATE_IO(&cv_mem->cv_hu, 1);
+  STATE_IO(&cv_mem->cv_saved_tq5, 1);
+  STATE_IO(&cv_mem->cv_tolsf, 1);
+  STATE_IO(&cv_mem->cv_indx_acor, 1);
+
+  /* Counters */
+
+  STATE_IO(&cv_mem->cv_nst, 1);
+  STATE_IO(&cv_mem->cv_nfe, 1);
+  STATE_IO(&cv_mem->cv_ncfn, 1);
+  STATE_IO(&cv_mem->cv_nni, 1);
+  STATE_IO(&cv_mem->cv_nnf, 1);
+  STATE_IO(&cv_mem->cv_netf, 1);
+  STATE_IO(&cv_mem->cv_nsetups, 1);
+  STATE_IO(&cv_mem->cv_nhnil, 1);
+  STATE_IO(&cv_mem->cv_nstlp, 1);
+
+  /* Stability limit detection data */
+
+  STATE_IO(&cv_mem->cv_ssdat[0][0], 6 * 4);
+  STATE_IO(&cv_mem->cv_nscon, 1);
+  STATE_IO(&cv_mem->cv_nor, 1);
+
+  /* Rootfinding data */
+
+  if (cv_mem->cv_nrtfn > 0)
+  {
+    STATE_IO(&cv_mem->cv_tlo, 1);
+    STATE_IO(&cv_mem->cv_thi, 1);
+    STATE_IO(&cv_mem->cv_trout, 1);
+    STATE_IO(&cv_mem->cv_irfnd, 1);
+    STATE_IO(&cv_mem->cv_nge, 1);
+    STATE_IO(cv_mem->cv_glo, cv_mem->cv_nrtfn);
+    STATE_IO(cv_mem->cv_ghi, cv_mem->cv_nrtfn);
+    STATE_IO(cv_mem->cv_grout, cv_mem->cv_nrtfn);
+    STATE_IO(cv_mem->cv_iroots, cv_mem->cv_nrtfn);
+    STATE_IO(cv_mem->cv_gactive, cv_mem->cv_nrtfn);
+  }
+
+  /* Nordsieck array and the last correction */
+
+  for (j = 0; j <= cv_mem->cv_qmax; j++) { vecs[j] = cv_mem->cv_zn[j]; }
+  vecs[cv_mem->cv_qmax + 1] = cv_mem->cv_acor;
+
+  return (cvStateVectors(fp, vecs, cv_mem->cv_qmax + 2, save));
+}
+
+#undef STATE_IO
+
 /*
  * -----------------------------------------------------------------
  * Initial stepsize calculation
@@ -2675,15 +3257,15 @@ void cvRescale(CVodeMem cv_mem)
  *
  * This routine advances tn by the tentative step size h, and computes
  * the predicted array z_n(0), which is overwritten on zn.  The
- * prediction of zn is done by repeated additions.
+ * prediction of zn is done by repeated additions (the Pascal triangle),
+ * fused into a single sweep over zn by vectors providing the
+ * N_VPascalShiftVectorArray operation.
  * If tstop is enabled, it is possible for tn + h to be past tstop by roundoff,
  * and in that case, we reset tn (after incrementing by h) to tstop.
  */
 
 static void cvPredict(CVodeMem cv_mem)
 {
-  int j, k;
-
   cv_mem->cv_tn += cv_mem->cv_h;
   if (cv_mem->cv_tstopset)
   {
@@ -2693,14 +3275,7 @@ static void cvPredict(CVodeMem cv_mem)
     }
   }
 
-  for (k = 1; k <= cv_mem->cv_q; k++)
-  {
-    for (j = cv_mem->cv_q; j >= k; j--)
-    {
-      N_VLinearSum(ONE, cv_mem->cv_zn[j - 1], ONE, cv_mem->cv_zn[j],
-                   cv_mem->cv_zn[j - 1]);
-    }
-  }
+  (void)N_VPascalShiftVectorArray(cv_mem->cv_q + 1, cv_mem->cv_zn);
 
 #ifdef SUNDIALS_LOGGING_EXTRA_DEBUG
   SUNLogger_QueueMsg(CV_LOGGER, SUN_LOGLEVEL_DEBUG, "CVODE::cvPredict",
@@ -3008,8 +3583,10 @@ static int cvNls(CVodeMem cv_mem, int nflag)
 {
   int flag = CV_SUCCESS;
   sunbooleantype callSetup;
-  long int nni_inc = 0;
-  long int nnf_inc = 0;
+  long int nni_inc    = 0;
+  long int nnf_inc    = 0;
+  double tstart       = 0.0;
+  sunrealtype tlsetup = ZERO;
 
   /* Decide whether or not to call setup routine (if one exists) and */
   /* set flag convfail (input to lsetup for its evaluation decision) */
@@ -3041,10 +3618,23 @@ static int cvNls(CVodeMem cv_mem, int nflag)
     if (flag > 0) { return (SUN_NLS_CONV_RECVR); }
   }
 
-  /* solve the nonlinear system */
+  /* solve the nonlinear system (timing it for the Jacobian cost model) */
+  if (cv_mem->cv_costmodel)
+  {
+    tstart  = sunWallClockTime();
+    tlsetup = cv_mem->cv_tjac + cv_mem->cv_tlsetup;
+  }
+
   flag = SUNNonlinSolSolve(cv_mem->NLS, cv_mem->cv_zn[0], cv_mem->cv_acor,
                            cv_mem->cv_ewt, cv_mem->cv_tq[4], callSetup, cv_mem);
 
+  if (cv_mem->cv_costmodel)
+  {
+    /* exclude the time spent in lsetup, which is timed separately */
+    tlsetup = cv_mem->cv_tjac + cv_mem->cv_tlsetup - tlsetup;
+    cv_mem->cv_tnls += (sunrealtype)(sunWallClockTime() - tstart) - tlsetup;
+  }
+
   /* increment counters */
   (void)SUNNonlinSolGetNumIters(cv_mem->NLS, &nni_inc);
   cv_mem->cv_nni += nni_inc;
@@ -3404,6 +3994,7 @@ static int cvDoErrorTest(CVodeMem cv_mem, int* nflagPtr, sunrealtype saved_t,
 static void cvCompleteStep(CVodeMem cv_mem)
 {
   int i;
+  N_Vector wv[2];
 
   cv_mem->cv_nst++;
   cv_mem->cv_nscon++;
@@ -3432,6 +4023,20 @@ static void cvCompleteStep(CVodeMem cv_mem)
                            cv_mem->cv_zn, cv_mem->cv_zn);
   }
 
+  /* With STALD on, compute the norms of zn[q-1] and zn[q] in one fused
+     reduction while the updated columns are at hand. They are shared by
+     cvComputeEtaqm1 and cvBDFStab, and skipped when cvSLdet cannot use
+     them before they are shifted out of ssdat. */
+  cv_mem->cv_sldnrm_cur = SUNFALSE;
+  if (cv_mem->cv_sldeton && (cv_mem->cv_q >= 3) &&
+      (cv_mem->cv_nscon >= SLDET_NSMIN))
+  {
+    wv[0] = wv[1] = cv_mem->cv_ewt;
+    (void)N_VWrmsNormVectorArray(2, cv_mem->cv_zn + cv_mem->cv_q - 1, wv,
+                                 cv_mem->cv_sldnrm);
+    cv_mem->cv_sldnrm_cur = SUNTRUE;
+  }
+
   cv_mem->cv_qwait--;
   if ((cv_mem->cv_qwait == 1) && (cv_mem->cv_q != cv_mem->cv_qmax))
   {
@@ -3561,8 +4166,11 @@ static sunrealtype cvComputeEtaqm1(CVodeMem cv_mem)
   cv_mem->cv_etaqm1 = ZERO;
   if (cv_mem->cv_q > 1)
   {
-    ddn = N_VWrmsNorm(cv_mem->cv_zn[cv_mem->cv_q], cv_mem->cv_ewt) *
-          cv_mem->cv_tq[1];
+    /* reuse the norm of zn[q] computed for STALD (if available) */
+    ddn = cv_mem->cv_sldnrm_cur
+            ? cv_mem->cv_sldnrm[1]
+            : N_VWrmsNorm(cv_mem->cv_zn[cv_mem->cv_q], cv_mem->cv_ewt);
+    ddn *= cv_mem->cv_tq[1];
     cv_mem->cv_etaqm1 = ONE /
                         (SUNRpowerR(BIAS1 * ddn, ONE / cv_mem->cv_q) + ADDON);
   }
@@ -3763,7 +4371,10 @@ static int cvHandleFailure(CVodeMem cv_mem, int flag)
  *
  * This routine handles the BDF Stability Limit Detection Algorithm
  * STALD.  It is called if lmm = CV_BDF and the SLDET option is on.
- * If the order is 3 or more, the required norm data is saved.
+ * If the order is 3 or more, the required norm data is saved. The
+ * norms of zn[q-1] and zn[q] are taken from cvCompleteStep; on
+ * steps where it skipped them, the data cannot reach cvSLdet and
+ * zeros are saved instead.
  * If a decision to reduce order has not already been made, and
  * enough data has been saved, cvSLdet is called.  If it signals
  * a stability limit violation, the order is reduced, and the step
@@ -3791,10 +4402,12 @@ static void cvBDFStab(CVodeMem cv_mem)
     for (i = 1; i <= cv_mem->cv_q - 1; i++) { factorial *= i; }
     sq = factorial * cv_mem->cv_q * (cv_mem->cv_q + 1) * cv_mem->cv_acnrm /
          SUNMAX(cv_mem->cv_tq[5], TINY);
-    sqm1 = factorial * cv_mem->cv_q *
-           N_VWrmsNorm(cv_mem->cv_zn[cv_mem->cv_q], cv_mem->cv_ewt);
-    sqm2 = factorial *
-           N_VWrmsNorm(cv_mem->cv_zn[cv_mem->cv_q - 1], cv_mem->cv_ewt);
+    sqm1 = sqm2 = ZERO;
+    if (cv_mem->cv_sldnrm_cur)
+    {
+      sqm1 = factorial * cv_mem->cv_q * cv_mem->cv_sldnrm[1];
+      sqm2 = factorial * cv_mem->cv_sldnrm[0];
+    }
     cv_mem->cv_ssdat[1][1] = sqm2 * sqm2;
     cv_mem->cv_ssdat[1][2] = sqm1 * sqm1;
     cv_mem->cv_ssdat[1][3] = sq * sq;
@@ -4416,6 +5029,16 @@ static int cvRcheck3(CVodeMem cv_mem)
  * gfun     = user-defined function for g(t).  Its form is
  *            (void) gfun(t, y, gt, user_data)
  *
+ * gsub     = optional user-defined function for a subset of the
+ *            components of g(t).  Its form is
+ *            (void) gsub(t, y, nsub, isub, gt, user_data)
+ *            If given, only the components with a root in the
+ *            current interval are evaluated while the root is
+ *            located, and gfun is called once more at trout.
+ *
+ * isub     = int array of length nrtfn listing the components of
+ *            g monitored in the search.  Work array.
+ *
  * rootdir  = in array specifying the direction of zero-crossings.
  *            If rootdir[i] > 0, search for roots of g_i only if
  *            g_i is increasing; if rootdir[i] < 0, search for
@@ -4473,43 +5096,24 @@ static int cvRcheck3(CVodeMem cv_mem)
 
 static int cvRootfind(CVodeMem cv_mem)
 {
-  sunrealtype alph, tmid, gfrac, maxfrac, fracint, fracsub;
-  int i, retval, imax, side, sideprev;
-  sunbooleantype zroot, sgnchg;
+  sunrealtype alph, tmid, fracint, fracsub;
+  int i, k, retval, imax, side, sideprev, nsub, nchg;
+  sunbooleantype zroot, sgnchg, subset, partial;
 
-  imax = 0;
+  imax    = 0;
+  subset  = (cv_mem->cv_gsub != NULL);
+  partial = SUNFALSE;
 
-  /* First check for change in sign in ghi or for a zero in ghi. */
-  maxfrac = ZERO;
-  zroot   = SUNFALSE;
-  sgnchg  = SUNFALSE;
+  /* Monitor all active components of g. */
+  nsub = 0;
   for (i = 0; i < cv_mem->cv_nrtfn; i++)
   {
-    if (!cv_mem->cv_gactive[i]) { continue; }
-    if (SUNRabs(cv_mem->cv_ghi[i]) == ZERO)
-    {
-      if (cv_mem->cv_rootdir[i] * cv_mem->cv_glo[i] <= ZERO)
-      {
-        zroot = SUNTRUE;
-      }
-    }
-    else
-    {
-      if ((DIFFERENT_SIGN(cv_mem->cv_glo[i], cv_mem->cv_ghi[i])) &&
-          (cv_mem->cv_rootdir[i] * cv_mem->cv_glo[i] <= ZERO))
-      {
-        gfrac =
-          SUNRabs(cv_mem->cv_ghi[i] / (cv_mem->cv_ghi[i] - cv_mem->cv_glo[i]));
-        if (gfrac > maxfrac)
-        {
-          sgnchg  = SUNTRUE;
-          maxfrac = gfrac;
-          imax    = i;
-        }
-      }
-    }
+    if (cv_mem->cv_gactive[i]) { cv_mem->cv_isub[nsub++] = i; }
   }
 
+  /* First check for change in sign in ghi or for a zero in ghi. */
+  sgnchg = cvRootScan(cv_mem, cv_mem->cv_ghi, nsub, &nchg, &imax, &zroot);
+
   /* If no sign change was found, reset trout and grout.  Then return
      CV_SUCCESS if no zero was found, or set iroots and return RTFOUND.  */
   if (!sgnchg)
@@ -4533,6 +5137,10 @@ static int cvRootfind(CVodeMem cv_mem)
     return (RTFOUND);
   }
 
+  /* With a subset function, only the components with a root in (tlo,thi)
+     are evaluated from here on. */
+  if (subset) { nsub = nchg; }
+
   /* Initialize alph to avoid compiler warning */
   alph = ONE;
 
@@ -4579,51 +5187,44 @@ static int cvRootfind(CVodeMem cv_mem)
     }
 
     (void)CVodeGetDky(cv_mem, tmid, 0, cv_mem->cv_y);
-    retval = cv_mem->cv_gfun(tmid, cv_mem->cv_y, cv_mem->cv_grout,
-                             cv_mem->cv_user_data);
+    if (subset)
+    {
+      retval  = cv_mem->cv_gsub(tmid, cv_mem->cv_y, nsub, cv_mem->cv_isub,
+                                cv_mem->cv_grout, cv_mem->cv_user_data);
+      partial = SUNTRUE;
+    }
+    else
+    {
+      retval = cv_mem->cv_gfun(tmid, cv_mem->cv_y, cv_mem->cv_grout,
+                               cv_mem->cv_user_data);
+    }
     cv_mem->cv_nge++;
     if (retval != 0) { return (CV_RTFUNC_FAIL); }
 
     /* Check to see in which subinterval g changes sign, and reset imax.
        Set side = 1 if sign change is on low side, or 2 if on high side.  */
-    maxfrac  = ZERO;
-    zroot    = SUNFALSE;
-    sgnchg   = SUNFALSE;
     sideprev = side;
-    for (i = 0; i < cv_mem->cv_nrtfn; i++)
+    sgnchg = cvRootScan(cv_mem, cv_mem->cv_grout, nsub, &nchg, &imax, &zroot);
+    if (sgnchg)
     {
-      if (!cv_mem->cv_gactive[i]) { continue; }
-      if (SUNRabs(cv_mem->cv_grout[i]) == ZERO)
+      /* Sign change found in (tlo,tmid); replace thi with tmid. */
+      cv_mem->cv_thi = tmid;
+      if (subset)
       {
-        if (cv_mem->cv_rootdir[i] * cv_mem->cv_glo[i] <= ZERO)
+        nsub = nchg;
+        for (k = 0; k < nsub; k++)
         {
-          zroot = SUNTRUE;
+          i                 = cv_mem->cv_isub[k];
+          cv_mem->cv_ghi[i] = cv_mem->cv_grout[i];
         }
       }
       else
       {
-        if ((DIFFERENT_SIGN(cv_mem->cv_glo[i], cv_mem->cv_grout[i])) &&
-            (cv_mem->cv_rootdir[i] * cv_mem->cv_glo[i] <= ZERO))
+        for (i = 0; i < cv_mem->cv_nrtfn; i++)
         {
-          gfrac = SUNRabs(cv_mem->cv_grout[i] /
-                          (cv_mem->cv_grout[i] - cv_mem->cv_glo[i]));
-          if (gfrac > maxfrac)
-          {
-            sgnchg  = SUNTRUE;
-            maxfrac = gfrac;
-            imax    = i;
-          }
+          cv_mem->cv_ghi[i] = cv_mem->cv_grout[i];
         }
       }
-    }
-    if (sgnchg)
-    {
-      /* Sign change found in (tlo,tmid); replace thi with tmid. */
-      cv_mem->cv_thi = tmid;
-      for (i = 0; i < cv_mem->cv_nrtfn; i++)
-      {
-        cv_mem->cv_ghi[i] = cv_mem->cv_grout[i];
-      }
       side = 1;
       /* Stop at root thi if converged; otherwise loop. */
       if (SUNRabs(cv_mem->cv_thi - cv_mem->cv_tlo) <= cv_mem->cv_ttol)
@@ -4637,6 +5238,7 @@ static int cvRootfind(CVodeMem cv_mem)
     {
       /* No sign change in (tlo,tmid), but g = 0 at tmid; return root tmid. */
       cv_mem->cv_thi = tmid;
+      if (subset) { nsub = nchg; }
       for (i = 0; i < cv_mem->cv_nrtfn; i++)
       {
         cv_mem->cv_ghi[i] = cv_mem->cv_grout[i];
@@ -4647,9 +5249,20 @@ static int cvRootfind(CVodeMem cv_mem)
     /* No sign change in (tlo,tmid), and no zero at tmid.
        Sign change must be in (tmid,thi).  Replace tlo with tmid. */
     cv_mem->cv_tlo = tmid;
-    for (i = 0; i < cv_mem->cv_nrtfn; i++)
+    if (subset)
     {
-      cv_mem->cv_glo[i] = cv_mem->cv_grout[i];
+      for (k = 0; k < nsub; k++)
+      {
+        i                 = cv_mem->cv_isub[k];
+        cv_mem->cv_glo[i] = cv_mem->cv_grout[i];
+      }
+    }
+    else
+    {
+      for (i = 0; i < cv_mem->cv_nrtfn; i++)
+      {
+        cv_mem->cv_glo[i] = cv_mem->cv_grout[i];
+      }
     }
     side = 2;
     /* Stop at root thi if converged; otherwise loop back. */
@@ -4657,13 +5270,27 @@ static int cvRootfind(CVodeMem cv_mem)
 
   } /* End of root-search loop */
 
+  /* If only a subset of g was evaluated at thi, evaluate all of g there so
+     that grout is complete for the next search. */
+  if (partial)
+  {
+    (void)CVodeGetDky(cv_mem, cv_mem->cv_thi, 0, cv_mem->cv_y);
+    retval = cv_mem->cv_gfun(cv_mem->cv_thi, cv_mem->cv_y, cv_mem->cv_ghi,
+                             cv_mem->cv_user_data);
+    cv_mem->cv_nge++;
+    if (retval != 0) { return (CV_RTFUNC_FAIL); }
+  }
+
   /* Reset trout and grout, set iroots, and return RTFOUND. */
   cv_mem->cv_trout = cv_mem->cv_thi;
   for (i = 0; i < cv_mem->cv_nrtfn; i++)
   {
     cv_mem->cv_grout[i]  = cv_mem->cv_ghi[i];
     cv_mem->cv_iroots[i] = 0;
-    if (!cv_mem->cv_gactive[i]) { continue; }
+  }
+  for (k = 0; k < nsub; k++)
+  {
+    i = cv_mem->cv_isub[k];
     if ((SUNRabs(cv_mem->cv_ghi[i]) == ZERO) &&
         (cv_mem->cv_rootdir[i] * cv_mem->cv_glo[i] <= ZERO))
     {
@@ -4678,6 +5305,61 @@ static int cvRootfind(CVodeMem cv_mem)
   return (RTFOUND);
 }
 
+/*
+ * cvRootScan
+ *
+ * This routine checks the nsub components of g listed in isub for a
+ * zero in g or a change in sign between glo and g. It sets zroot if
+ * a zero was found and returns SUNTRUE if a sign change was found, in
+ * which case imax is the component whose secant root is nearest to
+ * tlo. When a subset function is used, the components with a zero or
+ * sign change are moved to the front of isub and their number is
+ * returned in nchg; the remaining components keep their place in
+ * isub behind them.
+ */
+
+static sunbooleantype cvRootScan(CVodeMem cv_mem, sunrealtype* g, int nsub,
+                                 int* nchg, int* imax, sunbooleantype* zroot)
+{
+  sunrealtype gfrac, maxfrac;
+  int i, k;
+  sunbooleantype sgnchg, root;
+
+  maxfrac = ZERO;
+  sgnchg  = SUNFALSE;
+  *zroot  = SUNFALSE;
+  *nchg   = 0;
+  for (k = 0; k < nsub; k++)
+  {
+    i    = cv_mem->cv_isub[k];
+    root = SUNFALSE;
+    if (cv_mem->cv_rootdir[i] * cv_mem->cv_glo[i] > ZERO) { continue; }
+    if (SUNRabs(g[i]) == ZERO)
+    {
+      *zroot = SUNTRUE;
+      root   = SUNTRUE;
+    }
+    else if (DIFFERENT_SIGN(cv_mem->cv_glo[i], g[i]))
+    {
+      root  = SUNTRUE;
+      gfrac = SUNRabs(g[i] / (g[i] - cv_mem->cv_glo[i]));
+      if (gfrac > maxfrac)
+      {
+        sgnchg  = SUNTRUE;
+        maxfrac = gfrac;
+        *imax   = i;
+      }
+    }
+    if (root && cv_mem->cv_gsub != NULL)
+    {
+      cv_mem->cv_isub[k]        = cv_mem->cv_isub[*nchg];
+      cv_mem->cv_isub[(*nchg)++] = i;
+    }
+  }
+
+  return (sgnchg);
+}
+
 /*
  * =================================================================
  * Internal EWT function
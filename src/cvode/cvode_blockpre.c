@@ -0,0 +1,756 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This file contains implementations of the block-diagonal
+ * difference quotient Jacobian-based preconditioner and solver
+ * routines for use with the CVLS linear solver interface.
+ *
+ * The state is a ManyVector, and the preconditioner keeps one
+ * diagonal block I - gamma*J_kk per subvector k, where J_kk is a
+ * dense or banded difference quotient approximation of the
+ * Jacobian of f_k with respect to y_k. The blocks are factored
+ * independently (with OpenMP threads when available) and applied
+ * either in a block Jacobi sweep or in a block Gauss-Seidel sweep,
+ * where the coupling to the previous blocks is approximated with
+ * one difference quotient Jacobian-vector product per block.
+ * -----------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sundials/sundials_math.h>
+
+#include "cvode_blockpre_impl.h"
+#include "cvode_impl.h"
+#include "cvode_ls_impl.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define MIN_INC_MULT SUN_RCONST(1000.0)
+#define ZERO         SUN_RCONST(0.0)
+#define ONE          SUN_RCONST(1.0)
+#define TWO          SUN_RCONST(2.0)
+
+/* Prototypes of CVBlockPrecSetup and CVBlockPrecSolve */
+static int CVBlockPrecSetup(sunrealtype t, N_Vector y, N_Vector fy,
+                            sunbooleantype jok, sunbooleantype* jcurPtr,
+                            sunrealtype gamma, void* blp_data);
+static int CVBlockPrecSolve(sunrealtype t, N_Vector y, N_Vector fy, N_Vector r,
+                            N_Vector z, sunrealtype gamma, sunrealtype delta,
+                            int lr, void* blp_data);
+
+/* Prototypes for CVBlockPrecFree and CVBlockPrecFreeData */
+static int CVBlockPrecFree(CVodeMem cv_mem);
+static void CVBlockPrecFreeData(CVBlockPrecData pdata);
+
+/* Prototype for difference quotient Jacobian calculation routine */
+static int CVBlockPDQJac(CVBlockPrecData pdata, sunindextype k, sunrealtype t,
+                         N_Vector y, N_Vector fy, N_Vector ftemp,
+                         N_Vector ytemp);
+
+/*-----------------------------------------------------------------
+  Initialization, Free, and Get Functions
+  NOTE: The dense and band linear solvers used for the blocks
+        assume serial/OpenMP/Pthreads subvectors. Therefore,
+        CVBlockPrecInit will first test that the state is a
+        ManyVector whose subvectors implement N_VGetArrayPointer.
+  -----------------------------------------------------------------*/
+int CVBlockPrecInit(void* cvode_mem, int sweep, sunindextype* mu,
+                    sunindextype* ml)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  CVBlockPrecData pdata;
+  N_Vector vk;
+  sunindextype k, Nk, storagemu;
+  int flag;
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CVLS_MEM_NULL, __LINE__, __func__, __FILE__,
+                   MSGBLP_MEM_NULL);
+    return (CVLS_MEM_NULL);
+  }
+  cv_mem = (CVodeMem)cvode_mem;
+
+  /* Test if the CVLS linear solver interface has been attached */
+  if (cv_mem->cv_lmem == NULL)
+  {
+    cvProcessError(cv_mem, CVLS_LMEM_NULL, __LINE__, __func__, __FILE__,
+                   MSGBLP_LMEM_NULL);
+    return (CVLS_LMEM_NULL);
+  }
+  cvls_mem = (CVLsMem)cv_mem->cv_lmem;
+
+  /* Test the sweep type */
+  if (sweep != CV_BLOCKPRE_JACOBI && sweep != CV_BLOCKPRE_GAUSS_SEIDEL)
+  {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGBLP_BAD_SWEEP);
+    return (CVLS_ILL_INPUT);
+  }
+
+  /* Test compatibility of NVECTOR package with the BLOCK preconditioner */
+  if (N_VGetVectorID(cv_mem->cv_tempv) != SUNDIALS_NVEC_MANYVECTOR)
+  {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGBLP_BAD_NVECTOR);
+    return (CVLS_ILL_INPUT);
+  }
+  for (k = 0; k < BLP_NSUBVECS(cv_mem->cv_tempv); k++)
+  {
+    if (BLP_SUBVEC(cv_mem->cv_tempv, k)->ops->nvgetarraypointer == NULL)
+    {
+      cvProcessError(cv_mem, CVLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                     MSGBLP_BAD_NVECTOR);
+      return (CVLS_ILL_INPUT);
+    }
+  }
+
+  /* Allocate data memory */
+  pdata = NULL;
+  pdata = (CVBlockPrecData)malloc(sizeof *pdata);
+  if (pdata == NULL)
+  {
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                   MSGBLP_MEM_FAIL);
+    return (CVLS_MEM_FAIL);
+  }
+
+  /* Load pointers and sweep type into pdata block */
+  pdata->cvode_mem = cvode_mem;
+  pdata->nblocks   = BLP_NSUBVECS(cv_mem->cv_tempv);
+  pdata->sweep     = sweep;
+  pdata->nthreads  = 1;
+  pdata->nfeBLP    = 0;
+
+  /* Allocate the per-block arrays (zeroed so that a partial
+     allocation can be freed) and the temporary N_Vectors */
+  pdata->N      = (sunindextype*)calloc(pdata->nblocks, sizeof(sunindextype));
+  pdata->mu     = (sunindextype*)calloc(pdata->nblocks, sizeof(sunindextype));
+  pdata->ml     = (sunindextype*)calloc(pdata->nblocks, sizeof(sunindextype));
+  pdata->banded = (sunbooleantype*)calloc(pdata->nblocks,
+                                          sizeof(sunbooleantype));
+  pdata->savedJ = (SUNMatrix*)calloc(pdata->nblocks, sizeof(SUNMatrix));
+  pdata->savedP = (SUNMatrix*)calloc(pdata->nblocks, sizeof(SUNMatrix));
+  pdata->LS = (SUNLinearSolver*)calloc(pdata->nblocks, sizeof(SUNLinearSolver));
+  pdata->tmp1 = N_VClone(cv_mem->cv_tempv);
+  pdata->tmp2 = N_VClone(cv_mem->cv_tempv);
+  pdata->tmp3 = N_VClone(cv_mem->cv_tempv);
+  if (pdata->N == NULL || pdata->mu == NULL || pdata->ml == NULL ||
+      pdata->banded == NULL || pdata->savedJ == NULL ||
+      pdata->savedP == NULL || pdata->LS == NULL || pdata->tmp1 == NULL ||
+      pdata->tmp2 == NULL || pdata->tmp3 == NULL)
+  {
+    CVBlockPrecFreeData(pdata);
+    cvProcessError(cv_mem, CVLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                   MSGBLP_MEM_FAIL);
+    return (CVLS_MEM_FAIL);
+  }
+
+  /* Set up each block: a band matrix when half-bandwidths are given
+     for it, otherwise a dense matrix */
+  for (k = 0; k < pdata->nblocks; k++)
+  {
+    vk = BLP_SUBVEC(cv_mem->cv_tempv, k);
+    Nk = N_VGetLength(vk);
+
+    pdata->N[k]      = Nk;
+    pdata->banded[k] = (mu != NULL && ml != NULL && mu[k] >= 0 && ml[k] >= 0);
+    if (pdata->banded[k])
+    {
+      pdata->mu[k] = SUNMIN(Nk - 1, mu[k]);
+      pdata->ml[k] = SUNMIN(Nk - 1, ml[k]);
+      storagemu    = SUNMIN(Nk - 1, pdata->mu[k] + pdata->ml[k]);
+      pdata->savedJ[k] = SUNBandMatrixStorage(Nk, pdata->mu[k], pdata->ml[k],
+                                              pdata->mu[k], cv_mem->cv_sunctx);
+      pdata->savedP[k] = SUNBandMatrixStorage(Nk, pdata->mu[k], pdata->ml[k],
+                                              storagemu, cv_mem->cv_sunctx);
+      if (pdata->savedP[k] != NULL)
+      {
+        pdata->LS[k] = SUNLinSol_Band(vk, pdata->savedP[k], cv_mem->cv_sunctx);
+      }
+    }
+    else
+    {
+      pdata->mu[k]     = Nk - 1;
+      pdata->ml[k]     = Nk - 1;
+      pdata->savedJ[k] = SUNDenseMatrix(Nk, Nk, cv_mem->cv_sunctx);
+      pdata->savedP[k] = SUNDenseMatrix(Nk, Nk, cv_mem->cv_sunctx);
+      if (pdata->savedP[k] != NULL)
+      {
+        pdata->LS[k] = SUNLinSol_Dense(vk, pdata->savedP[k], cv_mem->cv_sunctx);
+      }
+    }
+    if (pdata->savedJ[k] == NULL || pdata->savedP[k] == NULL ||
+        pdata->LS[k] == NULL)
+    {
+      CVBlockPrecFreeData(pdata);
+      cvProcessError(cv_mem, CVLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                     MSGBLP_MEM_FAIL);
+      return (CVLS_MEM_FAIL);
+    }
+
+    /* initialize block linear solver object */
+    flag = SUNLinSolInitialize(pdata->LS[k]);
+    if (flag != SUN_SUCCESS)
+    {
+      CVBlockPrecFreeData(pdata);
+      cvProcessError(cv_mem, CVLS_SUNLS_FAIL, __LINE__, __func__, __FILE__,
+                     MSGBLP_SUNLS_FAIL);
+      return (CVLS_SUNLS_FAIL);
+    }
+  }
+
+  /* make sure P_data is free from any previous allocations */
+  if (cvls_mem->pfree) { cvls_mem->pfree(cv_mem); }
+
+  /* Point to the new P_data field in the LS memory */
+  cvls_mem->P_data = pdata;
+
+  /* Attach the pfree function */
+  cvls_mem->pfree = CVBlockPrecFree;
+
+  /* Attach preconditioner solve and setup functions */
+  flag = CVodeSetPreconditioner(cvode_mem, CVBlockPrecSetup, CVBlockPrecSolve);
+  return (flag);
+}
+
+/* Accesses the CVBlockPrecData attached to the CVLS interface */
+static int cvBlockPrec_AccessPData(void* cvode_mem, const char* fname,
+                                   CVodeMem* cv_mem, CVBlockPrecData* pdata)
+{
+  CVLsMem cvls_mem;
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CVLS_MEM_NULL, __LINE__, fname, __FILE__,
+                   MSGBLP_MEM_NULL);
+    return (CVLS_MEM_NULL);
+  }
+  *cv_mem = (CVodeMem)cvode_mem;
+
+  if ((*cv_mem)->cv_lmem == NULL)
+  {
+    cvProcessError(*cv_mem, CVLS_LMEM_NULL, __LINE__, fname, __FILE__,
+                   MSGBLP_LMEM_NULL);
+    return (CVLS_LMEM_NULL);
+  }
+  cvls_mem = (CVLsMem)(*cv_mem)->cv_lmem;
+
+  if (cvls_mem->P_data == NULL || cvls_mem->pfree != CVBlockPrecFree)
+  {
+    cvProcessError(*cv_mem, CVLS_PMEM_NULL, __LINE__, fname, __FILE__,
+                   MSGBLP_PMEM_NULL);
+    return (CVLS_PMEM_NULL);
+  }
+  *pdata = (CVBlockPrecData)cvls_mem->P_data;
+
+  return (CVLS_SUCCESS);
+}
+
+int CVBlockPrecSetNumThreads(void* cvode_mem, int nthreads)
+{
+  CVodeMem cv_mem;
+  CVBlockPrecData pdata;
+  int flag;
+
+  flag = cvBlockPrec_AccessPData(cvode_mem, __func__, &cv_mem, &pdata);
+  if (flag != CVLS_SUCCESS) { return (flag); }
+
+  pdata->nthreads = (nthreads > 0) ? nthreads : 1;
+
+  return (CVLS_SUCCESS);
+}
+
+int CVBlockPrecGetWorkSpace(void* cvode_mem, long int* lenrwBLP,
+                            long int* leniwBLP)
+{
+  CVodeMem cv_mem;
+  CVBlockPrecData pdata;
+  sunindextype lrw1, liw1, k;
+  long int lrw, liw;
+  int flag;
+
+  flag = cvBlockPrec_AccessPData(cvode_mem, __func__, &cv_mem, &pdata);
+  if (flag != CVLS_SUCCESS) { return (flag); }
+
+  /* sum space requirements for all objects in pdata */
+  *leniwBLP = 4 + 4 * pdata->nblocks;
+  *lenrwBLP = 0;
+  if (cv_mem->cv_tempv->ops->nvspace)
+  {
+    N_VSpace(cv_mem->cv_tempv, &lrw1, &liw1);
+    *leniwBLP += 3 * liw1;
+    *lenrwBLP += 3 * lrw1;
+  }
+  for (k = 0; k < pdata->nblocks; k++)
+  {
+    if (pdata->savedJ[k]->ops->space)
+    {
+      flag = SUNMatSpace(pdata->savedJ[k], &lrw, &liw);
+      if (flag != 0) { return (-1); }
+      *leniwBLP += liw;
+      *lenrwBLP += lrw;
+    }
+    if (pdata->savedP[k]->ops->space)
+    {
+      flag = SUNMatSpace(pdata->savedP[k], &lrw, &liw);
+      if (flag != 0) { return (-1); }
+      *leniwBLP += liw;
+      *lenrwBLP += lrw;
+    }
+    if (pdata->LS[k]->ops->space)
+    {
+      flag = SUNLinSolSpace(pdata->LS[k], &lrw, &liw);
+      if (flag != 0) { return (-1); }
+      *leniwBLP += liw;
+      *lenrwBLP += lrw;
+    }
+  }
+
+  return (CVLS_SUCCESS);
+}
+
+int CVBlockPrecGetNumRhsEvals(void* cvode_mem, long int* nfevalsBLP)
+{
+  CVodeMem cv_mem;
+  CVBlockPrecData pdata;
+  int flag;
+
+  flag = cvBlockPrec_AccessPData(cvode_mem, __func__, &cv_mem, &pdata);
+  if (flag != CVLS_SUCCESS) { return (flag); }
+
+  *nfevalsBLP = pdata->nfeBLP;
+
+  return (CVLS_SUCCESS);
+}
+
+/*-----------------------------------------------------------------
+  CVBlockPrecSetup
+  -----------------------------------------------------------------
+  Together CVBlockPrecSetup and CVBlockPrecSolve use a block
+  diagonal difference quotient Jacobian to create a
+  preconditioner. CVBlockPrecSetup calculates new diagonal blocks
+  J_kk, if necessary, then calculates P_k = I - gamma*J_kk, and
+  does an LU factorization of each P_k.
+
+  The parameters of CVBlockPrecSetup are as follows:
+
+  t       is the current value of the independent variable.
+
+  y       is the current value of the dependent variable vector,
+          namely the predicted value of y(t).
+
+  fy      is the vector f(t,y).
+
+  jok     is an input flag indicating whether Jacobian-related
+          data needs to be recomputed, as follows:
+            jok == SUNFALSE means recompute Jacobian-related data
+                   from scratch.
+            jok == SUNTRUE means that Jacobian data from the
+                   previous PrecSetup call will be reused
+                   (with the current value of gamma).
+          A CVBlockPrecSetup call with jok == SUNTRUE should only
+          occur after a call with jok == SUNFALSE.
+
+  *jcurPtr is a pointer to an output integer flag which is
+           set by CVBlockPrecSetup as follows:
+             *jcurPtr = SUNTRUE if Jacobian data was recomputed.
+             *jcurPtr = SUNFALSE if Jacobian data was not recomputed,
+                        but saved data was reused.
+
+  gamma   is the scalar appearing in the Newton matrix.
+
+  blp_data is a pointer to preconditoner data (set by CVBlockPrecInit)
+
+  The difference quotients call f and are formed one block after
+  the other. The blocks are then copied, shifted, and factored
+  independently, using pdata->nthreads OpenMP threads.
+
+  The value to be returned by the CVBlockPrecSetup function is
+    0  if successful, or
+    1  if a block factorization failed.
+  -----------------------------------------------------------------*/
+static int CVBlockPrecSetup(sunrealtype t, N_Vector y, N_Vector fy,
+                            sunbooleantype jok, sunbooleantype* jcurPtr,
+                            sunrealtype gamma, void* blp_data)
+{
+  CVBlockPrecData pdata;
+  CVodeMem cv_mem;
+  sunindextype k;
+  int retval, matfail;
+
+  pdata  = (CVBlockPrecData)blp_data;
+  cv_mem = (CVodeMem)pdata->cvode_mem;
+
+  if (jok)
+  {
+    /* If jok = SUNTRUE, use saved copies of the J_kk. */
+    *jcurPtr = SUNFALSE;
+  }
+  else
+  {
+    /* If jok = SUNFALSE, call CVBlockPDQJac for new J_kk values. */
+    *jcurPtr = SUNTRUE;
+    for (k = 0; k < pdata->nblocks; k++)
+    {
+      retval = SUNMatZero(pdata->savedJ[k]);
+      if (retval < 0)
+      {
+        cvProcessError(cv_mem, -1, __LINE__, __func__, __FILE__,
+                       MSGBLP_SUNMAT_FAIL);
+        return (-1);
+      }
+      if (retval > 0) { return (1); }
+
+      retval = CVBlockPDQJac(pdata, k, t, y, fy, pdata->tmp1, pdata->tmp2);
+      if (retval < 0)
+      {
+        cvProcessError(cv_mem, -1, __LINE__, __func__, __FILE__,
+                       MSGBLP_RHSFUNC_FAILED);
+        return (-1);
+      }
+      if (retval > 0) { return (1); }
+    }
+  }
+
+  /* Form savedP_k = I - gamma*J_kk and do the LU factorizations. The
+     first matrix failure and the largest factorization flag are kept. */
+  matfail = 0;
+  retval  = 0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pdata->nthreads) schedule(dynamic) \
+  if (pdata->nthreads > 1)
+#endif
+  for (k = 0; k < pdata->nblocks; k++)
+  {
+    int ier;
+
+    ier = SUNMatCopy(pdata->savedJ[k], pdata->savedP[k]);
+    if (ier == 0) { ier = SUNMatScaleAddI(-gamma, pdata->savedP[k]); }
+    if (ier != 0)
+    {
+#ifdef _OPENMP
+#pragma omp critical(CVBlockPrecSetup)
+#endif
+      {
+        if (matfail == 0) { matfail = ier; }
+      }
+      continue;
+    }
+
+    ier = SUNLinSolSetup(pdata->LS[k], pdata->savedP[k]);
+    if (ier != 0)
+    {
+#ifdef _OPENMP
+#pragma omp critical(CVBlockPrecSetup)
+#endif
+      {
+        if (ier > retval) { retval = ier; }
+      }
+    }
+  }
+
+  if (matfail < 0)
+  {
+    cvProcessError(cv_mem, -1, __LINE__, __func__, __FILE__, MSGBLP_SUNMAT_FAIL);
+    return (-1);
+  }
+  if (matfail > 0 || retval > 0) { return (1); }
+
+  return (0);
+}
+
+/*-----------------------------------------------------------------
+  CVBlockPrecSolve
+  -----------------------------------------------------------------
+  CVBlockPrecSolve solves a linear system P z = r, where P is the
+  block preconditioner computed by CVBlockPrecSetup.
+
+  With the block Jacobi sweep, P is block diagonal and the blocks
+  z_k = P_k^{-1} r_k are solved independently.
+
+  With the block Gauss-Seidel sweep, P is block lower triangular,
+  with the off-diagonal blocks -gamma*J_kj (j < k) of I - gamma*J,
+  and the blocks are solved in order,
+
+    z_k = P_k^{-1} (r_k + gamma * sum_{j<k} J_kj z_j),
+
+  where the sum is the k-th block of a difference quotient
+  approximation of J v, with v = (z_0, ..., z_{k-1}, 0, ..., 0).
+  This costs one call to f for each block after the first.
+
+  The parameters of CVBlockPrecSolve used here are as follows:
+
+  y, fy are the current state and right-hand side vectors.
+
+  r is the right-hand side vector of the linear system.
+
+  gamma is the scalar appearing in the Newton matrix.
+
+  blp_data is a pointer to preconditoner data (set by CVBlockPrecInit)
+
+  z is the output vector computed by CVBlockPrecSolve.
+
+  The value returned by CVBlockPrecSolve is 0 if successful, or the
+  flag of the failed right-hand side call or block solve.
+  -----------------------------------------------------------------*/
+static int CVBlockPrecSolve(sunrealtype t, N_Vector y, N_Vector fy, N_Vector r,
+                            N_Vector z, sunrealtype gamma,
+                            SUNDIALS_MAYBE_UNUSED sunrealtype delta,
+                            SUNDIALS_MAYBE_UNUSED int lr, void* blp_data)
+{
+  CVBlockPrecData pdata;
+  CVodeMem cv_mem;
+  N_Vector v, ytemp, ftemp;
+  sunrealtype vnorm, sig;
+  sunindextype k;
+  int retval;
+
+  pdata  = (CVBlockPrecData)blp_data;
+  cv_mem = (CVodeMem)pdata->cvode_mem;
+
+  if (pdata->sweep == CV_BLOCKPRE_JACOBI)
+  {
+    retval = 0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(pdata->nthreads) schedule(dynamic) \
+  if (pdata->nthreads > 1)
+#endif
+    for (k = 0; k < pdata->nblocks; k++)
+    {
+      int ier;
+
+      ier = SUNLinSolSolve(pdata->LS[k], pdata->savedP[k], BLP_SUBVEC(z, k),
+                           BLP_SUBVEC(r, k), ZERO);
+      if (ier != 0)
+      {
+#ifdef _OPENMP
+#pragma omp critical(CVBlockPrecSolve)
+#endif
+        {
+          if (retval == 0) { retval = ier; }
+        }
+      }
+    }
+    return (retval);
+  }
+
+  /* Block Gauss-Seidel sweep: v holds the blocks of z solved so far */
+  v     = pdata->tmp1;
+  ytemp = pdata->tmp2;
+  ftemp = pdata->tmp3;
+  N_VConst(ZERO, v);
+
+  for (k = 0; k < pdata->nblocks; k++)
+  {
+    vnorm = (k > 0) ? N_VWrmsNorm(v, cv_mem->cv_ewt) : ZERO;
+    if (vnorm > ZERO)
+    {
+      /* ftemp_k = (f(y + sig*v) - fy)_k ~ sig * sum_{j<k} J_kj z_j */
+      sig = ONE / vnorm;
+      N_VLinearSum(sig, v, ONE, y, ytemp);
+      retval = cv_mem->cv_f(t, ytemp, ftemp, cv_mem->cv_user_data);
+      pdata->nfeBLP++;
+      if (retval != 0) { return (retval); }
+
+      N_VLinearSum(ONE, BLP_SUBVEC(ftemp, k), -ONE, BLP_SUBVEC(fy, k),
+                   BLP_SUBVEC(ftemp, k));
+      N_VLinearSum(ONE, BLP_SUBVEC(r, k), gamma / sig, BLP_SUBVEC(ftemp, k),
+                   BLP_SUBVEC(z, k));
+    }
+    else { N_VScale(ONE, BLP_SUBVEC(r, k), BLP_SUBVEC(z, k)); }
+
+    retval = SUNLinSolSolve(pdata->LS[k], pdata->savedP[k], BLP_SUBVEC(z, k),
+                            BLP_SUBVEC(z, k), ZERO);
+    if (retval != 0) { return (retval); }
+
+    if (k < pdata->nblocks - 1)
+    {
+      N_VScale(ONE, BLP_SUBVEC(z, k), BLP_SUBVEC(v, k));
+    }
+  }
+
+  return (0);
+}
+
+static int CVBlockPrecFree(CVodeMem cv_mem)
+{
+  CVLsMem cvls_mem;
+
+  if (cv_mem->cv_lmem == NULL) { return (0); }
+  cvls_mem = (CVLsMem)cv_mem->cv_lmem;
+
+  if (cvls_mem->P_data == NULL) { return (0); }
+
+  CVBlockPrecFreeData((CVBlockPrecData)cvls_mem->P_data);
+
+  return (0);
+}
+
+/* Frees a (possibly partially allocated) CVBlockPrecData */
+static void CVBlockPrecFreeData(CVBlockPrecData pdata)
+{
+  sunindextype k;
+
+  for (k = 0; k < pdata->nblocks; k++)
+  {
+    if (pdata->LS && pdata->LS[k]) { SUNLinSolFree(pdata->LS[k]); }
+    if (pdata->savedP && pdata->savedP[k]) { SUNMatDestroy(pdata->savedP[k]); }
+    if (pdata->savedJ && pdata->savedJ[k]) { SUNMatDestroy(pdata->savedJ[k]); }
+  }
+  free(pdata->LS);
+  free(pdata->savedP);
+  free(pdata->savedJ);
+  free(pdata->banded);
+  free(pdata->ml);
+  free(pdata->mu);
+  free(pdata->N);
+  if (pdata->tmp1) { N_VDestroy(pdata->tmp1); }
+  if (pdata->tmp2) { N_VDestroy(pdata->tmp2); }
+  if (pdata->tmp3) { N_VDestroy(pdata->tmp3); }
+
+  free(pdata);
+}
+
+/*-----------------------------------------------------------------
+  CVBlockPDQJac
+  -----------------------------------------------------------------
+  This routine generates a difference quotient approximation to
+  the diagonal block J_kk = df_k/dy_k of the Jacobian of f(t,y).
+  Only the components of block k are perturbed, and columns of
+  J_kk that do not share a row (those mu+ml+1 apart for a banded
+  block) are perturbed together, so a banded block of width w
+  costs min(w, N_k) calls to f and a dense block N_k calls.
+  -----------------------------------------------------------------*/
+static int CVBlockPDQJac(CVBlockPrecData pdata, sunindextype k, sunrealtype t,
+                         N_Vector y, N_Vector fy, N_Vector ftemp, N_Vector ytemp)
+{
+  CVodeMem cv_mem;
+  SUNMatrix J;
+  sunrealtype fnorm, minInc, inc, inc_inv, yj, srur, conj;
+  sunindextype group, i, j, Nk, width, ngroups, i1, i2;
+  sunrealtype *col_j, *ewt_data, *fy_data, *ftemp_data;
+  sunrealtype *y_data, *ytemp_data, *cns_data;
+  int retval;
+
+  /* initialize cns_data to avoid compiler warning */
+  cns_data = NULL;
+
+  cv_mem = (CVodeMem)pdata->cvode_mem;
+  J      = pdata->savedJ[k];
+  Nk     = pdata->N[k];
+
+  /* Obtain pointers to the block k data for various vectors */
+  ewt_data   = N_VGetArrayPointer(BLP_SUBVEC(cv_mem->cv_ewt, k));
+  fy_data    = N_VGetArrayPointer(BLP_SUBVEC(fy, k));
+  ftemp_data = N_VGetArrayPointer(BLP_SUBVEC(ftemp, k));
+  y_data     = N_VGetArrayPointer(BLP_SUBVEC(y, k));
+  ytemp_data = N_VGetArrayPointer(BLP_SUBVEC(ytemp, k));
+  if (cv_mem->cv_constraintsSet)
+  {
+    cns_data = N_VGetArrayPointer(BLP_SUBVEC(cv_mem->cv_constraints, k));
+  }
+
+  /* Load ytemp with y = predicted y vector. */
+  N_VScale(ONE, y, ytemp);
+
+  /* Set minimum increment based on uround and norm of f_k. */
+  srur   = SUNRsqrt(cv_mem->cv_uround);
+  fnorm  = N_VWrmsNorm(BLP_SUBVEC(fy, k), BLP_SUBVEC(cv_mem->cv_ewt, k));
+  minInc = (fnorm != ZERO) ? (MIN_INC_MULT * SUNRabs(cv_mem->cv_h) *
+                              cv_mem->cv_uround * Nk * fnorm)
+                           : ONE;
+
+  /* Set bandwidth and number of column groups for differencing. */
+  width   = pdata->ml[k] + pdata->mu[k] + 1;
+  ngroups = SUNMIN(width, Nk);
+
+  for (group = 1; group <= ngroups; group++)
+  {
+    /* Increment all y_j in group. */
+    for (j = group - 1; j < Nk; j += width)
+    {
+      inc = SUNMAX(srur * SUNRabs(y_data[j]), minInc / ewt_data[j]);
+      yj  = y_data[j];
+
+      /* Adjust sign(inc) again if yj has an inequality constraint. */
+      if (cv_mem->cv_constraintsSet)
+      {
+        conj = cns_data[j];
+        if (SUNRabs(conj) == ONE)
+        {
+          if ((yj + inc) * conj < ZERO) { inc = -inc; }
+        }
+        else if (SUNRabs(conj) == TWO)
+        {
+          if ((yj + inc) * conj <= ZERO) { inc = -inc; }
+        }
+      }
+
+      ytemp_data[j] += inc;
+    }
+
+    /* Evaluate f with incremented y. */
+    retval = cv_mem->cv_f(t, ytemp, ftemp, cv_mem->cv_user_data);
+    pdata->nfeBLP++;
+    if (retval != 0) { return (retval); }
+
+    /* Restore ytemp, then form and load difference quotients. */
+    for (j = group - 1; j < Nk; j += width)
+    {
+      yj            = y_data[j];
+      ytemp_data[j] = y_data[j];
+      inc           = SUNMAX(srur * SUNRabs(y_data[j]), minInc / ewt_data[j]);
+
+      /* Adjust sign(inc) as before. */
+      if (cv_mem->cv_constraintsSet)
+      {
+        conj = cns_data[j];
+        if (SUNRabs(conj) == ONE)
+        {
+          if ((yj + inc) * conj < ZERO) { inc = -inc; }
+        }
+        else if (SUNRabs(conj) == TWO)
+        {
+          if ((yj + inc) * conj <= ZERO) { inc = -inc; }
+        }
+      }
+
+      inc_inv = ONE / inc;
+      i1      = SUNMAX(0, j - pdata->mu[k]);
+      i2      = SUNMIN(j + pdata->ml[k], Nk - 1);
+      if (pdata->banded[k])
+      {
+        col_j = SUNBandMatrix_Column(J, j);
+        for (i = i1; i <= i2; i++)
+        {
+          SM_COLUMN_ELEMENT_B(col_j, i, j) = inc_inv *
+                                             (ftemp_data[i] - fy_data[i]);
+        }
+      }
+      else
+      {
+        col_j = SUNDenseMatrix_Column(J, j);
+        for (i = i1; i <= i2; i++)
+        {
+          col_j[i] = inc_inv * (ftemp_data[i] - fy_data[i]);
+        }
+      }
+    }
+  }
+
+  return (0);
+}
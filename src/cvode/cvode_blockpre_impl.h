@@ -0,0 +1,96 @@
+/*
+ * -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * Implementation header file for the CVBLOCKPRE module.
+ * -----------------------------------------------------------------
+ */
+
+#ifndef _CVBLOCKPRE_IMPL_H
+#define _CVBLOCKPRE_IMPL_H
+
+#include <cvode/cvode_blockpre.h>
+#include <nvector/nvector_manyvector.h>
+#include <sunlinsol/sunlinsol_band.h>
+#include <sunlinsol/sunlinsol_dense.h>
+#include <sunmatrix/sunmatrix_band.h>
+#include <sunmatrix/sunmatrix_dense.h>
+
+#ifdef __cplusplus /* wrapper to enable C++ usage */
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------------
+  Access to the subvectors of a ManyVector (through its content,
+  so that CVODE does not depend on the NVECTOR_MANYVECTOR library)
+  -----------------------------------------------------------------*/
+
+#define BLP_NSUBVECS(v) \
+  (((N_VectorContent_ManyVector)((v)->content))->num_subvectors)
+#define BLP_SUBVEC(v, i) \
+  (((N_VectorContent_ManyVector)((v)->content))->subvec_array[i])
+
+/*-----------------------------------------------------------------
+  Type: CVBlockPrecData
+  -----------------------------------------------------------------*/
+
+typedef struct CVBlockPrecDataRec
+{
+  /* Data set by user in CVBlockPrecInit */
+  sunindextype nblocks;   /* number of blocks (subvectors)            */
+  int sweep;              /* block Jacobi or block Gauss-Seidel       */
+  sunindextype* N;        /* block sizes                              */
+  sunindextype *mu, *ml;  /* block half-bandwidths                    */
+  sunbooleantype* banded; /* is the block stored as a band matrix?    */
+
+  /* Number of threads used to factor and solve the blocks */
+  int nthreads;
+
+  /* Data set by CVBlockPrecSetup */
+  SUNMatrix* savedJ;
+  SUNMatrix* savedP;
+  SUNLinearSolver* LS;
+  N_Vector tmp1;
+  N_Vector tmp2;
+  N_Vector tmp3;
+
+  /* Rhs calls */
+  long int nfeBLP;
+
+  /* Pointer to cvode_mem */
+  void* cvode_mem;
+
+}* CVBlockPrecData;
+
+/*-----------------------------------------------------------------
+  CVBLOCKPRE error messages
+  -----------------------------------------------------------------*/
+
+#define MSGBLP_MEM_NULL "Integrator memory is NULL."
+#define MSGBLP_LMEM_NULL                                                   \
+  "Linear solver memory is NULL. One of the SPILS linear solvers must be " \
+  "attached."
+#define MSGBLP_MEM_FAIL "A memory request failed."
+#define MSGBLP_BAD_NVECTOR \
+  "The state must be a ManyVector whose subvectors support N_VGetArrayPointer."
+#define MSGBLP_BAD_SWEEP  "Illegal value for sweep."
+#define MSGBLP_SUNMAT_FAIL "An error arose from a SUNMatrix routine."
+#define MSGBLP_SUNLS_FAIL  "An error arose from a SUNLinearSolver routine."
+#define MSGBLP_PMEM_NULL \
+  "Block preconditioner memory is NULL. CVBlockPrecInit must be called."
+#define MSGBLP_RHSFUNC_FAILED \
+  "The right-hand side routine failed in an unrecoverable manner."
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
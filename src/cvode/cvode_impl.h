@@ -209,6 +209,7 @@ typedef struct CVodeMemRec
     --------------------------*/
 
   CVRhsFn cv_f;       /* y' = f(t,y(t))                                */
+  CVRhsDirFn cv_fdir; /* f(t,y) and (df/dy) v together (optional)      */
   void* cv_user_data; /* user pointer passed to f                      */
   int cv_lmm;         /* lmm = CV_ADAMS or CV_BDF                      */
   int cv_itol;        /* itol = CV_SS, CV_SV, CV_WF, CV_NN             */
@@ -390,6 +391,13 @@ typedef struct CVodeMemRec
   sunrealtype cv_dgmax_lsetup; /* gamma ratio threshold to signal for a linear
                               * solver setup */
 
+  /* Jacobian evaluation cost model (see CVodeSetJacEvalCostModel) */
+  sunbooleantype cv_costmodel; /* time the nonlinear solver and lsetup calls */
+  sunrealtype cv_tjac;         /* time in lsetup calls that updated J        */
+  sunrealtype cv_tjaclast;     /* time of the last lsetup that updated J     */
+  sunrealtype cv_tlsetup;      /* time in lsetup calls that reused J         */
+  sunrealtype cv_tnls;         /* time in nonlinear solves excluding lsetup  */
+
   /*------------
     Saved Values
     ------------*/
@@ -417,15 +425,19 @@ typedef struct CVodeMemRec
     -------------------------------------------*/
   CVMonitorFn cv_monitorfun;    /* func called with CVODE mem and user data  */
   long int cv_monitor_interval; /* step interval to call cv_monitorfun       */
+  SUNOutputFn cv_outputfn;      /* func called with tn and y after each step */
+  void* cv_output_data;         /* data pointer passed to cv_outputfn        */
 
   /*-------------------------
     Stability Limit Detection
     -------------------------*/
 
-  sunbooleantype cv_sldeton;  /* is Stability Limit Detection on?             */
-  sunrealtype cv_ssdat[6][4]; /* scaled data array for STALD                  */
-  int cv_nscon;               /* counter for STALD method                     */
-  long int cv_nor;            /* counter for number of order reductions       */
+  sunbooleantype cv_sldeton;    /* is Stability Limit Detection on?           */
+  sunrealtype cv_ssdat[6][4];   /* scaled data array for STALD                */
+  int cv_nscon;                 /* counter for STALD method                   */
+  long int cv_nor;              /* counter for number of order reductions     */
+  sunrealtype cv_sldnrm[2];     /* WRMS norms of zn[q-1] and zn[q] for STALD  */
+  sunbooleantype cv_sldnrm_cur; /* are sldnrm set for the current step?       */
 
   /*----------------
     Rootfinding Data
@@ -448,6 +460,8 @@ typedef struct CVodeMemRec
   long int cv_nge;       /* counter for g evaluations                       */
   sunbooleantype* cv_gactive; /* array with active/inactive event functions      */
   int cv_mxgnull; /* number of warning messages about possible g==0  */
+  CVRootSubsetFn cv_gsub; /* function g for a subset of the components   */
+  int* cv_isub;           /* components of g monitored in the root search */
 
   /*---------------
     Projection Data
@@ -725,6 +739,11 @@ int cvDiagSolve_updateM(const sunrealtype r, N_Vector M);
 #define MSGCV_BAD_T          "Illegal value for t." MSG_TIME_INT
 #define MSGCV_NO_ROOT        "Rootfinding was not initialized."
 #define MSGCV_NLS_INIT_FAIL  "The nonlinear solver's init routine failed."
+#define MSGCV_NULL_FP        "fp = NULL illegal."
+#define MSGCV_STATE_WRITE    "Writing the integrator state failed."
+#define MSGCV_STATE_READ     "Reading the integrator state failed."
+#define MSGCV_STATE_BAD \
+  "The saved state is not compatible with this integrator."
 
 /* CVode Error Messages */
 
@@ -777,6 +796,8 @@ int cvDiagSolve_updateM(const sunrealtype r, N_Vector M);
 #define MSGCV_RTFUNC_FAILED                                              \
   "At " MSG_TIME ", the rootfinding routine failed in an unrecoverable " \
   "manner."
+#define MSGCV_OUTPUTFUNC_FAILED \
+  "At " MSG_TIME ", the output function failed in an unrecoverable manner."
 #define MSGCV_CLOSE_ROOTS "Root found at and very near " MSG_TIME "."
 #define MSGCV_BAD_TSTOP                                      \
   "The value " MSG_TIME_TSTOP " is behind current " MSG_TIME \
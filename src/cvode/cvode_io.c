@@ -81,6 +81,31 @@ int CVodeSetUserData(void* cvode_mem, void* user_data)
   return (CV_SUCCESS);
 }
 
+/*
+ * CVodeSetRhsDirFn
+ *
+ * Specifies the user function that evaluates f together with a
+ * directional derivative (df/dy) v. It replaces the difference
+ * quotient Jacobian-vector products.
+ */
+
+int CVodeSetRhsDirFn(void* cvode_mem, CVRhsDirFn fdir)
+{
+  CVodeMem cv_mem;
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+
+  cv_mem = (CVodeMem)cvode_mem;
+
+  cv_mem->cv_fdir = fdir;
+
+  return (CV_SUCCESS);
+}
+
 /*
  * CVodeSetMonitorFn
  *
@@ -112,6 +137,31 @@ int CVodeSetMonitorFn(void* cvode_mem, CVMonitorFn fn)
 #endif
 }
 
+/*
+ * CVodeSetOutputFn
+ *
+ * Specifies the function to call with the solution after each
+ * successful step, e.g., SUNOutputWriter_OutputFn.
+ */
+
+int CVodeSetOutputFn(void* cvode_mem, SUNOutputFn fn, void* output_data)
+{
+  CVodeMem cv_mem;
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+
+  cv_mem = (CVodeMem)cvode_mem;
+
+  cv_mem->cv_outputfn    = fn;
+  cv_mem->cv_output_data = output_data;
+
+  return (CV_SUCCESS);
+}
+
 /*
  * CVodeSetMonitorFrequency
  *
@@ -922,6 +972,38 @@ int CVodeSetNoInactiveRootWarn(void* cvode_mem)
   return (CV_SUCCESS);
 }
 
+/*
+ * CVodeSetRootSubsetFn
+ *
+ * Specifies a function evaluating only some components of g. It is
+ * used while locating a root, once the components that change sign
+ * are known. A NULL function evaluates all of g (the default).
+ */
+
+int CVodeSetRootSubsetFn(void* cvode_mem, CVRootSubsetFn gsub)
+{
+  CVodeMem cv_mem;
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+
+  cv_mem = (CVodeMem)cvode_mem;
+
+  if (cv_mem->cv_nrtfn == 0)
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_NO_ROOT);
+    return (CV_ILL_INPUT);
+  }
+
+  cv_mem->cv_gsub = gsub;
+
+  return (CV_SUCCESS);
+}
+
 /*
  * CVodeSetConstraints
  *
@@ -1684,6 +1766,20 @@ int CVodePrintAllStats(void* cvode_mem, FILE* outfile, SUNOutputFormat fmt)
         fprintf(outfile, "Prec evals per NLS iter      = %" RSYM "\n",
                 (sunrealtype)cvls_mem->npe / (sunrealtype)cv_mem->cv_nni);
       }
+      if (cv_mem->cv_costmodel)
+      {
+        fprintf(outfile, "Jac setup time               = %" RSYM "\n",
+                cv_mem->cv_tjac);
+        fprintf(outfile, "LS setup time                = %" RSYM "\n",
+                cv_mem->cv_tlsetup);
+        fprintf(outfile, "NLS iteration time           = %" RSYM "\n",
+                cv_mem->cv_tnls);
+      }
+      if (cvls_mem->coltrack)
+      {
+        fprintf(outfile, "LS setups skipped            = %ld\n",
+                cvls_mem->nlsskip);
+      }
     }
 
     /* rootfinding stats */
@@ -1753,6 +1849,16 @@ int CVodePrintAllStats(void* cvode_mem, FILE* outfile, SUNOutputFormat fmt)
         fprintf(outfile, ",Jac evals per NLS iter,0");
         fprintf(outfile, ",Prec evals per NLS iter,0");
       }
+      if (cv_mem->cv_costmodel)
+      {
+        fprintf(outfile, ",Jac setup time,%" RSYM, cv_mem->cv_tjac);
+        fprintf(outfile, ",LS setup time,%" RSYM, cv_mem->cv_tlsetup);
+        fprintf(outfile, ",NLS iteration time,%" RSYM, cv_mem->cv_tnls);
+      }
+      if (cvls_mem->coltrack)
+      {
+        fprintf(outfile, ",LS setups skipped,%ld", cvls_mem->nlsskip);
+      }
     }
 
     /* rootfinding stats */
@@ -1835,6 +1941,7 @@ char* CVodeGetReturnFlagName(long int flag)
   case CV_PROJ_MEM_NULL: sprintf(name, "CV_PROJ_MEM_NULL"); break;
   case CV_PROJFUNC_FAIL: sprintf(name, "CV_PROJFUNC_FAIL"); break;
   case CV_REPTD_PROJFUNC_ERR: sprintf(name, "CV_REPTD_PROJFUNC_ERR"); break;
+  case CV_OUTPUTFUNC_FAIL: sprintf(name, "CV_OUTPUTFUNC_FAIL"); break;
   default: sprintf(name, "NONE");
   }
 
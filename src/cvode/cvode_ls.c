@@ -43,6 +43,15 @@ static int cvLsLinSys(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix A,
                       sunrealtype gamma, void* user_data, N_Vector tmp1,
                       N_Vector tmp2, N_Vector tmp3);
 
+static sunbooleantype cvLsCostModelJbad(CVodeMem cv_mem, CVLsMem cvls_mem);
+
+static sunrealtype cvLsForcingTol(CVLsMem cvls_mem, int curiter,
+                                  sunrealtype bnorm, sunrealtype tolmax);
+
+static int cvLsDenseDQJacColumns(CVodeMem cv_mem, CVLsMem cvls_mem, N_Vector y,
+                                 SUNMatrix Jac, sunbooleantype** coldirty);
+static void cvLsFreeTracker(CVLsMem cvls_mem);
+
 /*===============================================================
   CVLS Exported functions -- Required
   ===============================================================*/
@@ -205,6 +214,27 @@ int CVodeSetLinearSolver(void* cvode_mem, SUNLinearSolver LS, SUNMatrix A)
   cvls_mem->eplifac    = CVLS_EPLIN;
   cvls_mem->last_flag  = CVLS_SUCCESS;
 
+  /* The adaptive forcing term is disabled by default */
+  cvls_mem->forcing = SUNFALSE;
+  cvls_mem->fgamma  = CVLS_FGAMMA;
+  cvls_mem->falpha  = CVLS_FALPHA;
+  cvls_mem->frelax  = CVLS_FRELAX;
+  cvls_mem->feta    = CVLS_FETA0;
+  cvls_mem->fbnorm  = ZERO;
+
+  /* Column tracking is disabled by default */
+  cvls_mem->coltrack    = SUNFALSE;
+  cvls_mem->dytol       = CVLS_DYTOL;
+  cvls_mem->jfull       = SUNTRUE;
+  cvls_mem->nupdated    = -1;
+  cvls_mem->gamma_setup = ZERO;
+  cvls_mem->skipsetup   = SUNFALSE;
+  cvls_mem->ylj         = NULL;
+  cvls_mem->dirty       = NULL;
+  cvls_mem->pattern     = NULL;
+  cvls_mem->ntrack      = 0;
+  cvls_mem->nsfull      = 0;
+
   /* If LS supports ATimes, attach CVLs routine */
   if (LS->ops->setatimes)
   {
@@ -396,6 +426,78 @@ int CVodeSetLSNormFactor(void* cvode_mem, sunrealtype nrmfac)
   return (CVLS_SUCCESS);
 }
 
+/* CVodeSetLSForcing enables or disables the adaptive (Eisenstat-Walker)
+   forcing term for the iterative linear solver tolerance */
+int CVodeSetLSForcing(void* cvode_mem, sunbooleantype adaptive)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  int retval;
+
+  /* access CVLsMem structure */
+  retval = cvLs_AccessLMem(cvode_mem, __func__, &cv_mem, &cvls_mem);
+  if (retval != CVLS_SUCCESS) { return (retval); }
+
+  cvls_mem->forcing = adaptive;
+  cvls_mem->feta    = CVLS_FETA0;
+  cvls_mem->fbnorm  = ZERO;
+
+  return (CVLS_SUCCESS);
+}
+
+/* CVodeSetLSForcingParams sets the parameters gamma and alpha of the adaptive
+   forcing term; non-positive values restore the defaults */
+int CVodeSetLSForcingParams(void* cvode_mem, sunrealtype fgamma,
+                            sunrealtype falpha)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  int retval;
+
+  /* access CVLsMem structure */
+  retval = cvLs_AccessLMem(cvode_mem, __func__, &cv_mem, &cvls_mem);
+  if (retval != CVLS_SUCCESS) { return (retval); }
+
+  /* Check for legal gamma and alpha */
+  if (fgamma > ONE || falpha > TWO || (falpha > ZERO && falpha <= ONE))
+  {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSG_LS_BAD_FORCING);
+    return (CVLS_ILL_INPUT);
+  }
+
+  cvls_mem->fgamma = (fgamma <= ZERO) ? CVLS_FGAMMA : fgamma;
+  cvls_mem->falpha = (falpha <= ZERO) ? CVLS_FALPHA : falpha;
+
+  return (CVLS_SUCCESS);
+}
+
+/* CVodeSetLSForcingMaxRelax sets the maximum factor by which the adaptive
+   forcing term relaxes the fixed linear solver tolerance; a non-positive
+   value restores the default */
+int CVodeSetLSForcingMaxRelax(void* cvode_mem, sunrealtype frelax)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  int retval;
+
+  /* access CVLsMem structure */
+  retval = cvLs_AccessLMem(cvode_mem, __func__, &cv_mem, &cvls_mem);
+  if (retval != CVLS_SUCCESS) { return (retval); }
+
+  /* Check for legal frelax */
+  if (frelax > ZERO && frelax < ONE)
+  {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSG_LS_BAD_FRELAX);
+    return (CVLS_ILL_INPUT);
+  }
+
+  cvls_mem->frelax = (frelax <= ZERO) ? CVLS_FRELAX : frelax;
+
+  return (CVLS_SUCCESS);
+}
+
 /* CVodeSetJacEvalFrequency specifies the frequency for recomputing the Jacobian
    matrix and/or preconditioner */
 int CVodeSetJacEvalFrequency(void* cvode_mem, long int msbj)
@@ -421,6 +523,70 @@ int CVodeSetJacEvalFrequency(void* cvode_mem, long int msbj)
   return (CVLS_SUCCESS);
 }
 
+/* CVodeSetJacEvalCostModel enables or disables deciding when to recompute
+   the Jacobian matrix and/or preconditioner from the measured solver costs
+   instead of the evaluation frequency */
+int CVodeSetJacEvalCostModel(void* cvode_mem, sunbooleantype onoff)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  int retval;
+
+  /* access CVLsMem structure; store input and return */
+  retval = cvLs_AccessLMem(cvode_mem, __func__, &cv_mem, &cvls_mem);
+  if (retval != CVLS_SUCCESS) { return (retval); }
+
+  cv_mem->cv_costmodel = onoff;
+
+  return (CVLS_SUCCESS);
+}
+
+/* CVodeSetJacColumnTracking enables or disables updating the Jacobian matrix
+   in place, recomputing only the columns that changed */
+int CVodeSetJacColumnTracking(void* cvode_mem, sunbooleantype onoff,
+                              sunrealtype dytol)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  int retval;
+
+  /* access CVLsMem structure */
+  retval = cvLs_AccessLMem(cvode_mem, __func__, &cv_mem, &cvls_mem);
+  if (retval != CVLS_SUCCESS) { return (retval); }
+
+  /* Column tracking requires a matrix-based linear solver */
+  if (onoff && (cvls_mem->A == NULL))
+  {
+    cvProcessError(cv_mem, CVLS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   "Column tracking requires a matrix-based linear solver");
+    return (CVLS_ILL_INPUT);
+  }
+
+  /* store inputs and return */
+  cvls_mem->coltrack = onoff;
+  cvls_mem->dytol    = (dytol < ZERO) ? CVLS_DYTOL : dytol;
+  cvls_mem->jfull    = SUNTRUE;
+
+  return (CVLS_SUCCESS);
+}
+
+/* CVodeSetNumJacUpdatedColumns is called from within the Jacobian function to
+   report the number of columns it updated when tracking columns */
+int CVodeSetNumJacUpdatedColumns(void* cvode_mem, sunindextype ncols)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  int retval;
+
+  /* access CVLsMem structure; store input and return */
+  retval = cvLs_AccessLMem(cvode_mem, __func__, &cv_mem, &cvls_mem);
+  if (retval != CVLS_SUCCESS) { return (retval); }
+
+  cvls_mem->nupdated = ncols;
+
+  return (CVLS_SUCCESS);
+}
+
 /* CVodeSetLinearSolutionScaling enables or disables scaling the
    linear solver solution to account for changes in gamma. */
 int CVodeSetLinearSolutionScaling(void* cvode_mem, sunbooleantype onoff)
@@ -837,6 +1003,44 @@ int CVodeGetLinSolveStats(void* cvode_mem, long int* njevals, long int* nfevalsL
   return (CVLS_SUCCESS);
 }
 
+/* CVodeGetLinSolveTimes returns the times (in seconds) spent in linear
+   solver setups that evaluated the Jacobian, in setups that reused it, and
+   in the nonlinear solver otherwise, as measured for the cost model */
+int CVodeGetLinSolveTimes(void* cvode_mem, sunrealtype* tjac,
+                          sunrealtype* tlsetup, sunrealtype* tnls)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  int retval;
+
+  /* access CVLsMem structure; set output values and return */
+  retval = cvLs_AccessLMem(cvode_mem, __func__, &cv_mem, &cvls_mem);
+  if (retval != CVLS_SUCCESS) { return (retval); }
+
+  *tjac    = cv_mem->cv_tjac;
+  *tlsetup = cv_mem->cv_tlsetup;
+  *tnls    = cv_mem->cv_tnls;
+
+  return (CVLS_SUCCESS);
+}
+
+/* CVodeGetNumLinSetupsSkipped returns the number of linear solver setups
+   skipped because neither the Jacobian nor gamma changed */
+int CVodeGetNumLinSetupsSkipped(void* cvode_mem, long int* nlsskip)
+{
+  CVodeMem cv_mem;
+  CVLsMem cvls_mem;
+  int retval;
+
+  /* access CVLsMem structure; set output value and return */
+  retval = cvLs_AccessLMem(cvode_mem, __func__, &cv_mem, &cvls_mem);
+  if (retval != CVLS_SUCCESS) { return (retval); }
+
+  *nlsskip = cvls_mem->nlsskip;
+
+  return (CVLS_SUCCESS);
+}
+
 /* CVodeGetLastLinFlag returns the last flag set in a CVLS function */
 int CVodeGetLastLinFlag(void* cvode_mem, long int* flag)
 {
@@ -1048,14 +1252,17 @@ int cvLsDenseDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
                    CVodeMem cv_mem, N_Vector tmp1)
 {
   sunrealtype fnorm, minInc, inc, inc_inv, yjsaved, srur, conj;
-  sunrealtype *y_data, *ewt_data, *cns_data;
+  sunrealtype *y_data, *ewt_data, *cns_data, *col_data;
+  sunbooleantype *coldirty, *pattern;
   N_Vector ftemp, jthCol;
-  sunindextype j, N;
+  sunindextype i, j, N;
   CVLsMem cvls_mem;
   int retval = 0;
 
-  /* initialize cns_data to avoid compiler warning */
+  /* initialize cns_data to avoid compiler warning; without column tracking
+     all columns are computed (coldirty is NULL) */
   cns_data = NULL;
+  coldirty = NULL;
 
   /* access LsMem interface structure */
   cvls_mem = (CVLsMem)cv_mem->cv_lmem;
@@ -1063,6 +1270,13 @@ int cvLsDenseDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
   /* access matrix dimension */
   N = SUNDenseMatrix_Columns(Jac);
 
+  /* When tracking columns, determine the columns that may have changed */
+  if (cvls_mem->coltrack)
+  {
+    retval = cvLsDenseDQJacColumns(cv_mem, cvls_mem, y, Jac, &coldirty);
+    if (retval != CVLS_SUCCESS) { return (retval); }
+  }
+
   /* Rename work vector for readibility */
   ftemp = tmp1;
 
@@ -1086,6 +1300,9 @@ int cvLsDenseDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
 
   for (j = 0; j < N; j++)
   {
+    /* Skip columns that are unaffected by changes in y */
+    if (coldirty && !coldirty[j]) { continue; }
+
     /* Generate the jth col of J(tn,y) */
     N_VSetArrayPointer(SUNDenseMatrix_Column(Jac, j), jthCol);
 
@@ -1116,6 +1333,17 @@ int cvLsDenseDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
 
     inc_inv = ONE / inc;
     N_VLinearSum(inc_inv, ftemp, -inc_inv, fy, jthCol);
+
+    /* When tracking columns, add the nonzeros to the sparsity pattern */
+    if (coldirty)
+    {
+      col_data = SUNDenseMatrix_Column(Jac, j);
+      pattern  = cvls_mem->pattern + j * N;
+      for (i = 0; i < N; i++)
+      {
+        if (col_data[i] != ZERO) { pattern[i] = SUNTRUE; }
+      }
+    }
   }
 
   /* Destroy jthCol vector */
@@ -1125,6 +1353,134 @@ int cvLsDenseDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
   return (retval);
 }
 
+/*-----------------------------------------------------------------
+  cvLsDenseDQJacColumns
+
+  This routine flags the columns of a dense DQ Jacobian that may
+  have changed since they were last computed. A solution component
+  y_k has changed if it differs from its reference value by more
+  than dytol in the weighted norm. Then any f_i depending on y_k,
+  i.e., with P(i,k) set, is flagged, and so are the columns j with
+  P(i,j) set in such a row, as df_i/dy_j may depend on y_k. The
+  pattern P is the union of the nonzeros of all columns computed
+  so far, so that a coupling that is numerically zero at one
+  evaluation (e.g., proportional to a component that is zero
+  initially) is still tracked once it was nonzero at any other.
+  Couplings that were zero at every evaluation are picked up by
+  the full update forced every msbj setups in cvLsSetup.
+  The reference values of the changed components are reset, as
+  all columns depending on them are recomputed; the others keep
+  their reference so that slow drifts are eventually detected.
+  All columns are flagged on the first call, when the problem size
+  changed, and after a full update was requested (jfull).
+  -----------------------------------------------------------------*/
+static int cvLsDenseDQJacColumns(CVodeMem cv_mem, CVLsMem cvls_mem, N_Vector y,
+                                 SUNMatrix Jac, sunbooleantype** coldirty)
+{
+  sunrealtype *y_data, *ylj_data, *ewt_data;
+  sunbooleantype *rowdirty, *cols, *pattern;
+  sunindextype i, j, N;
+
+  N = SUNDenseMatrix_Columns(Jac);
+
+  /* Allocate the tracker workspace on first use or for a new problem size */
+  if ((cvls_mem->ntrack != N) || (cvls_mem->ylj == NULL) ||
+      (N_VGetLength(cvls_mem->ylj) != N_VGetLength(y)))
+  {
+    cvLsFreeTracker(cvls_mem);
+    cvls_mem->ylj   = N_VClone(y);
+    cvls_mem->dirty = (sunbooleantype*)malloc(2 * N * sizeof(sunbooleantype));
+    cvls_mem->pattern =
+      (sunbooleantype*)calloc((size_t)N * (size_t)N, sizeof(sunbooleantype));
+    if ((cvls_mem->ylj == NULL) || (cvls_mem->dirty == NULL) ||
+        (cvls_mem->pattern == NULL))
+    {
+      cvLsFreeTracker(cvls_mem);
+      cvProcessError(cv_mem, CVLS_MEM_FAIL, __LINE__, __func__, __FILE__,
+                     MSG_LS_MEM_FAIL);
+      return (CVLS_MEM_FAIL);
+    }
+    cvls_mem->ntrack = N;
+    cvls_mem->jfull  = SUNTRUE;
+  }
+
+  rowdirty  = cvls_mem->dirty;
+  cols      = cvls_mem->dirty + N;
+  pattern   = cvls_mem->pattern;
+  *coldirty = cols;
+
+  /* Recompute all columns and reset the reference solution */
+  if (cvls_mem->jfull)
+  {
+    for (j = 0; j < N; j++) { cols[j] = SUNTRUE; }
+    N_VScale(ONE, y, cvls_mem->ylj);
+    cvls_mem->nupdated = N;
+    cvls_mem->nsfull   = 0;
+    return (CVLS_SUCCESS);
+  }
+
+  y_data   = N_VGetArrayPointer(y);
+  ylj_data = N_VGetArrayPointer(cvls_mem->ylj);
+  ewt_data = N_VGetArrayPointer(cv_mem->cv_ewt);
+
+  /* Flag the changed components and reset their reference values */
+  for (j = 0; j < N; j++)
+  {
+    rowdirty[j] = SUNFALSE;
+    cols[j]     = (SUNRabs(y_data[j] - ylj_data[j]) * ewt_data[j] >
+               cvls_mem->dytol);
+    if (cols[j]) { ylj_data[j] = y_data[j]; }
+  }
+
+  /* Flag the functions depending on a changed component */
+  for (j = 0; j < N; j++)
+  {
+    if (!cols[j]) { continue; }
+    for (i = 0; i < N; i++)
+    {
+      if (pattern[j * N + i]) { rowdirty[i] = SUNTRUE; }
+    }
+  }
+
+  /* Flag the columns with an entry in a flagged row */
+  cvls_mem->nupdated = 0;
+  for (j = 0; j < N; j++)
+  {
+    for (i = 0; (i < N) && !cols[j]; i++)
+    {
+      if (rowdirty[i] && pattern[j * N + i]) { cols[j] = SUNTRUE; }
+    }
+    if (cols[j]) { cvls_mem->nupdated++; }
+  }
+
+  return (CVLS_SUCCESS);
+}
+
+/*-----------------------------------------------------------------
+  cvLsFreeTracker
+
+  This routine frees the workspace of the dense DQ column tracker.
+  -----------------------------------------------------------------*/
+static void cvLsFreeTracker(CVLsMem cvls_mem)
+{
+  if (cvls_mem->ylj)
+  {
+    N_VDestroy(cvls_mem->ylj);
+    cvls_mem->ylj = NULL;
+  }
+  if (cvls_mem->dirty)
+  {
+    free(cvls_mem->dirty);
+    cvls_mem->dirty = NULL;
+  }
+  if (cvls_mem->pattern)
+  {
+    free(cvls_mem->pattern);
+    cvls_mem->pattern = NULL;
+  }
+  cvls_mem->ntrack = 0;
+}
+
 /*-----------------------------------------------------------------
   cvLsBandDQJac
 
@@ -1258,7 +1614,9 @@ int cvLsBandDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
   This routine generates a difference quotient approximation to
   the Jacobian times vector f_y(t,y) * v. The approximation is
   Jv = [f(y + v*sig) - f(y)]/sig, where sig = 1 / ||v||_WRMS,
-  i.e. the WRMS norm of v*sig is 1.
+  i.e. the WRMS norm of v*sig is 1. If the user supplied a
+  directional derivative function with CVodeSetRhsDirFn (and no
+  alternative jtimesRhsFn), the exact product is returned instead.
   -----------------------------------------------------------------*/
 int cvLsDQJtimes(N_Vector v, N_Vector Jv, sunrealtype t, N_Vector y,
                  N_Vector fy, void* cvode_mem, N_Vector work)
@@ -1272,6 +1630,15 @@ int cvLsDQJtimes(N_Vector v, N_Vector Jv, sunrealtype t, N_Vector y,
   retval = cvLs_AccessLMem(cvode_mem, __func__, &cv_mem, &cvls_mem);
   if (retval != CVLS_SUCCESS) { return (retval); }
 
+  /* Compute Jv with the directional derivative function (work = f) */
+  if ((cv_mem->cv_fdir != NULL) && (cvls_mem->jt_f == cv_mem->cv_f))
+  {
+    retval = cv_mem->cv_fdir(t, y, v, work, Jv, cv_mem->cv_user_data);
+    if (retval < 0) { return (-1); }
+    if (retval > 0) { return (+1); }
+    return (0);
+  }
+
   /* Initialize perturbation to 1/||v|| */
   sig = ONE / N_VWrmsNorm(v, cv_mem->cv_ewt);
 
@@ -1312,6 +1679,7 @@ static int cvLsLinSys(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix A,
 {
   CVodeMem cv_mem;
   CVLsMem cvls_mem;
+  SUNMatrix J;
   int retval;
 
   /* access CVLsMem structure */
@@ -1324,6 +1692,14 @@ static int cvLsLinSys(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix A,
     /* Use saved copy of J */
     *jcur = SUNFALSE;
 
+    /* When tracking columns, A still holds the factored linear system if
+       gamma did not change since the last linear solver setup */
+    if (cvls_mem->coltrack && (gamma == cvls_mem->gamma_setup))
+    {
+      cvls_mem->skipsetup = SUNTRUE;
+      return (CVLS_SUCCESS);
+    }
+
     /* Overwrite linear system matrix with saved J */
     retval = SUNMatCopy(cvls_mem->savedJ, A);
     if (retval)
@@ -1339,10 +1715,14 @@ static int cvLsLinSys(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix A,
     /* Call jac() routine to update J */
     *jcur = SUNTRUE;
 
-    /* Clear the linear system matrix if necessary */
-    if (SUNLinSolGetType(cvls_mem->LS) == SUNLINEARSOLVER_DIRECT)
+    /* When tracking columns, update the saved copy of J in place */
+    J = (cvls_mem->coltrack) ? cvls_mem->savedJ : A;
+
+    /* Clear the Jacobian matrix if necessary */
+    if ((SUNLinSolGetType(cvls_mem->LS) == SUNLINEARSOLVER_DIRECT) &&
+        (!cvls_mem->coltrack || cvls_mem->jfull))
     {
-      retval = SUNMatZero(A);
+      retval = SUNMatZero(J);
       if (retval)
       {
         cvProcessError(cv_mem, CVLS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
@@ -1353,7 +1733,8 @@ static int cvLsLinSys(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix A,
     }
 
     /* Compute new Jacobian matrix */
-    retval = cvls_mem->jac(t, y, fy, A, cvls_mem->J_data, vtemp1, vtemp2, vtemp3);
+    cvls_mem->nupdated = -1;
+    retval = cvls_mem->jac(t, y, fy, J, cvls_mem->J_data, vtemp1, vtemp2, vtemp3);
     if (retval < 0)
     {
       cvProcessError(cv_mem, CVLS_JACFUNC_UNRECVR, __LINE__, __func__, __FILE__,
@@ -1363,12 +1744,25 @@ static int cvLsLinSys(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix A,
     }
     if (retval > 0)
     {
+      /* a partially updated J must be recomputed in full */
+      cvls_mem->jfull     = SUNTRUE;
       cvls_mem->last_flag = CVLS_JACFUNC_RECVR;
       return (1);
     }
 
-    /* Update saved copy of the Jacobian matrix */
-    retval = SUNMatCopy(A, cvls_mem->savedJ);
+    /* Update saved copy of the Jacobian matrix, or when tracking columns, the
+       linear system matrix unless neither J nor gamma changed */
+    if (cvls_mem->coltrack)
+    {
+      cvls_mem->jfull = SUNFALSE;
+      if ((cvls_mem->nupdated == 0) && (gamma == cvls_mem->gamma_setup))
+      {
+        cvls_mem->skipsetup = SUNTRUE;
+        return (CVLS_SUCCESS);
+      }
+      retval = SUNMatCopy(cvls_mem->savedJ, A);
+    }
+    else { retval = SUNMatCopy(A, cvls_mem->savedJ); }
     if (retval)
     {
       cvProcessError(cv_mem, CVLS_SUNMAT_FAIL, __LINE__, __func__, __FILE__,
@@ -1488,6 +1882,10 @@ int cvLsInitialize(CVodeMem cv_mem)
   /* reset counters */
   cvLsInitializeCounters(cvls_mem);
 
+  /* Require a full Jacobian and linear solver setup at the first call */
+  cvls_mem->jfull       = SUNTRUE;
+  cvls_mem->gamma_setup = ZERO;
+
   /* Set Jacobian-vector product related fields, based on jtimesDQ */
   if (cvls_mem->jtimesDQ)
   {
@@ -1536,6 +1934,7 @@ int cvLsSetup(CVodeMem cv_mem, int convfail, N_Vector ypred, N_Vector fpred,
 {
   CVLsMem cvls_mem;
   sunrealtype dgamma;
+  sunbooleantype jold;
   int retval;
 
   /* access CVLsMem structure */
@@ -1555,13 +1954,30 @@ int cvLsSetup(CVodeMem cv_mem, int convfail, N_Vector ypred, N_Vector fpred,
   }
 
   /* Set CVLs N_Vector pointers to current solution and rhs */
-  cvls_mem->ycur = ypred;
-  cvls_mem->fcur = fpred;
+  cvls_mem->ycur      = ypred;
+  cvls_mem->fcur      = fpred;
+  cvls_mem->skipsetup = SUNFALSE;
+
+  /* When tracking columns, recompute the full DQ Jacobian after a nonlinear
+     solver failure and at least every msbj setups, so that couplings that
+     were zero at every evaluation so far are eventually found */
+  if (cvls_mem->coltrack && cvls_mem->jacDQ)
+  {
+    cvls_mem->nsfull++;
+    if ((convfail != CV_NO_FAILURES) || (cvls_mem->nsfull >= cvls_mem->msbj))
+    {
+      cvls_mem->jfull = SUNTRUE;
+    }
+  }
+
+  /* Use nst, gamma/gammap, and convfail to set J/P eval. flag jok; the
+     cost model replaces the test on the number of steps since the last
+     evaluation */
+  if (cv_mem->cv_costmodel) { jold = cvLsCostModelJbad(cv_mem, cvls_mem); }
+  else { jold = (cv_mem->cv_nst >= cvls_mem->nstlj + cvls_mem->msbj); }
 
-  /* Use nst, gamma/gammap, and convfail to set J/P eval. flag jok */
   dgamma         = SUNRabs((cv_mem->cv_gamma / cv_mem->cv_gammap) - ONE);
-  cvls_mem->jbad = (cv_mem->cv_nst == 0) ||
-                   (cv_mem->cv_nst >= cvls_mem->nstlj + cvls_mem->msbj) ||
+  cvls_mem->jbad = (cv_mem->cv_nst == 0) || jold ||
                    ((convfail == CV_FAIL_BAD_J) &&
                     (dgamma < cvls_mem->dgmax_jbad)) ||
                    (convfail == CV_FAIL_OTHER);
@@ -1578,8 +1994,10 @@ int cvLsSetup(CVodeMem cv_mem, int convfail, N_Vector ypred, N_Vector fpred,
     if (*jcurPtr)
     {
       cvls_mem->nje++;
-      cvls_mem->nstlj = cv_mem->cv_nst;
-      cvls_mem->tnlj  = cv_mem->cv_tn;
+      cvls_mem->nstlj    = cv_mem->cv_nst;
+      cvls_mem->tnlj     = cv_mem->cv_tn;
+      cvls_mem->tcost_lj = cv_mem->cv_tnls + cv_mem->cv_tlsetup;
+      cvls_mem->tstep    = ZERO;
     }
 
     /* Check linsys() return value and return if necessary */
@@ -1609,10 +2027,25 @@ int cvLsSetup(CVodeMem cv_mem, int convfail, N_Vector ypred, N_Vector fpred,
     *jcurPtr = cvls_mem->jbad;
   }
 
+  /* Skip the LS setup if the linear system did not change */
+  if (cvls_mem->skipsetup)
+  {
+    cvls_mem->nlsskip++;
+    cvls_mem->last_flag = CVLS_SUCCESS;
+    return (cvls_mem->last_flag);
+  }
+
   /* Call LS setup routine -- the LS may call cvLsPSetup, who will
      pass the heuristic suggestions above to the user code(s) */
   cvls_mem->last_flag = SUNLinSolSetup(cvls_mem->LS, cvls_mem->A);
 
+  /* Save gamma of a successful setup to detect when it can be skipped */
+  if (cvls_mem->last_flag == SUN_SUCCESS)
+  {
+    cvls_mem->gamma_setup = cv_mem->cv_gamma;
+  }
+  else { cvls_mem->gamma_setup = ZERO; }
+
   /* If Matrix-free, update heuristics flags */
   if (cvls_mem->A == NULL)
   {
@@ -1620,8 +2053,10 @@ int cvLsSetup(CVodeMem cv_mem, int convfail, N_Vector ypred, N_Vector fpred,
     if (*jcurPtr)
     {
       cvls_mem->npe++;
-      cvls_mem->nstlj = cv_mem->cv_nst;
-      cvls_mem->tnlj  = cv_mem->cv_tn;
+      cvls_mem->nstlj    = cv_mem->cv_nst;
+      cvls_mem->tnlj     = cv_mem->cv_tn;
+      cvls_mem->tcost_lj = cv_mem->cv_tnls + cv_mem->cv_tlsetup;
+      cvls_mem->tstep    = ZERO;
     }
 
     /* Update jcur flag if we suggested an update */
@@ -1631,6 +2066,93 @@ int cvLsSetup(CVodeMem cv_mem, int convfail, N_Vector ypred, N_Vector fpred,
   return (cvls_mem->last_flag);
 }
 
+/*-----------------------------------------------------------------
+  cvLsCostModelJbad
+
+  Decides from the measured solver costs whether the Jacobian (or
+  preconditioner) should be recomputed. The cost per step of the
+  steps since the last setup call, i.e., the time in the nonlinear
+  solver and in setups that reused the Jacobian, is compared to the
+  average cost per step since the last Jacobian evaluation, which
+  also includes the time of that evaluation. Once the cost per step
+  exceeds the average, as the Newton iteration slows down with an
+  aging Jacobian, a new evaluation reduces the average cost per
+  step. Expensive evaluations are thus reused for longer and cheap
+  ones are recomputed more often.
+
+  The cost per step is smoothed with an exponential average (weight
+  CVLS_CMWT on the latest value) that restarts at each evaluation,
+  so that a single slow step, e.g., from a preempted thread, does
+  not trigger an evaluation by itself. Since the decision depends
+  on measured times, the step sequence is not reproducible from run
+  to run when the cost model is enabled.
+  -----------------------------------------------------------------*/
+static sunbooleantype cvLsCostModelJbad(CVodeMem cv_mem, CVLsMem cvls_mem)
+{
+  sunrealtype tcost, tavg, tstep;
+  sunbooleantype jbad = SUNFALSE;
+
+  tcost = cv_mem->cv_tnls + cv_mem->cv_tlsetup;
+
+  if ((cv_mem->cv_nst > cvls_mem->nstls) && (cv_mem->cv_nst > cvls_mem->nstlj))
+  {
+    tavg  = (cv_mem->cv_tjaclast + tcost - cvls_mem->tcost_lj) /
+           (sunrealtype)(cv_mem->cv_nst - cvls_mem->nstlj);
+    tstep = (tcost - cvls_mem->tcost_ls) /
+            (sunrealtype)(cv_mem->cv_nst - cvls_mem->nstls);
+    if (cvls_mem->tstep > ZERO)
+    {
+      tstep = CVLS_CMWT * tstep + (ONE - CVLS_CMWT) * cvls_mem->tstep;
+    }
+    cvls_mem->tstep = tstep;
+    jbad            = (tstep > tavg);
+  }
+
+  cvls_mem->tcost_ls = tcost;
+  cvls_mem->nstls    = cv_mem->cv_nst;
+
+  return (jbad);
+}
+
+/*-----------------------------------------------------------------
+  cvLsForcingTol
+
+  This routine returns the adaptive linear solver tolerance
+  min(eta_k * ||b_k||, tolmax) (in the WRMS norm) for Newton
+  iteration k, with the Eisenstat-Walker forcing term (choice 2)
+
+    eta_k = gamma * (||b_k|| / ||b_{k-1}||)^alpha,
+
+  safeguarded by gamma * eta_{k-1}^alpha when that exceeds 0.1 and
+  bounded by CVLS_FETAMX. The first iteration uses CVLS_FETA0. The
+  tolerance is loose while the residual is large and tightens as
+  the Newton iteration converges. The cap tolmax keeps the linear
+  solver error below the Newton tolerance, since a preconditioned
+  solver measures a residual norm that can be much smaller than
+  ||b_k||, and the Newton corrections form the local error
+  estimate.
+  -----------------------------------------------------------------*/
+static sunrealtype cvLsForcingTol(CVLsMem cvls_mem, int curiter,
+                                  sunrealtype bnorm, sunrealtype tolmax)
+{
+  sunrealtype eta, etasafe;
+
+  if (curiter == 0 || cvls_mem->fbnorm <= ZERO) { eta = CVLS_FETA0; }
+  else
+  {
+    eta = cvls_mem->fgamma *
+          SUNRpowerR(bnorm / cvls_mem->fbnorm, cvls_mem->falpha);
+    etasafe = cvls_mem->fgamma * SUNRpowerR(cvls_mem->feta, cvls_mem->falpha);
+    if (etasafe > SUN_RCONST(0.1)) { eta = SUNMAX(eta, etasafe); }
+  }
+  eta = SUNMIN(eta, CVLS_FETAMX);
+
+  cvls_mem->feta   = eta;
+  cvls_mem->fbnorm = bnorm;
+
+  return (SUNMIN(eta * bnorm, tolmax));
+}
+
 /*-----------------------------------------------------------------
   cvLsSolve
 
@@ -1676,6 +2198,13 @@ int cvLsSolve(CVodeMem cv_mem, N_Vector b, N_Vector weight, N_Vector ynow,
       cvls_mem->last_flag = CVLS_SUCCESS;
       return (cvls_mem->last_flag);
     }
+    /* With the adaptive forcing term, relax the tolerance relative to
+       the current residual (between deltar and frelax * deltar) */
+    if (cvls_mem->forcing)
+    {
+      deltar = SUNMAX(deltar, cvLsForcingTol(cvls_mem, curiter, bnorm,
+                                             cvls_mem->frelax * deltar));
+    }
     /* Adjust tolerance for 2-norm */
     delta = deltar * cvls_mem->nrmfac;
   }
@@ -1860,6 +2389,9 @@ int cvLsFree(CVodeMem cv_mem)
     cvls_mem->savedJ = NULL;
   }
 
+  /* Free column tracking memory */
+  cvLsFreeTracker(cvls_mem);
+
   /* Nullify other N_Vector pointers */
   cvls_mem->ycur = NULL;
   cvls_mem->fcur = NULL;
@@ -1892,6 +2424,11 @@ int cvLsInitializeCounters(CVLsMem cvls_mem)
   cvls_mem->ncfl     = 0;
   cvls_mem->njtsetup = 0;
   cvls_mem->njtimes  = 0;
+  cvls_mem->tcost_lj = ZERO;
+  cvls_mem->tcost_ls = ZERO;
+  cvls_mem->tstep    = ZERO;
+  cvls_mem->nstls    = 0;
+  cvls_mem->nlsskip  = 0;
   return (0);
 }
 
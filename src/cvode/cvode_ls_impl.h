@@ -36,10 +36,28 @@ extern "C" {
   CVLS_EPLIN  default value for factor by which the tolerance on
               the nonlinear iteration is multiplied to get a
               tolerance on the linear iteration
+  CVLS_DYTOL  default weighted change in a solution component
+              above which the DQ Jacobian columns depending on it
+              are recomputed when tracking columns
+  CVLS_FGAMMA default gamma of the adaptive forcing term
+  CVLS_FALPHA default alpha of the adaptive forcing term
+  CVLS_FETA0  adaptive forcing term at the first Newton iteration
+  CVLS_FETAMX maximum adaptive forcing term
+  CVLS_FRELAX default maximum factor by which the adaptive forcing
+              term relaxes the linear solver tolerance
+  CVLS_CMWT   weight of the latest per-step cost in the smoothed
+              per-step cost of the Jacobian evaluation cost model
   -----------------------------------------------------------------*/
-#define CVLS_MSBJ  51
-#define CVLS_DGMAX SUN_RCONST(0.2)
-#define CVLS_EPLIN SUN_RCONST(0.05)
+#define CVLS_MSBJ   51
+#define CVLS_DGMAX  SUN_RCONST(0.2)
+#define CVLS_EPLIN  SUN_RCONST(0.05)
+#define CVLS_DYTOL  SUN_RCONST(1.0)
+#define CVLS_FGAMMA SUN_RCONST(0.9)
+#define CVLS_FALPHA SUN_RCONST(2.0)
+#define CVLS_FETA0  SUN_RCONST(0.1)
+#define CVLS_FETAMX SUN_RCONST(0.9)
+#define CVLS_FRELAX SUN_RCONST(2.0)
+#define CVLS_CMWT   SUN_RCONST(0.25)
 
 /*-----------------------------------------------------------------
   Types : CVLsMemRec, CVLsMem
@@ -67,6 +85,14 @@ typedef struct CVLsMemRec
   sunrealtype eplifac; /* nonlinear -> linear tol scaling factor       */
   sunrealtype nrmfac;  /* integrator -> LS norm conversion factor      */
 
+  /* Adaptive forcing term (see CVodeSetLSForcing) */
+  sunbooleantype forcing; /* use the Eisenstat-Walker forcing term     */
+  sunrealtype fgamma;     /* forcing term parameter gamma              */
+  sunrealtype falpha;     /* forcing term parameter alpha              */
+  sunrealtype frelax;     /* maximum relaxation of the fixed tolerance */
+  sunrealtype feta;       /* forcing term of the last linear solve     */
+  sunrealtype fbnorm;     /* WRMS norm of b in the last linear solve   */
+
   /* Linear solver, matrix and vector objects/pointers */
   SUNLinearSolver LS; /* generic linear solver object                 */
   SUNMatrix A;        /* A = I - gamma * df/dy                        */
@@ -90,6 +116,26 @@ typedef struct CVLsMemRec
   long int njtimes;  /* njtimes = total number of calls to jtimes    */
   sunrealtype tnlj;  /* tnlj = t_n at last jac/pset call             */
 
+  /* Jacobian evaluation cost model (see CVodeSetJacEvalCostModel) */
+  sunrealtype tcost_lj; /* per-step solver time at last jac/pset call */
+  sunrealtype tcost_ls; /* per-step solver time at last setup call    */
+  sunrealtype tstep;    /* smoothed solver time per step since jac    */
+  long int nstls;       /* nst at last setup call                     */
+
+  /* Incremental Jacobian updates (see CVodeSetJacColumnTracking) */
+  sunbooleantype coltrack;  /* update J in place, tracking columns      */
+  sunrealtype dytol;        /* change tolerance of the DQ tracker       */
+  sunbooleantype jfull;     /* must all columns be recomputed?          */
+  sunindextype nupdated;    /* columns updated by last jac (-1 = all)   */
+  sunrealtype gamma_setup;  /* gamma at last LS setup (0 = invalid)     */
+  sunbooleantype skipsetup; /* are A and its factorization current?     */
+  long int nlsskip;         /* number of skipped LS setups              */
+  N_Vector ylj;             /* reference y of the DQ change tracker     */
+  sunbooleantype* dirty;    /* dirty row and column flags (length 2N)   */
+  sunbooleantype* pattern;  /* nonzeros of all computed DQ columns      */
+  sunindextype ntrack;      /* N of the DQ tracker workspace            */
+  long int nsfull;          /* setups since the last full DQ Jacobian   */
+
   /* Preconditioner computation
    * (a) user-provided:
    *     - P_data == user_data
@@ -177,6 +223,9 @@ int cvLs_AccessLMem(void* cvode_mem, const char* fname, CVodeMem* cv_mem,
 #define MSG_LS_BAD_SIZES \
   "Illegal bandwidth parameter(s). Must have 0 <=  ml, mu <= N-1."
 #define MSG_LS_BAD_EPLIN "eplifac < 0 illegal."
+#define MSG_LS_BAD_FORCING \
+  "Illegal forcing term parameters (need gamma <= 1 and 1 < alpha <= 2)."
+#define MSG_LS_BAD_FRELAX "frelax < 1 illegal."
 
 #define MSG_LS_PSET_FAILED \
   "The preconditioner setup routine failed in an unrecoverable manner."
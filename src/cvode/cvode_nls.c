@@ -16,9 +16,11 @@
 
 #include "cvode_impl.h"
 #include "sundials/sundials_math.h"
+#include "sundials_utils.h"
 
 /* constant macros */
-#define ONE SUN_RCONST(1.0) /* real 1.0 */
+#define ZERO SUN_RCONST(0.0) /* real 0.0 */
+#define ONE  SUN_RCONST(1.0) /* real 1.0 */
 
 /* nonlinear solver constants
      NLS_MAXCOR  maximum no. of corrector iterations for the nonlinear solver
@@ -254,6 +256,7 @@ static int cvNlsLSetup(sunbooleantype jbad, sunbooleantype* jcur, void* cvode_me
 {
   CVodeMem cv_mem;
   int retval;
+  double tsetup = 0.0;
 
   if (cvode_mem == NULL)
   {
@@ -266,12 +269,26 @@ static int cvNlsLSetup(sunbooleantype jbad, sunbooleantype* jcur, void* cvode_me
   if (jbad) { cv_mem->convfail = CV_FAIL_BAD_J; }
 
   /* setup the linear solver */
+  if (cv_mem->cv_costmodel) { tsetup = sunWallClockTime(); }
+
   retval = cv_mem->cv_lsetup(cv_mem, cv_mem->convfail, cv_mem->cv_y,
                              cv_mem->cv_ftemp, &(cv_mem->cv_jcur),
                              cv_mem->cv_vtemp1, cv_mem->cv_vtemp2,
                              cv_mem->cv_vtemp3);
   cv_mem->cv_nsetups++;
 
+  /* accumulate the setup time for the Jacobian cost model */
+  if (cv_mem->cv_costmodel)
+  {
+    tsetup = sunWallClockTime() - tsetup;
+    if (cv_mem->cv_jcur)
+    {
+      cv_mem->cv_tjac     += (sunrealtype)tsetup;
+      cv_mem->cv_tjaclast  = (sunrealtype)tsetup;
+    }
+    else { cv_mem->cv_tlsetup += (sunrealtype)tsetup; }
+  }
+
   /* update Jacobian status */
   *jcur = cv_mem->cv_jcur;
 
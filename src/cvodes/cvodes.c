@@ -47,6 +47,10 @@
  *
  *      CVodeRootInit
  *
+ *   Checkpoint/restart functions
+ *      CVodeWriteState
+ *      CVodeReadState
+ *
  *   Main solver function
  *      CVode
  *
@@ -89,6 +93,12 @@
  *      cvUpperBoundH0
  *      cvYddNorm
  *
+ *   State serialization
+ *      cvStateHeader
+ *      cvStateIO
+ *      cvStateVectors
+ *      cvStateTransfer
+ *
  *   Initial setup
  *      cvInitialSetup
  *      cvEwtSet
@@ -173,7 +183,13 @@
  *   Internal DQ approximations for sensitivity RHS
  *      cvSensRhsInternalDQ
  *      cvSensRhs1InternalDQ
+ *      cvSensRhsThreadedDQ
+ *      cvSensRhs1DQ
  *      cvQuadSensRhsDQ
+ *      cvQuadSensRhsThreadedDQ
+ *      cvQuadSensRhs1DQ
+ *      cvSensDQThreadsSyncParams
+ *      cvSensDQThreadsFree
  *
  *   Error message handling functions
  *      cvProcessError
@@ -196,6 +212,10 @@
 #include "sundials/priv/sundials_errors_impl.h"
 #include "sundials/sundials_context.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /*=================================================================*/
 /* CVODE Private Constants                                         */
 /*=================================================================*/
@@ -304,6 +324,21 @@
 
 #define CORTES SUN_RCONST(0.1)
 
+/*
+ * State stream constants
+ * ----------------------
+ *
+ * CVodeWriteState and CVodeReadState
+ *
+ *    STATE_ID      identifier at the start of a CVODE state stream
+ *    STATE_VERSION layout version of the state stream
+ *    STATE_NHDR    number of int entries in the stream header
+ */
+
+#define STATE_ID      0x43564F44
+#define STATE_VERSION 1
+#define STATE_NHDR    13
+
 /*=================================================================*/
 /* Private Helper Functions Prototypes                             */
 /*=================================================================*/
@@ -314,6 +349,16 @@ static sunbooleantype cvCheckNvector(N_Vector tmpl);
 
 static int cvInitialSetup(CVodeMem cv_mem);
 
+/* State serialization */
+
+static void cvStateHeader(CVodeMem cv_mem, int hdr[]);
+static sunbooleantype cvStateIO(FILE* fp, void* data, size_t size, size_t n,
+                                sunbooleantype save);
+static sunbooleantype cvStateVectors(FILE* fp, N_Vector* v, int n,
+                                     sunbooleantype save);
+static sunbooleantype cvStateTransfer(CVodeMem cv_mem, FILE* fp,
+                                      sunbooleantype save);
+
 /* Memory allocation/deallocation */
 
 static sunbooleantype cvAllocVectors(CVodeMem cv_mem, N_Vector tmpl);
@@ -442,6 +487,26 @@ static int cvQuadSensRhs1InternalDQ(CVodeMem cv_mem, int is, sunrealtype t,
                                     N_Vector y, N_Vector yS, N_Vector yQdot,
                                     N_Vector yQSdot, N_Vector tmp, N_Vector tmpQ);
 
+static int cvSensRhsThreadedDQ(CVodeMem cv_mem, int Ns, sunrealtype t,
+                               N_Vector y, N_Vector ydot, N_Vector* yS,
+                               N_Vector* ySdot, N_Vector ytemp, N_Vector ftemp);
+
+static int cvSensRhs1DQ(CVodeMem cv_mem, sunrealtype t, N_Vector y,
+                        N_Vector ydot, int is, N_Vector yS, N_Vector ySdot,
+                        sunrealtype* p, void* user_data, N_Vector ytemp,
+                        N_Vector ftemp, int* nfel);
+
+static int cvQuadSensRhsThreadedDQ(CVodeMem cv_mem, int Ns, sunrealtype t,
+                                   N_Vector y, N_Vector* yS, N_Vector yQdot,
+                                   N_Vector* yQSdot, N_Vector tmp, N_Vector tmpQ);
+
+static int cvQuadSensRhs1DQ(CVodeMem cv_mem, int is, sunrealtype t,
+                            N_Vector y, N_Vector yS, N_Vector yQdot,
+                            N_Vector yQSdot, sunrealtype* p, void* user_data,
+                            N_Vector tmp, N_Vector tmpQ, int* nfel);
+
+static void cvSensDQThreadsSyncParams(CVodeMem cv_mem);
+
 /*
  * =================================================================
  * Exported Functions Implementation
@@ -506,6 +571,7 @@ void* CVodeCreate(int lmm, SUNContext sunctx)
 
   /* Set default values for integrator optional inputs */
   cv_mem->cv_f                = NULL;
+  cv_mem->cv_fdir             = NULL;
   cv_mem->cv_user_data        = NULL;
   cv_mem->cv_itol             = CV_NN;
   cv_mem->cv_atolmin0         = SUNTRUE;
@@ -570,24 +636,29 @@ void* CVodeCreate(int lmm, SUNContext sunctx)
 
   /* Set default values for sensi. optional inputs */
 
-  cv_mem->cv_sensi     = SUNFALSE;
-  cv_mem->cv_fS_data   = NULL;
-  cv_mem->cv_fS        = cvSensRhsInternalDQ;
-  cv_mem->cv_fS1       = cvSensRhs1InternalDQ;
-  cv_mem->cv_fSDQ      = SUNTRUE;
-  cv_mem->cv_ifS       = CV_ONESENS;
-  cv_mem->cv_DQtype    = CV_CENTERED;
-  cv_mem->cv_DQrhomax  = ZERO;
-  cv_mem->cv_p         = NULL;
-  cv_mem->cv_pbar      = NULL;
-  cv_mem->cv_plist     = NULL;
-  cv_mem->cv_errconS   = SUNFALSE;
-  cv_mem->cv_ncfS1     = NULL;
-  cv_mem->cv_ncfnS1    = NULL;
-  cv_mem->cv_nniS1     = NULL;
-  cv_mem->cv_nnfS1     = NULL;
-  cv_mem->cv_itolS     = CV_NN;
-  cv_mem->cv_atolSmin0 = NULL;
+  cv_mem->cv_sensi      = SUNFALSE;
+  cv_mem->cv_fS_data    = NULL;
+  cv_mem->cv_fS         = cvSensRhsInternalDQ;
+  cv_mem->cv_fS1        = cvSensRhs1InternalDQ;
+  cv_mem->cv_fSDQ       = SUNTRUE;
+  cv_mem->cv_ifS        = CV_ONESENS;
+  cv_mem->cv_DQtype     = CV_CENTERED;
+  cv_mem->cv_DQrhomax   = ZERO;
+  cv_mem->cv_DQnthreads = 1;
+  cv_mem->cv_DQpth      = NULL;
+  cv_mem->cv_DQudatath  = NULL;
+  cv_mem->cv_DQtmpth    = NULL;
+  cv_mem->cv_DQtmpQth   = NULL;
+  cv_mem->cv_p          = NULL;
+  cv_mem->cv_pbar       = NULL;
+  cv_mem->cv_plist      = NULL;
+  cv_mem->cv_errconS    = SUNFALSE;
+  cv_mem->cv_ncfS1      = NULL;
+  cv_mem->cv_ncfnS1     = NULL;
+  cv_mem->cv_nniS1      = NULL;
+  cv_mem->cv_nnfS1      = NULL;
+  cv_mem->cv_itolS      = CV_NN;
+  cv_mem->cv_atolSmin0  = NULL;
 
   /* Set default values for quad. sensi. optional inputs */
 
@@ -819,11 +890,12 @@ int CVodeInit(void* cvode_mem, CVRhsFn f, sunrealtype t0, N_Vector y0)
   /* Set the linear solver addresses to NULL.
      (We check != NULL later, in CVode) */
 
-  cv_mem->cv_linit  = NULL;
-  cv_mem->cv_lsetup = NULL;
-  cv_mem->cv_lsolve = NULL;
-  cv_mem->cv_lfree  = NULL;
-  cv_mem->cv_lmem   = NULL;
+  cv_mem->cv_linit       = NULL;
+  cv_mem->cv_lsetup      = NULL;
+  cv_mem->cv_lsolve      = NULL;
+  cv_mem->cv_lsolvemulti = NULL;
+  cv_mem->cv_lfree       = NULL;
+  cv_mem->cv_lmem        = NULL;
 
   /* Set forceSetup to SUNFALSE */
 
@@ -981,6 +1053,188 @@ int CVodeReInit(void* cvode_mem, sunrealtype t0, N_Vector y0)
 
 /*-----------------------------------------------------------------*/
 
+/*
+ * CVodeWriteState
+ *
+ * CVodeWriteState writes everything CVODES needs to continue the
+ * integration from the current internal time to the binary stream fp:
+ * the step data, counters, Nordsieck history arrays (including those
+ * of quadratures and sensitivities, if active), and rootfinding data.
+ * Adjoint sensitivity data is not written. Optional inputs, tolerances, and solver objects are not
+ * written; they are set up by the user before calling CVodeReadState.
+ * The vectors are written with the N_Vector buffer operations, so the
+ * stream holds the local (per-process) part of the state.
+ */
+
+int CVodeWriteState(void* cvode_mem, FILE* fp)
+{
+  CVodeMem cv_mem;
+  int hdr[STATE_NHDR];
+  sunindextype bufsize;
+  sunbooleantype ok;
+
+  /* Check cvode_mem */
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem)cvode_mem;
+
+  if (cv_mem->cv_MallocDone == SUNFALSE)
+  {
+    cvProcessError(cv_mem, CV_NO_MALLOC, __LINE__, __func__, __FILE__,
+                   MSGCV_NO_MALLOC);
+    return (CV_NO_MALLOC);
+  }
+
+  if (fp == NULL)
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_NULL_FP);
+    return (CV_ILL_INPUT);
+  }
+
+  /* The vectors are serialized with the buffer operations */
+
+  if (N_VBufSize(cv_mem->cv_zn[0], &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    cvProcessError(cv_mem, CV_VECTOROP_ERR, __LINE__, __func__, __FILE__,
+                   MSGCV_BAD_NVECTOR);
+    return (CV_VECTOROP_ERR);
+  }
+
+  /* Write the header followed by the state */
+
+  cvStateHeader(cv_mem, hdr);
+
+  ok = cvStateIO(fp, hdr, sizeof(int), STATE_NHDR, SUNTRUE) &&
+       cvStateTransfer(cv_mem, fp, SUNTRUE);
+
+  if (!ok)
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_STATE_WRITE);
+    return (CV_ILL_INPUT);
+  }
+
+  return (CV_SUCCESS);
+}
+
+/*
+ * CVodeReadState
+ *
+ * CVodeReadState restores a state written by CVodeWriteState. The
+ * CVODES memory must have been created with the same method, maximum
+ * order, number of root functions, quadrature and sensitivity setup,
+ * and vector layout, and must have its tolerances and solvers
+ * attached. The next call to CVode then
+ * continues from the saved internal time with the saved step size,
+ * order, and history. Since the linear solver memory (e.g., a saved
+ * Jacobian) is not part of the state, a linear solver setup with a
+ * fresh Jacobian is done at the next step. If reading fails, the
+ * CVODE memory must be re-initialized before it is used again.
+ */
+
+int CVodeReadState(void* cvode_mem, FILE* fp)
+{
+  CVodeMem cv_mem;
+  int hdr[STATE_NHDR], hdr_in[STATE_NHDR];
+  int i, ier;
+  sunindextype bufsize;
+  sunbooleantype ok;
+
+  /* Check cvode_mem */
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+  cv_mem = (CVodeMem)cvode_mem;
+
+  SUNDIALS_MARK_FUNCTION_BEGIN(CV_PROFILER);
+
+  if (cv_mem->cv_MallocDone == SUNFALSE)
+  {
+    cvProcessError(cv_mem, CV_NO_MALLOC, __LINE__, __func__, __FILE__,
+                   MSGCV_NO_MALLOC);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_NO_MALLOC);
+  }
+
+  if (fp == NULL)
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_NULL_FP);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_ILL_INPUT);
+  }
+
+  if (N_VBufSize(cv_mem->cv_zn[0], &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    cvProcessError(cv_mem, CV_VECTOROP_ERR, __LINE__, __func__, __FILE__,
+                   MSGCV_BAD_NVECTOR);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_VECTOROP_ERR);
+  }
+
+  /* Check that the stream matches this integrator */
+
+  if (!cvStateIO(fp, hdr_in, sizeof(int), STATE_NHDR, SUNFALSE))
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_STATE_READ);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_ILL_INPUT);
+  }
+
+  cvStateHeader(cv_mem, hdr);
+
+  ok = SUNTRUE;
+  for (i = 0; i < STATE_NHDR; i++) { ok = ok && (hdr_in[i] == hdr[i]); }
+
+  if (!ok)
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_STATE_BAD);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_ILL_INPUT);
+  }
+
+  /* Read the state */
+
+  ok = cvStateTransfer(cv_mem, fp, SUNFALSE);
+
+  if (!ok)
+  {
+    cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                   MSGCV_STATE_READ);
+    SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+    return (CV_ILL_INPUT);
+  }
+
+  /* Redo the setup normally done on the first call to CVode and force
+     a linear solver setup (and Jacobian evaluation) at the next step */
+
+  if (cv_mem->cv_nst > 0)
+  {
+    ier = cvInitialSetup(cv_mem);
+    if (ier != CV_SUCCESS)
+    {
+      SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+      return (ier);
+    }
+    cv_mem->cv_nstlp = cv_mem->cv_nst - cv_mem->cv_msbp;
+  }
+
+  SUNDIALS_MARK_FUNCTION_END(CV_PROFILER);
+  return (CV_SUCCESS);
+}
+
+/*-----------------------------------------------------------------*/
+
 /*
  * CVodeSStolerances
  * CVodeSVtolerances
@@ -4463,6 +4717,7 @@ void CVodeSensFree(void* cvode_mem)
       cv_mem->cv_nnfS1      = NULL;
       cv_mem->cv_stgr1alloc = SUNFALSE;
     }
+    cvSensDQThreadsFree(cv_mem);
     cvSensFreeVectors(cv_mem);
     cv_mem->cv_SensMallocDone = SUNFALSE;
     cv_mem->cv_sensi          = SUNFALSE;
@@ -5092,6 +5347,14 @@ static void cvQuadSensFreeVectors(CVodeMem cv_mem)
 
   maxord = cv_mem->cv_qmax_allocQS;
 
+  if (cv_mem->cv_DQtmpQth != NULL)
+  {
+    N_VDestroyVectorArray(cv_mem->cv_DQtmpQth, cv_mem->cv_DQnthreads - 1);
+    cv_mem->cv_DQtmpQth = NULL;
+    cv_mem->cv_lrw -= (cv_mem->cv_DQnthreads - 1) * cv_mem->cv_lrw1Q;
+    cv_mem->cv_liw -= (cv_mem->cv_DQnthreads - 1) * cv_mem->cv_liw1Q;
+  }
+
   N_VDestroy(cv_mem->cv_ftempQ);
 
   N_VDestroyVectorArray(cv_mem->cv_yQS, cv_mem->cv_Ns);
@@ -5392,6 +5655,267 @@ static int cvInitialSetup(CVodeMem cv_mem)
   return (CV_SUCCESS);
 }
 
+/*
+ * -----------------------------------------------------------------
+ * State serialization
+ * -----------------------------------------------------------------
+ */
+
+/*
+ * cvStateHeader
+ *
+ * This routine fills the header of a state stream. A stream can only
+ * be read by an integrator producing the same header.
+ */
+
+static void cvStateHeader(CVodeMem cv_mem, int hdr[])
+{
+  hdr[0]  = STATE_ID;
+  hdr[1]  = STATE_VERSION;
+  hdr[2]  = (int)sizeof(sunrealtype);
+  hdr[3]  = (int)sizeof(long int);
+  hdr[4]  = (int)sizeof(sunindextype);
+  hdr[5]  = cv_mem->cv_lmm;
+  hdr[6]  = cv_mem->cv_qmax;
+  hdr[7]  = cv_mem->cv_nrtfn;
+  hdr[8]  = cv_mem->cv_quadr;
+  hdr[9]  = cv_mem->cv_sensi;
+  hdr[10] = cv_mem->cv_sensi ? cv_mem->cv_Ns : 0;
+  hdr[11] = cv_mem->cv_sensi ? cv_mem->cv_ism : 0;
+  hdr[12] = cv_mem->cv_quadr_sensi;
+}
+
+/*
+ * cvStateIO
+ *
+ * This routine writes (save = SUNTRUE) or reads (save = SUNFALSE) n
+ * items of the given size and returns SUNFALSE on a short transfer.
+ */
+
+static sunbooleantype cvStateIO(FILE* fp, void* data, size_t size, size_t n,
+                                sunbooleantype save)
+{
+  if (n == 0) { return (SUNTRUE); }
+  if (save) { return (fwrite(data, size, n, fp) == n); }
+  return (fread(data, size, n, fp) == n);
+}
+
+/*
+ * cvStateVectors
+ *
+ * This routine writes or reads the n vectors v with the N_Vector
+ * buffer operations. The buffer size is written first and checked on
+ * reading, so a stream from a different vector layout is rejected.
+ */
+
+static sunbooleantype cvStateVectors(FILE* fp, N_Vector* v, int n,
+                                     sunbooleantype save)
+{
+  sunindextype bufsize, bufsize_in;
+  void* buf;
+  int j;
+  sunbooleantype ok;
+
+  if (N_VBufSize(v[0], &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    return (SUNFALSE);
+  }
+
+  bufsize_in = bufsize;
+  if (!cvStateIO(fp, &bufsize_in, sizeof(sunindextype), 1, save) ||
+      (bufsize_in != bufsize))
+  {
+    return (SUNFALSE);
+  }
+
+  buf = malloc(bufsize);
+  if (buf == NULL) { return (SUNFALSE); }
+
+  ok = SUNTRUE;
+  for (j = 0; ok && j < n; j++)
+  {
+    if (save) { ok = (N_VBufPack(v[j], buf) == SUN_SUCCESS); }
+    ok = ok && cvStateIO(fp, buf, 1, (size_t)bufsize, save);
+    if (!save) { ok = ok && (N_VBufUnpack(v[j], buf) == SUN_SUCCESS); }
+  }
+
+  free(buf);
+
+  return (ok);
+}
+
+/*
+ * cvStateTransfer
+ *
+ * This routine writes or reads the integrator state in a fixed order,
+ * so the same code defines the stream layout in both directions.
+ */
+
+#define STATE_IO(x, n)                                      \
+  if (!cvStateIO(fp, (x), sizeof(*(x)), (size_t)(n), save)) \
+  {                                                         \
+    return (SUNFALSE);                                      \
+  }
+
+static sunbooleantype cvStateTransfer(CVodeMem cv_mem, FILE* fp,
+                                      sunbooleantype save)
+{
+  int j;
+  N_Vector vecs[L_MAX + 1];
+
+  /* Step data */
+
+  STATE_IO(&cv_mem->cv_tn, 1);
+  STATE_IO(&cv_mem->cv_tretlast, 1);
+  STATE_IO(&cv_mem->cv_h, 1);
+  STATE_IO(&cv_mem->cv_hprime, 1);
+  STATE_IO(&cv_mem->cv_next_h, 1);
+  STATE_IO(&cv_mem->cv_eta, 1);
+  STATE_IO(&cv_mem->cv_hscale, 1);
+  STATE_IO(&cv_mem->cv_etamax, 1);
+  STATE_IO(&cv_mem->cv_etaqm1, 1);
+  STATE_IO(&cv_mem->cv_etaq, 1);
+  STATE_IO(&cv_mem->cv_etaqp1, 1);
+  STATE_IO(cv_mem->cv_tau, L_MAX + 1);
+  STATE_IO(cv_mem->cv_tq, NUM_TESTS + 1);
+  STATE_IO(cv_mem->cv_l, L_MAX);
+  STATE_IO(&cv_mem->cv_rl1, 1);
+  STATE_IO(&cv_mem->cv_gamma, 1);
+  STATE_IO(&cv_mem->cv_gammap, 1);
+  STATE_IO(&cv_mem->cv_gamrat, 1);
+  STATE_IO(&cv_mem->cv_crate, 1);
+  STATE_IO(&cv_mem->cv_delp, 1);
+  STATE_IO(&cv_mem->cv_acnrm, 1);
+  STATE_IO(&cv_mem->cv_acnrmcur, 1);
+  STATE_IO(&cv_mem->cv_crateS, 1);
+  STATE_IO(&cv_mem->cv_acnrmQ, 1);
+  STATE_IO(&cv_mem->cv_acnrmS, 1);
+  STATE_IO(&cv_mem->cv_acnrmScur, 1);
+  STATE_IO(&cv_mem->cv_acnrmQS, 1);
+  STATE_IO(&cv_mem->cv_q, 1);
+  STATE_IO(&cv_mem->cv_qprime, 1);
+  STATE_IO(&cv_mem->cv_next_q, 1);
+  STATE_IO(&cv_mem->cv_qwait, 1);
+  STATE_IO(&cv_mem->cv_L, 1);
+
+  /* Saved values */
+
+  STATE_IO(&cv_mem->cv_qu, 1);
+  STATE_IO(&cv_mem->cv_h0u, 1);
+  STATE_IO(&cv_mem->cv_hu, 1);
+  STATE_IO(&cv_mem->cv_saved_tq5, 1);
+  STATE_IO(&cv_mem->cv_tolsf, 1);
+  STATE_IO(&cv_mem->cv_indx_acor, 1);
+
+  /* Counters */
+
+  STATE_IO(&cv_mem->cv_nst, 1);
+  STATE_IO(&cv_mem->cv_nfe, 1);
+  STATE_IO(&cv_mem->cv_ncfn, 1);
+  STATE_IO(&cv_mem->cv_nni, 1);
+  STATE_IO(&cv_mem->cv_nnf, 1);
+  STATE_IO(&cv_mem->cv_netf, 1);
+  STATE_IO(&cv_mem->cv_nsetups, 1);
+  STATE_IO(&cv_mem->cv_nhnil, 1);
+  STATE_IO(&cv_mem->cv_nstlp, 1);
+  STATE_IO(&cv_mem->cv_nfQe, 1);
+  STATE_IO(&cv_mem->cv_nfSe, 1);
+  STATE_IO(&cv_mem->cv_nfeS, 1);
+  STATE_IO(&cv_mem->cv_nfQSe, 1);
+  STATE_IO(&cv_mem->cv_nfQeS, 1);
+  STATE_IO(&cv_mem->cv_ncfnS, 1);
+  STATE_IO(&cv_mem->cv_nniS, 1);
+  STATE_IO(&cv_mem->cv_nnfS, 1);
+  STATE_IO(&cv_mem->cv_netfQ, 1);
+  STATE_IO(&cv_mem->cv_netfS, 1);
+  STATE_IO(&cv_mem->cv_netfQS, 1);
+  STATE_IO(&cv_mem->cv_nsetupsS, 1);
+
+  if (cv_mem->cv_sensi && cv_mem->cv_stgr1alloc)
+  {
+    STATE_IO(cv_mem->cv_ncfnS1, cv_mem->cv_Ns);
+    STATE_IO(cv_mem->cv_nniS1, cv_mem->cv_Ns);
+    STATE_IO(cv_mem->cv_nnfS1, cv_mem->cv_Ns);
+  }
+
+  /* Stability limit detection data */
+
+  STATE_IO(&cv_mem->cv_ssdat[0][0], 6 * 4);
+  STATE_IO(&cv_mem->cv_nscon, 1);
+  STATE_IO(&cv_mem->cv_nor, 1);
+
+  /* Rootfinding data */
+
+  if (cv_mem->cv_nrtfn > 0)
+  {
+    STATE_IO(&cv_mem->cv_tlo, 1);
+    STATE_IO(&cv_mem->cv_thi, 1);
+    STATE_IO(&cv_mem->cv_trout, 1);
+    STATE_IO(&cv_mem->cv_irfnd, 1);
+    STATE_IO(&cv_mem->cv_nge, 1);
+    STATE_IO(cv_mem->cv_glo, cv_mem->cv_nrtfn);
+    STATE_IO(cv_mem->cv_ghi, cv_mem->cv_nrtfn);
+    STATE_IO(cv_mem->cv_grout, cv_mem->cv_nrtfn);
+    STATE_IO(cv_mem->cv_iroots, cv_mem->cv_nrtfn);
+    STATE_IO(cv_mem->cv_gactive, cv_mem->cv_nrtfn);
+  }
+
+  /* Nordsieck arrays and the last corrections */
+
+  for (j = 0; j <= cv_mem->cv_qmax; j++) { vecs[j] = cv_mem->cv_zn[j]; }
+  vecs[cv_mem->cv_qmax + 1] = cv_mem->cv_acor;
+
+  if (!cvStateVectors(fp, vecs, cv_mem->cv_qmax + 2, save))
+  {
+    return (SUNFALSE);
+  }
+
+  if (cv_mem->cv_quadr)
+  {
+    for (j = 0; j <= cv_mem->cv_qmax; j++) { vecs[j] = cv_mem->cv_znQ[j]; }
+    vecs[cv_mem->cv_qmax + 1] = cv_mem->cv_acorQ;
+
+    if (!cvStateVectors(fp, vecs, cv_mem->cv_qmax + 2, save))
+    {
+      return (SUNFALSE);
+    }
+  }
+
+  if (cv_mem->cv_sensi)
+  {
+    for (j = 0; j <= cv_mem->cv_qmax; j++)
+    {
+      if (!cvStateVectors(fp, cv_mem->cv_znS[j], cv_mem->cv_Ns, save))
+      {
+        return (SUNFALSE);
+      }
+    }
+    if (!cvStateVectors(fp, cv_mem->cv_acorS, cv_mem->cv_Ns, save))
+    {
+      return (SUNFALSE);
+    }
+  }
+
+  if (cv_mem->cv_quadr_sensi)
+  {
+    for (j = 0; j <= cv_mem->cv_qmax; j++)
+    {
+      if (!cvStateVectors(fp, cv_mem->cv_znQS[j], cv_mem->cv_Ns, save))
+      {
+        return (SUNFALSE);
+      }
+    }
+    if (!cvStateVectors(fp, cv_mem->cv_acorQS, cv_mem->cv_Ns, save))
+    {
+      return (SUNFALSE);
+    }
+  }
+
+  return (SUNTRUE);
+}
+
+#undef STATE_IO
+
 /*
  * -----------------------------------------------------------------
  * Initial stepsize calculation
@@ -9591,15 +10115,25 @@ int cvSensRhs1Wrapper(CVodeMem cv_mem, sunrealtype time, N_Vector ycur,
  * cvSensRhsInternalDQ   - internal CVSensRhsFn
  *
  * cvSensRhsInternalDQ computes right hand side of all sensitivity equations
- * by finite differences
+ * by finite differences. If more than one thread was requested with
+ * CVodeSetSensDQThreads, the work is done in cvSensRhsThreadedDQ.
  */
 
 int cvSensRhsInternalDQ(int Ns, sunrealtype t, N_Vector y, N_Vector ydot,
                         N_Vector* yS, N_Vector* ySdot, void* cvode_mem,
                         N_Vector ytemp, N_Vector ftemp)
 {
+  CVodeMem cv_mem;
   int is, retval;
 
+  /* cvode_mem is passed here as user data */
+  cv_mem = (CVodeMem)cvode_mem;
+
+  if (cv_mem->cv_DQnthreads > 1)
+  {
+    return (cvSensRhsThreadedDQ(cv_mem, Ns, t, y, ydot, yS, ySdot, ytemp, ftemp));
+  }
+
   for (is = 0; is < Ns; is++)
   {
     retval = cvSensRhs1InternalDQ(Ns, t, y, ydot, is, yS[is], ySdot[is],
@@ -9625,8 +10159,110 @@ int cvSensRhs1InternalDQ(SUNDIALS_MAYBE_UNUSED int Ns, sunrealtype t, N_Vector y
                          void* cvode_mem, N_Vector ytemp, N_Vector ftemp)
 {
   CVodeMem cv_mem;
+  int retval, nfel = 0;
+
+  /* cvode_mem is passed here as user data */
+  cv_mem = (CVodeMem)cvode_mem;
+
+  retval = cvSensRhs1DQ(cv_mem, t, y, ydot, is, yS, ySdot, cv_mem->cv_p,
+                        cv_mem->cv_user_data, ytemp, ftemp, &nfel);
+  if (retval != 0) { return (retval); }
+
+  /* Increment counter nfeS */
+  cv_mem->cv_nfeS += nfel;
+
+  return (0);
+}
+
+/*
+ * cvSensRhsThreadedDQ
+ *
+ * cvSensRhsThreadedDQ computes the right hand side of all sensitivity
+ * equations by finite differences, distributing the sensitivities over
+ * cv_DQnthreads OpenMP threads. Thread k perturbs its own copy of the
+ * parameters, cv_DQpth[k], passes cv_DQudatath[k] to f, and uses its own
+ * pair of work vectors (thread 0 uses ytemp and ftemp). The counter nfeS is
+ * accumulated with a reduction and updated once all threads are done.
+ *
+ * If CVODES was built without OpenMP the loop runs serially on the
+ * buffers of thread 0.
+ *
+ * cvSensRhsThreadedDQ returns 0 if successful. Otherwise it returns the
+ * non-zero return value from f(), preferring an unrecoverable (negative)
+ * value if the calls on different threads failed differently.
+ */
+
+static int cvSensRhsThreadedDQ(CVodeMem cv_mem, int Ns, sunrealtype t,
+                               N_Vector y, N_Vector ydot, N_Vector* yS,
+                               N_Vector* ySdot, N_Vector ytemp, N_Vector ftemp)
+{
+  int is, retval;
+  long int nfeS;
+
+  cvSensDQThreadsSyncParams(cv_mem);
+
+  retval = 0;
+  nfeS   = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(cv_mem->cv_DQnthreads) schedule(dynamic) \
+  reduction(+ : nfeS)
+#endif
+  for (is = 0; is < Ns; is++)
+  {
+    int tid = 0, nfel = 0, ier;
+    N_Vector tmp1 = ytemp, tmp2 = ftemp;
+
+#ifdef _OPENMP
+    tid = omp_get_thread_num();
+#endif
+    if (tid > 0)
+    {
+      tmp1 = cv_mem->cv_DQtmpth[2 * (tid - 1)];
+      tmp2 = cv_mem->cv_DQtmpth[2 * (tid - 1) + 1];
+    }
+
+    ier = cvSensRhs1DQ(cv_mem, t, y, ydot, is, yS[is], ySdot[is],
+                       cv_mem->cv_DQpth[tid], cv_mem->cv_DQudatath[tid], tmp1,
+                       tmp2, &nfel);
+    nfeS += nfel;
+
+    if (ier != 0)
+    {
+#ifdef _OPENMP
+#pragma omp critical(cvSensRhsThreadedDQ)
+#endif
+      {
+        if ((retval == 0) || (ier < 0 && retval > 0)) { retval = ier; }
+      }
+    }
+  }
+
+  /* Increment counter nfeS */
+  cv_mem->cv_nfeS += nfeS;
+
+  return (retval);
+}
+
+/*
+ * cvSensRhs1DQ
+ *
+ * cvSensRhs1DQ does the actual work of cvSensRhs1InternalDQ. The parameter
+ * array p is perturbed in place (and restored on success) and user_data is
+ * passed to f. The number of f evaluations is added to nfel.
+ *
+ * If a directional derivative function was supplied with CVodeSetRhsDirFn,
+ * the term (df/dy) yS is computed exactly and only df/dp is approximated by
+ * (centered or forward) differences in p.
+ */
+
+static int cvSensRhs1DQ(CVodeMem cv_mem, sunrealtype t, N_Vector y,
+                        N_Vector ydot, int is, N_Vector yS, N_Vector ySdot,
+                        sunrealtype* p, void* user_data, N_Vector ytemp,
+                        N_Vector ftemp, int* nfel)
+{
   int retval, method;
-  int nfel = 0, which;
+  int which;
   sunrealtype psave, pbari;
   sunrealtype delta, rdelta;
   sunrealtype Deltap, rDeltap, r2Deltap;
@@ -9638,9 +10274,6 @@ int cvSensRhs1InternalDQ(SUNDIALS_MAYBE_UNUSED int Ns, sunrealtype t, N_Vector y
   sunrealtype cvals[3];
   N_Vector Xvecs[3];
 
-  /* cvode_mem is passed here as user data */
-  cv_mem = (CVodeMem)cvode_mem;
-
   delta  = SUNRsqrt(SUNMAX(cv_mem->cv_reltol, cv_mem->cv_uround));
   rdelta = ONE / delta;
 
@@ -9648,7 +10281,7 @@ int cvSensRhs1InternalDQ(SUNDIALS_MAYBE_UNUSED int Ns, sunrealtype t, N_Vector y
 
   which = cv_mem->cv_plist[is];
 
-  psave = cv_mem->cv_p[which];
+  psave = p[which];
 
   Deltap  = pbari * delta;
   rDeltap = ONE / Deltap;
@@ -9656,6 +10289,59 @@ int cvSensRhs1InternalDQ(SUNDIALS_MAYBE_UNUSED int Ns, sunrealtype t, N_Vector y
   rDeltay = SUNMAX(norms, rdelta) / pbari;
   Deltay  = ONE / rDeltay;
 
+  if (cv_mem->cv_fdir != NULL)
+  {
+    /* (df/dy) yS from the directional derivative function, df/dp by DQ */
+    retval = cv_mem->cv_fdir(t, y, yS, ftemp, ySdot, user_data);
+    (*nfel)++;
+    if (retval != 0) { return (retval); }
+
+    if (cv_mem->cv_DQtype == CV_CENTERED)
+    {
+      r2Deltap = HALF / Deltap;
+
+      p[which] = psave + Deltap;
+      retval   = cv_mem->cv_f(t, y, ytemp, user_data);
+      (*nfel)++;
+      if (retval != 0) { return (retval); }
+
+      p[which] = psave - Deltap;
+      retval   = cv_mem->cv_f(t, y, ftemp, user_data);
+      (*nfel)++;
+      if (retval != 0) { return (retval); }
+
+      /* ySdot = ySdot + r2Deltap * ytemp - r2Deltap * ftemp */
+      cvals[0] = ONE;
+      Xvecs[0] = ySdot;
+      cvals[1] = r2Deltap;
+      Xvecs[1] = ytemp;
+      cvals[2] = -r2Deltap;
+      Xvecs[2] = ftemp;
+    }
+    else
+    {
+      p[which] = psave + Deltap;
+      retval   = cv_mem->cv_f(t, y, ytemp, user_data);
+      (*nfel)++;
+      if (retval != 0) { return (retval); }
+
+      /* ySdot = ySdot + rDeltap * ytemp - rDeltap * ydot */
+      cvals[0] = ONE;
+      Xvecs[0] = ySdot;
+      cvals[1] = rDeltap;
+      Xvecs[1] = ytemp;
+      cvals[2] = -rDeltap;
+      Xvecs[2] = ydot;
+    }
+
+    p[which] = psave;
+
+    retval = N_VLinearCombination(3, cvals, Xvecs, ySdot);
+    if (retval != CV_SUCCESS) { return (CV_VECTOROP_ERR); }
+
+    return (0);
+  }
+
   if (cv_mem->cv_DQrhomax == ZERO)
   {
     /* No switching */
@@ -9680,17 +10366,17 @@ int cvSensRhs1InternalDQ(SUNDIALS_MAYBE_UNUSED int Ns, sunrealtype t, N_Vector y
     r2Delta = HALF / Delta;
 
     N_VLinearSum(ONE, y, Delta, yS, ytemp);
-    cv_mem->cv_p[which] = psave + Delta;
+    p[which] = psave + Delta;
 
-    retval = cv_mem->cv_f(t, ytemp, ySdot, cv_mem->cv_user_data);
-    nfel++;
+    retval = cv_mem->cv_f(t, ytemp, ySdot, user_data);
+    (*nfel)++;
     if (retval != 0) { return (retval); }
 
     N_VLinearSum(ONE, y, -Delta, yS, ytemp);
-    cv_mem->cv_p[which] = psave - Delta;
+    p[which] = psave - Delta;
 
-    retval = cv_mem->cv_f(t, ytemp, ftemp, cv_mem->cv_user_data);
-    nfel++;
+    retval = cv_mem->cv_f(t, ytemp, ftemp, user_data);
+    (*nfel)++;
     if (retval != 0) { return (retval); }
 
     N_VLinearSum(r2Delta, ySdot, -r2Delta, ftemp, ySdot);
@@ -9704,26 +10390,26 @@ int cvSensRhs1InternalDQ(SUNDIALS_MAYBE_UNUSED int Ns, sunrealtype t, N_Vector y
 
     N_VLinearSum(ONE, y, Deltay, yS, ytemp);
 
-    retval = cv_mem->cv_f(t, ytemp, ySdot, cv_mem->cv_user_data);
-    nfel++;
+    retval = cv_mem->cv_f(t, ytemp, ySdot, user_data);
+    (*nfel)++;
     if (retval != 0) { return (retval); }
 
     N_VLinearSum(ONE, y, -Deltay, yS, ytemp);
 
-    retval = cv_mem->cv_f(t, ytemp, ftemp, cv_mem->cv_user_data);
-    nfel++;
+    retval = cv_mem->cv_f(t, ytemp, ftemp, user_data);
+    (*nfel)++;
     if (retval != 0) { return (retval); }
 
     N_VLinearSum(r2Deltay, ySdot, -r2Deltay, ftemp, ySdot);
 
-    cv_mem->cv_p[which] = psave + Deltap;
-    retval              = cv_mem->cv_f(t, y, ytemp, cv_mem->cv_user_data);
-    nfel++;
+    p[which] = psave + Deltap;
+    retval   = cv_mem->cv_f(t, y, ytemp, user_data);
+    (*nfel)++;
     if (retval != 0) { return (retval); }
 
-    cv_mem->cv_p[which] = psave - Deltap;
-    retval              = cv_mem->cv_f(t, y, ftemp, cv_mem->cv_user_data);
-    nfel++;
+    p[which] = psave - Deltap;
+    retval   = cv_mem->cv_f(t, y, ftemp, user_data);
+    (*nfel)++;
     if (retval != 0) { return (retval); }
 
     /* ySdot = ySdot + r2Deltap * ytemp - r2Deltap * ftemp */
@@ -9745,10 +10431,10 @@ int cvSensRhs1InternalDQ(SUNDIALS_MAYBE_UNUSED int Ns, sunrealtype t, N_Vector y
     rDelta = ONE / Delta;
 
     N_VLinearSum(ONE, y, Delta, yS, ytemp);
-    cv_mem->cv_p[which] = psave + Delta;
+    p[which] = psave + Delta;
 
-    retval = cv_mem->cv_f(t, ytemp, ySdot, cv_mem->cv_user_data);
-    nfel++;
+    retval = cv_mem->cv_f(t, ytemp, ySdot, user_data);
+    (*nfel)++;
     if (retval != 0) { return (retval); }
 
     N_VLinearSum(rDelta, ySdot, -rDelta, ydot, ySdot);
@@ -9759,15 +10445,15 @@ int cvSensRhs1InternalDQ(SUNDIALS_MAYBE_UNUSED int Ns, sunrealtype t, N_Vector y
 
     N_VLinearSum(ONE, y, Deltay, yS, ytemp);
 
-    retval = cv_mem->cv_f(t, ytemp, ySdot, cv_mem->cv_user_data);
-    nfel++;
+    retval = cv_mem->cv_f(t, ytemp, ySdot, user_data);
+    (*nfel)++;
     if (retval != 0) { return (retval); }
 
     N_VLinearSum(rDeltay, ySdot, -rDeltay, ydot, ySdot);
 
-    cv_mem->cv_p[which] = psave + Deltap;
-    retval              = cv_mem->cv_f(t, y, ytemp, cv_mem->cv_user_data);
-    nfel++;
+    p[which] = psave + Deltap;
+    retval   = cv_mem->cv_f(t, y, ytemp, user_data);
+    (*nfel)++;
     if (retval != 0) { return (retval); }
 
     /* ySdot = ySdot + rDeltap * ytemp - rDeltap * ydot */
@@ -9784,10 +10470,7 @@ int cvSensRhs1InternalDQ(SUNDIALS_MAYBE_UNUSED int Ns, sunrealtype t, N_Vector y
     break;
   }
 
-  cv_mem->cv_p[which] = psave;
-
-  /* Increment counter nfeS */
-  cv_mem->cv_nfeS += nfel;
+  p[which] = psave;
 
   return (0);
 }
@@ -9797,7 +10480,8 @@ int cvSensRhs1InternalDQ(SUNDIALS_MAYBE_UNUSED int Ns, sunrealtype t, N_Vector y
  *
  * cvQuadSensRhsInternalDQ computes right hand side of all quadrature
  * sensitivity equations by finite differences. All work is actually
- * done in cvQuadSensRhs1InternalDQ.
+ * done in cvQuadSensRhs1InternalDQ (or in cvQuadSensRhsThreadedDQ if more
+ * than one thread was requested with CVodeSetSensDQThreads).
  */
 
 static int cvQuadSensRhsInternalDQ(int Ns, sunrealtype t, N_Vector y,
@@ -9810,6 +10494,12 @@ static int cvQuadSensRhsInternalDQ(int Ns, sunrealtype t, N_Vector y,
   /* cvode_mem is passed here as user data */
   cv_mem = (CVodeMem)cvode_mem;
 
+  if (cv_mem->cv_DQnthreads > 1)
+  {
+    return (cvQuadSensRhsThreadedDQ(cv_mem, Ns, t, y, yS, yQdot, yQSdot, tmp,
+                                    tmpQ));
+  }
+
   for (is = 0; is < Ns; is++)
   {
     retval = cvQuadSensRhs1InternalDQ(cv_mem, is, t, y, yS[is], yQdot,
@@ -9823,9 +10513,101 @@ static int cvQuadSensRhsInternalDQ(int Ns, sunrealtype t, N_Vector y,
 static int cvQuadSensRhs1InternalDQ(CVodeMem cv_mem, int is, sunrealtype t,
                                     N_Vector y, N_Vector yS, N_Vector yQdot,
                                     N_Vector yQSdot, N_Vector tmp, N_Vector tmpQ)
+{
+  int retval, nfel = 0;
+
+  retval = cvQuadSensRhs1DQ(cv_mem, is, t, y, yS, yQdot, yQSdot, cv_mem->cv_p,
+                            cv_mem->cv_user_data, tmp, tmpQ, &nfel);
+  if (retval != 0) { return (retval); }
+
+  /* Increment counter nfQeS */
+  cv_mem->cv_nfQeS += nfel;
+
+  return (0);
+}
+
+/*
+ * cvQuadSensRhsThreadedDQ
+ *
+ * Threaded version of the quadrature sensitivity DQ loop, see
+ * cvSensRhsThreadedDQ. The quadrature-sized work vectors of the extra
+ * threads are allocated on first use.
+ */
+
+static int cvQuadSensRhsThreadedDQ(CVodeMem cv_mem, int Ns, sunrealtype t,
+                                   N_Vector y, N_Vector* yS, N_Vector yQdot,
+                                   N_Vector* yQSdot, N_Vector tmp, N_Vector tmpQ)
+{
+  int is, retval;
+  long int nfQeS;
+
+  if (cv_mem->cv_DQtmpQth == NULL)
+  {
+    cv_mem->cv_DQtmpQth = N_VCloneVectorArray(cv_mem->cv_DQnthreads - 1, tmpQ);
+    if (cv_mem->cv_DQtmpQth == NULL) { return (CV_MEM_FAIL); }
+    cv_mem->cv_lrw += (cv_mem->cv_DQnthreads - 1) * cv_mem->cv_lrw1Q;
+    cv_mem->cv_liw += (cv_mem->cv_DQnthreads - 1) * cv_mem->cv_liw1Q;
+  }
+
+  cvSensDQThreadsSyncParams(cv_mem);
+
+  retval = 0;
+  nfQeS  = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(cv_mem->cv_DQnthreads) schedule(dynamic) \
+  reduction(+ : nfQeS)
+#endif
+  for (is = 0; is < Ns; is++)
+  {
+    int tid = 0, nfel = 0, ier;
+    N_Vector tmp1 = tmp, tmp2 = tmpQ;
+
+#ifdef _OPENMP
+    tid = omp_get_thread_num();
+#endif
+    if (tid > 0)
+    {
+      tmp1 = cv_mem->cv_DQtmpth[2 * (tid - 1)];
+      tmp2 = cv_mem->cv_DQtmpQth[tid - 1];
+    }
+
+    ier = cvQuadSensRhs1DQ(cv_mem, is, t, y, yS[is], yQdot, yQSdot[is],
+                           cv_mem->cv_DQpth[tid], cv_mem->cv_DQudatath[tid],
+                           tmp1, tmp2, &nfel);
+    nfQeS += nfel;
+
+    if (ier != 0)
+    {
+#ifdef _OPENMP
+#pragma omp critical(cvQuadSensRhsThreadedDQ)
+#endif
+      {
+        if ((retval == 0) || (ier < 0 && retval > 0)) { retval = ier; }
+      }
+    }
+  }
+
+  /* Increment counter nfQeS */
+  cv_mem->cv_nfQeS += nfQeS;
+
+  return (retval);
+}
+
+/*
+ * cvQuadSensRhs1DQ
+ *
+ * cvQuadSensRhs1DQ does the actual work of cvQuadSensRhs1InternalDQ, see
+ * cvSensRhs1DQ.
+ */
+
+static int cvQuadSensRhs1DQ(CVodeMem cv_mem, int is, sunrealtype t,
+                            N_Vector y, N_Vector yS, N_Vector yQdot,
+                            N_Vector yQSdot, sunrealtype* p, void* user_data,
+                            N_Vector tmp, N_Vector tmpQ, int* nfel)
 {
   int retval, method;
-  int nfel = 0, which;
+  int which;
   sunrealtype psave, pbari;
   sunrealtype delta, rdelta;
   sunrealtype Deltap;
@@ -9840,7 +10622,7 @@ static int cvQuadSensRhs1InternalDQ(CVodeMem cv_mem, int is, sunrealtype t,
 
   which = cv_mem->cv_plist[is];
 
-  psave = cv_mem->cv_p[which];
+  psave = p[which];
 
   Deltap  = pbari * delta;
   norms   = N_VWrmsNorm(yS, cv_mem->cv_ewt) * pbari;
@@ -9857,17 +10639,17 @@ static int cvQuadSensRhs1InternalDQ(CVodeMem cv_mem, int is, sunrealtype t,
     r2Delta = HALF / Delta;
 
     N_VLinearSum(ONE, y, Delta, yS, tmp);
-    cv_mem->cv_p[which] = psave + Delta;
+    p[which] = psave + Delta;
 
-    retval = cv_mem->cv_fQ(t, tmp, yQSdot, cv_mem->cv_user_data);
-    nfel++;
+    retval = cv_mem->cv_fQ(t, tmp, yQSdot, user_data);
+    (*nfel)++;
     if (retval != 0) { return (retval); }
 
     N_VLinearSum(ONE, y, -Delta, yS, tmp);
-    cv_mem->cv_p[which] = psave - Delta;
+    p[which] = psave - Delta;
 
-    retval = cv_mem->cv_fQ(t, tmp, tmpQ, cv_mem->cv_user_data);
-    nfel++;
+    retval = cv_mem->cv_fQ(t, tmp, tmpQ, user_data);
+    (*nfel)++;
     if (retval != 0) { return (retval); }
 
     N_VLinearSum(r2Delta, yQSdot, -r2Delta, tmpQ, yQSdot);
@@ -9880,10 +10662,10 @@ static int cvQuadSensRhs1InternalDQ(CVodeMem cv_mem, int is, sunrealtype t,
     rDelta = ONE / Delta;
 
     N_VLinearSum(ONE, y, Delta, yS, tmp);
-    cv_mem->cv_p[which] = psave + Delta;
+    p[which] = psave + Delta;
 
-    retval = cv_mem->cv_fQ(t, tmp, yQSdot, cv_mem->cv_user_data);
-    nfel++;
+    retval = cv_mem->cv_fQ(t, tmp, yQSdot, user_data);
+    (*nfel)++;
     if (retval != 0) { return (retval); }
 
     N_VLinearSum(rDelta, yQSdot, -rDelta, yQdot, yQSdot);
@@ -9891,14 +10673,68 @@ static int cvQuadSensRhs1InternalDQ(CVodeMem cv_mem, int is, sunrealtype t,
     break;
   }
 
-  cv_mem->cv_p[which] = psave;
-
-  /* Increment counter nfQeS */
-  cv_mem->cv_nfQeS += nfel;
+  p[which] = psave;
 
   return (0);
 }
 
+/*
+ * cvSensDQThreadsSyncParams
+ *
+ * Copies the current values of the sensitivity parameters into the
+ * per-thread parameter arrays before a threaded DQ evaluation.
+ */
+
+static void cvSensDQThreadsSyncParams(CVodeMem cv_mem)
+{
+  int k, is, which;
+
+  for (k = 0; k < cv_mem->cv_DQnthreads; k++)
+  {
+    for (is = 0; is < cv_mem->cv_Ns; is++)
+    {
+      which                      = cv_mem->cv_plist[is];
+      cv_mem->cv_DQpth[k][which] = cv_mem->cv_p[which];
+    }
+  }
+}
+
+/*
+ * cvSensDQThreadsFree
+ *
+ * Frees the memory allocated for the threaded DQ sensitivity RHS and
+ * resets the number of threads to one.
+ */
+
+void cvSensDQThreadsFree(CVodeMem cv_mem)
+{
+  int nextra;
+
+  nextra = cv_mem->cv_DQnthreads - 1;
+
+  if (cv_mem->cv_DQtmpth != NULL)
+  {
+    N_VDestroyVectorArray(cv_mem->cv_DQtmpth, 2 * nextra);
+    cv_mem->cv_DQtmpth = NULL;
+    cv_mem->cv_lrw -= 2 * nextra * cv_mem->cv_lrw1;
+    cv_mem->cv_liw -= 2 * nextra * cv_mem->cv_liw1;
+  }
+  if (cv_mem->cv_DQtmpQth != NULL)
+  {
+    N_VDestroyVectorArray(cv_mem->cv_DQtmpQth, nextra);
+    cv_mem->cv_DQtmpQth = NULL;
+    cv_mem->cv_lrw -= nextra * cv_mem->cv_lrw1Q;
+    cv_mem->cv_liw -= nextra * cv_mem->cv_liw1Q;
+  }
+
+  free(cv_mem->cv_DQpth);
+  cv_mem->cv_DQpth = NULL;
+  free(cv_mem->cv_DQudatath);
+  cv_mem->cv_DQudatath = NULL;
+
+  cv_mem->cv_DQnthreads = 1;
+}
+
 /*
  * -----------------------------------------------------------------
  * Error message handling functions
@@ -124,6 +124,8 @@ int CVDiag(void* cvode_mem)
   lsolve = CVDiagSolve;
   lfree  = CVDiagFree;
 
+  cv_mem->cv_lsolvemulti = NULL;
+
   /* Get memory for CVDiagMemRec */
   cvdiag_mem = NULL;
   cvdiag_mem = (CVDiagMem)malloc(sizeof(CVDiagMemRec));
@@ -240,6 +240,7 @@ typedef struct CVodeMemRec
     --------------------------*/
 
   CVRhsFn cv_f;       /* y' = f(t,y(t))                                */
+  CVRhsDirFn cv_fdir; /* f(t,y) and (df/dy) v together (optional)      */
   void* cv_user_data; /* user pointer passed to f                      */
   int cv_lmm;         /* lmm = CV_ADAMS or CV_BDF                      */
   int cv_itol;        /* itol = CV_SS, CV_SV, CV_WF, CV_NN             */
@@ -293,6 +294,12 @@ typedef struct CVodeMemRec
   int cv_DQtype;           /* central/forward finite differences           */
   sunrealtype cv_DQrhomax; /* cut-off value for separate/simultaneous FD   */
 
+  int cv_DQnthreads;      /* number of threads used by the DQ sensi. RHS   */
+  sunrealtype** cv_DQpth; /* per-thread copies of p perturbed by DQ RHS    */
+  void** cv_DQudatath;    /* per-thread user data passed to f and fQ       */
+  N_Vector* cv_DQtmpth;   /* per-thread work vectors (2 per extra thread)  */
+  N_Vector* cv_DQtmpQth;  /* per-thread quadrature work vectors            */
+
   sunbooleantype cv_errconS; /* SUNTRUE if yS are considered in err. control */
 
   int cv_itolS;
@@ -574,6 +581,9 @@ typedef struct CVodeMemRec
   int (*cv_lsolve)(struct CVodeMemRec* cv_mem, N_Vector b, N_Vector weight,
                    N_Vector ycur, N_Vector fcur);
 
+  int (*cv_lsolvemulti)(struct CVodeMemRec* cv_mem, int nrhs, N_Vector* b,
+                        N_Vector ycur, N_Vector fcur);
+
   int (*cv_lfree)(struct CVodeMemRec* cv_mem);
 
   /* Linear Solver specific memory */
@@ -1102,6 +1112,19 @@ struct CVadjMemRec
  * -----------------------------------------------------------------
  */
 
+/*
+ * -----------------------------------------------------------------
+ * int (*cv_lsolvemulti)(CVodeMem cv_mem, int nrhs, N_Vector* b,
+ *                       N_Vector ycur, N_Vector fcur);
+ * -----------------------------------------------------------------
+ * cv_lsolvemulti is optional. When non-NULL it must solve the
+ * nrhs linear equations P x_i = b_i, with P as in cv_lsolve,
+ * returning each solution in b_i. It is used for the sensitivity
+ * corrections, which all share the same P. The return values
+ * are the same as for cv_lsolve.
+ * -----------------------------------------------------------------
+ */
+
 /*
  * -----------------------------------------------------------------
  * int (*cv_lfree)(CVodeMem cv_mem);
@@ -1182,6 +1205,8 @@ int cvSensRhs1InternalDQ(int Ns, sunrealtype t, N_Vector y, N_Vector ydot,
                          int is, N_Vector yS, N_Vector ySdot, void* fS_data,
                          N_Vector tempv, N_Vector ftemp);
 
+void cvSensDQThreadsFree(CVodeMem cv_mem);
+
 /*
  * =================================================================
  *    E R R O R    M E S S A G E S
@@ -1247,6 +1272,11 @@ int cvSensRhs1InternalDQ(int Ns, sunrealtype t, N_Vector y, N_Vector ydot,
 #define MSGCV_BAD_T         "Illegal value for t." MSG_TIME_INT
 #define MSGCV_NO_ROOT       "Rootfinding was not initialized."
 #define MSGCV_NLS_INIT_FAIL "The nonlinear solver's init routine failed."
+#define MSGCV_NULL_FP       "fp = NULL illegal."
+#define MSGCV_STATE_WRITE   "Writing the integrator state failed."
+#define MSGCV_STATE_READ    "Reading the integrator state failed."
+#define MSGCV_STATE_BAD \
+  "The saved state is not compatible with this integrator."
 
 #define MSGCV_NO_QUAD "Quadrature integration not activated."
 #define MSGCV_BAD_ITOLQ \
@@ -1277,6 +1307,8 @@ int cvSensRhs1InternalDQ(int Ns, sunrealtype t, N_Vector y, N_Vector ydot,
 #define MSGCV_BAD_DQTYPE \
   "Illegal value for DQtype. Legal values are: CV_CENTERED and CV_FORWARD."
 #define MSGCV_BAD_DQRHO "DQrhomax < 0 illegal."
+#define MSGCV_NULL_DQTH \
+  "p_th and user_data_th must be non-NULL when nthreads > 1."
 
 #define MSGCV_BAD_ITOLQS \
   "Illegal value for itolQS. The legal values are CV_SS, CV_SV, and CV_EE."
@@ -81,6 +81,32 @@ int CVodeSetUserData(void* cvode_mem, void* user_data)
   return (CV_SUCCESS);
 }
 
+/*
+ * CVodeSetRhsDirFn
+ *
+ * Specifies the user function that evaluates f together with a
+ * directional derivative (df/dy) v. It replaces the difference
+ * quotient Jacobian-vector products and the Jacobian part
+ * of the difference quotient sensitivity right-hand sides.
+ */
+
+int CVodeSetRhsDirFn(void* cvode_mem, CVRhsDirFn fdir)
+{
+  CVodeMem cv_mem;
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+
+  cv_mem = (CVodeMem)cvode_mem;
+
+  cv_mem->cv_fdir = fdir;
+
+  return (CV_SUCCESS);
+}
+
 /*
  * CVodeSetMonitorFn
  *
@@ -1076,6 +1102,93 @@ int CVodeSetSensDQMethod(void* cvode_mem, int DQtype, sunrealtype DQrhomax)
 
 /*-----------------------------------------------------------------*/
 
+int CVodeSetSensDQThreads(void* cvode_mem, int nthreads, sunrealtype** p_th,
+                          void** user_data_th)
+{
+  CVodeMem cv_mem;
+  int k;
+
+  if (cvode_mem == NULL)
+  {
+    cvProcessError(NULL, CV_MEM_NULL, __LINE__, __func__, __FILE__, MSGCV_NO_MEM);
+    return (CV_MEM_NULL);
+  }
+
+  cv_mem = (CVodeMem)cvode_mem;
+
+  /* Was sensitivity initialized? */
+
+  if (cv_mem->cv_SensMallocDone == SUNFALSE)
+  {
+    cvProcessError(cv_mem, CV_NO_SENS, __LINE__, __func__, __FILE__,
+                   MSGCV_NO_SENSI);
+    return (CV_NO_SENS);
+  }
+
+  if (nthreads > 1)
+  {
+    if ((p_th == NULL) || (user_data_th == NULL))
+    {
+      cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                     MSGCV_NULL_DQTH);
+      return (CV_ILL_INPUT);
+    }
+    for (k = 0; k < nthreads; k++)
+    {
+      if (p_th[k] == NULL)
+      {
+        cvProcessError(cv_mem, CV_ILL_INPUT, __LINE__, __func__, __FILE__,
+                       MSGCV_NULL_DQTH);
+        return (CV_ILL_INPUT);
+      }
+    }
+  }
+
+  /* Free any previous per-thread data */
+
+  cvSensDQThreadsFree(cv_mem);
+
+  if (nthreads <= 1) { return (CV_SUCCESS); }
+
+  /* Copy the per-thread parameter and user data pointers */
+
+  cv_mem->cv_DQpth     = (sunrealtype**)malloc(nthreads * sizeof(sunrealtype*));
+  cv_mem->cv_DQudatath = (void**)malloc(nthreads * sizeof(void*));
+  if ((cv_mem->cv_DQpth == NULL) || (cv_mem->cv_DQudatath == NULL))
+  {
+    cvSensDQThreadsFree(cv_mem);
+    cvProcessError(cv_mem, CV_MEM_FAIL, __LINE__, __func__, __FILE__,
+                   MSGCV_MEM_FAIL);
+    return (CV_MEM_FAIL);
+  }
+
+  for (k = 0; k < nthreads; k++)
+  {
+    cv_mem->cv_DQpth[k]     = p_th[k];
+    cv_mem->cv_DQudatath[k] = user_data_th[k];
+  }
+
+  /* Allocate two work vectors for each thread but the first one, which
+     uses the work vectors passed to the DQ routines */
+
+  cv_mem->cv_DQtmpth = N_VCloneVectorArray(2 * (nthreads - 1), cv_mem->cv_tempv);
+  if (cv_mem->cv_DQtmpth == NULL)
+  {
+    cvSensDQThreadsFree(cv_mem);
+    cvProcessError(cv_mem, CV_MEM_FAIL, __LINE__, __func__, __FILE__,
+                   MSGCV_MEM_FAIL);
+    return (CV_MEM_FAIL);
+  }
+
+  cv_mem->cv_DQnthreads = nthreads;
+  cv_mem->cv_lrw += 2 * (nthreads - 1) * cv_mem->cv_lrw1;
+  cv_mem->cv_liw += 2 * (nthreads - 1) * cv_mem->cv_liw1;
+
+  return (CV_SUCCESS);
+}
+
+/*-----------------------------------------------------------------*/
+
 int CVodeSetSensErrCon(void* cvode_mem, sunbooleantype errconS)
 {
   CVodeMem cv_mem;
@@ -223,6 +223,14 @@ int CVodeSetLinearSolver(void* cvode_mem, SUNLinearSolver LS, SUNMatrix A)
   cv_mem->cv_lsolve = cvLsSolve;
   cv_mem->cv_lfree  = cvLsFree;
 
+  /* Direct solvers that support multiple right-hand sides can solve all
+     sensitivity systems with one pass over the factorization */
+  if (!iterative && (LS->ops->solvemulti != NULL))
+  {
+    cv_mem->cv_lsolvemulti = cvLsSolveMulti;
+  }
+  else { cv_mem->cv_lsolvemulti = NULL; }
+
   /* Allocate memory for CVLsMemRec */
   cvls_mem = NULL;
   cvls_mem = (CVLsMem)malloc(sizeof(struct CVLsMemRec));
@@ -1336,7 +1344,9 @@ int cvLsBandDQJac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix Jac,
   This routine generates a difference quotient approximation to
   the Jacobian times vector f_y(t,y) * v. The approximation is
   Jv = [f(y + v*sig) - f(y)]/sig, where sig = 1 / ||v||_WRMS,
-  i.e. the WRMS norm of v*sig is 1.
+  i.e. the WRMS norm of v*sig is 1. If the user supplied a
+  directional derivative function with CVodeSetRhsDirFn (and no
+  alternative jtimesRhsFn), the exact product is returned instead.
   -----------------------------------------------------------------*/
 int cvLsDQJtimes(N_Vector v, N_Vector Jv, sunrealtype t, N_Vector y,
                  N_Vector fy, void* cvode_mem, N_Vector work)
@@ -1350,6 +1360,15 @@ int cvLsDQJtimes(N_Vector v, N_Vector Jv, sunrealtype t, N_Vector y,
   retval = cvLs_AccessLMem(cvode_mem, __func__, &cv_mem, &cvls_mem);
   if (retval != CVLS_SUCCESS) { return (retval); }
 
+  /* Compute Jv with the directional derivative function (work = f) */
+  if ((cv_mem->cv_fdir != NULL) && (cvls_mem->jt_f == cv_mem->cv_f))
+  {
+    retval = cv_mem->cv_fdir(t, y, v, work, Jv, cv_mem->cv_user_data);
+    if (retval < 0) { return (-1); }
+    if (retval > 0) { return (+1); }
+    return (0);
+  }
+
   /* Initialize perturbation to 1/||v|| */
   sig = ONE / N_VWrmsNorm(v, cv_mem->cv_ewt);
 
@@ -1922,6 +1941,68 @@ int cvLsSolve(CVodeMem cv_mem, N_Vector b, N_Vector weight, N_Vector ynow,
   return (0);
 }
 
+/*-----------------------------------------------------------------
+  cvLsSolveMulti
+
+  This routine interfaces between CVode and the generic
+  SUNLinSolSolveMulti routine to solve several linear systems that
+  share the same matrix, e.g., the sensitivity corrections. It is
+  only attached for direct linear solvers, so no tolerance, scaling
+  vectors, or initial guess are needed and the solutions overwrite
+  the right-hand sides.
+  -----------------------------------------------------------------*/
+int cvLsSolveMulti(CVodeMem cv_mem, int nrhs, N_Vector* b, N_Vector ynow,
+                   N_Vector fnow)
+{
+  CVLsMem cvls_mem;
+  int i, retval;
+
+  /* access CVLsMem structure */
+  if (cv_mem->cv_lmem == NULL)
+  {
+    cvProcessError(cv_mem, CVLS_LMEM_NULL, __LINE__, __func__, __FILE__,
+                   MSG_LS_LMEM_NULL);
+    return (CVLS_LMEM_NULL);
+  }
+  cvls_mem = (CVLsMem)cv_mem->cv_lmem;
+
+  /* Set vectors ycur and fcur for use by the linear solver */
+  cvls_mem->ycur = ynow;
+  cvls_mem->fcur = fnow;
+
+  /* Call solver, solutions overwrite the right-hand sides */
+  retval = SUNLinSolSolveMulti(cvls_mem->LS, cvls_mem->A, b, b, nrhs, ZERO);
+
+  /* If using a BDF method and gamma has changed, scale the corrections to
+     account for change in gamma */
+  if (cvls_mem->scalesol && cv_mem->cv_gamrat != ONE)
+  {
+    for (i = 0; i < nrhs; i++)
+    {
+      N_VScale(TWO / (ONE + cv_mem->cv_gamrat), b[i], b[i]);
+    }
+  }
+
+  /* Increment counters and interpret solver return value */
+  if (retval != SUN_SUCCESS) { cvls_mem->ncfl++; }
+  cvls_mem->last_flag = retval;
+
+  switch (retval)
+  {
+  case SUN_SUCCESS: return (0); break;
+  case SUNLS_PACKAGE_FAIL_REC:
+  case SUNLS_LUFACT_FAIL: return (1); break;
+  case SUN_ERR_EXT_FAIL:
+    cvProcessError(cv_mem, SUN_ERR_EXT_FAIL, __LINE__, __func__, __FILE__,
+                   "Failure in SUNLinSol external package");
+    return (-1);
+    break;
+  default: return (retval > 0) ? 1 : -1; break;
+  }
+
+  return (0);
+}
+
 /*-----------------------------------------------------------------
   cvLsFree
 
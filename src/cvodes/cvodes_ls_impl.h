@@ -162,6 +162,8 @@ int cvLsSetup(CVodeMem cv_mem, int convfail, N_Vector ypred, N_Vector fpred,
               N_Vector vtemp3);
 int cvLsSolve(CVodeMem cv_mem, N_Vector b, N_Vector weight, N_Vector ycur,
               N_Vector fcur);
+int cvLsSolveMulti(CVodeMem cv_mem, int nrhs, N_Vector* b, N_Vector ycur,
+                   N_Vector fcur);
 int cvLsFree(CVodeMem cv_mem);
 
 /* Auxilliary functions */
@@ -290,7 +290,19 @@ static int cvNlsLSolveSensStg(N_Vector deltaStg, void* cvode_mem)
   /* extract sensitivity deltas from the vector wrapper */
   deltaS = NV_VECS_SW(deltaStg);
 
-  /* solve the sensitivity linear systems */
+  /* solve the sensitivity linear systems with a single multiple right-hand
+     side solve when supported by the linear solver */
+  if (cv_mem->cv_lsolvemulti)
+  {
+    retval = cv_mem->cv_lsolvemulti(cv_mem, cv_mem->cv_Ns, deltaS,
+                                    cv_mem->cv_y, cv_mem->cv_ftemp);
+
+    if (retval < 0) { return (CV_LSOLVE_FAIL); }
+    if (retval > 0) { return (SUN_NLS_CONV_RECVR); }
+
+    return (CV_SUCCESS);
+  }
+
   for (is = 0; is < cv_mem->cv_Ns; is++)
   {
     retval = cv_mem->cv_lsolve(cv_mem, deltaS[is], cv_mem->cv_ewtS[is],
@@ -90,6 +90,7 @@
 
 #include "ida_impl.h"
 #include "sundials/priv/sundials_errors_impl.h"
+#include "sundials_utils.h"
 
 /*
  * =================================================================
@@ -179,6 +180,17 @@
 #define MAXNI    10 /* max. Newton iterations in IC calc. */
 #define EPCON    SUN_RCONST(0.33) /* Newton convergence test constant */
 #define MAXBACKS 100 /* max backtracks per Newton step in IDACalcIC */
+#define COSTWT   SUN_RCONST(0.25) /* weight of the latest step in the setup
+                                     cost model's smoothed cost per step */
+
+/*
+ * State stream constants
+ * ----------------------
+ */
+
+#define STATE_ID      0x49444153 /* identifies an IDA state stream */
+#define STATE_VERSION 1          /* layout version of the stream   */
+#define STATE_NHDR    7          /* number of int header entries   */
 
 /*
  * =================================================================
@@ -197,6 +209,16 @@ static void IDAFreeVectors(IDAMem IDA_mem);
 
 int IDAInitialSetup(IDAMem IDA_mem);
 
+/* State serialization */
+
+static void IDAStateHeader(IDAMem IDA_mem, int hdr[]);
+static sunbooleantype IDAStateIO(FILE* fp, void* data, size_t size, size_t n,
+                                 sunbooleantype save);
+static sunbooleantype IDAStateVectors(FILE* fp, N_Vector* v, int n,
+                                      sunbooleantype save);
+static sunbooleantype IDAStateTransfer(IDAMem IDA_mem, FILE* fp,
+                                       sunbooleantype save);
+
 static int IDAEwtSetSS(IDAMem IDA_mem, N_Vector ycur, N_Vector weight);
 static int IDAEwtSetSV(IDAMem IDA_mem, N_Vector ycur, N_Vector weight);
 
@@ -212,6 +234,7 @@ static void IDASetCoeffs(IDAMem IDA_mem, sunrealtype* ck);
 
 static void IDAPredict(IDAMem IDA_mem);
 static int IDANls(IDAMem IDA_mem);
+static sunbooleantype IDACostModelSetup(IDAMem IDA_mem);
 
 /* Error test */
 
@@ -302,7 +325,10 @@ void* IDACreate(SUNContext sunctx)
 
   /* Set default values for integrator optional inputs */
   IDA_mem->ida_res            = NULL;
+  IDA_mem->ida_resdir         = NULL;
   IDA_mem->ida_user_data      = NULL;
+  IDA_mem->ida_outputfn       = NULL;
+  IDA_mem->ida_output_data    = NULL;
   IDA_mem->ida_itol           = IDA_NN;
   IDA_mem->ida_atolmin0       = SUNTRUE;
   IDA_mem->ida_user_efun      = SUNFALSE;
@@ -329,6 +355,7 @@ void* IDACreate(SUNContext sunctx)
   IDA_mem->ida_constraintsSet = SUNFALSE;
   IDA_mem->ida_tstopset       = SUNFALSE;
   IDA_mem->ida_dcj            = DCJ_DEFAULT;
+  IDA_mem->ida_costmodel      = SUNFALSE;
 
   /* set the saved value maxord_alloc */
   IDA_mem->ida_maxord_alloc = MAXORD_DEFAULT;
@@ -501,6 +528,10 @@ int IDAInit(void* ida_mem, IDAResFn res, sunrealtype t0, N_Vector yy0,
   IDA_mem->ida_lfree  = NULL;
   IDA_mem->ida_lmem   = NULL;
 
+  /* Set forceSetup to SUNFALSE */
+
+  IDA_mem->ida_forceSetup = SUNFALSE;
+
   /* Initialize all the counters and other optional output values */
 
   IDA_mem->ida_nst     = 0;
@@ -511,6 +542,15 @@ int IDAInit(void* ida_mem, IDAResFn res, sunrealtype t0, N_Vector yy0,
   IDA_mem->ida_nnf     = 0;
   IDA_mem->ida_nsetups = 0;
 
+  IDA_mem->ida_tjac     = ZERO;
+  IDA_mem->ida_tjaclast = ZERO;
+  IDA_mem->ida_tnls     = ZERO;
+  IDA_mem->ida_tnls_lj  = ZERO;
+  IDA_mem->ida_tnls_ls  = ZERO;
+  IDA_mem->ida_tstep    = ZERO;
+  IDA_mem->ida_nstlj    = 0;
+  IDA_mem->ida_nstls    = 0;
+
   IDA_mem->ida_kused = 0;
   IDA_mem->ida_hused = ZERO;
   IDA_mem->ida_tolsf = ONE;
@@ -609,6 +649,10 @@ int IDAReInit(void* ida_mem, sunrealtype t0, N_Vector yy0, N_Vector yp0)
 
   IDA_mem->ida_tn = t0;
 
+  /* Set forceSetup to SUNFALSE */
+
+  IDA_mem->ida_forceSetup = SUNFALSE;
+
   /* Initialize the phi array */
 
   N_VScale(ONE, yy0, IDA_mem->ida_phi[0]);
@@ -624,6 +668,15 @@ int IDAReInit(void* ida_mem, sunrealtype t0, N_Vector yy0, N_Vector yp0)
   IDA_mem->ida_nnf     = 0;
   IDA_mem->ida_nsetups = 0;
 
+  IDA_mem->ida_tjac     = ZERO;
+  IDA_mem->ida_tjaclast = ZERO;
+  IDA_mem->ida_tnls     = ZERO;
+  IDA_mem->ida_tnls_lj  = ZERO;
+  IDA_mem->ida_tnls_ls  = ZERO;
+  IDA_mem->ida_tstep    = ZERO;
+  IDA_mem->ida_nstlj    = 0;
+  IDA_mem->ida_nstls    = 0;
+
   IDA_mem->ida_kused = 0;
   IDA_mem->ida_hused = ZERO;
   IDA_mem->ida_tolsf = ONE;
@@ -644,6 +697,186 @@ int IDAReInit(void* ida_mem, sunrealtype t0, N_Vector yy0, N_Vector yp0)
 
 /*-----------------------------------------------------------------*/
 
+/*
+ * IDAWriteState
+ *
+ * IDAWriteState writes everything IDA needs to continue the
+ * integration from the current internal time to the binary stream fp:
+ * the step data, counters, divided difference array phi, and
+ * rootfinding data. Optional inputs, tolerances, and solver objects
+ * are not written; they are set up by the user before calling
+ * IDAReadState. The vectors are written with the N_Vector buffer
+ * operations, so the stream holds the local part of the state.
+ */
+
+int IDAWriteState(void* ida_mem, FILE* fp)
+{
+  IDAMem IDA_mem;
+  int hdr[STATE_NHDR];
+  sunindextype bufsize;
+  sunbooleantype ok;
+
+  /* Check ida_mem */
+
+  if (ida_mem == NULL)
+  {
+    IDAProcessError(NULL, IDA_MEM_NULL, __LINE__, __func__, __FILE__, MSG_NO_MEM);
+    return (IDA_MEM_NULL);
+  }
+  IDA_mem = (IDAMem)ida_mem;
+
+  if (IDA_mem->ida_MallocDone == SUNFALSE)
+  {
+    IDAProcessError(IDA_mem, IDA_NO_MALLOC, __LINE__, __func__, __FILE__,
+                    MSG_NO_MALLOC);
+    return (IDA_NO_MALLOC);
+  }
+
+  if (fp == NULL)
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_NULL_FP);
+    return (IDA_ILL_INPUT);
+  }
+
+  /* The vectors are serialized with the buffer operations */
+
+  if (N_VBufSize(IDA_mem->ida_phi[0], &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    IDAProcessError(IDA_mem, IDA_VECTOROP_ERR, __LINE__, __func__, __FILE__,
+                    MSG_BAD_NVECTOR);
+    return (IDA_VECTOROP_ERR);
+  }
+
+  /* Write the header followed by the state */
+
+  IDAStateHeader(IDA_mem, hdr);
+
+  ok = IDAStateIO(fp, hdr, sizeof(int), STATE_NHDR, SUNTRUE) &&
+       IDAStateTransfer(IDA_mem, fp, SUNTRUE);
+
+  if (!ok)
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_STATE_WRITE);
+    return (IDA_ILL_INPUT);
+  }
+
+  return (IDA_SUCCESS);
+}
+
+/*
+ * IDAReadState
+ *
+ * IDAReadState restores a state written by IDAWriteState. The IDA
+ * memory must have been created with the same maximum order, number
+ * of root functions, and vector layout, and must have its tolerances
+ * and solvers attached. The next call to IDASolve then continues from
+ * the saved internal time with the saved step size, order, and
+ * history. Since the linear solver memory is not part of the state, a
+ * linear solver setup is forced at the next step. If reading fails,
+ * the IDA memory must be re-initialized before it is used again.
+ */
+
+int IDAReadState(void* ida_mem, FILE* fp)
+{
+  IDAMem IDA_mem;
+  int hdr[STATE_NHDR], hdr_in[STATE_NHDR];
+  int i, ier;
+  sunindextype bufsize;
+  sunbooleantype ok;
+
+  /* Check ida_mem */
+
+  if (ida_mem == NULL)
+  {
+    IDAProcessError(NULL, IDA_MEM_NULL, __LINE__, __func__, __FILE__, MSG_NO_MEM);
+    return (IDA_MEM_NULL);
+  }
+  IDA_mem = (IDAMem)ida_mem;
+
+  SUNDIALS_MARK_FUNCTION_BEGIN(IDA_PROFILER);
+
+  if (IDA_mem->ida_MallocDone == SUNFALSE)
+  {
+    IDAProcessError(IDA_mem, IDA_NO_MALLOC, __LINE__, __func__, __FILE__,
+                    MSG_NO_MALLOC);
+    SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+    return (IDA_NO_MALLOC);
+  }
+
+  if (fp == NULL)
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_NULL_FP);
+    SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+    return (IDA_ILL_INPUT);
+  }
+
+  if (N_VBufSize(IDA_mem->ida_phi[0], &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    IDAProcessError(IDA_mem, IDA_VECTOROP_ERR, __LINE__, __func__, __FILE__,
+                    MSG_BAD_NVECTOR);
+    SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+    return (IDA_VECTOROP_ERR);
+  }
+
+  /* Check that the stream matches this integrator */
+
+  if (!IDAStateIO(fp, hdr_in, sizeof(int), STATE_NHDR, SUNFALSE))
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_STATE_READ);
+    SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+    return (IDA_ILL_INPUT);
+  }
+
+  IDAStateHeader(IDA_mem, hdr);
+
+  ok = SUNTRUE;
+  for (i = 0; i < STATE_NHDR; i++) { ok = ok && (hdr_in[i] == hdr[i]); }
+
+  if (!ok)
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_STATE_BAD);
+    SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+    return (IDA_ILL_INPUT);
+  }
+
+  /* Read the state */
+
+  ok = IDAStateTransfer(IDA_mem, fp, SUNFALSE);
+
+  if (!ok)
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_STATE_READ);
+    SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+    return (IDA_ILL_INPUT);
+  }
+
+  /* Redo the setup normally done on the first call to IDASolve and
+     force a linear solver setup at the next step */
+
+  if (IDA_mem->ida_nst > 0)
+  {
+    ier = IDAInitialSetup(IDA_mem);
+    if (ier != IDA_SUCCESS)
+    {
+      SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+      return (ier);
+    }
+    IDA_mem->ida_SetupDone  = SUNTRUE;
+    IDA_mem->ida_forceSetup = SUNTRUE;
+  }
+
+  SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+  return (IDA_SUCCESS);
+}
+
+/*-----------------------------------------------------------------*/
+
 /*
  * IDASStolerances
  * IDASVtolerances
@@ -1422,6 +1655,22 @@ int IDASolve(void* ida_mem, sunrealtype tout, sunrealtype* tret, N_Vector yret,
       }
     }
 
+    /* Pass the new solution to the output function. */
+    if (IDA_mem->ida_outputfn != NULL)
+    {
+      ier = IDA_mem->ida_outputfn(IDA_mem->ida_tn, IDA_mem->ida_phi[0],
+                                  IDA_mem->ida_output_data);
+      if (ier != 0)
+      {
+        IDAProcessError(IDA_mem, IDA_OUTPUTFUNC_FAIL, __LINE__, __func__,
+                        __FILE__, MSG_OUTPUTFUNC_FAILED, IDA_mem->ida_tn);
+        istate = IDA_OUTPUTFUNC_FAIL;
+        *tret = IDA_mem->ida_tretlast = IDA_mem->ida_tn;
+        ier   = IDAGetSolution(IDA_mem, IDA_mem->ida_tn, yret, ypret);
+        break;
+      }
+    }
+
     /* After successful step, check for stop conditions; continue or break. */
 
     /* First check for root in the last step taken. */
@@ -2069,6 +2318,173 @@ int IDAInitialSetup(IDAMem IDA_mem)
   return (IDA_SUCCESS);
 }
 
+/*
+ * -----------------------------------------------------------------
+ * State serialization
+ * -----------------------------------------------------------------
+ */
+
+/*
+ * IDAStateHeader
+ *
+ * This routine fills the header of a state stream. A stream can only
+ * be read by an integrator producing the same header.
+ */
+
+static void IDAStateHeader(IDAMem IDA_mem, int hdr[])
+{
+  hdr[0] = STATE_ID;
+  hdr[1] = STATE_VERSION;
+  hdr[2] = (int)sizeof(sunrealtype);
+  hdr[3] = (int)sizeof(long int);
+  hdr[4] = (int)sizeof(sunindextype);
+  hdr[5] = IDA_mem->ida_maxord;
+  hdr[6] = IDA_mem->ida_nrtfn;
+}
+
+/*
+ * IDAStateIO
+ *
+ * This routine writes (save = SUNTRUE) or reads (save = SUNFALSE) n
+ * items of the given size and returns SUNFALSE on a short transfer.
+ */
+
+static sunbooleantype IDAStateIO(FILE* fp, void* data, size_t size, size_t n,
+                                 sunbooleantype save)
+{
+  if (n == 0) { return (SUNTRUE); }
+  if (save) { return (fwrite(data, size, n, fp) == n); }
+  return (fread(data, size, n, fp) == n);
+}
+
+/*
+ * IDAStateVectors
+ *
+ * This routine writes or reads the n vectors v with the N_Vector
+ * buffer operations. The buffer size is written first and checked on
+ * reading, so a stream from a different vector layout is rejected.
+ */
+
+static sunbooleantype IDAStateVectors(FILE* fp, N_Vector* v, int n,
+                                      sunbooleantype save)
+{
+  sunindextype bufsize, bufsize_in;
+  void* buf;
+  int j;
+  sunbooleantype ok;
+
+  if (N_VBufSize(v[0], &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    return (SUNFALSE);
+  }
+
+  bufsize_in = bufsize;
+  if (!IDAStateIO(fp, &bufsize_in, sizeof(sunindextype), 1, save) ||
+      (bufsize_in != bufsize))
+  {
+    return (SUNFALSE);
+  }
+
+  buf = malloc(bufsize);
+  if (buf == NULL) { return (SUNFALSE); }
+
+  ok = SUNTRUE;
+  for (j = 0; ok && j < n; j++)
+  {
+    if (save) { ok = (N_VBufPack(v[j], buf) == SUN_SUCCESS); }
+    ok = ok && IDAStateIO(fp, buf, 1, (size_t)bufsize, save);
+    if (!save) { ok = ok && (N_VBufUnpack(v[j], buf) == SUN_SUCCESS); }
+  }
+
+  free(buf);
+
+  return (ok);
+}
+
+/*
+ * IDAStateTransfer
+ *
+ * This routine writes or reads the integrator state in a fixed order,
+ * so the same code defines the stream layout in both directions.
+ */
+
+#define STATE_IO(x, n)                                       \
+  if (!IDAStateIO(fp, (x), sizeof(*(x)), (size_t)(n), save)) \
+  {                                                          \
+    return (SUNFALSE);                                       \
+  }
+
+static sunbooleantype IDAStateTransfer(IDAMem IDA_mem, FILE* fp,
+                                       sunbooleantype save)
+{
+  int j, maxcol;
+  N_Vector vecs[MXORDP1 + 1];
+
+  /* Step data */
+
+  STATE_IO(&IDA_mem->ida_tn, 1);
+  STATE_IO(&IDA_mem->ida_tretlast, 1);
+  STATE_IO(&IDA_mem->ida_hh, 1);
+  STATE_IO(&IDA_mem->ida_hused, 1);
+  STATE_IO(&IDA_mem->ida_h0u, 1);
+  STATE_IO(&IDA_mem->ida_eta, 1);
+  STATE_IO(&IDA_mem->ida_cj, 1);
+  STATE_IO(&IDA_mem->ida_cjlast, 1);
+  STATE_IO(&IDA_mem->ida_cjold, 1);
+  STATE_IO(&IDA_mem->ida_cjratio, 1);
+  STATE_IO(&IDA_mem->ida_ss, 1);
+  STATE_IO(&IDA_mem->ida_oldnrm, 1);
+  STATE_IO(&IDA_mem->ida_epsNewt, 1);
+  STATE_IO(&IDA_mem->ida_toldel, 1);
+  STATE_IO(&IDA_mem->ida_tolsf, 1);
+  STATE_IO(IDA_mem->ida_psi, MXORDP1);
+  STATE_IO(IDA_mem->ida_alpha, MXORDP1);
+  STATE_IO(IDA_mem->ida_beta, MXORDP1);
+  STATE_IO(IDA_mem->ida_sigma, MXORDP1);
+  STATE_IO(IDA_mem->ida_gamma, MXORDP1);
+  STATE_IO(&IDA_mem->ida_kk, 1);
+  STATE_IO(&IDA_mem->ida_kused, 1);
+  STATE_IO(&IDA_mem->ida_knew, 1);
+  STATE_IO(&IDA_mem->ida_phase, 1);
+  STATE_IO(&IDA_mem->ida_ns, 1);
+
+  /* Counters */
+
+  STATE_IO(&IDA_mem->ida_nst, 1);
+  STATE_IO(&IDA_mem->ida_nre, 1);
+  STATE_IO(&IDA_mem->ida_ncfn, 1);
+  STATE_IO(&IDA_mem->ida_netf, 1);
+  STATE_IO(&IDA_mem->ida_nni, 1);
+  STATE_IO(&IDA_mem->ida_nnf, 1);
+  STATE_IO(&IDA_mem->ida_nsetups, 1);
+
+  /* Rootfinding data */
+
+  if (IDA_mem->ida_nrtfn > 0)
+  {
+    STATE_IO(&IDA_mem->ida_tlo, 1);
+    STATE_IO(&IDA_mem->ida_thi, 1);
+    STATE_IO(&IDA_mem->ida_trout, 1);
+    STATE_IO(&IDA_mem->ida_irfnd, 1);
+    STATE_IO(&IDA_mem->ida_nge, 1);
+    STATE_IO(IDA_mem->ida_glo, IDA_mem->ida_nrtfn);
+    STATE_IO(IDA_mem->ida_ghi, IDA_mem->ida_nrtfn);
+    STATE_IO(IDA_mem->ida_grout, IDA_mem->ida_nrtfn);
+    STATE_IO(IDA_mem->ida_iroots, IDA_mem->ida_nrtfn);
+    STATE_IO(IDA_mem->ida_gactive, IDA_mem->ida_nrtfn);
+  }
+
+  /* Divided difference array and the last correction */
+
+  maxcol = SUNMAX(IDA_mem->ida_maxord, 3);
+  for (j = 0; j <= maxcol; j++) { vecs[j] = IDA_mem->ida_phi[j]; }
+  vecs[maxcol + 1] = IDA_mem->ida_ee;
+
+  return (IDAStateVectors(fp, vecs, maxcol + 2, save));
+}
+
+#undef STATE_IO
+
 /*
  * IDAEwtSet
  *
@@ -2696,6 +3112,8 @@ static int IDANls(IDAMem IDA_mem)
   int retval;
   sunbooleantype constraintsPassed, callLSetup;
   sunrealtype temp1, temp2, vnorm;
+  double tstart    = 0.0;
+  sunrealtype tjac = ZERO;
   N_Vector mm, tmp;
   long int nni_inc = 0;
   long int nnf_inc = 0;
@@ -2722,6 +3140,11 @@ static int IDANls(IDAMem IDA_mem)
     {
       callLSetup = SUNTRUE;
     }
+    if (IDA_mem->ida_forceSetup) { callLSetup = SUNTRUE; }
+    if (IDA_mem->ida_costmodel && IDACostModelSetup(IDA_mem))
+    {
+      callLSetup = SUNTRUE;
+    }
     if (IDA_mem->ida_cj != IDA_mem->ida_cjlast) { IDA_mem->ida_ss = HUNDRED; }
   }
 
@@ -2736,11 +3159,24 @@ static int IDANls(IDAMem IDA_mem)
     if (retval > 0) { return (IDA_NLS_SETUP_RECVR); }
   }
 
-  /* solve the nonlinear system */
+  /* solve the nonlinear system (timing it for the setup cost model) */
+  if (IDA_mem->ida_costmodel)
+  {
+    tstart = sunWallClockTime();
+    tjac   = IDA_mem->ida_tjac;
+  }
+
   retval = SUNNonlinSolSolve(IDA_mem->NLS, IDA_mem->ida_yypredict,
                              IDA_mem->ida_ee, IDA_mem->ida_ewt,
                              IDA_mem->ida_epsNewt, callLSetup, IDA_mem);
 
+  if (IDA_mem->ida_costmodel)
+  {
+    /* exclude the time spent in lsetup, which is timed separately */
+    IDA_mem->ida_tnls += (sunrealtype)(sunWallClockTime() - tstart) -
+                         (IDA_mem->ida_tjac - tjac);
+  }
+
   /* increment counters */
   (void)SUNNonlinSolGetNumIters(IDA_mem->NLS, &nni_inc);
   IDA_mem->ida_nni += nni_inc;
@@ -2817,6 +3253,49 @@ static int IDANls(IDAMem IDA_mem)
   return (IDA_SUCCESS);
 }
 
+/*
+ * IDACostModelSetup
+ *
+ * This routine decides from the measured solver costs whether the linear
+ * solver setup should be called in addition to the cj ratio test. The
+ * nonlinear solver time per step of the steps since the last decision is
+ * compared to the average time per step since the last setup, which also
+ * includes the time of that setup. Once the former exceeds the latter, as
+ * the Newton iteration slows down with an aging Jacobian, a new setup
+ * reduces the average cost per step.
+ *
+ * The time per step is an exponential average (weight COSTWT on the latest
+ * value) that restarts at each setup, so a single slow step does not force
+ * a setup by itself. Since the decision depends on measured times, the step
+ * sequence is not reproducible from run to run when the cost model is used.
+ */
+
+static sunbooleantype IDACostModelSetup(IDAMem IDA_mem)
+{
+  sunrealtype tavg, tstep;
+  sunbooleantype setup = SUNFALSE;
+
+  if ((IDA_mem->ida_nst > IDA_mem->ida_nstls) &&
+      (IDA_mem->ida_nst > IDA_mem->ida_nstlj))
+  {
+    tavg = (IDA_mem->ida_tjaclast + IDA_mem->ida_tnls - IDA_mem->ida_tnls_lj) /
+           (sunrealtype)(IDA_mem->ida_nst - IDA_mem->ida_nstlj);
+    tstep = (IDA_mem->ida_tnls - IDA_mem->ida_tnls_ls) /
+            (sunrealtype)(IDA_mem->ida_nst - IDA_mem->ida_nstls);
+    if (IDA_mem->ida_tstep > ZERO)
+    {
+      tstep = COSTWT * tstep + (ONE - COSTWT) * IDA_mem->ida_tstep;
+    }
+    IDA_mem->ida_tstep = tstep;
+    setup              = (tstep > tavg);
+  }
+
+  IDA_mem->ida_tnls_ls = IDA_mem->ida_tnls;
+  IDA_mem->ida_nstls   = IDA_mem->ida_nst;
+
+  return (setup);
+}
+
 /*
  * IDAPredict
  *
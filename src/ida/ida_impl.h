@@ -102,8 +102,12 @@ typedef struct IDAMemRec
     Problem Specification Data
     --------------------------*/
 
-  IDAResFn ida_res;    /* F(t,y(t),y'(t))=0; the function F     */
-  void* ida_user_data; /* user pointer passed to res            */
+  IDAResFn ida_res;       /* F(t,y(t),y'(t))=0; the function F     */
+  IDAResDirFn ida_resdir; /* F and its directional derivative      */
+  void* ida_user_data;    /* user pointer passed to res            */
+
+  SUNOutputFn ida_outputfn; /* called with tn and y after each step  */
+  void* ida_output_data;    /* user pointer passed to outputfn       */
 
   int ida_itol;                 /* itol = IDA_SS, IDA_SV, IDA_WF, IDA_NN */
   sunrealtype ida_rtol;         /* relative tolerance                    */
@@ -296,6 +300,22 @@ typedef struct IDAMemRec
   sunrealtype ida_dcj; /* parameter that determines cj ratio thresholds for calling
                      * the linear solver setup function */
 
+  /* Flag to request a call to the setup routine */
+
+  sunbooleantype ida_forceSetup;
+
+  /* Setup cost model (see IDASetJacEvalCostModel) */
+
+  sunbooleantype ida_costmodel; /* time the nonlinear solver and lsetup calls */
+  sunrealtype ida_tjac;         /* time in lsetup calls                       */
+  sunrealtype ida_tjaclast;     /* time of the last lsetup call               */
+  sunrealtype ida_tnls;         /* time in nonlinear solves excluding lsetup  */
+  sunrealtype ida_tnls_lj;      /* tnls at the last lsetup call               */
+  sunrealtype ida_tnls_ls;      /* tnls at the last setup decision            */
+  sunrealtype ida_tstep;        /* smoothed nls time per step since lsetup    */
+  long int ida_nstlj;           /* nst at the last lsetup call                */
+  long int ida_nstls;           /* nst at the last setup decision             */
+
   /* Flag to indicate successful ida_linit call */
 
   sunbooleantype ida_linitOK;
@@ -514,6 +534,11 @@ int idaNlsInit(IDAMem IDA_mem);
 #define MSG_LSOLVE_NULL    "The linear solver's solve routine is NULL."
 #define MSG_LINIT_FAIL     "The linear solver's init routine failed."
 #define MSG_NLS_INIT_FAIL  "The nonlinear solver's init routine failed."
+#define MSG_NULL_FP        "fp = NULL illegal."
+#define MSG_STATE_WRITE    "Writing the integrator state failed."
+#define MSG_STATE_READ     "Reading the integrator state failed."
+#define MSG_STATE_BAD \
+  "The saved state is not compatible with this integrator."
 
 /* IDACalcIC error messages */
 
@@ -580,6 +605,8 @@ int idaNlsInit(IDAMem IDA_mem);
 #define MSG_RTFUNC_FAILED                                                \
   "At " MSG_TIME ", the rootfinding routine failed in an unrecoverable " \
   "manner."
+#define MSG_OUTPUTFUNC_FAILED \
+  "At " MSG_TIME "the output function failed in an unrecoverable manner."
 #define MSG_NO_ROOT "Rootfinding was not initialized."
 #define MSG_INACTIVE_ROOTS                                             \
   "At the end of the first step, there are still some root functions " \
@@ -74,6 +74,45 @@ int IDASetUserData(void* ida_mem, void* user_data)
 
 /*-----------------------------------------------------------------*/
 
+int IDASetResDirFn(void* ida_mem, IDAResDirFn resdir)
+{
+  IDAMem IDA_mem;
+
+  if (ida_mem == NULL)
+  {
+    IDAProcessError(NULL, IDA_MEM_NULL, __LINE__, __func__, __FILE__, MSG_NO_MEM);
+    return (IDA_MEM_NULL);
+  }
+
+  IDA_mem = (IDAMem)ida_mem;
+
+  IDA_mem->ida_resdir = resdir;
+
+  return (IDA_SUCCESS);
+}
+
+/*-----------------------------------------------------------------*/
+
+int IDASetOutputFn(void* ida_mem, SUNOutputFn fn, void* output_data)
+{
+  IDAMem IDA_mem;
+
+  if (ida_mem == NULL)
+  {
+    IDAProcessError(NULL, IDA_MEM_NULL, __LINE__, __func__, __FILE__, MSG_NO_MEM);
+    return (IDA_MEM_NULL);
+  }
+
+  IDA_mem = (IDAMem)ida_mem;
+
+  IDA_mem->ida_outputfn    = fn;
+  IDA_mem->ida_output_data = output_data;
+
+  return (IDA_SUCCESS);
+}
+
+/*-----------------------------------------------------------------*/
+
 int IDASetEtaFixedStepBounds(void* ida_mem, sunrealtype eta_min_fx,
                              sunrealtype eta_max_fx)
 {
@@ -1472,6 +1511,13 @@ int IDAPrintAllStats(void* ida_mem, FILE* outfile, SUNOutputFormat fmt)
         fprintf(outfile, "Prec evals per NLS iter      = %" RSYM "\n",
                 (sunrealtype)idals_mem->npe / (sunrealtype)IDA_mem->ida_nni);
       }
+      if (IDA_mem->ida_costmodel)
+      {
+        fprintf(outfile, "Jac setup time               = %" RSYM "\n",
+                IDA_mem->ida_tjac);
+        fprintf(outfile, "NLS iteration time           = %" RSYM "\n",
+                IDA_mem->ida_tnls);
+      }
     }
 
     /* rootfinding stats */
@@ -1534,6 +1580,11 @@ int IDAPrintAllStats(void* ida_mem, FILE* outfile, SUNOutputFormat fmt)
         fprintf(outfile, ",Jac evals per NLS iter,0");
         fprintf(outfile, ",Prec evals per NLS iter,0");
       }
+      if (IDA_mem->ida_costmodel)
+      {
+        fprintf(outfile, ",Jac setup time,%" RSYM, IDA_mem->ida_tjac);
+        fprintf(outfile, ",NLS iteration time,%" RSYM, IDA_mem->ida_tnls);
+      }
     }
 
     /* rootfinding stats */
@@ -1585,6 +1636,7 @@ char* IDAGetReturnFlagName(long int flag)
   case IDA_LINESEARCH_FAIL: sprintf(name, "IDA_LINESEARCH_FAIL"); break;
   case IDA_NLS_SETUP_FAIL: sprintf(name, "IDA_NLS_SETUP_FAIL"); break;
   case IDA_NLS_FAIL: sprintf(name, "IDA_NLS_FAIL"); break;
+  case IDA_OUTPUTFUNC_FAIL: sprintf(name, "IDA_OUTPUTFUNC_FAIL"); break;
   default: sprintf(name, "NONE");
   }
 
@@ -36,6 +36,10 @@
 #define ONE       SUN_RCONST(1.0)
 #define TWO       SUN_RCONST(2.0)
 
+/* private functions */
+static sunrealtype idaLsForcingTol(IDALsMem idals_mem, int curiter,
+                                   sunrealtype bnorm, sunrealtype tolmax);
+
 /*===============================================================
   IDALS Exported functions -- Required
   ===============================================================*/
@@ -205,6 +209,14 @@ int IDASetLinearSolver(void* ida_mem, SUNLinearSolver LS, SUNMatrix A)
   idals_mem->dqincfac  = ONE;
   idals_mem->last_flag = IDALS_SUCCESS;
 
+  /* The adaptive forcing term is disabled by default */
+  idals_mem->forcing = SUNFALSE;
+  idals_mem->fgamma  = IDALS_FGAMMA;
+  idals_mem->falpha  = IDALS_FALPHA;
+  idals_mem->frelax  = IDALS_FRELAX;
+  idals_mem->feta    = IDALS_FETA0;
+  idals_mem->fbnorm  = ZERO;
+
   /* If LS supports ATimes, attach IDALs routine */
   if (LS->ops->setatimes)
   {
@@ -379,6 +391,77 @@ int IDASetLSNormFactor(void* ida_mem, sunrealtype nrmfac)
   return (IDALS_SUCCESS);
 }
 
+/* IDASetLSForcing enables or disables the adaptive (Eisenstat-Walker)
+   forcing term for the iterative linear solver tolerance */
+int IDASetLSForcing(void* ida_mem, sunbooleantype adaptive)
+{
+  IDAMem IDA_mem;
+  IDALsMem idals_mem;
+  int retval;
+
+  /* access IDALsMem structure */
+  retval = idaLs_AccessLMem(ida_mem, __func__, &IDA_mem, &idals_mem);
+  if (retval != IDALS_SUCCESS) { return (retval); }
+
+  idals_mem->forcing = adaptive;
+  idals_mem->feta    = IDALS_FETA0;
+  idals_mem->fbnorm  = ZERO;
+
+  return (IDALS_SUCCESS);
+}
+
+/* IDASetLSForcingParams sets the parameters gamma and alpha of the adaptive
+   forcing term; non-positive values restore the defaults */
+int IDASetLSForcingParams(void* ida_mem, sunrealtype fgamma, sunrealtype falpha)
+{
+  IDAMem IDA_mem;
+  IDALsMem idals_mem;
+  int retval;
+
+  /* access IDALsMem structure */
+  retval = idaLs_AccessLMem(ida_mem, __func__, &IDA_mem, &idals_mem);
+  if (retval != IDALS_SUCCESS) { return (retval); }
+
+  /* Check for legal gamma and alpha */
+  if (fgamma > ONE || falpha > TWO || (falpha > ZERO && falpha <= ONE))
+  {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_LS_BAD_FORCING);
+    return (IDALS_ILL_INPUT);
+  }
+
+  idals_mem->fgamma = (fgamma <= ZERO) ? IDALS_FGAMMA : fgamma;
+  idals_mem->falpha = (falpha <= ZERO) ? IDALS_FALPHA : falpha;
+
+  return (IDALS_SUCCESS);
+}
+
+/* IDASetLSForcingMaxRelax sets the maximum factor by which the adaptive
+   forcing term relaxes the fixed linear solver tolerance; a non-positive
+   value restores the default */
+int IDASetLSForcingMaxRelax(void* ida_mem, sunrealtype frelax)
+{
+  IDAMem IDA_mem;
+  IDALsMem idals_mem;
+  int retval;
+
+  /* access IDALsMem structure */
+  retval = idaLs_AccessLMem(ida_mem, __func__, &IDA_mem, &idals_mem);
+  if (retval != IDALS_SUCCESS) { return (retval); }
+
+  /* Check for legal frelax */
+  if (frelax > ZERO && frelax < ONE)
+  {
+    IDAProcessError(IDA_mem, IDALS_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_LS_BAD_FRELAX);
+    return (IDALS_ILL_INPUT);
+  }
+
+  idals_mem->frelax = (frelax <= ZERO) ? IDALS_FRELAX : frelax;
+
+  return (IDALS_SUCCESS);
+}
+
 /* IDASetLinearSolutionScaling enables or disables scaling the linear solver
    solution to account for changes in cj. */
 int IDASetLinearSolutionScaling(void* ida_mem, sunbooleantype onoff)
@@ -424,6 +507,23 @@ int IDASetIncrementFactor(void* ida_mem, sunrealtype dqincfac)
   return (IDALS_SUCCESS);
 }
 
+/* IDASetJacEvalCostModel enables or disables additional linear solver
+   setups decided from the measured solver costs */
+int IDASetJacEvalCostModel(void* ida_mem, sunbooleantype onoff)
+{
+  IDAMem IDA_mem;
+  IDALsMem idals_mem;
+  int retval;
+
+  /* access IDALsMem structure; store input and return */
+  retval = idaLs_AccessLMem(ida_mem, __func__, &IDA_mem, &idals_mem);
+  if (retval != IDALS_SUCCESS) { return (retval); }
+
+  IDA_mem->ida_costmodel = onoff;
+
+  return (IDALS_SUCCESS);
+}
+
 /* IDASetPreconditioner specifies the user-supplied psetup and psolve routines */
 int IDASetPreconditioner(void* ida_mem, IDALsPrecSetupFn psetup,
                          IDALsPrecSolveFn psolve)
@@ -748,6 +848,23 @@ int IDAGetNumLinResEvals(void* ida_mem, long int* nrevalsLS)
   return (IDALS_SUCCESS);
 }
 
+/* IDAGetLinSolveTimes returns the times (in seconds) spent in linear
+   solver setups and in the nonlinear solver otherwise, as measured for
+   the cost model */
+int IDAGetLinSolveTimes(void* ida_mem, sunrealtype* tjac, sunrealtype* tnls)
+{
+  IDAMem IDA_mem;
+  IDALsMem idals_mem;
+  int retval;
+
+  /* access IDALsMem structure; store output and return */
+  retval = idaLs_AccessLMem(ida_mem, __func__, &IDA_mem, &idals_mem);
+  if (retval != IDALS_SUCCESS) { return (retval); }
+  *tjac = IDA_mem->ida_tjac;
+  *tnls = IDA_mem->ida_tnls;
+  return (IDALS_SUCCESS);
+}
+
 /* IDAGetLastLinFlag returns the last flag set in a IDALS function */
 int IDAGetLastLinFlag(void* ida_mem, long int* flag)
 {
@@ -1200,6 +1317,10 @@ int idaLsBandDQJac(sunrealtype tt, sunrealtype c_j, N_Vector yy, N_Vector yp,
        sigma = sqrt(Neq)*dqincfac.
   The return value from the call to res is saved in order to set
   the return flag from idaLsSolve.
+
+  If the user supplied a directional derivative function with
+  IDASetResDirFn (and no alternative jtimesResFn), the exact
+  product Jv = F_y v + cj F_y' v is returned instead.
   ---------------------------------------------------------------*/
 int idaLsDQJtimes(sunrealtype tt, N_Vector yy, N_Vector yp, N_Vector rr,
                   N_Vector v, N_Vector Jv, sunrealtype c_j, void* ida_mem,
@@ -1216,6 +1337,17 @@ int idaLsDQJtimes(sunrealtype tt, N_Vector yy, N_Vector yp, N_Vector rr,
   retval = idaLs_AccessLMem(ida_mem, __func__, &IDA_mem, &idals_mem);
   if (retval != IDALS_SUCCESS) { return (retval); }
 
+  /* Compute Jv with the directional derivative function (work1 = F) */
+  if ((IDA_mem->ida_resdir != NULL) && (idals_mem->jt_res == IDA_mem->ida_res))
+  {
+    N_VScale(c_j, v, work2);
+    retval = IDA_mem->ida_resdir(tt, yy, yp, v, work2, work1, Jv,
+                                 IDA_mem->ida_user_data);
+    if (retval < 0) { return (-1); }
+    if (retval > 0) { return (+1); }
+    return (0);
+  }
+
   LSID = SUNLinSolGetID(idals_mem->LS);
   if (LSID == SUNLINEARSOLVER_SPGMR || LSID == SUNLINEARSOLVER_SPFGMR)
   {
@@ -1421,6 +1553,39 @@ int idaLsSetup(IDAMem IDA_mem, N_Vector y, N_Vector yp, N_Vector r,
   return (idals_mem->last_flag);
 }
 
+/*---------------------------------------------------------------
+ idaLsForcingTol
+
+ This routine returns the adaptive linear solver tolerance
+ min(eta_k * ||b_k||, tolmax) (in the WRMS norm) for Newton
+ iteration k, with the Eisenstat-Walker forcing term (choice 2)
+
+   eta_k = gamma * (||b_k|| / ||b_{k-1}||)^alpha,
+
+ safeguarded by gamma * eta_{k-1}^alpha when that exceeds 0.1 and
+ bounded by IDALS_FETAMX. The first iteration uses IDALS_FETA0.
+---------------------------------------------------------------*/
+static sunrealtype idaLsForcingTol(IDALsMem idals_mem, int curiter,
+                                   sunrealtype bnorm, sunrealtype tolmax)
+{
+  sunrealtype eta, etasafe;
+
+  if (curiter == 0 || idals_mem->fbnorm <= ZERO) { eta = IDALS_FETA0; }
+  else
+  {
+    eta = idals_mem->fgamma *
+          SUNRpowerR(bnorm / idals_mem->fbnorm, idals_mem->falpha);
+    etasafe = idals_mem->fgamma * SUNRpowerR(idals_mem->feta, idals_mem->falpha);
+    if (etasafe > SUN_RCONST(0.1)) { eta = SUNMAX(eta, etasafe); }
+  }
+  eta = SUNMIN(eta, IDALS_FETAMX);
+
+  idals_mem->feta   = eta;
+  idals_mem->fbnorm = bnorm;
+
+  return (SUNMIN(eta * bnorm, tolmax));
+}
+
 /*---------------------------------------------------------------
  idaLsSolve
 
@@ -1435,8 +1600,8 @@ int idaLsSolve(IDAMem IDA_mem, N_Vector b, N_Vector weight, N_Vector ycur,
                N_Vector ypcur, N_Vector rescur)
 {
   IDALsMem idals_mem;
-  int nli_inc, retval;
-  sunrealtype tol, w_mean;
+  int curiter, nli_inc, retval;
+  sunrealtype deltar, tol, w_mean;
 
   /* access IDALsMem structure */
   if (IDA_mem->ida_lmem == NULL)
@@ -1455,6 +1620,19 @@ int idaLsSolve(IDAMem IDA_mem, N_Vector b, N_Vector weight, N_Vector ycur,
   if (idals_mem->iterative)
   {
     tol = idals_mem->nrmfac * idals_mem->eplifac * IDA_mem->ida_epsNewt;
+
+    /* With the adaptive forcing term, relax the tolerance relative to
+       the current residual (between tol and frelax * tol) */
+    if (idals_mem->forcing)
+    {
+      retval = SUNNonlinSolGetCurIter(IDA_mem->NLS, &curiter);
+      if (retval != SUN_SUCCESS) { return (-1); }
+      deltar = idals_mem->eplifac * IDA_mem->ida_epsNewt;
+      deltar = SUNMAX(deltar, idaLsForcingTol(idals_mem, curiter,
+                                              N_VWrmsNorm(b, weight),
+                                              idals_mem->frelax * deltar));
+      tol = idals_mem->nrmfac * deltar;
+    }
   }
   else { tol = ZERO; }
 
@@ -26,6 +26,22 @@
 extern "C" {
 #endif
 
+/*-----------------------------------------------------------------
+  IDALS solver constants
+
+  IDALS_FGAMMA default gamma of the adaptive forcing term
+  IDALS_FALPHA default alpha of the adaptive forcing term
+  IDALS_FETA0  adaptive forcing term at the first Newton iteration
+  IDALS_FETAMX maximum adaptive forcing term
+  IDALS_FRELAX default maximum factor by which the adaptive forcing
+               term relaxes the linear solver tolerance
+  -----------------------------------------------------------------*/
+#define IDALS_FGAMMA SUN_RCONST(0.9)
+#define IDALS_FALPHA SUN_RCONST(2.0)
+#define IDALS_FETA0  SUN_RCONST(0.1)
+#define IDALS_FETAMX SUN_RCONST(0.9)
+#define IDALS_FRELAX SUN_RCONST(2.0)
+
 /*-----------------------------------------------------------------
   Types : struct IDALsMemRec, struct *IDALsMem
 
@@ -61,6 +77,14 @@ typedef struct IDALsMemRec
   sunrealtype eplifac; /* nonlinear -> linear tol scaling factor       */
   sunrealtype nrmfac;  /* integrator -> LS norm conversion factor      */
 
+  /* Adaptive forcing term (see IDASetLSForcing) */
+  sunbooleantype forcing; /* use the Eisenstat-Walker forcing term     */
+  sunrealtype fgamma;     /* forcing term parameter gamma              */
+  sunrealtype falpha;     /* forcing term parameter alpha              */
+  sunrealtype frelax;     /* maximum relaxation of the fixed tolerance */
+  sunrealtype feta;       /* forcing term of the last linear solve     */
+  sunrealtype fbnorm;     /* WRMS norm of b in the last linear solve   */
+
   /* Statistics and associated parameters */
   sunrealtype dqincfac; /* dqincfac = optional increment factor in Jv   */
   long int nje;         /* nje = no. of calls to jac                    */
@@ -173,6 +197,9 @@ int idaLs_AccessLMem(void* ida_mem, const char* fname, IDAMem* IDA_mem,
 #define MSG_LS_NEG_MAXRS    "maxrs < 0 illegal."
 #define MSG_LS_NEG_EPLIFAC  "eplifac < 0.0 illegal."
 #define MSG_LS_NEG_DQINCFAC "dqincfac < 0.0 illegal."
+#define MSG_LS_BAD_FORCING \
+  "Illegal forcing term parameters (need gamma <= 1 and 1 < alpha <= 2)."
+#define MSG_LS_BAD_FRELAX "frelax < 1 illegal."
 #define MSG_LS_PSET_FAILED \
   "The preconditioner setup routine failed in an unrecoverable manner."
 #define MSG_LS_PSOLVE_FAILED \
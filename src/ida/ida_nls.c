@@ -16,8 +16,10 @@
 
 #include "ida_impl.h"
 #include "sundials/sundials_math.h"
+#include "sundials_utils.h"
 
 /* constant macros */
+#define ZERO   SUN_RCONST(0.0)    /* real 0.0    */
 #define PT0001 SUN_RCONST(0.0001) /* real 0.0001 */
 #define ONE    SUN_RCONST(1.0)    /* real 1.0    */
 #define TWENTY SUN_RCONST(20.0)   /* real 20.0   */
@@ -238,6 +240,7 @@ static int idaNlsLSetup(SUNDIALS_MAYBE_UNUSED sunbooleantype jbad,
 {
   IDAMem IDA_mem;
   int retval;
+  double tsetup = 0.0;
 
   if (ida_mem == NULL)
   {
@@ -247,10 +250,25 @@ static int idaNlsLSetup(SUNDIALS_MAYBE_UNUSED sunbooleantype jbad,
   IDA_mem = (IDAMem)ida_mem;
 
   IDA_mem->ida_nsetups++;
+  IDA_mem->ida_forceSetup = SUNFALSE;
+
+  if (IDA_mem->ida_costmodel) { tsetup = sunWallClockTime(); }
+
   retval = IDA_mem->ida_lsetup(IDA_mem, IDA_mem->ida_yy, IDA_mem->ida_yp,
                                IDA_mem->ida_savres, IDA_mem->ida_tempv1,
                                IDA_mem->ida_tempv2, IDA_mem->ida_tempv3);
 
+  /* accumulate the setup time for the setup cost model */
+  if (IDA_mem->ida_costmodel)
+  {
+    tsetup                 = sunWallClockTime() - tsetup;
+    IDA_mem->ida_tjac     += (sunrealtype)tsetup;
+    IDA_mem->ida_tjaclast  = (sunrealtype)tsetup;
+    IDA_mem->ida_tnls_lj   = IDA_mem->ida_tnls;
+    IDA_mem->ida_tstep     = ZERO;
+    IDA_mem->ida_nstlj     = IDA_mem->ida_nst;
+  }
+
   /* update Jacobian status */
   *jcur = SUNTRUE;
 
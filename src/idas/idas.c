@@ -33,6 +33,9 @@
  *       IDAQuadSensInit
  *       IDAQuadSensReInit
  *       IDARootInit
+ *   Checkpoint/restart functions
+ *       IDAWriteState
+ *       IDAReadState
  *   Main solver function
  *       IDASolve
  *   Interpolated output and extraction functions
@@ -61,6 +64,11 @@
  *       IDASensFreeVectors
  *       IDAQuadSensAllocVectors
  *       IDAQuadSensFreeVectors
+ *   State serialization
+ *       IDAStateHeader
+ *       IDAStateIO
+ *       IDAStateVectors
+ *       IDAStateTransfer
  *   Initial setup
  *       IDAInitialSetup
  *       IDAEwtSet
@@ -238,6 +246,15 @@
 #define EPCON    SUN_RCONST(0.33) /* Newton convergence test constant */
 #define MAXBACKS 100 /* max backtracks per Newton step in IDACalcIC */
 
+/*
+ * State stream constants
+ * ----------------------
+ */
+
+#define STATE_ID      0x49444153 /* identifies an IDAS state stream */
+#define STATE_VERSION 1          /* layout version of the stream    */
+#define STATE_NHDR    12         /* number of int header entries    */
+
 /*
  * =================================================================
  * PRIVATE FUNCTION PROTOTYPES
@@ -264,6 +281,16 @@ static void IDAQuadSensFreeVectors(IDAMem ida_mem);
 
 int IDAInitialSetup(IDAMem IDA_mem);
 
+/* State serialization */
+
+static void IDAStateHeader(IDAMem IDA_mem, int hdr[]);
+static sunbooleantype IDAStateIO(FILE* fp, void* data, size_t size, size_t n,
+                                 sunbooleantype save);
+static sunbooleantype IDAStateVectors(FILE* fp, N_Vector* v, int n,
+                                      sunbooleantype save);
+static sunbooleantype IDAStateTransfer(IDAMem IDA_mem, FILE* fp,
+                                       sunbooleantype save);
+
 static int IDAEwtSetSS(IDAMem IDA_mem, N_Vector ycur, N_Vector weight);
 static int IDAEwtSetSV(IDAMem IDA_mem, N_Vector ycur, N_Vector weight);
 
@@ -431,6 +458,7 @@ void* IDACreate(SUNContext sunctx)
 
   /* Set default values for integrator optional inputs */
   IDA_mem->ida_res            = NULL;
+  IDA_mem->ida_resdir         = NULL;
   IDA_mem->ida_user_data      = NULL;
   IDA_mem->ida_itol           = IDA_NN;
   IDA_mem->ida_atolmin0       = SUNTRUE;
@@ -705,12 +733,13 @@ int IDAInit(void* ida_mem, IDAResFn res, sunrealtype t0, N_Vector yy0,
 
   /* Set the linear solver addresses to NULL */
 
-  IDA_mem->ida_linit  = NULL;
-  IDA_mem->ida_lsetup = NULL;
-  IDA_mem->ida_lsolve = NULL;
-  IDA_mem->ida_lperf  = NULL;
-  IDA_mem->ida_lfree  = NULL;
-  IDA_mem->ida_lmem   = NULL;
+  IDA_mem->ida_linit       = NULL;
+  IDA_mem->ida_lsetup      = NULL;
+  IDA_mem->ida_lsolve      = NULL;
+  IDA_mem->ida_lsolvemulti = NULL;
+  IDA_mem->ida_lperf       = NULL;
+  IDA_mem->ida_lfree       = NULL;
+  IDA_mem->ida_lmem        = NULL;
 
   /* Set forceSetup to SUNFALSE */
 
@@ -863,6 +892,187 @@ int IDAReInit(void* ida_mem, sunrealtype t0, N_Vector yy0, N_Vector yp0)
 
 /*-----------------------------------------------------------------*/
 
+/*
+ * IDAWriteState
+ *
+ * IDAWriteState writes everything IDAS needs to continue the
+ * integration from the current internal time to the binary stream fp:
+ * the step data, counters, divided difference arrays (including those
+ * of quadratures and sensitivities, if active), and rootfinding data.
+ * Adjoint sensitivity data is not written. Optional inputs, tolerances, and solver objects
+ * are not written; they are set up by the user before calling
+ * IDAReadState. The vectors are written with the N_Vector buffer
+ * operations, so the stream holds the local part of the state.
+ */
+
+int IDAWriteState(void* ida_mem, FILE* fp)
+{
+  IDAMem IDA_mem;
+  int hdr[STATE_NHDR];
+  sunindextype bufsize;
+  sunbooleantype ok;
+
+  /* Check ida_mem */
+
+  if (ida_mem == NULL)
+  {
+    IDAProcessError(NULL, IDA_MEM_NULL, __LINE__, __func__, __FILE__, MSG_NO_MEM);
+    return (IDA_MEM_NULL);
+  }
+  IDA_mem = (IDAMem)ida_mem;
+
+  if (IDA_mem->ida_MallocDone == SUNFALSE)
+  {
+    IDAProcessError(IDA_mem, IDA_NO_MALLOC, __LINE__, __func__, __FILE__,
+                    MSG_NO_MALLOC);
+    return (IDA_NO_MALLOC);
+  }
+
+  if (fp == NULL)
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_NULL_FP);
+    return (IDA_ILL_INPUT);
+  }
+
+  /* The vectors are serialized with the buffer operations */
+
+  if (N_VBufSize(IDA_mem->ida_phi[0], &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    IDAProcessError(IDA_mem, IDA_VECTOROP_ERR, __LINE__, __func__, __FILE__,
+                    MSG_BAD_NVECTOR);
+    return (IDA_VECTOROP_ERR);
+  }
+
+  /* Write the header followed by the state */
+
+  IDAStateHeader(IDA_mem, hdr);
+
+  ok = IDAStateIO(fp, hdr, sizeof(int), STATE_NHDR, SUNTRUE) &&
+       IDAStateTransfer(IDA_mem, fp, SUNTRUE);
+
+  if (!ok)
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_STATE_WRITE);
+    return (IDA_ILL_INPUT);
+  }
+
+  return (IDA_SUCCESS);
+}
+
+/*
+ * IDAReadState
+ *
+ * IDAReadState restores a state written by IDAWriteState. The IDAS
+ * memory must have been created with the same maximum order, number
+ * of root functions, quadrature and sensitivity setup, and vector
+ * layout, and must have its tolerances and solvers attached. The next call to IDASolve then continues from
+ * the saved internal time with the saved step size, order, and
+ * history. Since the linear solver memory is not part of the state, a
+ * linear solver setup is forced at the next step. If reading fails,
+ * the IDA memory must be re-initialized before it is used again.
+ */
+
+int IDAReadState(void* ida_mem, FILE* fp)
+{
+  IDAMem IDA_mem;
+  int hdr[STATE_NHDR], hdr_in[STATE_NHDR];
+  int i, ier;
+  sunindextype bufsize;
+  sunbooleantype ok;
+
+  /* Check ida_mem */
+
+  if (ida_mem == NULL)
+  {
+    IDAProcessError(NULL, IDA_MEM_NULL, __LINE__, __func__, __FILE__, MSG_NO_MEM);
+    return (IDA_MEM_NULL);
+  }
+  IDA_mem = (IDAMem)ida_mem;
+
+  SUNDIALS_MARK_FUNCTION_BEGIN(IDA_PROFILER);
+
+  if (IDA_mem->ida_MallocDone == SUNFALSE)
+  {
+    IDAProcessError(IDA_mem, IDA_NO_MALLOC, __LINE__, __func__, __FILE__,
+                    MSG_NO_MALLOC);
+    SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+    return (IDA_NO_MALLOC);
+  }
+
+  if (fp == NULL)
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_NULL_FP);
+    SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+    return (IDA_ILL_INPUT);
+  }
+
+  if (N_VBufSize(IDA_mem->ida_phi[0], &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    IDAProcessError(IDA_mem, IDA_VECTOROP_ERR, __LINE__, __func__, __FILE__,
+                    MSG_BAD_NVECTOR);
+    SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+    return (IDA_VECTOROP_ERR);
+  }
+
+  /* Check that the stream matches this integrator */
+
+  if (!IDAStateIO(fp, hdr_in, sizeof(int), STATE_NHDR, SUNFALSE))
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_STATE_READ);
+    SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+    return (IDA_ILL_INPUT);
+  }
+
+  IDAStateHeader(IDA_mem, hdr);
+
+  ok = SUNTRUE;
+  for (i = 0; i < STATE_NHDR; i++) { ok = ok && (hdr_in[i] == hdr[i]); }
+
+  if (!ok)
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_STATE_BAD);
+    SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+    return (IDA_ILL_INPUT);
+  }
+
+  /* Read the state */
+
+  ok = IDAStateTransfer(IDA_mem, fp, SUNFALSE);
+
+  if (!ok)
+  {
+    IDAProcessError(IDA_mem, IDA_ILL_INPUT, __LINE__, __func__, __FILE__,
+                    MSG_STATE_READ);
+    SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+    return (IDA_ILL_INPUT);
+  }
+
+  /* Redo the setup normally done on the first call to IDASolve and
+     force a linear solver setup at the next step */
+
+  if (IDA_mem->ida_nst > 0)
+  {
+    ier = IDAInitialSetup(IDA_mem);
+    if (ier != IDA_SUCCESS)
+    {
+      SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+      return (ier);
+    }
+    IDA_mem->ida_SetupDone  = SUNTRUE;
+    IDA_mem->ida_forceSetup = SUNTRUE;
+  }
+
+  SUNDIALS_MARK_FUNCTION_END(IDA_PROFILER);
+  return (IDA_SUCCESS);
+}
+
+/*-----------------------------------------------------------------*/
+
 /*
  * IDASStolerances
  * IDASVtolerances
@@ -5174,6 +5384,232 @@ int IDAInitialSetup(IDAMem IDA_mem)
   return (IDA_SUCCESS);
 }
 
+/*
+ * -----------------------------------------------------------------
+ * State serialization
+ * -----------------------------------------------------------------
+ */
+
+/*
+ * IDAStateHeader
+ *
+ * This routine fills the header of a state stream. A stream can only
+ * be read by an integrator producing the same header.
+ */
+
+static void IDAStateHeader(IDAMem IDA_mem, int hdr[])
+{
+  hdr[0]  = STATE_ID;
+  hdr[1]  = STATE_VERSION;
+  hdr[2]  = (int)sizeof(sunrealtype);
+  hdr[3]  = (int)sizeof(long int);
+  hdr[4]  = (int)sizeof(sunindextype);
+  hdr[5]  = IDA_mem->ida_maxord;
+  hdr[6]  = IDA_mem->ida_nrtfn;
+  hdr[7]  = IDA_mem->ida_quadr;
+  hdr[8]  = IDA_mem->ida_sensi;
+  hdr[9]  = IDA_mem->ida_sensi ? IDA_mem->ida_Ns : 0;
+  hdr[10] = IDA_mem->ida_sensi ? IDA_mem->ida_ism : 0;
+  hdr[11] = IDA_mem->ida_quadr_sensi;
+}
+
+/*
+ * IDAStateIO
+ *
+ * This routine writes (save = SUNTRUE) or reads (save = SUNFALSE) n
+ * items of the given size and returns SUNFALSE on a short transfer.
+ */
+
+static sunbooleantype IDAStateIO(FILE* fp, void* data, size_t size, size_t n,
+                                 sunbooleantype save)
+{
+  if (n == 0) { return (SUNTRUE); }
+  if (save) { return (fwrite(data, size, n, fp) == n); }
+  return (fread(data, size, n, fp) == n);
+}
+
+/*
+ * IDAStateVectors
+ *
+ * This routine writes or reads the n vectors v with the N_Vector
+ * buffer operations. The buffer size is written first and checked on
+ * reading, so a stream from a different vector layout is rejected.
+ */
+
+static sunbooleantype IDAStateVectors(FILE* fp, N_Vector* v, int n,
+                                      sunbooleantype save)
+{
+  sunindextype bufsize, bufsize_in;
+  void* buf;
+  int j;
+  sunbooleantype ok;
+
+  if (N_VBufSize(v[0], &bufsize) != SUN_SUCCESS || bufsize <= 0)
+  {
+    return (SUNFALSE);
+  }
+
+  bufsize_in = bufsize;
+  if (!IDAStateIO(fp, &bufsize_in, sizeof(sunindextype), 1, save) ||
+      (bufsize_in != bufsize))
+  {
+    return (SUNFALSE);
+  }
+
+  buf = malloc(bufsize);
+  if (buf == NULL) { return (SUNFALSE); }
+
+  ok = SUNTRUE;
+  for (j = 0; ok && j < n; j++)
+  {
+    if (save) { ok = (N_VBufPack(v[j], buf) == SUN_SUCCESS); }
+    ok = ok && IDAStateIO(fp, buf, 1, (size_t)bufsize, save);
+    if (!save) { ok = ok && (N_VBufUnpack(v[j], buf) == SUN_SUCCESS); }
+  }
+
+  free(buf);
+
+  return (ok);
+}
+
+/*
+ * IDAStateTransfer
+ *
+ * This routine writes or reads the integrator state in a fixed order,
+ * so the same code defines the stream layout in both directions.
+ */
+
+#define STATE_IO(x, n)                                       \
+  if (!IDAStateIO(fp, (x), sizeof(*(x)), (size_t)(n), save)) \
+  {                                                          \
+    return (SUNFALSE);                                       \
+  }
+
+static sunbooleantype IDAStateTransfer(IDAMem IDA_mem, FILE* fp,
+                                       sunbooleantype save)
+{
+  int j, maxcol;
+  N_Vector vecs[MXORDP1 + 1];
+
+  /* Step data */
+
+  STATE_IO(&IDA_mem->ida_tn, 1);
+  STATE_IO(&IDA_mem->ida_tretlast, 1);
+  STATE_IO(&IDA_mem->ida_hh, 1);
+  STATE_IO(&IDA_mem->ida_hused, 1);
+  STATE_IO(&IDA_mem->ida_h0u, 1);
+  STATE_IO(&IDA_mem->ida_eta, 1);
+  STATE_IO(&IDA_mem->ida_cj, 1);
+  STATE_IO(&IDA_mem->ida_cjlast, 1);
+  STATE_IO(&IDA_mem->ida_cjold, 1);
+  STATE_IO(&IDA_mem->ida_cjratio, 1);
+  STATE_IO(&IDA_mem->ida_ss, 1);
+  STATE_IO(&IDA_mem->ida_ssS, 1);
+  STATE_IO(&IDA_mem->ida_oldnrm, 1);
+  STATE_IO(&IDA_mem->ida_epsNewt, 1);
+  STATE_IO(&IDA_mem->ida_toldel, 1);
+  STATE_IO(&IDA_mem->ida_tolsf, 1);
+  STATE_IO(IDA_mem->ida_psi, MXORDP1);
+  STATE_IO(IDA_mem->ida_alpha, MXORDP1);
+  STATE_IO(IDA_mem->ida_beta, MXORDP1);
+  STATE_IO(IDA_mem->ida_sigma, MXORDP1);
+  STATE_IO(IDA_mem->ida_gamma, MXORDP1);
+  STATE_IO(&IDA_mem->ida_kk, 1);
+  STATE_IO(&IDA_mem->ida_kused, 1);
+  STATE_IO(&IDA_mem->ida_knew, 1);
+  STATE_IO(&IDA_mem->ida_phase, 1);
+  STATE_IO(&IDA_mem->ida_ns, 1);
+
+  /* Counters */
+
+  STATE_IO(&IDA_mem->ida_nst, 1);
+  STATE_IO(&IDA_mem->ida_nre, 1);
+  STATE_IO(&IDA_mem->ida_ncfn, 1);
+  STATE_IO(&IDA_mem->ida_netf, 1);
+  STATE_IO(&IDA_mem->ida_nni, 1);
+  STATE_IO(&IDA_mem->ida_nnf, 1);
+  STATE_IO(&IDA_mem->ida_nsetups, 1);
+  STATE_IO(&IDA_mem->ida_nrQe, 1);
+  STATE_IO(&IDA_mem->ida_nrSe, 1);
+  STATE_IO(&IDA_mem->ida_nrQSe, 1);
+  STATE_IO(&IDA_mem->ida_nreS, 1);
+  STATE_IO(&IDA_mem->ida_nrQeS, 1);
+  STATE_IO(&IDA_mem->ida_ncfnQ, 1);
+  STATE_IO(&IDA_mem->ida_ncfnS, 1);
+  STATE_IO(&IDA_mem->ida_netfQ, 1);
+  STATE_IO(&IDA_mem->ida_netfS, 1);
+  STATE_IO(&IDA_mem->ida_netfQS, 1);
+  STATE_IO(&IDA_mem->ida_nniS, 1);
+  STATE_IO(&IDA_mem->ida_nnfS, 1);
+  STATE_IO(&IDA_mem->ida_nsetupsS, 1);
+
+  /* Rootfinding data */
+
+  if (IDA_mem->ida_nrtfn > 0)
+  {
+    STATE_IO(&IDA_mem->ida_tlo, 1);
+    STATE_IO(&IDA_mem->ida_thi, 1);
+    STATE_IO(&IDA_mem->ida_trout, 1);
+    STATE_IO(&IDA_mem->ida_irfnd, 1);
+    STATE_IO(&IDA_mem->ida_nge, 1);
+    STATE_IO(IDA_mem->ida_glo, IDA_mem->ida_nrtfn);
+    STATE_IO(IDA_mem->ida_ghi, IDA_mem->ida_nrtfn);
+    STATE_IO(IDA_mem->ida_grout, IDA_mem->ida_nrtfn);
+    STATE_IO(IDA_mem->ida_iroots, IDA_mem->ida_nrtfn);
+    STATE_IO(IDA_mem->ida_gactive, IDA_mem->ida_nrtfn);
+  }
+
+  /* Divided difference arrays and the last corrections */
+
+  maxcol = SUNMAX(IDA_mem->ida_maxord, 3);
+  for (j = 0; j <= maxcol; j++) { vecs[j] = IDA_mem->ida_phi[j]; }
+  vecs[maxcol + 1] = IDA_mem->ida_ee;
+
+  if (!IDAStateVectors(fp, vecs, maxcol + 2, save)) { return (SUNFALSE); }
+
+  if (IDA_mem->ida_quadr)
+  {
+    for (j = 0; j <= maxcol; j++) { vecs[j] = IDA_mem->ida_phiQ[j]; }
+    vecs[maxcol + 1] = IDA_mem->ida_eeQ;
+
+    if (!IDAStateVectors(fp, vecs, maxcol + 2, save)) { return (SUNFALSE); }
+  }
+
+  if (IDA_mem->ida_sensi)
+  {
+    for (j = 0; j <= maxcol; j++)
+    {
+      if (!IDAStateVectors(fp, IDA_mem->ida_phiS[j], IDA_mem->ida_Ns, save))
+      {
+        return (SUNFALSE);
+      }
+    }
+    if (!IDAStateVectors(fp, IDA_mem->ida_eeS, IDA_mem->ida_Ns, save))
+    {
+      return (SUNFALSE);
+    }
+  }
+
+  if (IDA_mem->ida_quadr_sensi)
+  {
+    for (j = 0; j <= maxcol; j++)
+    {
+      if (!IDAStateVectors(fp, IDA_mem->ida_phiQS[j], IDA_mem->ida_Ns, save))
+      {
+        return (SUNFALSE);
+      }
+    }
+    if (!IDAStateVectors(fp, IDA_mem->ida_eeQS, IDA_mem->ida_Ns, save))
+    {
+      return (SUNFALSE);
+    }
+  }
+
+  return (SUNTRUE);
+}
+
+#undef STATE_IO
+
 /*
  * IDAEwtSet
  *
@@ -112,8 +112,9 @@ typedef struct IDAMemRec
     Problem Specification Data
     --------------------------*/
 
-  IDAResFn ida_res;    /* F(t,y(t),y'(t))=0; the function F     */
-  void* ida_user_data; /* user pointer passed to res            */
+  IDAResFn ida_res;       /* F(t,y(t),y'(t))=0; the function F     */
+  IDAResDirFn ida_resdir; /* F and its directional derivative      */
+  void* ida_user_data;    /* user pointer passed to res            */
 
   int ida_itol;                 /* itol = IDA_SS, IDA_SV, IDA_WF, IDA_NN */
   sunrealtype ida_rtol;         /* relative tolerance                    */
@@ -470,6 +471,9 @@ typedef struct IDAMemRec
   int (*ida_lsolve)(struct IDAMemRec* idamem, N_Vector b, N_Vector weight,
                     N_Vector ycur, N_Vector ypcur, N_Vector rescur);
 
+  int (*ida_lsolvemulti)(struct IDAMemRec* idamem, int nrhs, N_Vector* b,
+                         N_Vector ycur, N_Vector ypcur, N_Vector rescur);
+
   int (*ida_lperf)(struct IDAMemRec* idamem, int perftask);
 
   int (*ida_lfree)(struct IDAMemRec* idamem);
@@ -915,6 +919,20 @@ struct IDAadjMemRec
  * -----------------------------------------------------------------
  */
 
+/*
+ * -----------------------------------------------------------------
+ * int (*ida_lsolvemulti)(IDAMem IDA_mem, int nrhs, N_Vector* b,
+ *                        N_Vector ycur, N_Vector ypcur,
+ *                        N_Vector rescur);
+ * -----------------------------------------------------------------
+ * ida_lsolvemulti is optional. When non-NULL it must solve the
+ * nrhs linear equations P x_i = b_i, with P as in ida_lsolve,
+ * returning each solution in b_i. It is used for the sensitivity
+ * corrections, which all share the same P. The return values
+ * are the same as for ida_lsolve.
+ * -----------------------------------------------------------------
+ */
+
 /*
  * -----------------------------------------------------------------
  * int (*ida_lperf)(IDAMem IDA_mem, int perftask);
@@ -1045,6 +1063,11 @@ int IDASensResDQ(int Ns, sunrealtype t, N_Vector yy, N_Vector yp,
 #define MSG_LSOLVE_NULL   "The linear solver's solve routine is NULL."
 #define MSG_LINIT_FAIL    "The linear solver's init routine failed."
 #define MSG_NLS_INIT_FAIL "The nonlinear solver's init routine failed."
+#define MSG_NULL_FP       "fp = NULL illegal."
+#define MSG_STATE_WRITE   "Writing the integrator state failed."
+#define MSG_STATE_READ    "Reading the integrator state failed."
+#define MSG_STATE_BAD \
+  "The saved state is not compatible with this integrator."
 
 #define MSG_NO_QUAD  "Illegal attempt to call before calling IDAQuadInit."
 #define MSG_BAD_EWTQ "Initial ewtQ has component(s) equal to zero (illegal)."
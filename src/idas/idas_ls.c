@@ -194,6 +194,14 @@ int IDASetLinearSolver(void* ida_mem, SUNLinearSolver LS, SUNMatrix A)
   /* Set ida_lperf if using an iterative SUNLinearSolver object */
   IDA_mem->ida_lperf = (iterative) ? idaLsPerf : NULL;
 
+  /* Direct solvers that support multiple right-hand sides can solve all
+     sensitivity systems with one pass over the factorization */
+  if (!iterative && (LS->ops->solvemulti != NULL))
+  {
+    IDA_mem->ida_lsolvemulti = idaLsSolveMulti;
+  }
+  else { IDA_mem->ida_lsolvemulti = NULL; }
+
   /* Allocate memory for IDALsMemRec */
   idals_mem = NULL;
   idals_mem = (IDALsMem)malloc(sizeof(struct IDALsMemRec));
@@ -1241,6 +1249,10 @@ int idaLsBandDQJac(sunrealtype tt, sunrealtype c_j, N_Vector yy, N_Vector yp,
        sigma = sqrt(Neq)*dqincfac.
   The return value from the call to res is saved in order to set
   the return flag from idaLsSolve.
+
+  If the user supplied a directional derivative function with
+  IDASetResDirFn (and no alternative jtimesResFn), the exact
+  product Jv = F_y v + cj F_y' v is returned instead.
   ---------------------------------------------------------------*/
 int idaLsDQJtimes(sunrealtype tt, N_Vector yy, N_Vector yp, N_Vector rr,
                   N_Vector v, N_Vector Jv, sunrealtype c_j, void* ida_mem,
@@ -1257,6 +1269,17 @@ int idaLsDQJtimes(sunrealtype tt, N_Vector yy, N_Vector yp, N_Vector rr,
   retval = idaLs_AccessLMem(ida_mem, __func__, &IDA_mem, &idals_mem);
   if (retval != IDALS_SUCCESS) { return (retval); }
 
+  /* Compute Jv with the directional derivative function (work1 = F) */
+  if ((IDA_mem->ida_resdir != NULL) && (idals_mem->jt_res == IDA_mem->ida_res))
+  {
+    N_VScale(c_j, v, work2);
+    retval = IDA_mem->ida_resdir(tt, yy, yp, v, work2, work1, Jv,
+                                 IDA_mem->ida_user_data);
+    if (retval < 0) { return (-1); }
+    if (retval > 0) { return (+1); }
+    return (0);
+  }
+
   LSID = SUNLinSolGetID(idals_mem->LS);
   if (LSID == SUNLINEARSOLVER_SPGMR || LSID == SUNLINEARSOLVER_SPFGMR)
   {
@@ -1629,6 +1652,66 @@ int idaLsSolve(IDAMem IDA_mem, N_Vector b, N_Vector weight, N_Vector ycur,
   return (0);
 }
 
+/*---------------------------------------------------------------
+ idaLsSolveMulti: interfaces between IDAS and the generic
+ SUNLinSolSolveMulti routine to solve several linear systems that
+ share the same matrix, e.g., the sensitivity corrections. It is
+ only attached for direct linear solvers, so no tolerance, scaling
+ vectors, or initial guess are needed and the solutions overwrite
+ the right-hand sides.
+---------------------------------------------------------------*/
+int idaLsSolveMulti(IDAMem IDA_mem, int nrhs, N_Vector* b, N_Vector ycur,
+                    N_Vector ypcur, N_Vector rescur)
+{
+  IDALsMem idals_mem;
+  int i, retval;
+
+  /* access IDALsMem structure */
+  if (IDA_mem->ida_lmem == NULL)
+  {
+    IDAProcessError(IDA_mem, IDALS_LMEM_NULL, __LINE__, __func__, __FILE__,
+                    MSG_LS_LMEM_NULL);
+    return (IDALS_LMEM_NULL);
+  }
+  idals_mem = (IDALsMem)IDA_mem->ida_lmem;
+
+  /* Set vectors ycur, ypcur and rcur for use by the linear solver */
+  idals_mem->ycur  = ycur;
+  idals_mem->ypcur = ypcur;
+  idals_mem->rcur  = rescur;
+
+  /* Call solver, solutions overwrite the right-hand sides */
+  retval = SUNLinSolSolveMulti(idals_mem->LS, idals_mem->J, b, b, nrhs, ZERO);
+
+  /* Scale the corrections to account for change in cj */
+  if (idals_mem->scalesol && (IDA_mem->ida_cjratio != ONE))
+  {
+    for (i = 0; i < nrhs; i++)
+    {
+      N_VScale(TWO / (ONE + IDA_mem->ida_cjratio), b[i], b[i]);
+    }
+  }
+
+  /* Increment ncfl counter and interpret solver return value */
+  if (retval != SUN_SUCCESS) { idals_mem->ncfl++; }
+  idals_mem->last_flag = retval;
+
+  switch (retval)
+  {
+  case SUN_SUCCESS: return (0); break;
+  case SUNLS_PACKAGE_FAIL_REC:
+  case SUNLS_LUFACT_FAIL: return (1); break;
+  case SUN_ERR_EXT_FAIL:
+    IDAProcessError(IDA_mem, SUN_ERR_EXT_FAIL, __LINE__, __func__, __FILE__,
+                    "Failure in SUNLinSol external package");
+    return (-1);
+    break;
+  default: return (retval > 0) ? 1 : -1; break;
+  }
+
+  return (0);
+}
+
 /*---------------------------------------------------------------
  idaLsPerf: accumulates performance statistics information
  for IDA
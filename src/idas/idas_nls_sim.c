@@ -326,6 +326,20 @@ static int idaNlsLSolveSensSim(N_Vector deltaSim, void* ida_mem)
   }
   IDA_mem = (IDAMem)ida_mem;
 
+  /* solve the state and sensitivity linear systems with a single multiple
+     right-hand side solve when supported by the linear solver */
+  if (IDA_mem->ida_lsolvemulti)
+  {
+    retval = IDA_mem->ida_lsolvemulti(IDA_mem, IDA_mem->ida_Ns + 1,
+                                      NV_VECS_SW(deltaSim), IDA_mem->ida_yy,
+                                      IDA_mem->ida_yp, IDA_mem->ida_savres);
+
+    if (retval < 0) { return (IDA_LSOLVE_FAIL); }
+    if (retval > 0) { return (IDA_LSOLVE_RECVR); }
+
+    return (IDA_SUCCESS);
+  }
+
   /* extract state update vector from the vector wrapper */
   delta = NV_VEC_SW(deltaSim, 0);
 
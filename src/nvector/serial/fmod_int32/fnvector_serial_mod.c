@@ -742,6 +742,20 @@ SWIGEXPORT int _wrap_FN_VWrmsNormMaskVectorArray_Serial(int const *farg1, void *
 }
 
 
+SWIGEXPORT int _wrap_FN_VPascalShiftVectorArray_Serial(int const *farg1, void *farg2) {
+  int fresult ;
+  int arg1 ;
+  N_Vector *arg2 = (N_Vector *) 0 ;
+  SUNErrCode result;
+  
+  arg1 = (int)(*farg1);
+  arg2 = (N_Vector *)(farg2);
+  result = (SUNErrCode)N_VPascalShiftVectorArray_Serial(arg1,arg2);
+  fresult = (SUNErrCode)(result);
+  return fresult;
+}
+
+
 SWIGEXPORT double _wrap_FN_VWSqrSumLocal_Serial(N_Vector farg1, N_Vector farg2) {
   double fresult ;
   N_Vector arg1 = (N_Vector) 0 ;
@@ -940,6 +954,20 @@ SWIGEXPORT int _wrap_FN_VEnableWrmsNormMaskVectorArray_Serial(N_Vector farg1, in
 }
 
 
+SWIGEXPORT int _wrap_FN_VEnablePascalShiftVectorArray_Serial(N_Vector farg1, int const *farg2) {
+  int fresult ;
+  N_Vector arg1 = (N_Vector) 0 ;
+  int arg2 ;
+  SUNErrCode result;
+  
+  arg1 = (N_Vector)(farg1);
+  arg2 = (int)(*farg2);
+  result = (SUNErrCode)N_VEnablePascalShiftVectorArray_Serial(arg1,arg2);
+  fresult = (SUNErrCode)(result);
+  return fresult;
+}
+
+
 
 SWIGEXPORT double * _wrap_FN_VGetArrayPointer_Serial(N_Vector farg1) {
   double * fresult ;
@@ -64,6 +64,7 @@ module fnvector_serial_mod
  public :: FN_VConstVectorArray_Serial
  public :: FN_VWrmsNormVectorArray_Serial
  public :: FN_VWrmsNormMaskVectorArray_Serial
+ public :: FN_VPascalShiftVectorArray_Serial
  public :: FN_VWSqrSumLocal_Serial
  public :: FN_VWSqrSumMaskLocal_Serial
  public :: FN_VBufSize_Serial
@@ -78,6 +79,7 @@ module fnvector_serial_mod
  public :: FN_VEnableConstVectorArray_Serial
  public :: FN_VEnableWrmsNormVectorArray_Serial
  public :: FN_VEnableWrmsNormMaskVectorArray_Serial
+ public :: FN_VEnablePascalShiftVectorArray_Serial
 
  public :: FN_VGetArrayPointer_Serial
 
@@ -429,6 +431,15 @@ type(C_PTR), value :: farg5
 integer(C_INT) :: fresult
 end function
 
+function swigc_FN_VPascalShiftVectorArray_Serial(farg1, farg2) &
+bind(C, name="_wrap_FN_VPascalShiftVectorArray_Serial") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT), intent(in) :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FN_VWSqrSumLocal_Serial(farg1, farg2) &
 bind(C, name="_wrap_FN_VWSqrSumLocal_Serial") &
 result(fresult)
@@ -556,6 +567,15 @@ integer(C_INT), intent(in) :: farg2
 integer(C_INT) :: fresult
 end function
 
+function swigc_FN_VEnablePascalShiftVectorArray_Serial(farg1, farg2) &
+bind(C, name="_wrap_FN_VEnablePascalShiftVectorArray_Serial") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+type(C_PTR), value :: farg1
+integer(C_INT), intent(in) :: farg2
+integer(C_INT) :: fresult
+end function
+
 
 function swigc_FN_VGetArrayPointer_Serial(farg1) &
 bind(C, name="_wrap_FN_VGetArrayPointer_Serial") &
@@ -1204,6 +1224,22 @@ fresult = swigc_FN_VWrmsNormMaskVectorArray_Serial(farg1, farg2, farg3, farg4, f
 swig_result = fresult
 end function
 
+function FN_VPascalShiftVectorArray_Serial(nvec, z) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+integer(C_INT), intent(in) :: nvec
+type(C_PTR) :: z
+integer(C_INT) :: fresult 
+integer(C_INT) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = nvec
+farg2 = z
+fresult = swigc_FN_VPascalShiftVectorArray_Serial(farg1, farg2)
+swig_result = fresult
+end function
+
 function FN_VWSqrSumLocal_Serial(x, w) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
@@ -1431,6 +1467,22 @@ fresult = swigc_FN_VEnableWrmsNormMaskVectorArray_Serial(farg1, farg2)
 swig_result = fresult
 end function
 
+function FN_VEnablePascalShiftVectorArray_Serial(v, tf) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+type(N_Vector), target, intent(inout) :: v
+integer(C_INT), intent(in) :: tf
+integer(C_INT) :: fresult 
+type(C_PTR) :: farg1 
+integer(C_INT) :: farg2 
+
+farg1 = c_loc(v)
+farg2 = tf
+fresult = swigc_FN_VEnablePascalShiftVectorArray_Serial(farg1, farg2)
+swig_result = fresult
+end function
+
 
 function FN_VGetArrayPointer_Serial(v) &
 result(swig_result)
@@ -32,6 +32,10 @@
 #define ONE    SUN_RCONST(1.0)
 #define ONEPT5 SUN_RCONST(1.5)
 
+/* Number of elements of each vector processed together in the Pascal shift,
+   so that the blocks of all vectors stay in the L1 cache */
+#define PASCAL_BLOCK 128
+
 /* Private functions for special cases of vector operations */
 static void VCopy_Serial(N_Vector x, N_Vector z);             /* z=x       */
 static void VSum_Serial(N_Vector x, N_Vector y, N_Vector z);  /* z=x+y     */
@@ -1550,6 +1554,44 @@ SUNErrCode N_VLinearCombinationVectorArray_Serial(int nvec, int nsum,
   return SUN_SUCCESS;
 }
 
+SUNErrCode N_VPascalShiftVectorArray_Serial(int nvec, N_Vector* Z)
+{
+  SUNFunctionBegin(Z[0]->sunctx);
+  int j, k;
+  sunindextype b, i, N, nb;
+  sunrealtype* zd  = NULL;
+  sunrealtype* zd1 = NULL;
+
+  /* invalid number of vectors */
+  SUNAssert(nvec >= 1, SUN_ERR_ARG_OUTOFRANGE);
+
+  /* nothing to shift */
+  if (nvec == 1) { return SUN_SUCCESS; }
+
+  /* get vector length */
+  N = NV_LENGTH_S(Z[0]);
+
+  /*
+   * Z[j-1] += Z[j] for j = nvec-1,...,k and k = 1,...,nvec-1, i.e.,
+   * Z[j] = sum{ binomial(i,j) * Z[i] }, i = j,...,nvec-1, applied to one
+   * block of all vectors at a time
+   */
+  for (b = 0; b < N; b += PASCAL_BLOCK)
+  {
+    nb = SUNMIN(PASCAL_BLOCK, N - b);
+    for (k = 1; k < nvec; k++)
+    {
+      for (j = nvec - 1; j >= k; j--)
+      {
+        zd  = NV_DATA_S(Z[j]) + b;
+        zd1 = NV_DATA_S(Z[j - 1]) + b;
+        for (i = 0; i < nb; i++) { zd1[i] += zd[i]; }
+      }
+    }
+  }
+  return SUN_SUCCESS;
+}
+
 /*
  * -----------------------------------------------------------------
  * OPTIONAL XBraid interface operations
@@ -1969,6 +2011,7 @@ SUNErrCode N_VEnableFusedOps_Serial(N_Vector v, sunbooleantype tf)
     v->ops->nvscaleaddmultivectorarray = N_VScaleAddMultiVectorArray_Serial;
     v->ops->nvlinearcombinationvectorarray =
       N_VLinearCombinationVectorArray_Serial;
+    v->ops->nvpascalshiftvectorarray = N_VPascalShiftVectorArray_Serial;
     /* enable single buffer reduction operations */
     v->ops->nvdotprodmultilocal = N_VDotProdMulti_Serial;
   }
@@ -1986,6 +2029,7 @@ SUNErrCode N_VEnableFusedOps_Serial(N_Vector v, sunbooleantype tf)
     v->ops->nvwrmsnormmaskvectorarray      = NULL;
     v->ops->nvscaleaddmultivectorarray     = NULL;
     v->ops->nvlinearcombinationvectorarray = NULL;
+    v->ops->nvpascalshiftvectorarray       = NULL;
     /* disable single buffer reduction operations */
     v->ops->nvdotprodmultilocal = NULL;
   }
@@ -2058,3 +2102,10 @@ SUNErrCode N_VEnableLinearCombinationVectorArray_Serial(N_Vector v,
     tf ? N_VLinearCombinationVectorArray_Serial : NULL;
   return SUN_SUCCESS;
 }
+
+SUNErrCode N_VEnablePascalShiftVectorArray_Serial(N_Vector v, sunbooleantype tf)
+{
+  v->ops->nvpascalshiftvectorarray = tf ? N_VPascalShiftVectorArray_Serial
+                                        : NULL;
+  return SUN_SUCCESS;
+}
@@ -0,0 +1,256 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the SUNAdaptController_MRIHTol
+ * module.
+ * -----------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sunadaptcontroller/sunadaptcontroller_mrihtol.h>
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_core.h>
+#include <sundials/sundials_errors.h>
+
+#include "sundials_macros.h"
+
+/* ---------------
+ * Macro accessors
+ * --------------- */
+
+#define MRIHTOL_CONTENT(C)     ((SUNAdaptControllerContent_MRIHTol)(C->content))
+#define MRIHTOL_CSLOW(C)       (MRIHTOL_CONTENT(C)->HControl)
+#define MRIHTOL_CFAST(C)       (MRIHTOL_CONTENT(C)->TolControl)
+#define MRIHTOL_INNER_RELCH(C) (MRIHTOL_CONTENT(C)->inner_max_relch)
+#define MRIHTOL_INNER_MIN(C)   (MRIHTOL_CONTENT(C)->inner_min_tolfac)
+#define MRIHTOL_INNER_MAX(C)   (MRIHTOL_CONTENT(C)->inner_max_tolfac)
+
+/* ------------------
+ * Default parameters
+ * ------------------ */
+
+#define DEFAULT_INNER_MAX_RELCH  SUN_RCONST(20.0)
+#define DEFAULT_INNER_MIN_TOLFAC SUN_RCONST(1.0e-5)
+#define DEFAULT_INNER_MAX_TOLFAC SUN_RCONST(0.99)
+#define TINY                     SUN_RCONST(1.0e-10)
+
+/* -----------------------------------------------------------------
+ * exported functions
+ * ----------------------------------------------------------------- */
+
+/* -----------------------------------------------------------------
+ * Function to create a new MRIHTol controller from two controllers
+ * of type SUN_ADAPTCONTROLLER_H, one for the slow step size and one
+ * for the fast relative tolerance factor
+ */
+
+SUNAdaptController SUNAdaptController_MRIHTol(SUNContext sunctx,
+                                              SUNAdaptController HControl,
+                                              SUNAdaptController TolControl)
+{
+  SUNFunctionBegin(sunctx);
+
+  SUNAdaptController C;
+  SUNAdaptControllerContent_MRIHTol content;
+
+  /* Check for valid sub-controllers */
+  SUNAssertNull(HControl, SUN_ERR_ARG_CORRUPT);
+  SUNAssertNull(TolControl, SUN_ERR_ARG_CORRUPT);
+  SUNAssertNull(SUNAdaptController_GetType(HControl) == SUN_ADAPTCONTROLLER_H,
+                SUN_ERR_ARG_INCOMPATIBLE);
+  SUNAssertNull(SUNAdaptController_GetType(TolControl) ==
+                  SUN_ADAPTCONTROLLER_H,
+                SUN_ERR_ARG_INCOMPATIBLE);
+
+  /* Create an empty controller object */
+  C = NULL;
+  C = SUNAdaptController_NewEmpty(sunctx);
+  SUNCheckLastErrNull();
+
+  /* Attach operations */
+  C->ops->gettype         = SUNAdaptController_GetType_MRIHTol;
+  C->ops->estimatesteptol = SUNAdaptController_EstimateStepTol_MRIHTol;
+  C->ops->reset           = SUNAdaptController_Reset_MRIHTol;
+  C->ops->setdefaults     = SUNAdaptController_SetDefaults_MRIHTol;
+  C->ops->write           = SUNAdaptController_Write_MRIHTol;
+  C->ops->seterrorbias    = SUNAdaptController_SetErrorBias_MRIHTol;
+  C->ops->updatemrihtol   = SUNAdaptController_UpdateMRIHTol_MRIHTol;
+  C->ops->space           = SUNAdaptController_Space_MRIHTol;
+
+  /* Create content */
+  content = NULL;
+  content = (SUNAdaptControllerContent_MRIHTol)malloc(sizeof *content);
+  SUNAssertNull(content, SUN_ERR_MALLOC_FAIL);
+
+  /* Attach sub-controllers (these are owned by the user) */
+  content->HControl   = HControl;
+  content->TolControl = TolControl;
+
+  /* Attach content */
+  C->content = content;
+
+  /* Fill content with default values */
+  content->inner_max_relch  = DEFAULT_INNER_MAX_RELCH;
+  content->inner_min_tolfac = DEFAULT_INNER_MIN_TOLFAC;
+  content->inner_max_tolfac = DEFAULT_INNER_MAX_TOLFAC;
+
+  return (C);
+}
+
+/* -----------------------------------------------------------------
+ * Function to set MRIHTol parameters (non-positive values and
+ * inconsistent bounds restore the defaults)
+ */
+
+SUNErrCode SUNAdaptController_SetParams_MRIHTol(SUNAdaptController C,
+                                                sunrealtype inner_max_relch,
+                                                sunrealtype inner_min_tolfac,
+                                                sunrealtype inner_max_tolfac)
+{
+  SUNFunctionBegin(C->sunctx);
+
+  if (inner_max_relch <= SUN_RCONST(1.0))
+  {
+    MRIHTOL_INNER_RELCH(C) = DEFAULT_INNER_MAX_RELCH;
+  }
+  else { MRIHTOL_INNER_RELCH(C) = inner_max_relch; }
+
+  if ((inner_min_tolfac <= SUN_RCONST(0.0)) ||
+      (inner_max_tolfac <= SUN_RCONST(0.0)) ||
+      (inner_max_tolfac > SUN_RCONST(1.0)) ||
+      (inner_min_tolfac >= inner_max_tolfac))
+  {
+    MRIHTOL_INNER_MIN(C) = DEFAULT_INNER_MIN_TOLFAC;
+    MRIHTOL_INNER_MAX(C) = DEFAULT_INNER_MAX_TOLFAC;
+  }
+  else
+  {
+    MRIHTOL_INNER_MIN(C) = inner_min_tolfac;
+    MRIHTOL_INNER_MAX(C) = inner_max_tolfac;
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* -----------------------------------------------------------------
+ * implementation of controller operations
+ * ----------------------------------------------------------------- */
+
+SUNAdaptController_Type SUNAdaptController_GetType_MRIHTol(
+  SUNDIALS_MAYBE_UNUSED SUNAdaptController C)
+{
+  return SUN_ADAPTCONTROLLER_MRI_H_TOL;
+}
+
+SUNErrCode SUNAdaptController_EstimateStepTol_MRIHTol(
+  SUNAdaptController C, sunrealtype H, sunrealtype tolfac, int P,
+  sunrealtype DSM, sunrealtype dsm, sunrealtype* Hnew, sunrealtype* tolfacnew)
+{
+  SUNFunctionBegin(C->sunctx);
+
+  SUNAssert(Hnew, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(tolfacnew, SUN_ERR_ARG_CORRUPT);
+
+  sunrealtype tolfac_est, tolfac_min, tolfac_max;
+
+  /* slow step size from the slow error estimate */
+  SUNCheckCall(SUNAdaptController_EstimateStep(MRIHTOL_CSLOW(C), H, P, DSM,
+                                               Hnew));
+
+  /* the accumulated fast error is proportional to the fast tolerance,
+     so the tolerance factor is controlled as a "step" of order zero */
+  SUNCheckCall(SUNAdaptController_EstimateStep(MRIHTOL_CFAST(C), tolfac, 0,
+                                               SUNMAX(dsm, TINY), &tolfac_est));
+
+  /* limit the relative change and enforce the bounds */
+  tolfac_min = SUNMAX(tolfac / MRIHTOL_INNER_RELCH(C), MRIHTOL_INNER_MIN(C));
+  tolfac_max = SUNMIN(tolfac * MRIHTOL_INNER_RELCH(C), MRIHTOL_INNER_MAX(C));
+  *tolfacnew = SUNMIN(SUNMAX(tolfac_est, tolfac_min), tolfac_max);
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNAdaptController_Reset_MRIHTol(SUNAdaptController C)
+{
+  SUNFunctionBegin(C->sunctx);
+  SUNCheckCall(SUNAdaptController_Reset(MRIHTOL_CSLOW(C)));
+  SUNCheckCall(SUNAdaptController_Reset(MRIHTOL_CFAST(C)));
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNAdaptController_SetDefaults_MRIHTol(SUNAdaptController C)
+{
+  SUNFunctionBegin(C->sunctx);
+  SUNCheckCall(SUNAdaptController_SetDefaults(MRIHTOL_CSLOW(C)));
+  SUNCheckCall(SUNAdaptController_SetDefaults(MRIHTOL_CFAST(C)));
+  MRIHTOL_INNER_RELCH(C) = DEFAULT_INNER_MAX_RELCH;
+  MRIHTOL_INNER_MIN(C)   = DEFAULT_INNER_MIN_TOLFAC;
+  MRIHTOL_INNER_MAX(C)   = DEFAULT_INNER_MAX_TOLFAC;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNAdaptController_Write_MRIHTol(SUNAdaptController C, FILE* fptr)
+{
+  SUNFunctionBegin(C->sunctx);
+  SUNAssert(fptr, SUN_ERR_ARG_CORRUPT);
+  fprintf(fptr, "Multirate H-Tol SUNAdaptController module:\n");
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+  fprintf(fptr, "  inner_max_relch = %32Lg\n", MRIHTOL_INNER_RELCH(C));
+  fprintf(fptr, "  inner_min_tolfac = %32Lg\n", MRIHTOL_INNER_MIN(C));
+  fprintf(fptr, "  inner_max_tolfac = %32Lg\n", MRIHTOL_INNER_MAX(C));
+#else
+  fprintf(fptr, "  inner_max_relch = %16g\n", MRIHTOL_INNER_RELCH(C));
+  fprintf(fptr, "  inner_min_tolfac = %16g\n", MRIHTOL_INNER_MIN(C));
+  fprintf(fptr, "  inner_max_tolfac = %16g\n", MRIHTOL_INNER_MAX(C));
+#endif
+  fprintf(fptr, "\nSlow step controller:\n");
+  SUNCheckCall(SUNAdaptController_Write(MRIHTOL_CSLOW(C), fptr));
+  fprintf(fptr, "\nFast tolerance controller:\n");
+  SUNCheckCall(SUNAdaptController_Write(MRIHTOL_CFAST(C), fptr));
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNAdaptController_SetErrorBias_MRIHTol(SUNAdaptController C,
+                                                   sunrealtype bias)
+{
+  SUNFunctionBegin(C->sunctx);
+  SUNCheckCall(SUNAdaptController_SetErrorBias(MRIHTOL_CSLOW(C), bias));
+  SUNCheckCall(SUNAdaptController_SetErrorBias(MRIHTOL_CFAST(C), bias));
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNAdaptController_UpdateMRIHTol_MRIHTol(SUNAdaptController C,
+                                                    sunrealtype H,
+                                                    sunrealtype tolfac,
+                                                    sunrealtype DSM,
+                                                    sunrealtype dsm)
+{
+  SUNFunctionBegin(C->sunctx);
+  SUNCheckCall(SUNAdaptController_UpdateH(MRIHTOL_CSLOW(C), H, DSM));
+  SUNCheckCall(SUNAdaptController_UpdateH(MRIHTOL_CFAST(C), tolfac,
+                                          SUNMAX(dsm, TINY)));
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNAdaptController_Space_MRIHTol(SUNAdaptController C,
+                                            long int* lenrw, long int* leniw)
+{
+  SUNFunctionBegin(C->sunctx);
+  SUNAssert(lenrw, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(leniw, SUN_ERR_ARG_CORRUPT);
+  long int lrw, liw;
+  SUNCheckCall(SUNAdaptController_Space(MRIHTOL_CSLOW(C), lenrw, leniw));
+  SUNCheckCall(SUNAdaptController_Space(MRIHTOL_CFAST(C), &lrw, &liw));
+  *lenrw += lrw + 3;
+  *leniw += liw + 2;
+  return SUN_SUCCESS;
+}
@@ -209,6 +209,7 @@ module fsundials_core_mod
   type(C_FUNPTR), public :: nvwrmsnormmaskvectorarray
   type(C_FUNPTR), public :: nvscaleaddmultivectorarray
   type(C_FUNPTR), public :: nvlinearcombinationvectorarray
+  type(C_FUNPTR), public :: nvpascalshiftvectorarray
   type(C_FUNPTR), public :: nvdotprodlocal
   type(C_FUNPTR), public :: nvmaxnormlocal
   type(C_FUNPTR), public :: nvminlocal
@@ -271,6 +272,7 @@ module fsundials_core_mod
  public :: FN_VConstVectorArray
  public :: FN_VWrmsNormVectorArray
  public :: FN_VWrmsNormMaskVectorArray
+ public :: FN_VPascalShiftVectorArray
  public :: FN_VDotProdLocal
  public :: FN_VMaxNormLocal
  public :: FN_VMinLocal
@@ -415,6 +417,7 @@ module fsundials_core_mod
   type(C_FUNPTR), public :: initialize
   type(C_FUNPTR), public :: setup
   type(C_FUNPTR), public :: solve
+  type(C_FUNPTR), public :: solvemulti
   type(C_FUNPTR), public :: numiters
   type(C_FUNPTR), public :: resnorm
   type(C_FUNPTR), public :: lastflag
@@ -1217,6 +1220,15 @@ type(C_PTR), value :: farg5
 integer(C_INT) :: fresult
 end function
 
+function swigc_FN_VPascalShiftVectorArray(farg1, farg2) &
+bind(C, name="_wrap_FN_VPascalShiftVectorArray") &
+result(fresult)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT), intent(in) :: farg1
+type(C_PTR), value :: farg2
+integer(C_INT) :: fresult
+end function
+
 function swigc_FN_VDotProdLocal(farg1, farg2) &
 bind(C, name="_wrap_FN_VDotProdLocal") &
 result(fresult)
@@ -3284,6 +3296,22 @@ fresult = swigc_FN_VWrmsNormMaskVectorArray(farg1, farg2, farg3, farg4, farg5)
 swig_result = fresult
 end function
 
+function FN_VPascalShiftVectorArray(nvec, z) &
+result(swig_result)
+use, intrinsic :: ISO_C_BINDING
+integer(C_INT) :: swig_result
+integer(C_INT), intent(in) :: nvec
+type(C_PTR) :: z
+integer(C_INT) :: fresult 
+integer(C_INT) :: farg1 
+type(C_PTR) :: farg2 
+
+farg1 = nvec
+farg2 = z
+fresult = swigc_FN_VPascalShiftVectorArray(farg1, farg2)
+swig_result = fresult
+end function
+
 function FN_VDotProdLocal(x, y) &
 result(swig_result)
 use, intrinsic :: ISO_C_BINDING
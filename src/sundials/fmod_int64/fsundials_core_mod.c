@@ -1357,6 +1357,20 @@ SWIGEXPORT int _wrap_FN_VWrmsNormMaskVectorArray(int const *farg1, void *farg2,
 }
 
 
+SWIGEXPORT int _wrap_FN_VPascalShiftVectorArray(int const *farg1, void *farg2) {
+  int fresult ;
+  int arg1 ;
+  N_Vector *arg2 = (N_Vector *) 0 ;
+  SUNErrCode result;
+  
+  arg1 = (int)(*farg1);
+  arg2 = (N_Vector *)(farg2);
+  result = (SUNErrCode)N_VPascalShiftVectorArray(arg1,arg2);
+  fresult = (SUNErrCode)(result);
+  return fresult;
+}
+
+
 SWIGEXPORT double _wrap_FN_VDotProdLocal(N_Vector farg1, N_Vector farg2) {
   double fresult ;
   N_Vector arg1 = (N_Vector) 0 ;
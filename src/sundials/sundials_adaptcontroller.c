@@ -56,6 +56,9 @@ SUNAdaptController SUNAdaptController_NewEmpty(SUNContext sunctx)
   ops->updateh      = NULL;
   ops->space        = NULL;
 
+  ops->estimatesteptol = NULL;
+  ops->updatemrihtol   = NULL;
+
   /* attach ops and initialize content to NULL */
   C->ops     = ops;
   C->content = NULL;
@@ -137,6 +140,24 @@ SUNErrCode SUNAdaptController_EstimateStep(SUNAdaptController C, sunrealtype h,
   return (ier);
 }
 
+SUNErrCode SUNAdaptController_EstimateStepTol(
+  SUNAdaptController C, sunrealtype H, sunrealtype tolfac, int P,
+  sunrealtype DSM, sunrealtype dsm, sunrealtype* Hnew, sunrealtype* tolfacnew)
+{
+  SUNErrCode ier = SUN_SUCCESS;
+  if (C == NULL) { return SUN_ERR_ARG_CORRUPT; }
+  SUNFunctionBegin(C->sunctx);
+  SUNAssert(Hnew, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(tolfacnew, SUN_ERR_ARG_CORRUPT);
+  *Hnew      = H; /* initialize outputs with identity */
+  *tolfacnew = tolfac;
+  if (C->ops->estimatesteptol)
+  {
+    ier = C->ops->estimatesteptol(C, H, tolfac, P, DSM, dsm, Hnew, tolfacnew);
+  }
+  return (ier);
+}
+
 SUNErrCode SUNAdaptController_Reset(SUNAdaptController C)
 {
   SUNErrCode ier = SUN_SUCCESS;
@@ -184,6 +205,20 @@ SUNErrCode SUNAdaptController_UpdateH(SUNAdaptController C, sunrealtype h,
   return (ier);
 }
 
+SUNErrCode SUNAdaptController_UpdateMRIHTol(SUNAdaptController C, sunrealtype H,
+                                            sunrealtype tolfac, sunrealtype DSM,
+                                            sunrealtype dsm)
+{
+  SUNErrCode ier = SUN_SUCCESS;
+  if (C == NULL) { return SUN_ERR_ARG_CORRUPT; }
+  SUNFunctionBegin(C->sunctx);
+  if (C->ops->updatemrihtol)
+  {
+    ier = C->ops->updatemrihtol(C, H, tolfac, DSM, dsm);
+  }
+  return (ier);
+}
+
 SUNErrCode SUNAdaptController_Space(SUNAdaptController C, long int* lenrw,
                                     long int* leniw)
 {
@@ -66,6 +66,7 @@ SUNLinearSolver SUNLinSolNewEmpty(SUNContext sunctx)
   ops->initialize        = NULL;
   ops->setup             = NULL;
   ops->solve             = NULL;
+  ops->solvemulti        = NULL;
   ops->numiters          = NULL;
   ops->resnorm           = NULL;
   ops->resid             = NULL;
@@ -183,6 +184,26 @@ int SUNLinSolSolve(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
   return (ier);
 }
 
+int SUNLinSolSolveMulti(SUNLinearSolver S, SUNMatrix A, N_Vector* X,
+                        N_Vector* B, int nrhs, sunrealtype tol)
+{
+  int ier, i;
+  SUNDIALS_MARK_FUNCTION_BEGIN(getSUNProfiler(S));
+  if (S->ops->solvemulti) { ier = S->ops->solvemulti(S, A, X, B, nrhs, tol); }
+  else
+  {
+    /* fall back to one solve per right-hand side */
+    ier = SUN_SUCCESS;
+    for (i = 0; i < nrhs; i++)
+    {
+      ier = S->ops->solve(S, A, X[i], B[i], tol);
+      if (ier != SUN_SUCCESS) { break; }
+    }
+  }
+  SUNDIALS_MARK_FUNCTION_END(getSUNProfiler(S));
+  return (ier);
+}
+
 int SUNLinSolNumIters(SUNLinearSolver S)
 {
   int result;
@@ -118,6 +118,7 @@ N_Vector N_VNewEmpty(SUNContext sunctx)
   ops->nvwrmsnormmaskvectorarray      = NULL;
   ops->nvscaleaddmultivectorarray     = NULL;
   ops->nvlinearcombinationvectorarray = NULL;
+  ops->nvpascalshiftvectorarray       = NULL;
 
   /*
    * OPTIONAL operations with no default implementation.
@@ -242,6 +243,7 @@ SUNErrCode N_VCopyOps(N_Vector w, N_Vector v)
   v->ops->nvwrmsnormmaskvectorarray  = w->ops->nvwrmsnormmaskvectorarray;
   v->ops->nvscaleaddmultivectorarray = w->ops->nvscaleaddmultivectorarray;
   v->ops->nvlinearcombinationvectorarray = w->ops->nvlinearcombinationvectorarray;
+  v->ops->nvpascalshiftvectorarray       = w->ops->nvpascalshiftvectorarray;
 
   /*
    * OPTIONAL operations with no default implementation.
@@ -827,6 +829,34 @@ SUNErrCode N_VLinearCombinationVectorArray(int nvec, int nsum, sunrealtype* c,
   return (ier);
 }
 
+SUNErrCode N_VPascalShiftVectorArray(int nvec, N_Vector* Z)
+{
+  int j, k;
+  SUNErrCode ier;
+
+  SUNDIALS_MARK_FUNCTION_BEGIN(getSUNProfiler(Z[0]));
+
+  if (Z[0]->ops->nvpascalshiftvectorarray != NULL)
+  {
+    ier = Z[0]->ops->nvpascalshiftvectorarray(nvec, Z);
+  }
+  else
+  {
+    for (k = 1; k < nvec; k++)
+    {
+      for (j = nvec - 1; j >= k; j--)
+      {
+        Z[0]->ops->nvlinearsum(SUN_RCONST(1.0), Z[j - 1], SUN_RCONST(1.0), Z[j],
+                               Z[j - 1]);
+      }
+    }
+    ier = SUN_SUCCESS;
+  }
+
+  SUNDIALS_MARK_FUNCTION_END(getSUNProfiler(Z[0]));
+  return (ier);
+}
+
 /* -----------------------------------------------------------------
  * OPTIONAL local reduction kernels (no parallel communication)
  * -----------------------------------------------------------------*/
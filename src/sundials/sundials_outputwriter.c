@@ -0,0 +1,259 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the SUNOutputWriter.
+ *
+ * Each record is the time t (one sunrealtype) followed by the
+ * N_VBufPack data of y. A record is packed into one of two buffers
+ * by the caller. With Pthreads, a background thread writes full
+ * buffers to the file while the caller packs the next record into
+ * the other buffer; the caller only waits when both buffers are
+ * full. Without Pthreads, each record is written when it is given.
+ * -----------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_config.h>
+#include <sundials/sundials_errors.h>
+#include <sundials/sundials_outputwriter.h>
+
+#ifdef SUNDIALS_PTHREADS_ENABLED
+#include <pthread.h>
+#endif
+
+struct SUNOutputWriter_
+{
+  SUNContext sunctx;
+  FILE* fp;               /* output file                                */
+  size_t recsize;         /* bytes in a record: t and the packed vector */
+  char* buf[2];           /* record buffers                             */
+  sunbooleantype full[2]; /* buffer holds a record not yet written      */
+  int next;               /* buffer for the next record                 */
+  long int nrecords;      /* number of records given to the writer      */
+  SUNErrCode werr;        /* first error writing to the file            */
+#ifdef SUNDIALS_PTHREADS_ENABLED
+  pthread_t thread;     /* background writer thread                     */
+  pthread_mutex_t lock; /* protects full, werr, and done                */
+  pthread_cond_t cond;  /* signals a change of full or done             */
+  sunbooleantype done;  /* the writer thread should exit                */
+#endif
+};
+
+/* Writes a record to the file */
+static SUNErrCode writeRecord(SUNOutputWriter writer, const char* buf)
+{
+  if (fwrite(buf, 1, writer->recsize, writer->fp) != writer->recsize)
+  {
+    return SUN_ERR_OP_FAIL;
+  }
+  return SUN_SUCCESS;
+}
+
+#ifdef SUNDIALS_PTHREADS_ENABLED
+
+/* Background thread: writes the buffers, in order, as they fill up */
+static void* writerThread(void* arg)
+{
+  SUNOutputWriter writer = (SUNOutputWriter)arg;
+  SUNErrCode err;
+  int i = 0;
+
+  pthread_mutex_lock(&writer->lock);
+  for (;;)
+  {
+    while (!writer->full[i] && !writer->done)
+    {
+      pthread_cond_wait(&writer->cond, &writer->lock);
+    }
+    if (!writer->full[i]) { break; }
+
+    /* the caller does not touch a full buffer, so write it unlocked */
+    pthread_mutex_unlock(&writer->lock);
+    err = writeRecord(writer, writer->buf[i]);
+    pthread_mutex_lock(&writer->lock);
+
+    if (err != SUN_SUCCESS && writer->werr == SUN_SUCCESS)
+    {
+      writer->werr = err;
+    }
+    writer->full[i] = SUNFALSE;
+    pthread_cond_broadcast(&writer->cond);
+    i = 1 - i;
+  }
+  pthread_mutex_unlock(&writer->lock);
+
+  return NULL;
+}
+
+#endif
+
+SUNErrCode SUNOutputWriter_Create(N_Vector tmpl, FILE* fp, SUNContext sunctx,
+                                  SUNOutputWriter* writer_out)
+{
+  SUNFunctionBegin(sunctx);
+  SUNOutputWriter writer;
+  sunindextype bufsize;
+  int i;
+
+  SUNAssert(tmpl, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(fp, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(writer_out, SUN_ERR_ARG_CORRUPT);
+
+  /* the vector must support packing */
+  if (tmpl->ops->nvbufsize == NULL || tmpl->ops->nvbufpack == NULL)
+  {
+    return SUN_ERR_ARG_INCOMPATIBLE;
+  }
+  SUNCheckCall(N_VBufSize(tmpl, &bufsize));
+
+  writer = NULL;
+  writer = (SUNOutputWriter)malloc(sizeof(*writer));
+  if (writer == NULL) { return SUN_ERR_MALLOC_FAIL; }
+
+  writer->sunctx   = sunctx;
+  writer->fp       = fp;
+  writer->recsize  = sizeof(sunrealtype) + (size_t)bufsize;
+  writer->next     = 0;
+  writer->nrecords = 0;
+  writer->werr     = SUN_SUCCESS;
+  for (i = 0; i < 2; i++)
+  {
+    writer->full[i] = SUNFALSE;
+    writer->buf[i]  = (char*)malloc(writer->recsize);
+  }
+  if (writer->buf[0] == NULL || writer->buf[1] == NULL)
+  {
+    free(writer->buf[0]);
+    free(writer->buf[1]);
+    free(writer);
+    return SUN_ERR_MALLOC_FAIL;
+  }
+
+#ifdef SUNDIALS_PTHREADS_ENABLED
+  writer->done = SUNFALSE;
+  pthread_mutex_init(&writer->lock, NULL);
+  pthread_cond_init(&writer->cond, NULL);
+  if (pthread_create(&writer->thread, NULL, writerThread, writer))
+  {
+    pthread_cond_destroy(&writer->cond);
+    pthread_mutex_destroy(&writer->lock);
+    free(writer->buf[0]);
+    free(writer->buf[1]);
+    free(writer);
+    return SUN_ERR_EXT_FAIL;
+  }
+#endif
+
+  *writer_out = writer;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNOutputWriter_Write(SUNOutputWriter writer, sunrealtype t,
+                                 N_Vector y)
+{
+  SUNFunctionBegin(writer->sunctx);
+  SUNErrCode err;
+  char* buf;
+
+#ifdef SUNDIALS_PTHREADS_ENABLED
+  /* wait for the writer thread to release the next buffer */
+  pthread_mutex_lock(&writer->lock);
+  while (writer->full[writer->next])
+  {
+    pthread_cond_wait(&writer->cond, &writer->lock);
+  }
+  err = writer->werr;
+  pthread_mutex_unlock(&writer->lock);
+  if (err != SUN_SUCCESS) { return err; }
+#endif
+
+  /* pack the record */
+  buf = writer->buf[writer->next];
+  memcpy(buf, &t, sizeof(sunrealtype));
+  SUNCheckCall(N_VBufPack(y, buf + sizeof(sunrealtype)));
+  writer->nrecords++;
+
+#ifdef SUNDIALS_PTHREADS_ENABLED
+  /* hand the buffer to the writer thread */
+  pthread_mutex_lock(&writer->lock);
+  writer->full[writer->next] = SUNTRUE;
+  pthread_cond_broadcast(&writer->cond);
+  pthread_mutex_unlock(&writer->lock);
+  writer->next = 1 - writer->next;
+#else
+  err = writeRecord(writer, buf);
+  if (err != SUN_SUCCESS) { return err; }
+#endif
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNOutputWriter_Flush(SUNOutputWriter writer)
+{
+  SUNErrCode err = SUN_SUCCESS;
+
+#ifdef SUNDIALS_PTHREADS_ENABLED
+  /* wait for the writer thread to write all pending records */
+  pthread_mutex_lock(&writer->lock);
+  while (writer->full[0] || writer->full[1])
+  {
+    pthread_cond_wait(&writer->cond, &writer->lock);
+  }
+  err = writer->werr;
+  pthread_mutex_unlock(&writer->lock);
+  if (err != SUN_SUCCESS) { return err; }
+#endif
+
+  if (fflush(writer->fp)) { err = SUN_ERR_OP_FAIL; }
+
+  return err;
+}
+
+SUNErrCode SUNOutputWriter_GetNumRecords(SUNOutputWriter writer,
+                                         long int* nrecords)
+{
+  *nrecords = writer->nrecords;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNOutputWriter_Destroy(SUNOutputWriter* writer)
+{
+  SUNErrCode err;
+
+  if (writer == NULL || *writer == NULL) { return SUN_SUCCESS; }
+
+  /* write all pending records and stop the writer thread */
+  err = SUNOutputWriter_Flush(*writer);
+
+#ifdef SUNDIALS_PTHREADS_ENABLED
+  pthread_mutex_lock(&(*writer)->lock);
+  (*writer)->done = SUNTRUE;
+  pthread_cond_broadcast(&(*writer)->cond);
+  pthread_mutex_unlock(&(*writer)->lock);
+  pthread_join((*writer)->thread, NULL);
+  pthread_cond_destroy(&(*writer)->cond);
+  pthread_mutex_destroy(&(*writer)->lock);
+#endif
+
+  free((*writer)->buf[0]);
+  free((*writer)->buf[1]);
+  free(*writer);
+  *writer = NULL;
+
+  return err;
+}
+
+int SUNOutputWriter_OutputFn(sunrealtype t, N_Vector y, void* output_data)
+{
+  return (SUNOutputWriter_Write((SUNOutputWriter)output_data, t, y) !=
+          SUN_SUCCESS);
+}
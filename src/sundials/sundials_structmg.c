@@ -0,0 +1,778 @@
+/* -----------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------
+ * This is the implementation file for the SUNStructMG.
+ *
+ * The operator A = c0 I - s L is never stored, each level
+ * rediscretizes the star stencil of L with its own mesh spacing.
+ * Coarse levels keep every other node of the finer level, so each
+ * process coarsens its own subdomain. The smoother is weighted
+ * Jacobi, restriction is full weighting, and prolongation is
+ * multilinear interpolation. Levels are added while the number of
+ * mesh intervals in every direction is even and every process owns
+ * at least one node of the coarser level, so grids with 2^k + 1
+ * nodes in each direction give the deepest hierarchy.
+ *
+ * Level arrays have a ghost layer in each direction of the grid.
+ * The ghost layers are exchanged one direction at a time and each
+ * message includes the ghost nodes of the other directions, so the
+ * edge and corner ghost nodes are also filled.
+ * -----------------------------------------------------------------*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <sundials/priv/sundials_errors_impl.h>
+#include <sundials/sundials_config.h>
+#include <sundials/sundials_errors.h>
+#include <sundials/sundials_structmg.h>
+
+#include "sundials_macros.h"
+
+#if SUNDIALS_MPI_ENABLED
+#include <sundials/sundials_mpi_types.h>
+#endif
+
+#define ZERO SUN_RCONST(0.0)
+#define HALF SUN_RCONST(0.5)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+/* Weighted Jacobi damping factor and number of coarsest level sweeps */
+#define STRUCTMG_OMEGA   SUN_RCONST(0.8)
+#define STRUCTMG_NCOARSE 20
+
+#define MAXDIM SUN_STRUCTMG_MAXDIM
+
+typedef struct
+{
+  sunindextype n[MAXDIM];      /* global nodes per direction              */
+  sunindextype start[MAXDIM];  /* global index of the first local node    */
+  sunindextype nloc[MAXDIM];   /* local nodes per direction               */
+  sunindextype ng[MAXDIM];     /* local nodes with the ghost layer        */
+  sunindextype stride[MAXDIM]; /* strides of the level arrays             */
+  sunindextype origin;         /* array index of the first local node     */
+  sunindextype len;            /* length of the level arrays              */
+  sunrealtype coef[MAXDIM];    /* stencil coefficients on this level      */
+  sunrealtype* u;              /* solution                                */
+  sunrealtype* f;              /* right-hand side                         */
+  sunrealtype* w;              /* residual and smoother work array        */
+} SUNStructMGLevel;
+
+struct SUNStructMG_
+{
+  SUNContext sunctx;
+  int dim;                 /* number of grid directions              */
+  int nbr[MAXDIM][2];      /* lower and upper neighbor ranks         */
+  SUNComm comm;            /* communicator of the neighbor ranks     */
+  int nlevels;             /* number of levels                       */
+  SUNStructMGLevel* lev;   /* levels from finest (0) to coarsest     */
+  int sweeps;              /* pre- and post-smoothing sweeps         */
+  sunrealtype c0;          /* operator coefficients, A = c0 I - s L  */
+  sunrealtype s;           /* operator coefficients, A = c0 I - s L  */
+  sunrealtype* buf[2][2];  /* send and receive buffers for each side */
+};
+
+/* -----------------------------------------------------------------
+ * Private helper functions
+ * -----------------------------------------------------------------*/
+
+/* Set the ghosted array layout of a level and allocate its arrays */
+static SUNErrCode initLevel(SUNStructMGLevel* L, int dim)
+{
+  sunindextype gw;
+  int d;
+
+  L->len = 1;
+  L->origin = 0;
+  for (d = 0; d < MAXDIM; d++)
+  {
+    gw           = (d < dim) ? 1 : 0;
+    L->ng[d]     = L->nloc[d] + 2 * gw;
+    L->stride[d] = L->len;
+    L->origin += gw * L->stride[d];
+    L->len *= L->ng[d];
+  }
+
+  L->u = (sunrealtype*)calloc((size_t)L->len, sizeof(sunrealtype));
+  L->f = (sunrealtype*)calloc((size_t)L->len, sizeof(sunrealtype));
+  L->w = (sunrealtype*)calloc((size_t)L->len, sizeof(sunrealtype));
+  if (L->u == NULL || L->f == NULL || L->w == NULL)
+  {
+    return SUN_ERR_MALLOC_FAIL;
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* Check if a local node is on the global boundary */
+static sunbooleantype onBoundary(const SUNStructMGLevel* L, int dim,
+                                 const sunindextype* idx)
+{
+  sunindextype gidx;
+  int d;
+
+  for (d = 0; d < dim; d++)
+  {
+    gidx = L->start[d] + idx[d];
+    if (gidx == 0 || gidx == L->n[d] - 1) { return SUNTRUE; }
+  }
+  return SUNFALSE;
+}
+
+#if SUNDIALS_MPI_ENABLED
+/* Copy the slab of the level array a at ghosted position pos in
+   direction d to buf (pack = SUNTRUE) or from buf to a */
+static sunindextype copySlab(const SUNStructMGLevel* L, int d,
+                             sunindextype pos, sunrealtype* a,
+                             sunrealtype* buf, sunbooleantype pack)
+{
+  sunindextype lo[MAXDIM], hi[MAXDIM], i, j, k, g, m = 0;
+  int e;
+
+  for (e = 0; e < MAXDIM; e++)
+  {
+    lo[e] = 0;
+    hi[e] = L->ng[e];
+  }
+  lo[d] = pos;
+  hi[d] = pos + 1;
+
+  for (k = lo[2]; k < hi[2]; k++)
+  {
+    for (j = lo[1]; j < hi[1]; j++)
+    {
+      for (i = lo[0]; i < hi[0]; i++)
+      {
+        g = i + L->stride[1] * j + L->stride[2] * k;
+        if (pack) { buf[m++] = a[g]; }
+        else { a[g] = buf[m++]; }
+      }
+    }
+  }
+
+  return m;
+}
+#endif
+
+/* Fill the ghost layer of a level array with the values from the
+   neighbors. Messages sent to the lower neighbor in direction d have
+   tag 2 d and messages sent to the upper neighbor have tag 2 d + 1. */
+static SUNErrCode exchange(SUNDIALS_MAYBE_UNUSED SUNStructMG mg,
+                           SUNDIALS_MAYBE_UNUSED SUNStructMGLevel* L,
+                           SUNDIALS_MAYBE_UNUSED sunrealtype* a)
+{
+#if SUNDIALS_MPI_ENABLED
+  MPI_Request req[4];
+  sunindextype count;
+  int d, side, nreq;
+
+  for (d = 0; d < mg->dim; d++)
+  {
+    nreq  = 0;
+    count = L->len / L->ng[d];
+    for (side = 0; side < 2; side++)
+    {
+      if (mg->nbr[d][side] < 0) { continue; }
+
+      copySlab(L, d, (side == 0) ? 1 : L->nloc[d], a, mg->buf[side][0],
+               SUNTRUE);
+      if (MPI_Irecv(mg->buf[side][1], (int)count, MPI_SUNREALTYPE,
+                    mg->nbr[d][side], 2 * d + (side == 0 ? 1 : 0), mg->comm,
+                    &req[nreq++]) != MPI_SUCCESS)
+      {
+        return SUN_ERR_MPI_FAIL;
+      }
+      if (MPI_Isend(mg->buf[side][0], (int)count, MPI_SUNREALTYPE,
+                    mg->nbr[d][side], 2 * d + side, mg->comm,
+                    &req[nreq++]) != MPI_SUCCESS)
+      {
+        return SUN_ERR_MPI_FAIL;
+      }
+    }
+    if (MPI_Waitall(nreq, req, MPI_STATUSES_IGNORE) != MPI_SUCCESS)
+    {
+      return SUN_ERR_MPI_FAIL;
+    }
+
+    for (side = 0; side < 2; side++)
+    {
+      if (mg->nbr[d][side] < 0) { continue; }
+      copySlab(L, d, (side == 0) ? 0 : L->nloc[d] + 1, a, mg->buf[side][1],
+               SUNFALSE);
+    }
+  }
+#endif
+
+  return SUN_SUCCESS;
+}
+
+/* Weighted Jacobi sweeps for A u = f, boundary nodes are solved exactly */
+static SUNErrCode smooth(SUNStructMG mg, SUNStructMGLevel* L, int sweeps)
+{
+  sunrealtype sc[MAXDIM], dd, Au, *tmp;
+  sunindextype idx[MAXDIM], g;
+  int d, sweep;
+
+  dd = mg->c0;
+  for (d = 0; d < MAXDIM; d++)
+  {
+    sc[d] = (d < mg->dim) ? mg->s * L->coef[d] : ZERO;
+    dd += TWO * sc[d];
+  }
+
+  for (sweep = 0; sweep < sweeps; sweep++)
+  {
+    SUNErrCode err = exchange(mg, L, L->u);
+    if (err != SUN_SUCCESS) { return err; }
+
+    for (idx[2] = 0; idx[2] < L->nloc[2]; idx[2]++)
+    {
+      for (idx[1] = 0; idx[1] < L->nloc[1]; idx[1]++)
+      {
+        for (idx[0] = 0; idx[0] < L->nloc[0]; idx[0]++)
+        {
+          g = L->origin + idx[0] + L->stride[1] * idx[1] +
+              L->stride[2] * idx[2];
+          if (onBoundary(L, mg->dim, idx)) { L->w[g] = L->f[g] / mg->c0; }
+          else
+          {
+            Au = dd * L->u[g];
+            for (d = 0; d < mg->dim; d++)
+            {
+              Au -= sc[d] * (L->u[g - L->stride[d]] + L->u[g + L->stride[d]]);
+            }
+            L->w[g] = L->u[g] + STRUCTMG_OMEGA * (L->f[g] - Au) / dd;
+          }
+        }
+      }
+    }
+
+    tmp  = L->u;
+    L->u = L->w;
+    L->w = tmp;
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* Compute the residual w = f - A u */
+static SUNErrCode residual(SUNStructMG mg, SUNStructMGLevel* L)
+{
+  sunrealtype sc[MAXDIM], dd;
+  sunindextype idx[MAXDIM], g;
+  SUNErrCode err;
+  int d;
+
+  dd = mg->c0;
+  for (d = 0; d < MAXDIM; d++)
+  {
+    sc[d] = (d < mg->dim) ? mg->s * L->coef[d] : ZERO;
+    dd += TWO * sc[d];
+  }
+
+  err = exchange(mg, L, L->u);
+  if (err != SUN_SUCCESS) { return err; }
+
+  for (idx[2] = 0; idx[2] < L->nloc[2]; idx[2]++)
+  {
+    for (idx[1] = 0; idx[1] < L->nloc[1]; idx[1]++)
+    {
+      for (idx[0] = 0; idx[0] < L->nloc[0]; idx[0]++)
+      {
+        g = L->origin + idx[0] + L->stride[1] * idx[1] + L->stride[2] * idx[2];
+        if (onBoundary(L, mg->dim, idx))
+        {
+          L->w[g] = L->f[g] - mg->c0 * L->u[g];
+        }
+        else
+        {
+          L->w[g] = L->f[g] - dd * L->u[g];
+          for (d = 0; d < mg->dim; d++)
+          {
+            L->w[g] += sc[d] * (L->u[g - L->stride[d]] + L->u[g + L->stride[d]]);
+          }
+        }
+      }
+    }
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* Full weighting restriction of the fine residual to the coarse
+   right-hand side, the coarse initial guess is set to zero */
+static SUNErrCode restrictResidual(SUNStructMG mg, SUNStructMGLevel* F,
+                                   SUNStructMGLevel* C)
+{
+  /* one dimensional weights of the offsets -1, 0, and 1 */
+  const sunrealtype wt[3] = {SUN_RCONST(0.25), HALF, SUN_RCONST(0.25)};
+  sunindextype idx[MAXDIM], fidx, g, G, o[MAXDIM], a[MAXDIM];
+  sunrealtype sum;
+  SUNErrCode err;
+  int d;
+
+  err = exchange(mg, F, F->w);
+  if (err != SUN_SUCCESS) { return err; }
+
+  for (d = 0; d < MAXDIM; d++) { a[d] = (d < mg->dim) ? 1 : 0; }
+
+  for (idx[2] = 0; idx[2] < C->nloc[2]; idx[2]++)
+  {
+    for (idx[1] = 0; idx[1] < C->nloc[1]; idx[1]++)
+    {
+      for (idx[0] = 0; idx[0] < C->nloc[0]; idx[0]++)
+      {
+        G = C->origin + idx[0] + C->stride[1] * idx[1] + C->stride[2] * idx[2];
+
+        C->u[G] = ZERO;
+
+        if (onBoundary(C, mg->dim, idx))
+        {
+          C->f[G] = ZERO;
+          continue;
+        }
+
+        /* fine grid array index of the coarse node */
+        g = F->origin;
+        for (d = 0; d < mg->dim; d++)
+        {
+          fidx = 2 * (C->start[d] + idx[d]) - F->start[d];
+          g += F->stride[d] * fidx;
+        }
+
+        sum = ZERO;
+        for (o[2] = -a[2]; o[2] <= a[2]; o[2]++)
+        {
+          for (o[1] = -a[1]; o[1] <= a[1]; o[1]++)
+          {
+            for (o[0] = -a[0]; o[0] <= a[0]; o[0]++)
+            {
+              sunrealtype w = ONE;
+              for (d = 0; d < mg->dim; d++) { w *= wt[o[d] + 1]; }
+              sum += w * F->w[g + o[0] + F->stride[1] * o[1] +
+                              F->stride[2] * o[2]];
+            }
+          }
+        }
+        C->f[G] = sum;
+      }
+    }
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* Multilinear interpolation of the coarse solution added to the fine
+   solution */
+static SUNErrCode prolong(SUNStructMG mg, SUNStructMGLevel* C,
+                          SUNStructMGLevel* F)
+{
+  sunindextype idx[MAXDIM], gidx, g, G, o[MAXDIM], a[MAXDIM];
+  sunrealtype val, w;
+  SUNErrCode err;
+  int d;
+
+  err = exchange(mg, C, C->u);
+  if (err != SUN_SUCCESS) { return err; }
+
+  for (idx[2] = 0; idx[2] < F->nloc[2]; idx[2]++)
+  {
+    for (idx[1] = 0; idx[1] < F->nloc[1]; idx[1]++)
+    {
+      for (idx[0] = 0; idx[0] < F->nloc[0]; idx[0]++)
+      {
+        if (onBoundary(F, mg->dim, idx)) { continue; }
+
+        /* nearest coarse node below and the number of coarse nodes used
+           in each direction (two for fine nodes between coarse nodes) */
+        G = C->origin;
+        for (d = 0; d < MAXDIM; d++)
+        {
+          a[d] = 0;
+          if (d < mg->dim)
+          {
+            gidx = F->start[d] + idx[d];
+            G += C->stride[d] * (gidx / 2 - C->start[d]);
+            a[d] = gidx % 2;
+          }
+        }
+
+        val = ZERO;
+        for (o[2] = 0; o[2] <= a[2]; o[2]++)
+        {
+          for (o[1] = 0; o[1] <= a[1]; o[1]++)
+          {
+            for (o[0] = 0; o[0] <= a[0]; o[0]++)
+            {
+              w = ONE;
+              for (d = 0; d < mg->dim; d++)
+              {
+                if (a[d]) { w *= HALF; }
+              }
+              val += w * C->u[G + o[0] + C->stride[1] * o[1] +
+                              C->stride[2] * o[2]];
+            }
+          }
+        }
+
+        g = F->origin + idx[0] + F->stride[1] * idx[1] + F->stride[2] * idx[2];
+        F->u[g] += val;
+      }
+    }
+  }
+
+  return SUN_SUCCESS;
+}
+
+/* Copy between a vector and the interior of a level array */
+static void copyVector(SUNStructMGLevel* L, sunrealtype* v, sunrealtype* a,
+                       sunbooleantype toLevel)
+{
+  sunindextype i, j, k, g, m = 0;
+
+  for (k = 0; k < L->nloc[2]; k++)
+  {
+    for (j = 0; j < L->nloc[1]; j++)
+    {
+      g = L->origin + L->stride[1] * j + L->stride[2] * k;
+      for (i = 0; i < L->nloc[0]; i++)
+      {
+        if (toLevel) { a[g + i] = v[m++]; }
+        else { v[m++] = a[g + i]; }
+      }
+    }
+  }
+}
+
+/* -----------------------------------------------------------------
+ * Exported functions
+ * -----------------------------------------------------------------*/
+
+SUNErrCode SUNStructMG_Create(const SUNStructGrid* grid,
+                              const SUNStructStencil* stencil, int maxlevels,
+                              SUNContext sunctx, SUNStructMG* mg_out)
+{
+  SUNFunctionBegin(sunctx);
+  SUNStructMG mg;
+  SUNStructMGLevel *F, *C;
+  sunindextype maxslab;
+  long int nmin;
+  SUNErrCode err;
+  int d, side, l;
+
+  SUNAssert(grid, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(stencil, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(mg_out, SUN_ERR_ARG_CORRUPT);
+
+  if (grid->dim < 1 || grid->dim > MAXDIM) { return SUN_ERR_ARG_OUTOFRANGE; }
+  for (d = 0; d < grid->dim; d++)
+  {
+    if (grid->n[d] < 1 || grid->nloc[d] < 1 || grid->start[d] < 0 ||
+        grid->start[d] + grid->nloc[d] > grid->n[d])
+    {
+      return SUN_ERR_ARG_OUTOFRANGE;
+    }
+#if !SUNDIALS_MPI_ENABLED
+    if (grid->nbr[d][0] >= 0 || grid->nbr[d][1] >= 0)
+    {
+      return SUN_ERR_ARG_OUTOFRANGE;
+    }
+#endif
+  }
+
+  mg = NULL;
+  mg = (SUNStructMG)malloc(sizeof(*mg));
+  if (mg == NULL) { return SUN_ERR_MALLOC_FAIL; }
+
+  mg->sunctx  = sunctx;
+  mg->dim     = grid->dim;
+  mg->comm    = grid->comm;
+  mg->sweeps  = 2;
+  mg->c0      = ONE;
+  mg->s       = ZERO;
+  mg->nlevels = 0;
+  mg->lev     = NULL;
+  for (d = 0; d < MAXDIM; d++)
+  {
+    for (side = 0; side < 2; side++)
+    {
+      mg->nbr[d][side] = (d < grid->dim) ? grid->nbr[d][side] : -1;
+    }
+  }
+  for (side = 0; side < 2; side++)
+  {
+    mg->buf[side][0] = NULL;
+    mg->buf[side][1] = NULL;
+  }
+
+  /* there are at most as many levels as times a global direction can be
+     halved */
+  mg->lev = (SUNStructMGLevel*)calloc(8 * sizeof(sunindextype),
+                                      sizeof(SUNStructMGLevel));
+  if (mg->lev == NULL)
+  {
+    free(mg);
+    return SUN_ERR_MALLOC_FAIL;
+  }
+
+  /* finest level is the problem grid */
+  F = &(mg->lev[0]);
+  for (d = 0; d < MAXDIM; d++)
+  {
+    F->n[d]     = (d < grid->dim) ? grid->n[d] : 1;
+    F->start[d] = (d < grid->dim) ? grid->start[d] : 0;
+    F->nloc[d]  = (d < grid->dim) ? grid->nloc[d] : 1;
+    F->coef[d]  = (d < grid->dim) ? stencil->coef[d] : ZERO;
+  }
+  mg->nlevels = 1;
+
+  /* add coarse levels */
+  while (maxlevels <= 0 || mg->nlevels < maxlevels)
+  {
+    F = &(mg->lev[mg->nlevels - 1]);
+    C = &(mg->lev[mg->nlevels]);
+
+    nmin = 1;
+    for (d = 0; d < MAXDIM; d++)
+    {
+      if (d >= mg->dim)
+      {
+        C->n[d]     = 1;
+        C->start[d] = 0;
+        C->nloc[d]  = 1;
+        C->coef[d]  = ZERO;
+        continue;
+      }
+
+      if ((F->n[d] - 1) % 2 != 0 || (F->n[d] - 1) / 2 + 1 < 3) { nmin = -1; }
+
+      /* coarse nodes are the fine nodes with even global indices */
+      C->n[d]     = (F->n[d] - 1) / 2 + 1;
+      C->start[d] = (F->start[d] + 1) / 2;
+      C->nloc[d]  = (F->start[d] + F->nloc[d] - 1) / 2 - C->start[d] + 1;
+      C->coef[d]  = F->coef[d] / SUN_RCONST(4.0);
+
+      if (C->nloc[d] < nmin) { nmin = C->nloc[d]; }
+    }
+
+    /* every process must own a coarse node in each direction */
+#if SUNDIALS_MPI_ENABLED
+    if (mg->comm != MPI_COMM_NULL)
+    {
+      if (MPI_Allreduce(MPI_IN_PLACE, &nmin, 1, MPI_LONG, MPI_MIN, mg->comm) !=
+          MPI_SUCCESS)
+      {
+        SUNStructMG_Destroy(&mg);
+        return SUN_ERR_MPI_FAIL;
+      }
+    }
+#endif
+    if (nmin < 1) { break; }
+
+    mg->nlevels++;
+  }
+
+  /* allocate the level arrays */
+  for (l = 0; l < mg->nlevels; l++)
+  {
+    err = initLevel(&(mg->lev[l]), mg->dim);
+    if (err != SUN_SUCCESS)
+    {
+      SUNStructMG_Destroy(&mg);
+      return err;
+    }
+  }
+
+  /* allocate the exchange buffers for the largest slab of the finest level */
+  F       = &(mg->lev[0]);
+  maxslab = 0;
+  for (d = 0; d < mg->dim; d++)
+  {
+    if (F->len / F->ng[d] > maxslab) { maxslab = F->len / F->ng[d]; }
+  }
+  for (side = 0; side < 2; side++)
+  {
+    for (d = 0; d < 2; d++)
+    {
+      mg->buf[side][d] = (sunrealtype*)malloc((size_t)maxslab *
+                                              sizeof(sunrealtype));
+      if (mg->buf[side][d] == NULL)
+      {
+        SUNStructMG_Destroy(&mg);
+        return SUN_ERR_MALLOC_FAIL;
+      }
+    }
+  }
+
+  *mg_out = mg;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNStructMG_SetNumSweeps(SUNStructMG mg, int sweeps)
+{
+  mg->sweeps = (sweeps > 0) ? sweeps : 2;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNStructMG_SetOperator(SUNStructMG mg, sunrealtype c0,
+                                   sunrealtype s)
+{
+  if (c0 == ZERO) { return SUN_ERR_ARG_OUTOFRANGE; }
+  mg->c0 = c0;
+  mg->s  = s;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNStructMG_Solve(SUNStructMG mg, N_Vector r, N_Vector z)
+{
+  SUNStructMGLevel* lev = mg->lev;
+  int nlevels           = mg->nlevels;
+  sunrealtype *rdata, *zdata;
+  SUNErrCode err;
+  int l;
+
+  rdata = N_VGetArrayPointer(r);
+  zdata = N_VGetArrayPointer(z);
+  if (rdata == NULL || zdata == NULL) { return SUN_ERR_ARG_INCOMPATIBLE; }
+
+  /* copy the right-hand side into the finest level with a zero initial
+     guess */
+  copyVector(&lev[0], rdata, lev[0].f, SUNTRUE);
+  memset(lev[0].u, 0, (size_t)lev[0].len * sizeof(sunrealtype));
+
+  /* smooth and restrict down to the coarsest level */
+  for (l = 0; l < nlevels - 1; l++)
+  {
+    err = smooth(mg, &lev[l], mg->sweeps);
+    if (err != SUN_SUCCESS) { return err; }
+
+    err = residual(mg, &lev[l]);
+    if (err != SUN_SUCCESS) { return err; }
+
+    err = restrictResidual(mg, &lev[l], &lev[l + 1]);
+    if (err != SUN_SUCCESS) { return err; }
+  }
+
+  /* approximate coarsest level solve */
+  err = smooth(mg, &lev[nlevels - 1],
+               (nlevels > 1) ? STRUCTMG_NCOARSE : mg->sweeps);
+  if (err != SUN_SUCCESS) { return err; }
+
+  /* prolong and smooth up to the finest level */
+  for (l = nlevels - 2; l >= 0; l--)
+  {
+    err = prolong(mg, &lev[l + 1], &lev[l]);
+    if (err != SUN_SUCCESS) { return err; }
+
+    err = smooth(mg, &lev[l], mg->sweeps);
+    if (err != SUN_SUCCESS) { return err; }
+  }
+
+  /* copy the solution out of the finest level */
+  copyVector(&lev[0], zdata, lev[0].u, SUNFALSE);
+
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNStructMG_GetNumLevels(SUNStructMG mg, int* nlevels)
+{
+  *nlevels = mg->nlevels;
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNStructMG_GetCoarseGrid(SUNStructMG mg, sunindextype* n)
+{
+  int d;
+  for (d = 0; d < mg->dim; d++) { n[d] = mg->lev[mg->nlevels - 1].n[d]; }
+  return SUN_SUCCESS;
+}
+
+SUNErrCode SUNStructMG_Destroy(SUNStructMG* mg)
+{
+  int l, side, d;
+
+  if (mg == NULL || *mg == NULL) { return SUN_SUCCESS; }
+
+  if ((*mg)->lev)
+  {
+    for (l = 0; l < (*mg)->nlevels; l++)
+    {
+      free((*mg)->lev[l].u);
+      free((*mg)->lev[l].f);
+      free((*mg)->lev[l].w);
+    }
+    free((*mg)->lev);
+  }
+  for (side = 0; side < 2; side++)
+  {
+    for (d = 0; d < 2; d++) { free((*mg)->buf[side][d]); }
+  }
+  free(*mg);
+  *mg = NULL;
+
+  return SUN_SUCCESS;
+}
+
+/* -----------------------------------------------------------------
+ * Preconditioner setup and solve functions
+ * -----------------------------------------------------------------*/
+
+int SUNStructMG_ODEPrecSetup(SUNDIALS_MAYBE_UNUSED sunrealtype t,
+                             SUNDIALS_MAYBE_UNUSED N_Vector y,
+                             SUNDIALS_MAYBE_UNUSED N_Vector fy,
+                             SUNDIALS_MAYBE_UNUSED sunbooleantype jok,
+                             sunbooleantype* jcurPtr, sunrealtype gamma,
+                             void* P_data)
+{
+  /* the operator is applied matrix-free, only its coefficients are stored */
+  *jcurPtr = SUNTRUE;
+  return (SUNStructMG_SetOperator((SUNStructMG)P_data, ONE, gamma) !=
+          SUN_SUCCESS);
+}
+
+int SUNStructMG_ODEPrecSolve(SUNDIALS_MAYBE_UNUSED sunrealtype t,
+                             SUNDIALS_MAYBE_UNUSED N_Vector y,
+                             SUNDIALS_MAYBE_UNUSED N_Vector fy, N_Vector r,
+                             N_Vector z, sunrealtype gamma,
+                             SUNDIALS_MAYBE_UNUSED sunrealtype delta,
+                             SUNDIALS_MAYBE_UNUSED int lr, void* P_data)
+{
+  SUNStructMG mg = (SUNStructMG)P_data;
+
+  /* use the current gamma, it may differ from the one of the last setup */
+  if (SUNStructMG_SetOperator(mg, ONE, gamma) != SUN_SUCCESS) { return 1; }
+  return (SUNStructMG_Solve(mg, r, z) != SUN_SUCCESS) ? -1 : 0;
+}
+
+int SUNStructMG_DAEPrecSetup(SUNDIALS_MAYBE_UNUSED sunrealtype t,
+                             SUNDIALS_MAYBE_UNUSED N_Vector y,
+                             SUNDIALS_MAYBE_UNUSED N_Vector yp,
+                             SUNDIALS_MAYBE_UNUSED N_Vector res,
+                             sunrealtype cj, void* P_data)
+{
+  return (SUNStructMG_SetOperator((SUNStructMG)P_data, cj, ONE) !=
+          SUN_SUCCESS);
+}
+
+int SUNStructMG_DAEPrecSolve(SUNDIALS_MAYBE_UNUSED sunrealtype t,
+                             SUNDIALS_MAYBE_UNUSED N_Vector y,
+                             SUNDIALS_MAYBE_UNUSED N_Vector yp,
+                             SUNDIALS_MAYBE_UNUSED N_Vector res, N_Vector r,
+                             N_Vector z, sunrealtype cj,
+                             SUNDIALS_MAYBE_UNUSED sunrealtype delta,
+                             void* P_data)
+{
+  SUNStructMG mg = (SUNStructMG)P_data;
+
+  /* use the current cj, it may differ from the one of the last setup */
+  if (SUNStructMG_SetOperator(mg, cj, ONE) != SUN_SUCCESS) { return 1; }
+  return (SUNStructMG_Solve(mg, r, z) != SUN_SUCCESS) ? -1 : 0;
+}
@@ -23,6 +23,7 @@
 #include <string.h>
 #include <sundials/sundials_config.h>
 #include <sundials/sundials_types.h>
+#include <time.h>
 
 static inline char* sunCombineFileAndLine(int line, const char* file)
 {
@@ -86,4 +87,23 @@ static inline void sunCompensatedSum(sunrealtype base, sunrealtype inc,
   *sum                      = tmp2;
 }
 
+/*
+ * Returns the wall clock time in seconds from the monotonic clock used by the
+ * SUNProfiler. Without POSIX timers the processor time is returned instead.
+ * The time is returned as a double regardless of the precision of sunrealtype
+ * since a single precision value cannot resolve short intervals of a clock
+ * that started long ago; only differences of two times should be converted
+ * to sunrealtype.
+ */
+static inline double sunWallClockTime(void)
+{
+#if defined(SUNDIALS_HAVE_POSIX_TIMERS)
+  struct timespec ts;
+  if (clock_gettime(CLOCK_MONOTONIC, &ts)) { return 0.0; }
+  return (double)ts.tv_sec + 1.0e-9 * (double)ts.tv_nsec;
+#else
+  return (double)clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
+
 #endif /* _SUNDIALS_UTILS_H */
@@ -29,6 +29,9 @@
 #define ONE            SUN_RCONST(1.0)
 #define ROW(i, j, smu) (i - j + smu)
 
+/* number of right-hand sides processed per sweep over the LU factors */
+#define MULTI_BLOCK 8
+
 /*
  * -----------------------------------------------------------------
  * Band solver structure accessibility macros:
@@ -39,6 +42,16 @@
 #define PIVOTS(S)       (BAND_CONTENT(S)->pivots)
 #define LASTFLAG(S)     (BAND_CONTENT(S)->last_flag)
 
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static void bandGBTRSMulti(sunrealtype** a, sunindextype n, sunindextype smu,
+                           sunindextype ml, sunindextype* p, sunrealtype** b,
+                           int nrhs);
+
 /*
  * -----------------------------------------------------------------
  * exported functions
@@ -81,6 +94,7 @@ SUNLinearSolver SUNLinSol_Band(SUNDIALS_MAYBE_UNUSED N_Vector y, SUNMatrix A,
   S->ops->initialize = SUNLinSolInitialize_Band;
   S->ops->setup      = SUNLinSolSetup_Band;
   S->ops->solve      = SUNLinSolSolve_Band;
+  S->ops->solvemulti = SUNLinSolSolveMulti_Band;
   S->ops->lastflag   = SUNLinSolLastFlag_Band;
   S->ops->space      = SUNLinSolSpace_Band;
   S->ops->free       = SUNLinSolFree_Band;
@@ -188,6 +202,44 @@ int SUNLinSolSolve_Band(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
   return SUN_SUCCESS;
 }
 
+int SUNLinSolSolveMulti_Band(SUNLinearSolver S, SUNMatrix A, N_Vector* X,
+                             N_Vector* B, int nrhs,
+                             SUNDIALS_MAYBE_UNUSED sunrealtype tol)
+{
+  SUNFunctionBegin(S->sunctx);
+  sunrealtype** A_cols;
+  sunrealtype* xdata[MULTI_BLOCK];
+  sunindextype* pivots;
+  int i, j, nblock;
+
+  /* access data pointers (return with failure on NULL) */
+  A_cols = NULL;
+  pivots = NULL;
+  A_cols = SUNBandMatrix_Cols(A);
+  SUNCheckLastErr();
+  pivots = PIVOTS(S);
+  SUNAssert(pivots, SUN_ERR_ARG_CORRUPT);
+
+  /* solve blocks of right-hand sides with a single pass over the factors */
+  for (i = 0; i < nrhs; i += MULTI_BLOCK)
+  {
+    nblock = SUNMIN(MULTI_BLOCK, nrhs - i);
+    for (j = 0; j < nblock; j++)
+    {
+      /* copy b into x */
+      N_VScale(ONE, B[i + j], X[i + j]);
+      SUNCheckLastErr();
+      xdata[j] = N_VGetArrayPointer(X[i + j]);
+      SUNCheckLastErr();
+    }
+    bandGBTRSMulti(A_cols, SM_COLUMNS_B(A), SM_SUBAND_B(A), SM_LBAND_B(A),
+                   pivots, xdata, nblock);
+  }
+
+  LASTFLAG(S) = SUN_SUCCESS;
+  return SUN_SUCCESS;
+}
+
 sunindextype SUNLinSolLastFlag_Band(SUNLinearSolver S)
 {
   /* return the stored 'last_flag' value */
@@ -229,3 +281,58 @@ SUNErrCode SUNLinSolFree_Band(SUNLinearSolver S)
   S = NULL;
   return SUN_SUCCESS;
 }
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* Solves A x_j = b_j, j = 0,...,nrhs-1, using the LU factors computed by
+   SUNDlsMat_bandGBTRF. Each column of the factors is applied to all
+   right-hand sides before moving to the next column. The solutions are
+   returned in b. */
+
+static void bandGBTRSMulti(sunrealtype** a, sunindextype n, sunindextype smu,
+                           sunindextype ml, sunindextype* p, sunrealtype** b,
+                           int nrhs)
+{
+  sunindextype k, l, i, first_row_k, last_row_k;
+  sunrealtype mult, *diag_k, *b_j;
+  int j;
+
+  /* Solve Ly = Pb, store solution y in b */
+
+  for (k = 0; k < n - 1; k++)
+  {
+    l          = p[k];
+    diag_k     = a[k] + smu;
+    last_row_k = SUNMIN(n - 1, k + ml);
+    for (j = 0; j < nrhs; j++)
+    {
+      b_j  = b[j];
+      mult = b_j[l];
+      if (l != k)
+      {
+        b_j[l] = b_j[k];
+        b_j[k] = mult;
+      }
+      for (i = k + 1; i <= last_row_k; i++) { b_j[i] += mult * diag_k[i - k]; }
+    }
+  }
+
+  /* Solve Ux = y, store solution x in b */
+
+  for (k = n - 1; k >= 0; k--)
+  {
+    diag_k      = a[k] + smu;
+    first_row_k = SUNMAX(0, k - smu);
+    for (j = 0; j < nrhs; j++)
+    {
+      b_j = b[j];
+      b_j[k] /= (*diag_k);
+      mult = -b_j[k];
+      for (i = first_row_k; i <= k - 1; i++) { b_j[i] += mult * diag_k[i - k]; }
+    }
+  }
+}
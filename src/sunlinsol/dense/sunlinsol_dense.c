@@ -28,6 +28,9 @@
 
 #define ONE SUN_RCONST(1.0)
 
+/* number of right-hand sides processed per sweep over the LU factors */
+#define MULTI_BLOCK 8
+
 /*
  * -----------------------------------------------------------------
  * Dense solver structure accessibility macros:
@@ -38,6 +41,15 @@
 #define PIVOTS(S)        (DENSE_CONTENT(S)->pivots)
 #define LASTFLAG(S)      (DENSE_CONTENT(S)->last_flag)
 
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+static void denseGETRSMulti(sunrealtype** a, sunindextype n, sunindextype* p,
+                            sunrealtype** b, int nrhs);
+
 /*
  * -----------------------------------------------------------------
  * exported functions
@@ -75,6 +87,7 @@ SUNLinearSolver SUNLinSol_Dense(SUNDIALS_MAYBE_UNUSED N_Vector y, SUNMatrix A,
   S->ops->initialize = SUNLinSolInitialize_Dense;
   S->ops->setup      = SUNLinSolSetup_Dense;
   S->ops->solve      = SUNLinSolSolve_Dense;
+  S->ops->solvemulti = SUNLinSolSolveMulti_Dense;
   S->ops->lastflag   = SUNLinSolLastFlag_Dense;
   S->ops->space      = SUNLinSolSpace_Dense;
   S->ops->free       = SUNLinSolFree_Dense;
@@ -179,6 +192,46 @@ int SUNLinSolSolve_Dense(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
   return SUN_SUCCESS;
 }
 
+int SUNLinSolSolveMulti_Dense(SUNLinearSolver S, SUNMatrix A, N_Vector* X,
+                              N_Vector* B, int nrhs,
+                              SUNDIALS_MAYBE_UNUSED sunrealtype tol)
+{
+  SUNFunctionBegin(S->sunctx);
+  sunrealtype** A_cols;
+  sunrealtype* xdata[MULTI_BLOCK];
+  sunindextype* pivots;
+  int i, j, nblock;
+
+  /* access data pointers (return with failure on NULL) */
+  A_cols = NULL;
+  pivots = NULL;
+  A_cols = SUNDenseMatrix_Cols(A);
+  SUNCheckLastErr();
+  pivots = PIVOTS(S);
+
+  SUNAssert(A_cols, SUN_ERR_ARG_CORRUPT);
+  SUNAssert(pivots, SUN_ERR_ARG_CORRUPT);
+
+  /* solve blocks of right-hand sides with a single pass over the factors */
+  for (i = 0; i < nrhs; i += MULTI_BLOCK)
+  {
+    nblock = SUNMIN(MULTI_BLOCK, nrhs - i);
+    for (j = 0; j < nblock; j++)
+    {
+      /* copy b into x */
+      N_VScale(ONE, B[i + j], X[i + j]);
+      SUNCheckLastErr();
+      xdata[j] = N_VGetArrayPointer(X[i + j]);
+      SUNCheckLastErr();
+      SUNAssert(xdata[j], SUN_ERR_ARG_CORRUPT);
+    }
+    denseGETRSMulti(A_cols, SUNDenseMatrix_Rows(A), pivots, xdata, nblock);
+  }
+
+  LASTFLAG(S) = SUN_SUCCESS;
+  return SUN_SUCCESS;
+}
+
 sunindextype SUNLinSolLastFlag_Dense(SUNLinearSolver S)
 {
   /* return the stored 'last_flag' value */
@@ -220,3 +273,65 @@ SUNErrCode SUNLinSolFree_Dense(SUNLinearSolver S)
   S = NULL;
   return SUN_SUCCESS;
 }
+
+/*
+ * -----------------------------------------------------------------
+ * private functions
+ * -----------------------------------------------------------------
+ */
+
+/* Solves A x_j = b_j, j = 0,...,nrhs-1, using the LU factors computed by
+   SUNDlsMat_denseGETRF. This performs the same operations as
+   SUNDlsMat_denseGETRS but each column of the factors is applied to all
+   right-hand sides before moving to the next column. The solutions are
+   returned in b. */
+
+static void denseGETRSMulti(sunrealtype** a, sunindextype n, sunindextype* p,
+                            sunrealtype** b, int nrhs)
+{
+  sunindextype i, k, pk;
+  sunrealtype *col_k, *b_j, tmp;
+  int j;
+
+  /* Permute b, based on pivot information in p */
+  for (k = 0; k < n; k++)
+  {
+    pk = p[k];
+    if (pk != k)
+    {
+      for (j = 0; j < nrhs; j++)
+      {
+        b_j     = b[j];
+        tmp     = b_j[k];
+        b_j[k]  = b_j[pk];
+        b_j[pk] = tmp;
+      }
+    }
+  }
+
+  /* Solve Ly = b, store solution y in b */
+  for (k = 0; k < n - 1; k++)
+  {
+    col_k = a[k];
+    for (j = 0; j < nrhs; j++)
+    {
+      b_j = b[j];
+      tmp = b_j[k];
+      for (i = k + 1; i < n; i++) { b_j[i] -= col_k[i] * tmp; }
+    }
+  }
+
+  /* Solve Ux = y, store solution x in b */
+  for (k = n - 1; k > 0; k--)
+  {
+    col_k = a[k];
+    for (j = 0; j < nrhs; j++)
+    {
+      b_j = b[j];
+      b_j[k] /= col_k[k];
+      tmp = b_j[k];
+      for (i = 0; i < k; i++) { b_j[i] -= col_k[i] * tmp; }
+    }
+  }
+  for (j = 0; j < nrhs; j++) { b[j][0] /= a[0][0]; }
+}
@@ -31,6 +31,9 @@
 #define TWO       SUN_RCONST(2.0)
 #define TWOTHIRDS SUN_RCONST(0.666666666666666666666666666666667)
 
+/* number of right-hand sides passed to each KLU solve call in SolveMulti */
+#define MULTI_BLOCK 8
+
 /*
  * -----------------------------------------------------------------
  * KLU solver structure accessibility macros:
@@ -44,6 +47,8 @@
 #define NUMERIC(S)        (KLU_CONTENT(S)->numeric)
 #define COMMON(S)         (KLU_CONTENT(S)->common)
 #define SOLVE(S)          (KLU_CONTENT(S)->klu_solver)
+#define RHSWORK(S)        (KLU_CONTENT(S)->rhs_work)
+#define RHSWORKLEN(S)     (KLU_CONTENT(S)->rhs_work_len)
 
 /*
  * -----------------------------------------------------------------
@@ -86,6 +91,7 @@ SUNLinearSolver SUNLinSol_KLU(N_Vector y, SUNMatrix A, SUNContext sunctx)
   S->ops->initialize = SUNLinSolInitialize_KLU;
   S->ops->setup      = SUNLinSolSetup_KLU;
   S->ops->solve      = SUNLinSolSolve_KLU;
+  S->ops->solvemulti = SUNLinSolSolveMulti_KLU;
   S->ops->lastflag   = SUNLinSolLastFlag_KLU;
   S->ops->space      = SUNLinSolSpace_KLU;
   S->ops->free       = SUNLinSolFree_KLU;
@@ -107,6 +113,8 @@ SUNLinearSolver SUNLinSol_KLU(N_Vector y, SUNMatrix A, SUNContext sunctx)
   content->first_factorize = 1;
   content->symbolic        = NULL;
   content->numeric         = NULL;
+  content->rhs_work        = NULL;
+  content->rhs_work_len    = 0;
 
 #if defined(SUNDIALS_INT64_T)
   if (SUNSparseMatrix_SparseType(A) == CSC_MAT)
@@ -377,15 +385,87 @@ int SUNLinSolSolve_KLU(SUNLinearSolver S, SUNMatrix A, N_Vector x, N_Vector b,
   return (LASTFLAG(S));
 }
 
+int SUNLinSolSolveMulti_KLU(SUNLinearSolver S, SUNMatrix A, N_Vector* X,
+                            N_Vector* B, int nrhs,
+                            SUNDIALS_MAYBE_UNUSED sunrealtype tol)
+{
+  int flag, i, j, nblock;
+  sunindextype n, k;
+  sunrealtype *xdata, *work;
+
+  /* check for valid inputs */
+  if ((A == NULL) || (S == NULL) || (X == NULL) || (B == NULL))
+  {
+    return SUN_ERR_ARG_CORRUPT;
+  }
+
+  n = SUNSparseMatrix_NP(A);
+
+  /* allocate the column-major right-hand side workspace on first use, or
+     reallocate it if the system has grown since (e.g., after a ReInit) */
+  if (RHSWORK(S) == NULL || RHSWORKLEN(S) < n)
+  {
+    free(RHSWORK(S));
+    RHSWORKLEN(S) = 0;
+    RHSWORK(S) = (sunrealtype*)malloc(MULTI_BLOCK * n * sizeof(sunrealtype));
+    if (RHSWORK(S) == NULL)
+    {
+      LASTFLAG(S) = SUN_ERR_MEM_FAIL;
+      return (LASTFLAG(S));
+    }
+    RHSWORKLEN(S) = n;
+  }
+  work = RHSWORK(S);
+
+  /* gather blocks of right-hand sides into the workspace and call KLU once
+     per block so the factors are traversed once per block */
+  for (i = 0; i < nrhs; i += MULTI_BLOCK)
+  {
+    nblock = SUNMIN(MULTI_BLOCK, nrhs - i);
+    for (j = 0; j < nblock; j++)
+    {
+      xdata = N_VGetArrayPointer(B[i + j]);
+      if (xdata == NULL)
+      {
+        LASTFLAG(S) = SUN_ERR_MEM_FAIL;
+        return (LASTFLAG(S));
+      }
+      for (k = 0; k < n; k++) { work[j * n + k] = xdata[k]; }
+    }
+
+    flag = SOLVE(S)(SYMBOLIC(S), NUMERIC(S), n, nblock, work, &COMMON(S));
+    if (flag == 0)
+    {
+      LASTFLAG(S) = SUNLS_PACKAGE_FAIL_REC;
+      return (LASTFLAG(S));
+    }
+
+    for (j = 0; j < nblock; j++)
+    {
+      xdata = N_VGetArrayPointer(X[i + j]);
+      if (xdata == NULL)
+      {
+        LASTFLAG(S) = SUN_ERR_MEM_FAIL;
+        return (LASTFLAG(S));
+      }
+      for (k = 0; k < n; k++) { xdata[k] = work[j * n + k]; }
+    }
+  }
+
+  LASTFLAG(S) = SUN_SUCCESS;
+  return (LASTFLAG(S));
+}
+
 sunindextype SUNLinSolLastFlag_KLU(SUNLinearSolver S) { return (LASTFLAG(S)); }
 
-SUNErrCode SUNLinSolSpace_KLU(SUNDIALS_MAYBE_UNUSED SUNLinearSolver S,
-                              long int* lenrwLS, long int* leniwLS)
+SUNErrCode SUNLinSolSpace_KLU(SUNLinearSolver S, long int* lenrwLS,
+                              long int* leniwLS)
 {
   /* since the klu structures are opaque objects, we
-     omit those from these results */
-  *leniwLS = 2;
-  *lenrwLS = 0;
+     omit those from these results; the multiple right-hand
+     side workspace is counted once it has been allocated */
+  *leniwLS = 3;
+  *lenrwLS = (long int)(MULTI_BLOCK * RHSWORKLEN(S));
   return SUN_SUCCESS;
 }
 
@@ -399,6 +479,12 @@ SUNErrCode SUNLinSolFree_KLU(SUNLinearSolver S)
   {
     if (NUMERIC(S)) { sun_klu_free_numeric(&NUMERIC(S), &COMMON(S)); }
     if (SYMBOLIC(S)) { sun_klu_free_symbolic(&SYMBOLIC(S), &COMMON(S)); }
+    if (RHSWORK(S))
+    {
+      free(RHSWORK(S));
+      RHSWORK(S)    = NULL;
+      RHSWORKLEN(S) = 0;
+    }
     free(S->content);
     S->content = NULL;
   }
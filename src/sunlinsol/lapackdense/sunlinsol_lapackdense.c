@@ -39,6 +39,9 @@
 #define ZERO SUN_RCONST(0.0)
 #define ONE  SUN_RCONST(1.0)
 
+/* number of right-hand sides passed to each GETRS call in SolveMulti */
+#define MULTI_BLOCK 8
+
 /*
  * -----------------------------------------------------------------
  * LapackDense solver structure accessibility macros:
@@ -49,6 +52,7 @@
   ((SUNLinearSolverContent_LapackDense)(S->content))
 #define PIVOTS(S)   (LAPACKDENSE_CONTENT(S)->pivots)
 #define LASTFLAG(S) (LAPACKDENSE_CONTENT(S)->last_flag)
+#define RHSWORK(S)  (LAPACKDENSE_CONTENT(S)->rhs_work)
 
 /*
  * -----------------------------------------------------------------
@@ -92,6 +96,7 @@ SUNLinearSolver SUNLinSol_LapackDense(N_Vector y, SUNMatrix A, SUNContext sunctx
   S->ops->initialize = SUNLinSolInitialize_LapackDense;
   S->ops->setup      = SUNLinSolSetup_LapackDense;
   S->ops->solve      = SUNLinSolSolve_LapackDense;
+  S->ops->solvemulti = SUNLinSolSolveMulti_LapackDense;
   S->ops->lastflag   = SUNLinSolLastFlag_LapackDense;
   S->ops->space      = SUNLinSolSpace_LapackDense;
   S->ops->free       = SUNLinSolFree_LapackDense;
@@ -112,6 +117,7 @@ SUNLinearSolver SUNLinSol_LapackDense(N_Vector y, SUNMatrix A, SUNContext sunctx
   content->N         = MatrixRows;
   content->last_flag = 0;
   content->pivots    = NULL;
+  content->rhs_work  = NULL;
 
   /* Allocate content */
   content->pivots = (sunindextype*)malloc(MatrixRows * sizeof(sunindextype));
@@ -207,6 +213,72 @@ int SUNLinSolSolve_LapackDense(SUNLinearSolver S, SUNMatrix A, N_Vector x,
   return SUN_SUCCESS;
 }
 
+int SUNLinSolSolveMulti_LapackDense(SUNLinearSolver S, SUNMatrix A,
+                                    N_Vector* X, N_Vector* B, int nrhs,
+                                    SUNDIALS_MAYBE_UNUSED sunrealtype tol)
+{
+  sunindextype n, nb, ier, k;
+  sunrealtype *xdata, *work;
+  int i, j, nblock;
+
+  if ((A == NULL) || (S == NULL) || (X == NULL) || (B == NULL))
+  {
+    return SUN_ERR_ARG_CORRUPT;
+  }
+
+  n = SUNDenseMatrix_Rows(A);
+
+  /* allocate the column-major right-hand side workspace on first use */
+  if (RHSWORK(S) == NULL)
+  {
+    RHSWORK(S) = (sunrealtype*)malloc(MULTI_BLOCK * n * sizeof(sunrealtype));
+    if (RHSWORK(S) == NULL)
+    {
+      LASTFLAG(S) = SUN_ERR_MEM_FAIL;
+      return SUN_ERR_MEM_FAIL;
+    }
+  }
+  work = RHSWORK(S);
+
+  /* gather blocks of right-hand sides into the workspace and call LAPACK
+     once per block */
+  for (i = 0; i < nrhs; i += MULTI_BLOCK)
+  {
+    nblock = SUNMIN(MULTI_BLOCK, nrhs - i);
+    for (j = 0; j < nblock; j++)
+    {
+      xdata = N_VGetArrayPointer(B[i + j]);
+      if (xdata == NULL)
+      {
+        LASTFLAG(S) = SUN_ERR_MEM_FAIL;
+        return SUN_ERR_MEM_FAIL;
+      }
+      for (k = 0; k < n; k++) { work[j * n + k] = xdata[k]; }
+    }
+
+    nb  = nblock;
+    ier = 0;
+    xgetrs_f77("N", &n, &nb, SUNDenseMatrix_Data(A), &n, PIVOTS(S), work, &n,
+               &ier);
+    LASTFLAG(S) = ier;
+    if (ier < 0) { return SUN_ERR_EXT_FAIL; }
+
+    for (j = 0; j < nblock; j++)
+    {
+      xdata = N_VGetArrayPointer(X[i + j]);
+      if (xdata == NULL)
+      {
+        LASTFLAG(S) = SUN_ERR_MEM_FAIL;
+        return SUN_ERR_MEM_FAIL;
+      }
+      for (k = 0; k < n; k++) { xdata[k] = work[j * n + k]; }
+    }
+  }
+
+  LASTFLAG(S) = SUN_SUCCESS;
+  return SUN_SUCCESS;
+}
+
 sunindextype SUNLinSolLastFlag_LapackDense(SUNLinearSolver S)
 {
   return (LASTFLAG(S));
@@ -215,7 +287,7 @@ sunindextype SUNLinSolLastFlag_LapackDense(SUNLinearSolver S)
 SUNErrCode SUNLinSolSpace_LapackDense(SUNLinearSolver S, long int* lenrwLS,
                                       long int* leniwLS)
 {
-  *lenrwLS = 0;
+  *lenrwLS = (RHSWORK(S)) ? MULTI_BLOCK * LAPACKDENSE_CONTENT(S)->N : 0;
   *leniwLS = 2 + LAPACKDENSE_CONTENT(S)->N;
   return SUN_SUCCESS;
 }
@@ -233,6 +305,11 @@ SUNErrCode SUNLinSolFree_LapackDense(SUNLinearSolver S)
       free(PIVOTS(S));
       PIVOTS(S) = NULL;
     }
+    if (RHSWORK(S))
+    {
+      free(RHSWORK(S));
+      RHSWORK(S) = NULL;
+    }
     free(S->content);
     S->content = NULL;
   }
@@ -0,0 +1,231 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the discrete adjoint of explicit Runge--Kutta methods. The
+ * gradient of J = y_0(tf) + 2 y_1(tf) for the problem
+ *
+ *   y_0' = -p_0 y_0 y_1
+ *   y_1' =  p_0 y_0 y_1 - p_1 y_1 + 0.1 t
+ *
+ * with respect to y(0) and p computed by ARKodeAdjSolve is compared to central
+ * differences of the fixed step solution with ERKStep and ARKStep.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode/arkode_arkstep.h"
+#include "arkode/arkode_erkstep.h"
+#include "nvector/nvector_serial.h"
+#include "sundials/sundials_math.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+#define TF    SUN_RCONST(2.0)
+#define HFIX  SUN_RCONST(0.01)
+#define NINTV 7
+
+/* Right-hand side function */
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* p  = (sunrealtype*)user_data;
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = -p[0] * yd[0] * yd[1];
+  fd[1] = p[0] * yd[0] * yd[1] - p[1] * yd[1] + SUN_RCONST(0.1) * t;
+
+  return 0;
+}
+
+/* Transposed Jacobian products */
+static int fadj(sunrealtype t, N_Vector y, N_Vector lambda, N_Vector JyTl,
+                N_Vector JpTl, void* user_data)
+{
+  sunrealtype* p  = (sunrealtype*)user_data;
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* ld = N_VGetArrayPointer(lambda);
+  sunrealtype* jy = N_VGetArrayPointer(JyTl);
+  sunrealtype* jp = NULL;
+
+  jy[0] = p[0] * yd[1] * (ld[1] - ld[0]);
+  jy[1] = p[0] * yd[0] * (ld[1] - ld[0]) - p[1] * ld[1];
+
+  if (JpTl)
+  {
+    jp    = N_VGetArrayPointer(JpTl);
+    jp[0] = yd[0] * yd[1] * (ld[1] - ld[0]);
+    jp[1] = -yd[1] * ld[1];
+  }
+
+  return 0;
+}
+
+/* Integrate to TF with fixed steps, return J, and optionally the gradient */
+static int run(int use_ark, sunrealtype* p, sunrealtype* y0,
+               sunrealtype* dJdy0, sunrealtype* dJdp, sunrealtype* J,
+               SUNContext sunctx)
+{
+  int retval       = 0;
+  N_Vector y       = NULL;
+  N_Vector lambda  = NULL;
+  N_Vector mu      = NULL;
+  void* arkode_mem = NULL;
+  sunrealtype tret;
+
+  y = N_VNew_Serial(2, sunctx);
+  if (!y) { return 1; }
+  N_VGetArrayPointer(y)[0] = y0[0];
+  N_VGetArrayPointer(y)[1] = y0[1];
+
+  if (use_ark) { arkode_mem = ARKStepCreate(f, NULL, ZERO, y, sunctx); }
+  else { arkode_mem = ERKStepCreate(f, ZERO, y, sunctx); }
+  if (!arkode_mem) { return 1; }
+
+  retval = ARKodeSetUserData(arkode_mem, p);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetFixedStep(arkode_mem, HFIX);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetMaxNumSteps(arkode_mem, 1000);
+  if (retval) { return 1; }
+
+  if (dJdy0)
+  {
+    retval = ARKodeAdjInit(arkode_mem, NINTV, fadj);
+    if (retval)
+    {
+      fprintf(stderr, "ARKodeAdjInit returned %i\n", retval);
+      return 1;
+    }
+  }
+
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_NORMAL);
+  if (retval < 0)
+  {
+    fprintf(stderr, "ARKodeEvolve returned %i\n", retval);
+    return 1;
+  }
+
+  *J = N_VGetArrayPointer(y)[0] + TWO * N_VGetArrayPointer(y)[1];
+
+  if (dJdy0)
+  {
+    lambda = N_VClone(y);
+    mu     = N_VClone(y);
+    if (!lambda || !mu) { return 1; }
+
+    N_VGetArrayPointer(lambda)[0] = ONE;
+    N_VGetArrayPointer(lambda)[1] = TWO;
+    N_VConst(ZERO, mu);
+
+    retval = ARKodeAdjSolve(arkode_mem, lambda, mu);
+    if (retval)
+    {
+      fprintf(stderr, "ARKodeAdjSolve returned %i\n", retval);
+      return 1;
+    }
+
+    dJdy0[0] = N_VGetArrayPointer(lambda)[0];
+    dJdy0[1] = N_VGetArrayPointer(lambda)[1];
+    dJdp[0]  = N_VGetArrayPointer(mu)[0];
+    dJdp[1]  = N_VGetArrayPointer(mu)[1];
+
+    N_VDestroy(lambda);
+    N_VDestroy(mu);
+  }
+
+  ARKodeFree(&arkode_mem);
+  N_VDestroy(y);
+
+  return 0;
+}
+
+/* Compare the adjoint gradient to central differences */
+static int test(int use_ark, SUNContext sunctx)
+{
+  int i, fails = 0;
+  sunrealtype p[2]  = {SUN_RCONST(1.5), SUN_RCONST(0.7)};
+  sunrealtype y0[2] = {ONE, SUN_RCONST(0.5)};
+  sunrealtype dJdy0[2], dJdp[2], fd, Jp, Jm, J;
+  sunrealtype eps = SUN_RCONST(1.0e-5);
+  sunrealtype tol = SUN_RCONST(1.0e-6);
+
+  if (run(use_ark, p, y0, dJdy0, dJdp, &J, sunctx)) { return 1; }
+
+  for (i = 0; i < 2; i++)
+  {
+    y0[i] += eps;
+    if (run(use_ark, p, y0, NULL, NULL, &Jp, sunctx)) { return 1; }
+    y0[i] -= TWO * eps;
+    if (run(use_ark, p, y0, NULL, NULL, &Jm, sunctx)) { return 1; }
+    y0[i] += eps;
+    fd = (Jp - Jm) / (TWO * eps);
+    if (SUNRabs(dJdy0[i] - fd) > tol * (ONE + SUNRabs(fd)))
+    {
+      fprintf(stderr, "dJ/dy0[%i]: adjoint %g, difference %g\n", i,
+              (double)dJdy0[i], (double)fd);
+      fails++;
+    }
+
+    p[i] += eps;
+    if (run(use_ark, p, y0, NULL, NULL, &Jp, sunctx)) { return 1; }
+    p[i] -= TWO * eps;
+    if (run(use_ark, p, y0, NULL, NULL, &Jm, sunctx)) { return 1; }
+    p[i] += eps;
+    fd = (Jp - Jm) / (TWO * eps);
+    if (SUNRabs(dJdp[i] - fd) > tol * (ONE + SUNRabs(fd)))
+    {
+      fprintf(stderr, "dJ/dp[%i]: adjoint %g, difference %g\n", i,
+              (double)dJdp[i], (double)fd);
+      fails++;
+    }
+  }
+
+  return fails;
+}
+
+/* Main program */
+int main(int argc, char* argv[])
+{
+  int retval        = 0;
+  int fails         = 0;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  fails += test(0, sunctx);
+  fails += test(1, sunctx);
+
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %i failures\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
@@ -0,0 +1,215 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the Jacobian evaluation cost model enabled with
+ * ARKodeSetJacEvalCostModel. The Robertson problem is integrated with a DIRK
+ * method using the default Jacobian update policy, with the cost model enabled and then
+ * disabled again, and with the cost model enabled. The first two runs must be
+ * identical and must not record any solver times. Since the cost model
+ * decisions depend on measured times, the last run is only required to
+ * succeed, to record the solver times, and to agree with the default run to
+ * within the integration tolerances.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode/arkode_arkstep.h"
+#include "nvector/nvector_serial.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#else
+#define GSYM "g"
+#endif
+
+#define NEQ 3
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+#define RTOL SUN_RCONST(1.0e-6)
+#define ATOL SUN_RCONST(1.0e-10)
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = SUN_RCONST(-0.04) * yd[0] + SUN_RCONST(1.0e4) * yd[1] * yd[2];
+  fd[2] = SUN_RCONST(3.0e7) * yd[1] * yd[1];
+  fd[1] = -fd[0] - fd[2];
+
+  return 0;
+}
+
+/* Integrate to tout and return the solution, counters, and solver times. mode
+   0 uses the default update policy, mode 1 enables and then disables the cost
+   model, and mode 2 enables the cost model. */
+static int run(SUNContext sunctx, int mode, N_Vector yout, long int* counters,
+               sunrealtype* times)
+{
+  void* arkode_mem   = NULL;
+  N_Vector y         = NULL;
+  SUNMatrix A        = NULL;
+  SUNLinearSolver LS = NULL;
+  long int nfe_evals;
+  sunrealtype tret;
+  int flag;
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  if (!y) { return 1; }
+  N_VConst(ZERO, y);
+  NV_Ith_S(y, 0) = ONE;
+
+  arkode_mem = ARKStepCreate(NULL, f, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  flag = ARKodeSStolerances(arkode_mem, RTOL, ATOL);
+  if (flag) { return 1; }
+
+  flag = ARKodeSetMaxNumSteps(arkode_mem, 10000);
+  if (flag) { return 1; }
+
+  A = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  if (!A) { return 1; }
+
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  if (!LS) { return 1; }
+
+  flag = ARKodeSetLinearSolver(arkode_mem, LS, A);
+  if (flag) { return 1; }
+
+  if (mode > 0)
+  {
+    flag = ARKodeSetJacEvalCostModel(arkode_mem, SUNTRUE);
+    if (flag) { return 1; }
+  }
+
+  if (mode == 1)
+  {
+    flag = ARKodeSetJacEvalCostModel(arkode_mem, SUNFALSE);
+    if (flag) { return 1; }
+  }
+
+  flag = ARKodeEvolve(arkode_mem, SUN_RCONST(4.0e3), y, &tret, ARK_NORMAL);
+  if (flag < 0) { return 1; }
+
+  N_VScale(ONE, y, yout);
+
+  flag = ARKodeGetNumSteps(arkode_mem, &counters[0]);
+  if (flag) { return 1; }
+  flag = ARKStepGetNumRhsEvals(arkode_mem, &nfe_evals, &counters[1]);
+  if (flag) { return 1; }
+  flag = ARKodeGetNumJacEvals(arkode_mem, &counters[2]);
+  if (flag) { return 1; }
+  flag = ARKodeGetNumLinSolvSetups(arkode_mem, &counters[3]);
+  if (flag) { return 1; }
+
+  flag = ARKodeGetLinSolveTimes(arkode_mem, &times[0], &times[1], &times[2]);
+  if (flag) { return 1; }
+
+  N_VDestroy(y);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  ARKodeFree(&arkode_mem);
+
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  N_Vector y[3]     = {NULL, NULL, NULL};
+  long int c[3][4];
+  sunrealtype tm[3][3];
+  const char* names[3]  = {"default:", "on then off:", "cost model:"};
+  const char* cnames[4] = {"nst", "nfi", "nje", "nsetups"};
+  sunrealtype err;
+  int fails = 0;
+  int i, k;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  for (k = 0; k < 3; k++)
+  {
+    y[k] = N_VNew_Serial(NEQ, sunctx);
+    if (!y[k]) { return 1; }
+    if (run(sunctx, k, y[k], c[k], tm[k])) { return 1; }
+
+    printf("%-13s nst = %ld, nfi = %ld, nje = %ld, nsetups = %ld, tjac = "
+           "%.2e, tlsetup = %.2e, tnls = %.2e\n",
+           names[k], c[k][0], c[k][1], c[k][2], c[k][3], (double)tm[k][0],
+           (double)tm[k][1], (double)tm[k][2]);
+  }
+
+  /* Disabling the cost model restores the default policy exactly */
+  for (i = 0; i < NEQ; i++)
+  {
+    if (NV_Ith_S(y[0], i) != NV_Ith_S(y[1], i))
+    {
+      fprintf(stderr, "ERROR: y[%d] differs from the default run\n", i);
+      fails++;
+    }
+  }
+  for (i = 0; i < 4; i++)
+  {
+    if (c[0][i] != c[1][i])
+    {
+      fprintf(stderr, "ERROR: %s differs from the default run\n", cnames[i]);
+      fails++;
+    }
+  }
+
+  /* Times are only measured with the cost model enabled */
+  for (k = 0; k < 2; k++)
+  {
+    if (tm[k][0] != ZERO || tm[k][1] != ZERO || tm[k][2] != ZERO)
+    {
+      fprintf(stderr, "ERROR: solver times recorded without the cost model\n");
+      fails++;
+    }
+  }
+  if (tm[2][0] <= ZERO || tm[2][2] <= ZERO || c[2][2] < 1)
+  {
+    fprintf(stderr, "ERROR: the cost model did not record solver times\n");
+    fails++;
+  }
+
+  /* The cost model solution agrees to within the tolerances (the global
+     error of the DIRK method over the long interval is a few hundred times
+     the local tolerances) */
+  for (i = 0; i < NEQ; i++)
+  {
+    err = SUNRabs(NV_Ith_S(y[2], i) - NV_Ith_S(y[0], i)) /
+          (RTOL * SUNRabs(NV_Ith_S(y[0], i)) + ATOL);
+    if (err > SUN_RCONST(1000.0))
+    {
+      fprintf(stderr, "ERROR: cost model y[%d] = %" GSYM " vs %" GSYM "\n", i,
+              NV_Ith_S(y[2], i), NV_Ith_S(y[0], i));
+      fails++;
+    }
+  }
+
+  for (k = 0; k < 3; k++) { N_VDestroy(y[k]); }
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d checks failed\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}
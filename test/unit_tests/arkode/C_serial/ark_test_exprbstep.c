@@ -0,0 +1,319 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the ExpRBStep module. The test integrates the stiff,
+ * nonlinear, non-autonomous problem
+ *
+ *   u' = -50 (u - cos(v)),  v' = cos(t) - u v,  u(0) = 1, v(0) = 0,
+ *
+ * and checks
+ *
+ *   1. the observed order of the fixed step solution at TF, against a
+ *      reference solution computed with a much smaller step, and
+ *   2. the observed order of the local error estimate of a single step.
+ *
+ * It also integrates the semi-discrete heat equation u_t = u_xx on (0,1) with
+ * homogeneous Dirichlet boundaries and u(0,x) = sin(pi x), with the difference
+ * quotient or the exact Jacobian-vector product, and checks the adaptive
+ * solution error and that the step sizes are not limited by stiffness.
+ * ---------------------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode/arkode_exprbstep.h"
+#include "nvector/nvector_serial.h"
+#include "sundials/sundials_math.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+#define TF SUN_RCONST(1.0)
+
+/* heat equation grid size and final time */
+#define NX      99
+#define HEAT_TF SUN_RCONST(0.1)
+#define PI      SUN_RCONST(3.141592653589793238462643383279502884197169)
+
+/* Right-hand side function */
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = -SUN_RCONST(50.0) * (yd[0] - (sunrealtype)cos((double)yd[1]));
+  fd[1] = (sunrealtype)cos((double)t) - yd[0] * yd[1];
+
+  return 0;
+}
+
+/* Heat equation right-hand side function */
+static int f_heat(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+  sunrealtype dx  = ONE / (NX + 1);
+  sunrealtype c   = ONE / (dx * dx);
+  sunrealtype yl, yr;
+  int i;
+
+  for (i = 0; i < NX; i++)
+  {
+    yl    = (i > 0) ? yd[i - 1] : ZERO;
+    yr    = (i < NX - 1) ? yd[i + 1] : ZERO;
+    fd[i] = c * (yl - TWO * yd[i] + yr);
+  }
+
+  return 0;
+}
+
+/* Heat equation Jacobian-vector product (the problem is linear) */
+static int jtimes_heat(N_Vector v, N_Vector Jv, sunrealtype t, N_Vector y,
+                       N_Vector fy, void* user_data, N_Vector tmp)
+{
+  return f_heat(t, v, Jv, user_data);
+}
+
+/* Solution at TF with a fixed step size h */
+static int fixed_solve(sunrealtype h, N_Vector y, SUNContext sunctx)
+{
+  int retval       = 0;
+  void* arkode_mem = NULL;
+  sunrealtype tret;
+
+  N_VGetArrayPointer(y)[0] = ONE;
+  N_VGetArrayPointer(y)[1] = ZERO;
+
+  arkode_mem = ExpRBStepCreate(f, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  retval = ARKodeSetFixedStep(arkode_mem, h);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetMaxNumSteps(arkode_mem, 100000);
+  if (retval) { return 1; }
+
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_NORMAL);
+  if (retval < 0) { return 1; }
+
+  ARKodeFree(&arkode_mem);
+
+  return 0;
+}
+
+/* Local error estimate of a single step of size h */
+static int estimate(sunrealtype h, sunrealtype* est, SUNContext sunctx)
+{
+  int retval       = 0;
+  void* arkode_mem = NULL;
+  N_Vector y       = NULL;
+  N_Vector ele     = NULL;
+  sunrealtype tret;
+
+  y   = N_VNew_Serial(2, sunctx);
+  ele = N_VNew_Serial(2, sunctx);
+  if (!y || !ele) { return 1; }
+
+  N_VGetArrayPointer(y)[0] = ONE;
+  N_VGetArrayPointer(y)[1] = ZERO;
+
+  arkode_mem = ExpRBStepCreate(f, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  /* loose tolerances so the first step is accepted (the tolerances also set
+     the difference quotient perturbation), with accurate Krylov approximations
+     so the estimate is not polluted by their error */
+  retval = ARKodeSStolerances(arkode_mem, SUN_RCONST(1.0e-4),
+                              SUN_RCONST(1.0e-4));
+  if (retval) { return 1; }
+
+  retval = ExpRBStepSetEpsKrylov(arkode_mem, SUN_RCONST(1.0e-10));
+  if (retval) { return 1; }
+
+  retval = ARKodeSetInitStep(arkode_mem, h);
+  if (retval) { return 1; }
+
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_ONE_STEP);
+  if (retval < 0) { return 1; }
+
+  retval = ARKodeGetEstLocalErrors(arkode_mem, ele);
+  if (retval) { return 1; }
+
+  *est = N_VMaxNorm(ele);
+
+  ARKodeFree(&arkode_mem);
+  N_VDestroy(y);
+  N_VDestroy(ele);
+
+  return 0;
+}
+
+/* Check the observed orders of the method */
+static int test_order(SUNContext sunctx)
+{
+  int fails  = 0;
+  N_Vector y = NULL;
+  N_Vector e = NULL;
+  sunrealtype e1, e2, order;
+  sunrealtype h = SUN_RCONST(0.1);
+
+  y = N_VNew_Serial(2, sunctx);
+  e = N_VNew_Serial(2, sunctx);
+  if (!y || !e) { return 1; }
+
+  /* reference solution */
+  if (fixed_solve(h / SUN_RCONST(256.0), e, sunctx)) { return 1; }
+
+  /* global error of the solution */
+  if (fixed_solve(h, y, sunctx)) { return 1; }
+  N_VLinearSum(ONE, y, -ONE, e, y);
+  e1 = N_VMaxNorm(y);
+  if (fixed_solve(h / TWO, y, sunctx)) { return 1; }
+  N_VLinearSum(ONE, y, -ONE, e, y);
+  e2    = N_VMaxNorm(y);
+  order = (sunrealtype)(log((double)(e1 / e2)) / log(2.0));
+  printf("exprb32: solution order %.2f (expected 3)\n", (double)order);
+  if (order < SUN_RCONST(2.75)) { fails++; }
+
+  /* local error estimate */
+  h = SUN_RCONST(0.01);
+  if (estimate(h, &e1, sunctx)) { return 1; }
+  if (estimate(h / TWO, &e2, sunctx)) { return 1; }
+  order = (sunrealtype)(log((double)(e1 / e2)) / log(2.0));
+  printf("exprb32: estimate order %.2f (expected 3)\n", (double)order);
+  if (order < SUN_RCONST(2.75)) { fails++; }
+
+  N_VDestroy(y);
+  N_VDestroy(e);
+
+  return fails;
+}
+
+/* Check an adaptive solution of the heat equation */
+static int test_heat(sunbooleantype user_jtimes, SUNContext sunctx)
+{
+  int retval       = 0;
+  int fails        = 0;
+  int i            = 0;
+  void* arkode_mem = NULL;
+  N_Vector y       = NULL;
+  sunrealtype *yd, tret, dx, lambda1, err, uex;
+  long int nst, nfe, njv, nkri, nkcf;
+
+  dx = ONE / (NX + 1);
+
+  y = N_VNew_Serial(NX, sunctx);
+  if (!y) { return 1; }
+  yd = N_VGetArrayPointer(y);
+  for (i = 0; i < NX; i++)
+  {
+    yd[i] = (sunrealtype)sin((double)(PI * (i + 1) * dx));
+  }
+
+  arkode_mem = ExpRBStepCreate(f_heat, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  retval = ExpRBStepSetAutonomous(arkode_mem, SUNTRUE);
+  if (retval) { return 1; }
+
+  if (user_jtimes)
+  {
+    retval = ExpRBStepSetJacTimes(arkode_mem, jtimes_heat);
+    if (retval) { return 1; }
+  }
+
+  retval = ARKodeSStolerances(arkode_mem, SUN_RCONST(1.0e-6),
+                              SUN_RCONST(1.0e-10));
+  if (retval) { return 1; }
+
+  retval = ARKodeSetStopTime(arkode_mem, HEAT_TF);
+  if (retval) { return 1; }
+
+  retval = ARKodeEvolve(arkode_mem, HEAT_TF, y, &tret, ARK_NORMAL);
+  if (retval < 0) { return 1; }
+
+  /* the exact solution of the semi-discrete problem */
+  lambda1 = (sunrealtype)sin((double)(PI * dx / TWO));
+  lambda1 = SUN_RCONST(4.0) / (dx * dx) * lambda1 * lambda1;
+  err     = ZERO;
+  for (i = 0; i < NX; i++)
+  {
+    uex = SUNRexp(-lambda1 * tret) *
+          (sunrealtype)sin((double)(PI * (i + 1) * dx));
+    err = SUNMAX(err, SUNRabs(yd[i] - uex));
+  }
+
+  retval = ARKodeGetNumSteps(arkode_mem, &nst);
+  if (retval) { return 1; }
+
+  retval = ExpRBStepGetNumRhsEvals(arkode_mem, &nfe);
+  if (retval) { return 1; }
+
+  retval = ExpRBStepGetNumJtimesEvals(arkode_mem, &njv);
+  if (retval) { return 1; }
+
+  retval = ExpRBStepGetNumKrylovIters(arkode_mem, &nkri);
+  if (retval) { return 1; }
+
+  retval = ExpRBStepGetNumKrylovConvFails(arkode_mem, &nkcf);
+  if (retval) { return 1; }
+
+  printf("exprb32: heat (%s Jv): error %.2e, steps %li, fevals %li, "
+         "Jv evals %li, Krylov iters %li, Krylov fails %li\n",
+         user_jtimes ? "user" : "DQ", (double)err, nst, nfe, njv, nkri, nkcf);
+
+  /* an explicit method needs at least HEAT_TF * 2 / dx^2 = 2000 steps */
+  if (err > SUN_RCONST(1.0e-4)) { fails++; }
+  if (nst > 200) { fails++; }
+  if (nkri < 1) { fails++; }
+
+  ARKodeFree(&arkode_mem);
+  N_VDestroy(y);
+
+  return fails;
+}
+
+/* Main program */
+int main(int argc, char* argv[])
+{
+  int retval        = 0;
+  int fails         = 0;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  fails += test_order(sunctx);
+  fails += test_heat(SUNFALSE, sunctx);
+  fails += test_heat(SUNTRUE, sunctx);
+
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %i failures\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
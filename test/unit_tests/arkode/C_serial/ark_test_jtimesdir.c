@@ -0,0 +1,239 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the directional derivative function set with
+ * ARKodeSetJacTimesDirFn. A nonlinear reaction-diffusion problem is integrated
+ * with a DIRK method and SPGMR using the difference quotient Jacobian-vector
+ * product and using the exact product from the directional derivative
+ * function. The solutions must agree to within the integration tolerances and
+ * the directional derivative run must not make any difference quotient RHS
+ * evaluations. The function must not be used when an alternative RHS is given
+ * to ARKodeSetJacTimesRhsFn or after the product is replaced with
+ * ARKodeSetJacTimes.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode/arkode_arkstep.h"
+#include "nvector/nvector_serial.h"
+#include "sunlinsol/sunlinsol_spgmr.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#else
+#define GSYM "g"
+#endif
+
+#define NEQ 20
+
+#define ZERO  SUN_RCONST(0.0)
+#define ONE   SUN_RCONST(1.0)
+#define TWO   SUN_RCONST(2.0)
+#define THREE SUN_RCONST(3.0)
+
+/* Number of calls to the directional derivative function */
+typedef struct
+{
+  long int ndir;
+} UserData;
+
+/* f_i = c (y_{i-1} - 2 y_i + y_{i+1}) - y_i^3 with homogeneous boundaries */
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+  sunrealtype c   = SUN_RCONST(10.0);
+  sunrealtype yl, yr;
+  int i;
+
+  for (i = 0; i < NEQ; i++)
+  {
+    yl    = (i > 0) ? yd[i - 1] : ZERO;
+    yr    = (i < NEQ - 1) ? yd[i + 1] : ZERO;
+    fd[i] = c * (yl - TWO * yd[i] + yr) - yd[i] * yd[i] * yd[i];
+  }
+
+  return 0;
+}
+
+/* Same RHS under a different function pointer */
+static int f_alt(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  return f(t, y, ydot, user_data);
+}
+
+/* f and Jv = f_y v */
+static int fdir(sunrealtype t, N_Vector y, N_Vector v, N_Vector ydot,
+                N_Vector Jv, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* vd = N_VGetArrayPointer(v);
+  sunrealtype* jd = N_VGetArrayPointer(Jv);
+  sunrealtype c   = SUN_RCONST(10.0);
+  sunrealtype vl, vr;
+  int i;
+
+  ((UserData*)user_data)->ndir++;
+
+  for (i = 0; i < NEQ; i++)
+  {
+    vl    = (i > 0) ? vd[i - 1] : ZERO;
+    vr    = (i < NEQ - 1) ? vd[i + 1] : ZERO;
+    jd[i] = c * (vl - TWO * vd[i] + vr) - THREE * yd[i] * yd[i] * vd[i];
+  }
+
+  return f(t, y, ydot, user_data);
+}
+
+/* Integrate to tout and return the solution, nfeDQ, and the number of
+   directional derivative evaluations. mode 0 uses the DQ product, mode 1 the
+   directional derivative, mode 2 the directional derivative together with an
+   alternative Jv RHS, and mode 3 the directional derivative followed by a
+   reset of the Jacobian-vector product. */
+static int run(SUNContext sunctx, int mode, N_Vector yout, long int* nfeDQ,
+               long int* ndir)
+{
+  void* arkode_mem   = NULL;
+  N_Vector y         = NULL;
+  SUNLinearSolver LS = NULL;
+  UserData udata;
+  sunrealtype tret;
+  int flag, i;
+
+  udata.ndir = 0;
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  if (!y) { return 1; }
+  for (i = 0; i < NEQ; i++)
+  {
+    NV_Ith_S(y, i) = ONE + SUN_RCONST(0.1) * (sunrealtype)i;
+  }
+
+  arkode_mem = ARKStepCreate(NULL, f, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  flag = ARKodeSetUserData(arkode_mem, &udata);
+  if (flag) { return 1; }
+
+  flag = ARKodeSStolerances(arkode_mem, SUN_RCONST(1.0e-8), SUN_RCONST(1.0e-10));
+  if (flag) { return 1; }
+
+  LS = SUNLinSol_SPGMR(y, SUN_PREC_NONE, 0, sunctx);
+  if (!LS) { return 1; }
+
+  flag = ARKodeSetLinearSolver(arkode_mem, LS, NULL);
+  if (flag) { return 1; }
+
+  if (mode > 0)
+  {
+    flag = ARKodeSetJacTimesDirFn(arkode_mem, fdir);
+    if (flag) { return 1; }
+  }
+
+  if (mode == 2)
+  {
+    flag = ARKodeSetJacTimesRhsFn(arkode_mem, f_alt);
+    if (flag) { return 1; }
+  }
+
+  if (mode == 3)
+  {
+    flag = ARKodeSetJacTimes(arkode_mem, NULL, NULL);
+    if (flag) { return 1; }
+  }
+
+  flag = ARKodeEvolve(arkode_mem, SUN_RCONST(1.0), y, &tret, ARK_NORMAL);
+  if (flag < 0) { return 1; }
+
+  flag = ARKodeGetNumLinRhsEvals(arkode_mem, nfeDQ);
+  if (flag) { return 1; }
+  *ndir = udata.ndir;
+
+  N_VScale(ONE, y, yout);
+
+  N_VDestroy(y);
+  SUNLinSolFree(LS);
+  ARKodeFree(&arkode_mem);
+
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  N_Vector ydq = NULL, ydir = NULL, yalt = NULL;
+  long int nfeDQ[4], ndir[4];
+  sunrealtype err;
+  int fails = 0;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  ydq  = N_VNew_Serial(NEQ, sunctx);
+  ydir = N_VNew_Serial(NEQ, sunctx);
+  yalt = N_VNew_Serial(NEQ, sunctx);
+  if (!ydq || !ydir || !yalt) { return 1; }
+
+  if (run(sunctx, 0, ydq, &nfeDQ[0], &ndir[0])) { return 1; }
+  if (run(sunctx, 1, ydir, &nfeDQ[1], &ndir[1])) { return 1; }
+  if (run(sunctx, 2, yalt, &nfeDQ[2], &ndir[2])) { return 1; }
+  if (run(sunctx, 3, yalt, &nfeDQ[3], &ndir[3])) { return 1; }
+
+  printf("DQ:          nfeDQ = %ld, ndir = %ld\n", nfeDQ[0], ndir[0]);
+  printf("JacTimesDir: nfeDQ = %ld, ndir = %ld\n", nfeDQ[1], ndir[1]);
+  printf("JacTimesRhs: nfeDQ = %ld, ndir = %ld\n", nfeDQ[2], ndir[2]);
+  printf("JacTimes:    nfeDQ = %ld, ndir = %ld\n", nfeDQ[3], ndir[3]);
+
+  /* The directional derivative replaces every DQ RHS evaluation */
+  if (nfeDQ[0] == 0 || nfeDQ[1] != 0 || ndir[1] == 0)
+  {
+    fprintf(stderr, "ERROR: JacTimesDirFn did not replace the DQ product\n");
+    fails++;
+  }
+
+  /* The directional derivative is unused with an alternative Jv RHS */
+  if (nfeDQ[2] == 0 || ndir[2] != 0)
+  {
+    fprintf(stderr, "ERROR: JacTimesDirFn used with a JacTimesRhsFn\n");
+    fails++;
+  }
+
+  /* Replacing the Jacobian-vector product clears the directional derivative */
+  if (nfeDQ[3] == 0 || ndir[3] != 0)
+  {
+    fprintf(stderr, "ERROR: JacTimesDirFn used after ARKodeSetJacTimes\n");
+    fails++;
+  }
+
+  /* The solutions agree to within the integration tolerances */
+  N_VLinearSum(ONE, ydq, -ONE, ydir, ydir);
+  err = N_VMaxNorm(ydir);
+  printf("max |y_DQ - y_dir| = %" GSYM "\n", err);
+  if (err > SUN_RCONST(1.0e-6))
+  {
+    fprintf(stderr, "ERROR: DQ and directional derivative solutions differ\n");
+    fails++;
+  }
+
+  N_VDestroy(ydq);
+  N_VDestroy(ydir);
+  N_VDestroy(yalt);
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL\n");
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}
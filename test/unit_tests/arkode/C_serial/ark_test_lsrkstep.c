@@ -0,0 +1,503 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the LSRKStep module. For each method the test integrates
+ *
+ *   y' = lambda (y - t^3) + 3 t^2,  y(0) = 1,
+ *
+ * with exact solution y(t) = t^3 + exp(lambda t), and checks
+ *
+ *   1. the observed order of the fixed step solution at TF, and
+ *   2. the observed order of the local error estimate of a single step.
+ *
+ * The super-time-stepping methods additionally integrate the semi-discrete
+ * heat equation u_t = u_xx on (0,1) with homogeneous Dirichlet boundaries and
+ * u(0,x) = sin(pi x), using the exact dominant eigenvalue or the internal
+ * power iteration, and check the adaptive solution error, that the power
+ * iteration estimate is close to the exact spectral radius, and that more
+ * than two stages were used. Finally, the heat equation is integrated with a
+ * small maximum number of stages, which must succeed by retrying steps with
+ * the largest stable step size, and with a minimum step size above that
+ * step size, which must fail with ARK_CONV_FAILURE instead of retrying
+ * forever.
+ * ---------------------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode/arkode_lsrkstep.h"
+#include "nvector/nvector_serial.h"
+#include "sundials/sundials_math.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+#define LAMBDA SUN_RCONST(-2.0)
+#define TF     SUN_RCONST(1.0)
+
+/* heat equation grid size and final time */
+#define NX      99
+#define HEAT_TF SUN_RCONST(0.1)
+#define PI      SUN_RCONST(3.141592653589793238462643383279502884197169)
+
+/* Right-hand side function */
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = LAMBDA * (yd[0] - t * t * t) + SUN_RCONST(3.0) * t * t;
+
+  return 0;
+}
+
+/* Exact solution */
+static sunrealtype ytrue(sunrealtype t) { return t * t * t + SUNRexp(LAMBDA * t); }
+
+/* Heat equation right-hand side function */
+static int f_heat(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+  sunrealtype dx  = ONE / (NX + 1);
+  sunrealtype c   = ONE / (dx * dx);
+  sunrealtype yl, yr;
+  int i;
+
+  for (i = 0; i < NX; i++)
+  {
+    yl    = (i > 0) ? yd[i - 1] : ZERO;
+    yr    = (i < NX - 1) ? yd[i + 1] : ZERO;
+    fd[i] = c * (yl - TWO * yd[i] + yr);
+  }
+
+  return 0;
+}
+
+/* Heat equation dominant eigenvalue, lambda = -4 / dx^2 (an upper bound) */
+static int dom_eig_heat(sunrealtype t, N_Vector y, N_Vector fn,
+                        sunrealtype* lambdaR, sunrealtype* lambdaI,
+                        void* user_data, N_Vector temp1, N_Vector temp2,
+                        N_Vector temp3)
+{
+  sunrealtype dx = ONE / (NX + 1);
+
+  *lambdaR = -SUN_RCONST(4.0) / (dx * dx);
+  *lambdaI = ZERO;
+
+  return 0;
+}
+
+/* Create the integrator for a given method and number of stages */
+static void* create(ARKODE_LSRKMethodType method, int stages, N_Vector y,
+                    SUNContext sunctx)
+{
+  int retval       = 0;
+  void* arkode_mem = NULL;
+
+  N_VConst(ONE, y);
+
+  if (method == ARKODE_LSRK_RKC_2 || method == ARKODE_LSRK_RKL_2)
+  {
+    arkode_mem = LSRKStepCreateSTS(f, ZERO, y, sunctx);
+    if (!arkode_mem) { return NULL; }
+
+    retval = LSRKStepSetSTSMethod(arkode_mem, method);
+    if (retval) { return NULL; }
+
+    return arkode_mem;
+  }
+
+  arkode_mem = LSRKStepCreateSSP(f, ZERO, y, sunctx);
+  if (!arkode_mem) { return NULL; }
+
+  retval = LSRKStepSetSSPMethod(arkode_mem, method);
+  if (retval) { return NULL; }
+
+  retval = LSRKStepSetNumSSPStages(arkode_mem, stages);
+  if (retval) { return NULL; }
+
+  return arkode_mem;
+}
+
+/* Error at TF with a fixed step size h */
+static int fixed_error(ARKODE_LSRKMethodType method, int stages, sunrealtype h,
+                       sunrealtype* err, SUNContext sunctx)
+{
+  int retval       = 0;
+  void* arkode_mem = NULL;
+  N_Vector y       = NULL;
+  sunrealtype tret;
+
+  y = N_VNew_Serial(1, sunctx);
+  if (!y) { return 1; }
+
+  arkode_mem = create(method, stages, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  retval = ARKodeSetFixedStep(arkode_mem, h);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_NORMAL);
+  if (retval < 0) { return 1; }
+
+  *err = SUNRabs(N_VGetArrayPointer(y)[0] - ytrue(tret));
+
+  ARKodeFree(&arkode_mem);
+  N_VDestroy(y);
+
+  return 0;
+}
+
+/* Local error estimate of a single step of size h */
+static int estimate(ARKODE_LSRKMethodType method, int stages, sunrealtype h,
+                    sunrealtype* est, SUNContext sunctx)
+{
+  int retval       = 0;
+  void* arkode_mem = NULL;
+  N_Vector y       = NULL;
+  N_Vector ele     = NULL;
+  sunrealtype tret;
+
+  y   = N_VNew_Serial(1, sunctx);
+  ele = N_VNew_Serial(1, sunctx);
+  if (!y || !ele) { return 1; }
+
+  arkode_mem = create(method, stages, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  /* loose tolerances so the first step is accepted */
+  retval = ARKodeSStolerances(arkode_mem, ONE, ONE);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetInitStep(arkode_mem, h);
+  if (retval) { return 1; }
+
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_ONE_STEP);
+  if (retval < 0) { return 1; }
+
+  retval = ARKodeGetEstLocalErrors(arkode_mem, ele);
+  if (retval) { return 1; }
+
+  *est = SUNRabs(N_VGetArrayPointer(ele)[0]);
+
+  ARKodeFree(&arkode_mem);
+  N_VDestroy(y);
+  N_VDestroy(ele);
+
+  return 0;
+}
+
+/* Check the observed orders of one method */
+static int test(const char* name, ARKODE_LSRKMethodType method, int stages,
+                int q, int p, SUNContext sunctx)
+{
+  int fails = 0;
+  sunrealtype e1, e2, order;
+  sunrealtype h = SUN_RCONST(0.1);
+
+  /* global error of the solution */
+  if (fixed_error(method, stages, h, &e1, sunctx)) { return 1; }
+  if (fixed_error(method, stages, h / TWO, &e2, sunctx)) { return 1; }
+  order = (sunrealtype)(log((double)(e1 / e2)) / log(2.0));
+  printf("%-22s s = %2i: solution order %.2f (expected %i)\n", name, stages,
+         (double)order, q);
+  if (order < (sunrealtype)q - SUN_RCONST(0.25)) { fails++; }
+
+  /* local error estimate */
+  h = SUN_RCONST(0.05);
+  if (estimate(method, stages, h, &e1, sunctx)) { return 1; }
+  if (estimate(method, stages, h / TWO, &e2, sunctx)) { return 1; }
+  order = (sunrealtype)(log((double)(e1 / e2)) / log(2.0));
+  printf("%-22s s = %2i: estimate order %.2f (expected %i)\n", name, stages,
+         (double)order, p + 1);
+  if (order < (sunrealtype)(p + 1) - SUN_RCONST(0.25)) { fails++; }
+
+  return fails;
+}
+
+/* Check an adaptive super-time-stepping solution of the heat equation */
+static int test_heat(const char* name, ARKODE_LSRKMethodType method,
+                     sunbooleantype user_dom_eig, SUNContext sunctx)
+{
+  int retval       = 0;
+  int fails        = 0;
+  int i            = 0;
+  int stage_max    = 0;
+  void* arkode_mem = NULL;
+  N_Vector y       = NULL;
+  sunrealtype *yd, tret, dx, lambda1, err, uex;
+  long int nfe, ndomeig;
+
+  dx = ONE / (NX + 1);
+
+  y = N_VNew_Serial(NX, sunctx);
+  if (!y) { return 1; }
+  yd = N_VGetArrayPointer(y);
+  for (i = 0; i < NX; i++)
+  {
+    yd[i] = (sunrealtype)sin((double)(PI * (i + 1) * dx));
+  }
+
+  arkode_mem = LSRKStepCreateSTS(f_heat, ZERO, y, sunctx);
+  if (!arkode_mem)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  retval = LSRKStepSetSTSMethod(arkode_mem, method);
+  if (retval)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  if (user_dom_eig)
+  {
+    retval = LSRKStepSetDomEigFn(arkode_mem, dom_eig_heat);
+    if (retval)
+    {
+      fails = 1;
+      goto cleanup;
+    }
+  }
+
+  retval = ARKodeSStolerances(arkode_mem, SUN_RCONST(1.0e-6),
+                              SUN_RCONST(1.0e-10));
+  if (retval)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  retval = ARKodeSetStopTime(arkode_mem, HEAT_TF);
+  if (retval)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  retval = ARKodeEvolve(arkode_mem, HEAT_TF, y, &tret, ARK_NORMAL);
+  if (retval < 0)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  /* the exact solution of the semi-discrete problem */
+  lambda1 = (sunrealtype)sin((double)(PI * dx / TWO));
+  lambda1 = SUN_RCONST(4.0) / (dx * dx) * lambda1 * lambda1;
+  err = ZERO;
+  for (i = 0; i < NX; i++)
+  {
+    uex = SUNRexp(-lambda1 * tret) *
+          (sunrealtype)sin((double)(PI * (i + 1) * dx));
+    err = SUNMAX(err, SUNRabs(yd[i] - uex));
+  }
+
+  retval = LSRKStepGetMaxNumStages(arkode_mem, &stage_max);
+  if (retval)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  retval = LSRKStepGetNumRhsEvals(arkode_mem, &nfe);
+  if (retval)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  retval = LSRKStepGetNumDomEigUpdates(arkode_mem, &ndomeig);
+  if (retval)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  printf("%-22s heat (%s dom eig): error %.2e, max stages %i, fevals %li, "
+         "dom eig updates %li\n",
+         name, user_dom_eig ? "user" : "power", (double)err, stage_max, nfe,
+         ndomeig);
+
+  if (err > SUN_RCONST(1.0e-4)) { fails++; }
+  if (stage_max <= 2) { fails++; }
+  if (ndomeig < 1) { fails++; }
+
+cleanup:
+  ARKodeFree(&arkode_mem);
+  N_VDestroy(y);
+
+  return fails;
+}
+
+/* Check that steps exceeding the maximum number of stages are retried with a
+   stable step size, and that the retries stop at hmin */
+static int test_stage_limit(const char* name, ARKODE_LSRKMethodType method,
+                            sunrealtype hmin, int expected, SUNContext sunctx)
+{
+  int retval       = 0;
+  int fails        = 0;
+  int i            = 0;
+  int stage_max    = 0;
+  void* arkode_mem = NULL;
+  N_Vector y       = NULL;
+  sunrealtype *yd, tret, dx;
+
+  dx = ONE / (NX + 1);
+
+  y = N_VNew_Serial(NX, sunctx);
+  if (!y) { return 1; }
+  yd = N_VGetArrayPointer(y);
+  for (i = 0; i < NX; i++)
+  {
+    yd[i] = (sunrealtype)sin((double)(PI * (i + 1) * dx));
+  }
+
+  arkode_mem = LSRKStepCreateSTS(f_heat, ZERO, y, sunctx);
+  if (!arkode_mem)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  retval = LSRKStepSetSTSMethod(arkode_mem, method);
+  if (retval)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  retval = LSRKStepSetDomEigFn(arkode_mem, dom_eig_heat);
+  if (retval)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  retval = LSRKStepSetMaxNumStages(arkode_mem, 4);
+  if (retval)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  retval = ARKodeSStolerances(arkode_mem, SUN_RCONST(1.0e-4),
+                              SUN_RCONST(1.0e-8));
+  if (retval)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  retval = ARKodeSetMaxNumSteps(arkode_mem, 10000);
+  if (retval)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  if (hmin > ZERO)
+  {
+    retval = ARKodeSetMinStep(arkode_mem, hmin);
+    if (retval)
+    {
+      fails = 1;
+      goto cleanup;
+    }
+  }
+
+  retval = ARKodeSetStopTime(arkode_mem, HEAT_TF);
+  if (retval)
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  retval = ARKodeEvolve(arkode_mem, HEAT_TF, y, &tret, ARK_NORMAL);
+
+  if (LSRKStepGetMaxNumStages(arkode_mem, &stage_max))
+  {
+    fails = 1;
+    goto cleanup;
+  }
+
+  printf("%-22s stage limit 4, hmin %.1e: flag %i (expected %i), max stages "
+         "%i\n",
+         name, (double)hmin, retval, expected, stage_max);
+
+  if (retval != expected) { fails++; }
+  if (stage_max > 4) { fails++; }
+
+cleanup:
+  ARKodeFree(&arkode_mem);
+  N_VDestroy(y);
+
+  return fails;
+}
+
+/* Main program */
+int main(int argc, char* argv[])
+{
+  int retval        = 0;
+  int fails         = 0;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  fails += test("ARKODE_LSRK_SSP_S_2", ARKODE_LSRK_SSP_S_2, 2, 2, 1, sunctx);
+  fails += test("ARKODE_LSRK_SSP_S_2", ARKODE_LSRK_SSP_S_2, 10, 2, 1, sunctx);
+  fails += test("ARKODE_LSRK_SSP_S_3", ARKODE_LSRK_SSP_S_3, 4, 3, 2, sunctx);
+  fails += test("ARKODE_LSRK_SSP_S_3", ARKODE_LSRK_SSP_S_3, 9, 3, 2, sunctx);
+  fails += test("ARKODE_LSRK_SSP_S_3", ARKODE_LSRK_SSP_S_3, 16, 3, 2, sunctx);
+  fails += test("ARKODE_LSRK_SSP_10_4", ARKODE_LSRK_SSP_10_4, 10, 4, 3, sunctx);
+  fails += test("ARKODE_LSRK_RKC_2", ARKODE_LSRK_RKC_2, 0, 2, 2, sunctx);
+  fails += test("ARKODE_LSRK_RKL_2", ARKODE_LSRK_RKL_2, 0, 2, 2, sunctx);
+
+  fails += test_heat("ARKODE_LSRK_RKC_2", ARKODE_LSRK_RKC_2, SUNTRUE, sunctx);
+  fails += test_heat("ARKODE_LSRK_RKC_2", ARKODE_LSRK_RKC_2, SUNFALSE, sunctx);
+  fails += test_heat("ARKODE_LSRK_RKL_2", ARKODE_LSRK_RKL_2, SUNTRUE, sunctx);
+  fails += test_heat("ARKODE_LSRK_RKL_2", ARKODE_LSRK_RKL_2, SUNFALSE, sunctx);
+
+  fails += test_stage_limit("ARKODE_LSRK_RKC_2", ARKODE_LSRK_RKC_2, ZERO,
+                            ARK_TSTOP_RETURN, sunctx);
+  fails += test_stage_limit("ARKODE_LSRK_RKC_2", ARKODE_LSRK_RKC_2,
+                            SUN_RCONST(1.0e-3), ARK_CONV_FAILURE, sunctx);
+  fails += test_stage_limit("ARKODE_LSRK_RKL_2", ARKODE_LSRK_RKL_2, ZERO,
+                            ARK_TSTOP_RETURN, sunctx);
+  fails += test_stage_limit("ARKODE_LSRK_RKL_2", ARKODE_LSRK_RKL_2,
+                            SUN_RCONST(1.0e-3), ARK_CONV_FAILURE, sunctx);
+
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %i failures\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
@@ -0,0 +1,361 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for adaptive slow time steps in MRIStep. The test integrates the
+ * two-rate, nonlinear problem
+ *
+ *   u' = cos(t) - 0.5 v^2                (slow)
+ *   v' = -20 (v - sin(u))                (fast)
+ *
+ * with u(0) = v(0) = 0, and checks
+ *
+ *   1. the order of the local error estimate of each embedded coupling table,
+ *      from single slow steps of size H and H/2 with accurate fast solves,
+ *   2. the accuracy of adaptive solutions with each table, and
+ *   3. the accuracy of an adaptive solution with the multirate step size and
+ *      fast tolerance controller SUNAdaptController_MRIHTol.
+ * ---------------------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode/arkode_arkstep.h"
+#include "arkode/arkode_mristep.h"
+#include "nvector/nvector_serial.h"
+#include "sunadaptcontroller/sunadaptcontroller_mrihtol.h"
+#include "sunadaptcontroller/sunadaptcontroller_soderlind.h"
+#include "sundials/sundials_math.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define HALF SUN_RCONST(0.5)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+#define TF SUN_RCONST(2.0)
+
+/* Slow right-hand side function */
+static int fs(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = (sunrealtype)cos((double)t) - HALF * yd[1] * yd[1];
+  fd[1] = ZERO;
+
+  return 0;
+}
+
+/* Fast right-hand side function */
+static int ff(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = ZERO;
+  fd[1] = -SUN_RCONST(20.0) * (yd[1] - (sunrealtype)sin((double)yd[0]));
+
+  return 0;
+}
+
+/* Full right-hand side function (for the reference solution) */
+static int fn(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = (sunrealtype)cos((double)t) - HALF * yd[1] * yd[1];
+  fd[1] = -SUN_RCONST(20.0) * (yd[1] - (sunrealtype)sin((double)yd[0]));
+
+  return 0;
+}
+
+/* Adaptive MRIStep integrator (with an optional multirate controller) */
+static void* create_mri(ARKODE_MRITableID table, sunrealtype rtol,
+                        sunrealtype inner_h, SUNAdaptController C, N_Vector y,
+                        void** inner_mem, MRIStepInnerStepper* stepper,
+                        SUNMatrix* A, SUNLinearSolver* LS, SUNContext sunctx)
+{
+  int retval;
+  void* arkode_mem;
+  MRIStepCoupling MRIC;
+  sunbooleantype implicit = (table == ARKODE_MRI_GARK_IRK21a);
+
+  N_VConst(ZERO, y);
+
+  /* fast integrator: fixed small steps, or adaptive with a tolerance that may
+     be adjusted by the multirate controller */
+  *inner_mem = ARKStepCreate(ff, NULL, ZERO, y, sunctx);
+  if (!*inner_mem) { return NULL; }
+  if (inner_h > ZERO)
+  {
+    retval = ARKodeSetFixedStep(*inner_mem, inner_h);
+    if (retval) { return NULL; }
+  }
+  else
+  {
+    retval = ARKodeSStolerances(*inner_mem, rtol, SUN_RCONST(1.0e-10));
+    if (retval) { return NULL; }
+  }
+  retval = ARKodeSetOrder(*inner_mem, 4);
+  if (retval) { return NULL; }
+  retval = ARKodeSetMaxNumSteps(*inner_mem, 100000);
+  if (retval) { return NULL; }
+  retval = ARKStepCreateMRIStepInnerStepper(*inner_mem, stepper);
+  if (retval) { return NULL; }
+
+  /* slow integrator */
+  arkode_mem = MRIStepCreate(implicit ? NULL : fs, implicit ? fs : NULL, ZERO,
+                             y, *stepper, sunctx);
+  if (!arkode_mem) { return NULL; }
+
+  MRIC = MRIStepCoupling_LoadTable(table);
+  if (!MRIC) { return NULL; }
+  retval = MRIStepSetCoupling(arkode_mem, MRIC);
+  if (retval) { return NULL; }
+  MRIStepCoupling_Free(MRIC);
+
+  if (implicit)
+  {
+    *A = SUNDenseMatrix(2, 2, sunctx);
+    if (!*A) { return NULL; }
+    *LS = SUNLinSol_Dense(y, *A, sunctx);
+    if (!*LS) { return NULL; }
+    retval = ARKodeSetLinearSolver(arkode_mem, *LS, *A);
+    if (retval) { return NULL; }
+  }
+
+  retval = ARKodeSStolerances(arkode_mem, rtol, SUN_RCONST(1.0e-3) * rtol);
+  if (retval) { return NULL; }
+
+  if (C)
+  {
+    retval = ARKodeSetAdaptController(arkode_mem, C);
+    if (retval) { return NULL; }
+  }
+
+  retval = ARKodeSetMaxNumSteps(arkode_mem, 100000);
+  if (retval) { return NULL; }
+
+  return arkode_mem;
+}
+
+static void free_mri(void** arkode_mem, void** inner_mem,
+                     MRIStepInnerStepper* stepper, SUNMatrix* A,
+                     SUNLinearSolver* LS)
+{
+  ARKodeFree(arkode_mem);
+  MRIStepInnerStepper_Free(stepper);
+  ARKodeFree(inner_mem);
+  if (*LS) { SUNLinSolFree(*LS); }
+  if (*A) { SUNMatDestroy(*A); }
+  *LS = NULL;
+  *A  = NULL;
+}
+
+/* Local error estimate from a single slow step of size H */
+static int local_error(ARKODE_MRITableID table, sunrealtype H, N_Vector y,
+                       sunrealtype* est, SUNContext sunctx)
+{
+  int retval;
+  void* arkode_mem          = NULL;
+  void* inner_mem           = NULL;
+  MRIStepInnerStepper inner = NULL;
+  SUNMatrix A               = NULL;
+  SUNLinearSolver LS        = NULL;
+  sunrealtype tret;
+
+  /* a loose tolerance accepts the first step */
+  arkode_mem = create_mri(table, SUN_RCONST(1.0e3), H / SUN_RCONST(100.0),
+                          NULL, y, &inner_mem, &inner, &A, &LS, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  retval = ARKodeSetInitStep(arkode_mem, H);
+  if (retval) { return 1; }
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_ONE_STEP);
+  if (retval < 0) { return 1; }
+  if (SUNRabs(tret - H) > SUN_RCONST(1.0e-14)) { return 1; }
+
+  retval = ARKodeGetEstLocalErrors(arkode_mem, y);
+  if (retval) { return 1; }
+  *est = N_VMaxNorm(y);
+
+  free_mri(&arkode_mem, &inner_mem, &inner, &A, &LS);
+
+  return 0;
+}
+
+/* Check the order of the embedded error estimate of a table */
+static int test_embedding(ARKODE_MRITableID table, const char* name, int p,
+                          N_Vector yref, SUNContext sunctx)
+{
+  int fails     = 0;
+  N_Vector y    = NULL;
+  sunrealtype H = SUN_RCONST(0.1);
+  sunrealtype e1, e2, order;
+
+  y = N_VClone(yref);
+  if (!y) { return 1; }
+
+  if (local_error(table, H, y, &e1, sunctx)) { return 1; }
+  if (local_error(table, H / TWO, y, &e2, sunctx)) { return 1; }
+  order = (sunrealtype)(log((double)(e1 / e2)) / log(2.0));
+
+  printf("%s: error estimates %.2e, %.2e, order %.2f (expected >= %i)\n", name,
+         (double)e1, (double)e2, (double)order, p + 1);
+  if (order < (sunrealtype)(p + 1) - SUN_RCONST(0.3)) { fails++; }
+
+  N_VDestroy(y);
+
+  return fails;
+}
+
+/* Check the accuracy of an adaptive solution */
+static int test_adaptive(ARKODE_MRITableID table, const char* name,
+                         SUNAdaptController C, N_Vector yref, SUNContext sunctx)
+{
+  int retval;
+  int fails                 = 0;
+  void* arkode_mem          = NULL;
+  void* inner_mem           = NULL;
+  MRIStepInnerStepper inner = NULL;
+  SUNMatrix A               = NULL;
+  SUNLinearSolver LS        = NULL;
+  N_Vector y                = NULL;
+  long int nst, nfails, nst_fast;
+  sunrealtype tret, err;
+
+  y = N_VClone(yref);
+  if (!y) { return 1; }
+
+  /* fixed fast steps, or adaptive ones with the multirate controller */
+  arkode_mem = create_mri(table, SUN_RCONST(1.0e-5),
+                          C ? ZERO : SUN_RCONST(1.0e-3), C, y, &inner_mem,
+                          &inner, &A, &LS, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_NORMAL);
+  if (retval < 0) { return 1; }
+
+  retval = ARKodeGetNumSteps(arkode_mem, &nst);
+  if (retval) { return 1; }
+  retval = ARKodeGetNumErrTestFails(arkode_mem, &nfails);
+  if (retval) { return 1; }
+  retval = ARKodeGetNumSteps(inner_mem, &nst_fast);
+  if (retval) { return 1; }
+
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  err = N_VMaxNorm(y);
+
+  printf("%s (adaptive%s): error %.2e, slow steps %li, error test fails %li, "
+         "fast steps %li\n",
+         name, C ? ", MRIHTol" : "", (double)err, nst, nfails, nst_fast);
+
+  if (err > SUN_RCONST(1.0e-3)) { fails++; }
+  if (nst < 2) { fails++; }
+
+  free_mri(&arkode_mem, &inner_mem, &inner, &A, &LS);
+  N_VDestroy(y);
+
+  return fails;
+}
+
+/* Main program */
+int main(int argc, char* argv[])
+{
+  int retval                = 0;
+  int fails                 = 0;
+  void* arkode_mem          = NULL;
+  N_Vector yref             = NULL;
+  SUNAdaptController HCtrl  = NULL;
+  SUNAdaptController TolCtr = NULL;
+  SUNAdaptController C      = NULL;
+  SUNContext sunctx         = NULL;
+  sunrealtype tret;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  /* reference solution */
+  yref = N_VNew_Serial(2, sunctx);
+  if (!yref) { return 1; }
+  N_VConst(ZERO, yref);
+  arkode_mem = ARKStepCreate(fn, NULL, ZERO, yref, sunctx);
+  if (!arkode_mem) { return 1; }
+  retval = ARKodeSetOrder(arkode_mem, 5);
+  if (retval) { return 1; }
+  retval = ARKodeSStolerances(arkode_mem, SUN_RCONST(1.0e-12),
+                              SUN_RCONST(1.0e-14));
+  if (retval) { return 1; }
+  retval = ARKodeSetMaxNumSteps(arkode_mem, 1000000);
+  if (retval) { return 1; }
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+  retval = ARKodeEvolve(arkode_mem, TF, yref, &tret, ARK_NORMAL);
+  if (retval < 0) { return 1; }
+  ARKodeFree(&arkode_mem);
+
+  fails += test_embedding(ARKODE_MRI_GARK_ERK22b, "MRI_GARK_ERK22b", 1, yref,
+                          sunctx);
+  fails += test_embedding(ARKODE_MRI_GARK_RALSTON2, "MRI_GARK_RALSTON2", 1,
+                          yref, sunctx);
+  fails += test_embedding(ARKODE_MRI_GARK_ERK33a, "MRI_GARK_ERK33a", 2, yref,
+                          sunctx);
+  fails += test_embedding(ARKODE_MRI_GARK_RALSTON3, "MRI_GARK_RALSTON3", 2,
+                          yref, sunctx);
+  fails += test_embedding(ARKODE_MRI_GARK_ERK45a, "MRI_GARK_ERK45a", 3, yref,
+                          sunctx);
+  fails += test_embedding(ARKODE_MRI_GARK_IRK21a, "MRI_GARK_IRK21a", 1, yref,
+                          sunctx);
+
+  fails += test_adaptive(ARKODE_MRI_GARK_ERK22b, "MRI_GARK_ERK22b", NULL, yref,
+                         sunctx);
+  fails += test_adaptive(ARKODE_MRI_GARK_ERK33a, "MRI_GARK_ERK33a", NULL, yref,
+                         sunctx);
+  fails += test_adaptive(ARKODE_MRI_GARK_ERK45a, "MRI_GARK_ERK45a", NULL, yref,
+                         sunctx);
+  fails += test_adaptive(ARKODE_MRI_GARK_IRK21a, "MRI_GARK_IRK21a", NULL, yref,
+                         sunctx);
+
+  /* multirate step size and fast tolerance control */
+  HCtrl  = SUNAdaptController_I(sunctx);
+  TolCtr = SUNAdaptController_I(sunctx);
+  if (!HCtrl || !TolCtr) { return 1; }
+  C = SUNAdaptController_MRIHTol(sunctx, HCtrl, TolCtr);
+  if (!C) { return 1; }
+  fails += test_adaptive(ARKODE_MRI_GARK_ERK33a, "MRI_GARK_ERK33a", C, yref,
+                         sunctx);
+  SUNAdaptController_Destroy(C);
+  SUNAdaptController_Destroy(HCtrl);
+  SUNAdaptController_Destroy(TolCtr);
+
+  N_VDestroy(yref);
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %i failures\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
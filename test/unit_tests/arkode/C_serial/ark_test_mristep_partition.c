@@ -0,0 +1,466 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the component-partitioned mode of MRIStep. The test integrates
+ * the eight component problem
+ *
+ *   y0' = cos(t) - 0.5 y2^2              y4' = -y4 y2
+ *   y1' = -0.1 y1 + y5                   y5' = -50 (y5 - cos(y1))   (fast)
+ *   y2' = -20 (y2 - sin(y0))  (fast)     y6' = y0 - y3
+ *   y3' = 0.5 cos(t)                     y7' = -0.2 y7
+ *
+ * with a single RHS function and a mask selecting y2 and y5 as fast, and
+ * checks that
+ *
+ *   1. the inner integrator advances a packed state with two components,
+ *   2. the solution matches an MRIStep solution with the equivalent user split
+ *      RHS functions and an ARKStep inner stepper on the full state,
+ *   3. fixed slow steps converge with the order of the coupling table,
+ *   4. an adaptive solution meets the tolerances, and
+ *   5. invalid inputs are rejected.
+ * ---------------------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode/arkode_arkstep.h"
+#include "arkode/arkode_mristep.h"
+#include "nvector/nvector_serial.h"
+#include "sundials/sundials_math.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define HALF SUN_RCONST(0.5)
+#define ONE  SUN_RCONST(1.0)
+
+#define NEQ 8
+#define TF  SUN_RCONST(1.0)
+
+/* Full right-hand side function */
+static int fn(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = (sunrealtype)cos((double)t) - HALF * yd[2] * yd[2];
+  fd[1] = -SUN_RCONST(0.1) * yd[1] + yd[5];
+  fd[2] = -SUN_RCONST(20.0) * (yd[2] - (sunrealtype)sin((double)yd[0]));
+  fd[3] = HALF * (sunrealtype)cos((double)t);
+  fd[4] = -yd[4] * yd[2];
+  fd[5] = -SUN_RCONST(50.0) * (yd[5] - (sunrealtype)cos((double)yd[1]));
+  fd[6] = yd[0] - yd[3];
+  fd[7] = -SUN_RCONST(0.2) * yd[7];
+
+  return 0;
+}
+
+/* Slow right-hand side function of the user split problem */
+static int fs(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fn(t, y, ydot, user_data);
+  fd[2] = ZERO;
+  fd[5] = ZERO;
+
+  return 0;
+}
+
+/* Fast right-hand side function of the user split problem */
+static int ff(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+  sunrealtype f2, f5;
+
+  fn(t, y, ydot, user_data);
+  f2 = fd[2];
+  f5 = fd[5];
+  N_VConst(ZERO, ydot);
+  fd[2] = f2;
+  fd[5] = f5;
+
+  return 0;
+}
+
+static void set_initial_condition(N_Vector y)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  int i;
+
+  for (i = 0; i < NEQ; i++) { yd[i] = SUN_RCONST(0.1) * (sunrealtype)(i + 1); }
+}
+
+static N_Vector create_mask(SUNContext sunctx)
+{
+  N_Vector mask = N_VNew_Serial(NEQ, sunctx);
+  if (!mask) { return NULL; }
+
+  N_VConst(ZERO, mask);
+  N_VGetArrayPointer(mask)[2] = ONE;
+  N_VGetArrayPointer(mask)[5] = ONE;
+
+  return mask;
+}
+
+/* Solves the problem with fixed slow step H, inner step h and the ERK33a
+   coupling, with the partitioned mode or the user split RHS functions */
+static int solve_fixed(sunbooleantype partitioned, sunrealtype H, sunrealtype h,
+                       N_Vector y, SUNContext sunctx)
+{
+  int retval                  = 0;
+  void* arkode_mem            = NULL;
+  void* inner_arkode_mem      = NULL;
+  MRIStepInnerStepper stepper = NULL;
+  MRIStepCoupling MRIC        = NULL;
+  N_Vector mask               = NULL;
+  sunrealtype tret;
+
+  set_initial_condition(y);
+
+  if (partitioned)
+  {
+    mask = create_mask(sunctx);
+    if (!mask) { return 1; }
+    arkode_mem = MRIStepCreatePartitioned(fn, mask, ZERO, y, sunctx);
+    N_VDestroy(mask);
+    if (!arkode_mem) { return 1; }
+    retval = MRIStepGetPartitionedInnerMem(arkode_mem, &inner_arkode_mem);
+    if (retval) { return 1; }
+  }
+  else
+  {
+    inner_arkode_mem = ARKStepCreate(ff, NULL, ZERO, y, sunctx);
+    if (!inner_arkode_mem) { return 1; }
+    retval = ARKStepCreateMRIStepInnerStepper(inner_arkode_mem, &stepper);
+    if (retval) { return 1; }
+    arkode_mem = MRIStepCreate(fs, NULL, ZERO, y, stepper, sunctx);
+    if (!arkode_mem) { return 1; }
+  }
+
+  retval = ARKodeSetFixedStep(inner_arkode_mem, h);
+  if (retval) { return 1; }
+
+  MRIC = MRIStepCoupling_LoadTable(ARKODE_MRI_GARK_ERK33a);
+  if (!MRIC) { return 1; }
+  retval = MRIStepSetCoupling(arkode_mem, MRIC);
+  MRIStepCoupling_Free(MRIC);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetFixedStep(arkode_mem, H);
+  if (retval) { return 1; }
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_NORMAL);
+  if (retval < 0) { return 1; }
+
+  ARKodeFree(&arkode_mem);
+  if (!partitioned)
+  {
+    ARKodeFree(&inner_arkode_mem);
+    MRIStepInnerStepper_Free(&stepper);
+  }
+
+  return 0;
+}
+
+static int test_packed_state(SUNContext sunctx)
+{
+  int retval             = 0;
+  void* arkode_mem       = NULL;
+  void* inner_arkode_mem = NULL;
+  N_Vector y             = NULL;
+  N_Vector mask          = NULL;
+  N_Vector yf            = NULL;
+  sunrealtype t;
+
+  y    = N_VNew_Serial(NEQ, sunctx);
+  mask = create_mask(sunctx);
+  if (!y || !mask) { return 1; }
+  set_initial_condition(y);
+
+  arkode_mem = MRIStepCreatePartitioned(fn, mask, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+  retval = MRIStepGetPartitionedInnerMem(arkode_mem, &inner_arkode_mem);
+  if (retval) { return 1; }
+  retval = ARKodeSetFixedStep(arkode_mem, SUN_RCONST(0.01));
+  if (retval) { return 1; }
+  retval = ARKodeEvolve(arkode_mem, TF, y, &t, ARK_ONE_STEP);
+  if (retval < 0) { return 1; }
+  retval = ARKodeGetCurrentState(inner_arkode_mem, &yf);
+  if (retval) { return 1; }
+
+  if (N_VGetLength(yf) != 2 ||
+      N_VGetArrayPointer(yf)[0] != N_VGetArrayPointer(y)[2] ||
+      N_VGetArrayPointer(yf)[1] != N_VGetArrayPointer(y)[5])
+  {
+    printf(">>> FAILED: packed fast state is incorrect\n");
+    retval = 1;
+  }
+  else { printf("PASSED: packed fast state has two components\n"); }
+
+  ARKodeFree(&arkode_mem);
+  N_VDestroy(mask);
+  N_VDestroy(y);
+
+  return retval;
+}
+
+static int test_split_equivalence(SUNContext sunctx)
+{
+  int fails = 0;
+  N_Vector yp, ys;
+  sunrealtype diff;
+
+  yp = N_VNew_Serial(NEQ, sunctx);
+  ys = N_VNew_Serial(NEQ, sunctx);
+  if (!yp || !ys) { return 1; }
+
+  if (solve_fixed(SUNTRUE, SUN_RCONST(0.05), SUN_RCONST(0.005), yp, sunctx))
+  {
+    return 1;
+  }
+  if (solve_fixed(SUNFALSE, SUN_RCONST(0.05), SUN_RCONST(0.005), ys, sunctx))
+  {
+    return 1;
+  }
+
+  /* the solutions differ only by the inner integration error of the slow
+     components in the split problem */
+  N_VLinearSum(ONE, yp, -ONE, ys, ys);
+  diff = N_VMaxNorm(ys);
+  if (diff > SUN_RCONST(1.0e-7))
+  {
+    printf(">>> FAILED: partitioned and split solutions differ by %g\n",
+           (double)diff);
+    fails++;
+  }
+  else
+  {
+    printf("PASSED: partitioned and split solutions differ by %g\n",
+           (double)diff);
+  }
+
+  N_VDestroy(yp);
+  N_VDestroy(ys);
+
+  return fails;
+}
+
+static int test_order(N_Vector yref, SUNContext sunctx)
+{
+  int fails = 0;
+  N_Vector y;
+  sunrealtype err1, err2, order;
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  if (!y) { return 1; }
+
+  if (solve_fixed(SUNTRUE, SUN_RCONST(0.05), SUN_RCONST(0.0005), y, sunctx))
+  {
+    return 1;
+  }
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  err1 = N_VMaxNorm(y);
+
+  if (solve_fixed(SUNTRUE, SUN_RCONST(0.025), SUN_RCONST(0.0005), y, sunctx))
+  {
+    return 1;
+  }
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  err2 = N_VMaxNorm(y);
+
+  order = (sunrealtype)(log((double)(err1 / err2)) / log(2.0));
+  if (order < SUN_RCONST(2.6))
+  {
+    printf(">>> FAILED: observed order %g (errors %g, %g)\n", (double)order,
+           (double)err1, (double)err2);
+    fails++;
+  }
+  else
+  {
+    printf("PASSED: observed order %g (errors %g, %g)\n", (double)order,
+           (double)err1, (double)err2);
+  }
+
+  N_VDestroy(y);
+
+  return fails;
+}
+
+static int test_adaptive(N_Vector yref, SUNContext sunctx)
+{
+  int retval             = 0;
+  void* arkode_mem       = NULL;
+  void* inner_arkode_mem = NULL;
+  N_Vector y             = NULL;
+  N_Vector mask          = NULL;
+  sunrealtype tret, err;
+  const sunrealtype rtol = SUN_RCONST(1.0e-6);
+
+  y    = N_VNew_Serial(NEQ, sunctx);
+  mask = create_mask(sunctx);
+  if (!y || !mask) { return 1; }
+  set_initial_condition(y);
+
+  arkode_mem = MRIStepCreatePartitioned(fn, mask, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+  retval = ARKodeSStolerances(arkode_mem, rtol, SUN_RCONST(1.0e-3) * rtol);
+  if (retval) { return 1; }
+  retval = MRIStepGetPartitionedInnerMem(arkode_mem, &inner_arkode_mem);
+  if (retval) { return 1; }
+  retval = ARKodeSStolerances(inner_arkode_mem, SUN_RCONST(0.1) * rtol,
+                              SUN_RCONST(1.0e-4) * rtol);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_NORMAL);
+  if (retval < 0) { return 1; }
+
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  err = N_VMaxNorm(y);
+  if (err > SUN_RCONST(100.0) * rtol)
+  {
+    printf(">>> FAILED: adaptive error %g\n", (double)err);
+    retval = 1;
+  }
+  else
+  {
+    printf("PASSED: adaptive error %g\n", (double)err);
+    retval = 0;
+  }
+
+  ARKodeFree(&arkode_mem);
+  N_VDestroy(mask);
+  N_VDestroy(y);
+
+  return retval;
+}
+
+static int test_invalid_inputs(SUNContext sunctx)
+{
+  int retval                  = 0;
+  int fails                   = 0;
+  void* arkode_mem            = NULL;
+  void* inner_arkode_mem      = NULL;
+  N_Vector y                  = NULL;
+  N_Vector mask               = NULL;
+  N_Vector short_mask         = NULL;
+  MRIStepInnerStepper stepper = NULL;
+
+  y          = N_VNew_Serial(NEQ, sunctx);
+  mask       = N_VNew_Serial(NEQ, sunctx);
+  short_mask = N_VNew_Serial(NEQ - 1, sunctx);
+  if (!y || !mask || !short_mask) { return 1; }
+  set_initial_condition(y);
+  N_VConst(ZERO, mask);
+  N_VConst(ONE, short_mask);
+
+  /* a mask without fast components or of the wrong length */
+  if (MRIStepCreatePartitioned(fn, mask, ZERO, y, sunctx) != NULL) { fails++; }
+  if (MRIStepCreatePartitioned(fn, short_mask, ZERO, y, sunctx) != NULL)
+  {
+    fails++;
+  }
+
+  /* an integrator created without a partition */
+  inner_arkode_mem = ARKStepCreate(ff, NULL, ZERO, y, sunctx);
+  if (!inner_arkode_mem) { return 1; }
+  retval = ARKStepCreateMRIStepInnerStepper(inner_arkode_mem, &stepper);
+  if (retval) { return 1; }
+  arkode_mem = MRIStepCreate(fs, NULL, ZERO, y, stepper, sunctx);
+  if (!arkode_mem) { return 1; }
+  if (MRIStepGetPartitionedInnerMem(arkode_mem, &inner_arkode_mem) !=
+      ARK_ILL_INPUT)
+  {
+    fails++;
+  }
+  ARKodeFree(&arkode_mem);
+  ARKodeFree(&inner_arkode_mem);
+  MRIStepInnerStepper_Free(&stepper);
+
+  N_VGetArrayPointer(mask)[0] = ONE;
+  arkode_mem = MRIStepCreatePartitioned(fn, mask, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+  if (MRIStepReInit(arkode_mem, fn, fn, ZERO, y) != ARK_ILL_INPUT) { fails++; }
+  if (MRIStepReInit(arkode_mem, fn, NULL, ZERO, y) != ARK_SUCCESS) { fails++; }
+  if (MRIStepGetPartitionedInnerMem(arkode_mem, &inner_arkode_mem) !=
+        ARK_SUCCESS ||
+      inner_arkode_mem == NULL)
+  {
+    fails++;
+  }
+  ARKodeFree(&arkode_mem);
+
+  if (fails) { printf(">>> FAILED: %i invalid input checks\n", fails); }
+  else { printf("PASSED: invalid input checks\n"); }
+
+  N_VDestroy(short_mask);
+  N_VDestroy(mask);
+  N_VDestroy(y);
+
+  return fails;
+}
+
+/* -----------------------------------------------------------------------------
+ * Main Program
+ * ---------------------------------------------------------------------------*/
+
+int main(int argc, char* argv[])
+{
+  int retval        = 0;
+  int fails         = 0;
+  void* arkode_mem  = NULL;
+  N_Vector yref     = NULL;
+  SUNContext sunctx = NULL;
+  sunrealtype tret;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  /* reference solution */
+  yref = N_VNew_Serial(NEQ, sunctx);
+  if (!yref) { return 1; }
+  set_initial_condition(yref);
+  arkode_mem = ARKStepCreate(fn, NULL, ZERO, yref, sunctx);
+  if (!arkode_mem) { return 1; }
+  retval = ARKodeSetOrder(arkode_mem, 5);
+  if (retval) { return 1; }
+  retval = ARKodeSStolerances(arkode_mem, SUN_RCONST(1.0e-12),
+                              SUN_RCONST(1.0e-14));
+  if (retval) { return 1; }
+  retval = ARKodeSetMaxNumSteps(arkode_mem, 1000000);
+  if (retval) { return 1; }
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+  retval = ARKodeEvolve(arkode_mem, TF, yref, &tret, ARK_NORMAL);
+  if (retval < 0) { return 1; }
+  ARKodeFree(&arkode_mem);
+
+  fails += test_packed_state(sunctx);
+  fails += test_split_equivalence(sunctx);
+  fails += test_order(yref, sunctx);
+  fails += test_adaptive(yref, sunctx);
+  fails += test_invalid_inputs(sunctx);
+
+  N_VDestroy(yref);
+  SUNContext_Free(&sunctx);
+
+  if (fails) { printf("FAIL: %i tests failed\n", fails); }
+  else { printf("SUCCESS: all tests passed\n"); }
+
+  return fails;
+}
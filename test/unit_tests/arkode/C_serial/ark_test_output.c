@@ -0,0 +1,208 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the output function set with ARKodeSetOutputFn. A harmonic
+ * oscillator is integrated with ERKStep over many steps with an output function that logs
+ * the step times and passes the solution to a SUNOutputWriter. The ARKODE
+ * memory is freed before the writer is destroyed, and the file must then hold
+ * one record per step with the logged times, in order, and the final record
+ * must be the solution at the last step. An output function that fails at step NFAIL must
+ * stop the integration with ARK_OUTPUTFUNC_FAIL at that step.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arkode/arkode_erkstep.h"
+#include "nvector/nvector_serial.h"
+#include "sundials/sundials_outputwriter.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#else
+#define GSYM "g"
+#endif
+
+#define NEQ   2
+#define MAXST 100000
+#define NFAIL 10
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* Output function data */
+typedef struct
+{
+  SUNOutputWriter writer;
+  long int n;             /* number of calls               */
+  long int nfail;         /* call that fails, 0 for none   */
+  sunrealtype* tlog;      /* times of the calls            */
+  sunrealtype ylast[NEQ]; /* solution at the last call     */
+} OutputData;
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  NV_Ith_S(ydot, 0) = NV_Ith_S(y, 1);
+  NV_Ith_S(ydot, 1) = -NV_Ith_S(y, 0);
+  return 0;
+}
+
+static int output(sunrealtype t, N_Vector y, void* output_data)
+{
+  OutputData* odata = (OutputData*)output_data;
+
+  odata->n++;
+  if (odata->n == odata->nfail) { return 1; }
+  if (odata->n <= MAXST) { odata->tlog[odata->n - 1] = t; }
+  memcpy(odata->ylast, N_VGetArrayPointer(y), NEQ * sizeof(sunrealtype));
+
+  return SUNOutputWriter_OutputFn(t, y, odata->writer);
+}
+
+/* Integrate to tf with the output function, free ARKODE, destroy the writer,
+   and check the records in the file */
+static int run(SUNContext sunctx, long int nfail)
+{
+  void* arkode_mem = NULL;
+  N_Vector y       = NULL;
+  FILE* fp         = NULL;
+  char* buf        = NULL;
+  OutputData odata;
+  sunrealtype tf = SUN_RCONST(100.0), tret, tcur, t;
+  size_t recsize = (NEQ + 1) * sizeof(sunrealtype);
+  long int nst, nrecords, k;
+  long len;
+  int flag, fails = 0;
+
+  fp         = tmpfile();
+  odata.tlog = (sunrealtype*)malloc(MAXST * sizeof(sunrealtype));
+  if (!fp || !odata.tlog) { return 1; }
+  odata.n     = 0;
+  odata.nfail = nfail;
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  if (!y) { return 1; }
+  NV_Ith_S(y, 0) = ZERO;
+  NV_Ith_S(y, 1) = ONE;
+
+  if (SUNOutputWriter_Create(y, fp, sunctx, &odata.writer)) { return 1; }
+
+  arkode_mem = ERKStepCreate(f, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  flag = ARKodeSStolerances(arkode_mem, SUN_RCONST(1.0e-8), SUN_RCONST(1.0e-10));
+  if (flag) { return 1; }
+
+  flag = ARKodeSetMaxNumSteps(arkode_mem, MAXST);
+  if (flag) { return 1; }
+
+  flag = ARKodeSetOutputFn(arkode_mem, output, &odata);
+  if (flag) { return 1; }
+
+  flag = ARKodeEvolve(arkode_mem, tf, y, &tret, ARK_NORMAL);
+
+  if (ARKodeGetNumSteps(arkode_mem, &nst)) { return 1; }
+  if (ARKodeGetCurrentTime(arkode_mem, &tcur)) { return 1; }
+
+  if (nfail > 0)
+  {
+    if (flag != ARK_OUTPUTFUNC_FAIL || nst != nfail || tret != tcur)
+    {
+      fprintf(stderr,
+              "ERROR: failing output function returned %d at step %ld\n",
+              flag, nst);
+      fails++;
+    }
+  }
+  else if (flag != ARK_SUCCESS || odata.n != nst)
+  {
+    fprintf(stderr, "ERROR: ARKodeEvolve returned %d, %ld steps, %ld outputs\n",
+            flag, nst, odata.n);
+    fails++;
+  }
+
+  /* free the integrator before the writer */
+  N_VDestroy(y);
+  ARKodeFree(&arkode_mem);
+
+  if (SUNOutputWriter_GetNumRecords(odata.writer, &nrecords)) { return 1; }
+  if (SUNOutputWriter_Destroy(&odata.writer)) { return 1; }
+
+  /* read the records back */
+  fseek(fp, 0, SEEK_END);
+  len = ftell(fp);
+  rewind(fp);
+  buf = (char*)malloc(len > 0 ? len : 1);
+  if (!buf || fread(buf, 1, len, fp) != (size_t)len) { return 1; }
+
+  printf("%s output: %ld steps, %ld records, %ld bytes\n",
+         nfail ? "failing" : "full", nst, nrecords, len);
+
+  /* every step but the failed one is written, in order */
+  if (nrecords != (nfail ? nfail - 1 : nst) ||
+      (size_t)len != (size_t)nrecords * recsize)
+  {
+    fprintf(stderr, "ERROR: %ld records in %ld bytes for %ld steps\n",
+            nrecords, len, nst);
+    fails++;
+  }
+  else
+  {
+    for (k = 0; k < nrecords; k++)
+    {
+      memcpy(&t, buf + k * recsize, sizeof(sunrealtype));
+      if (t != odata.tlog[k] || (k > 0 && t <= odata.tlog[k - 1]))
+      {
+        fprintf(stderr, "ERROR: record %ld has t = %" GSYM "\n", k, t);
+        fails++;
+        break;
+      }
+    }
+
+    /* the last record is the solution at the last step */
+    if (nfail == 0 && nrecords > 0 &&
+        (t != tcur || memcmp(buf + (nrecords - 1) * recsize + sizeof(sunrealtype),
+                             odata.ylast, NEQ * sizeof(sunrealtype))))
+    {
+      fprintf(stderr, "ERROR: the last record is not the last step\n");
+      fails++;
+    }
+  }
+
+  free(buf);
+  free(odata.tlog);
+  fclose(fp);
+
+  return fails;
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  int fails         = 0;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  fails += run(sunctx, 0);
+  fails += run(sunctx, NFAIL);
+
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d checks failed\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}
@@ -0,0 +1,315 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the PDIRKStep module. The test integrates the stiff,
+ * nonlinear, non-autonomous problem
+ *
+ *   u' = -50 (u - cos(v)),  v' = cos(t) - u v,  u(0) = 1, v(0) = 0,
+ *
+ * with one dense matrix and linear solver per stage, and checks
+ *
+ *   1. the observed order of each method with fixed steps, against a
+ *      reference solution computed with a much smaller step,
+ *   2. the accuracy of an adaptive solution and that the Jacobian is reused
+ *      across steps, and
+ *   3. that the fixed step and adaptive solutions and counters with two and
+ *      NSTAGES threads for the stage solves are identical to the serial run
+ *      (the threads are only used when ARKODE is built with OpenMP).
+ * ---------------------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode/arkode_pdirkstep.h"
+#include "nvector/nvector_serial.h"
+#include "sundials/sundials_math.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+#define TF SUN_RCONST(1.0)
+
+#define NSTAGES 3
+
+/* Right-hand side function */
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = -SUN_RCONST(50.0) * (yd[0] - (sunrealtype)cos((double)yd[1]));
+  fd[1] = (sunrealtype)cos((double)t) - yd[0] * yd[1];
+
+  return 0;
+}
+
+/* Jacobian function */
+static int jac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+               void* user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+
+  SM_ELEMENT_D(J, 0, 0) = -SUN_RCONST(50.0);
+  SM_ELEMENT_D(J, 0, 1) = -SUN_RCONST(50.0) * (sunrealtype)sin((double)yd[1]);
+  SM_ELEMENT_D(J, 1, 0) = -yd[1];
+  SM_ELEMENT_D(J, 1, 1) = -yd[0];
+
+  return 0;
+}
+
+/* Solution at TF with a fixed (h > 0) or adaptive (h = 0) step size */
+static int solve(ARKODE_PDIRKMethodType method, sunrealtype h, int nthreads,
+                 N_Vector y, long int* nst, long int* nje, long int* nni,
+                 SUNContext sunctx)
+{
+  int retval       = 0;
+  int i            = 0;
+  void* arkode_mem = NULL;
+  SUNMatrix A[NSTAGES];
+  SUNLinearSolver LS[NSTAGES];
+  sunrealtype tret;
+
+  N_VGetArrayPointer(y)[0] = ONE;
+  N_VGetArrayPointer(y)[1] = ZERO;
+
+  arkode_mem = PDIRKStepCreate(f, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  for (i = 0; i < NSTAGES; i++)
+  {
+    A[i]  = SUNDenseMatrix(2, 2, sunctx);
+    LS[i] = SUNLinSol_Dense(y, A[i], sunctx);
+    if (!A[i] || !LS[i]) { return 1; }
+  }
+
+  retval = PDIRKStepSetLinearSolvers(arkode_mem, NSTAGES, LS, A);
+  if (retval) { return 1; }
+
+  retval = PDIRKStepSetJacFn(arkode_mem, jac);
+  if (retval) { return 1; }
+
+  retval = PDIRKStepSetMethod(arkode_mem, method);
+  if (retval) { return 1; }
+
+  retval = PDIRKStepSetNumThreads(arkode_mem, nthreads);
+  if (retval) { return 1; }
+
+  if (h > ZERO)
+  {
+    retval = ARKodeSetFixedStep(arkode_mem, h);
+    if (retval) { return 1; }
+
+    /* converge the stage systems tightly to observe the method order */
+    retval = ARKodeSetNonlinConvCoef(arkode_mem, SUN_RCONST(1.0e-6));
+    if (retval) { return 1; }
+
+    retval = ARKodeSetMaxNonlinIters(arkode_mem, 10);
+    if (retval) { return 1; }
+  }
+  else
+  {
+    retval = ARKodeSStolerances(arkode_mem, SUN_RCONST(1.0e-6),
+                                SUN_RCONST(1.0e-10));
+    if (retval) { return 1; }
+  }
+
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetMaxNumSteps(arkode_mem, 100000);
+  if (retval) { return 1; }
+
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_NORMAL);
+  if (retval < 0) { return 1; }
+
+  if (nst)
+  {
+    retval = ARKodeGetNumSteps(arkode_mem, nst);
+    if (retval) { return 1; }
+  }
+
+  if (nje)
+  {
+    retval = PDIRKStepGetNumJacEvals(arkode_mem, nje);
+    if (retval) { return 1; }
+  }
+
+  if (nni)
+  {
+    retval = ARKodeGetNumNonlinSolvIters(arkode_mem, nni);
+    if (retval) { return 1; }
+  }
+
+  ARKodeFree(&arkode_mem);
+  for (i = 0; i < NSTAGES; i++)
+  {
+    SUNLinSolFree(LS[i]);
+    SUNMatDestroy(A[i]);
+  }
+
+  return 0;
+}
+
+/* Check the observed order of a method */
+static int test_order(ARKODE_PDIRKMethodType method, const char* name, int q,
+                      sunrealtype h, N_Vector yref, SUNContext sunctx)
+{
+  int fails  = 0;
+  N_Vector y = NULL;
+  sunrealtype e1, e2, order;
+
+  y = N_VClone(yref);
+  if (!y) { return 1; }
+
+  if (solve(method, h, 1, y, NULL, NULL, NULL, sunctx)) { return 1; }
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  e1 = N_VMaxNorm(y);
+  if (solve(method, h / TWO, 1, y, NULL, NULL, NULL, sunctx)) { return 1; }
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  e2    = N_VMaxNorm(y);
+  order = (sunrealtype)(log((double)(e1 / e2)) / log(2.0));
+
+  printf("%s: errors %.2e, %.2e, solution order %.2f (expected >= %i)\n",
+         name, (double)e1, (double)e2, (double)order, q);
+  if (order < (sunrealtype)q - SUN_RCONST(0.25)) { fails++; }
+
+  N_VDestroy(y);
+
+  return fails;
+}
+
+/* Check an adaptive solution and its independence of the number of threads */
+static int test_adaptive(ARKODE_PDIRKMethodType method, const char* name,
+                         N_Vector yref, SUNContext sunctx)
+{
+  int fails   = 0;
+  N_Vector y1 = NULL;
+  long int nst, nje, nni;
+  sunrealtype err;
+
+  y1 = N_VClone(yref);
+  if (!y1) { return 1; }
+
+  if (solve(method, ZERO, 1, y1, &nst, &nje, &nni, sunctx)) { return 1; }
+
+  N_VLinearSum(ONE, y1, -ONE, yref, y1);
+  err = N_VMaxNorm(y1);
+
+  printf("%s (adaptive): error %.2e, steps %li, NLS iters %li, Jac evals "
+         "%li\n",
+         name, (double)err, nst, nni, nje);
+
+  if (err > SUN_RCONST(1.0e-4)) { fails++; }
+  if (nje >= nst) { fails++; }
+
+  N_VDestroy(y1);
+
+  return fails;
+}
+
+/* Check that threaded runs match the serial run exactly (h = 0 is adaptive) */
+static int test_threads(ARKODE_PDIRKMethodType method, const char* name,
+                        sunrealtype h, N_Vector yref, SUNContext sunctx)
+{
+  int fails   = 0;
+  int k       = 0;
+  int nth[2]  = {2, NSTAGES};
+  N_Vector y1 = NULL;
+  N_Vector y2 = NULL;
+  long int nst1, nje1, nni1, nst2, nje2, nni2;
+
+  y1 = N_VClone(yref);
+  y2 = N_VClone(yref);
+  if (!y1 || !y2) { return 1; }
+
+  if (solve(method, h, 1, y1, &nst1, &nje1, &nni1, sunctx)) { return 1; }
+
+  for (k = 0; k < 2; k++)
+  {
+    if (solve(method, h, nth[k], y2, &nst2, &nje2, &nni2, sunctx)) { return 1; }
+
+    printf("%s (%s, %i threads): steps %li/%li, NLS iters %li/%li, Jac evals "
+           "%li/%li, solution %s\n",
+           name, (h > ZERO) ? "fixed" : "adaptive", nth[k], nst2, nst1, nni2,
+           nni1, nje2, nje1,
+           (N_VGetArrayPointer(y1)[0] == N_VGetArrayPointer(y2)[0] &&
+            N_VGetArrayPointer(y1)[1] == N_VGetArrayPointer(y2)[1])
+             ? "identical"
+             : "DIFFERENT");
+
+    if (N_VGetArrayPointer(y1)[0] != N_VGetArrayPointer(y2)[0]) { fails++; }
+    if (N_VGetArrayPointer(y1)[1] != N_VGetArrayPointer(y2)[1]) { fails++; }
+    if (nst1 != nst2 || nje1 != nje2 || nni1 != nni2) { fails++; }
+  }
+
+  N_VDestroy(y1);
+  N_VDestroy(y2);
+
+  return fails;
+}
+
+/* Main program */
+int main(int argc, char* argv[])
+{
+  int retval        = 0;
+  int fails         = 0;
+  N_Vector yref     = NULL;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  /* reference solution */
+  yref = N_VNew_Serial(2, sunctx);
+  if (!yref) { return 1; }
+  if (solve(ARKODE_PDIRK_RADAU_3_5, SUN_RCONST(0.05) / SUN_RCONST(64.0), 1,
+            yref, NULL, NULL, NULL, sunctx))
+  {
+    return 1;
+  }
+
+  fails += test_order(ARKODE_PDIRK_RADAU_2_3, "RADAU_2_3", 3,
+                      SUN_RCONST(0.025), yref, sunctx);
+  /* with h lambda ~ -0.6 the stiff component is not yet in the asymptotic
+     regime of the iteration, which limits the observed order to about 4.5 */
+  fails += test_order(ARKODE_PDIRK_RADAU_3_5, "RADAU_3_5", 4,
+                      SUN_RCONST(0.0125), yref, sunctx);
+  fails += test_adaptive(ARKODE_PDIRK_RADAU_2_3, "RADAU_2_3", yref, sunctx);
+  fails += test_adaptive(ARKODE_PDIRK_RADAU_3_5, "RADAU_3_5", yref, sunctx);
+  fails += test_threads(ARKODE_PDIRK_RADAU_2_3, "RADAU_2_3", SUN_RCONST(0.025),
+                        yref, sunctx);
+  fails += test_threads(ARKODE_PDIRK_RADAU_2_3, "RADAU_2_3", ZERO, yref, sunctx);
+  fails += test_threads(ARKODE_PDIRK_RADAU_3_5, "RADAU_3_5", SUN_RCONST(0.0125),
+                        yref, sunctx);
+  fails += test_threads(ARKODE_PDIRK_RADAU_3_5, "RADAU_3_5", ZERO, yref, sunctx);
+
+  N_VDestroy(yref);
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %i failures\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
@@ -0,0 +1,253 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the RadauStep module. The test integrates the stiff,
+ * nonlinear, non-autonomous problem
+ *
+ *   u' = -50 (u - cos(v)),  v' = cos(t) - u v,  u(0) = 1, v(0) = 0,
+ *
+ * and checks
+ *
+ *   1. the observed order of each method with fixed steps, against a
+ *      reference solution computed with a much smaller step,
+ *   2. the accuracy of an adaptive solution and that the Jacobian and the
+ *      factorizations are reused across steps, and
+ *   3. that the difference quotient Jacobian gives the same accuracy.
+ * ---------------------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode/arkode_radaustep.h"
+#include "nvector/nvector_serial.h"
+#include "sundials/sundials_math.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+#define TF SUN_RCONST(1.0)
+
+/* Right-hand side function */
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = -SUN_RCONST(50.0) * (yd[0] - (sunrealtype)cos((double)yd[1]));
+  fd[1] = (sunrealtype)cos((double)t) - yd[0] * yd[1];
+
+  return 0;
+}
+
+/* Jacobian function */
+static int jac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+               void* user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+
+  SM_ELEMENT_D(J, 0, 0) = -SUN_RCONST(50.0);
+  SM_ELEMENT_D(J, 0, 1) = -SUN_RCONST(50.0) * (sunrealtype)sin((double)yd[1]);
+  SM_ELEMENT_D(J, 1, 0) = -yd[1];
+  SM_ELEMENT_D(J, 1, 1) = -yd[0];
+
+  return 0;
+}
+
+/* Solution at TF with a fixed (h > 0) or adaptive (h = 0) step size */
+static int solve(ARKODE_RadauMethodType method, sunrealtype h, ARKLsJacFn J,
+                 N_Vector y, long int* nst, long int* nje, long int* nsetups,
+                 SUNContext sunctx)
+{
+  int retval       = 0;
+  void* arkode_mem = NULL;
+  sunrealtype tret;
+
+  N_VGetArrayPointer(y)[0] = ONE;
+  N_VGetArrayPointer(y)[1] = ZERO;
+
+  arkode_mem = RadauStepCreate(f, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  retval = RadauStepSetJacFn(arkode_mem, J);
+  if (retval) { return 1; }
+
+  retval = RadauStepSetMethod(arkode_mem, method);
+  if (retval) { return 1; }
+
+  if (h > ZERO)
+  {
+    retval = ARKodeSetFixedStep(arkode_mem, h);
+    if (retval) { return 1; }
+
+    /* converge the stage systems tightly to observe the method order (the
+       first iterations from the Jacobian at v = 0 are not monotone) */
+    retval = ARKodeSetNonlinConvCoef(arkode_mem, SUN_RCONST(1.0e-6));
+    if (retval) { return 1; }
+
+    retval = ARKodeSetMaxNonlinIters(arkode_mem, 20);
+    if (retval) { return 1; }
+
+    retval = ARKodeSetNonlinRDiv(arkode_mem, SUN_RCONST(1000.0));
+    if (retval) { return 1; }
+  }
+  else
+  {
+    retval = ARKodeSStolerances(arkode_mem, SUN_RCONST(1.0e-6),
+                                SUN_RCONST(1.0e-10));
+    if (retval) { return 1; }
+  }
+
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetMaxNumSteps(arkode_mem, 100000);
+  if (retval) { return 1; }
+
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_NORMAL);
+  if (retval < 0) { return 1; }
+
+  if (nst)
+  {
+    retval = ARKodeGetNumSteps(arkode_mem, nst);
+    if (retval) { return 1; }
+  }
+
+  if (nje)
+  {
+    retval = RadauStepGetNumJacEvals(arkode_mem, nje);
+    if (retval) { return 1; }
+  }
+
+  if (nsetups)
+  {
+    retval = ARKodeGetNumLinSolvSetups(arkode_mem, nsetups);
+    if (retval) { return 1; }
+  }
+
+  ARKodeFree(&arkode_mem);
+
+  return 0;
+}
+
+/* Check the observed order of a method */
+static int test_order(ARKODE_RadauMethodType method, const char* name, int q,
+                      sunrealtype h, N_Vector yref, SUNContext sunctx)
+{
+  int fails  = 0;
+  N_Vector y = NULL;
+  sunrealtype e1, e2, order;
+
+  y = N_VClone(yref);
+  if (!y) { return 1; }
+
+  if (solve(method, h, jac, y, NULL, NULL, NULL, sunctx)) { return 1; }
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  e1 = N_VMaxNorm(y);
+  if (solve(method, h / TWO, jac, y, NULL, NULL, NULL, sunctx)) { return 1; }
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  e2    = N_VMaxNorm(y);
+  order = (sunrealtype)(log((double)(e1 / e2)) / log(2.0));
+
+  printf("%s: errors %.2e, %.2e, solution order %.2f (expected >= %i)\n",
+         name, (double)e1, (double)e2, (double)order, q);
+  if (order < (sunrealtype)q - SUN_RCONST(0.25)) { fails++; }
+
+  N_VDestroy(y);
+
+  return fails;
+}
+
+/* Check an adaptive solution with the analytic and the DQ Jacobian */
+static int test_adaptive(ARKODE_RadauMethodType method, const char* name,
+                         N_Vector yref, SUNContext sunctx)
+{
+  int fails   = 0;
+  N_Vector y1 = NULL;
+  N_Vector y2 = NULL;
+  long int nst, nje, nsetups;
+  sunrealtype err, errdq;
+
+  y1 = N_VClone(yref);
+  y2 = N_VClone(yref);
+  if (!y1 || !y2) { return 1; }
+
+  if (solve(method, ZERO, jac, y1, &nst, &nje, &nsetups, sunctx)) { return 1; }
+  if (solve(method, ZERO, NULL, y2, NULL, NULL, NULL, sunctx)) { return 1; }
+
+  N_VLinearSum(ONE, y1, -ONE, yref, y1);
+  err = N_VMaxNorm(y1);
+  N_VLinearSum(ONE, y2, -ONE, yref, y2);
+  errdq = N_VMaxNorm(y2);
+
+  printf("%s (adaptive): error %.2e, steps %li, Jac evals %li, LS setups "
+         "%li, DQ Jacobian error %.2e\n",
+         name, (double)err, nst, nje, nsetups, (double)errdq);
+
+  if (err > SUN_RCONST(1.0e-4)) { fails++; }
+  if (errdq > SUN_RCONST(1.0e-4)) { fails++; }
+  if (nje >= nst) { fails++; }
+
+  N_VDestroy(y1);
+  N_VDestroy(y2);
+
+  return fails;
+}
+
+/* Main program */
+int main(int argc, char* argv[])
+{
+  int retval        = 0;
+  int fails         = 0;
+  N_Vector yref     = NULL;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  /* reference solution */
+  yref = N_VNew_Serial(2, sunctx);
+  if (!yref) { return 1; }
+  if (solve(ARKODE_RADAU_5_9, SUN_RCONST(0.01), jac, yref, NULL, NULL, NULL,
+            sunctx))
+  {
+    return 1;
+  }
+
+  fails += test_order(ARKODE_RADAU_3_5, "RADAU_3_5", 5, SUN_RCONST(0.025),
+                      yref, sunctx);
+  /* smaller steps reach roundoff, and with h lambda ~ -10 the stiff component
+     limits the observed order of the 5-stage method to about 8.5 */
+  fails += test_order(ARKODE_RADAU_5_9, "RADAU_5_9", 8, SUN_RCONST(0.2), yref,
+                      sunctx);
+  fails += test_adaptive(ARKODE_RADAU_3_5, "RADAU_3_5", yref, sunctx);
+  fails += test_adaptive(ARKODE_RADAU_5_9, "RADAU_5_9", yref, sunctx);
+
+  N_VDestroy(yref);
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %i failures\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
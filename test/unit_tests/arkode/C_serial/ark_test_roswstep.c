@@ -0,0 +1,320 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the RosWStep module. The test integrates the stiff,
+ * nonlinear, non-autonomous problem
+ *
+ *   u' = -50 (u - cos(v)),  v' = cos(t) - u v,  u(0) = 1, v(0) = 0,
+ *
+ * with a dense matrix and linear solver, and checks
+ *
+ *   1. the observed order of each method with fixed steps, against a
+ *      reference solution computed with a much smaller step, both when the
+ *      Jacobian is updated in every step and when it is only updated every
+ *      20 steps (W-method),
+ *   2. that with a fixed step the linear system is only set up every msbp
+ *      steps, and
+ *   3. the accuracy of an adaptive solution and that the Jacobian is reused
+ *      across steps.
+ * ---------------------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode/arkode_roswstep.h"
+#include "nvector/nvector_serial.h"
+#include "sundials/sundials_math.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+#define TF SUN_RCONST(1.0)
+
+/* Right-hand side function */
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = -SUN_RCONST(50.0) * (yd[0] - (sunrealtype)cos((double)yd[1]));
+  fd[1] = (sunrealtype)cos((double)t) - yd[0] * yd[1];
+
+  return 0;
+}
+
+/* Solution at TF with a fixed step size h (msbj = Jacobian frequency, msbp =
+   linear solver setup frequency) */
+static int fixed_solve(ARKODE_RosWMethodType method, sunrealtype h, long int msbj,
+                       int msbp, N_Vector y, long int* nsetups, long int* nje,
+                       SUNContext sunctx)
+{
+  int retval        = 0;
+  void* arkode_mem  = NULL;
+  SUNMatrix A       = NULL;
+  SUNLinearSolver LS = NULL;
+  long int nst;
+  sunrealtype tret;
+
+  N_VGetArrayPointer(y)[0] = ONE;
+  N_VGetArrayPointer(y)[1] = ZERO;
+
+  arkode_mem = RosWStepCreate(f, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  A  = SUNDenseMatrix(2, 2, sunctx);
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  if (!A || !LS) { return 1; }
+
+  retval = ARKodeSetLinearSolver(arkode_mem, LS, A);
+  if (retval) { return 1; }
+
+  retval = RosWStepSetMethod(arkode_mem, method);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetJacEvalFrequency(arkode_mem, msbj);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetLSetupFrequency(arkode_mem, msbp);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetFixedStep(arkode_mem, h);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetMaxNumSteps(arkode_mem, 100000);
+  if (retval) { return 1; }
+
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_NORMAL);
+  if (retval < 0) { return 1; }
+
+  retval = ARKodeGetNumSteps(arkode_mem, &nst);
+  if (retval) { return 1; }
+
+  if (nsetups)
+  {
+    retval = ARKodeGetNumLinSolvSetups(arkode_mem, nsetups);
+    if (retval) { return 1; }
+  }
+
+  if (nje)
+  {
+    retval = ARKodeGetNumJacEvals(arkode_mem, nje);
+    if (retval) { return 1; }
+  }
+
+  ARKodeFree(&arkode_mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+
+  return 0;
+}
+
+/* Check the observed order of a method with a current or a stale Jacobian */
+static int test_order(ARKODE_RosWMethodType method, const char* name, int q,
+                      sunbooleantype stale, N_Vector yref, SUNContext sunctx)
+{
+  int fails     = 0;
+  N_Vector y    = NULL;
+  long int msbj = stale ? 20 : 1;
+  sunrealtype e1, e2, order;
+  sunrealtype h = SUN_RCONST(0.0125);
+
+  y = N_VClone(yref);
+  if (!y) { return 1; }
+
+  if (fixed_solve(method, h, msbj, -1, y, NULL, NULL, sunctx)) { return 1; }
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  e1 = N_VMaxNorm(y);
+  if (fixed_solve(method, h / TWO, msbj, -1, y, NULL, NULL, sunctx))
+  {
+    return 1;
+  }
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  e2    = N_VMaxNorm(y);
+  order = (sunrealtype)(log((double)(e1 / e2)) / log(2.0));
+
+  /* with a stale Jacobian only the W-method order (2) is guaranteed */
+  if (stale) { q = 2; }
+  printf("%s (%s J): solution order %.2f (expected >= %i)\n", name,
+         stale ? "stale" : "current", (double)order, q);
+  if (order < (sunrealtype)q - SUN_RCONST(0.25)) { fails++; }
+
+  N_VDestroy(y);
+
+  return fails;
+}
+
+/* Check that the linear solver setup is reused with a fixed step size */
+static int test_reuse(N_Vector yref, SUNContext sunctx)
+{
+  int fails  = 0;
+  N_Vector y = NULL;
+  long int nsetups, nje;
+  sunrealtype err;
+
+  y = N_VClone(yref);
+  if (!y) { return 1; }
+
+  /* default setup and Jacobian frequencies */
+  if (fixed_solve(ARKODE_ROSW_ROS34PW2, SUN_RCONST(0.01), 0, 0, y, &nsetups,
+                  &nje, sunctx))
+  {
+    return 1;
+  }
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  err = N_VMaxNorm(y);
+
+  printf("ROS34PW2 (fixed h): error %.2e, 100 steps, LS setups %li, "
+         "Jac evals %li\n",
+         (double)err, nsetups, nje);
+
+  if (err > SUN_RCONST(1.0e-5)) { fails++; }
+  /* a setup every msbp = 20 steps and for the last step, which is shortened
+     to reach TF exactly */
+  if (nsetups > 6) { fails++; }
+  if (nje > nsetups) { fails++; }
+
+  N_VDestroy(y);
+
+  return fails;
+}
+
+/* Check an adaptive solution */
+static int test_adaptive(ARKODE_RosWMethodType method, const char* name,
+                         N_Vector yref, SUNContext sunctx)
+{
+  int retval         = 0;
+  int fails          = 0;
+  void* arkode_mem   = NULL;
+  N_Vector y         = NULL;
+  SUNMatrix A        = NULL;
+  SUNLinearSolver LS = NULL;
+  long int nst, nfe, nsetups, nje, nlinsolves;
+  sunrealtype tret, err;
+
+  y = N_VClone(yref);
+  if (!y) { return 1; }
+  N_VGetArrayPointer(y)[0] = ONE;
+  N_VGetArrayPointer(y)[1] = ZERO;
+
+  arkode_mem = RosWStepCreate(f, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  A  = SUNDenseMatrix(2, 2, sunctx);
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  if (!A || !LS) { return 1; }
+
+  retval = ARKodeSetLinearSolver(arkode_mem, LS, A);
+  if (retval) { return 1; }
+
+  retval = RosWStepSetMethod(arkode_mem, method);
+  if (retval) { return 1; }
+
+  retval = ARKodeSStolerances(arkode_mem, SUN_RCONST(1.0e-6),
+                              SUN_RCONST(1.0e-10));
+  if (retval) { return 1; }
+
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+
+  retval = ARKodeSetMaxNumSteps(arkode_mem, 100000);
+  if (retval) { return 1; }
+
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_NORMAL);
+  if (retval < 0) { return 1; }
+
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  err = N_VMaxNorm(y);
+
+  retval = ARKodeGetNumSteps(arkode_mem, &nst);
+  if (retval) { return 1; }
+
+  retval = RosWStepGetNumRhsEvals(arkode_mem, &nfe);
+  if (retval) { return 1; }
+
+  retval = RosWStepGetNumLinSolves(arkode_mem, &nlinsolves);
+  if (retval) { return 1; }
+
+  retval = ARKodeGetNumLinSolvSetups(arkode_mem, &nsetups);
+  if (retval) { return 1; }
+
+  retval = ARKodeGetNumJacEvals(arkode_mem, &nje);
+  if (retval) { return 1; }
+
+  printf("%s (adaptive): error %.2e, steps %li, fevals %li, LS setups %li, "
+         "LS solves %li, Jac evals %li\n",
+         name, (double)err, nst, nfe, nsetups, nlinsolves, nje);
+
+  if (err > SUN_RCONST(1.0e-4)) { fails++; }
+  if (nje >= nst) { fails++; }
+
+  ARKodeFree(&arkode_mem);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  N_VDestroy(y);
+
+  return fails;
+}
+
+/* Main program */
+int main(int argc, char* argv[])
+{
+  int retval        = 0;
+  int fails         = 0;
+  N_Vector yref     = NULL;
+  SUNContext sunctx = NULL;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  /* reference solution */
+  yref = N_VNew_Serial(2, sunctx);
+  if (!yref) { return 1; }
+  if (fixed_solve(ARKODE_ROSW_ROS34PW2, SUN_RCONST(0.0125) / SUN_RCONST(64.0),
+                  1, -1, yref, NULL, NULL, sunctx))
+  {
+    return 1;
+  }
+
+  fails += test_order(ARKODE_ROSW_ROS2, "ROS2", 2, SUNFALSE, yref, sunctx);
+  fails += test_order(ARKODE_ROSW_ROS2, "ROS2", 2, SUNTRUE, yref, sunctx);
+  fails += test_order(ARKODE_ROSW_ROS34PW2, "ROS34PW2", 3, SUNFALSE, yref,
+                      sunctx);
+  fails += test_order(ARKODE_ROSW_ROS34PW2, "ROS34PW2", 3, SUNTRUE, yref,
+                      sunctx);
+  fails += test_reuse(yref, sunctx);
+  fails += test_adaptive(ARKODE_ROSW_ROS2, "ROS2", yref, sunctx);
+  fails += test_adaptive(ARKODE_ROSW_ROS34PW2, "ROS34PW2", yref, sunctx);
+
+  N_VDestroy(yref);
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %i failures\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+
+  return 0;
+}
@@ -0,0 +1,560 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the SplittingStep module. The test integrates the linear
+ * problem y' = A y + B y with non-commuting matrices
+ *
+ *   A = [ -1    0.5 ]    B = [ -0.3   0  ]
+ *       [  0   -0.5 ]        [  0.7  -1  ]
+ *
+ * with ARKStep integrators evolving the two partitions, and checks that
+ *
+ *   1. the splitting methods converge with their order (including methods
+ *      with negative substeps and the parallel splittings evolved
+ *      concurrently with separate method steppers),
+ *   2. the number of partition evolves matches the splitting stages,
+ *   3. evolving the parallel splittings concurrently with two threads gives
+ *      the same solution and partition evolves as a serial run,
+ *   4. an implicit partition stepper that continues from the end of its
+ *      previous substep reuses its linear solver setup across substeps, and
+ *   5. invalid inputs are rejected.
+ * ---------------------------------------------------------------------------*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "arkode/arkode_arkstep.h"
+#include "arkode/arkode_splittingstep.h"
+#include "nvector/nvector_serial.h"
+#include "sundials/sundials_math.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define HALF SUN_RCONST(0.5)
+#define ONE  SUN_RCONST(1.0)
+
+#define NEQ 2
+#define TF  SUN_RCONST(1.0)
+
+/* Partition right-hand side functions */
+static int fA(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = -yd[0] + HALF * yd[1];
+  fd[1] = -HALF * yd[1];
+
+  return 0;
+}
+
+static int fB(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = -SUN_RCONST(0.3) * yd[0];
+  fd[1] = SUN_RCONST(0.7) * yd[0] - yd[1];
+
+  return 0;
+}
+
+/* Full right-hand side function */
+static int fn(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = -SUN_RCONST(1.3) * yd[0] + HALF * yd[1];
+  fd[1] = SUN_RCONST(0.7) * yd[0] - SUN_RCONST(1.5) * yd[1];
+
+  return 0;
+}
+
+static void set_initial_condition(N_Vector y)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  yd[0]           = ONE;
+  yd[1]           = HALF;
+}
+
+/* Creates an ARKStep integrator for a partition and its inner stepper */
+static void* create_partition(ARKRhsFn f, N_Vector y, SUNContext sunctx,
+                              MRIStepInnerStepper* stepper)
+{
+  void* arkode_mem = ARKStepCreate(f, NULL, ZERO, y, sunctx);
+  if (!arkode_mem) { return NULL; }
+  if (ARKodeSStolerances(arkode_mem, SUN_RCONST(1.0e-13), SUN_RCONST(1.0e-15)))
+  {
+    return NULL;
+  }
+  if (ARKodeSetMaxNumSteps(arkode_mem, 100000)) { return NULL; }
+  if (ARKStepCreateMRIStepInnerStepper(arkode_mem, stepper)) { return NULL; }
+  return arkode_mem;
+}
+
+/* Solves to TF with step size H and returns the max error in *err, the
+   partition evolves in evolves (if not NULL), and the solution in yout (if not
+   NULL). With nthreads > 0, the second sequential method is given separate
+   partition steppers and nthreads threads are used. */
+static int solve(SplittingStepCoefficients coefficients, sunrealtype H,
+                 int nthreads, N_Vector yref, sunrealtype* err,
+                 long int* evolves, N_Vector yout, SUNContext sunctx)
+{
+  int retval = 0;
+  int k;
+  void* arkode_mem = NULL;
+  void* inner_mem[4]       = {NULL, NULL, NULL, NULL};
+  MRIStepInnerStepper s[4] = {NULL, NULL, NULL, NULL};
+  N_Vector y               = NULL;
+  sunrealtype tret;
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  if (!y) { return 1; }
+  set_initial_condition(y);
+
+  inner_mem[0] = create_partition(fA, y, sunctx, &s[0]);
+  inner_mem[1] = create_partition(fB, y, sunctx, &s[1]);
+  if (!inner_mem[0] || !inner_mem[1]) { return 1; }
+
+  arkode_mem = SplittingStepCreate(s, 2, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  retval = SplittingStepSetCoefficients(arkode_mem, coefficients);
+  if (retval) { return 1; }
+
+  if (nthreads > 0)
+  {
+    inner_mem[2] = create_partition(fA, y, sunctx, &s[2]);
+    inner_mem[3] = create_partition(fB, y, sunctx, &s[3]);
+    if (!inner_mem[2] || !inner_mem[3]) { return 1; }
+    retval = SplittingStepSetMethodSteppers(arkode_mem, 1, &s[2]);
+    if (retval) { return 1; }
+    retval = SplittingStepSetNumThreads(arkode_mem, nthreads);
+    if (retval) { return 1; }
+  }
+
+  retval = ARKodeSetFixedStep(arkode_mem, H);
+  if (retval) { return 1; }
+  retval = ARKodeSetMaxNumSteps(arkode_mem, 100000);
+  if (retval) { return 1; }
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+
+  retval = ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_NORMAL);
+  if (retval < 0)
+  {
+    printf("ARKodeEvolve returned %i\n", retval);
+    return 1;
+  }
+
+  if (yout) { N_VScale(ONE, y, yout); }
+
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  *err = N_VMaxNorm(y);
+
+  if (evolves)
+  {
+    for (k = 0; k < 2; k++)
+    {
+      retval = SplittingStepGetNumEvolves(arkode_mem, k, &evolves[k]);
+      if (retval) { return 1; }
+    }
+  }
+
+  ARKodeFree(&arkode_mem);
+  for (k = 0; k < 4; k++)
+  {
+    if (inner_mem[k])
+    {
+      MRIStepInnerStepper_Free(&s[k]);
+      ARKodeFree(&inner_mem[k]);
+    }
+  }
+  N_VDestroy(y);
+
+  return 0;
+}
+
+/* Checks the convergence order of a splitting method */
+static int check_order(const char* name, SplittingStepCoefficients coefficients,
+                       sunrealtype H, int nthreads, N_Vector yref,
+                       SUNContext sunctx)
+{
+  sunrealtype err1, err2, order;
+
+  if (!coefficients)
+  {
+    printf("FAIL: %s coefficients could not be created\n", name);
+    return 1;
+  }
+
+  if (solve(coefficients, H, nthreads, yref, &err1, NULL, NULL, sunctx) ||
+      solve(coefficients, HALF * H, nthreads, yref, &err2, NULL, NULL, sunctx))
+  {
+    printf("FAIL: %s solve failed\n", name);
+    SplittingStepCoefficients_Free(coefficients);
+    return 1;
+  }
+
+  order = (sunrealtype)(log((double)(err1 / err2)) / log(2.0));
+  printf("%-34s errors = %.3e, %.3e, order = %.2f\n", name, (double)err1,
+         (double)err2, (double)order);
+
+  if (order < coefficients->order - SUN_RCONST(0.3))
+  {
+    printf("FAIL: %s order %.2f is below %i\n", name, (double)order,
+           coefficients->order);
+    SplittingStepCoefficients_Free(coefficients);
+    return 1;
+  }
+
+  SplittingStepCoefficients_Free(coefficients);
+  return 0;
+}
+
+static int test_order(N_Vector yref, SUNContext sunctx)
+{
+  int fails = 0;
+  int id;
+
+  for (id = ARKODE_MIN_SPLITTING_NUM; id <= ARKODE_MAX_SPLITTING_NUM; id++)
+  {
+    fails += check_order(SplittingStepCoefficients_IDToName(
+                           (ARKODE_SplittingCoefficientsID)id),
+                         SplittingStepCoefficients_LoadCoefficients(
+                           (ARKODE_SplittingCoefficientsID)id),
+                         SUN_RCONST(0.25), 0, yref, sunctx);
+  }
+
+  fails += check_order("SuzukiFractal(2, 4)",
+                       SplittingStepCoefficients_SuzukiFractal(2, 4),
+                       SUN_RCONST(0.25), 0, yref, sunctx);
+  fails += check_order("Parallel(2)", SplittingStepCoefficients_Parallel(2),
+                       SUN_RCONST(0.1), 0, yref, sunctx);
+  fails += check_order("SymmetricParallel(2)",
+                       SplittingStepCoefficients_SymmetricParallel(2),
+                       SUN_RCONST(0.1), 2, yref, sunctx);
+
+  return fails;
+}
+
+/* Checks the partition evolves of the Lie-Trotter and Strang splittings */
+static int test_evolves(N_Vector yref, SUNContext sunctx)
+{
+  SplittingStepCoefficients coefficients;
+  sunrealtype err;
+  long int evolves[2];
+  int fails = 0;
+
+  coefficients = SplittingStepCoefficients_LieTrotter(2);
+  if (solve(coefficients, SUN_RCONST(0.1), 0, yref, &err, evolves, NULL,
+            sunctx) ||
+      evolves[0] != 10 || evolves[1] != 10)
+  {
+    printf("FAIL: Lie-Trotter evolves = %li, %li (expected 10, 10)\n",
+           evolves[0], evolves[1]);
+    fails++;
+  }
+  SplittingStepCoefficients_Free(coefficients);
+
+  /* the Strang splitting evolves the first partition twice per step */
+  coefficients = SplittingStepCoefficients_Strang(2);
+  if (solve(coefficients, SUN_RCONST(0.1), 0, yref, &err, evolves, NULL,
+            sunctx) ||
+      evolves[0] != 20 || evolves[1] != 10)
+  {
+    printf("FAIL: Strang evolves = %li, %li (expected 20, 10)\n", evolves[0],
+           evolves[1]);
+    fails++;
+  }
+  SplittingStepCoefficients_Free(coefficients);
+
+  if (!fails) { printf("PASS: partition evolves\n"); }
+  return fails;
+}
+
+/* Checks that the concurrent parallel splitting matches a serial run */
+static int test_threads(N_Vector yref, SUNContext sunctx)
+{
+  SplittingStepCoefficients coefficients;
+  N_Vector y1 = NULL;
+  N_Vector y2 = NULL;
+  sunrealtype err1, err2;
+  long int evolves1[2], evolves2[2];
+  int fails = 0;
+
+  y1 = N_VClone(yref);
+  y2 = N_VClone(yref);
+  if (!y1 || !y2) { return 1; }
+
+  coefficients = SplittingStepCoefficients_SymmetricParallel(2);
+  if (!coefficients) { return 1; }
+
+  if (solve(coefficients, SUN_RCONST(0.1), 1, yref, &err1, evolves1, y1,
+            sunctx) ||
+      solve(coefficients, SUN_RCONST(0.1), 2, yref, &err2, evolves2, y2,
+            sunctx))
+  {
+    printf("FAIL: threaded solve failed\n");
+    fails++;
+  }
+  else if (N_VGetArrayPointer(y1)[0] != N_VGetArrayPointer(y2)[0] ||
+           N_VGetArrayPointer(y1)[1] != N_VGetArrayPointer(y2)[1] ||
+           evolves1[0] != evolves2[0] || evolves1[1] != evolves2[1])
+  {
+    printf("FAIL: 2 threads give error %.3e and evolves %li, %li, 1 thread "
+           "gives error %.3e and evolves %li, %li\n",
+           (double)err2, evolves2[0], evolves2[1], (double)err1, evolves1[0],
+           evolves1[1]);
+    fails++;
+  }
+  SplittingStepCoefficients_Free(coefficients);
+
+  N_VDestroy(y1);
+  N_VDestroy(y2);
+
+  if (!fails) { printf("PASS: threaded parallel splitting\n"); }
+  return fails;
+}
+
+/* Checks that an implicit partition stepper is not reset between the substeps
+   of a Lie-Trotter splitting, where each substep starts at the end of the
+   previous one, so that it does not repeat its linear solver setup */
+static int test_carry_state(N_Vector yref, SUNContext sunctx)
+{
+  SplittingStepCoefficients coefficients = NULL;
+  void* arkode_mem                       = NULL;
+  void* inner_mem[2]                     = {NULL, NULL};
+  MRIStepInnerStepper s[2]               = {NULL, NULL};
+  SUNMatrix A                            = NULL;
+  SUNLinearSolver LS                     = NULL;
+  N_Vector y                             = NULL;
+  sunrealtype tret, err, err_explicit;
+  long int evolves, nsetups;
+  int k, fails = 0;
+
+  /* reference error with explicit partition steppers */
+  coefficients = SplittingStepCoefficients_LieTrotter(2);
+  if (!coefficients) { return 1; }
+  if (solve(coefficients, SUN_RCONST(0.1), 0, yref, &err_explicit, NULL, NULL,
+            sunctx))
+  {
+    SplittingStepCoefficients_Free(coefficients);
+    return 1;
+  }
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  if (!y)
+  {
+    fails++;
+    goto cleanup;
+  }
+  set_initial_condition(y);
+
+  /* the first partition is evolved with a DIRK method with a fixed step, so
+     that only the substep starts could force linear solver setups */
+  inner_mem[0] = ARKStepCreate(NULL, fA, ZERO, y, sunctx);
+  A            = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  LS           = SUNLinSol_Dense(y, A, sunctx);
+  if (!inner_mem[0] || !A || !LS ||
+      ARKodeSStolerances(inner_mem[0], SUN_RCONST(1.0e-13),
+                         SUN_RCONST(1.0e-15)) ||
+      ARKodeSetLinearSolver(inner_mem[0], LS, A) ||
+      ARKodeSetFixedStep(inner_mem[0], SUN_RCONST(0.01)) ||
+      ARKStepCreateMRIStepInnerStepper(inner_mem[0], &s[0]))
+  {
+    fails++;
+    goto cleanup;
+  }
+  inner_mem[1] = create_partition(fB, y, sunctx, &s[1]);
+  if (!inner_mem[1])
+  {
+    fails++;
+    goto cleanup;
+  }
+
+  arkode_mem = SplittingStepCreate(s, 2, ZERO, y, sunctx);
+  if (!arkode_mem || SplittingStepSetCoefficients(arkode_mem, coefficients) ||
+      ARKodeSetFixedStep(arkode_mem, SUN_RCONST(0.1)) ||
+      ARKodeSetStopTime(arkode_mem, TF) ||
+      ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_NORMAL) < 0 ||
+      SplittingStepGetNumEvolves(arkode_mem, 0, &evolves) ||
+      ARKodeGetNumLinSolvSetups(inner_mem[0], &nsetups))
+  {
+    fails++;
+    goto cleanup;
+  }
+
+  N_VLinearSum(ONE, y, -ONE, yref, y);
+  err = N_VMaxNorm(y);
+
+  /* a reset before every substep would force a setup in each evolve */
+  if (nsetups >= evolves)
+  {
+    printf("FAIL: %li linear solver setups in %li evolves\n", nsetups, evolves);
+    fails++;
+  }
+  if (SUNRabs(err - err_explicit) > SUN_RCONST(1.0e-6))
+  {
+    printf("FAIL: implicit partition error %.3e, explicit error %.3e\n",
+           (double)err, (double)err_explicit);
+    fails++;
+  }
+
+  if (!fails) { printf("PASS: implicit partition state carried forward\n"); }
+
+cleanup:
+  ARKodeFree(&arkode_mem);
+  for (k = 0; k < 2; k++)
+  {
+    if (s[k]) { MRIStepInnerStepper_Free(&s[k]); }
+    if (inner_mem[k]) { ARKodeFree(&inner_mem[k]); }
+  }
+  if (LS) { SUNLinSolFree(LS); }
+  if (A) { SUNMatDestroy(A); }
+  if (y) { N_VDestroy(y); }
+  SplittingStepCoefficients_Free(coefficients);
+
+  return fails;
+}
+
+static int test_invalid_inputs(N_Vector yref, SUNContext sunctx)
+{
+  int fails        = 0;
+  void* arkode_mem = NULL;
+  void* inner_mem  = NULL;
+  MRIStepInnerStepper s[2];
+  SplittingStepCoefficients coefficients;
+  N_Vector y = NULL;
+  long int evolves;
+  sunrealtype tret;
+
+  y = N_VClone(yref);
+  if (!y) { return 1; }
+  set_initial_condition(y);
+
+  /* NULL steppers */
+  if (SplittingStepCreate(NULL, 2, ZERO, y, sunctx) != NULL)
+  {
+    printf("FAIL: NULL steppers accepted\n");
+    fails++;
+  }
+
+  inner_mem = create_partition(fA, y, sunctx, &s[0]);
+  if (!inner_mem) { return 1; }
+  s[1] = s[0];
+
+  arkode_mem = SplittingStepCreate(s, 2, ZERO, y, sunctx);
+  if (!arkode_mem) { return 1; }
+
+  /* coefficients with the wrong number of partitions */
+  coefficients = SplittingStepCoefficients_Strang(3);
+  if (SplittingStepSetCoefficients(arkode_mem, coefficients) != ARK_ILL_INPUT)
+  {
+    printf("FAIL: coefficients with 3 partitions accepted\n");
+    fails++;
+  }
+  SplittingStepCoefficients_Free(coefficients);
+
+  /* invalid partition index */
+  if (SplittingStepGetNumEvolves(arkode_mem, 2, &evolves) != ARK_ILL_INPUT)
+  {
+    printf("FAIL: invalid partition index accepted\n");
+    fails++;
+  }
+
+  /* adaptive steps are not supported */
+  if (ARKodeEvolve(arkode_mem, TF, y, &tret, ARK_NORMAL) != ARK_ILL_INPUT)
+  {
+    printf("FAIL: evolve without a fixed step size succeeded\n");
+    fails++;
+  }
+
+  /* odd composition orders are not supported */
+  if (SplittingStepCoefficients_TripleJump(2, 3) != NULL)
+  {
+    printf("FAIL: triple jump of odd order created\n");
+    fails++;
+  }
+
+  /* coefficients by name */
+  coefficients =
+    SplittingStepCoefficients_LoadCoefficientsByName("ARKODE_SPLITTING_"
+                                                     "STRANG_2_2_2");
+  if (!coefficients || coefficients->order != 2 || coefficients->stages != 2)
+  {
+    printf("FAIL: coefficients by name\n");
+    fails++;
+  }
+  SplittingStepCoefficients_Free(coefficients);
+
+  ARKodeFree(&arkode_mem);
+  MRIStepInnerStepper_Free(&s[0]);
+  ARKodeFree(&inner_mem);
+  N_VDestroy(y);
+
+  if (!fails) { printf("PASS: invalid inputs\n"); }
+  return fails;
+}
+
+int main(int argc, char* argv[])
+{
+  int retval        = 0;
+  int fails         = 0;
+  void* arkode_mem  = NULL;
+  N_Vector yref     = NULL;
+  SUNContext sunctx = NULL;
+  sunrealtype tret;
+
+  /* Create the SUNDIALS context object for this simulation. */
+  retval = SUNContext_Create(SUN_COMM_NULL, &sunctx);
+  if (retval)
+  {
+    fprintf(stderr, "SUNContext_Create returned %i\n", retval);
+    return 1;
+  }
+
+  /* reference solution */
+  yref = N_VNew_Serial(NEQ, sunctx);
+  if (!yref) { return 1; }
+  set_initial_condition(yref);
+  arkode_mem = ARKStepCreate(fn, NULL, ZERO, yref, sunctx);
+  if (!arkode_mem) { return 1; }
+  retval = ARKodeSetOrder(arkode_mem, 5);
+  if (retval) { return 1; }
+  retval = ARKodeSStolerances(arkode_mem, SUN_RCONST(1.0e-14),
+                              SUN_RCONST(1.0e-16));
+  if (retval) { return 1; }
+  retval = ARKodeSetMaxNumSteps(arkode_mem, 1000000);
+  if (retval) { return 1; }
+  retval = ARKodeSetStopTime(arkode_mem, TF);
+  if (retval) { return 1; }
+  retval = ARKodeEvolve(arkode_mem, TF, yref, &tret, ARK_NORMAL);
+  if (retval < 0) { return 1; }
+  ARKodeFree(&arkode_mem);
+
+  fails += test_order(yref, sunctx);
+  fails += test_evolves(yref, sunctx);
+  fails += test_threads(yref, sunctx);
+  fails += test_carry_state(yref, sunctx);
+  fails += test_invalid_inputs(yref, sunctx);
+
+  N_VDestroy(yref);
+  SUNContext_Free(&sunctx);
+
+  if (fails) { printf("FAIL: %i tests failed\n", fails); }
+  else { printf("SUCCESS: all tests passed\n"); }
+
+  return fails;
+}
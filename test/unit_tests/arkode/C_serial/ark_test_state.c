@@ -0,0 +1,304 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for ARKodeWriteState and ARKodeReadState. The Robertson problem is
+ * integrated with a DIRK method to t1, the state is written, read into a new
+ * ARKStep memory, and the integration is continued to t2.
+ *
+ * Reading a state resets the stepper, which discards the step size controller
+ * and predictor history that are not part of the state. This test uses a
+ * controller and predictor without history and sets up the linear solver with
+ * a fresh Jacobian every step, so the restarted run must match an
+ * uninterrupted run bit-for-bit. The comparison writes the state of both runs
+ * at t2 and compares the streams, which covers the solution, step size data,
+ * and counters. Reading a truncated stream or a stream for a different
+ * problem size must fail.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arkode/arkode_arkstep.h"
+#include "nvector/nvector_serial.h"
+#include "sunadaptcontroller/sunadaptcontroller_soderlind.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#else
+#define GSYM "g"
+#endif
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* ARKODE memory together with the objects attached to it */
+typedef struct
+{
+  void* arkode_mem;
+  N_Vector y;
+  SUNMatrix A;
+  SUNLinearSolver LS;
+  SUNAdaptController C;
+} Integrator;
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+  sunindextype i, n = N_VGetLength(y) / 3;
+
+  /* n uncoupled copies of the Robertson problem */
+  for (i = 0; i < n; i++)
+  {
+    fd[3 * i]     = SUN_RCONST(-0.04) * yd[3 * i] +
+                SUN_RCONST(1.0e4) * yd[3 * i + 1] * yd[3 * i + 2];
+    fd[3 * i + 2] = SUN_RCONST(3.0e7) * yd[3 * i + 1] * yd[3 * i + 1];
+    fd[3 * i + 1] = -fd[3 * i] - fd[3 * i + 2];
+  }
+
+  return 0;
+}
+
+static int create(SUNContext sunctx, sunindextype n, Integrator* I)
+{
+  sunindextype i;
+
+  I->y = N_VNew_Serial(3 * n, sunctx);
+  if (!I->y) { return 1; }
+  N_VConst(ZERO, I->y);
+  for (i = 0; i < n; i++) { NV_Ith_S(I->y, 3 * i) = ONE; }
+
+  I->arkode_mem = ARKStepCreate(NULL, f, ZERO, I->y, sunctx);
+  if (!I->arkode_mem) { return 1; }
+
+  if (ARKodeSStolerances(I->arkode_mem, SUN_RCONST(1.0e-6), SUN_RCONST(1.0e-10)))
+  {
+    return 1;
+  }
+
+  I->A = SUNDenseMatrix(3 * n, 3 * n, sunctx);
+  if (!I->A) { return 1; }
+
+  I->LS = SUNLinSol_Dense(I->y, I->A, sunctx);
+  if (!I->LS) { return 1; }
+
+  if (ARKodeSetLinearSolver(I->arkode_mem, I->LS, I->A)) { return 1; }
+
+  /* No history in the controller or predictor and a fresh Jacobian at every
+     step */
+  I->C = SUNAdaptController_I(sunctx);
+  if (!I->C) { return 1; }
+  if (ARKodeSetAdaptController(I->arkode_mem, I->C)) { return 1; }
+  if (ARKodeSetPredictorMethod(I->arkode_mem, 0)) { return 1; }
+  if (ARKodeSetLSetupFrequency(I->arkode_mem, 1)) { return 1; }
+  if (ARKodeSetJacEvalFrequency(I->arkode_mem, 1)) { return 1; }
+  if (ARKodeSetMaxNumSteps(I->arkode_mem, 10000)) { return 1; }
+
+  return 0;
+}
+
+static void destroy(Integrator* I)
+{
+  ARKodeFree(&I->arkode_mem);
+  SUNAdaptController_Destroy(I->C);
+  SUNLinSolFree(I->LS);
+  SUNMatDestroy(I->A);
+  N_VDestroy(I->y);
+}
+
+/* Read the whole stream into a buffer and return its length */
+static long stream_bytes(FILE* fp, char** buf)
+{
+  long len;
+
+  fseek(fp, 0, SEEK_END);
+  len = ftell(fp);
+  rewind(fp);
+
+  *buf = (char*)malloc(len > 0 ? len : 1);
+  if (fread(*buf, 1, len, fp) != (size_t)len) { len = -1; }
+
+  return len;
+}
+
+/* Compare the states written by two integrators */
+static int compare_states(void* mem1, void* mem2)
+{
+  FILE *fp1 = tmpfile(), *fp2 = tmpfile();
+  char *b1 = NULL, *b2 = NULL;
+  long n1, n2, k;
+  int fails = 0;
+
+  if (!fp1 || !fp2) { return 1; }
+
+  if (ARKodeWriteState(mem1, fp1) || ARKodeWriteState(mem2, fp2)) { return 1; }
+
+  n1 = stream_bytes(fp1, &b1);
+  n2 = stream_bytes(fp2, &b2);
+
+  if (n1 <= 0 || n1 != n2)
+  {
+    fprintf(stderr, "ERROR: state lengths differ: %ld vs %ld\n", n1, n2);
+    fails++;
+  }
+  else
+  {
+    for (k = 0; k < n1; k++)
+    {
+      if (b1[k] != b2[k])
+      {
+        fprintf(stderr, "ERROR: states differ at byte %ld of %ld\n", k, n1);
+        fails++;
+        break;
+      }
+    }
+  }
+
+  free(b1);
+  free(b2);
+  fclose(fp1);
+  fclose(fp2);
+
+  return fails;
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  Integrator ref, rst, bad;
+  FILE *fp = NULL, *fpt = NULL;
+  char* buf    = NULL;
+  sunrealtype t1 = SUN_RCONST(0.4), t2 = SUN_RCONST(4.0e3), tret;
+  long int nst1, nst2, netf1, netf2;
+  sunrealtype h1, h2;
+  long len;
+  int flag;
+  int fails = 0;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  /* ------------------------------------------------
+   * Uninterrupted run, writing the state at t1
+   * ------------------------------------------------ */
+
+  fp = tmpfile();
+  if (!fp) { return 1; }
+
+  if (create(sunctx, 1, &ref)) { return 1; }
+
+  if (ARKodeEvolve(ref.arkode_mem, t1, ref.y, &tret, ARK_NORMAL) < 0)
+  {
+    return 1;
+  }
+
+  if (ARKodeWriteState(ref.arkode_mem, fp)) { return 1; }
+
+  if (ARKodeEvolve(ref.arkode_mem, t2, ref.y, &tret, ARK_NORMAL) < 0)
+  {
+    return 1;
+  }
+
+  /* ------------------------------------------------
+   * Restarted run from the state at t1
+   * ------------------------------------------------ */
+
+  if (create(sunctx, 1, &rst)) { return 1; }
+
+  rewind(fp);
+  if (ARKodeReadState(rst.arkode_mem, fp)) { return 1; }
+
+  if (ARKodeEvolve(rst.arkode_mem, t2, rst.y, &tret, ARK_NORMAL) < 0)
+  {
+    return 1;
+  }
+
+  ARKodeGetNumSteps(ref.arkode_mem, &nst1);
+  ARKodeGetNumSteps(rst.arkode_mem, &nst2);
+  ARKodeGetNumErrTestFails(ref.arkode_mem, &netf1);
+  ARKodeGetNumErrTestFails(rst.arkode_mem, &netf2);
+  ARKodeGetLastStep(ref.arkode_mem, &h1);
+  ARKodeGetLastStep(rst.arkode_mem, &h2);
+
+  printf("uninterrupted: nst = %ld, netf = %ld, h = %" GSYM "\n", nst1, netf1,
+         h1);
+  printf("restarted:     nst = %ld, netf = %ld, h = %" GSYM "\n", nst2, netf2,
+         h2);
+
+  if (nst1 != nst2 || netf1 != netf2 || h1 != h2)
+  {
+    fprintf(stderr, "ERROR: restarted run statistics differ\n");
+    fails++;
+  }
+
+  if (memcmp(N_VGetArrayPointer(ref.y), N_VGetArrayPointer(rst.y),
+             3 * sizeof(sunrealtype)))
+  {
+    fprintf(stderr, "ERROR: restarted run solution differs\n");
+    fails++;
+  }
+
+  fails += compare_states(ref.arkode_mem, rst.arkode_mem);
+
+  destroy(&rst);
+
+  /* ------------------------------------------------
+   * A truncated stream is rejected
+   * ------------------------------------------------ */
+
+  len = stream_bytes(fp, &buf);
+  if (len <= 0) { return 1; }
+
+  fpt = tmpfile();
+  if (!fpt) { return 1; }
+  fwrite(buf, 1, len / 2, fpt);
+  rewind(fpt);
+
+  if (create(sunctx, 1, &bad)) { return 1; }
+  flag = ARKodeReadState(bad.arkode_mem, fpt);
+  if (flag != ARK_ILL_INPUT)
+  {
+    fprintf(stderr, "ERROR: truncated stream returned %d\n", flag);
+    fails++;
+  }
+  destroy(&bad);
+  fclose(fpt);
+  free(buf);
+
+  /* ------------------------------------------------
+   * A stream for a different problem size is rejected
+   * ------------------------------------------------ */
+
+  rewind(fp);
+  if (create(sunctx, 2, &bad)) { return 1; }
+  flag = ARKodeReadState(bad.arkode_mem, fp);
+  if (flag != ARK_ILL_INPUT)
+  {
+    fprintf(stderr, "ERROR: problem size mismatch returned %d\n", flag);
+    fails++;
+  }
+  destroy(&bad);
+
+  fclose(fp);
+  destroy(&ref);
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d checks failed\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}
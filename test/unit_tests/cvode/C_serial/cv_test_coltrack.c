@@ -0,0 +1,332 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for incremental Jacobian updates enabled with
+ * CVodeSetJacColumnTracking. Uncoupled copies of the Robertson problem running
+ * on different time scales are integrated from t = 0, where the couplings
+ * through the second and third components are zero, with a dense linear
+ * solver and checks that
+ *
+ *   1. with the difference quotient Jacobian and a zero change tolerance every
+ *      column is recomputed, so the run is identical to one without tracking,
+ *   2. with the default change tolerance (1.0) fewer difference quotient RHS
+ *      evaluations are needed and the solution agrees with the run without
+ *      tracking to within the integration tolerances, and
+ *   3. with a Jacobian function that updates only the blocks of the copies
+ *      that changed and reports the number of updated columns with
+ *      CVodeSetNumJacUpdatedColumns, linear solver setups are skipped when no
+ *      column changed (CVodeGetNumLinSetupsSkipped) and the solution agrees
+ *      with the run without tracking.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cvode/cvode.h"
+#include "nvector/nvector_serial.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#else
+#define GSYM "g"
+#endif
+
+#define NCOPY 4
+#define NEQ   (3 * NCOPY)
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+#define RTOL SUN_RCONST(1.0e-6)
+#define ATOL SUN_RCONST(1.0e-10)
+
+/* CVODE memory, whether columns are tracked, and the solution at the last
+   update of each Jacobian block */
+typedef struct
+{
+  void* cvode_mem;
+  sunbooleantype tracking;
+  sunbooleantype first;
+  sunrealtype ylast[NEQ];
+} UserData;
+
+/* Time scale of copy k */
+static sunrealtype scale(int k)
+{
+  sunrealtype s = ONE;
+  int i;
+
+  for (i = 0; i < k; i++) { s *= SUN_RCONST(0.1); }
+
+  return s;
+}
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+  sunrealtype s;
+  int k;
+
+  for (k = 0; k < NCOPY; k++)
+  {
+    s             = scale(k);
+    fd[3 * k]     = s * (SUN_RCONST(-0.04) * yd[3 * k] +
+                     SUN_RCONST(1.0e4) * yd[3 * k + 1] * yd[3 * k + 2]);
+    fd[3 * k + 2] = s * SUN_RCONST(3.0e7) * yd[3 * k + 1] * yd[3 * k + 1];
+    fd[3 * k + 1] = -fd[3 * k] - fd[3 * k + 2];
+  }
+
+  return 0;
+}
+
+/* When tracking, updates only the blocks of copies with a relative change
+   above 1e-2 since their last update and reports the number of updated
+   columns. Otherwise the matrix is zero on input and every block is set. */
+static int jac(sunrealtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+               void* user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3)
+{
+  UserData* udata = (UserData*)user_data;
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype s, dy;
+  sunindextype ncols = 0;
+  sunbooleantype changed;
+  int i, k;
+
+  for (k = 0; k < NCOPY; k++)
+  {
+    changed = udata->first || !udata->tracking;
+    for (i = 3 * k; i < 3 * k + 3; i++)
+    {
+      dy = SUNRabs(yd[i] - udata->ylast[i]);
+      if (dy > SUN_RCONST(1.0e-1) * SUNRabs(yd[i]) + ATOL) { changed = SUNTRUE; }
+    }
+    if (!changed) { continue; }
+
+    s = scale(k);
+    SM_ELEMENT_D(J, 3 * k, 3 * k)     = s * SUN_RCONST(-0.04);
+    SM_ELEMENT_D(J, 3 * k, 3 * k + 1) = s * SUN_RCONST(1.0e4) * yd[3 * k + 2];
+    SM_ELEMENT_D(J, 3 * k, 3 * k + 2) = s * SUN_RCONST(1.0e4) * yd[3 * k + 1];
+    SM_ELEMENT_D(J, 3 * k + 2, 3 * k + 1) = s * SUN_RCONST(6.0e7) *
+                                            yd[3 * k + 1];
+    SM_ELEMENT_D(J, 3 * k + 1, 3 * k) = -SM_ELEMENT_D(J, 3 * k, 3 * k);
+    SM_ELEMENT_D(J, 3 * k + 1, 3 * k + 1) =
+      -SM_ELEMENT_D(J, 3 * k, 3 * k + 1) - SM_ELEMENT_D(J, 3 * k + 2, 3 * k + 1);
+    SM_ELEMENT_D(J, 3 * k + 1, 3 * k + 2) = -SM_ELEMENT_D(J, 3 * k, 3 * k + 2);
+
+    for (i = 3 * k; i < 3 * k + 3; i++) { udata->ylast[i] = yd[i]; }
+    ncols += 3;
+  }
+
+  udata->first = SUNFALSE;
+
+  if (!udata->tracking) { return 0; }
+
+  return CVodeSetNumJacUpdatedColumns(udata->cvode_mem, ncols);
+}
+
+/* Integrate to tout and return the solution and the counters nst, nfe, nje,
+   nfeLS, nsetups, and nlsskip. A negative dytol disables tracking. */
+static int run(SUNContext sunctx, sunbooleantype userjac, sunrealtype dytol,
+               N_Vector yout, long int* counters)
+{
+  N_Vector y         = NULL;
+  SUNMatrix A        = NULL;
+  SUNLinearSolver LS = NULL;
+  UserData udata;
+  sunrealtype tret;
+  int flag, k;
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  if (!y) { return 1; }
+  N_VConst(ZERO, y);
+  for (k = 0; k < NCOPY; k++) { NV_Ith_S(y, 3 * k) = ONE; }
+
+  udata.cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  if (!udata.cvode_mem) { return 1; }
+  udata.tracking = (dytol >= ZERO);
+  udata.first    = SUNTRUE;
+
+  flag = CVodeInit(udata.cvode_mem, f, ZERO, y);
+  if (flag) { return 1; }
+
+  flag = CVodeSetUserData(udata.cvode_mem, &udata);
+  if (flag) { return 1; }
+
+  flag = CVodeSStolerances(udata.cvode_mem, RTOL, ATOL);
+  if (flag) { return 1; }
+
+  /* Long runs of steps with the same step size and order */
+  flag = CVodeSetMaxStep(udata.cvode_mem, SUN_RCONST(10.0));
+  if (flag) { return 1; }
+
+  flag = CVodeSetMaxNumSteps(udata.cvode_mem, 10000);
+  if (flag) { return 1; }
+
+  A = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  if (!A) { return 1; }
+
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  if (!LS) { return 1; }
+
+  flag = CVodeSetLinearSolver(udata.cvode_mem, LS, A);
+  if (flag) { return 1; }
+
+  if (userjac)
+  {
+    flag = CVodeSetJacFn(udata.cvode_mem, jac);
+    if (flag) { return 1; }
+  }
+
+  /* Frequent Jacobian updates, many of which change few columns */
+  flag = CVodeSetJacEvalFrequency(udata.cvode_mem, 5);
+  if (flag) { return 1; }
+
+  if (dytol >= ZERO)
+  {
+    flag = CVodeSetJacColumnTracking(udata.cvode_mem, SUNTRUE, dytol);
+    if (flag) { return 1; }
+  }
+
+  flag = CVode(udata.cvode_mem, SUN_RCONST(4.0e3), y, &tret, CV_NORMAL);
+  if (flag < 0) { return 1; }
+
+  N_VScale(ONE, y, yout);
+
+  flag = CVodeGetNumSteps(udata.cvode_mem, &counters[0]);
+  if (flag) { return 1; }
+  flag = CVodeGetNumRhsEvals(udata.cvode_mem, &counters[1]);
+  if (flag) { return 1; }
+  flag = CVodeGetNumJacEvals(udata.cvode_mem, &counters[2]);
+  if (flag) { return 1; }
+  flag = CVodeGetNumLinRhsEvals(udata.cvode_mem, &counters[3]);
+  if (flag) { return 1; }
+  flag = CVodeGetNumLinSolvSetups(udata.cvode_mem, &counters[4]);
+  if (flag) { return 1; }
+  flag = CVodeGetNumLinSetupsSkipped(udata.cvode_mem, &counters[5]);
+  if (flag) { return 1; }
+
+  N_VDestroy(y);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  CVodeFree(&udata.cvode_mem);
+
+  return 0;
+}
+
+/* Check that two solutions agree to within the integration tolerances */
+static int check_solution(const char* name, N_Vector y, N_Vector yref)
+{
+  sunrealtype err, errmax = ZERO;
+  int i;
+
+  for (i = 0; i < NEQ; i++)
+  {
+    err = SUNRabs(NV_Ith_S(y, i) - NV_Ith_S(yref, i)) /
+          (RTOL * SUNRabs(NV_Ith_S(yref, i)) + ATOL);
+    errmax = SUNMAX(err, errmax);
+  }
+
+  printf("%-18s max weighted difference = %" GSYM "\n", name, errmax);
+
+  if (errmax > SUN_RCONST(100.0))
+  {
+    fprintf(stderr, "ERROR: %s solution differs from the reference\n", name);
+    return 1;
+  }
+
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  N_Vector y[5]     = {NULL, NULL, NULL, NULL, NULL};
+  long int c[5][6];
+  const char* names[5] = {"DQ:", "DQ tracking 0:", "DQ tracking:",
+                          "Jac:", "Jac tracking:"};
+  const char* cnames[6] = {"nst", "nfe", "nje", "nfeLS", "nsetups", "nlsskip"};
+  int fails             = 0;
+  int i, k;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  for (k = 0; k < 5; k++)
+  {
+    y[k] = N_VNew_Serial(NEQ, sunctx);
+    if (!y[k]) { return 1; }
+  }
+
+  if (run(sunctx, SUNFALSE, -ONE, y[0], c[0])) { return 1; }
+  if (run(sunctx, SUNFALSE, ZERO, y[1], c[1])) { return 1; }
+  if (run(sunctx, SUNFALSE, SUN_RCONST(100.0), y[2], c[2])) { return 1; }
+  if (run(sunctx, SUNTRUE, -ONE, y[3], c[3])) { return 1; }
+  if (run(sunctx, SUNTRUE, ZERO, y[4], c[4])) { return 1; }
+
+  for (k = 0; k < 5; k++)
+  {
+    printf("%-18s nst = %ld, nfe = %ld, nje = %ld, nfeLS = %ld, nsetups = "
+           "%ld, nlsskip = %ld\n",
+           names[k], c[k][0], c[k][1], c[k][2], c[k][3], c[k][4], c[k][5]);
+  }
+
+  /* 1. Tracking with a zero tolerance recomputes every column */
+  if (memcmp(N_VGetArrayPointer(y[0]), N_VGetArrayPointer(y[1]),
+             NEQ * sizeof(sunrealtype)))
+  {
+    fprintf(stderr, "ERROR: tracking with dytol = 0 changed the solution\n");
+    fails++;
+  }
+  for (i = 0; i < 5; i++)
+  {
+    if (c[0][i] != c[1][i])
+    {
+      fprintf(stderr, "ERROR: tracking with dytol = 0 changed %s\n", cnames[i]);
+      fails++;
+    }
+  }
+  if (c[0][5] != 0)
+  {
+    fprintf(stderr, "ERROR: setups skipped without tracking\n");
+    fails++;
+  }
+
+  /* 2. Tracking saves DQ RHS evaluations */
+  fails += check_solution("DQ tracking:", y[2], y[0]);
+  if (c[2][3] >= (long int)NEQ * c[2][2])
+  {
+    fprintf(stderr, "ERROR: tracking recomputed every DQ column\n");
+    fails++;
+  }
+
+  /* 3. Jacobian updates reported by the user skip unchanged setups */
+  fails += check_solution("Jac tracking:", y[4], y[3]);
+  if (c[3][5] != 0 || c[4][5] == 0 || c[4][5] > c[4][4])
+  {
+    fprintf(stderr, "ERROR: unexpected number of skipped setups\n");
+    fails++;
+  }
+
+  for (k = 0; k < 5; k++) { N_VDestroy(y[k]); }
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d checks failed\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}
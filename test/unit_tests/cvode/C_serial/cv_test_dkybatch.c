@@ -0,0 +1,277 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for CVodeGetDkyBatch. A harmonic oscillator with a decaying
+ * component is integrated in one step mode with the Adams and BDF methods.
+ * After every step, the derivatives k = 0,...,q at NT times spanning the last
+ * step are computed with CVodeGetDkyBatch and with CVodeGetDky at each time.
+ * The two must be identical for k = 0 and, since the batch function applies
+ * the h^(-k) scaling to the coefficients rather than to the result, agree to
+ * a small multiple of the unit roundoff for k > 0. The test also checks that
+ *
+ *   1. an illegal k returns CV_BAD_K,
+ *   2. an illegal time anywhere in the batch returns CV_BAD_T before any
+ *      output vector is written,
+ *   3. a NULL output vector returns CV_BAD_DKY,
+ *   4. nt < 0 returns CV_ILL_INPUT and nt = 0 succeeds.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "cvode/cvode.h"
+#include "nvector/nvector_serial.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#else
+#define GSYM "g"
+#endif
+
+#define NEQ 3
+#define NT  7
+
+#define ZERO SUN_RCONST(0.0)
+#define HALF SUN_RCONST(0.5)
+#define ONE  SUN_RCONST(1.0)
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  NV_Ith_S(ydot, 0) = NV_Ith_S(y, 1);
+  NV_Ith_S(ydot, 1) = -NV_Ith_S(y, 0);
+  NV_Ith_S(ydot, 2) = -HALF * NV_Ith_S(y, 2);
+  return 0;
+}
+
+/* Compare the batch and single time derivatives after every step and return
+   the number of failed checks */
+static int compare(SUNContext sunctx, int lmm, const char* name)
+{
+  void* cvode_mem    = NULL;
+  N_Vector y         = NULL;
+  N_Vector dky       = NULL;
+  N_Vector bdky[NT]  = {NULL};
+  N_Vector last      = NULL;
+  SUNMatrix A        = NULL;
+  SUNLinearSolver LS = NULL;
+  sunrealtype tb[NT];
+  sunrealtype tf = SUN_RCONST(10.0), tret = ZERO, hu, tol, err, nrm;
+  sunrealtype maxerr = ZERO;
+  long int ncmp      = 0;
+  int q, qmax = 0;
+  int flag, k, m, fails = 0;
+
+  y   = N_VNew_Serial(NEQ, sunctx);
+  dky = N_VClone(y);
+  if (!y || !dky) { return 1; }
+  for (m = 0; m < NT; m++)
+  {
+    bdky[m] = N_VClone(y);
+    if (!bdky[m]) { return 1; }
+  }
+  NV_Ith_S(y, 0) = ZERO;
+  NV_Ith_S(y, 1) = ONE;
+  NV_Ith_S(y, 2) = ONE;
+
+  cvode_mem = CVodeCreate(lmm, sunctx);
+  if (!cvode_mem) { return 1; }
+
+  flag = CVodeInit(cvode_mem, f, ZERO, y);
+  if (flag) { return 1; }
+
+  flag = CVodeSStolerances(cvode_mem, SUN_RCONST(1.0e-8), SUN_RCONST(1.0e-10));
+  if (flag) { return 1; }
+
+  flag = CVodeSetMaxNumSteps(cvode_mem, 10000);
+  if (flag) { return 1; }
+
+  A = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  if (!A) { return 1; }
+
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  if (!LS) { return 1; }
+
+  flag = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (flag) { return 1; }
+
+  flag = CVodeSetStopTime(cvode_mem, tf);
+  if (flag) { return 1; }
+
+  tol = SUN_RCONST(1.0e3) * SUN_UNIT_ROUNDOFF;
+
+  while (tret < tf)
+  {
+    flag = CVode(cvode_mem, tf, y, &tret, CV_ONE_STEP);
+    if (flag < 0) { return 1; }
+
+    flag = CVodeGetLastOrder(cvode_mem, &q);
+    if (flag) { return 1; }
+    flag = CVodeGetLastStep(cvode_mem, &hu);
+    if (flag) { return 1; }
+    if (q > qmax) { qmax = q; }
+
+    /* Times spanning the last step, including both end points */
+    for (m = 0; m < NT; m++)
+    {
+      tb[m] = tret - hu + hu * (sunrealtype)m / (sunrealtype)(NT - 1);
+    }
+    tb[NT - 1] = tret;
+
+    for (k = 0; k <= q; k++)
+    {
+      flag = CVodeGetDkyBatch(cvode_mem, NT, tb, k, bdky);
+      if (flag)
+      {
+        fprintf(stderr, "ERROR: %s CVodeGetDkyBatch k = %d returned %d\n",
+                name, k, flag);
+        return fails + 1;
+      }
+
+      for (m = 0; m < NT; m++)
+      {
+        flag = CVodeGetDky(cvode_mem, tb[m], k, dky);
+        if (flag) { return 1; }
+
+        nrm = N_VMaxNorm(dky);
+        N_VLinearSum(ONE, bdky[m], -ONE, dky, dky);
+        err = N_VMaxNorm(dky);
+        ncmp++;
+
+        if (k == 0 && err != ZERO)
+        {
+          fprintf(stderr,
+                  "ERROR: %s k = 0 at t = %" GSYM " differs by %" GSYM "\n",
+                  name, tb[m], err);
+          fails++;
+        }
+        else if (err > tol * SUNMAX(nrm, ONE))
+        {
+          fprintf(stderr,
+                  "ERROR: %s k = %d at t = %" GSYM " differs by %" GSYM "\n",
+                  name, k, tb[m], err);
+          fails++;
+        }
+        if (nrm > ZERO) { maxerr = SUNMAX(maxerr, err / SUNMAX(nrm, ONE)); }
+      }
+    }
+  }
+
+  printf("%s: %ld comparisons, max order %d, max scaled difference %" GSYM
+         "\n",
+         name, ncmp, qmax, maxerr);
+
+  if (qmax < 3)
+  {
+    fprintf(stderr, "ERROR: %s did not reach order 3\n", name);
+    fails++;
+  }
+
+  /* ------------------------------------------------
+   * Error paths at the final step
+   * ------------------------------------------------ */
+
+  flag = CVodeGetDkyBatch(cvode_mem, NT, tb, q + 1, bdky);
+  if (flag != CV_BAD_K)
+  {
+    fprintf(stderr, "ERROR: %s k = q + 1 returned %d\n", name, flag);
+    fails++;
+  }
+
+  flag = CVodeGetDkyBatch(cvode_mem, NT, tb, -1, bdky);
+  if (flag != CV_BAD_K)
+  {
+    fprintf(stderr, "ERROR: %s k = -1 returned %d\n", name, flag);
+    fails++;
+  }
+
+  /* An illegal last time is caught before the first output is written */
+  N_VConst(SUN_RCONST(-123.0), bdky[0]);
+  tb[NT - 1] = tret + SUN_RCONST(10.0) * hu;
+  flag       = CVodeGetDkyBatch(cvode_mem, NT, tb, 0, bdky);
+  if (flag != CV_BAD_T)
+  {
+    fprintf(stderr, "ERROR: %s illegal t returned %d\n", name, flag);
+    fails++;
+  }
+  if (NV_Ith_S(bdky[0], 0) != SUN_RCONST(-123.0))
+  {
+    fprintf(stderr, "ERROR: %s illegal t batch wrote an output\n", name);
+    fails++;
+  }
+  tb[NT - 1] = tret;
+
+  tb[0] = tret - SUN_RCONST(2.0) * hu;
+  flag  = CVodeGetDkyBatch(cvode_mem, NT, tb, 0, bdky);
+  if (flag != CV_BAD_T)
+  {
+    fprintf(stderr, "ERROR: %s t before the last step returned %d\n", name,
+            flag);
+    fails++;
+  }
+  tb[0] = tret - hu;
+
+  last         = bdky[NT - 1];
+  bdky[NT - 1] = NULL;
+  flag         = CVodeGetDkyBatch(cvode_mem, NT, tb, 0, bdky);
+  if (flag != CV_BAD_DKY)
+  {
+    fprintf(stderr, "ERROR: %s NULL output vector returned %d\n", name, flag);
+    fails++;
+  }
+  bdky[NT - 1] = last;
+
+  flag = CVodeGetDkyBatch(cvode_mem, -1, tb, 0, bdky);
+  if (flag != CV_ILL_INPUT)
+  {
+    fprintf(stderr, "ERROR: %s nt = -1 returned %d\n", name, flag);
+    fails++;
+  }
+
+  flag = CVodeGetDkyBatch(cvode_mem, 0, NULL, 0, NULL);
+  if (flag != CV_SUCCESS)
+  {
+    fprintf(stderr, "ERROR: %s nt = 0 returned %d\n", name, flag);
+    fails++;
+  }
+
+  for (m = 0; m < NT; m++) { N_VDestroy(bdky[m]); }
+  N_VDestroy(dky);
+  N_VDestroy(y);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  CVodeFree(&cvode_mem);
+
+  return fails;
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  int fails         = 0;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  fails += compare(sunctx, CV_ADAMS, "Adams");
+  fails += compare(sunctx, CV_BDF, "BDF");
+
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d checks failed\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}
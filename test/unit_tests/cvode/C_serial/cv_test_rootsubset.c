@@ -0,0 +1,299 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the root subset function set with CVodeSetRootSubsetFn. The
+ * harmonic oscillator y0' = y1, y1' = -y0 with y(0) = (0, 1) is integrated
+ * over two periods with NRT = 200 root functions g_i = y0 - a_i for levels a_i
+ * in (-1, 1), so every root function crosses zero four times in alternating
+ * directions and several roots are often found in the same step. The root
+ * times, root components, and directions returned with and without the subset
+ * function must be identical, and the subset function must evaluate fewer
+ * root function components in total. Setting the subset function before
+ * CVodeRootInit must fail, and calling CVodeRootInit again must remove it.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "cvode/cvode.h"
+#include "nvector/nvector_serial.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#else
+#define GSYM "g"
+#endif
+
+#define NEQ   2
+#define NRT   200
+#define MAXRT (4 * NRT + 16)
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+/* Root levels and the number of root function components evaluated */
+typedef struct
+{
+  sunrealtype a[NRT];
+  long int ncomp;
+} UserData;
+
+/* Roots found: time, component, and direction of each root in order */
+typedef struct
+{
+  int n;
+  sunrealtype t[MAXRT];
+  int comp[MAXRT];
+  int dir[MAXRT];
+} RootLog;
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  NV_Ith_S(ydot, 0) = NV_Ith_S(y, 1);
+  NV_Ith_S(ydot, 1) = -NV_Ith_S(y, 0);
+  return 0;
+}
+
+static int g(sunrealtype t, N_Vector y, sunrealtype* gout, void* user_data)
+{
+  UserData* udata = (UserData*)user_data;
+  int i;
+
+  for (i = 0; i < NRT; i++) { gout[i] = NV_Ith_S(y, 0) - udata->a[i]; }
+  udata->ncomp += NRT;
+
+  return 0;
+}
+
+static int gsub(sunrealtype t, N_Vector y, int nsub, const int* isub,
+                sunrealtype* gout, void* user_data)
+{
+  UserData* udata = (UserData*)user_data;
+  int k;
+
+  for (k = 0; k < nsub; k++)
+  {
+    gout[isub[k]] = NV_Ith_S(y, 0) - udata->a[isub[k]];
+  }
+  udata->ncomp += nsub;
+
+  return 0;
+}
+
+/* Integrate over two periods, logging every root, and return the number of
+   root function components evaluated. mode 0 uses only the full root function,
+   mode 1 also sets the subset function, and mode 2 sets the subset function
+   and then calls CVodeRootInit again. */
+static int run(SUNContext sunctx, int mode, RootLog* log, long int* ncomp)
+{
+  void* cvode_mem    = NULL;
+  N_Vector y         = NULL;
+  SUNMatrix A        = NULL;
+  SUNLinearSolver LS = NULL;
+  UserData udata;
+  int rootsfound[NRT];
+  sunrealtype tf = SUN_RCONST(4.0) * SUN_RCONST(3.141592653589793);
+  sunrealtype tret;
+  int flag, i;
+
+  /* Levels spread over (-1, 1) */
+  for (i = 0; i < NRT; i++)
+  {
+    udata.a[i] = -ONE + TWO * ((sunrealtype)i + SUN_RCONST(0.5)) /
+                          (sunrealtype)NRT;
+  }
+  udata.ncomp = 0;
+  log->n      = 0;
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  if (!y) { return 1; }
+  NV_Ith_S(y, 0) = ZERO;
+  NV_Ith_S(y, 1) = ONE;
+
+  cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  if (!cvode_mem) { return 1; }
+
+  flag = CVodeInit(cvode_mem, f, ZERO, y);
+  if (flag) { return 1; }
+
+  flag = CVodeSetUserData(cvode_mem, &udata);
+  if (flag) { return 1; }
+
+  flag = CVodeSStolerances(cvode_mem, SUN_RCONST(1.0e-8), SUN_RCONST(1.0e-10));
+  if (flag) { return 1; }
+
+  flag = CVodeSetMaxNumSteps(cvode_mem, 10000);
+  if (flag) { return 1; }
+
+  A = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  if (!A) { return 1; }
+
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  if (!LS) { return 1; }
+
+  flag = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (flag) { return 1; }
+
+  /* The subset function requires rootfinding */
+  if (mode == 0)
+  {
+    flag = CVodeSetRootSubsetFn(cvode_mem, gsub);
+    if (flag != CV_ILL_INPUT)
+    {
+      fprintf(stderr, "ERROR: subset function set before CVodeRootInit\n");
+      return 1;
+    }
+  }
+
+  flag = CVodeRootInit(cvode_mem, NRT, g);
+  if (flag) { return 1; }
+
+  if (mode > 0)
+  {
+    flag = CVodeSetRootSubsetFn(cvode_mem, gsub);
+    if (flag) { return 1; }
+  }
+
+  if (mode == 2)
+  {
+    flag = CVodeRootInit(cvode_mem, NRT, g);
+    if (flag) { return 1; }
+  }
+
+  tret = ZERO;
+  while (tret < tf)
+  {
+    flag = CVode(cvode_mem, tf, y, &tret, CV_NORMAL);
+    if (flag < 0) { return 1; }
+
+    if (flag == CV_ROOT_RETURN)
+    {
+      flag = CVodeGetRootInfo(cvode_mem, rootsfound);
+      if (flag) { return 1; }
+
+      for (i = 0; i < NRT; i++)
+      {
+        if (rootsfound[i] == 0) { continue; }
+        if (log->n == MAXRT) { return 1; }
+        log->t[log->n]    = tret;
+        log->comp[log->n] = i;
+        log->dir[log->n]  = rootsfound[i];
+        log->n++;
+      }
+    }
+  }
+
+  *ncomp = udata.ncomp;
+
+  N_VDestroy(y);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  CVodeFree(&cvode_mem);
+
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  RootLog* full     = NULL;
+  RootLog* sub      = NULL;
+  RootLog* reinit   = NULL;
+  long int ncomp_full, ncomp_sub, ncomp_reinit;
+  int fails = 0;
+  int k, nup = 0, ndown = 0;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  full = (RootLog*)malloc(sizeof(RootLog));
+  sub    = (RootLog*)malloc(sizeof(RootLog));
+  reinit = (RootLog*)malloc(sizeof(RootLog));
+  if (!full || !sub || !reinit) { return 1; }
+
+  if (run(sunctx, 0, full, &ncomp_full)) { return 1; }
+  if (run(sunctx, 1, sub, &ncomp_sub)) { return 1; }
+  if (run(sunctx, 2, reinit, &ncomp_reinit)) { return 1; }
+
+  for (k = 0; k < full->n; k++)
+  {
+    if (full->dir[k] > 0) { nup++; }
+    else { ndown++; }
+  }
+
+  printf("full:   %d roots (%d rising, %d falling), %ld components "
+         "evaluated\n",
+         full->n, nup, ndown, ncomp_full);
+  printf("subset: %d roots, %ld components evaluated\n", sub->n, ncomp_sub);
+
+  /* Every level is crossed four times */
+  if (full->n != 4 * NRT || nup != 2 * NRT || ndown != 2 * NRT)
+  {
+    fprintf(stderr, "ERROR: expected %d rising and %d falling roots\n",
+            2 * NRT, 2 * NRT);
+    fails++;
+  }
+
+  /* The subset function finds the same roots in the same order */
+  if (full->n != sub->n)
+  {
+    fprintf(stderr, "ERROR: %d roots with and %d without the subset function\n",
+            sub->n, full->n);
+    fails++;
+  }
+  else
+  {
+    for (k = 0; k < full->n; k++)
+    {
+      if (full->t[k] != sub->t[k] || full->comp[k] != sub->comp[k] ||
+          full->dir[k] != sub->dir[k])
+      {
+        fprintf(stderr,
+                "ERROR: root %d differs: g_%d at t = %.17" GSYM
+                " (dir %d) vs g_%d at t = %.17" GSYM " (dir %d)\n",
+                k, full->comp[k], full->t[k], full->dir[k], sub->comp[k],
+                sub->t[k], sub->dir[k]);
+        fails++;
+        break;
+      }
+    }
+  }
+
+  /* The subset function evaluates fewer components */
+  if (ncomp_sub >= ncomp_full)
+  {
+    fprintf(stderr, "ERROR: the subset function did not save evaluations\n");
+    fails++;
+  }
+
+  /* CVodeRootInit removes the subset function */
+  if (ncomp_reinit != ncomp_full || reinit->n != full->n)
+  {
+    fprintf(stderr, "ERROR: CVodeRootInit did not remove the subset function\n");
+    fails++;
+  }
+
+  free(full);
+  free(sub);
+  free(reinit);
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d checks failed\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}
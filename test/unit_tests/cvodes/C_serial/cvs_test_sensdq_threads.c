@@ -0,0 +1,247 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the threaded difference quotient sensitivity right-hand side
+ * enabled with CVodeSetSensDQThreads. The Robertson problem with three
+ * parameters is integrated with DQ sensitivities using one thread and using
+ * several threads, each with its own copy of the parameters. Since every
+ * sensitivity is computed by the same sequence of operations regardless of
+ * the thread it runs on, the solutions, sensitivities, and counters must be
+ * identical.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cvodes/cvodes.h"
+#include "nvector/nvector_serial.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#else
+#define GSYM "g"
+#endif
+
+#define NEQ 3
+#define NS  3
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* User data is a pointer to the parameter array used by the RHS */
+typedef struct
+{
+  sunrealtype* p;
+} UserData;
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* p  = ((UserData*)user_data)->p;
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+
+  fd[0] = -p[0] * yd[0] + p[1] * yd[1] * yd[2];
+  fd[2] = p[2] * yd[1] * yd[1];
+  fd[1] = -fd[0] - fd[2];
+
+  return 0;
+}
+
+/* Integrate to tout with nthreads threads and return the final solution,
+   sensitivities, and counters */
+static int run(SUNContext sunctx, int nthreads, sunrealtype tout, N_Vector yout,
+               N_Vector* ySout, long int* counters)
+{
+  void* cvode_mem    = NULL;
+  N_Vector y         = NULL;
+  N_Vector* yS       = NULL;
+  SUNMatrix A        = NULL;
+  SUNLinearSolver LS = NULL;
+  sunrealtype p[NS]  = {SUN_RCONST(0.04), SUN_RCONST(1.0e4), SUN_RCONST(3.0e7)};
+  sunrealtype pbar[NS];
+  sunrealtype p_th_data[8][NS];
+  sunrealtype* p_th[8];
+  UserData udata;
+  UserData udata_th[8];
+  void* udata_th_ptr[8];
+  sunrealtype tret;
+  int flag, k, is;
+
+  if (nthreads > 8) { nthreads = 8; }
+
+  y = N_VNew_Serial(NEQ, sunctx);
+  if (!y) { return 1; }
+  N_VConst(ZERO, y);
+  NV_Ith_S(y, 0) = ONE;
+
+  yS = N_VCloneVectorArray(NS, y);
+  if (!yS) { return 1; }
+  for (is = 0; is < NS; is++) { N_VConst(ZERO, yS[is]); }
+
+  cvode_mem = CVodeCreate(CV_BDF, sunctx);
+  if (!cvode_mem) { return 1; }
+
+  udata.p = p;
+  flag    = CVodeSetUserData(cvode_mem, &udata);
+  if (flag) { return 1; }
+
+  flag = CVodeInit(cvode_mem, f, ZERO, y);
+  if (flag) { return 1; }
+
+  flag = CVodeSStolerances(cvode_mem, SUN_RCONST(1.0e-6), SUN_RCONST(1.0e-10));
+  if (flag) { return 1; }
+
+  A = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  if (!A) { return 1; }
+
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  if (!LS) { return 1; }
+
+  flag = CVodeSetLinearSolver(cvode_mem, LS, A);
+  if (flag) { return 1; }
+
+  flag = CVodeSensInit(cvode_mem, NS, CV_SIMULTANEOUS, NULL, yS);
+  if (flag) { return 1; }
+
+  flag = CVodeSensEEtolerances(cvode_mem);
+  if (flag) { return 1; }
+
+  for (is = 0; is < NS; is++) { pbar[is] = p[is]; }
+  flag = CVodeSetSensParams(cvode_mem, p, pbar, NULL);
+  if (flag) { return 1; }
+
+  flag = CVodeSetSensErrCon(cvode_mem, SUNTRUE);
+  if (flag) { return 1; }
+
+  /* Give each thread a private copy of the parameters and user data */
+  for (k = 0; k < nthreads; k++)
+  {
+    memcpy(p_th_data[k], p, NS * sizeof(sunrealtype));
+    p_th[k]         = p_th_data[k];
+    udata_th[k].p   = p_th[k];
+    udata_th_ptr[k] = &udata_th[k];
+  }
+
+  flag = CVodeSetSensDQThreads(cvode_mem, nthreads, p_th, udata_th_ptr);
+  if (flag) { return 1; }
+
+  flag = CVode(cvode_mem, tout, y, &tret, CV_NORMAL);
+  if (flag < 0) { return 1; }
+
+  flag = CVodeGetSens(cvode_mem, &tret, yS);
+  if (flag) { return 1; }
+
+  N_VScale(ONE, y, yout);
+  for (is = 0; is < NS; is++) { N_VScale(ONE, yS[is], ySout[is]); }
+
+  flag = CVodeGetNumSteps(cvode_mem, &counters[0]);
+  if (flag) { return 1; }
+  flag = CVodeGetNumRhsEvals(cvode_mem, &counters[1]);
+  if (flag) { return 1; }
+  flag = CVodeGetSensNumRhsEvals(cvode_mem, &counters[2]);
+  if (flag) { return 1; }
+  flag = CVodeGetNumRhsEvalsSens(cvode_mem, &counters[3]);
+  if (flag) { return 1; }
+  flag = CVodeGetSensNumErrTestFails(cvode_mem, &counters[4]);
+  if (flag) { return 1; }
+
+  /* The user parameters must be unchanged after the integration */
+  if (p[0] != SUN_RCONST(0.04) || p[1] != SUN_RCONST(1.0e4) ||
+      p[2] != SUN_RCONST(3.0e7))
+  {
+    fprintf(stderr, "ERROR: parameters modified by the DQ routines\n");
+    return 1;
+  }
+
+  N_VDestroyVectorArray(yS, NS);
+  N_VDestroy(y);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  CVodeFree(&cvode_mem);
+
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  N_Vector y1 = NULL, y2 = NULL;
+  N_Vector *yS1 = NULL, *yS2 = NULL;
+  long int c1[5], c2[5];
+  const char* cnames[5] = {"nst", "nfe", "nfeS", "nfSe", "netfS"};
+  sunrealtype tout      = SUN_RCONST(40.0);
+  int nthreads          = 4;
+  int fails             = 0;
+  int i, is;
+
+  if (argc > 1) { nthreads = atoi(argv[1]); }
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  y1 = N_VNew_Serial(NEQ, sunctx);
+  y2 = N_VNew_Serial(NEQ, sunctx);
+  if (!y1 || !y2) { return 1; }
+  yS1 = N_VCloneVectorArray(NS, y1);
+  yS2 = N_VCloneVectorArray(NS, y1);
+  if (!yS1 || !yS2) { return 1; }
+
+  if (run(sunctx, 1, tout, y1, yS1, c1)) { return 1; }
+  if (run(sunctx, nthreads, tout, y2, yS2, c2)) { return 1; }
+
+  for (i = 0; i < NEQ; i++)
+  {
+    if (NV_Ith_S(y1, i) != NV_Ith_S(y2, i))
+    {
+      fprintf(stderr, "ERROR: y[%d] differs: %.17" GSYM " vs %.17" GSYM "\n",
+              i, NV_Ith_S(y1, i), NV_Ith_S(y2, i));
+      fails++;
+    }
+    for (is = 0; is < NS; is++)
+    {
+      if (NV_Ith_S(yS1[is], i) != NV_Ith_S(yS2[is], i))
+      {
+        fprintf(stderr,
+                "ERROR: yS[%d][%d] differs: %.17" GSYM " vs %.17" GSYM "\n",
+                is, i, NV_Ith_S(yS1[is], i), NV_Ith_S(yS2[is], i));
+        fails++;
+      }
+    }
+  }
+
+  for (i = 0; i < 5; i++)
+  {
+    if (c1[i] != c2[i])
+    {
+      fprintf(stderr, "ERROR: %s differs: %ld vs %ld\n", cnames[i], c1[i],
+              c2[i]);
+      fails++;
+    }
+  }
+
+  N_VDestroyVectorArray(yS1, NS);
+  N_VDestroyVectorArray(yS2, NS);
+  N_VDestroy(y1);
+  N_VDestroy(y2);
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d differences between 1 and %d threads\n", fails, nthreads);
+    return 1;
+  }
+
+  printf("SUCCESS: nst = %ld, nfeS = %ld with 1 and %d threads\n", c1[0], c1[2],
+         nthreads);
+  return 0;
+}
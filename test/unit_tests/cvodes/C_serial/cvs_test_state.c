@@ -0,0 +1,398 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for CVodeWriteState and CVodeReadState in CVODES. The Robertson
+ * problem with forward sensitivities with respect to its three rate constants
+ * and a quadrature is integrated to t1, the state is written, read into a new
+ * CVODES memory, and the integration is continued to t2. The result is
+ * compared bit-for-bit with an uninterrupted run by writing the state of both
+ * runs at t2 and comparing the streams, which covers the solution,
+ * sensitivity, and quadrature Nordsieck histories, order, step size, and
+ * counters. The linear solver is set up with a fresh Jacobian every step so
+ * that the forced setup after a restart does not change the step sequence.
+ * Reading a truncated stream or a stream from a different method, maximum
+ * order, problem size, or number of sensitivities must fail.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cvodes/cvodes.h"
+#include "nvector/nvector_serial.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#else
+#define GSYM "g"
+#endif
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+#define NP 3
+
+/* CVODES memory together with the objects attached to it */
+typedef struct
+{
+  void* cvode_mem;
+  N_Vector y;
+  N_Vector q;
+  N_Vector* yS;
+  int Ns;
+  SUNMatrix A;
+  SUNLinearSolver LS;
+  sunrealtype p[NP];
+} Integrator;
+
+static int f(sunrealtype t, N_Vector y, N_Vector ydot, void* user_data)
+{
+  sunrealtype* p  = (sunrealtype*)user_data;
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunrealtype* fd = N_VGetArrayPointer(ydot);
+  sunindextype i, n = N_VGetLength(y) / 3;
+
+  /* n uncoupled copies of the Robertson problem */
+  for (i = 0; i < n; i++)
+  {
+    fd[3 * i]     = -p[0] * yd[3 * i] + p[1] * yd[3 * i + 1] * yd[3 * i + 2];
+    fd[3 * i + 2] = p[2] * yd[3 * i + 1] * yd[3 * i + 1];
+    fd[3 * i + 1] = -fd[3 * i] - fd[3 * i + 2];
+  }
+
+  return 0;
+}
+
+/* Integral of the first component */
+static int fQ(sunrealtype t, N_Vector y, N_Vector qdot, void* user_data)
+{
+  N_VGetArrayPointer(qdot)[0] = N_VGetArrayPointer(y)[0];
+  return 0;
+}
+
+static int create(SUNContext sunctx, int lmm, int maxord, sunindextype n,
+                  int Ns, Integrator* I)
+{
+  sunindextype i;
+  int is;
+
+  I->p[0] = SUN_RCONST(0.04);
+  I->p[1] = SUN_RCONST(1.0e4);
+  I->p[2] = SUN_RCONST(3.0e7);
+  I->Ns   = Ns;
+
+  I->y = N_VNew_Serial(3 * n, sunctx);
+  if (!I->y) { return 1; }
+  N_VConst(ZERO, I->y);
+  for (i = 0; i < n; i++) { NV_Ith_S(I->y, 3 * i) = ONE; }
+
+  I->cvode_mem = CVodeCreate(lmm, sunctx);
+  if (!I->cvode_mem) { return 1; }
+
+  if (CVodeInit(I->cvode_mem, f, ZERO, I->y)) { return 1; }
+
+  if (CVodeSetUserData(I->cvode_mem, I->p)) { return 1; }
+
+  if (CVodeSStolerances(I->cvode_mem, SUN_RCONST(1.0e-6), SUN_RCONST(1.0e-10)))
+  {
+    return 1;
+  }
+
+  if (CVodeSetMaxOrd(I->cvode_mem, maxord)) { return 1; }
+
+  I->A = SUNDenseMatrix(3 * n, 3 * n, sunctx);
+  if (!I->A) { return 1; }
+
+  I->LS = SUNLinSol_Dense(I->y, I->A, sunctx);
+  if (!I->LS) { return 1; }
+
+  if (CVodeSetLinearSolver(I->cvode_mem, I->LS, I->A)) { return 1; }
+
+  /* Fresh Jacobian at every step */
+  if (CVodeSetLSetupFrequency(I->cvode_mem, 1)) { return 1; }
+  if (CVodeSetJacEvalFrequency(I->cvode_mem, 1)) { return 1; }
+
+  I->q = N_VNew_Serial(1, sunctx);
+  if (!I->q) { return 1; }
+  N_VConst(ZERO, I->q);
+
+  if (CVodeQuadInit(I->cvode_mem, fQ, I->q)) { return 1; }
+  if (CVodeQuadSStolerances(I->cvode_mem, SUN_RCONST(1.0e-6),
+                            SUN_RCONST(1.0e-10)))
+  {
+    return 1;
+  }
+  if (CVodeSetQuadErrCon(I->cvode_mem, SUNTRUE)) { return 1; }
+
+  I->yS = N_VCloneVectorArray(Ns, I->y);
+  if (!I->yS) { return 1; }
+  for (is = 0; is < Ns; is++) { N_VConst(ZERO, I->yS[is]); }
+
+  if (CVodeSensInit(I->cvode_mem, Ns, CV_SIMULTANEOUS, NULL, I->yS))
+  {
+    return 1;
+  }
+  if (CVodeSensEEtolerances(I->cvode_mem)) { return 1; }
+  if (CVodeSetSensParams(I->cvode_mem, I->p, I->p, NULL)) { return 1; }
+  if (CVodeSetSensErrCon(I->cvode_mem, SUNTRUE)) { return 1; }
+
+  return 0;
+}
+
+static void destroy(Integrator* I)
+{
+  CVodeFree(&I->cvode_mem);
+  N_VDestroyVectorArray(I->yS, I->Ns);
+  N_VDestroy(I->q);
+  SUNLinSolFree(I->LS);
+  SUNMatDestroy(I->A);
+  N_VDestroy(I->y);
+}
+
+/* Read the whole stream into a buffer and return its length */
+static long stream_bytes(FILE* fp, char** buf)
+{
+  long len;
+
+  fseek(fp, 0, SEEK_END);
+  len = ftell(fp);
+  rewind(fp);
+
+  *buf = (char*)malloc(len > 0 ? len : 1);
+  if (fread(*buf, 1, len, fp) != (size_t)len) { len = -1; }
+
+  return len;
+}
+
+/* Compare the states written by two integrators */
+static int compare_states(void* mem1, void* mem2)
+{
+  FILE *fp1 = tmpfile(), *fp2 = tmpfile();
+  char *b1 = NULL, *b2 = NULL;
+  long n1, n2, k;
+  int fails = 0;
+
+  if (!fp1 || !fp2) { return 1; }
+
+  if (CVodeWriteState(mem1, fp1) || CVodeWriteState(mem2, fp2)) { return 1; }
+
+  n1 = stream_bytes(fp1, &b1);
+  n2 = stream_bytes(fp2, &b2);
+
+  if (n1 <= 0 || n1 != n2)
+  {
+    fprintf(stderr, "ERROR: state lengths differ: %ld vs %ld\n", n1, n2);
+    fails++;
+  }
+  else
+  {
+    for (k = 0; k < n1; k++)
+    {
+      if (b1[k] != b2[k])
+      {
+        fprintf(stderr, "ERROR: states differ at byte %ld of %ld\n", k, n1);
+        fails++;
+        break;
+      }
+    }
+  }
+
+  free(b1);
+  free(b2);
+  fclose(fp1);
+  fclose(fp2);
+
+  return fails;
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  Integrator ref, rst, bad;
+  FILE *fp = NULL, *fpt = NULL;
+  char* buf    = NULL;
+  sunrealtype t1 = SUN_RCONST(0.4), t2 = SUN_RCONST(4.0e3), tret;
+  long int nst1, nst2, nfe1, nfe2, nsetups1, nsetups2, nfS1, nfS2;
+  sunrealtype h1, h2;
+  int q1, q2, is, flag;
+  long len;
+  int fails = 0;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  /* ------------------------------------------------
+   * Uninterrupted run, writing the state at t1
+   * ------------------------------------------------ */
+
+  fp = tmpfile();
+  if (!fp) { return 1; }
+
+  if (create(sunctx, CV_BDF, 5, 1, NP, &ref)) { return 1; }
+
+  if (CVode(ref.cvode_mem, t1, ref.y, &tret, CV_NORMAL) < 0) { return 1; }
+
+  if (CVodeWriteState(ref.cvode_mem, fp)) { return 1; }
+
+  if (CVode(ref.cvode_mem, t2, ref.y, &tret, CV_NORMAL) < 0) { return 1; }
+
+  /* ------------------------------------------------
+   * Restarted run from the state at t1
+   * ------------------------------------------------ */
+
+  if (create(sunctx, CV_BDF, 5, 1, NP, &rst)) { return 1; }
+
+  rewind(fp);
+  if (CVodeReadState(rst.cvode_mem, fp)) { return 1; }
+
+  if (CVode(rst.cvode_mem, t2, rst.y, &tret, CV_NORMAL) < 0) { return 1; }
+
+  if (CVodeGetSens(ref.cvode_mem, &tret, ref.yS)) { return 1; }
+  if (CVodeGetSens(rst.cvode_mem, &tret, rst.yS)) { return 1; }
+  if (CVodeGetQuad(ref.cvode_mem, &tret, ref.q)) { return 1; }
+  if (CVodeGetQuad(rst.cvode_mem, &tret, rst.q)) { return 1; }
+
+  CVodeGetNumSteps(ref.cvode_mem, &nst1);
+  CVodeGetNumSteps(rst.cvode_mem, &nst2);
+  CVodeGetNumRhsEvals(ref.cvode_mem, &nfe1);
+  CVodeGetNumRhsEvals(rst.cvode_mem, &nfe2);
+  CVodeGetNumLinSolvSetups(ref.cvode_mem, &nsetups1);
+  CVodeGetNumLinSolvSetups(rst.cvode_mem, &nsetups2);
+  CVodeGetSensNumRhsEvals(ref.cvode_mem, &nfS1);
+  CVodeGetSensNumRhsEvals(rst.cvode_mem, &nfS2);
+  CVodeGetLastOrder(ref.cvode_mem, &q1);
+  CVodeGetLastOrder(rst.cvode_mem, &q2);
+  CVodeGetLastStep(ref.cvode_mem, &h1);
+  CVodeGetLastStep(rst.cvode_mem, &h2);
+
+  printf("uninterrupted: nst = %ld, nfe = %ld, nfeS = %ld, nsetups = %ld, q = "
+         "%d, h = %" GSYM "\n",
+         nst1, nfe1, nfS1, nsetups1, q1, h1);
+  printf("restarted:     nst = %ld, nfe = %ld, nfeS = %ld, nsetups = %ld, q = "
+         "%d, h = %" GSYM "\n",
+         nst2, nfe2, nfS2, nsetups2, q2, h2);
+
+  if (nst1 != nst2 || nfe1 != nfe2 || nfS1 != nfS2 || nsetups1 != nsetups2 ||
+      q1 != q2 || h1 != h2)
+  {
+    fprintf(stderr, "ERROR: restarted run statistics differ\n");
+    fails++;
+  }
+
+  if (N_VGetArrayPointer(ref.y)[0] != N_VGetArrayPointer(rst.y)[0] ||
+      N_VGetArrayPointer(ref.y)[1] != N_VGetArrayPointer(rst.y)[1] ||
+      N_VGetArrayPointer(ref.y)[2] != N_VGetArrayPointer(rst.y)[2])
+  {
+    fprintf(stderr, "ERROR: restarted run solution differs\n");
+    fails++;
+  }
+
+  for (is = 0; is < NP; is++)
+  {
+    if (memcmp(N_VGetArrayPointer(ref.yS[is]), N_VGetArrayPointer(rst.yS[is]),
+               3 * sizeof(sunrealtype)))
+    {
+      fprintf(stderr, "ERROR: restarted run sensitivity %d differs\n", is);
+      fails++;
+    }
+  }
+
+  if (N_VGetArrayPointer(ref.q)[0] != N_VGetArrayPointer(rst.q)[0])
+  {
+    fprintf(stderr, "ERROR: restarted run quadrature differs\n");
+    fails++;
+  }
+
+  fails += compare_states(ref.cvode_mem, rst.cvode_mem);
+
+  destroy(&rst);
+
+  /* ------------------------------------------------
+   * A truncated stream is rejected
+   * ------------------------------------------------ */
+
+  len = stream_bytes(fp, &buf);
+  if (len <= 0) { return 1; }
+
+  fpt = tmpfile();
+  if (!fpt) { return 1; }
+  fwrite(buf, 1, len / 2, fpt);
+  rewind(fpt);
+
+  if (create(sunctx, CV_BDF, 5, 1, NP, &bad)) { return 1; }
+  flag = CVodeReadState(bad.cvode_mem, fpt);
+  if (flag != CV_ILL_INPUT)
+  {
+    fprintf(stderr, "ERROR: truncated stream returned %d\n", flag);
+    fails++;
+  }
+  destroy(&bad);
+  fclose(fpt);
+  free(buf);
+
+  /* ------------------------------------------------
+   * Streams from a mismatched integrator are rejected
+   * ------------------------------------------------ */
+
+  rewind(fp);
+  if (create(sunctx, CV_ADAMS, 5, 1, NP, &bad)) { return 1; }
+  flag = CVodeReadState(bad.cvode_mem, fp);
+  if (flag != CV_ILL_INPUT)
+  {
+    fprintf(stderr, "ERROR: method mismatch returned %d\n", flag);
+    fails++;
+  }
+  destroy(&bad);
+
+  rewind(fp);
+  if (create(sunctx, CV_BDF, 3, 1, NP, &bad)) { return 1; }
+  flag = CVodeReadState(bad.cvode_mem, fp);
+  if (flag != CV_ILL_INPUT)
+  {
+    fprintf(stderr, "ERROR: maximum order mismatch returned %d\n", flag);
+    fails++;
+  }
+  destroy(&bad);
+
+  rewind(fp);
+  if (create(sunctx, CV_BDF, 5, 2, NP, &bad)) { return 1; }
+  flag = CVodeReadState(bad.cvode_mem, fp);
+  if (flag != CV_ILL_INPUT)
+  {
+    fprintf(stderr, "ERROR: problem size mismatch returned %d\n", flag);
+    fails++;
+  }
+  destroy(&bad);
+
+  rewind(fp);
+  if (create(sunctx, CV_BDF, 5, 1, NP - 1, &bad)) { return 1; }
+  flag = CVodeReadState(bad.cvode_mem, fp);
+  if (flag != CV_ILL_INPUT)
+  {
+    fprintf(stderr, "ERROR: sensitivity mismatch returned %d\n", flag);
+    fails++;
+  }
+  destroy(&bad);
+
+  fclose(fp);
+  destroy(&ref);
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d checks failed\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}
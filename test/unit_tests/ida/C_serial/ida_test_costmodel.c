@@ -0,0 +1,220 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the setup cost model enabled with IDASetJacEvalCostModel. The
+ * Robertson DAE is integrated with the default setup policy, with the cost
+ * model enabled and then disabled again, and with the cost model enabled. The first two runs must be
+ * identical and must not record any solver times. Since the cost model
+ * decisions depend on measured times, the last run is only required to
+ * succeed, to record the solver times, and to agree with the default run to
+ * within the integration tolerances.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ida/ida.h"
+#include "nvector/nvector_serial.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#else
+#define GSYM "g"
+#endif
+
+#define NEQ 3
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+#define RTOL SUN_RCONST(1.0e-6)
+#define ATOL SUN_RCONST(1.0e-10)
+
+static int res(sunrealtype t, N_Vector y, N_Vector yp, N_Vector rr,
+               void* user_data)
+{
+  sunrealtype* yd  = N_VGetArrayPointer(y);
+  sunrealtype* ypd = N_VGetArrayPointer(yp);
+  sunrealtype* rd  = N_VGetArrayPointer(rr);
+
+  rd[0] = SUN_RCONST(-0.04) * yd[0] + SUN_RCONST(1.0e4) * yd[1] * yd[2];
+  rd[1] = -rd[0] - SUN_RCONST(3.0e7) * yd[1] * yd[1] - ypd[1];
+  rd[0] -= ypd[0];
+  rd[2] = yd[0] + yd[1] + yd[2] - ONE;
+
+  return 0;
+}
+
+/* Integrate to tout and return the solution, counters, and solver times. mode
+   0 uses the default setup policy, mode 1 enables and then disables the cost
+   model, and mode 2 enables the cost model. */
+static int run(SUNContext sunctx, int mode, N_Vector yout, long int* counters,
+               sunrealtype* times)
+{
+  void* ida_mem      = NULL;
+  N_Vector y         = NULL;
+  N_Vector yp        = NULL;
+  SUNMatrix A        = NULL;
+  SUNLinearSolver LS = NULL;
+  sunrealtype tret;
+  int flag;
+
+  y  = N_VNew_Serial(NEQ, sunctx);
+  yp = N_VNew_Serial(NEQ, sunctx);
+  if (!y || !yp) { return 1; }
+  N_VConst(ZERO, y);
+  N_VConst(ZERO, yp);
+  NV_Ith_S(y, 0)  = ONE;
+  NV_Ith_S(yp, 0) = SUN_RCONST(-0.04);
+  NV_Ith_S(yp, 1) = SUN_RCONST(0.04);
+
+  ida_mem = IDACreate(sunctx);
+  if (!ida_mem) { return 1; }
+
+  flag = IDAInit(ida_mem, res, ZERO, y, yp);
+  if (flag) { return 1; }
+
+  flag = IDASStolerances(ida_mem, RTOL, ATOL);
+  if (flag) { return 1; }
+
+  A = SUNDenseMatrix(NEQ, NEQ, sunctx);
+  if (!A) { return 1; }
+
+  LS = SUNLinSol_Dense(y, A, sunctx);
+  if (!LS) { return 1; }
+
+  flag = IDASetLinearSolver(ida_mem, LS, A);
+  if (flag) { return 1; }
+
+  if (mode > 0)
+  {
+    flag = IDASetJacEvalCostModel(ida_mem, SUNTRUE);
+    if (flag) { return 1; }
+  }
+
+  if (mode == 1)
+  {
+    flag = IDASetJacEvalCostModel(ida_mem, SUNFALSE);
+    if (flag) { return 1; }
+  }
+
+  flag = IDASolve(ida_mem, SUN_RCONST(4.0e3), &tret, y, yp, IDA_NORMAL);
+  if (flag < 0) { return 1; }
+
+  N_VScale(ONE, y, yout);
+
+  flag = IDAGetNumSteps(ida_mem, &counters[0]);
+  if (flag) { return 1; }
+  flag = IDAGetNumResEvals(ida_mem, &counters[1]);
+  if (flag) { return 1; }
+  flag = IDAGetNumJacEvals(ida_mem, &counters[2]);
+  if (flag) { return 1; }
+  flag = IDAGetNumLinSolvSetups(ida_mem, &counters[3]);
+  if (flag) { return 1; }
+
+  flag = IDAGetLinSolveTimes(ida_mem, &times[0], &times[1]);
+  if (flag) { return 1; }
+
+  N_VDestroy(y);
+  N_VDestroy(yp);
+  SUNLinSolFree(LS);
+  SUNMatDestroy(A);
+  IDAFree(&ida_mem);
+
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  N_Vector y[3]     = {NULL, NULL, NULL};
+  long int c[3][4];
+  sunrealtype tm[3][2];
+  const char* names[3]  = {"default:", "on then off:", "cost model:"};
+  const char* cnames[4] = {"nst", "nre", "nje", "nsetups"};
+  sunrealtype err;
+  int fails = 0;
+  int i, k;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  for (k = 0; k < 3; k++)
+  {
+    y[k] = N_VNew_Serial(NEQ, sunctx);
+    if (!y[k]) { return 1; }
+    if (run(sunctx, k, y[k], c[k], tm[k])) { return 1; }
+
+    printf("%-13s nst = %ld, nre = %ld, nje = %ld, nsetups = %ld, tjac = "
+           "%.2e, tnls = %.2e\n",
+           names[k], c[k][0], c[k][1], c[k][2], c[k][3], (double)tm[k][0],
+           (double)tm[k][1]);
+  }
+
+  /* Disabling the cost model restores the default policy exactly */
+  for (i = 0; i < NEQ; i++)
+  {
+    if (NV_Ith_S(y[0], i) != NV_Ith_S(y[1], i))
+    {
+      fprintf(stderr, "ERROR: y[%d] differs from the default run\n", i);
+      fails++;
+    }
+  }
+  for (i = 0; i < 4; i++)
+  {
+    if (c[0][i] != c[1][i])
+    {
+      fprintf(stderr, "ERROR: %s differs from the default run\n", cnames[i]);
+      fails++;
+    }
+  }
+
+  /* Times are only measured with the cost model enabled */
+  for (k = 0; k < 2; k++)
+  {
+    if (tm[k][0] != ZERO || tm[k][1] != ZERO)
+    {
+      fprintf(stderr, "ERROR: solver times recorded without the cost model\n");
+      fails++;
+    }
+  }
+  if (tm[2][0] <= ZERO || tm[2][1] <= ZERO || c[2][2] < 1)
+  {
+    fprintf(stderr, "ERROR: the cost model did not record solver times\n");
+    fails++;
+  }
+
+  /* The cost model solution agrees to within the tolerances */
+  for (i = 0; i < NEQ; i++)
+  {
+    err = SUNRabs(NV_Ith_S(y[2], i) - NV_Ith_S(y[0], i)) /
+          (RTOL * SUNRabs(NV_Ith_S(y[0], i)) + ATOL);
+    if (err > SUN_RCONST(100.0))
+    {
+      fprintf(stderr, "ERROR: cost model y[%d] = %" GSYM " vs %" GSYM "\n", i,
+              NV_Ith_S(y[2], i), NV_Ith_S(y[0], i));
+      fails++;
+    }
+  }
+
+  for (k = 0; k < 3; k++) { N_VDestroy(y[k]); }
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d checks failed\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}
@@ -0,0 +1,313 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the adaptive linear solver tolerance enabled with
+ * IDASetLSForcing. The Fisher equation u_t = u_xx + R u (1 - u) on (0, 1)
+ * with homogeneous Dirichlet boundary conditions is discretized with N
+ * interior points, written as a residual, and integrated with an
+ * unpreconditioned SPGMR solver. The test checks that
+ *
+ *   1. IDASetLSForcingParams rejects gamma > 1, alpha in (0, 1], and
+ *      alpha > 2, leaves the parameters unchanged when it does, and accepts
+ *      legal values,
+ *   2. IDASetLSForcingMaxRelax rejects a factor in (0, 1) and accepts
+ *      legal values,
+ *   3. enabling and then disabling the forcing term, or enabling it with a
+ *      maximum relaxation factor of one, restores the default run exactly,
+ *   4. with the forcing term the solution agrees with the default run to
+ *      within the integration tolerances.
+ *
+ * The savings in linear iterations depend on the problem and are shown by the
+ * idaHeat2D_kry example with the forcing term enabled.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ida/ida.h"
+#include "nvector/nvector_serial.h"
+#include "sunlinsol/sunlinsol_spgmr.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#else
+#define GSYM "g"
+#endif
+
+#define N 100
+#define R SUN_RCONST(20.0)
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+#define TWO  SUN_RCONST(2.0)
+
+#define RTOL SUN_RCONST(1.0e-6)
+#define ATOL SUN_RCONST(1.0e-10)
+
+/* The right-hand side u_xx + R u (1 - u) */
+static int rhs(N_Vector y, N_Vector ydot)
+{
+  sunrealtype* u  = N_VGetArrayPointer(y);
+  sunrealtype* ud = N_VGetArrayPointer(ydot);
+  sunrealtype c   = (sunrealtype)((N + 1) * (N + 1));
+  sunrealtype ul, ur;
+  int i;
+
+  for (i = 0; i < N; i++)
+  {
+    ul    = (i > 0) ? u[i - 1] : ZERO;
+    ur    = (i < N - 1) ? u[i + 1] : ZERO;
+    ud[i] = c * (ul - TWO * u[i] + ur) + R * u[i] * (ONE - u[i]);
+  }
+
+  return 0;
+}
+
+static int res(sunrealtype t, N_Vector y, N_Vector yp, N_Vector rr,
+               void* user_data)
+{
+  rhs(y, rr);
+  N_VLinearSum(ONE, rr, -ONE, yp, rr);
+  return 0;
+}
+
+/* Check the parameter validation, ending with the defaults set followed by
+   rejected values, and return the number of failed checks */
+static int check_params(void* ida_mem)
+{
+  const sunrealtype bad[4][2] = {{SUN_RCONST(1.5), TWO},
+                                 {SUN_RCONST(0.9), SUN_RCONST(0.5)},
+                                 {SUN_RCONST(0.9), ONE},
+                                 {SUN_RCONST(0.9), SUN_RCONST(2.5)}};
+  const sunrealtype good[3][2] = {{SUN_RCONST(0.5), SUN_RCONST(1.5)},
+                                  {ONE, TWO},
+                                  {ZERO, ZERO}};
+  int flag, k, fails = 0;
+
+  for (k = 0; k < 3; k++)
+  {
+    flag = IDASetLSForcingParams(ida_mem, good[k][0], good[k][1]);
+    if (flag != IDALS_SUCCESS)
+    {
+      fprintf(stderr, "ERROR: gamma = %" GSYM ", alpha = %" GSYM " returned %d\n",
+              good[k][0], good[k][1], flag);
+      fails++;
+    }
+  }
+
+  for (k = 0; k < 4; k++)
+  {
+    flag = IDASetLSForcingParams(ida_mem, bad[k][0], bad[k][1]);
+    if (flag != IDALS_ILL_INPUT)
+    {
+      fprintf(stderr, "ERROR: gamma = %" GSYM ", alpha = %" GSYM " returned %d\n",
+              bad[k][0], bad[k][1], flag);
+      fails++;
+    }
+  }
+
+  flag = IDASetLSForcingMaxRelax(ida_mem, SUN_RCONST(4.0));
+  if (flag != IDALS_SUCCESS)
+  {
+    fprintf(stderr, "ERROR: frelax = 4 returned %d\n", flag);
+    fails++;
+  }
+
+  flag = IDASetLSForcingMaxRelax(ida_mem, ZERO);
+  if (flag != IDALS_SUCCESS)
+  {
+    fprintf(stderr, "ERROR: frelax = 0 returned %d\n", flag);
+    fails++;
+  }
+
+  flag = IDASetLSForcingMaxRelax(ida_mem, SUN_RCONST(0.5));
+  if (flag != IDALS_ILL_INPUT)
+  {
+    fprintf(stderr, "ERROR: frelax = 0.5 returned %d\n", flag);
+    fails++;
+  }
+
+  return fails;
+}
+
+/* Integrate to tf and return the solution and counters. mode 0 uses the fixed
+   tolerance, mode 1 enables and then disables the forcing term, mode 2 enables
+   the forcing term, mode 3 also checks the parameter validation, and mode 4
+   enables the forcing term with a maximum relaxation factor of one. */
+static int run(SUNContext sunctx, int mode, N_Vector yout, long int* counters,
+               int* fails)
+{
+  void* ida_mem      = NULL;
+  N_Vector y         = NULL;
+  N_Vector yp        = NULL;
+  SUNLinearSolver LS = NULL;
+  sunrealtype tret, x;
+  int flag, i;
+
+  /* u(0, x) = 2 x (1 - x) */
+  y  = N_VNew_Serial(N, sunctx);
+  yp = N_VNew_Serial(N, sunctx);
+  if (!y || !yp) { return 1; }
+  for (i = 0; i < N; i++)
+  {
+    x              = (sunrealtype)(i + 1) / (sunrealtype)(N + 1);
+    NV_Ith_S(y, i) = TWO * x * (ONE - x);
+  }
+  rhs(y, yp);
+
+  ida_mem = IDACreate(sunctx);
+  if (!ida_mem) { return 1; }
+
+  flag = IDAInit(ida_mem, res, ZERO, y, yp);
+  if (flag) { return 1; }
+
+  flag = IDASStolerances(ida_mem, RTOL, ATOL);
+  if (flag) { return 1; }
+
+  flag = IDASetMaxNumSteps(ida_mem, 10000);
+  if (flag) { return 1; }
+
+  /* the parameters require the linear solver interface */
+  if (mode == 3)
+  {
+    flag = IDASetLSForcingParams(ida_mem, SUN_RCONST(0.9), TWO);
+    if (flag != IDALS_LMEM_NULL)
+    {
+      fprintf(stderr, "ERROR: parameters without a linear solver returned %d\n",
+              flag);
+      (*fails)++;
+    }
+  }
+
+  LS = SUNLinSol_SPGMR(y, SUN_PREC_NONE, 20, sunctx);
+  if (!LS) { return 1; }
+
+  flag = IDASetLinearSolver(ida_mem, LS, NULL);
+  if (flag) { return 1; }
+
+  if (mode > 0)
+  {
+    flag = IDASetLSForcing(ida_mem, SUNTRUE);
+    if (flag) { return 1; }
+  }
+
+  if (mode == 1)
+  {
+    flag = IDASetLSForcing(ida_mem, SUNFALSE);
+    if (flag) { return 1; }
+  }
+
+  if (mode == 3) { *fails += check_params(ida_mem); }
+
+  if (mode == 4)
+  {
+    flag = IDASetLSForcingMaxRelax(ida_mem, ONE);
+    if (flag) { return 1; }
+  }
+
+  flag = IDASolve(ida_mem, SUN_RCONST(0.5), &tret, y, yp, IDA_NORMAL);
+  if (flag < 0) { return 1; }
+
+  N_VScale(ONE, y, yout);
+
+  flag = IDAGetNumSteps(ida_mem, &counters[0]);
+  if (flag) { return 1; }
+  flag = IDAGetNumNonlinSolvIters(ida_mem, &counters[1]);
+  if (flag) { return 1; }
+  flag = IDAGetNumLinIters(ida_mem, &counters[2]);
+  if (flag) { return 1; }
+  flag = IDAGetNumLinConvFails(ida_mem, &counters[3]);
+  if (flag) { return 1; }
+
+  N_VDestroy(y);
+  N_VDestroy(yp);
+  SUNLinSolFree(LS);
+  IDAFree(&ida_mem);
+
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  N_Vector y[5]     = {NULL, NULL, NULL, NULL, NULL};
+  long int c[5][4];
+  const char* names[5]  = {"fixed:", "on then off:", "forcing:", "checked:",
+                           "no relax:"};
+  const char* cnames[4] = {"nst", "nni", "nli", "ncfl"};
+  sunrealtype err, maxerr = ZERO;
+  const int same[3][2] = {{1, 0}, {3, 2}, {4, 0}};
+  int fails            = 0;
+  int i, j, k, l;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  for (k = 0; k < 5; k++)
+  {
+    y[k] = N_VNew_Serial(N, sunctx);
+    if (!y[k]) { return 1; }
+    if (run(sunctx, k, y[k], c[k], &fails)) { return 1; }
+
+    printf("%-13s nst = %ld, nni = %ld, nli = %ld, ncfl = %ld\n", names[k],
+           c[k][0], c[k][1], c[k][2], c[k][3]);
+  }
+
+  /* Disabling the forcing term or its relaxation restores the fixed tolerance
+     exactly, and rejected parameters do not change the forcing term */
+  for (j = 0; j < 3; j++)
+  {
+    k = same[j][0];
+    l = same[j][1];
+    if (memcmp(N_VGetArrayPointer(y[l]), N_VGetArrayPointer(y[k]),
+               N * sizeof(sunrealtype)))
+    {
+      fprintf(stderr, "ERROR: %s solution differs from %s\n", names[k],
+              names[l]);
+      fails++;
+    }
+    for (i = 0; i < 4; i++)
+    {
+      if (c[l][i] != c[k][i])
+      {
+        fprintf(stderr, "ERROR: %s %s differs from %s\n", names[k], cnames[i],
+                names[l]);
+        fails++;
+      }
+    }
+  }
+
+  /* The relaxed linear solves do not cost accuracy */
+  for (i = 0; i < N; i++)
+  {
+    err = SUNRabs(NV_Ith_S(y[2], i) - NV_Ith_S(y[0], i)) /
+          (RTOL * SUNRabs(NV_Ith_S(y[0], i)) + ATOL);
+    maxerr = SUNMAX(maxerr, err);
+  }
+  printf("max weighted difference with the forcing term: %" GSYM "\n", maxerr);
+  if (maxerr > SUN_RCONST(100.0))
+  {
+    fprintf(stderr, "ERROR: the forcing term solution is not accurate\n");
+    fails++;
+  }
+
+  for (k = 0; k < 5; k++) { N_VDestroy(y[k]); }
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d checks failed\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}
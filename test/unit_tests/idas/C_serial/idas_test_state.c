@@ -0,0 +1,450 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for IDAWriteState and IDAReadState in IDAS. The Robertson DAE
+ * with forward sensitivities with respect to its three rate constants and a
+ * quadrature is integrated to t1, the state is written, read into a new IDAS
+ * memory, and the integration is continued to t2.
+ *
+ * Since the saved Jacobian is not part of the state, reading a state forces a
+ * linear solver setup at the next step and IDA has no option to set up at
+ * every step, so the restarted run is compared bit-for-bit with a run that
+ * reads the state back into its own memory at t1. The comparison writes the
+ * state of both runs at t2 and compares the streams, which covers the
+ * solution, sensitivity, and quadrature history arrays, order, step size, and
+ * counters, so nothing needed to
+ * continue may be left behind in the original memory. The restarted run must
+ * also agree with an uninterrupted run to within the integration tolerances.
+ * Reading a truncated stream or a stream from a different maximum order,
+ * problem size, or number of sensitivities must fail.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "idas/idas.h"
+#include "nvector/nvector_serial.h"
+#include "sunlinsol/sunlinsol_dense.h"
+#include "sunmatrix/sunmatrix_dense.h"
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#else
+#define GSYM "g"
+#endif
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+#define RTOL SUN_RCONST(1.0e-6)
+#define ATOL SUN_RCONST(1.0e-10)
+
+#define NP 3
+
+/* IDAS memory together with the objects attached to it */
+typedef struct
+{
+  void* ida_mem;
+  N_Vector y;
+  N_Vector yp;
+  N_Vector q;
+  N_Vector* yS;
+  N_Vector* ypS;
+  int Ns;
+  SUNMatrix A;
+  SUNLinearSolver LS;
+  sunrealtype p[NP];
+} Integrator;
+
+static int res(sunrealtype t, N_Vector y, N_Vector yp, N_Vector rr,
+               void* user_data)
+{
+  sunrealtype* p   = (sunrealtype*)user_data;
+  sunrealtype* yd  = N_VGetArrayPointer(y);
+  sunrealtype* ypd = N_VGetArrayPointer(yp);
+  sunrealtype* rd  = N_VGetArrayPointer(rr);
+  sunindextype i, n = N_VGetLength(y) / 3;
+
+  /* n uncoupled copies of the Robertson problem */
+  for (i = 0; i < n; i++)
+  {
+    rd[3 * i] = -p[0] * yd[3 * i] + p[1] * yd[3 * i + 1] * yd[3 * i + 2];
+    rd[3 * i + 1] = -rd[3 * i] - p[2] * yd[3 * i + 1] * yd[3 * i + 1] -
+                    ypd[3 * i + 1];
+    rd[3 * i] -= ypd[3 * i];
+    rd[3 * i + 2] = yd[3 * i] + yd[3 * i + 1] + yd[3 * i + 2] - ONE;
+  }
+
+  return 0;
+}
+
+/* Integral of the first component */
+static int rhsQ(sunrealtype t, N_Vector y, N_Vector yp, N_Vector qdot,
+                void* user_data)
+{
+  N_VGetArrayPointer(qdot)[0] = N_VGetArrayPointer(y)[0];
+  return 0;
+}
+
+static int create(SUNContext sunctx, int maxord, sunindextype n, int Ns,
+                  Integrator* I)
+{
+  sunindextype i;
+  int is;
+
+  I->p[0] = SUN_RCONST(0.04);
+  I->p[1] = SUN_RCONST(1.0e4);
+  I->p[2] = SUN_RCONST(3.0e7);
+  I->Ns   = Ns;
+
+  I->y  = N_VNew_Serial(3 * n, sunctx);
+  I->yp = N_VNew_Serial(3 * n, sunctx);
+  if (!I->y || !I->yp) { return 1; }
+  N_VConst(ZERO, I->y);
+  N_VConst(ZERO, I->yp);
+  for (i = 0; i < n; i++)
+  {
+    NV_Ith_S(I->y, 3 * i)      = ONE;
+    NV_Ith_S(I->yp, 3 * i)     = SUN_RCONST(-0.04);
+    NV_Ith_S(I->yp, 3 * i + 1) = SUN_RCONST(0.04);
+  }
+
+  I->ida_mem = IDACreate(sunctx);
+  if (!I->ida_mem) { return 1; }
+
+  if (IDAInit(I->ida_mem, res, ZERO, I->y, I->yp)) { return 1; }
+
+  if (IDASetUserData(I->ida_mem, I->p)) { return 1; }
+
+  if (IDASStolerances(I->ida_mem, RTOL, ATOL)) { return 1; }
+
+  if (IDASetMaxOrd(I->ida_mem, maxord)) { return 1; }
+
+  I->A = SUNDenseMatrix(3 * n, 3 * n, sunctx);
+  if (!I->A) { return 1; }
+
+  I->LS = SUNLinSol_Dense(I->y, I->A, sunctx);
+  if (!I->LS) { return 1; }
+
+  if (IDASetLinearSolver(I->ida_mem, I->LS, I->A)) { return 1; }
+
+  I->q = N_VNew_Serial(1, sunctx);
+  if (!I->q) { return 1; }
+  N_VConst(ZERO, I->q);
+
+  if (IDAQuadInit(I->ida_mem, rhsQ, I->q)) { return 1; }
+  if (IDAQuadSStolerances(I->ida_mem, RTOL, ATOL)) { return 1; }
+  if (IDASetQuadErrCon(I->ida_mem, SUNTRUE)) { return 1; }
+
+  /* the initial sensitivities are zero and consistent */
+  I->yS  = N_VCloneVectorArray(Ns, I->y);
+  I->ypS = N_VCloneVectorArray(Ns, I->y);
+  if (!I->yS || !I->ypS) { return 1; }
+  for (is = 0; is < Ns; is++)
+  {
+    N_VConst(ZERO, I->yS[is]);
+    N_VConst(ZERO, I->ypS[is]);
+  }
+  for (i = 0; i < n; i++)
+  {
+    NV_Ith_S(I->ypS[0], 3 * i)     = -ONE;
+    NV_Ith_S(I->ypS[0], 3 * i + 1) = ONE;
+  }
+
+  if (IDASensInit(I->ida_mem, Ns, IDA_SIMULTANEOUS, NULL, I->yS, I->ypS))
+  {
+    return 1;
+  }
+  if (IDASensEEtolerances(I->ida_mem)) { return 1; }
+  if (IDASetSensParams(I->ida_mem, I->p, I->p, NULL)) { return 1; }
+  if (IDASetSensErrCon(I->ida_mem, SUNTRUE)) { return 1; }
+
+  return 0;
+}
+
+static void destroy(Integrator* I)
+{
+  IDAFree(&I->ida_mem);
+  N_VDestroyVectorArray(I->yS, I->Ns);
+  N_VDestroyVectorArray(I->ypS, I->Ns);
+  N_VDestroy(I->q);
+  SUNLinSolFree(I->LS);
+  SUNMatDestroy(I->A);
+  N_VDestroy(I->y);
+  N_VDestroy(I->yp);
+}
+
+/* Read the whole stream into a buffer and return its length */
+static long stream_bytes(FILE* fp, char** buf)
+{
+  long len;
+
+  fseek(fp, 0, SEEK_END);
+  len = ftell(fp);
+  rewind(fp);
+
+  *buf = (char*)malloc(len > 0 ? len : 1);
+  if (fread(*buf, 1, len, fp) != (size_t)len) { len = -1; }
+
+  return len;
+}
+
+/* Compare the states written by two integrators */
+static int compare_states(void* mem1, void* mem2)
+{
+  FILE *fp1 = tmpfile(), *fp2 = tmpfile();
+  char *b1 = NULL, *b2 = NULL;
+  long n1, n2, k;
+  int fails = 0;
+
+  if (!fp1 || !fp2) { return 1; }
+
+  if (IDAWriteState(mem1, fp1) || IDAWriteState(mem2, fp2)) { return 1; }
+
+  n1 = stream_bytes(fp1, &b1);
+  n2 = stream_bytes(fp2, &b2);
+
+  if (n1 <= 0 || n1 != n2)
+  {
+    fprintf(stderr, "ERROR: state lengths differ: %ld vs %ld\n", n1, n2);
+    fails++;
+  }
+  else
+  {
+    for (k = 0; k < n1; k++)
+    {
+      if (b1[k] != b2[k])
+      {
+        fprintf(stderr, "ERROR: states differ at byte %ld of %ld\n", k, n1);
+        fails++;
+        break;
+      }
+    }
+  }
+
+  free(b1);
+  free(b2);
+  fclose(fp1);
+  fclose(fp2);
+
+  return fails;
+}
+
+static void print_stats(const char* name, void* ida_mem)
+{
+  long int nst, nre, nrS, nsetups;
+  sunrealtype h;
+  int q;
+
+  IDAGetNumSteps(ida_mem, &nst);
+  IDAGetNumResEvals(ida_mem, &nre);
+  IDAGetSensNumResEvals(ida_mem, &nrS);
+  IDAGetNumLinSolvSetups(ida_mem, &nsetups);
+  IDAGetLastOrder(ida_mem, &q);
+  IDAGetLastStep(ida_mem, &h);
+
+  printf("%-14s nst = %ld, nre = %ld, nreS = %ld, nsetups = %ld, q = %d, "
+         "h = %" GSYM "\n",
+         name, nst, nre, nrS, nsetups, q, h);
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  Integrator ref, inp, rst, bad;
+  FILE *fp = NULL, *fpi = NULL, *fpt = NULL;
+  char* buf    = NULL;
+  sunrealtype t1 = SUN_RCONST(0.4), t2 = SUN_RCONST(4.0e3), tret, err;
+  long len;
+  int i, is, flag;
+  int fails = 0;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  fp  = tmpfile();
+  fpi = tmpfile();
+  if (!fp || !fpi) { return 1; }
+
+  /* ------------------------------------------------
+   * Uninterrupted run, writing the state at t1
+   * ------------------------------------------------ */
+
+  if (create(sunctx, 5, 1, NP, &ref)) { return 1; }
+
+  if (IDASolve(ref.ida_mem, t1, &tret, ref.y, ref.yp, IDA_NORMAL) < 0)
+  {
+    return 1;
+  }
+
+  if (IDAWriteState(ref.ida_mem, fp)) { return 1; }
+
+  if (IDASolve(ref.ida_mem, t2, &tret, ref.y, ref.yp, IDA_NORMAL) < 0)
+  {
+    return 1;
+  }
+
+  /* ------------------------------------------------
+   * Run restarted in place at t1
+   * ------------------------------------------------ */
+
+  if (create(sunctx, 5, 1, NP, &inp)) { return 1; }
+
+  if (IDASolve(inp.ida_mem, t1, &tret, inp.y, inp.yp, IDA_NORMAL) < 0)
+  {
+    return 1;
+  }
+
+  if (IDAWriteState(inp.ida_mem, fpi)) { return 1; }
+  rewind(fpi);
+  if (IDAReadState(inp.ida_mem, fpi)) { return 1; }
+
+  if (IDASolve(inp.ida_mem, t2, &tret, inp.y, inp.yp, IDA_NORMAL) < 0)
+  {
+    return 1;
+  }
+
+  /* ------------------------------------------------
+   * Run restarted in a new memory from the state at t1
+   * ------------------------------------------------ */
+
+  if (create(sunctx, 5, 1, NP, &rst)) { return 1; }
+
+  rewind(fp);
+  if (IDAReadState(rst.ida_mem, fp)) { return 1; }
+
+  if (IDASolve(rst.ida_mem, t2, &tret, rst.y, rst.yp, IDA_NORMAL) < 0)
+  {
+    return 1;
+  }
+
+  if (IDAGetSens(inp.ida_mem, &tret, inp.yS)) { return 1; }
+  if (IDAGetSens(rst.ida_mem, &tret, rst.yS)) { return 1; }
+  if (IDAGetQuad(inp.ida_mem, &tret, inp.q)) { return 1; }
+  if (IDAGetQuad(rst.ida_mem, &tret, rst.q)) { return 1; }
+
+  print_stats("uninterrupted:", ref.ida_mem);
+  print_stats("in place:", inp.ida_mem);
+  print_stats("restarted:", rst.ida_mem);
+
+  if (memcmp(N_VGetArrayPointer(inp.y), N_VGetArrayPointer(rst.y),
+             3 * sizeof(sunrealtype)) ||
+      memcmp(N_VGetArrayPointer(inp.yp), N_VGetArrayPointer(rst.yp),
+             3 * sizeof(sunrealtype)))
+  {
+    fprintf(stderr, "ERROR: restarted run solution differs\n");
+    fails++;
+  }
+
+  for (is = 0; is < NP; is++)
+  {
+    if (memcmp(N_VGetArrayPointer(inp.yS[is]), N_VGetArrayPointer(rst.yS[is]),
+               3 * sizeof(sunrealtype)))
+    {
+      fprintf(stderr, "ERROR: restarted run sensitivity %d differs\n", is);
+      fails++;
+    }
+  }
+
+  if (N_VGetArrayPointer(inp.q)[0] != N_VGetArrayPointer(rst.q)[0])
+  {
+    fprintf(stderr, "ERROR: restarted run quadrature differs\n");
+    fails++;
+  }
+
+  fails += compare_states(inp.ida_mem, rst.ida_mem);
+
+  /* agreement with the uninterrupted run */
+  for (i = 0; i < 3; i++)
+  {
+    err = SUNRabs(NV_Ith_S(ref.y, i) - NV_Ith_S(rst.y, i)) /
+          (RTOL * SUNRabs(NV_Ith_S(ref.y, i)) + ATOL);
+    if (err > SUN_RCONST(100.0))
+    {
+      fprintf(stderr, "ERROR: y[%d] differs from the uninterrupted run\n", i);
+      fails++;
+    }
+  }
+
+  destroy(&inp);
+  destroy(&rst);
+  fclose(fpi);
+
+  /* ------------------------------------------------
+   * A truncated stream is rejected
+   * ------------------------------------------------ */
+
+  len = stream_bytes(fp, &buf);
+  if (len <= 0) { return 1; }
+
+  fpt = tmpfile();
+  if (!fpt) { return 1; }
+  fwrite(buf, 1, len / 2, fpt);
+  rewind(fpt);
+
+  if (create(sunctx, 5, 1, NP, &bad)) { return 1; }
+  flag = IDAReadState(bad.ida_mem, fpt);
+  if (flag != IDA_ILL_INPUT)
+  {
+    fprintf(stderr, "ERROR: truncated stream returned %d\n", flag);
+    fails++;
+  }
+  destroy(&bad);
+  fclose(fpt);
+  free(buf);
+
+  /* ------------------------------------------------
+   * Streams from a mismatched integrator are rejected
+   * ------------------------------------------------ */
+
+  rewind(fp);
+  if (create(sunctx, 3, 1, NP, &bad)) { return 1; }
+  flag = IDAReadState(bad.ida_mem, fp);
+  if (flag != IDA_ILL_INPUT)
+  {
+    fprintf(stderr, "ERROR: maximum order mismatch returned %d\n", flag);
+    fails++;
+  }
+  destroy(&bad);
+
+  rewind(fp);
+  if (create(sunctx, 5, 2, NP, &bad)) { return 1; }
+  flag = IDAReadState(bad.ida_mem, fp);
+  if (flag != IDA_ILL_INPUT)
+  {
+    fprintf(stderr, "ERROR: problem size mismatch returned %d\n", flag);
+    fails++;
+  }
+  destroy(&bad);
+
+  rewind(fp);
+  if (create(sunctx, 5, 1, NP - 1, &bad)) { return 1; }
+  flag = IDAReadState(bad.ida_mem, fp);
+  if (flag != IDA_ILL_INPUT)
+  {
+    fprintf(stderr, "ERROR: sensitivity mismatch returned %d\n", flag);
+    fails++;
+  }
+  destroy(&bad);
+
+  fclose(fp);
+  destroy(&ref);
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d checks failed\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}
@@ -0,0 +1,208 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the fused N_VPascalShiftVectorArray_Serial kernel. For vector
+ * lengths around the kernel block size and array sizes up to the largest
+ * Nordsieck array (q = 12 plus one), the test checks that
+ *
+ *   1. the operation is disabled by default, in which case
+ *      N_VPascalShiftVectorArray falls back to N_VLinearSum,
+ *   2. N_VEnablePascalShiftVectorArray_Serial and N_VEnableFusedOps_Serial
+ *      enable and disable the fused kernel,
+ *   3. the fused kernel gives bitwise the same result as the N_VLinearSum
+ *      fallback, and the same result as the binomial sums it computes.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvector/nvector_serial.h"
+#include "sundials/sundials_math.h"
+
+#define MAXVEC 13
+
+#define ONE SUN_RCONST(1.0)
+
+/* Fill Z[j] with values that are not exactly representable sums */
+static void fill(int nvec, N_Vector* Z)
+{
+  sunrealtype* zd;
+  sunindextype i, n;
+  int j;
+
+  n = N_VGetLength(Z[0]);
+  for (j = 0; j < nvec; j++)
+  {
+    zd = N_VGetArrayPointer(Z[j]);
+    for (i = 0; i < n; i++)
+    {
+      zd[i] = ONE / (sunrealtype)(3 * j + 7) +
+              (sunrealtype)((i * 7919 + j * 104729) % 1009) / SUN_RCONST(997.0);
+    }
+  }
+}
+
+/* Compare the fused kernel against the fallback for one length and array size
+   and return the number of failed checks */
+static int compare(SUNContext sunctx, sunindextype n, int nvec)
+{
+  N_Vector F[MAXVEC];
+  N_Vector S[MAXVEC];
+  N_Vector Z0[MAXVEC];
+  sunrealtype binom[MAXVEC];
+  sunrealtype *sd, *zd, sum, diff, maxdiff;
+  sunindextype i;
+  int j, k, fails = 0;
+
+  for (j = 0; j < nvec; j++)
+  {
+    F[j]  = N_VNew_Serial(n, sunctx);
+    S[j]  = N_VNew_Serial(n, sunctx);
+    Z0[j] = N_VNew_Serial(n, sunctx);
+    if (!F[j] || !S[j] || !Z0[j]) { return 1; }
+  }
+
+  /* the fused kernel is used through the first vector of the array */
+  if (N_VEnablePascalShiftVectorArray_Serial(F[0], SUNTRUE)) { return 1; }
+  if (F[0]->ops->nvpascalshiftvectorarray != N_VPascalShiftVectorArray_Serial ||
+      S[0]->ops->nvpascalshiftvectorarray != NULL)
+  {
+    fprintf(stderr, "ERROR: the fused kernel is not set as expected\n");
+    fails++;
+  }
+
+  fill(nvec, F);
+  fill(nvec, S);
+  fill(nvec, Z0);
+
+  if (N_VPascalShiftVectorArray(nvec, F)) { return 1; }
+  if (N_VPascalShiftVectorArray(nvec, S)) { return 1; }
+
+  /* the fused kernel adds in the same order as the fallback */
+  for (j = 0; j < nvec; j++)
+  {
+    if (memcmp(N_VGetArrayPointer(F[j]), N_VGetArrayPointer(S[j]),
+               (size_t)n * sizeof(sunrealtype)))
+    {
+      fprintf(stderr, "ERROR: n = %ld, nvec = %d: Z[%d] differs\n", (long int)n,
+              nvec, j);
+      fails++;
+      break;
+    }
+  }
+
+  /* Z[j] = sum_{k >= j} binomial(k, j) Z0[k] */
+  maxdiff = SUN_RCONST(0.0);
+  for (j = 0; j < nvec; j++)
+  {
+    binom[j] = ONE;
+    for (k = j + 1; k < nvec; k++)
+    {
+      binom[k] = binom[k - 1] * (sunrealtype)k / (sunrealtype)(k - j);
+    }
+    sd = N_VGetArrayPointer(S[j]);
+    for (i = 0; i < n; i++)
+    {
+      sum = SUN_RCONST(0.0);
+      for (k = j; k < nvec; k++)
+      {
+        zd = N_VGetArrayPointer(Z0[k]);
+        sum += binom[k] * zd[i];
+      }
+      diff    = SUNRabs(sd[i] - sum) / SUNMAX(SUNRabs(sum), ONE);
+      maxdiff = SUNMAX(maxdiff, diff);
+    }
+  }
+  if (maxdiff > SUN_RCONST(100.0) * SUN_UNIT_ROUNDOFF)
+  {
+    fprintf(stderr, "ERROR: n = %ld, nvec = %d: binomial sums differ by %g\n",
+            (long int)n, nvec, (double)maxdiff);
+    fails++;
+  }
+
+  for (j = 0; j < nvec; j++)
+  {
+    N_VDestroy(F[j]);
+    N_VDestroy(S[j]);
+    N_VDestroy(Z0[j]);
+  }
+
+  return fails;
+}
+
+/* Check that the fused kernel is disabled by default and toggled by the
+   enable functions */
+static int check_enable(SUNContext sunctx)
+{
+  N_Vector v = NULL;
+  int fails  = 0;
+
+  v = N_VNew_Serial(10, sunctx);
+  if (!v) { return 1; }
+
+  if (v->ops->nvpascalshiftvectorarray != NULL)
+  {
+    fprintf(stderr, "ERROR: the fused kernel is enabled by default\n");
+    fails++;
+  }
+
+  if (N_VEnableFusedOps_Serial(v, SUNTRUE)) { return 1; }
+  if (v->ops->nvpascalshiftvectorarray != N_VPascalShiftVectorArray_Serial)
+  {
+    fprintf(stderr, "ERROR: N_VEnableFusedOps_Serial did not enable it\n");
+    fails++;
+  }
+
+  if (N_VEnablePascalShiftVectorArray_Serial(v, SUNFALSE)) { return 1; }
+  if (v->ops->nvpascalshiftvectorarray != NULL)
+  {
+    fprintf(stderr, "ERROR: the fused kernel was not disabled\n");
+    fails++;
+  }
+
+  N_VDestroy(v);
+
+  return fails;
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx             = NULL;
+  const sunindextype lengths[6] = {1, 127, 128, 129, 1000, 4099};
+  int fails                     = 0;
+  int l, nvec;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  fails += check_enable(sunctx);
+
+  for (l = 0; l < 6; l++)
+  {
+    for (nvec = 1; nvec <= MAXVEC; nvec++)
+    {
+      fails += compare(sunctx, lengths[l], nvec);
+    }
+  }
+
+  printf("compared %d lengths and array sizes 1 to %d\n", 6, MAXVEC);
+
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d checks failed\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}
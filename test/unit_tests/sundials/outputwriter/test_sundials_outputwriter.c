@@ -0,0 +1,356 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the SUNOutputWriter. The test checks that
+ *
+ *   1. many records written through SUNOutputWriter_OutputFn and destroyed
+ *      right away, with records still pending, are all in the file, in order,
+ *      and with the right data,
+ *   2. a writer without records and a NULL writer are destroyed cleanly,
+ *   3. with Pthreads, the output function returns while the writer thread is
+ *      still writing the other buffer, and only waits when both buffers are
+ *      pending. The file is a pipe whose reader starts late and the records
+ *      are larger than the pipe capacity, so the writer thread is blocked
+ *      writing the first record while the second record is given.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvector/nvector_serial.h"
+#include "sundials/sundials_config.h"
+#include "sundials/sundials_outputwriter.h"
+
+#ifdef SUNDIALS_PTHREADS_ENABLED
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#if defined(SUNDIALS_EXTENDED_PRECISION)
+#define GSYM "Lg"
+#else
+#define GSYM "g"
+#endif
+
+#define ZERO SUN_RCONST(0.0)
+
+/* Set y_i = t + i */
+static void fill(sunrealtype t, N_Vector y)
+{
+  sunrealtype* yd = N_VGetArrayPointer(y);
+  sunindextype i;
+
+  for (i = 0; i < N_VGetLength(y); i++) { yd[i] = t + (sunrealtype)i; }
+}
+
+/* Check nrec records of n values with times 1, 2, ..., nrec and y_i = t + i */
+static int check_records(const char* buf, size_t nbytes, long int nrec,
+                         sunindextype n)
+{
+  size_t recsize = (size_t)(n + 1) * sizeof(sunrealtype);
+  sunrealtype t, val;
+  sunindextype i;
+  long int k;
+
+  if (nbytes != (size_t)nrec * recsize)
+  {
+    fprintf(stderr, "ERROR: %lu bytes written, expected %ld records\n",
+            (unsigned long)nbytes, nrec);
+    return 1;
+  }
+
+  for (k = 0; k < nrec; k++)
+  {
+    t = (sunrealtype)(k + 1);
+    memcpy(&val, buf + k * recsize, sizeof(sunrealtype));
+    if (val != t)
+    {
+      fprintf(stderr, "ERROR: record %ld has t = %" GSYM "\n", k, val);
+      return 1;
+    }
+
+    /* check the first and last few values */
+    for (i = 0; i < n; i++)
+    {
+      if (i == 4 && n > 8) { i = n - 4; }
+      memcpy(&val, buf + k * recsize + (i + 1) * sizeof(sunrealtype),
+             sizeof(sunrealtype));
+      if (val != t + (sunrealtype)i)
+      {
+        fprintf(stderr, "ERROR: record %ld has y[%ld] = %" GSYM "\n", k,
+                (long int)i, val);
+        return 1;
+      }
+    }
+  }
+
+  return 0;
+}
+
+/* Write nrec records to a file, destroy the writer with records pending, and
+   check the file */
+static int test_records(SUNContext sunctx, long int nrec)
+{
+  SUNOutputWriter writer = NULL;
+  N_Vector y             = NULL;
+  FILE* fp               = NULL;
+  char* buf              = NULL;
+  long int k, nrecords;
+  long len;
+  int fails = 0;
+
+  fp = tmpfile();
+  y  = N_VNew_Serial(5, sunctx);
+  if (!fp || !y) { return 1; }
+
+  if (SUNOutputWriter_Create(y, fp, sunctx, &writer)) { return 1; }
+
+  for (k = 0; k < nrec; k++)
+  {
+    fill((sunrealtype)(k + 1), y);
+    if (SUNOutputWriter_OutputFn((sunrealtype)(k + 1), y, writer))
+    {
+      fprintf(stderr, "ERROR: output function failed for record %ld\n", k);
+      return fails + 1;
+    }
+  }
+
+  if (SUNOutputWriter_GetNumRecords(writer, &nrecords)) { return 1; }
+  if (nrecords != nrec)
+  {
+    fprintf(stderr, "ERROR: writer counted %ld records, expected %ld\n",
+            nrecords, nrec);
+    fails++;
+  }
+
+  /* the pending records are written before the writer thread is joined */
+  if (SUNOutputWriter_Destroy(&writer) != SUN_SUCCESS || writer != NULL)
+  {
+    fprintf(stderr, "ERROR: destroying the writer failed\n");
+    fails++;
+  }
+
+  fseek(fp, 0, SEEK_END);
+  len = ftell(fp);
+  rewind(fp);
+  buf = (char*)malloc(len > 0 ? len : 1);
+  if (!buf || fread(buf, 1, len, fp) != (size_t)len) { return 1; }
+
+  fails += check_records(buf, (size_t)len, nrec, 5);
+
+  printf("records: %ld records written, %ld bytes\n", nrec, len);
+
+  free(buf);
+  fclose(fp);
+  N_VDestroy(y);
+
+  return fails;
+}
+
+/* Create and destroy writers without records */
+static int test_shutdown(SUNContext sunctx)
+{
+  SUNOutputWriter writer = NULL;
+  N_Vector y             = NULL;
+  FILE* fp               = NULL;
+  int k, fails = 0;
+
+  fp = tmpfile();
+  y  = N_VNew_Serial(5, sunctx);
+  if (!fp || !y) { return 1; }
+
+  /* the writer thread is idle waiting for records */
+  for (k = 0; k < 10; k++)
+  {
+    if (SUNOutputWriter_Create(y, fp, sunctx, &writer)) { return 1; }
+    if (SUNOutputWriter_Destroy(&writer) != SUN_SUCCESS || writer != NULL)
+    {
+      fprintf(stderr, "ERROR: destroying an idle writer failed\n");
+      fails++;
+      break;
+    }
+  }
+
+  if (SUNOutputWriter_Destroy(&writer) != SUN_SUCCESS ||
+      SUNOutputWriter_Destroy(NULL) != SUN_SUCCESS)
+  {
+    fprintf(stderr, "ERROR: destroying a NULL writer failed\n");
+    fails++;
+  }
+
+  if (ftell(fp) != 0)
+  {
+    fprintf(stderr, "ERROR: writers without records wrote to the file\n");
+    fails++;
+  }
+
+  printf("shutdown: %d idle writers destroyed\n", k);
+
+  fclose(fp);
+  N_VDestroy(y);
+
+  return fails;
+}
+
+#ifdef SUNDIALS_PTHREADS_ENABLED
+
+/* Pipe reader that starts reading after a delay */
+typedef struct
+{
+  int fd;
+  char* buf;
+  size_t cap;
+  size_t nbytes;
+  int reading;
+  pthread_mutex_t lock;
+} PipeReader;
+
+static void pause_ms(long ms)
+{
+  struct timespec ts;
+  ts.tv_sec  = ms / 1000;
+  ts.tv_nsec = (ms % 1000) * 1000000L;
+  nanosleep(&ts, NULL);
+}
+
+static int is_reading(PipeReader* r)
+{
+  int reading;
+  pthread_mutex_lock(&r->lock);
+  reading = r->reading;
+  pthread_mutex_unlock(&r->lock);
+  return reading;
+}
+
+static void* reader_thread(void* arg)
+{
+  PipeReader* r = (PipeReader*)arg;
+  ssize_t n;
+
+  pause_ms(300);
+
+  pthread_mutex_lock(&r->lock);
+  r->reading = 1;
+  pthread_mutex_unlock(&r->lock);
+
+  while (r->nbytes < r->cap &&
+         (n = read(r->fd, r->buf + r->nbytes, r->cap - r->nbytes)) > 0)
+  {
+    r->nbytes += (size_t)n;
+  }
+
+  return NULL;
+}
+
+/* Give three records larger than the pipe capacity to a writer on a pipe that
+   is not read yet */
+static int test_overlap(SUNContext sunctx)
+{
+  SUNOutputWriter writer = NULL;
+  N_Vector y             = NULL;
+  FILE* fp               = NULL;
+  PipeReader r;
+  pthread_t reader;
+  sunindextype n = 65536;
+  size_t recsize = (size_t)(n + 1) * sizeof(sunrealtype);
+  int fds[2];
+  int fails = 0;
+
+  if (pipe(fds)) { return 1; }
+  fp = fdopen(fds[1], "wb");
+  y  = N_VNew_Serial(n, sunctx);
+  if (!fp || !y) { return 1; }
+
+  r.fd      = fds[0];
+  r.cap     = 3 * recsize + 1;
+  r.buf     = (char*)malloc(r.cap);
+  r.nbytes  = 0;
+  r.reading = 0;
+  if (!r.buf) { return 1; }
+  pthread_mutex_init(&r.lock, NULL);
+
+  if (SUNOutputWriter_Create(y, fp, sunctx, &writer)) { return 1; }
+  if (pthread_create(&reader, NULL, reader_thread, &r)) { return 1; }
+
+  /* the writer thread takes the first record and blocks on the pipe */
+  fill(SUN_RCONST(1.0), y);
+  if (SUNOutputWriter_OutputFn(SUN_RCONST(1.0), y, writer)) { return 1; }
+  pause_ms(50);
+
+  /* the second record goes into the other buffer without waiting */
+  fill(SUN_RCONST(2.0), y);
+  if (SUNOutputWriter_OutputFn(SUN_RCONST(2.0), y, writer)) { return 1; }
+  if (is_reading(&r))
+  {
+    fprintf(stderr, "ERROR: the second record waited for the first one\n");
+    fails++;
+  }
+
+  /* both buffers are pending, so the third record waits for the first one */
+  fill(SUN_RCONST(3.0), y);
+  if (SUNOutputWriter_OutputFn(SUN_RCONST(3.0), y, writer)) { return 1; }
+  if (!is_reading(&r))
+  {
+    fprintf(stderr, "ERROR: the third record did not wait for a buffer\n");
+    fails++;
+  }
+
+  /* write the pending records, join the writer thread, and close the pipe */
+  if (SUNOutputWriter_Destroy(&writer) != SUN_SUCCESS)
+  {
+    fprintf(stderr, "ERROR: destroying the writer failed\n");
+    fails++;
+  }
+  fclose(fp);
+
+  pthread_join(reader, NULL);
+
+  fails += check_records(r.buf, r.nbytes, 3, n);
+
+  printf("overlap: %d records of %lu bytes read from the pipe\n", 3,
+         (unsigned long)recsize);
+
+  close(fds[0]);
+  pthread_mutex_destroy(&r.lock);
+  free(r.buf);
+  N_VDestroy(y);
+
+  return fails;
+}
+
+#endif
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  int fails         = 0;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  fails += test_records(sunctx, 10000);
+  fails += test_shutdown(sunctx);
+#ifdef SUNDIALS_PTHREADS_ENABLED
+  fails += test_overlap(sunctx);
+#endif
+
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d checks failed\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}
@@ -0,0 +1,322 @@
+/* -----------------------------------------------------------------------------
+ * SUNDIALS Copyright Start
+ * Copyright (c) 2002-2024, Lawrence Livermore National Security
+ * and Southern Methodist University.
+ * All rights reserved.
+ *
+ * See the top-level LICENSE and NOTICE files for details.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ * SUNDIALS Copyright End
+ * -----------------------------------------------------------------------------
+ * Unit test for the SUNStructMG. On a single process with 1, 2, and 3
+ * directions, the test checks that
+ *
+ *   1. grids with 2^k + 1 nodes in each direction are coarsened down to 3
+ *      nodes, and the number of levels is limited by maxlevels,
+ *   2. the V-cycle used as a stationary iteration for (I - gamma L) z = r
+ *      reduces the residual by a factor independent of the grid size. The
+ *      first cycle is not counted, the max norm of the residual can grow in
+ *      it because the rows of the Dirichlet nodes are not scaled,
+ *   3. the ODE and DAE preconditioner solve functions give the same result
+ *      as SUNStructMG_Solve with the matching operator,
+ *   4. invalid grids are rejected.
+ * ---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "nvector/nvector_serial.h"
+#include "sundials/sundials_math.h"
+#include "sundials/sundials_structmg.h"
+
+#define ZERO SUN_RCONST(0.0)
+#define ONE  SUN_RCONST(1.0)
+
+/* Compute res = r - (c0 I - s L) z on a single process grid */
+static void residual(const SUNStructGrid* grid, const SUNStructStencil* st,
+                     sunrealtype c0, sunrealtype s, N_Vector r, N_Vector z,
+                     N_Vector res)
+{
+  sunrealtype *rd, *zd, *resd, Az;
+  sunindextype n[3], stride[3], i, j, k, g;
+  int d;
+
+  rd   = N_VGetArrayPointer(r);
+  zd   = N_VGetArrayPointer(z);
+  resd = N_VGetArrayPointer(res);
+
+  for (d = 0; d < 3; d++) { n[d] = (d < grid->dim) ? grid->n[d] : 1; }
+  stride[0] = 1;
+  stride[1] = n[0];
+  stride[2] = n[0] * n[1];
+
+  for (k = 0; k < n[2]; k++)
+  {
+    for (j = 0; j < n[1]; j++)
+    {
+      for (i = 0; i < n[0]; i++)
+      {
+        sunindextype idx[3] = {i, j, k};
+        sunbooleantype bdry = SUNFALSE;
+
+        g = i + stride[1] * j + stride[2] * k;
+        for (d = 0; d < grid->dim; d++)
+        {
+          if (idx[d] == 0 || idx[d] == n[d] - 1) { bdry = SUNTRUE; }
+        }
+
+        Az = c0 * zd[g];
+        if (!bdry)
+        {
+          for (d = 0; d < grid->dim; d++)
+          {
+            Az -= s * st->coef[d] *
+                  (zd[g - stride[d]] - SUN_RCONST(2.0) * zd[g] +
+                   zd[g + stride[d]]);
+          }
+        }
+        resd[g] = rd[g] - Az;
+      }
+    }
+  }
+}
+
+/* Run V-cycle iterations for one grid and return the number of failed checks */
+static int check_convergence(SUNContext sunctx, int dim, int k)
+{
+  SUNStructGrid grid;
+  SUNStructStencil st;
+  SUNStructMG mg = NULL;
+  N_Vector r, z, res, dz;
+  sunrealtype gamma, rnorm0, rnorm, rate, h;
+  sunindextype N, ncoarse[3];
+  int d, it, nlevels, fails = 0;
+
+  memset(&grid, 0, sizeof(grid));
+  grid.dim  = dim;
+  grid.comm = SUN_COMM_NULL;
+  N         = 1;
+  for (d = 0; d < dim; d++)
+  {
+    grid.n[d]      = ((sunindextype)1 << k) + 1;
+    grid.start[d]  = 0;
+    grid.nloc[d]   = grid.n[d];
+    grid.nbr[d][0] = -1;
+    grid.nbr[d][1] = -1;
+    N *= grid.n[d];
+
+    /* mildly anisotropic diffusion on the unit cube */
+    h          = ONE / (sunrealtype)(grid.n[d] - 1);
+    st.coef[d] = (ONE + SUN_RCONST(0.25) * (sunrealtype)d) / (h * h);
+  }
+
+  /* stiff operator, gamma L is much larger than I */
+  gamma = SUN_RCONST(0.1);
+
+  if (SUNStructMG_Create(&grid, &st, 0, sunctx, &mg)) { return 1; }
+  if (SUNStructMG_SetNumSweeps(mg, 2)) { return 1; }
+  if (SUNStructMG_SetOperator(mg, ONE, gamma)) { return 1; }
+
+  SUNStructMG_GetNumLevels(mg, &nlevels);
+  SUNStructMG_GetCoarseGrid(mg, ncoarse);
+  if (nlevels != k)
+  {
+    fprintf(stderr, "ERROR: dim = %d, k = %d: %d levels, expected %d\n", dim,
+            k, nlevels, k);
+    fails++;
+  }
+  for (d = 0; d < dim; d++)
+  {
+    if (ncoarse[d] != 3)
+    {
+      fprintf(stderr, "ERROR: dim = %d, k = %d: %ld coarse nodes\n", dim, k,
+              (long int)ncoarse[d]);
+      fails++;
+    }
+  }
+
+  r   = N_VNew_Serial(N, sunctx);
+  z   = N_VClone(r);
+  res = N_VClone(r);
+  dz  = N_VClone(r);
+
+  /* smooth right-hand side with the boundary values */
+  N_VConst(ONE, r);
+  N_VConst(ZERO, z);
+
+  /* z += M^{-1} (r - A z) */
+  residual(&grid, &st, ONE, gamma, r, z, res);
+  rnorm0 = ZERO;
+  rnorm  = ZERO;
+  for (it = 0; it < 8; it++)
+  {
+    if (SUNStructMG_Solve(mg, res, dz)) { return 1; }
+    N_VLinearSum(ONE, z, ONE, dz, z);
+    residual(&grid, &st, ONE, gamma, r, z, res);
+    rnorm = N_VMaxNorm(res);
+    if (it == 0) { rnorm0 = rnorm; }
+  }
+
+  rate = SUNRpowerR(rnorm / rnorm0, ONE / SUN_RCONST(7.0));
+  printf("dim = %d, n = %4ld, levels = %2d, convergence rate = %.3f\n", dim,
+         (long int)grid.n[0], nlevels, (double)rate);
+  if (rate > SUN_RCONST(0.5))
+  {
+    fprintf(stderr, "ERROR: dim = %d, k = %d: convergence rate %g\n", dim, k,
+            (double)rate);
+    fails++;
+  }
+
+  N_VDestroy(r);
+  N_VDestroy(z);
+  N_VDestroy(res);
+  N_VDestroy(dz);
+  SUNStructMG_Destroy(&mg);
+
+  return fails;
+}
+
+/* Check maxlevels, the preconditioner wrappers, and invalid grids */
+static int check_interface(SUNContext sunctx)
+{
+  SUNStructGrid grid;
+  SUNStructStencil st;
+  SUNStructMG mg = NULL;
+  N_Vector r, z, zref;
+  sunbooleantype jcur = SUNFALSE;
+  sunrealtype* rd;
+  sunindextype i;
+  int nlevels, fails = 0;
+
+  memset(&grid, 0, sizeof(grid));
+  grid.dim       = 2;
+  grid.comm      = SUN_COMM_NULL;
+  grid.n[0]      = 33;
+  grid.n[1]      = 17;
+  grid.nloc[0]   = 33;
+  grid.nloc[1]   = 17;
+  grid.nbr[0][0] = grid.nbr[0][1] = -1;
+  grid.nbr[1][0] = grid.nbr[1][1] = -1;
+  st.coef[0]     = SUN_RCONST(1024.0);
+  st.coef[1]     = SUN_RCONST(256.0);
+
+  /* the coarsest grid is limited by the direction with the fewest nodes */
+  if (SUNStructMG_Create(&grid, &st, 0, sunctx, &mg)) { return 1; }
+  SUNStructMG_GetNumLevels(mg, &nlevels);
+  if (nlevels != 4)
+  {
+    fprintf(stderr, "ERROR: %d levels, expected 4\n", nlevels);
+    fails++;
+  }
+  SUNStructMG_Destroy(&mg);
+
+  if (SUNStructMG_Create(&grid, &st, 2, sunctx, &mg)) { return 1; }
+  SUNStructMG_GetNumLevels(mg, &nlevels);
+  if (nlevels != 2)
+  {
+    fprintf(stderr, "ERROR: %d levels with maxlevels = 2\n", nlevels);
+    fails++;
+  }
+
+  r    = N_VNew_Serial(33 * 17, sunctx);
+  z    = N_VClone(r);
+  zref = N_VClone(r);
+  rd   = N_VGetArrayPointer(r);
+  for (i = 0; i < 33 * 17; i++)
+  {
+    rd[i] = (sunrealtype)((i * 7919) % 1009) / SUN_RCONST(997.0);
+  }
+
+  /* ODE wrappers, A = I - gamma L */
+  SUNStructMG_SetOperator(mg, ONE, SUN_RCONST(0.01));
+  SUNStructMG_Solve(mg, r, zref);
+  SUNStructMG_SetOperator(mg, ONE, ONE);
+  if (SUNStructMG_ODEPrecSetup(ZERO, r, r, SUNFALSE, &jcur, SUN_RCONST(0.5),
+                               mg) ||
+      !jcur)
+  {
+    fprintf(stderr, "ERROR: ODE setup failed or did not set jcur\n");
+    fails++;
+  }
+  if (SUNStructMG_ODEPrecSolve(ZERO, r, r, r, z, SUN_RCONST(0.01), ZERO, 1, mg))
+  {
+    return 1;
+  }
+  N_VLinearSum(ONE, z, -ONE, zref, z);
+  if (N_VMaxNorm(z) != ZERO)
+  {
+    fprintf(stderr, "ERROR: ODE solve does not use the solve gamma\n");
+    fails++;
+  }
+
+  /* DAE wrappers, A = cj I - L */
+  SUNStructMG_SetOperator(mg, SUN_RCONST(100.0), ONE);
+  SUNStructMG_Solve(mg, r, zref);
+  if (SUNStructMG_DAEPrecSetup(ZERO, r, r, r, SUN_RCONST(100.0), mg)) { return 1; }
+  if (SUNStructMG_DAEPrecSolve(ZERO, r, r, r, r, z, SUN_RCONST(100.0), ZERO, mg))
+  {
+    return 1;
+  }
+  N_VLinearSum(ONE, z, -ONE, zref, z);
+  if (N_VMaxNorm(z) != ZERO)
+  {
+    fprintf(stderr, "ERROR: DAE solve differs from SUNStructMG_Solve\n");
+    fails++;
+  }
+
+  N_VDestroy(r);
+  N_VDestroy(z);
+  N_VDestroy(zref);
+  SUNStructMG_Destroy(&mg);
+
+  /* invalid grids */
+  grid.dim = 4;
+  if (SUNStructMG_Create(&grid, &st, 0, sunctx, &mg) == SUN_SUCCESS)
+  {
+    fprintf(stderr, "ERROR: dim = 4 was accepted\n");
+    SUNStructMG_Destroy(&mg);
+    fails++;
+  }
+  grid.dim     = 2;
+  grid.nloc[1] = 18;
+  if (SUNStructMG_Create(&grid, &st, 0, sunctx, &mg) == SUN_SUCCESS)
+  {
+    fprintf(stderr, "ERROR: local nodes outside the grid were accepted\n");
+    SUNStructMG_Destroy(&mg);
+    fails++;
+  }
+
+  return fails;
+}
+
+int main(int argc, char* argv[])
+{
+  SUNContext sunctx = NULL;
+  int fails         = 0;
+  int dim, k;
+
+  if (SUNContext_Create(SUN_COMM_NULL, &sunctx)) { return 1; }
+
+  for (dim = 1; dim <= 3; dim++)
+  {
+    for (k = 3; k <= ((dim == 3) ? 5 : 7); k++)
+    {
+      fails += check_convergence(sunctx, dim, k);
+    }
+  }
+
+  fails += check_interface(sunctx);
+
+  SUNContext_Free(&sunctx);
+
+  if (fails)
+  {
+    printf("FAIL: %d checks failed\n", fails);
+    return 1;
+  }
+
+  printf("SUCCESS\n");
+  return 0;
+}